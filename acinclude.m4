@@ -8,10 +8,153 @@ AC_DEFUN([AX_LIBCTHREADS_CHECK_LOCAL],
     [test "x$ac_cv_enable_winapi" = xno],
     [dnl Check for enabling pthread support
     AX_PTHREAD_CHECK_ENABLE
-      ac_cv_libcthreads_multi_threading=$ac_cv_pthread],
+      ac_cv_libcthreads_multi_threading=$ac_cv_pthread
+
+    dnl Check for eventfd support used for readiness notification
+    AC_CHECK_HEADERS([sys/eventfd.h])
+
+    dnl Check for monotonic clock support used for timed waits
+    AC_CHECK_HEADERS([sys/time.h])
+    AC_CHECK_FUNCS([clock_gettime pthread_condattr_setclock])
+
+    dnl Check for monotonic clock lock support used for timed grabs
+    AC_CHECK_FUNCS([nanosleep pthread_mutex_clocklock pthread_rwlock_clockrdlock pthread_rwlock_clockwrlock])
+
+    dnl Check for thread name support
+    AC_CHECK_FUNCS([pthread_setname_np])
+
+    dnl Check for current CPU support used by the sharded counter
+    AC_CHECK_FUNCS([sched_getcpu])],
     [ac_cv_libcthreads_multi_threading="winapi"])
   ])
 
+dnl Function to detect if the pthread static initializers are all zero bytes
+dnl in which case zero initialized storage can be used as a static initializer
+AC_DEFUN([AX_LIBCTHREADS_CHECK_STATIC_INITIALIZERS],
+  [ac_cv_libcthreads_static_initializers=no
+
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno && test "x$ac_cv_pthread" != xno],
+    [AC_CACHE_CHECK(
+      [whether the pthread static initializers are zero],
+      [ac_cv_libcthreads_static_initializers],
+      [AC_LANG_PUSH(C)
+      AC_RUN_IFELSE(
+        [AC_LANG_PROGRAM(
+          [[#include <pthread.h>
+#include <string.h>]],
+          [[pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_rwlock_t read_write_lock = PTHREAD_RWLOCK_INITIALIZER;
+pthread_mutex_t zero_mutex;
+pthread_rwlock_t zero_read_write_lock;
+
+memset( &zero_mutex, 0, sizeof( pthread_mutex_t ) );
+memset( &zero_read_write_lock, 0, sizeof( pthread_rwlock_t ) );
+
+if( memcmp( &mutex, &zero_mutex, sizeof( pthread_mutex_t ) ) != 0 )
+  return( 1 );
+if( memcmp( &read_write_lock, &zero_read_write_lock, sizeof( pthread_rwlock_t ) ) != 0 )
+  return( 1 );]] )],
+        [ac_cv_libcthreads_static_initializers=yes],
+        [ac_cv_libcthreads_static_initializers=no],
+        [ac_cv_libcthreads_static_initializers=no])
+      AC_LANG_POP(C)])
+    ])
+
+  AS_IF(
+    [test "x$ac_cv_libcthreads_static_initializers" = xyes],
+    [AC_DEFINE(
+      [HAVE_LIBCTHREADS_STATIC_INITIALIZERS],
+      [1],
+      [Define to 1 if zero initialized storage can be used as a static initializer.])
+    AC_SUBST(
+      [HAVE_LIBCTHREADS_STATIC_INITIALIZERS],
+      [1]) ],
+    [AC_SUBST(
+      [HAVE_LIBCTHREADS_STATIC_INITIALIZERS],
+      [0]) ])
+  ])
+
+dnl Function to detect if a double width compare and exchange is available
+dnl which is used by the atomic functions, e.g. to update the top node and tag of the stack atomically
+AC_DEFUN([AX_LIBCTHREADS_CHECK_DOUBLE_WIDTH_COMPARE_EXCHANGE],
+  [AC_CACHE_CHECK(
+    [whether a double width compare and exchange requires -mcx16],
+    [ac_cv_libcthreads_cflags_mcx16],
+    [AC_LANG_PUSH(C)
+    ac_cv_libcthreads_backup_cflags="$CFLAGS"
+    CFLAGS="$CFLAGS -mcx16"
+    AC_COMPILE_IFELSE(
+      [AC_LANG_PROGRAM(
+        [[]],
+        [[#if !defined( __x86_64__ ) || !defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16 )
+#error double width compare and exchange not supported
+#endif]] )],
+      [ac_cv_libcthreads_cflags_mcx16=yes],
+      [ac_cv_libcthreads_cflags_mcx16=no])
+    CFLAGS="$ac_cv_libcthreads_backup_cflags"
+    AC_LANG_POP(C)])
+
+  AS_IF(
+    [test "x$ac_cv_libcthreads_cflags_mcx16" = xyes],
+    [CFLAGS="$CFLAGS -mcx16"])
+  ])
+
+dnl Function to detect whether lock order validation should be enabled
+AC_DEFUN([AX_LIBCTHREADS_CHECK_ENABLE_LOCK_VALIDATION],
+  [AX_COMMON_ARG_ENABLE(
+    [lock-validation],
+    [lock_validation],
+    [enable lock order validation],
+    [no])
+
+  AS_IF(
+    [test "x$ac_cv_enable_lock_validation" != xno],
+    [AC_DEFINE(
+      [HAVE_LIBCTHREADS_LOCK_VALIDATION],
+      [1],
+      [Define to 1 if lock order validation should be used.])
+
+    dnl Headers included in libcthreads/libcthreads_lock_validator.c
+    AC_CHECK_HEADERS([stdarg.h varargs.h])
+
+    dnl Check for backtrace support used in lock order reports
+    AC_CHECK_HEADERS([execinfo.h])
+    AC_CHECK_FUNCS([backtrace backtrace_symbols])
+
+    dnl Check for spin lock support used to protect the lock order graph
+    AC_CHECK_FUNCS([pthread_spin_lock])
+
+    ac_cv_enable_lock_validation=yes])
+  ])
+
+dnl Function to detect whether USDT static probes should be enabled
+AC_DEFUN([AX_LIBCTHREADS_CHECK_ENABLE_USDT_PROBES],
+  [AX_COMMON_ARG_ENABLE(
+    [usdt-probes],
+    [usdt_probes],
+    [enable USDT static probes],
+    [no])
+
+  AS_IF(
+    [test "x$ac_cv_enable_usdt_probes" != xno],
+    [AC_CHECK_HEADERS([sys/sdt.h])
+
+    AS_IF(
+      [test "x$ac_cv_header_sys_sdt_h" != xyes],
+      [AC_MSG_FAILURE(
+        [Missing header: sys/sdt.h header is needed for USDT static probes],
+        [1])
+      ])
+
+    AC_DEFINE(
+      [HAVE_LIBCTHREADS_USDT_PROBES],
+      [1],
+      [Define to 1 if USDT static probes should be used.])
+
+    ac_cv_enable_usdt_probes=yes])
+  ])
+
 dnl Function to check if DLL support is needed
 AC_DEFUN([AX_LIBCTHREADS_CHECK_DLL_SUPPORT],
   [AS_IF(
@@ -0,0 +1,657 @@
+/*
+ * Atomic functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#endif
+
+#include "libcthreads_atomic.h"
+#include "libcthreads_definitions.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#if defined( __ATOMIC_RELAXED ) && !defined( WINAPI )
+#if ( __ATOMIC_RELAXED != 0 ) || ( __ATOMIC_ACQUIRE != 2 ) || ( __ATOMIC_RELEASE != 3 ) || ( __ATOMIC_ACQ_REL != 4 ) || ( __ATOMIC_SEQ_CST != 5 )
+#error Unsupported __ATOMIC memory order values
+#endif
+#endif
+
+#if defined( WINAPI ) && defined( _WIN64 )
+typedef LONG64 libcthreads_atomic_double_word_t[ 2 ];
+
+#elif defined( WINAPI ) && defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+typedef LONG64 libcthreads_atomic_double_word_t;
+
+#elif defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE ) && ( __SIZEOF_POINTER__ == 8 )
+typedef unsigned __int128 libcthreads_atomic_double_word_t;
+
+#elif defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+typedef uint64_t libcthreads_atomic_double_word_t;
+
+#endif
+
+#if !defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS ) || !defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+
+/* The lock that protects the operations that cannot be done atomically
+ */
+#if defined( WINAPI )
+static LONG volatile libcthreads_atomic_lock = 0;
+
+#define libcthreads_atomic_grab_lock() \
+	while( InterlockedExchange( &libcthreads_atomic_lock, 1 ) != 0 ) \
+	{ \
+		YieldProcessor(); \
+	}
+
+#define libcthreads_atomic_release_lock() \
+	InterlockedExchange( &libcthreads_atomic_lock, 0 )
+
+#elif defined( HAVE_PTHREAD_H )
+static pthread_mutex_t libcthreads_atomic_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#define libcthreads_atomic_grab_lock() \
+	pthread_mutex_lock( &libcthreads_atomic_lock )
+
+#define libcthreads_atomic_release_lock() \
+	pthread_mutex_unlock( &libcthreads_atomic_lock )
+
+#endif
+
+#endif /* !defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS ) || !defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE ) */
+
+/* Atomically loads a 32-bit value
+ * Returns the value
+ */
+uint32_t libcthreads_atomic_load_32(
+          volatile uint32_t *value,
+          int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	return( libcthreads_internal_atomic_load_32(
+	         value,
+	         memory_order ) );
+#else
+	uint32_t current_value = 0;
+
+	libcthreads_atomic_grab_lock();
+
+	current_value = *value;
+
+	libcthreads_atomic_release_lock();
+
+	return( current_value );
+#endif
+}
+
+/* Atomically stores a 32-bit value
+ */
+void libcthreads_atomic_store_32(
+      volatile uint32_t *value,
+      uint32_t new_value,
+      int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	libcthreads_internal_atomic_store_32(
+	 value,
+	 new_value,
+	 memory_order );
+#else
+	libcthreads_atomic_grab_lock();
+
+	*value = new_value;
+
+	libcthreads_atomic_release_lock();
+#endif
+}
+
+/* Atomically replaces a 32-bit value
+ * Returns the previous value
+ */
+uint32_t libcthreads_atomic_exchange_32(
+          volatile uint32_t *value,
+          uint32_t new_value,
+          int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	return( libcthreads_internal_atomic_exchange_32(
+	         value,
+	         new_value,
+	         memory_order ) );
+#else
+	uint32_t previous_value = 0;
+
+	libcthreads_atomic_grab_lock();
+
+	previous_value = *value;
+	*value         = new_value;
+
+	libcthreads_atomic_release_lock();
+
+	return( previous_value );
+#endif
+}
+
+/* Atomically replaces a 32-bit value with the new value if it equals the expected value
+ * Returns 1 if the value was replaced or 0 if not, in which case
+ * the expected value is set to the current value
+ */
+int libcthreads_atomic_compare_exchange_32(
+     volatile uint32_t *value,
+     uint32_t *expected_value,
+     uint32_t new_value,
+     int memory_order )
+{
+	uint32_t previous_value = 0;
+
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	previous_value = libcthreads_internal_atomic_compare_exchange_32(
+	                  value,
+	                  *expected_value,
+	                  new_value,
+	                  memory_order );
+#else
+	libcthreads_atomic_grab_lock();
+
+	previous_value = *value;
+
+	if( previous_value == *expected_value )
+	{
+		*value = new_value;
+	}
+	libcthreads_atomic_release_lock();
+#endif
+	if( previous_value == *expected_value )
+	{
+		return( 1 );
+	}
+	*expected_value = previous_value;
+
+	return( 0 );
+}
+
+/* Atomically adds to a 32-bit value
+ * Returns the previous value
+ */
+uint32_t libcthreads_atomic_fetch_add_32(
+          volatile uint32_t *value,
+          uint32_t addend,
+          int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	return( libcthreads_internal_atomic_fetch_add_32(
+	         value,
+	         addend,
+	         memory_order ) );
+#else
+	uint32_t previous_value = 0;
+
+	libcthreads_atomic_grab_lock();
+
+	previous_value = *value;
+	*value         = previous_value + addend;
+
+	libcthreads_atomic_release_lock();
+
+	return( previous_value );
+#endif
+}
+
+/* Atomically sets bits of a 32-bit value
+ * Returns the previous value
+ */
+uint32_t libcthreads_atomic_fetch_or_32(
+          volatile uint32_t *value,
+          uint32_t mask,
+          int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	return( libcthreads_internal_atomic_fetch_or_32(
+	         value,
+	         mask,
+	         memory_order ) );
+#else
+	uint32_t previous_value = 0;
+
+	libcthreads_atomic_grab_lock();
+
+	previous_value = *value;
+	*value         = previous_value | mask;
+
+	libcthreads_atomic_release_lock();
+
+	return( previous_value );
+#endif
+}
+
+/* Atomically loads a 64-bit value
+ * Returns the value
+ */
+uint64_t libcthreads_atomic_load_64(
+          volatile uint64_t *value,
+          int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	return( libcthreads_internal_atomic_load_64(
+	         value,
+	         memory_order ) );
+#else
+	uint64_t current_value = 0;
+
+	libcthreads_atomic_grab_lock();
+
+	current_value = *value;
+
+	libcthreads_atomic_release_lock();
+
+	return( current_value );
+#endif
+}
+
+/* Atomically stores a 64-bit value
+ */
+void libcthreads_atomic_store_64(
+      volatile uint64_t *value,
+      uint64_t new_value,
+      int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	libcthreads_internal_atomic_store_64(
+	 value,
+	 new_value,
+	 memory_order );
+#else
+	libcthreads_atomic_grab_lock();
+
+	*value = new_value;
+
+	libcthreads_atomic_release_lock();
+#endif
+}
+
+/* Atomically replaces a 64-bit value
+ * Returns the previous value
+ */
+uint64_t libcthreads_atomic_exchange_64(
+          volatile uint64_t *value,
+          uint64_t new_value,
+          int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	return( libcthreads_internal_atomic_exchange_64(
+	         value,
+	         new_value,
+	         memory_order ) );
+#else
+	uint64_t previous_value = 0;
+
+	libcthreads_atomic_grab_lock();
+
+	previous_value = *value;
+	*value         = new_value;
+
+	libcthreads_atomic_release_lock();
+
+	return( previous_value );
+#endif
+}
+
+/* Atomically replaces a 64-bit value with the new value if it equals the expected value
+ * Returns 1 if the value was replaced or 0 if not, in which case
+ * the expected value is set to the current value
+ */
+int libcthreads_atomic_compare_exchange_64(
+     volatile uint64_t *value,
+     uint64_t *expected_value,
+     uint64_t new_value,
+     int memory_order )
+{
+	uint64_t previous_value = 0;
+
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	previous_value = libcthreads_internal_atomic_compare_exchange_64(
+	                  value,
+	                  *expected_value,
+	                  new_value,
+	                  memory_order );
+#else
+	libcthreads_atomic_grab_lock();
+
+	previous_value = *value;
+
+	if( previous_value == *expected_value )
+	{
+		*value = new_value;
+	}
+	libcthreads_atomic_release_lock();
+#endif
+	if( previous_value == *expected_value )
+	{
+		return( 1 );
+	}
+	*expected_value = previous_value;
+
+	return( 0 );
+}
+
+/* Atomically adds to a 64-bit value
+ * Returns the previous value
+ */
+uint64_t libcthreads_atomic_fetch_add_64(
+          volatile uint64_t *value,
+          uint64_t addend,
+          int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	return( libcthreads_internal_atomic_fetch_add_64(
+	         value,
+	         addend,
+	         memory_order ) );
+#else
+	uint64_t previous_value = 0;
+
+	libcthreads_atomic_grab_lock();
+
+	previous_value = *value;
+	*value         = previous_value + addend;
+
+	libcthreads_atomic_release_lock();
+
+	return( previous_value );
+#endif
+}
+
+/* Atomically sets bits of a 64-bit value
+ * Returns the previous value
+ */
+uint64_t libcthreads_atomic_fetch_or_64(
+          volatile uint64_t *value,
+          uint64_t mask,
+          int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	return( libcthreads_internal_atomic_fetch_or_64(
+	         value,
+	         mask,
+	         memory_order ) );
+#else
+	uint64_t previous_value = 0;
+
+	libcthreads_atomic_grab_lock();
+
+	previous_value = *value;
+	*value         = previous_value | mask;
+
+	libcthreads_atomic_release_lock();
+
+	return( previous_value );
+#endif
+}
+
+/* Atomically loads a pointer
+ * Returns the pointer
+ */
+intptr_t *libcthreads_atomic_load_pointer(
+           intptr_t * volatile *value,
+           int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	return( (intptr_t *) libcthreads_internal_atomic_load_pointer(
+	                      value,
+	                      memory_order ) );
+#else
+	intptr_t *current_value = NULL;
+
+	libcthreads_atomic_grab_lock();
+
+	current_value = *value;
+
+	libcthreads_atomic_release_lock();
+
+	return( current_value );
+#endif
+}
+
+/* Atomically stores a pointer
+ */
+void libcthreads_atomic_store_pointer(
+      intptr_t * volatile *value,
+      intptr_t *new_value,
+      int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	libcthreads_internal_atomic_store_pointer(
+	 value,
+	 new_value,
+	 memory_order );
+#else
+	libcthreads_atomic_grab_lock();
+
+	*value = new_value;
+
+	libcthreads_atomic_release_lock();
+#endif
+}
+
+/* Atomically replaces a pointer
+ * Returns the previous pointer
+ */
+intptr_t *libcthreads_atomic_exchange_pointer(
+           intptr_t * volatile *value,
+           intptr_t *new_value,
+           int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	return( (intptr_t *) libcthreads_internal_atomic_exchange_pointer(
+	                      value,
+	                      new_value,
+	                      memory_order ) );
+#else
+	intptr_t *previous_value = NULL;
+
+	libcthreads_atomic_grab_lock();
+
+	previous_value = *value;
+	*value         = new_value;
+
+	libcthreads_atomic_release_lock();
+
+	return( previous_value );
+#endif
+}
+
+/* Atomically replaces a pointer with the new pointer if it equals the expected pointer
+ * Returns 1 if the pointer was replaced or 0 if not, in which case
+ * the expected pointer is set to the current pointer
+ */
+int libcthreads_atomic_compare_exchange_pointer(
+     intptr_t * volatile *value,
+     intptr_t **expected_value,
+     intptr_t *new_value,
+     int memory_order )
+{
+	intptr_t *previous_value = NULL;
+
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	previous_value = (intptr_t *) libcthreads_internal_atomic_compare_exchange_pointer(
+	                               value,
+	                               *expected_value,
+	                               new_value,
+	                               memory_order );
+#else
+	libcthreads_atomic_grab_lock();
+
+	previous_value = *value;
+
+	if( previous_value == *expected_value )
+	{
+		*value = new_value;
+	}
+	libcthreads_atomic_release_lock();
+#endif
+	if( previous_value == *expected_value )
+	{
+		return( 1 );
+	}
+	*expected_value = previous_value;
+
+	return( 0 );
+}
+
+/* Atomically replaces a double width value with the new value if it equals the expected value
+ * The operation is a full barrier. Since a failed compare and exchange sets the expected value
+ * to the current value, it can also be used to load the value atomically
+ * If the operation is not lock free, the value must only be accessed using this function
+ * Returns 1 if the value was replaced or 0 if not, in which case
+ * the expected value is set to the current value
+ */
+int libcthreads_atomic_compare_exchange_double_width(
+     volatile libcthreads_atomic_double_width_t *value,
+     libcthreads_atomic_double_width_t *expected_value,
+     libcthreads_atomic_double_width_t *new_value )
+{
+#if defined( WINAPI ) && defined( _WIN64 )
+	return( (int) InterlockedCompareExchange128(
+	               (LONG64 volatile *) value,
+	               (LONG64) new_value->high_value,
+	               (LONG64) new_value->low_value,
+	               (LONG64 *) expected_value ) );
+
+#elif defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+	libcthreads_atomic_double_word_t expected_double_word;
+	libcthreads_atomic_double_word_t new_double_word;
+	libcthreads_atomic_double_word_t previous_double_word;
+
+	memory_copy(
+	 &expected_double_word,
+	 expected_value,
+	 sizeof( libcthreads_atomic_double_word_t ) );
+
+	memory_copy(
+	 &new_double_word,
+	 new_value,
+	 sizeof( libcthreads_atomic_double_word_t ) );
+
+#if defined( WINAPI )
+	previous_double_word = InterlockedCompareExchange64(
+	                        (LONG64 volatile *) value,
+	                        new_double_word,
+	                        expected_double_word );
+#else
+	previous_double_word = __sync_val_compare_and_swap(
+	                        (libcthreads_atomic_double_word_t *) value,
+	                        expected_double_word,
+	                        new_double_word );
+#endif
+	if( previous_double_word == expected_double_word )
+	{
+		return( 1 );
+	}
+	memory_copy(
+	 expected_value,
+	 &previous_double_word,
+	 sizeof( libcthreads_atomic_double_word_t ) );
+
+	return( 0 );
+
+#else
+	int result = 0;
+
+	libcthreads_atomic_grab_lock();
+
+	if( ( value->low_value == expected_value->low_value )
+	 && ( value->high_value == expected_value->high_value ) )
+	{
+		value->low_value  = new_value->low_value;
+		value->high_value = new_value->high_value;
+
+		result = 1;
+	}
+	else
+	{
+		expected_value->low_value  = value->low_value;
+		expected_value->high_value = value->high_value;
+	}
+	libcthreads_atomic_release_lock();
+
+	return( result );
+#endif
+}
+
+/* Determines if the atomic operations on values of a specific size are lock free
+ * The value size is either 4, 8, the size of a pointer or
+ * the size of a double width value
+ * Returns 1 if lock free or 0 if not
+ */
+int libcthreads_atomic_is_lock_free(
+     size_t value_size )
+{
+	if( value_size == sizeof( libcthreads_atomic_double_width_t ) )
+	{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+		return( 1 );
+#else
+		return( 0 );
+#endif
+	}
+	if( ( value_size == 4 )
+	 || ( value_size == 8 )
+	 || ( value_size == sizeof( intptr_t * ) ) )
+	{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+		return( 1 );
+#else
+		return( 0 );
+#endif
+	}
+	return( 0 );
+}
+
+/* Issues a memory fence
+ */
+void libcthreads_atomic_thread_fence(
+      int memory_order )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	libcthreads_internal_atomic_thread_fence(
+	 memory_order );
+#else
+	libcthreads_atomic_grab_lock();
+	libcthreads_atomic_release_lock();
+#endif
+}
+
+/* Hints the processor that the calling thread is spinning
+ */
+void libcthreads_atomic_cpu_relax(
+      void )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+	libcthreads_internal_atomic_cpu_relax();
+#endif
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
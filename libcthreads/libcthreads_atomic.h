@@ -0,0 +1,308 @@
+/*
+ * Atomic functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_ATOMIC_H )
+#define _LIBCTHREADS_INTERNAL_ATOMIC_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_definitions.h"
+#include "libcthreads_extern.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The 32-bit, 64-bit and pointer width operations map onto the Interlocked
+ * functions or the __atomic builtins, if not available the operations
+ * are protected by a lock
+ */
+#if defined( WINAPI ) || defined( __GNUC__ ) || defined( __clang__ )
+#define LIBCTHREADS_ATOMIC_HAVE_BUILTINS
+#endif
+
+/* The double width compare and exchange maps onto the Interlocked functions
+ * or the __sync builtins, if not available the operation is protected by a lock
+ */
+#if defined( WINAPI ) && defined( _WIN64 )
+#define LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE
+
+#elif defined( WINAPI ) && ( WINVER >= 0x0600 )
+#define LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE
+
+#elif ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( __SIZEOF_POINTER__ == 8 ) && defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16 )
+#define LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE
+
+#elif ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( __SIZEOF_POINTER__ == 4 ) && defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8 )
+#define LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE
+
+#endif
+
+/* The internal operations are used by the library itself so that they are inlined,
+ * the compare and exchange operations evaluate to the previous value
+ * The Interlocked functions are full barriers and ignore the memory order
+ */
+#if defined( WINAPI )
+#define libcthreads_internal_atomic_load_32( value, memory_order ) \
+	(uint32_t) InterlockedCompareExchange( (LONG volatile *) ( value ), 0, 0 )
+
+#define libcthreads_internal_atomic_store_32( value, new_value, memory_order ) \
+	InterlockedExchange( (LONG volatile *) ( value ), (LONG) ( new_value ) )
+
+#define libcthreads_internal_atomic_exchange_32( value, new_value, memory_order ) \
+	(uint32_t) InterlockedExchange( (LONG volatile *) ( value ), (LONG) ( new_value ) )
+
+#define libcthreads_internal_atomic_compare_exchange_32( value, expected_value, new_value, memory_order ) \
+	(uint32_t) InterlockedCompareExchange( (LONG volatile *) ( value ), (LONG) ( new_value ), (LONG) ( expected_value ) )
+
+#define libcthreads_internal_atomic_fetch_add_32( value, addend, memory_order ) \
+	(uint32_t) InterlockedExchangeAdd( (LONG volatile *) ( value ), (LONG) ( addend ) )
+
+#define libcthreads_internal_atomic_fetch_or_32( value, mask, memory_order ) \
+	(uint32_t) InterlockedOr( (LONG volatile *) ( value ), (LONG) ( mask ) )
+
+#define libcthreads_internal_atomic_load_64( value, memory_order ) \
+	(uint64_t) InterlockedCompareExchange64( (LONG64 volatile *) ( value ), 0, 0 )
+
+#define libcthreads_internal_atomic_store_64( value, new_value, memory_order ) \
+	InterlockedExchange64( (LONG64 volatile *) ( value ), (LONG64) ( new_value ) )
+
+#define libcthreads_internal_atomic_exchange_64( value, new_value, memory_order ) \
+	(uint64_t) InterlockedExchange64( (LONG64 volatile *) ( value ), (LONG64) ( new_value ) )
+
+#define libcthreads_internal_atomic_compare_exchange_64( value, expected_value, new_value, memory_order ) \
+	(uint64_t) InterlockedCompareExchange64( (LONG64 volatile *) ( value ), (LONG64) ( new_value ), (LONG64) ( expected_value ) )
+
+#define libcthreads_internal_atomic_fetch_add_64( value, addend, memory_order ) \
+	(uint64_t) InterlockedExchangeAdd64( (LONG64 volatile *) ( value ), (LONG64) ( addend ) )
+
+#define libcthreads_internal_atomic_fetch_or_64( value, mask, memory_order ) \
+	(uint64_t) InterlockedOr64( (LONG64 volatile *) ( value ), (LONG64) ( mask ) )
+
+#define libcthreads_internal_atomic_load_pointer( value, memory_order ) \
+	InterlockedCompareExchangePointer( (PVOID volatile *) ( value ), NULL, NULL )
+
+#define libcthreads_internal_atomic_store_pointer( value, new_value, memory_order ) \
+	InterlockedExchangePointer( (PVOID volatile *) ( value ), (PVOID) ( new_value ) )
+
+#define libcthreads_internal_atomic_exchange_pointer( value, new_value, memory_order ) \
+	InterlockedExchangePointer( (PVOID volatile *) ( value ), (PVOID) ( new_value ) )
+
+#define libcthreads_internal_atomic_compare_exchange_pointer( value, expected_value, new_value, memory_order ) \
+	InterlockedCompareExchangePointer( (PVOID volatile *) ( value ), (PVOID) ( new_value ), (PVOID) ( expected_value ) )
+
+#define libcthreads_internal_atomic_thread_fence( memory_order ) \
+	MemoryBarrier()
+
+#define libcthreads_internal_atomic_cpu_relax() \
+	YieldProcessor()
+
+#elif defined( __GNUC__ ) || defined( __clang__ )
+
+/* The memory order definitions have the same values as the __ATOMIC definitions
+ * A failed compare and exchange cannot have release semantics
+ */
+#define libcthreads_internal_atomic_failure_memory_order( memory_order ) \
+	( ( ( memory_order ) == LIBCTHREADS_MEMORY_ORDER_ACQUIRE_RELEASE ) ? LIBCTHREADS_MEMORY_ORDER_ACQUIRE : \
+	  ( ( ( memory_order ) == LIBCTHREADS_MEMORY_ORDER_RELEASE ) ? LIBCTHREADS_MEMORY_ORDER_RELAXED : ( memory_order ) ) )
+
+#define libcthreads_internal_atomic_load( value, memory_order ) \
+	__atomic_load_n( value, memory_order )
+
+#define libcthreads_internal_atomic_store( value, new_value, memory_order ) \
+	__atomic_store_n( value, new_value, memory_order )
+
+#define libcthreads_internal_atomic_exchange( value, new_value, memory_order ) \
+	__atomic_exchange_n( value, new_value, memory_order )
+
+/* The addition removes the volatile qualifier from the type of the previous value
+ */
+#define libcthreads_internal_atomic_compare_exchange( value, expected_value, new_value, memory_order ) \
+	__extension__ ( { \
+		__typeof__( *( value ) + 0 ) libcthreads_internal_atomic_previous_value = ( expected_value ); \
+		__atomic_compare_exchange_n( value, &libcthreads_internal_atomic_previous_value, new_value, 0, memory_order, libcthreads_internal_atomic_failure_memory_order( memory_order ) ); \
+		libcthreads_internal_atomic_previous_value; \
+	} )
+
+#define libcthreads_internal_atomic_load_32		libcthreads_internal_atomic_load
+#define libcthreads_internal_atomic_store_32		libcthreads_internal_atomic_store
+#define libcthreads_internal_atomic_exchange_32		libcthreads_internal_atomic_exchange
+#define libcthreads_internal_atomic_compare_exchange_32	libcthreads_internal_atomic_compare_exchange
+#define libcthreads_internal_atomic_fetch_add_32	__atomic_fetch_add
+#define libcthreads_internal_atomic_fetch_or_32		__atomic_fetch_or
+
+#define libcthreads_internal_atomic_load_64		libcthreads_internal_atomic_load
+#define libcthreads_internal_atomic_store_64		libcthreads_internal_atomic_store
+#define libcthreads_internal_atomic_exchange_64		libcthreads_internal_atomic_exchange
+#define libcthreads_internal_atomic_compare_exchange_64	libcthreads_internal_atomic_compare_exchange
+#define libcthreads_internal_atomic_fetch_add_64	__atomic_fetch_add
+#define libcthreads_internal_atomic_fetch_or_64		__atomic_fetch_or
+
+#define libcthreads_internal_atomic_load_pointer		libcthreads_internal_atomic_load
+#define libcthreads_internal_atomic_store_pointer		libcthreads_internal_atomic_store
+#define libcthreads_internal_atomic_exchange_pointer		libcthreads_internal_atomic_exchange
+#define libcthreads_internal_atomic_compare_exchange_pointer	libcthreads_internal_atomic_compare_exchange
+
+#define libcthreads_internal_atomic_thread_fence( memory_order ) \
+	__atomic_thread_fence( memory_order )
+
+#if defined( __i386__ ) || defined( __x86_64__ )
+#define libcthreads_internal_atomic_cpu_relax() \
+	__builtin_ia32_pause()
+
+#elif defined( __aarch64__ ) || ( defined( __ARM_ARCH ) && ( __ARM_ARCH >= 7 ) )
+#define libcthreads_internal_atomic_cpu_relax() \
+	__asm__ __volatile__( "yield" ::: "memory" )
+
+#else
+#define libcthreads_internal_atomic_cpu_relax() \
+	__asm__ __volatile__( "" ::: "memory" )
+
+#endif
+
+#endif /* defined( WINAPI ) */
+
+LIBCTHREADS_EXTERN \
+uint32_t libcthreads_atomic_load_32(
+          volatile uint32_t *value,
+          int memory_order );
+
+LIBCTHREADS_EXTERN \
+void libcthreads_atomic_store_32(
+      volatile uint32_t *value,
+      uint32_t new_value,
+      int memory_order );
+
+LIBCTHREADS_EXTERN \
+uint32_t libcthreads_atomic_exchange_32(
+          volatile uint32_t *value,
+          uint32_t new_value,
+          int memory_order );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_atomic_compare_exchange_32(
+     volatile uint32_t *value,
+     uint32_t *expected_value,
+     uint32_t new_value,
+     int memory_order );
+
+LIBCTHREADS_EXTERN \
+uint32_t libcthreads_atomic_fetch_add_32(
+          volatile uint32_t *value,
+          uint32_t addend,
+          int memory_order );
+
+LIBCTHREADS_EXTERN \
+uint32_t libcthreads_atomic_fetch_or_32(
+          volatile uint32_t *value,
+          uint32_t mask,
+          int memory_order );
+
+LIBCTHREADS_EXTERN \
+uint64_t libcthreads_atomic_load_64(
+          volatile uint64_t *value,
+          int memory_order );
+
+LIBCTHREADS_EXTERN \
+void libcthreads_atomic_store_64(
+      volatile uint64_t *value,
+      uint64_t new_value,
+      int memory_order );
+
+LIBCTHREADS_EXTERN \
+uint64_t libcthreads_atomic_exchange_64(
+          volatile uint64_t *value,
+          uint64_t new_value,
+          int memory_order );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_atomic_compare_exchange_64(
+     volatile uint64_t *value,
+     uint64_t *expected_value,
+     uint64_t new_value,
+     int memory_order );
+
+LIBCTHREADS_EXTERN \
+uint64_t libcthreads_atomic_fetch_add_64(
+          volatile uint64_t *value,
+          uint64_t addend,
+          int memory_order );
+
+LIBCTHREADS_EXTERN \
+uint64_t libcthreads_atomic_fetch_or_64(
+          volatile uint64_t *value,
+          uint64_t mask,
+          int memory_order );
+
+LIBCTHREADS_EXTERN \
+intptr_t *libcthreads_atomic_load_pointer(
+           intptr_t * volatile *value,
+           int memory_order );
+
+LIBCTHREADS_EXTERN \
+void libcthreads_atomic_store_pointer(
+      intptr_t * volatile *value,
+      intptr_t *new_value,
+      int memory_order );
+
+LIBCTHREADS_EXTERN \
+intptr_t *libcthreads_atomic_exchange_pointer(
+           intptr_t * volatile *value,
+           intptr_t *new_value,
+           int memory_order );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_atomic_compare_exchange_pointer(
+     intptr_t * volatile *value,
+     intptr_t **expected_value,
+     intptr_t *new_value,
+     int memory_order );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_atomic_compare_exchange_double_width(
+     volatile libcthreads_atomic_double_width_t *value,
+     libcthreads_atomic_double_width_t *expected_value,
+     libcthreads_atomic_double_width_t *new_value );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_atomic_is_lock_free(
+     size_t value_size );
+
+LIBCTHREADS_EXTERN \
+void libcthreads_atomic_thread_fence(
+      int memory_order );
+
+LIBCTHREADS_EXTERN \
+void libcthreads_atomic_cpu_relax(
+      void );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_ATOMIC_H ) */
+
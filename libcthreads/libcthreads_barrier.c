@@ -0,0 +1,437 @@
+/*
+ * Barrier functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libcthreads_atomic.h"
+#include "libcthreads_barrier.h"
+#include "libcthreads_condition.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_mutex.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The sense is only changed while holding the condition mutex, but is read
+ * without the mutex by threads that spin before sleeping on the condition
+ */
+#if defined( WINAPI )
+#define libcthreads_barrier_get_sense( internal_barrier ) \
+	(int) InterlockedCompareExchange( &( ( internal_barrier )->sense ), 0, 0 )
+
+#define libcthreads_barrier_set_sense( internal_barrier, value ) \
+	InterlockedExchange( &( ( internal_barrier )->sense ), (LONG) ( value ) )
+
+#elif defined( __GNUC__ ) || defined( __clang__ )
+#define libcthreads_barrier_get_sense( internal_barrier ) \
+	__atomic_load_n( &( ( internal_barrier )->sense ), __ATOMIC_ACQUIRE )
+
+#define libcthreads_barrier_set_sense( internal_barrier, value ) \
+	__atomic_store_n( &( ( internal_barrier )->sense ), value, __ATOMIC_RELEASE )
+
+#else
+#define libcthreads_barrier_set_sense( internal_barrier, value ) \
+	( internal_barrier )->sense = value
+
+#endif
+
+/* Creates a barrier
+ * Make sure the value barrier is referencing, is set to NULL
+ *
+ * The spin_count is the number of times a waiting thread checks if the barrier
+ * has opened before it goes to sleep, where 0 represents sleep immediately
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_barrier_initialize(
+     libcthreads_barrier_t **barrier,
+     int number_of_threads,
+     int spin_count,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_barrier_t *internal_barrier = NULL;
+	static char *function                            = "libcthreads_barrier_initialize";
+
+	if( barrier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid barrier.",
+		 function );
+
+		return( -1 );
+	}
+	if( *barrier != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid barrier value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of threads value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( spin_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid spin count value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	internal_barrier = memory_allocate_structure(
+	                    libcthreads_internal_barrier_t );
+
+	if( internal_barrier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create barrier.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_barrier,
+	     0,
+	     sizeof( libcthreads_internal_barrier_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear barrier.",
+		 function );
+
+		memory_free(
+		 internal_barrier );
+
+		return( -1 );
+	}
+	internal_barrier->number_of_threads = number_of_threads;
+	internal_barrier->spin_count        = spin_count;
+
+	if( libcthreads_mutex_initialize(
+	     &( internal_barrier->condition_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( internal_barrier->open_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create open condition.",
+		 function );
+
+		goto on_error;
+	}
+	*barrier = (libcthreads_barrier_t *) internal_barrier;
+
+	return( 1 );
+
+on_error:
+	if( internal_barrier != NULL )
+	{
+		if( internal_barrier->condition_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_barrier->condition_mutex ),
+			 NULL );
+		}
+		memory_free(
+		 internal_barrier );
+	}
+	return( -1 );
+}
+
+/* Frees a barrier
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_barrier_free(
+     libcthreads_barrier_t **barrier,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_barrier_t *internal_barrier = NULL;
+	static char *function                            = "libcthreads_barrier_free";
+	int result                                       = 1;
+
+	if( barrier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid barrier.",
+		 function );
+
+		return( -1 );
+	}
+	if( *barrier != NULL )
+	{
+		internal_barrier = (libcthreads_internal_barrier_t *) *barrier;
+		*barrier         = NULL;
+
+		if( libcthreads_condition_free(
+		     &( internal_barrier->open_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free open condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( internal_barrier->condition_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_barrier );
+	}
+	return( result );
+}
+
+/* Waits until the number of threads of the barrier have arrived
+ * The barrier is reset when it opens and can be reused immediately
+ *
+ * Only the last thread to arrive does the work of opening the barrier and
+ * the condition is only broadcast if other threads went to sleep on it
+ *
+ * Returns 1 if the calling thread was the last to arrive, 0 if not or -1 on error
+ */
+int libcthreads_barrier_wait(
+     libcthreads_barrier_t *barrier,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_barrier_t *internal_barrier = NULL;
+	static char *function                            = "libcthreads_barrier_wait";
+	int local_sense                                  = 0;
+
+#if defined( libcthreads_barrier_get_sense )
+	int spin_iterator                                = 0;
+#endif
+
+	if( barrier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid barrier.",
+		 function );
+
+		return( -1 );
+	}
+	internal_barrier = (libcthreads_internal_barrier_t *) barrier;
+
+	if( libcthreads_mutex_grab(
+	     internal_barrier->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	local_sense = (int) internal_barrier->sense;
+
+	internal_barrier->number_of_arrived_threads++;
+
+	if( internal_barrier->number_of_arrived_threads >= internal_barrier->number_of_threads )
+	{
+		internal_barrier->number_of_arrived_threads = 0;
+
+		libcthreads_barrier_set_sense(
+		 internal_barrier,
+		 !local_sense );
+
+		if( internal_barrier->number_of_sleeping_threads > 0 )
+		{
+			/* The condition broadcast must be protected by the mutex for the WINAPI version
+			 */
+			if( libcthreads_condition_broadcast(
+			     internal_barrier->open_condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast open condition.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     internal_barrier->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#if defined( libcthreads_barrier_get_sense )
+	if( internal_barrier->spin_count > 0 )
+	{
+		if( libcthreads_mutex_release(
+		     internal_barrier->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+		for( spin_iterator = 0;
+		     spin_iterator < internal_barrier->spin_count;
+		     spin_iterator++ )
+		{
+			if( libcthreads_barrier_get_sense( internal_barrier ) != local_sense )
+			{
+				return( 0 );
+			}
+			libcthreads_internal_atomic_cpu_relax();
+		}
+		if( libcthreads_mutex_grab(
+		     internal_barrier->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif /* defined( libcthreads_barrier_get_sense ) */
+
+	internal_barrier->number_of_sleeping_threads++;
+
+	while( (int) internal_barrier->sense == local_sense )
+	{
+		if( libcthreads_condition_wait(
+		     internal_barrier->open_condition,
+		     internal_barrier->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for open condition.",
+			 function );
+
+			internal_barrier->number_of_sleeping_threads--;
+
+			goto on_error;
+		}
+	}
+	internal_barrier->number_of_sleeping_threads--;
+
+	if( libcthreads_mutex_release(
+	     internal_barrier->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_barrier->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,100 @@
+/*
+ * Barrier functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_BARRIER_H )
+#define _LIBCTHREADS_INTERNAL_BARRIER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct libcthreads_internal_barrier libcthreads_internal_barrier_t;
+
+struct libcthreads_internal_barrier
+{
+	/* The number of threads that need to arrive at the barrier
+	 */
+	int number_of_threads;
+
+	/* The number of threads that have arrived at the barrier
+	 */
+	int number_of_arrived_threads;
+
+	/* The number of threads sleeping on the condition
+	 */
+	int number_of_sleeping_threads;
+
+	/* The number of times a waiting thread checks the sense
+	 * before it sleeps on the condition
+	 */
+	int spin_count;
+
+	/* The sense, which is flipped every time the barrier opens
+	 */
+#if defined( WINAPI )
+	volatile LONG sense;
+#else
+	volatile int sense;
+#endif
+
+	/* The condition mutex
+	 */
+	libcthreads_mutex_t *condition_mutex;
+
+	/* The barrier open condition
+	 */
+	libcthreads_condition_t *open_condition;
+};
+
+LIBCTHREADS_EXTERN \
+int libcthreads_barrier_initialize(
+     libcthreads_barrier_t **barrier,
+     int number_of_threads,
+     int spin_count,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_barrier_free(
+     libcthreads_barrier_t **barrier,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_barrier_wait(
+     libcthreads_barrier_t *barrier,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_BARRIER_H ) */
+
@@ -0,0 +1,1549 @@
+/*
+ * Channel functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libcthreads_channel.h"
+#include "libcthreads_condition.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_mutex.h"
+#include "libcthreads_queue.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a channel
+ * Make sure the value channel is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_channel_initialize(
+     libcthreads_channel_t **channel,
+     int maximum_number_of_values,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_channel_t *internal_channel = NULL;
+	static char *function                            = "libcthreads_channel_initialize";
+
+	if( channel == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channel.",
+		 function );
+
+		return( -1 );
+	}
+	if( *channel != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid channel value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_values <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of values value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	internal_channel = memory_allocate_structure(
+	                    libcthreads_internal_channel_t );
+
+	if( internal_channel == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create channel.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_channel,
+	     0,
+	     sizeof( libcthreads_internal_channel_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear channel.",
+		 function );
+
+		memory_free(
+		 internal_channel );
+
+		return( -1 );
+	}
+	if( libcthreads_queue_initialize(
+	     &( internal_channel->queue ),
+	     maximum_number_of_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create queue.",
+		 function );
+
+		goto on_error;
+	}
+	*channel = (libcthreads_channel_t *) internal_channel;
+
+	return( 1 );
+
+on_error:
+	if( internal_channel != NULL )
+	{
+		memory_free(
+		 internal_channel );
+	}
+	return( -1 );
+}
+
+/* Frees a channel
+ * Uses the value_free_function to free the values that were not received
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_channel_free(
+     libcthreads_channel_t **channel,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libcthreads_internal_channel_t *internal_channel = NULL;
+	static char *function                            = "libcthreads_channel_free";
+	int result                                       = 1;
+
+	if( channel == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channel.",
+		 function );
+
+		return( -1 );
+	}
+	if( *channel != NULL )
+	{
+		internal_channel = (libcthreads_internal_channel_t *) *channel;
+		*channel         = NULL;
+
+		if( libcthreads_queue_free(
+		     &( internal_channel->queue ),
+		     value_free_function,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free queue.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_channel );
+	}
+	return( result );
+}
+
+/* Closes a channel
+ * After a channel is closed no more values can be sent, the values that are
+ * still in the channel can be received after which the channel reports end of stream.
+ * Closing a channel wakes up all threads waiting to send or receive.
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_channel_close(
+     libcthreads_channel_t *channel,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_channel_t *internal_channel = NULL;
+	libcthreads_internal_queue_t *internal_queue     = NULL;
+	static char *function                            = "libcthreads_channel_close";
+
+	if( channel == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channel.",
+		 function );
+
+		return( -1 );
+	}
+	internal_channel = (libcthreads_internal_channel_t *) channel;
+	internal_queue   = (libcthreads_internal_queue_t *) internal_channel->queue;
+
+	if( libcthreads_mutex_grab(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_channel->is_closed == 0 )
+	{
+		internal_channel->is_closed = 1;
+
+		/* The condition broadcast must be protected by the mutex for the WINAPI version
+		 */
+		if( libcthreads_condition_broadcast(
+		     internal_queue->empty_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast empty condition.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_condition_broadcast(
+		     internal_queue->full_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast full condition.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_internal_channel_notify_selectors(
+		     internal_channel,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to notify selectors.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_queue->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Determines if the channel reached end of stream
+ * A channel reaches end of stream when it is closed and all its values were received
+ * Returns 1 if end of stream, 0 if not or -1 on error
+ */
+int libcthreads_channel_is_end_of_stream(
+     libcthreads_channel_t *channel,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_channel_t *internal_channel = NULL;
+	libcthreads_internal_queue_t *internal_queue     = NULL;
+	static char *function                            = "libcthreads_channel_is_end_of_stream";
+	int result                                       = 0;
+
+	if( channel == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channel.",
+		 function );
+
+		return( -1 );
+	}
+	internal_channel = (libcthreads_internal_channel_t *) channel;
+	internal_queue   = (libcthreads_internal_queue_t *) internal_channel->queue;
+
+	if( libcthreads_mutex_grab(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_channel->is_closed != 0 )
+	 && ( internal_queue->number_of_values == 0 ) )
+	{
+		result = 1;
+	}
+	if( libcthreads_mutex_release(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Notifies the selectors waiting on the channel
+ * The condition mutex of the queue must be held by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_channel_notify_selectors(
+     libcthreads_internal_channel_t *internal_channel,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_channel_selector_element_t *selector_element = NULL;
+	libcthreads_internal_channel_selector_t *selector                 = NULL;
+	static char *function                                             = "libcthreads_internal_channel_notify_selectors";
+
+	if( internal_channel == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channel.",
+		 function );
+
+		return( -1 );
+	}
+	for( selector_element = internal_channel->first_selector_element;
+	     selector_element != NULL;
+	     selector_element = selector_element->next_element )
+	{
+		selector = selector_element->selector;
+
+		if( libcthreads_mutex_grab(
+		     selector->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab selector condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+		selector->is_ready = 1;
+
+		/* The condition signal must be protected by the mutex for the WINAPI version
+		 */
+		if( libcthreads_condition_signal(
+		     selector->ready_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal selector ready condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 selector->condition_mutex,
+			 NULL );
+
+			return( -1 );
+		}
+		if( libcthreads_mutex_release(
+		     selector->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release selector condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Tries to send a value over the channel
+ * Returns 1 if successful, 0 if the channel is full or -1 on error
+ */
+int libcthreads_channel_try_send(
+     libcthreads_channel_t *channel,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_channel_t *internal_channel = NULL;
+	libcthreads_internal_queue_t *internal_queue     = NULL;
+	static char *function                            = "libcthreads_channel_try_send";
+	uint32_t error_code                              = 0;
+	int result                                       = 1;
+
+	if( channel == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channel.",
+		 function );
+
+		return( -1 );
+	}
+	internal_channel = (libcthreads_internal_channel_t *) channel;
+	internal_queue   = (libcthreads_internal_queue_t *) internal_channel->queue;
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_channel->is_closed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid channel - channel is closed.",
+		 function );
+
+		goto on_error;
+	}
+	result = libcthreads_internal_queue_push_locked(
+	          internal_queue,
+	          value,
+	          0,
+	          NULL,
+	          &error_code );
+
+	if( result == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push value onto queue.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libcthreads_internal_channel_notify_selectors(
+		     internal_channel,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to notify selectors.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_queue->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Sends a value over the channel
+ * Waits while the channel is full
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_channel_send(
+     libcthreads_channel_t *channel,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_channel_t *internal_channel = NULL;
+	libcthreads_internal_queue_t *internal_queue     = NULL;
+	static char *function                            = "libcthreads_channel_send";
+	uint32_t error_code                              = 0;
+	int result                                       = 0;
+
+	if( channel == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channel.",
+		 function );
+
+		return( -1 );
+	}
+	internal_channel = (libcthreads_internal_channel_t *) channel;
+	internal_queue   = (libcthreads_internal_queue_t *) internal_channel->queue;
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_internal_queue_push_locked(
+	          internal_queue,
+	          value,
+	          1,
+	          &( internal_channel->is_closed ),
+	          &error_code );
+
+	if( result == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push value onto queue.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid channel - channel is closed.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_internal_channel_notify_selectors(
+	     internal_channel,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to notify selectors.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_queue->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Tries to receive a value from the channel
+ * Sets is_end_of_stream if the channel is closed and no values remain
+ * Returns 1 if successful, 0 if no value is available or -1 on error
+ */
+int libcthreads_internal_channel_try_receive(
+     libcthreads_internal_channel_t *internal_channel,
+     intptr_t **value,
+     uint8_t *is_end_of_stream,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_queue_t *internal_queue = NULL;
+	static char *function                        = "libcthreads_internal_channel_try_receive";
+	uint32_t error_code                          = 0;
+	int result                                   = 0;
+
+	if( internal_channel == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channel.",
+		 function );
+
+		return( -1 );
+	}
+	internal_queue = (libcthreads_internal_queue_t *) internal_channel->queue;
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_end_of_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is end of stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*is_end_of_stream = 0;
+
+	result = libcthreads_internal_queue_pop_locked(
+	          internal_queue,
+	          value,
+	          0,
+	          NULL,
+	          &error_code );
+
+	if( result == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop value off queue.",
+		 function );
+
+		goto on_error;
+	}
+	else if( ( result == 0 )
+	      && ( internal_channel->is_closed != 0 ) )
+	{
+		*is_end_of_stream = 1;
+	}
+	if( libcthreads_mutex_release(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_queue->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Tries to receive a value from the channel
+ * Use libcthreads_channel_is_end_of_stream to distinguish an empty channel from end of stream
+ * Returns 1 if successful, 0 if no value is available or -1 on error
+ */
+int libcthreads_channel_try_receive(
+     libcthreads_channel_t *channel,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function    = "libcthreads_channel_try_receive";
+	uint8_t is_end_of_stream = 0;
+	int result               = 0;
+
+	if( channel == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channel.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_internal_channel_try_receive(
+	          (libcthreads_internal_channel_t *) channel,
+	          value,
+	          &is_end_of_stream,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to receive value.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Receives a value from the channel
+ * Waits while the channel is empty and not closed
+ * Returns 1 if successful, 0 if end of stream or -1 on error
+ */
+int libcthreads_channel_receive(
+     libcthreads_channel_t *channel,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_channel_t *internal_channel = NULL;
+	libcthreads_internal_queue_t *internal_queue     = NULL;
+	static char *function                            = "libcthreads_channel_receive";
+	uint32_t error_code                              = 0;
+	int result                                       = 0;
+
+	if( channel == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channel.",
+		 function );
+
+		return( -1 );
+	}
+	internal_channel = (libcthreads_internal_channel_t *) channel;
+	internal_queue   = (libcthreads_internal_queue_t *) internal_channel->queue;
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_internal_queue_pop_locked(
+	          internal_queue,
+	          value,
+	          1,
+	          &( internal_channel->is_closed ),
+	          &error_code );
+
+	if( result == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop value off queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_queue->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Tries to receive a value from one of the channels
+ * The channels are checked in order
+ * End of stream is reported as by libcthreads_channel_select
+ * Returns 1 if successful, 0 if no value is available, 2 if all channels reached end of stream or -1 on error
+ */
+int libcthreads_channel_try_select(
+     libcthreads_channel_t **channels,
+     int number_of_channels,
+     int *channel_index,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function        = "libcthreads_channel_try_select";
+	uint8_t is_end_of_stream     = 0;
+	int index                    = 0;
+	int number_of_end_of_streams = 0;
+	int result                   = 0;
+
+	if( channels == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channels.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_channels <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of channels value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( channel_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channel index.",
+		 function );
+
+		return( -1 );
+	}
+	for( index = 0;
+	     index < number_of_channels;
+	     index++ )
+	{
+		result = libcthreads_internal_channel_try_receive(
+		          (libcthreads_internal_channel_t *) channels[ index ],
+		          value,
+		          &is_end_of_stream,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to receive value from channel: %d.",
+			 function,
+			 index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			*channel_index = index;
+
+			return( 1 );
+		}
+		if( is_end_of_stream != 0 )
+		{
+			number_of_end_of_streams++;
+		}
+	}
+	if( number_of_end_of_streams == number_of_channels )
+	{
+		return( 2 );
+	}
+	return( 0 );
+}
+
+/* Unregisters the selector elements from the channels
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_channel_unregister_selector_elements(
+     libcthreads_channel_t **channels,
+     int number_of_channels,
+     libcthreads_internal_channel_selector_element_t *selector_elements,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_channel_t *internal_channel = NULL;
+	libcthreads_internal_queue_t *internal_queue     = NULL;
+	static char *function                            = "libcthreads_internal_channel_unregister_selector_elements";
+	int index                                        = 0;
+	int result                                       = 1;
+
+	if( channels == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channels.",
+		 function );
+
+		return( -1 );
+	}
+	if( selector_elements == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid selector elements.",
+		 function );
+
+		return( -1 );
+	}
+	for( index = 0;
+	     index < number_of_channels;
+	     index++ )
+	{
+		internal_channel = (libcthreads_internal_channel_t *) channels[ index ];
+		internal_queue   = (libcthreads_internal_queue_t *) internal_channel->queue;
+
+		if( libcthreads_mutex_grab(
+		     internal_queue->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab condition mutex of channel: %d.",
+			 function,
+			 index );
+
+			result = -1;
+
+			continue;
+		}
+		if( selector_elements[ index ].previous_element != NULL )
+		{
+			selector_elements[ index ].previous_element->next_element = selector_elements[ index ].next_element;
+		}
+		else
+		{
+			internal_channel->first_selector_element = selector_elements[ index ].next_element;
+		}
+		if( selector_elements[ index ].next_element != NULL )
+		{
+			selector_elements[ index ].next_element->previous_element = selector_elements[ index ].previous_element;
+		}
+		if( libcthreads_mutex_release(
+		     internal_queue->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex of channel: %d.",
+			 function,
+			 index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Receives a value from one of the channels
+ * Waits until one of the channels has a value or all channels reached end of stream
+ * The channels are checked in order
+ * End of stream is reported as by libcthreads_channel_try_select
+ * Returns 1 if successful, 2 if all channels reached end of stream or -1 on error
+ */
+int libcthreads_channel_select(
+     libcthreads_channel_t **channels,
+     int number_of_channels,
+     int *channel_index,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_channel_selector_t selector;
+
+	libcthreads_internal_channel_selector_element_t *selector_elements = NULL;
+	libcthreads_internal_channel_t *internal_channel                   = NULL;
+	libcthreads_internal_queue_t *internal_queue                       = NULL;
+	static char *function                                              = "libcthreads_channel_select";
+	size_t selector_elements_size                                      = 0;
+	uint8_t is_end_of_stream                                           = 0;
+	int index                                                          = 0;
+	int number_of_end_of_streams                                       = 0;
+	int number_of_registered_channels                                  = 0;
+	int result                                                         = 0;
+
+	if( channels == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channels.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_channels <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of channels value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if SIZEOF_INT <= SIZEOF_SIZE_T
+	if( (size_t) number_of_channels > (size_t) ( SSIZE_MAX / sizeof( libcthreads_internal_channel_selector_element_t ) ) )
+#else
+	if( number_of_channels > (int) ( SSIZE_MAX / sizeof( libcthreads_internal_channel_selector_element_t ) ) )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of channels value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( channel_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid channel index.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &selector,
+	     0,
+	     sizeof( libcthreads_internal_channel_selector_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear selector.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check the channels first, so that the selector is only created when
+	 * the calling thread needs to wait
+	 */
+	for( index = 0;
+	     index < number_of_channels;
+	     index++ )
+	{
+		result = libcthreads_internal_channel_try_receive(
+		          (libcthreads_internal_channel_t *) channels[ index ],
+		          value,
+		          &is_end_of_stream,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to receive value from channel: %d.",
+			 function,
+			 index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			*channel_index = index;
+
+			return( 1 );
+		}
+		if( is_end_of_stream != 0 )
+		{
+			number_of_end_of_streams++;
+		}
+	}
+	if( number_of_end_of_streams == number_of_channels )
+	{
+		return( 2 );
+	}
+	selector_elements_size = sizeof( libcthreads_internal_channel_selector_element_t ) * number_of_channels;
+
+	selector_elements = (libcthreads_internal_channel_selector_element_t *) memory_allocate(
+	                                                                         selector_elements_size );
+
+	if( selector_elements == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create selector elements.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     selector_elements,
+	     0,
+	     selector_elements_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear selector elements.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( selector.condition_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create selector condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( selector.ready_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create selector ready condition.",
+		 function );
+
+		goto on_error;
+	}
+	/* Register the selector with every channel so that a value sent or a close
+	 * after the channel has been checked wakes up the calling thread
+	 */
+	for( number_of_registered_channels = 0;
+	     number_of_registered_channels < number_of_channels;
+	     number_of_registered_channels++ )
+	{
+		internal_channel = (libcthreads_internal_channel_t *) channels[ number_of_registered_channels ];
+		internal_queue   = (libcthreads_internal_queue_t *) internal_channel->queue;
+
+		if( libcthreads_mutex_grab(
+		     internal_queue->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab condition mutex of channel: %d.",
+			 function,
+			 number_of_registered_channels );
+
+			goto on_error;
+		}
+		selector_elements[ number_of_registered_channels ].selector     = &selector;
+		selector_elements[ number_of_registered_channels ].next_element = internal_channel->first_selector_element;
+
+		if( internal_channel->first_selector_element != NULL )
+		{
+			internal_channel->first_selector_element->previous_element = &( selector_elements[ number_of_registered_channels ] );
+		}
+		internal_channel->first_selector_element = &( selector_elements[ number_of_registered_channels ] );
+
+		if( libcthreads_mutex_release(
+		     internal_queue->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex of channel: %d.",
+			 function,
+			 number_of_registered_channels );
+
+			number_of_registered_channels++;
+
+			goto on_error;
+		}
+	}
+	result = 0;
+
+	while( result == 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     selector.condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab selector condition mutex.",
+			 function );
+
+			goto on_error;
+		}
+		selector.is_ready = 0;
+
+		if( libcthreads_mutex_release(
+		     selector.condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release selector condition mutex.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_end_of_streams = 0;
+
+		for( index = 0;
+		     index < number_of_channels;
+		     index++ )
+		{
+			result = libcthreads_internal_channel_try_receive(
+			          (libcthreads_internal_channel_t *) channels[ index ],
+			          value,
+			          &is_end_of_stream,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to receive value from channel: %d.",
+				 function,
+				 index );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				*channel_index = index;
+
+				break;
+			}
+			if( is_end_of_stream != 0 )
+			{
+				number_of_end_of_streams++;
+			}
+		}
+		if( number_of_end_of_streams == number_of_channels )
+		{
+			result = 2;
+		}
+		if( result != 0 )
+		{
+			break;
+		}
+		if( libcthreads_mutex_grab(
+		     selector.condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab selector condition mutex.",
+			 function );
+
+			goto on_error;
+		}
+		while( selector.is_ready == 0 )
+		{
+			if( libcthreads_condition_wait(
+			     selector.ready_condition,
+			     selector.condition_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for selector ready condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 selector.condition_mutex,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     selector.condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release selector condition mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_internal_channel_unregister_selector_elements(
+	     channels,
+	     number_of_registered_channels,
+	     selector_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to unregister selector elements.",
+		 function );
+
+		number_of_registered_channels = 0;
+
+		goto on_error;
+	}
+	number_of_registered_channels = 0;
+
+	if( libcthreads_condition_free(
+	     &( selector.ready_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free selector ready condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_free(
+	     &( selector.condition_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free selector condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 selector_elements );
+
+	return( result );
+
+on_error:
+	if( number_of_registered_channels > 0 )
+	{
+		libcthreads_internal_channel_unregister_selector_elements(
+		 channels,
+		 number_of_registered_channels,
+		 selector_elements,
+		 NULL );
+	}
+	if( selector.ready_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &( selector.ready_condition ),
+		 NULL );
+	}
+	if( selector.condition_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( selector.condition_mutex ),
+		 NULL );
+	}
+	if( selector_elements != NULL )
+	{
+		memory_free(
+		 selector_elements );
+	}
+	return( -1 );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,177 @@
+/*
+ * Channel functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_CHANNEL_H )
+#define _LIBCTHREADS_INTERNAL_CHANNEL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct libcthreads_internal_channel_selector libcthreads_internal_channel_selector_t;
+
+struct libcthreads_internal_channel_selector
+{
+	/* The condition mutex
+	 */
+	libcthreads_mutex_t *condition_mutex;
+
+	/* The ready condition
+	 */
+	libcthreads_condition_t *ready_condition;
+
+	/* Value to indicate one of the channels changed state
+	 */
+	uint8_t is_ready;
+};
+
+typedef struct libcthreads_internal_channel_selector_element libcthreads_internal_channel_selector_element_t;
+
+struct libcthreads_internal_channel_selector_element
+{
+	/* The selector
+	 */
+	libcthreads_internal_channel_selector_t *selector;
+
+	/* The previous element
+	 */
+	libcthreads_internal_channel_selector_element_t *previous_element;
+
+	/* The next element
+	 */
+	libcthreads_internal_channel_selector_element_t *next_element;
+};
+
+typedef struct libcthreads_internal_channel libcthreads_internal_channel_t;
+
+struct libcthreads_internal_channel
+{
+	/* The queue that contains the values
+	 * The channel uses the condition mutex and conditions of the queue
+	 */
+	libcthreads_queue_t *queue;
+
+	/* The first selector element
+	 */
+	libcthreads_internal_channel_selector_element_t *first_selector_element;
+
+	/* Value to indicate the channel was closed
+	 */
+	uint8_t is_closed;
+};
+
+LIBCTHREADS_EXTERN \
+int libcthreads_channel_initialize(
+     libcthreads_channel_t **channel,
+     int maximum_number_of_values,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_channel_free(
+     libcthreads_channel_t **channel,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_channel_close(
+     libcthreads_channel_t *channel,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_channel_is_end_of_stream(
+     libcthreads_channel_t *channel,
+     libcerror_error_t **error );
+
+int libcthreads_internal_channel_notify_selectors(
+     libcthreads_internal_channel_t *internal_channel,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_channel_try_send(
+     libcthreads_channel_t *channel,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_channel_send(
+     libcthreads_channel_t *channel,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+int libcthreads_internal_channel_try_receive(
+     libcthreads_internal_channel_t *internal_channel,
+     intptr_t **value,
+     uint8_t *is_end_of_stream,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_channel_try_receive(
+     libcthreads_channel_t *channel,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_channel_receive(
+     libcthreads_channel_t *channel,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_channel_try_select(
+     libcthreads_channel_t **channels,
+     int number_of_channels,
+     int *channel_index,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+int libcthreads_internal_channel_unregister_selector_elements(
+     libcthreads_channel_t **channels,
+     int number_of_channels,
+     libcthreads_internal_channel_selector_element_t *selector_elements,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_channel_select(
+     libcthreads_channel_t **channels,
+     int number_of_channels,
+     int *channel_index,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_CHANNEL_H ) */
+
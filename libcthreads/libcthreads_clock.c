@@ -0,0 +1,329 @@
+/*
+ * Clock functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include <errno.h>
+
+#if ( defined( HAVE_CLOCK_GETTIME ) || defined( HAVE_NANOSLEEP ) ) && !defined( WINAPI )
+#include <time.h>
+#endif
+
+#if !defined( HAVE_CLOCK_GETTIME ) && defined( HAVE_SYS_TIME_H ) && !defined( WINAPI )
+#include <sys/time.h>
+#endif
+
+#if !defined( HAVE_NANOSLEEP ) && defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <sched.h>
+#endif
+
+#include "libcthreads_clock.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_unused.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Retrieves the current time of the monotonic clock
+ * The time is in nanoseconds since an unspecified starting point and
+ * is not affected by changes of the system (wall clock) time
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_clock_get_monotonic_time(
+     uint64_t *monotonic_time,
+     libcerror_error_t **error )
+{
+	static char *function   = "libcthreads_clock_get_monotonic_time";
+
+#if defined( WINAPI )
+	LARGE_INTEGER counter   = { 0 };
+	LARGE_INTEGER frequency = { 0 };
+	DWORD error_code        = 0;
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_specification;
+
+#else
+	struct timeval time_value;
+#endif
+
+	if( monotonic_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid monotonic time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	/* Split the conversion to prevent the multiplication from overflowing
+	 */
+	*monotonic_time = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000000UL )
+	                + ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000000UL / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_specification ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 errno,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic clock time.",
+		 function );
+
+		return( -1 );
+	}
+	*monotonic_time = ( (uint64_t) time_specification.tv_sec * 1000000000UL )
+	                + (uint64_t) time_specification.tv_nsec;
+
+#else
+	/* Without a monotonic clock fall back to the system time
+	 */
+	if( gettimeofday(
+	     &time_value,
+	     NULL ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 errno,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve time of day.",
+		 function );
+
+		return( -1 );
+	}
+	*monotonic_time = ( (uint64_t) time_value.tv_sec * 1000000000UL )
+	                + ( (uint64_t) time_value.tv_usec * 1000 );
+#endif
+	return( 1 );
+}
+
+/* Determines the deadline that is timeout nanoseconds from now on the monotonic clock
+ * The deadline is capped at UINT64_MAX
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_clock_get_deadline(
+     uint64_t timeout,
+     uint64_t *deadline,
+     libcerror_error_t **error )
+{
+	static char *function   = "libcthreads_clock_get_deadline";
+	uint64_t monotonic_time = 0;
+
+	if( deadline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid deadline.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_clock_get_monotonic_time(
+	     &monotonic_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic time.",
+		 function );
+
+		return( -1 );
+	}
+	if( timeout > ( UINT64_MAX - monotonic_time ) )
+	{
+		*deadline = UINT64_MAX;
+	}
+	else
+	{
+		*deadline = monotonic_time + timeout;
+	}
+	return( 1 );
+}
+
+/* Suspends the calling thread for approximately duration nanoseconds
+ * The thread can resume earlier, e.g. when the sleep is interrupted by a signal
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_clock_sleep(
+     uint64_t duration,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	DWORD duration_in_milliseconds = 0;
+
+#elif defined( HAVE_NANOSLEEP )
+	struct timespec time_specification;
+
+	static char *function          = "libcthreads_clock_sleep";
+#endif
+
+#if defined( WINAPI )
+	LIBCTHREADS_UNREFERENCED_PARAMETER( error )
+
+	/* Round up so the sleep does not end before the duration
+	 */
+	if( duration >= ( (uint64_t) ( INFINITE - 1 ) * 1000000 ) )
+	{
+		duration_in_milliseconds = INFINITE - 1;
+	}
+	else
+	{
+		duration_in_milliseconds = (DWORD) ( ( duration + 999999 ) / 1000000 );
+	}
+	Sleep(
+	 duration_in_milliseconds );
+
+#elif defined( HAVE_NANOSLEEP )
+	time_specification.tv_sec  = (time_t) ( duration / 1000000000UL );
+	time_specification.tv_nsec = (long) ( duration % 1000000000UL );
+
+	if( ( nanosleep(
+	       &time_specification,
+	       NULL ) != 0 )
+	 && ( errno != EINTR ) )
+	{
+		libcerror_system_set_error(
+		 error,
+		 errno,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to sleep.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	/* Without nanosleep give up the remainder of the time slice instead
+	 */
+	LIBCTHREADS_UNREFERENCED_PARAMETER( duration )
+	LIBCTHREADS_UNREFERENCED_PARAMETER( error )
+
+	sched_yield();
+#endif
+	return( 1 );
+}
+
+/* Sleeps for the backoff time but not beyond the deadline on the monotonic clock
+ * The backoff time is doubled, up to the maximum backoff time, for the next call
+ * Returns 1 if successful, 0 if the deadline has passed or -1 on error
+ */
+int libcthreads_clock_backoff_until(
+     uint64_t deadline,
+     uint64_t *backoff_time,
+     libcerror_error_t **error )
+{
+	static char *function   = "libcthreads_clock_backoff_until";
+	uint64_t monotonic_time = 0;
+	uint64_t sleep_time     = 0;
+
+	if( backoff_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid backoff time.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_clock_get_monotonic_time(
+	     &monotonic_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic time.",
+		 function );
+
+		return( -1 );
+	}
+	if( monotonic_time >= deadline )
+	{
+		return( 0 );
+	}
+	if( *backoff_time < LIBCTHREADS_CLOCK_MINIMUM_BACKOFF_TIME )
+	{
+		*backoff_time = LIBCTHREADS_CLOCK_MINIMUM_BACKOFF_TIME;
+	}
+	sleep_time = *backoff_time;
+
+	if( sleep_time > ( deadline - monotonic_time ) )
+	{
+		sleep_time = deadline - monotonic_time;
+	}
+	if( libcthreads_clock_sleep(
+	     sleep_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to sleep.",
+		 function );
+
+		return( -1 );
+	}
+	if( *backoff_time < ( LIBCTHREADS_CLOCK_MAXIMUM_BACKOFF_TIME / 2 ) )
+	{
+		*backoff_time *= 2;
+	}
+	else
+	{
+		*backoff_time = LIBCTHREADS_CLOCK_MAXIMUM_BACKOFF_TIME;
+	}
+	return( 1 );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,69 @@
+/*
+ * Clock functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_CLOCK_H )
+#define _LIBCTHREADS_CLOCK_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The initial and maximum backoff time in nanoseconds between attempts
+ * to grab a lock that does not support waiting for a deadline
+ */
+#define LIBCTHREADS_CLOCK_MINIMUM_BACKOFF_TIME		1000
+#define LIBCTHREADS_CLOCK_MAXIMUM_BACKOFF_TIME		1000000
+
+LIBCTHREADS_EXTERN \
+int libcthreads_clock_get_monotonic_time(
+     uint64_t *monotonic_time,
+     libcerror_error_t **error );
+
+int libcthreads_clock_get_deadline(
+     uint64_t timeout,
+     uint64_t *deadline,
+     libcerror_error_t **error );
+
+int libcthreads_clock_sleep(
+     uint64_t duration,
+     libcerror_error_t **error );
+
+int libcthreads_clock_backoff_until(
+     uint64_t deadline,
+     uint64_t *backoff_time,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_CLOCK_H ) */
+
@@ -33,32 +33,50 @@
 #include <pthread.h>
 #endif
 
+#if defined( HAVE_CLOCK_GETTIME ) && !defined( WINAPI )
+#include <time.h>
+
+#elif defined( HAVE_SYS_TIME_H ) && !defined( WINAPI )
+#include <sys/time.h>
+#endif
+
+#include "libcthreads_clock.h"
 #include "libcthreads_condition.h"
 #include "libcthreads_libcerror.h"
 #include "libcthreads_mutex.h"
+#include "libcthreads_probes.h"
+#include "libcthreads_tracer.h"
 #include "libcthreads_types.h"
+#include "libcthreads_unused.h"
 
 #if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
 
-/* Creates a condition
- * Make sure the value condition is referencing, is set to NULL
+/* Make sure the internal condition fits in the storage for in place initialization
+ */
+typedef char libcthreads_internal_condition_storage_size_check_t[ ( sizeof( libcthreads_internal_condition_t ) <= LIBCTHREADS_CONDITION_STORAGE_SIZE ) ? 1 : -1 ];
+
+/* Initializes a condition in the provided memory
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_condition_initialize(
-     libcthreads_condition_t **condition,
+int libcthreads_internal_condition_initialize(
+     libcthreads_internal_condition_t *internal_condition,
      libcerror_error_t **error )
 {
-	libcthreads_internal_condition_t *internal_condition = NULL;
-	static char *function                                = "libcthreads_condition_initialize";
+	static char *function          = "libcthreads_internal_condition_initialize";
 
 #if defined( WINAPI ) && ( WINVER < 0x0600 )
-	DWORD error_code                                     = 0;
+	DWORD error_code               = 0;
 
 #elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                                   = 0;
+	pthread_condattr_t *attributes = NULL;
+	int pthread_result             = 0;
+
+#if defined( HAVE_PTHREAD_CONDATTR_SETCLOCK ) && defined( HAVE_CLOCK_GETTIME )
+	pthread_condattr_t condition_attributes;
+#endif
 #endif
 
-	if( condition == NULL )
+	if( internal_condition == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -69,31 +87,6 @@ int libcthreads_condition_initialize(
 
 		return( -1 );
 	}
-	if( *condition != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid condition value already set.",
-		 function );
-
-		return( -1 );
-	}
-	internal_condition = memory_allocate_structure(
-	                      libcthreads_internal_condition_t );
-
-	if( internal_condition == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create condition.",
-		 function );
-
-		goto on_error;
-	}
 	if( memory_set(
 	     internal_condition,
 	     0,
@@ -106,9 +99,6 @@ int libcthreads_condition_initialize(
 		 "%s: unable to clear condition.",
 		 function );
 
-		memory_free(
-		 internal_condition );
-
 		return( -1 );
 	}
 #if defined( WINAPI ) && ( WINVER >= 0x0600 )
@@ -161,9 +151,47 @@ int libcthreads_condition_initialize(
 	}
 
 #elif defined( HAVE_PTHREAD_H )
+#if defined( HAVE_PTHREAD_CONDATTR_SETCLOCK ) && defined( HAVE_CLOCK_GETTIME )
+	/* Timed waits use the monotonic clock so they are not affected
+	 * by changes of the system time
+	 */
+	pthread_result = pthread_condattr_init(
+	                  &condition_attributes );
+
+	if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize condition attributes.",
+		 function );
+
+		goto on_error;
+	}
+	attributes = &condition_attributes;
+
+	pthread_result = pthread_condattr_setclock(
+	                  attributes,
+	                  CLOCK_MONOTONIC );
+
+	if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set condition attributes clock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	pthread_result = pthread_cond_init(
 	                  &( internal_condition->condition ),
-	                  NULL );
+	                  attributes );
 
 	switch( pthread_result )
 	{
@@ -191,46 +219,44 @@ int libcthreads_condition_initialize(
 
 			goto on_error;
 	}
+	if( attributes != NULL )
+	{
+		pthread_condattr_destroy(
+		 attributes );
+	}
 #endif
-	*condition = (libcthreads_condition_t *) internal_condition;
-
 	return( 1 );
 
 on_error:
-	if( internal_condition != NULL )
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	if( attributes != NULL )
 	{
-#if defined( WINAPI ) && ( WINVER < 0x0600 )
-		if( internal_condition->signal_semaphore_handle != NULL )
-		{
-			CloseHandle(
-			 internal_condition->signal_semaphore_handle );
-		}
-		DeleteCriticalSection(
-		 &( internal_condition->wait_critical_section ) );
+		pthread_condattr_destroy(
+		 attributes );
+	}
 #endif
-		memory_free(
-		 internal_condition );
+#if defined( WINAPI ) && ( WINVER < 0x0600 )
+	if( internal_condition->signal_semaphore_handle != NULL )
+	{
+		CloseHandle(
+		 internal_condition->signal_semaphore_handle );
 	}
+	DeleteCriticalSection(
+	 &( internal_condition->wait_critical_section ) );
+#endif
 	return( -1 );
 }
 
-/* Frees a condition
+/* Creates a condition
+ * Make sure the value condition is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_condition_free(
+int libcthreads_condition_initialize(
      libcthreads_condition_t **condition,
      libcerror_error_t **error )
 {
 	libcthreads_internal_condition_t *internal_condition = NULL;
-	static char *function                                = "libcthreads_condition_free";
-	int result                                           = 1;
-
-#if defined( WINAPI ) && ( WINVER < 0x0600 )
-	DWORD error_code                                     = 0;
-
-#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                                   = 0;
-#endif
+	static char *function                                = "libcthreads_condition_initialize";
 
 	if( condition == NULL )
 	{
@@ -245,118 +271,73 @@ int libcthreads_condition_free(
 	}
 	if( *condition != NULL )
 	{
-		internal_condition = (libcthreads_internal_condition_t *) *condition;
-		*condition         = NULL;
-
-#if defined( WINAPI ) && ( WINVER >= 0x0600 )
-
-#elif defined( WINAPI )
-		if( CloseHandle(
-		     internal_condition->signal_event_handle ) == 0 )
-		{
-			error_code = GetLastError();
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid condition value already set.",
+		 function );
 
-			libcerror_system_set_error(
-			 error,
-			 error_code,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free signal event handle.",
-			 function );
+		return( -1 );
+	}
+	internal_condition = memory_allocate_structure(
+	                      libcthreads_internal_condition_t );
 
-			result = -1;
-		}
-		if( CloseHandle(
-		     internal_condition->signal_semaphore_handle ) == 0 )
-		{
-			error_code = GetLastError();
+	if( internal_condition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create condition.",
+		 function );
 
-			libcerror_system_set_error(
-			 error,
-			 error_code,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free signal semaphore handle.",
-			 function );
+		goto on_error;
+	}
+	if( libcthreads_internal_condition_initialize(
+	     internal_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize condition.",
+		 function );
 
-			result = -1;
-		}
-		DeleteCriticalSection(
-		 &( internal_condition->wait_critical_section ) );
+		goto on_error;
+	}
+	*condition = (libcthreads_condition_t *) internal_condition;
 
-#elif defined( HAVE_PTHREAD_H )
-		pthread_result = pthread_cond_destroy(
-		                  &( internal_condition->condition ) );
+	return( 1 );
 
-		switch( pthread_result )
-		{
-			case 0:
-				break;
-
-			case EAGAIN:
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to destroy condition with error: Insufficient resources.",
-				 function );
-
-				result = -1;
-				break;
-
-			case EBUSY:
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to destroy condition with error: Resource busy.",
-				 function );
-
-				result = -1;
-				break;
-
-			default:
-				libcerror_system_set_error(
-				 error,
-				 pthread_result,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to destroy condition.",
-				 function );
-
-				result = -1;
-				break;
-		}
-#endif
+on_error:
+	if( internal_condition != NULL )
+	{
 		memory_free(
 		 internal_condition );
 	}
-	return( result );
+	return( -1 );
 }
 
-/* Broadcasts a condition
- * The of this function must be locked by the same mutex as used to wait
- * This is necessary for the WINAPI pre Vista (0x0600) implementation
+/* Finalizes a condition in the provided memory
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_condition_broadcast(
-     libcthreads_condition_t *condition,
+int libcthreads_internal_condition_finalize(
+     libcthreads_internal_condition_t *internal_condition,
      libcerror_error_t **error )
 {
-	libcthreads_internal_condition_t *internal_condition = NULL;
-	static char *function                                = "libcthreads_condition_broadcast";
+	static char *function = "libcthreads_internal_condition_finalize";
+	int result            = 1;
 
 #if defined( WINAPI ) && ( WINVER < 0x0600 )
-	DWORD error_code                                     = 0;
-	DWORD wait_status                                    = 0;
-	BOOL result                                          = 1;
-	int number_of_waiting_threads                        = 0;
+	DWORD error_code      = 0;
 
 #elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                                   = 0;
+	int pthread_result    = 0;
 #endif
 
-	if( condition == NULL )
+	if( internal_condition == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -367,83 +348,577 @@ int libcthreads_condition_broadcast(
 
 		return( -1 );
 	}
-	internal_condition = (libcthreads_internal_condition_t *) condition;
-
 #if defined( WINAPI ) && ( WINVER >= 0x0600 )
-	WakeAllConditionVariable(
-	 &( internal_condition->condition_variable ) );
 
 #elif defined( WINAPI )
-	EnterCriticalSection(
-	 &( internal_condition->wait_critical_section ) );
-
-	number_of_waiting_threads = internal_condition->number_of_waiting_threads;
-
-	if( number_of_waiting_threads > 0 )
+	if( CloseHandle(
+	     internal_condition->signal_event_handle ) == 0 )
 	{
-		internal_condition->signal_is_broadcast = 1;
-
-		result = ReleaseSemaphore(
-		          internal_condition->signal_semaphore_handle,
-		          number_of_waiting_threads,
-		          0 );
+		error_code = GetLastError();
 
-		if( result == 0 )
-		{
-			error_code = GetLastError();
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free signal event handle.",
+		 function );
 
-			internal_condition->signal_is_broadcast = 0;
-		}
+		result = -1;
 	}
-	LeaveCriticalSection(
-	 &( internal_condition->wait_critical_section ) );
-
-	if( result == 0 )
+	if( CloseHandle(
+	     internal_condition->signal_semaphore_handle ) == 0 )
 	{
+		error_code = GetLastError();
+
 		libcerror_system_set_error(
 		 error,
 		 error_code,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release signal semaphore handle.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free signal semaphore handle.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( number_of_waiting_threads > 0 )
+	DeleteCriticalSection(
+	 &( internal_condition->wait_critical_section ) );
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_cond_destroy(
+	                  &( internal_condition->condition ) );
+
+	switch( pthread_result )
 	{
-		wait_status = WaitForSingleObject(
-		               internal_condition->signal_event_handle,
-		               INFINITE );
+		case 0:
+			break;
 
-		if( wait_status == WAIT_FAILED )
-		{
-			error_code = GetLastError();
+		case EAGAIN:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to destroy condition with error: Insufficient resources.",
+			 function );
 
-			internal_condition->signal_is_broadcast = 0;
+			result = -1;
+			break;
+
+		case EBUSY:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to destroy condition with error: Resource busy.",
+			 function );
+
+			result = -1;
+			break;
 
+		default:
 			libcerror_system_set_error(
 			 error,
-			 error_code,
+			 pthread_result,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: wait for no read event handle failed.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to destroy condition.",
 			 function );
 
-			return( -1 );
-		}
-		internal_condition->signal_is_broadcast = 0;
+			result = -1;
+			break;
 	}
+#endif
+	return( result );
+}
+
+/* Frees a condition
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_condition_free(
+     libcthreads_condition_t **condition,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_condition_t *internal_condition = NULL;
+	static char *function                                = "libcthreads_condition_free";
+	int result                                           = 1;
+
+	if( condition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid condition.",
+		 function );
+
+		return( -1 );
+	}
+	if( *condition != NULL )
+	{
+		internal_condition = (libcthreads_internal_condition_t *) *condition;
+		*condition         = NULL;
+
+		if( libcthreads_internal_condition_finalize(
+		     internal_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize condition.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_condition );
+	}
+	return( result );
+}
+
+/* Initializes a condition in caller provided storage
+ * The storage must remain available until the condition is finalized
+ * Make sure the value condition is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_condition_initialize_in_place(
+     libcthreads_condition_t **condition,
+     libcthreads_condition_storage_t *storage,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_condition_t *internal_condition = NULL;
+	static char *function                                = "libcthreads_condition_initialize_in_place";
+
+	if( condition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid condition.",
+		 function );
+
+		return( -1 );
+	}
+	if( *condition != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid condition value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage.",
+		 function );
+
+		return( -1 );
+	}
+	internal_condition = (libcthreads_internal_condition_t *) storage;
+
+	if( libcthreads_internal_condition_initialize(
+	     internal_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize condition.",
+		 function );
+
+		return( -1 );
+	}
+	*condition = (libcthreads_condition_t *) internal_condition;
+
+	return( 1 );
+}
+
+/* Finalizes a condition that was initialized in caller provided storage
+ * The storage itself is not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_condition_finalize_in_place(
+     libcthreads_condition_t **condition,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_condition_t *internal_condition = NULL;
+	static char *function                                = "libcthreads_condition_finalize_in_place";
+
+	if( condition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid condition.",
+		 function );
+
+		return( -1 );
+	}
+	if( *condition != NULL )
+	{
+		internal_condition = (libcthreads_internal_condition_t *) *condition;
+		*condition         = NULL;
+
+		if( libcthreads_internal_condition_finalize(
+		     internal_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize condition.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Broadcasts a condition without an error object
+ * The error code is set to the system error code on error
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_condition_broadcast(
+     libcthreads_internal_condition_t *internal_condition,
+     uint32_t *error_code )
+{
+#if defined( WINAPI ) && ( WINVER < 0x0600 )
+	DWORD wait_status             = 0;
+	BOOL result                   = 1;
+	int number_of_waiting_threads = 0;
+
+#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result            = 0;
+#endif
+
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	LIBCTHREADS_UNREFERENCED_PARAMETER( error_code )
+
+	WakeAllConditionVariable(
+	 &( internal_condition->condition_variable ) );
+
+#elif defined( WINAPI )
+	EnterCriticalSection(
+	 &( internal_condition->wait_critical_section ) );
+
+	number_of_waiting_threads = internal_condition->number_of_waiting_threads;
+
+	if( number_of_waiting_threads > 0 )
+	{
+		internal_condition->signal_is_broadcast = 1;
+
+		result = ReleaseSemaphore(
+		          internal_condition->signal_semaphore_handle,
+		          number_of_waiting_threads,
+		          0 );
+
+		if( result == 0 )
+		{
+			*error_code = (uint32_t) GetLastError();
+
+			internal_condition->signal_is_broadcast = 0;
+		}
+	}
+	LeaveCriticalSection(
+	 &( internal_condition->wait_critical_section ) );
+
+	if( result == 0 )
+	{
+		return( -1 );
+	}
+	if( number_of_waiting_threads > 0 )
+	{
+		wait_status = WaitForSingleObject(
+		               internal_condition->signal_event_handle,
+		               INFINITE );
+
+		internal_condition->signal_is_broadcast = 0;
+
+		if( wait_status == WAIT_FAILED )
+		{
+			*error_code = (uint32_t) GetLastError();
+
+			return( -1 );
+		}
+	}
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_cond_broadcast(
+	                  &( internal_condition->condition ) );
+
+	if( pthread_result != 0 )
+	{
+		*error_code = (uint32_t) pthread_result;
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Signals a condition without an error object
+ * The error code is set to the system error code on error
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_condition_signal(
+     libcthreads_internal_condition_t *internal_condition,
+     uint32_t *error_code )
+{
+#if defined( WINAPI ) && ( WINVER < 0x0600 )
+	BOOL result                   = 1;
+	int number_of_waiting_threads = 0;
+
+#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result            = 0;
+#endif
+
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	LIBCTHREADS_UNREFERENCED_PARAMETER( error_code )
+
+	WakeConditionVariable(
+	 &( internal_condition->condition_variable ) );
+
+#elif defined( WINAPI )
+	EnterCriticalSection(
+	 &( internal_condition->wait_critical_section ) );
+
+	number_of_waiting_threads = internal_condition->number_of_waiting_threads;
+
+	LeaveCriticalSection(
+	 &( internal_condition->wait_critical_section ) );
+
+	if( number_of_waiting_threads > 0 )
+	{
+		result = ReleaseSemaphore(
+		          internal_condition->signal_semaphore_handle,
+		          1,
+		          0 );
+
+		if( result == 0 )
+		{
+			*error_code = (uint32_t) GetLastError();
+
+			return( -1 );
+		}
+	}
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_cond_signal(
+	                  &( internal_condition->condition ) );
+
+	if( pthread_result != 0 )
+	{
+		*error_code = (uint32_t) pthread_result;
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Waits for a condition without an error object
+ * The error code is set to the system error code on error
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_condition_wait(
+     libcthreads_internal_condition_t *internal_condition,
+     libcthreads_internal_mutex_t *internal_mutex,
+     uint32_t *error_code )
+{
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	BOOL result                = 0;
+
+#elif defined( WINAPI ) && ( WINVER >= 0x0400 )
+	DWORD wait_status          = 0;
+	int is_last_waiting_thread = 0;
+
+#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result         = 0;
+#endif
+
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_BLOCK,
+	 internal_condition );
+
+	LIBCTHREADS_PROBE2(
+	 cond__wait,
+	 internal_condition,
+	 internal_mutex );
+
+	result = SleepConditionVariableCS(
+	          &( internal_condition->condition_variable ),
+	          &( internal_mutex->critical_section ),
+	          INFINITE );
+
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_WAKE,
+	 internal_condition );
+
+	LIBCTHREADS_PROBE2(
+	 cond__wake,
+	 internal_condition,
+	 internal_mutex );
+
+	if( result == 0 )
+	{
+		*error_code = (uint32_t) GetLastError();
+
+		return( -1 );
+	}
+
+#elif defined( WINAPI ) && ( WINVER >= 0x0400 )
+	EnterCriticalSection(
+	 &( internal_condition->wait_critical_section ) );
+
+	internal_condition->number_of_waiting_threads++;
+
+	LeaveCriticalSection(
+	 &( internal_condition->wait_critical_section ) );
+
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_BLOCK,
+	 internal_condition );
+
+	LIBCTHREADS_PROBE2(
+	 cond__wait,
+	 internal_condition,
+	 internal_mutex );
+
+	wait_status = SignalObjectAndWait(
+	               internal_mutex->mutex_handle,
+	               internal_condition->signal_semaphore_handle,
+	               INFINITE,
+	               FALSE );
+
+	if( wait_status == WAIT_FAILED )
+	{
+		*error_code = (uint32_t) GetLastError();
+
+		return( -1 );
+	}
+	EnterCriticalSection(
+	 &( internal_condition->wait_critical_section ) );
+
+	internal_condition->number_of_waiting_threads--;
+
+	if( ( internal_condition->number_of_waiting_threads == 0 )
+	 && ( internal_condition->signal_is_broadcast != 0 ) )
+	{
+		is_last_waiting_thread = 1;
+	}
+	LeaveCriticalSection(
+	 &( internal_condition->wait_critical_section ) );
+
+	if( is_last_waiting_thread != 0 )
+	{
+		wait_status = SignalObjectAndWait(
+		               internal_condition->signal_event_handle,
+		               internal_mutex->mutex_handle,
+		               INFINITE,
+		               FALSE );
+	}
+	else
+	{
+		wait_status = WaitForSingleObject(
+		               internal_mutex->mutex_handle,
+		               INFINITE );
+	}
+	if( wait_status == WAIT_FAILED )
+	{
+		*error_code = (uint32_t) GetLastError();
+
+		return( -1 );
+	}
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_WAKE,
+	 internal_condition );
+
+	LIBCTHREADS_PROBE2(
+	 cond__wake,
+	 internal_condition,
+	 internal_mutex );
+
+#elif defined( WINAPI )
+
+#error libcthreads_internal_condition_wait for Windows earlier than NT4 not implemented
+
+#elif defined( HAVE_PTHREAD_H )
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_BLOCK,
+	 internal_condition );
+
+	LIBCTHREADS_PROBE2(
+	 cond__wait,
+	 internal_condition,
+	 internal_mutex );
+
+	pthread_result = pthread_cond_wait(
+	                  &( internal_condition->condition ),
+	                  &( internal_mutex->mutex ) );
+
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_WAKE,
+	 internal_condition );
+
+	LIBCTHREADS_PROBE2(
+	 cond__wake,
+	 internal_condition,
+	 internal_mutex );
 
-#elif defined( HAVE_PTHREAD_H )
-	pthread_result = pthread_cond_broadcast(
-	                  &( internal_condition->condition ) );
-
 	if( pthread_result != 0 )
+	{
+		*error_code = (uint32_t) pthread_result;
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Broadcasts a condition
+ * The of this function must be locked by the same mutex as used to wait
+ * This is necessary for the WINAPI pre Vista (0x0600) implementation
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_condition_broadcast(
+     libcthreads_condition_t *condition,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_condition_broadcast";
+	uint32_t error_code   = 0;
+
+	if( condition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid condition.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_condition_broadcast(
+	     (libcthreads_internal_condition_t *) condition,
+	     &error_code ) != 1 )
 	{
 		libcerror_system_set_error(
 		 error,
-		 pthread_result,
+		 error_code,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
 		 "%s: unable to broadcast condition.",
@@ -451,10 +926,22 @@ int libcthreads_condition_broadcast(
 
 		return( -1 );
 	}
-#endif
 	return( 1 );
 }
 
+/* Broadcasts a condition without argument checks and error objects
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_condition_broadcast_fast(
+     libcthreads_condition_t *condition )
+{
+	uint32_t error_code = 0;
+
+	return( libcthreads_internal_condition_broadcast(
+	         (libcthreads_internal_condition_t *) condition,
+	         &error_code ) );
+}
+
 /* Signals a condition
  * The of this function must be locked by the same mutex as used to wait
  * This is necessary for the WINAPI pre Vista (0x0600) implementation
@@ -464,17 +951,8 @@ int libcthreads_condition_signal(
      libcthreads_condition_t *condition,
      libcerror_error_t **error )
 {
-	libcthreads_internal_condition_t *internal_condition = NULL;
-	static char *function                                = "libcthreads_condition_signal";
-
-#if defined( WINAPI ) && ( WINVER < 0x0600 )
-	DWORD error_code                                     = 0;
-	BOOL result                                          = 1;
-	int number_of_waiting_threads                        = 0;
-
-#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                                   = 0;
-#endif
+	static char *function = "libcthreads_condition_signal";
+	uint32_t error_code   = 0;
 
 	if( condition == NULL )
 	{
@@ -487,89 +965,146 @@ int libcthreads_condition_signal(
 
 		return( -1 );
 	}
-	internal_condition = (libcthreads_internal_condition_t *) condition;
+	if( libcthreads_internal_condition_signal(
+	     (libcthreads_internal_condition_t *) condition,
+	     &error_code ) != 1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to signal condition.",
+		 function );
 
-#if defined( WINAPI ) && ( WINVER >= 0x0600 )
-	WakeConditionVariable(
-	 &( internal_condition->condition_variable ) );
+		return( -1 );
+	}
+	return( 1 );
+}
 
-#elif defined( WINAPI )
-	EnterCriticalSection(
-	 &( internal_condition->wait_critical_section ) );
+/* Signals a condition without argument checks and error objects
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_condition_signal_fast(
+     libcthreads_condition_t *condition )
+{
+	uint32_t error_code = 0;
 
-	number_of_waiting_threads = internal_condition->number_of_waiting_threads;
+	return( libcthreads_internal_condition_signal(
+	         (libcthreads_internal_condition_t *) condition,
+	         &error_code ) );
+}
 
-	LeaveCriticalSection(
-	 &( internal_condition->wait_critical_section ) );
+/* Waits for a condition
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_condition_wait(
+     libcthreads_condition_t *condition,
+     libcthreads_mutex_t *mutex,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_condition_wait";
+	uint32_t error_code   = 0;
 
-	if( number_of_waiting_threads > 0 )
+	if( condition == NULL )
 	{
-		result = ReleaseSemaphore(
-		          internal_condition->signal_semaphore_handle,
-		          1,
-		          0 );
-
-		if( result == 0 )
-		{
-			error_code = GetLastError();
-
-			libcerror_system_set_error(
-			 error,
-			 error_code,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to release signal semaphore handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid condition.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
+	if( mutex == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mutex.",
+		 function );
 
-#elif defined( HAVE_PTHREAD_H )
-	pthread_result = pthread_cond_signal(
-	                  &( internal_condition->condition ) );
-
-	if( pthread_result != 0 )
+		return( -1 );
+	}
+	if( libcthreads_internal_condition_wait(
+	     (libcthreads_internal_condition_t *) condition,
+	     (libcthreads_internal_mutex_t *) mutex,
+	     &error_code ) != 1 )
 	{
 		libcerror_system_set_error(
 		 error,
-		 pthread_result,
+		 error_code,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to signal condition.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to wait for condition.",
 		 function );
 
 		return( -1 );
 	}
-#endif
 	return( 1 );
 }
 
-/* Waits for a condition
+/* Waits for a condition without argument checks and error objects
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_condition_wait(
+int libcthreads_condition_wait_fast(
+     libcthreads_condition_t *condition,
+     libcthreads_mutex_t *mutex )
+{
+	uint32_t error_code = 0;
+
+	return( libcthreads_internal_condition_wait(
+	         (libcthreads_internal_condition_t *) condition,
+	         (libcthreads_internal_mutex_t *) mutex,
+	         &error_code ) );
+}
+
+/* Waits for a condition until a deadline
+ * The deadline is a time of the monotonic clock in nanoseconds,
+ * as returned by libcthreads_clock_get_monotonic_time
+ * Returns 1 if successful, 0 if the deadline has passed or -1 on error
+ */
+int libcthreads_condition_wait_until(
      libcthreads_condition_t *condition,
      libcthreads_mutex_t *mutex,
+     uint64_t deadline,
      libcerror_error_t **error )
 {
 	libcthreads_internal_condition_t *internal_condition = NULL;
 	libcthreads_internal_mutex_t *internal_mutex         = NULL;
-	static char *function                                = "libcthreads_condition_wait";
+	static char *function                                = "libcthreads_condition_wait_until";
+	uint64_t monotonic_time                              = 0;
 
 #if defined( WINAPI )
 	DWORD error_code                                     = 0;
+	DWORD timeout_in_milliseconds                        = 0;
 
 #if ( WINVER >= 0x0600 )
 	BOOL result                                          = 0;
 
 #elif ( WINVER >= 0x0400 )
 	DWORD wait_status                                    = 0;
+	DWORD semaphore_wait_status                          = 0;
 	int is_last_waiting_thread                           = 0;
 #endif
 
 #elif defined( HAVE_PTHREAD_H )
+	struct timespec time_specification;
+
+	uint64_t absolute_time                               = 0;
 	int pthread_result                                   = 0;
+
+#if !defined( HAVE_PTHREAD_CONDATTR_SETCLOCK ) || !defined( HAVE_CLOCK_GETTIME )
+	uint64_t system_time                                 = 0;
+
+#if defined( HAVE_CLOCK_GETTIME )
+	struct timespec system_time_specification;
+#else
+	struct timeval system_time_value;
+#endif
+#endif
 #endif
 
 	if( condition == NULL )
@@ -598,16 +1133,67 @@ int libcthreads_condition_wait(
 	}
 	internal_mutex = (libcthreads_internal_mutex_t *) mutex;
 
+	if( libcthreads_clock_get_monotonic_time(
+	     &monotonic_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic time.",
+		 function );
+
+		return( -1 );
+	}
+	if( monotonic_time >= deadline )
+	{
+		return( 0 );
+	}
+#if defined( WINAPI )
+	/* Round up so the wait does not end before the deadline
+	 */
+	if( ( deadline - monotonic_time ) >= ( (uint64_t) ( INFINITE - 1 ) * 1000000 ) )
+	{
+		timeout_in_milliseconds = INFINITE - 1;
+	}
+	else
+	{
+		timeout_in_milliseconds = (DWORD) ( ( deadline - monotonic_time + 999999 ) / 1000000 );
+	}
+#endif
 #if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_BLOCK,
+	 internal_condition );
+
+	LIBCTHREADS_PROBE2(
+	 cond__wait,
+	 internal_condition,
+	 internal_mutex );
+
 	result = SleepConditionVariableCS(
 	          &( internal_condition->condition_variable ),
 	          &( internal_mutex->critical_section ),
-	          INFINITE );
+	          timeout_in_milliseconds );
+
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_WAKE,
+	 internal_condition );
+
+	LIBCTHREADS_PROBE2(
+	 cond__wake,
+	 internal_condition,
+	 internal_mutex );
 
 	if( result == 0 )
 	{
 		error_code = GetLastError();
 
+		if( error_code == ERROR_TIMEOUT )
+		{
+			return( 0 );
+		}
 		libcerror_system_set_error(
 		 error,
 		 error_code,
@@ -628,13 +1214,22 @@ int libcthreads_condition_wait(
 	LeaveCriticalSection(
 	 &( internal_condition->wait_critical_section ) );
 
-	wait_status = SignalObjectAndWait(
-	               internal_mutex->mutex_handle,
-	               internal_condition->signal_semaphore_handle,
-	               INFINITE,
-	               FALSE );
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_BLOCK,
+	 internal_condition );
 
-	if( wait_status == WAIT_FAILED )
+	LIBCTHREADS_PROBE2(
+	 cond__wait,
+	 internal_condition,
+	 internal_mutex );
+
+	semaphore_wait_status = SignalObjectAndWait(
+	                         internal_mutex->mutex_handle,
+	                         internal_condition->signal_semaphore_handle,
+	                         timeout_in_milliseconds,
+	                         FALSE );
+
+	if( semaphore_wait_status == WAIT_FAILED )
 	{
 		error_code = GetLastError();
 
@@ -653,6 +1248,9 @@ int libcthreads_condition_wait(
 
 	internal_condition->number_of_waiting_threads--;
 
+	/* A thread that timed out was counted by a broadcast sent in the meantime
+	 * so it has to release the broadcasting thread as well
+	 */
 	if( ( internal_condition->number_of_waiting_threads == 0 )
 	 && ( internal_condition->signal_is_broadcast != 0 ) )
 	{
@@ -668,54 +1266,127 @@ int libcthreads_condition_wait(
 		               internal_mutex->mutex_handle,
 		               INFINITE,
 		               FALSE );
-
-		if( wait_status == WAIT_FAILED )
-		{
-			error_code = GetLastError();
-
-			libcerror_system_set_error(
-			 error,
-			 error_code,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to signal signal event handle and wait for mutex handle.",
-			 function );
-
-			return( -1 );
-		}
 	}
 	else
 	{
 		wait_status = WaitForSingleObject(
 		               internal_mutex->mutex_handle,
 		               INFINITE );
+	}
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_WAKE,
+	 internal_condition );
 
-		if( wait_status == WAIT_FAILED )
-		{
-			error_code = GetLastError();
+	LIBCTHREADS_PROBE2(
+	 cond__wake,
+	 internal_condition,
+	 internal_mutex );
 
-			libcerror_system_set_error(
-			 error,
-			 error_code,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: wait for mutex handle failed.",
-			 function );
+	if( wait_status == WAIT_FAILED )
+	{
+		error_code = GetLastError();
 
-			return( -1 );
-		}
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: wait for mutex handle failed.",
+		 function );
+
+		return( -1 );
+	}
+	if( semaphore_wait_status == WAIT_TIMEOUT )
+	{
+		return( 0 );
 	}
 
 #elif defined( WINAPI )
 
-#error libcthreads_condition_wait for Windows earlier than NT4 not implemented
+#error libcthreads_condition_wait_until for Windows earlier than NT4 not implemented
 
 #elif defined( HAVE_PTHREAD_H )
-	pthread_result = pthread_cond_wait(
+#if defined( HAVE_PTHREAD_CONDATTR_SETCLOCK ) && defined( HAVE_CLOCK_GETTIME )
+	absolute_time = deadline;
+
+#else
+	/* The condition uses the system time, convert the deadline
+	 */
+#if defined( HAVE_CLOCK_GETTIME )
+	if( clock_gettime(
+	     CLOCK_REALTIME,
+	     &system_time_specification ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 errno,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve system time.",
+		 function );
+
+		return( -1 );
+	}
+	system_time = ( (uint64_t) system_time_specification.tv_sec * 1000000000UL )
+	            + (uint64_t) system_time_specification.tv_nsec;
+#else
+	if( gettimeofday(
+	     &system_time_value,
+	     NULL ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 errno,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve system time.",
+		 function );
+
+		return( -1 );
+	}
+	system_time = ( (uint64_t) system_time_value.tv_sec * 1000000000UL )
+	            + ( (uint64_t) system_time_value.tv_usec * 1000 );
+#endif
+	if( ( deadline - monotonic_time ) > ( UINT64_MAX - system_time ) )
+	{
+		absolute_time = UINT64_MAX;
+	}
+	else
+	{
+		absolute_time = system_time + ( deadline - monotonic_time );
+	}
+#endif
+	time_specification.tv_sec  = (time_t) ( absolute_time / 1000000000UL );
+	time_specification.tv_nsec = (long) ( absolute_time % 1000000000UL );
+
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_BLOCK,
+	 internal_condition );
+
+	LIBCTHREADS_PROBE2(
+	 cond__wait,
+	 internal_condition,
+	 internal_mutex );
+
+	pthread_result = pthread_cond_timedwait(
 	                  &( internal_condition->condition ),
-	                  &( internal_mutex->mutex ) );
+	                  &( internal_mutex->mutex ),
+	                  &time_specification );
 
-	if( pthread_result != 0 )
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_WAKE,
+	 internal_condition );
+
+	LIBCTHREADS_PROBE2(
+	 cond__wake,
+	 internal_condition,
+	 internal_mutex );
+
+	if( pthread_result == ETIMEDOUT )
+	{
+		return( 0 );
+	}
+	else if( pthread_result != 0 )
 	{
 		libcerror_system_set_error(
 		 error,
@@ -731,5 +1402,52 @@ int libcthreads_condition_wait(
 	return( 1 );
 }
 
+/* Waits for a condition for at most timeout nanoseconds
+ * Returns 1 if successful, 0 if the timeout has expired or -1 on error
+ */
+int libcthreads_condition_timed_wait(
+     libcthreads_condition_t *condition,
+     libcthreads_mutex_t *mutex,
+     uint64_t timeout,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_condition_timed_wait";
+	uint64_t deadline     = 0;
+	int result            = 0;
+
+	if( libcthreads_clock_get_deadline(
+	     timeout,
+	     &deadline,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine deadline.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_condition_wait_until(
+	          condition,
+	          mutex,
+	          deadline,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to wait for condition.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 #endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
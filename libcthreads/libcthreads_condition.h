@@ -35,6 +35,7 @@
 
 #include "libcthreads_extern.h"
 #include "libcthreads_libcerror.h"
+#include "libcthreads_mutex.h"
 #include "libcthreads_types.h"
 
 #if defined( __cplusplus )
@@ -84,32 +85,91 @@ struct libcthreads_internal_condition
 #endif
 };
 
+int libcthreads_internal_condition_initialize(
+     libcthreads_internal_condition_t *internal_condition,
+     libcerror_error_t **error );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_condition_initialize(
      libcthreads_condition_t **condition,
      libcerror_error_t **error );
 
+int libcthreads_internal_condition_finalize(
+     libcthreads_internal_condition_t *internal_condition,
+     libcerror_error_t **error );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_condition_free(
      libcthreads_condition_t **condition,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_condition_initialize_in_place(
+     libcthreads_condition_t **condition,
+     libcthreads_condition_storage_t *storage,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_condition_finalize_in_place(
+     libcthreads_condition_t **condition,
+     libcerror_error_t **error );
+
+int libcthreads_internal_condition_broadcast(
+     libcthreads_internal_condition_t *internal_condition,
+     uint32_t *error_code );
+
+int libcthreads_internal_condition_signal(
+     libcthreads_internal_condition_t *internal_condition,
+     uint32_t *error_code );
+
+int libcthreads_internal_condition_wait(
+     libcthreads_internal_condition_t *internal_condition,
+     libcthreads_internal_mutex_t *internal_mutex,
+     uint32_t *error_code );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_condition_broadcast(
      libcthreads_condition_t *condition,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_condition_broadcast_fast(
+     libcthreads_condition_t *condition );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_condition_signal(
      libcthreads_condition_t *condition,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_condition_signal_fast(
+     libcthreads_condition_t *condition );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_condition_wait(
      libcthreads_condition_t *condition,
      libcthreads_mutex_t *mutex,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_condition_wait_fast(
+     libcthreads_condition_t *condition,
+     libcthreads_mutex_t *mutex );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_condition_wait_until(
+     libcthreads_condition_t *condition,
+     libcthreads_mutex_t *mutex,
+     uint64_t deadline,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_condition_timed_wait(
+     libcthreads_condition_t *condition,
+     libcthreads_mutex_t *mutex,
+     uint64_t timeout,
+     libcerror_error_t **error );
+
 #endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 #if defined( __cplusplus )
@@ -0,0 +1,1556 @@
+/*
+ * Concurrent hash map functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libcthreads_definitions.h"
+#include "libcthreads_hash_map.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_lock_stripe.h"
+#include "libcthreads_mutex.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a hash map
+ * Make sure the value hash_map is referencing, is set to NULL
+ *
+ * The number of stripes determines the number of writers that can modify
+ * the hash map concurrently and is rounded up to the next power of 2
+ *
+ * The key_hash_function should set key_hash and return 1 if successful or -1 on error
+ * The key_compare_function should return LIBCTHREADS_COMPARE_LESS,
+ * LIBCTHREADS_COMPARE_EQUAL, LIBCTHREADS_COMPARE_GREATER if successful or -1 on error
+ * Both functions are called while a stripe is grabbed and must not use the hash map
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_hash_map_initialize(
+     libcthreads_hash_map_t **hash_map,
+     int number_of_stripes,
+     int (*key_hash_function)(
+            intptr_t *key,
+            uint64_t *key_hash,
+            libcerror_error_t **error ),
+     int (*key_compare_function)(
+            intptr_t *first_key,
+            intptr_t *second_key,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libcthreads_internal_hash_map_t *internal_hash_map = NULL;
+	static char *function                              = "libcthreads_hash_map_initialize";
+	size_t buckets_size                                = 0;
+	size_t stripes_size                                = 0;
+
+	if( hash_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_hash_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key hash function.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_compare_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key compare function.",
+		 function );
+
+		return( -1 );
+	}
+	internal_hash_map = memory_allocate_structure(
+	                     libcthreads_internal_hash_map_t );
+
+	if( internal_hash_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_hash_map,
+	     0,
+	     sizeof( libcthreads_internal_hash_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash map.",
+		 function );
+
+		memory_free(
+		 internal_hash_map );
+
+		return( -1 );
+	}
+	if( libcthreads_lock_stripe_initialize(
+	     &( internal_hash_map->lock_stripe ),
+	     number_of_stripes,
+	     LIBCTHREADS_LOCK_STRIPE_FLAG_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create lock stripe.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_lock_stripe_get_number_of_stripes(
+	     internal_hash_map->lock_stripe,
+	     &( internal_hash_map->number_of_stripes ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stripes.",
+		 function );
+
+		goto on_error;
+	}
+	/* The number of buckets is a power of 2 that is at least the number of stripes
+	 * so that all entries in a bucket are protected by the same stripe
+	 */
+	internal_hash_map->number_of_buckets = internal_hash_map->number_of_stripes;
+
+	if( internal_hash_map->number_of_buckets < LIBCTHREADS_HASH_MAP_MINIMUM_NUMBER_OF_BUCKETS )
+	{
+		internal_hash_map->number_of_buckets = LIBCTHREADS_HASH_MAP_MINIMUM_NUMBER_OF_BUCKETS;
+	}
+	stripes_size = sizeof( libcthreads_hash_map_stripe_t ) * internal_hash_map->number_of_stripes;
+
+	internal_hash_map->stripes = (libcthreads_hash_map_stripe_t *) memory_allocate(
+	                                                                stripes_size );
+
+	if( internal_hash_map->stripes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stripes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_hash_map->stripes,
+	     0,
+	     stripes_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stripes.",
+		 function );
+
+		goto on_error;
+	}
+	buckets_size = sizeof( libcthreads_hash_map_entry_t * ) * internal_hash_map->number_of_buckets;
+
+	internal_hash_map->buckets = (libcthreads_hash_map_entry_t **) memory_allocate(
+	                                                                buckets_size );
+
+	if( internal_hash_map->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_hash_map->buckets,
+	     0,
+	     buckets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_hash_map->resize_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create resize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	internal_hash_map->key_hash_function    = key_hash_function;
+	internal_hash_map->key_compare_function = key_compare_function;
+
+	*hash_map = (libcthreads_hash_map_t *) internal_hash_map;
+
+	return( 1 );
+
+on_error:
+	if( internal_hash_map != NULL )
+	{
+		if( internal_hash_map->buckets != NULL )
+		{
+			memory_free(
+			 internal_hash_map->buckets );
+		}
+		if( internal_hash_map->stripes != NULL )
+		{
+			memory_free(
+			 internal_hash_map->stripes );
+		}
+		if( internal_hash_map->lock_stripe != NULL )
+		{
+			libcthreads_lock_stripe_free(
+			 &( internal_hash_map->lock_stripe ),
+			 NULL );
+		}
+		memory_free(
+		 internal_hash_map );
+	}
+	return( -1 );
+}
+
+/* Frees the entries in buckets
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_hash_map_free_buckets(
+     libcthreads_hash_map_entry_t **buckets,
+     int number_of_buckets,
+     int (*key_free_function)(
+            intptr_t **key,
+            libcerror_error_t **error ),
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libcthreads_hash_map_entry_t *entry      = NULL;
+	libcthreads_hash_map_entry_t *next_entry = NULL;
+	static char *function                    = "libcthreads_internal_hash_map_free_buckets";
+	int bucket_index                         = 0;
+	int result                               = 1;
+
+	for( bucket_index = 0;
+	     bucket_index < number_of_buckets;
+	     bucket_index++ )
+	{
+		entry = buckets[ bucket_index ];
+
+		while( entry != NULL )
+		{
+			next_entry = entry->next_entry;
+
+			if( key_free_function != NULL )
+			{
+				if( key_free_function(
+				     &( entry->key ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free key.",
+					 function );
+
+					result = -1;
+				}
+			}
+			if( value_free_function != NULL )
+			{
+				if( value_free_function(
+				     &( entry->value ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free value.",
+					 function );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 entry );
+
+			entry = next_entry;
+		}
+		buckets[ bucket_index ] = NULL;
+	}
+	return( result );
+}
+
+/* Frees a hash map
+ * Uses the key_free_function and value_free_function to free the keys and values
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_hash_map_free(
+     libcthreads_hash_map_t **hash_map,
+     int (*key_free_function)(
+            intptr_t **key,
+            libcerror_error_t **error ),
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libcthreads_internal_hash_map_t *internal_hash_map = NULL;
+	static char *function                              = "libcthreads_hash_map_free";
+	int result                                         = 1;
+
+	if( hash_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_map != NULL )
+	{
+		internal_hash_map = (libcthreads_internal_hash_map_t *) *hash_map;
+		*hash_map         = NULL;
+
+		if( libcthreads_internal_hash_map_free_buckets(
+		     internal_hash_map->buckets,
+		     internal_hash_map->number_of_buckets,
+		     key_free_function,
+		     value_free_function,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free buckets.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_hash_map->buckets );
+
+		if( internal_hash_map->previous_buckets != NULL )
+		{
+			if( libcthreads_internal_hash_map_free_buckets(
+			     internal_hash_map->previous_buckets,
+			     internal_hash_map->number_of_previous_buckets,
+			     key_free_function,
+			     value_free_function,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free previous buckets.",
+				 function );
+
+				result = -1;
+			}
+			memory_free(
+			 internal_hash_map->previous_buckets );
+		}
+		if( libcthreads_mutex_free(
+		     &( internal_hash_map->resize_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free resize mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_lock_stripe_free(
+		     &( internal_hash_map->lock_stripe ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free lock stripe.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_hash_map->stripes );
+
+		memory_free(
+		 internal_hash_map );
+	}
+	return( result );
+}
+
+/* Determines the scrambled hash of a key
+ * The hash returned by the key hash function is scrambled so that
+ * its lower bits can be used as stripe and bucket index
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_hash_map_get_key_hash(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     intptr_t *key,
+     uint64_t *key_hash,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_hash_map_get_key_hash";
+	uint64_t hash         = 0;
+
+	if( internal_hash_map->key_hash_function(
+	     key,
+	     &hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve key hash.",
+		 function );
+
+		return( -1 );
+	}
+	/* Use the 64-bit finalizer of MurmurHash3 to scramble the hash
+	 */
+	hash ^= hash >> 33;
+	hash *= (uint64_t) 0xff51afd7ed558ccdUL;
+	hash ^= hash >> 33;
+	hash *= (uint64_t) 0xc4ceb9fe1a85ec53UL;
+	hash ^= hash >> 33;
+
+	*key_hash = hash;
+
+	return( 1 );
+}
+
+/* Finds the entry of a key in a bucket
+ * On return entry_reference points to the reference to the entry,
+ * which allows the entry to be unlinked
+ * Returns 1 if found, 0 if not or -1 on error
+ */
+int libcthreads_internal_hash_map_find_entry(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     libcthreads_hash_map_entry_t **first_entry_reference,
+     uint64_t key_hash,
+     intptr_t *key,
+     libcthreads_hash_map_entry_t ***entry_reference,
+     libcerror_error_t **error )
+{
+	libcthreads_hash_map_entry_t **safe_entry_reference = NULL;
+	static char *function                               = "libcthreads_internal_hash_map_find_entry";
+	int compare_result                                  = 0;
+
+	safe_entry_reference = first_entry_reference;
+
+	while( *safe_entry_reference != NULL )
+	{
+		if( ( *safe_entry_reference )->key_hash == key_hash )
+		{
+			compare_result = internal_hash_map->key_compare_function(
+			                  key,
+			                  ( *safe_entry_reference )->key,
+			                  error );
+
+			if( compare_result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare keys.",
+				 function );
+
+				return( -1 );
+			}
+			else if( compare_result == LIBCTHREADS_COMPARE_EQUAL )
+			{
+				*entry_reference = safe_entry_reference;
+
+				return( 1 );
+			}
+		}
+		safe_entry_reference = &( ( *safe_entry_reference )->next_entry );
+	}
+	*entry_reference = safe_entry_reference;
+
+	return( 0 );
+}
+
+/* Grabs all stripes for writing in ascending order
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_hash_map_grab_all_stripes(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_hash_map_grab_all_stripes";
+	int stripe_index      = 0;
+
+	for( stripe_index = 0;
+	     stripe_index < internal_hash_map->number_of_stripes;
+	     stripe_index++ )
+	{
+		if( libcthreads_internal_lock_stripe_grab_by_index(
+		     (libcthreads_internal_lock_stripe_t *) internal_hash_map->lock_stripe,
+		     stripe_index,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab stripe: %d.",
+			 function,
+			 stripe_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	while( stripe_index > 0 )
+	{
+		stripe_index--;
+
+		libcthreads_internal_lock_stripe_release_by_index(
+		 (libcthreads_internal_lock_stripe_t *) internal_hash_map->lock_stripe,
+		 stripe_index,
+		 0,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases all stripes that were grabbed for writing in descending order
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_hash_map_release_all_stripes(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_hash_map_release_all_stripes";
+	int result            = 1;
+	int stripe_index      = 0;
+
+	for( stripe_index = internal_hash_map->number_of_stripes - 1;
+	     stripe_index >= 0;
+	     stripe_index-- )
+	{
+		if( libcthreads_internal_lock_stripe_release_by_index(
+		     (libcthreads_internal_lock_stripe_t *) internal_hash_map->lock_stripe,
+		     stripe_index,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release stripe: %d.",
+			 function,
+			 stripe_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Moves the entries of a previous bucket to the current buckets
+ * The stripe of the previous bucket must be grabbed for writing
+ */
+void libcthreads_internal_hash_map_migrate_bucket(
+      libcthreads_internal_hash_map_t *internal_hash_map,
+      int previous_bucket_index )
+{
+	libcthreads_hash_map_entry_t *entry      = NULL;
+	libcthreads_hash_map_entry_t *next_entry = NULL;
+	int bucket_index                         = 0;
+
+	entry = internal_hash_map->previous_buckets[ previous_bucket_index ];
+
+	internal_hash_map->previous_buckets[ previous_bucket_index ] = NULL;
+
+	while( entry != NULL )
+	{
+		next_entry   = entry->next_entry;
+		bucket_index = (int) ( entry->key_hash & (uint64_t) ( internal_hash_map->number_of_buckets - 1 ) );
+
+		entry->next_entry                          = internal_hash_map->buckets[ bucket_index ];
+		internal_hash_map->buckets[ bucket_index ] = entry;
+
+		entry = next_entry;
+	}
+}
+
+/* Moves the previous bucket of a key hash and a limited number of other
+ * previous buckets of the stripe to the current buckets
+ * The stripe must be grabbed for writing
+ * Resize completed is set if this was the last stripe to complete migration
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_hash_map_migrate_stripe(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     int stripe_index,
+     uint64_t key_hash,
+     uint8_t *resize_completed,
+     libcerror_error_t **error )
+{
+	libcthreads_hash_map_stripe_t *stripe = NULL;
+	static char *function                 = "libcthreads_internal_hash_map_migrate_stripe";
+	int number_of_migrated_buckets        = 0;
+
+	if( internal_hash_map->previous_buckets == NULL )
+	{
+		return( 1 );
+	}
+	stripe = &( internal_hash_map->stripes[ stripe_index ] );
+
+	if( stripe->migration_pending == 0 )
+	{
+		return( 1 );
+	}
+	libcthreads_internal_hash_map_migrate_bucket(
+	 internal_hash_map,
+	 (int) ( key_hash & (uint64_t) ( internal_hash_map->number_of_previous_buckets - 1 ) ) );
+
+	while( ( number_of_migrated_buckets < LIBCTHREADS_HASH_MAP_NUMBER_OF_MIGRATED_BUCKETS )
+	    && ( stripe->migration_bucket_index < internal_hash_map->number_of_previous_buckets ) )
+	{
+		libcthreads_internal_hash_map_migrate_bucket(
+		 internal_hash_map,
+		 stripe->migration_bucket_index );
+
+		stripe->migration_bucket_index += internal_hash_map->number_of_stripes;
+
+		number_of_migrated_buckets++;
+	}
+	if( stripe->migration_bucket_index < internal_hash_map->number_of_previous_buckets )
+	{
+		return( 1 );
+	}
+	stripe->migration_pending = 0;
+
+	if( libcthreads_mutex_grab(
+	     internal_hash_map->resize_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab resize mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_hash_map->number_of_migrated_stripes += 1;
+
+	if( internal_hash_map->number_of_migrated_stripes == internal_hash_map->number_of_stripes )
+	{
+		*resize_completed = 1;
+	}
+	if( libcthreads_mutex_release(
+	     internal_hash_map->resize_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release resize mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Starts resizing the hash map if a stripe is still overloaded
+ * This grabs all stripes to swap the buckets, the entries are moved to
+ * the new buckets incrementally by subsequent writes
+ * If a previous resize has not completed its remaining buckets are moved first
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_hash_map_resize(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     libcerror_error_t **error )
+{
+	libcthreads_hash_map_entry_t **buckets = NULL;
+	static char *function                  = "libcthreads_internal_hash_map_resize";
+	size_t buckets_size                    = 0;
+	int bucket_index                       = 0;
+	int number_of_buckets                  = 0;
+	int stripe_index                       = 0;
+	uint8_t is_overloaded                  = 0;
+
+	if( libcthreads_internal_hash_map_grab_all_stripes(
+	     internal_hash_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab stripes.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_hash_map->previous_buckets != NULL )
+	{
+		for( bucket_index = 0;
+		     bucket_index < internal_hash_map->number_of_previous_buckets;
+		     bucket_index++ )
+		{
+			libcthreads_internal_hash_map_migrate_bucket(
+			 internal_hash_map,
+			 bucket_index );
+		}
+		memory_free(
+		 internal_hash_map->previous_buckets );
+
+		internal_hash_map->previous_buckets           = NULL;
+		internal_hash_map->number_of_previous_buckets = 0;
+		internal_hash_map->number_of_migrated_stripes = 0;
+	}
+	for( stripe_index = 0;
+	     stripe_index < internal_hash_map->number_of_stripes;
+	     stripe_index++ )
+	{
+		internal_hash_map->stripes[ stripe_index ].migration_pending = 0;
+
+		if( internal_hash_map->stripes[ stripe_index ].number_of_entries >= ( 2 * internal_hash_map->number_of_buckets ) / internal_hash_map->number_of_stripes )
+		{
+			is_overloaded = 1;
+		}
+	}
+	if( ( is_overloaded != 0 )
+	 && ( internal_hash_map->number_of_buckets < LIBCTHREADS_HASH_MAP_MAXIMUM_NUMBER_OF_BUCKETS ) )
+	{
+		number_of_buckets = internal_hash_map->number_of_buckets * 2;
+		buckets_size      = sizeof( libcthreads_hash_map_entry_t * ) * number_of_buckets;
+
+		buckets = (libcthreads_hash_map_entry_t **) memory_allocate(
+		                                             buckets_size );
+
+		if( buckets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buckets.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     buckets,
+		     0,
+		     buckets_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buckets.",
+			 function );
+
+			goto on_error;
+		}
+		internal_hash_map->previous_buckets           = internal_hash_map->buckets;
+		internal_hash_map->number_of_previous_buckets = internal_hash_map->number_of_buckets;
+		internal_hash_map->buckets                    = buckets;
+		internal_hash_map->number_of_buckets          = number_of_buckets;
+
+		for( stripe_index = 0;
+		     stripe_index < internal_hash_map->number_of_stripes;
+		     stripe_index++ )
+		{
+			internal_hash_map->stripes[ stripe_index ].migration_bucket_index = stripe_index;
+			internal_hash_map->stripes[ stripe_index ].migration_pending      = 1;
+		}
+	}
+	if( libcthreads_internal_hash_map_release_all_stripes(
+	     internal_hash_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release stripes.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( buckets != NULL )
+	{
+		memory_free(
+		 buckets );
+	}
+	libcthreads_internal_hash_map_release_all_stripes(
+	 internal_hash_map,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Frees the previous buckets after all stripes completed migration
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_hash_map_finish_resize(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_hash_map_finish_resize";
+
+	if( libcthreads_internal_hash_map_grab_all_stripes(
+	     internal_hash_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab stripes.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_hash_map->previous_buckets != NULL )
+	 && ( internal_hash_map->number_of_migrated_stripes == internal_hash_map->number_of_stripes ) )
+	{
+		memory_free(
+		 internal_hash_map->previous_buckets );
+
+		internal_hash_map->previous_buckets           = NULL;
+		internal_hash_map->number_of_previous_buckets = 0;
+		internal_hash_map->number_of_migrated_stripes = 0;
+	}
+	if( libcthreads_internal_hash_map_release_all_stripes(
+	     internal_hash_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release stripes.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of entries
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_hash_map_get_number_of_entries(
+     libcthreads_hash_map_t *hash_map,
+     int *number_of_entries,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_hash_map_t *internal_hash_map = NULL;
+	static char *function                              = "libcthreads_hash_map_get_number_of_entries";
+	int safe_number_of_entries                         = 0;
+	int stripe_index                                   = 0;
+
+	if( hash_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash map.",
+		 function );
+
+		return( -1 );
+	}
+	internal_hash_map = (libcthreads_internal_hash_map_t *) hash_map;
+
+	if( number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	/* The stripes are grabbed one at a time, hence the number of entries
+	 * is not a snapshot if the hash map is modified concurrently
+	 */
+	for( stripe_index = 0;
+	     stripe_index < internal_hash_map->number_of_stripes;
+	     stripe_index++ )
+	{
+		if( libcthreads_internal_lock_stripe_grab_by_index(
+		     (libcthreads_internal_lock_stripe_t *) internal_hash_map->lock_stripe,
+		     stripe_index,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab stripe: %d for reading.",
+			 function,
+			 stripe_index );
+
+			return( -1 );
+		}
+		safe_number_of_entries += internal_hash_map->stripes[ stripe_index ].number_of_entries;
+
+		if( libcthreads_internal_lock_stripe_release_by_index(
+		     (libcthreads_internal_lock_stripe_t *) internal_hash_map->lock_stripe,
+		     stripe_index,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release stripe: %d for reading.",
+			 function,
+			 stripe_index );
+
+			return( -1 );
+		}
+	}
+	*number_of_entries = safe_number_of_entries;
+
+	return( 1 );
+}
+
+/* Retrieves the value of a key
+ * The stripe of the key is only grabbed for reading
+ * Returns 1 if successful, 0 if no such key or -1 on error
+ */
+int libcthreads_hash_map_get_value(
+     libcthreads_hash_map_t *hash_map,
+     intptr_t *key,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	libcthreads_hash_map_entry_t **entry_reference     = NULL;
+	libcthreads_internal_hash_map_t *internal_hash_map = NULL;
+	static char *function                              = "libcthreads_hash_map_get_value";
+	uint64_t key_hash                                  = 0;
+	int bucket_index                                   = 0;
+	int result                                         = 0;
+	int stripe_index                                   = 0;
+
+	if( hash_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash map.",
+		 function );
+
+		return( -1 );
+	}
+	internal_hash_map = (libcthreads_internal_hash_map_t *) hash_map;
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_hash_map_get_key_hash(
+	     internal_hash_map,
+	     key,
+	     &key_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve key hash.",
+		 function );
+
+		return( -1 );
+	}
+	stripe_index = (int) ( key_hash & (uint64_t) ( internal_hash_map->number_of_stripes - 1 ) );
+
+	if( libcthreads_internal_lock_stripe_grab_by_index(
+	     (libcthreads_internal_lock_stripe_t *) internal_hash_map->lock_stripe,
+	     stripe_index,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab stripe for reading.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_index = (int) ( key_hash & (uint64_t) ( internal_hash_map->number_of_buckets - 1 ) );
+
+	result = libcthreads_internal_hash_map_find_entry(
+	          internal_hash_map,
+	          &( internal_hash_map->buckets[ bucket_index ] ),
+	          key_hash,
+	          key,
+	          &entry_reference,
+	          error );
+
+	/* While the hash map is resized the entry can still be in the previous buckets
+	 */
+	if( ( result == 0 )
+	 && ( internal_hash_map->previous_buckets != NULL ) )
+	{
+		bucket_index = (int) ( key_hash & (uint64_t) ( internal_hash_map->number_of_previous_buckets - 1 ) );
+
+		result = libcthreads_internal_hash_map_find_entry(
+		          internal_hash_map,
+		          &( internal_hash_map->previous_buckets[ bucket_index ] ),
+		          key_hash,
+		          key,
+		          &entry_reference,
+		          error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find entry.",
+		 function );
+	}
+	else if( result == 1 )
+	{
+		*value = ( *entry_reference )->value;
+	}
+	if( libcthreads_internal_lock_stripe_release_by_index(
+	     (libcthreads_internal_lock_stripe_t *) internal_hash_map->lock_stripe,
+	     stripe_index,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release stripe for reading.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Inserts a value for a key
+ * The hash map does not take ownership of the key and value until the value is inserted
+ * Returns 1 if successful, 0 if the key already exists or -1 on error
+ */
+int libcthreads_hash_map_insert_value(
+     libcthreads_hash_map_t *hash_map,
+     intptr_t *key,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	libcthreads_hash_map_entry_t *entry                = NULL;
+	libcthreads_hash_map_entry_t **entry_reference     = NULL;
+	libcthreads_internal_hash_map_t *internal_hash_map = NULL;
+	static char *function                              = "libcthreads_hash_map_insert_value";
+	uint64_t key_hash                                  = 0;
+	uint8_t resize_attempted                           = 0;
+	uint8_t resize_completed                           = 0;
+	int bucket_index                                   = 0;
+	int result                                         = 0;
+	int stripe_index                                   = 0;
+
+	if( hash_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash map.",
+		 function );
+
+		return( -1 );
+	}
+	internal_hash_map = (libcthreads_internal_hash_map_t *) hash_map;
+
+	if( libcthreads_internal_hash_map_get_key_hash(
+	     internal_hash_map,
+	     key,
+	     &key_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve key hash.",
+		 function );
+
+		return( -1 );
+	}
+	/* Allocate the entry before grabbing the stripe to keep the stripe
+	 * grabbed as short as possible
+	 */
+	entry = memory_allocate_structure(
+	         libcthreads_hash_map_entry_t );
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entry.",
+		 function );
+
+		return( -1 );
+	}
+	entry->key_hash   = key_hash;
+	entry->key        = key;
+	entry->value      = value;
+	entry->next_entry = NULL;
+
+	stripe_index = (int) ( key_hash & (uint64_t) ( internal_hash_map->number_of_stripes - 1 ) );
+
+	do
+	{
+		if( libcthreads_internal_lock_stripe_grab_by_index(
+		     (libcthreads_internal_lock_stripe_t *) internal_hash_map->lock_stripe,
+		     stripe_index,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab stripe for writing.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_internal_hash_map_migrate_stripe(
+		     internal_hash_map,
+		     stripe_index,
+		     key_hash,
+		     &resize_completed,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to migrate stripe.",
+			 function );
+
+			goto on_error_release_stripe;
+		}
+		/* A resize is started when the stripe holds on average more than
+		 * 2 entries per bucket
+		 */
+		if( ( resize_attempted != 0 )
+		 || ( internal_hash_map->previous_buckets != NULL )
+		 || ( internal_hash_map->number_of_buckets >= LIBCTHREADS_HASH_MAP_MAXIMUM_NUMBER_OF_BUCKETS )
+		 || ( internal_hash_map->stripes[ stripe_index ].number_of_entries < ( 2 * internal_hash_map->number_of_buckets ) / internal_hash_map->number_of_stripes ) )
+		{
+			break;
+		}
+		if( libcthreads_internal_lock_stripe_release_by_index(
+		     (libcthreads_internal_lock_stripe_t *) internal_hash_map->lock_stripe,
+		     stripe_index,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release stripe for writing.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_internal_hash_map_resize(
+		     internal_hash_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize hash map.",
+			 function );
+
+			goto on_error;
+		}
+		resize_attempted = 1;
+		resize_completed = 0;
+	}
+	while( 1 );
+
+	bucket_index = (int) ( key_hash & (uint64_t) ( internal_hash_map->number_of_buckets - 1 ) );
+
+	result = libcthreads_internal_hash_map_find_entry(
+	          internal_hash_map,
+	          &( internal_hash_map->buckets[ bucket_index ] ),
+	          key_hash,
+	          key,
+	          &entry_reference,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find entry.",
+		 function );
+
+		goto on_error_release_stripe;
+	}
+	else if( result == 0 )
+	{
+		entry->next_entry                          = internal_hash_map->buckets[ bucket_index ];
+		internal_hash_map->buckets[ bucket_index ] = entry;
+
+		internal_hash_map->stripes[ stripe_index ].number_of_entries += 1;
+
+		entry = NULL;
+	}
+	if( libcthreads_internal_lock_stripe_release_by_index(
+	     (libcthreads_internal_lock_stripe_t *) internal_hash_map->lock_stripe,
+	     stripe_index,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release stripe for writing.",
+		 function );
+
+		goto on_error;
+	}
+	if( entry != NULL )
+	{
+		memory_free(
+		 entry );
+	}
+	if( resize_completed != 0 )
+	{
+		if( libcthreads_internal_hash_map_finish_resize(
+		     internal_hash_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to finish resize of hash map.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result == 0 );
+
+on_error_release_stripe:
+	libcthreads_internal_lock_stripe_release_by_index(
+	 (libcthreads_internal_lock_stripe_t *) internal_hash_map->lock_stripe,
+	 stripe_index,
+	 0,
+	 NULL );
+
+on_error:
+	if( entry != NULL )
+	{
+		memory_free(
+		 entry );
+	}
+	return( -1 );
+}
+
+/* Removes the value of a key
+ * The removed key and value are returned so that they can be freed by the caller
+ * Returns 1 if successful, 0 if no such key or -1 on error
+ */
+int libcthreads_hash_map_remove_value(
+     libcthreads_hash_map_t *hash_map,
+     intptr_t *key,
+     intptr_t **removed_key,
+     intptr_t **removed_value,
+     libcerror_error_t **error )
+{
+	libcthreads_hash_map_entry_t *entry                = NULL;
+	libcthreads_hash_map_entry_t **entry_reference     = NULL;
+	libcthreads_internal_hash_map_t *internal_hash_map = NULL;
+	static char *function                              = "libcthreads_hash_map_remove_value";
+	uint64_t key_hash                                  = 0;
+	uint8_t resize_completed                           = 0;
+	int bucket_index                                   = 0;
+	int result                                         = 0;
+	int stripe_index                                   = 0;
+
+	if( hash_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash map.",
+		 function );
+
+		return( -1 );
+	}
+	internal_hash_map = (libcthreads_internal_hash_map_t *) hash_map;
+
+	if( removed_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid removed key.",
+		 function );
+
+		return( -1 );
+	}
+	if( removed_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid removed value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_hash_map_get_key_hash(
+	     internal_hash_map,
+	     key,
+	     &key_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve key hash.",
+		 function );
+
+		return( -1 );
+	}
+	stripe_index = (int) ( key_hash & (uint64_t) ( internal_hash_map->number_of_stripes - 1 ) );
+
+	if( libcthreads_internal_lock_stripe_grab_by_index(
+	     (libcthreads_internal_lock_stripe_t *) internal_hash_map->lock_stripe,
+	     stripe_index,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab stripe for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_hash_map_migrate_stripe(
+	     internal_hash_map,
+	     stripe_index,
+	     key_hash,
+	     &resize_completed,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to migrate stripe.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		bucket_index = (int) ( key_hash & (uint64_t) ( internal_hash_map->number_of_buckets - 1 ) );
+
+		result = libcthreads_internal_hash_map_find_entry(
+		          internal_hash_map,
+		          &( internal_hash_map->buckets[ bucket_index ] ),
+		          key_hash,
+		          key,
+		          &entry_reference,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to find entry.",
+			 function );
+		}
+		else if( result == 1 )
+		{
+			entry            = *entry_reference;
+			*entry_reference = entry->next_entry;
+
+			internal_hash_map->stripes[ stripe_index ].number_of_entries -= 1;
+		}
+	}
+	if( libcthreads_internal_lock_stripe_release_by_index(
+	     (libcthreads_internal_lock_stripe_t *) internal_hash_map->lock_stripe,
+	     stripe_index,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release stripe for writing.",
+		 function );
+
+		result = -1;
+	}
+	if( entry != NULL )
+	{
+		*removed_key   = entry->key;
+		*removed_value = entry->value;
+
+		memory_free(
+		 entry );
+	}
+	if( resize_completed != 0 )
+	{
+		if( libcthreads_internal_hash_map_finish_resize(
+		     internal_hash_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to finish resize of hash map.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
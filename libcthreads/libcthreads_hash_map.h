@@ -0,0 +1,262 @@
+/*
+ * Concurrent hash map functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_HASH_MAP_H )
+#define _LIBCTHREADS_INTERNAL_HASH_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_definitions.h"
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The maximum number of buckets
+ */
+#define LIBCTHREADS_HASH_MAP_MAXIMUM_NUMBER_OF_BUCKETS		( 1 << 28 )
+
+/* The minimum number of buckets
+ */
+#define LIBCTHREADS_HASH_MAP_MINIMUM_NUMBER_OF_BUCKETS		16
+
+/* The number of previous buckets a write moves to the current buckets
+ * in addition to the bucket of the key, while the hash map is resized
+ */
+#define LIBCTHREADS_HASH_MAP_NUMBER_OF_MIGRATED_BUCKETS		2
+
+typedef struct libcthreads_hash_map_entry libcthreads_hash_map_entry_t;
+
+struct libcthreads_hash_map_entry
+{
+	/* The scrambled key hash
+	 */
+	uint64_t key_hash;
+
+	/* The key
+	 */
+	intptr_t *key;
+
+	/* The value
+	 */
+	intptr_t *value;
+
+	/* The next entry in the bucket
+	 */
+	libcthreads_hash_map_entry_t *next_entry;
+};
+
+typedef struct libcthreads_hash_map_stripe libcthreads_hash_map_stripe_t;
+
+struct libcthreads_hash_map_stripe
+{
+	/* The number of entries of the stripe
+	 */
+	int number_of_entries;
+
+	/* The index of the next previous bucket of the stripe to migrate
+	 */
+	int migration_bucket_index;
+
+	/* Value to indicate the previous buckets of the stripe are being migrated
+	 */
+	uint8_t migration_pending;
+
+	/* Padding to prevent stripes from sharing a cache line
+	 */
+	uint8_t padding[ LIBCTHREADS_CACHE_LINE_SIZE - ( 2 * sizeof( int ) ) - 1 ];
+};
+
+typedef struct libcthreads_internal_hash_map libcthreads_internal_hash_map_t;
+
+struct libcthreads_internal_hash_map
+{
+	/* The lock stripe, stripe i protects the buckets with index i modulo
+	 * the number of stripes, in both the current and previous buckets
+	 */
+	libcthreads_lock_stripe_t *lock_stripe;
+
+	/* The per stripe state
+	 */
+	libcthreads_hash_map_stripe_t *stripes;
+
+	/* The number of stripes
+	 */
+	int number_of_stripes;
+
+	/* The current buckets
+	 */
+	libcthreads_hash_map_entry_t **buckets;
+
+	/* The number of current buckets
+	 */
+	int number_of_buckets;
+
+	/* The previous buckets, these are not NULL while the hash map is resized
+	 */
+	libcthreads_hash_map_entry_t **previous_buckets;
+
+	/* The number of previous buckets
+	 */
+	int number_of_previous_buckets;
+
+	/* The number of stripes that completed migration of the previous buckets
+	 */
+	int number_of_migrated_stripes;
+
+	/* The resize mutex, this protects the number of migrated stripes
+	 */
+	libcthreads_mutex_t *resize_mutex;
+
+	/* The key hash function
+	 */
+	int (*key_hash_function)(
+	       intptr_t *key,
+	       uint64_t *key_hash,
+	       libcerror_error_t **error );
+
+	/* The key compare function
+	 */
+	int (*key_compare_function)(
+	       intptr_t *first_key,
+	       intptr_t *second_key,
+	       libcerror_error_t **error );
+};
+
+LIBCTHREADS_EXTERN \
+int libcthreads_hash_map_initialize(
+     libcthreads_hash_map_t **hash_map,
+     int number_of_stripes,
+     int (*key_hash_function)(
+            intptr_t *key,
+            uint64_t *key_hash,
+            libcerror_error_t **error ),
+     int (*key_compare_function)(
+            intptr_t *first_key,
+            intptr_t *second_key,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libcthreads_internal_hash_map_free_buckets(
+     libcthreads_hash_map_entry_t **buckets,
+     int number_of_buckets,
+     int (*key_free_function)(
+            intptr_t **key,
+            libcerror_error_t **error ),
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_hash_map_free(
+     libcthreads_hash_map_t **hash_map,
+     int (*key_free_function)(
+            intptr_t **key,
+            libcerror_error_t **error ),
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libcthreads_internal_hash_map_get_key_hash(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     intptr_t *key,
+     uint64_t *key_hash,
+     libcerror_error_t **error );
+
+int libcthreads_internal_hash_map_find_entry(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     libcthreads_hash_map_entry_t **first_entry_reference,
+     uint64_t key_hash,
+     intptr_t *key,
+     libcthreads_hash_map_entry_t ***entry_reference,
+     libcerror_error_t **error );
+
+int libcthreads_internal_hash_map_grab_all_stripes(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     libcerror_error_t **error );
+
+int libcthreads_internal_hash_map_release_all_stripes(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     libcerror_error_t **error );
+
+void libcthreads_internal_hash_map_migrate_bucket(
+      libcthreads_internal_hash_map_t *internal_hash_map,
+      int previous_bucket_index );
+
+int libcthreads_internal_hash_map_migrate_stripe(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     int stripe_index,
+     uint64_t key_hash,
+     uint8_t *resize_completed,
+     libcerror_error_t **error );
+
+int libcthreads_internal_hash_map_resize(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     libcerror_error_t **error );
+
+int libcthreads_internal_hash_map_finish_resize(
+     libcthreads_internal_hash_map_t *internal_hash_map,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_hash_map_get_number_of_entries(
+     libcthreads_hash_map_t *hash_map,
+     int *number_of_entries,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_hash_map_get_value(
+     libcthreads_hash_map_t *hash_map,
+     intptr_t *key,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_hash_map_insert_value(
+     libcthreads_hash_map_t *hash_map,
+     intptr_t *key,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_hash_map_remove_value(
+     libcthreads_hash_map_t *hash_map,
+     intptr_t *key,
+     intptr_t **removed_key,
+     intptr_t **removed_value,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_HASH_MAP_H ) */
+
@@ -0,0 +1,1281 @@
+/*
+ * Hazard pointer domain functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libcthreads_hazard_pointer_domain.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_mutex.h"
+#include "libcthreads_thread_local.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#if defined( LIBCTHREADS_HAZARD_POINTER_DOMAIN_HAVE_ATOMICS )
+#define libcthreads_hazard_pointer_domain_get_value( value_reference ) \
+	(intptr_t *) libcthreads_internal_atomic_load_pointer( value_reference, LIBCTHREADS_MEMORY_ORDER_SEQUENTIALLY_CONSISTENT )
+
+#define libcthreads_hazard_pointer_domain_set_value( value_reference, value ) \
+	libcthreads_internal_atomic_store_pointer( value_reference, value, LIBCTHREADS_MEMORY_ORDER_SEQUENTIALLY_CONSISTENT )
+
+#define libcthreads_hazard_pointer_domain_get_first_record( record_reference ) \
+	(libcthreads_internal_hazard_pointer_domain_record_t *) libcthreads_internal_atomic_load_pointer( record_reference, LIBCTHREADS_MEMORY_ORDER_ACQUIRE )
+
+#define libcthreads_hazard_pointer_domain_set_first_record( record_reference, record ) \
+	libcthreads_internal_atomic_store_pointer( record_reference, record, LIBCTHREADS_MEMORY_ORDER_RELEASE )
+
+#define libcthreads_hazard_pointer_domain_memory_fence() \
+	libcthreads_internal_atomic_thread_fence( LIBCTHREADS_MEMORY_ORDER_SEQUENTIALLY_CONSISTENT )
+
+#else
+#define libcthreads_hazard_pointer_domain_get_value( value_reference ) \
+	*( value_reference )
+
+#define libcthreads_hazard_pointer_domain_set_value( value_reference, value ) \
+	*( value_reference ) = value
+
+#define libcthreads_hazard_pointer_domain_get_first_record( record_reference ) \
+	*( record_reference )
+
+#define libcthreads_hazard_pointer_domain_set_first_record( record_reference, record ) \
+	*( record_reference ) = record
+
+#define libcthreads_hazard_pointer_domain_memory_fence()
+
+#endif
+
+/* Clears the hazard pointers of the record when its owning thread exits,
+ * reclaims the retired values that are no longer protected and marks
+ * the record as orphaned
+ * The remaining retired values are taken over by the next thread
+ * that adopts the record
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_hazard_pointer_domain_record_exit(
+     intptr_t **record,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_hazard_pointer_domain_record_t *internal_record = NULL;
+	static char *function                                                = "libcthreads_internal_hazard_pointer_domain_record_exit";
+	int result                                                           = 1;
+	int slot_index                                                       = 0;
+
+	if( record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record.",
+		 function );
+
+		return( -1 );
+	}
+	if( *record == NULL )
+	{
+		return( 1 );
+	}
+	internal_record = (libcthreads_internal_hazard_pointer_domain_record_t *) *record;
+	*record         = NULL;
+
+	for( slot_index = 0;
+	     slot_index < internal_record->hazard_pointer_domain->number_of_slots;
+	     slot_index++ )
+	{
+		libcthreads_hazard_pointer_domain_set_value(
+		 &( internal_record->hazard_pointers[ slot_index ] ),
+		 NULL );
+	}
+	if( libcthreads_internal_hazard_pointer_domain_scan_record(
+	     internal_record->hazard_pointer_domain,
+	     internal_record,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to scan retired values.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_grab(
+	     internal_record->hazard_pointer_domain->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab records mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_record->is_orphaned = 1;
+
+	if( libcthreads_mutex_release(
+	     internal_record->hazard_pointer_domain->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release records mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Creates a hazard pointer domain
+ * Make sure the value hazard_pointer_domain is referencing, is set to NULL
+ *
+ * Every thread that uses the hazard pointer domain has number_of_slots
+ * hazard pointers to protect values it is about to access. Values that are
+ * retired are only freed, using the value free function, once no hazard
+ * pointer protects them anymore. Every thread holds at most a number
+ * of retired values proportional to the total number of hazard pointers.
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_hazard_pointer_domain_initialize(
+     libcthreads_hazard_pointer_domain_t **hazard_pointer_domain,
+     int number_of_slots,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libcthreads_internal_hazard_pointer_domain_t *internal_hazard_pointer_domain = NULL;
+	static char *function                                                        = "libcthreads_hazard_pointer_domain_initialize";
+
+	if( hazard_pointer_domain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hazard pointer domain.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hazard_pointer_domain != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hazard pointer domain value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_slots <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of slots value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_slots > LIBCTHREADS_HAZARD_POINTER_DOMAIN_MAXIMUM_NUMBER_OF_SLOTS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of slots value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_free_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value free function.",
+		 function );
+
+		return( -1 );
+	}
+	internal_hazard_pointer_domain = memory_allocate_structure(
+	                                  libcthreads_internal_hazard_pointer_domain_t );
+
+	if( internal_hazard_pointer_domain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hazard pointer domain.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_hazard_pointer_domain,
+	     0,
+	     sizeof( libcthreads_internal_hazard_pointer_domain_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hazard pointer domain.",
+		 function );
+
+		memory_free(
+		 internal_hazard_pointer_domain );
+
+		return( -1 );
+	}
+	internal_hazard_pointer_domain->number_of_slots     = number_of_slots;
+	internal_hazard_pointer_domain->value_free_function = value_free_function;
+
+	if( libcthreads_mutex_initialize(
+	     &( internal_hazard_pointer_domain->records_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create records mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_local_initialize(
+	     &( internal_hazard_pointer_domain->record_storage ),
+	     &libcthreads_internal_hazard_pointer_domain_record_exit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create record storage.",
+		 function );
+
+		goto on_error;
+	}
+	*hazard_pointer_domain = (libcthreads_hazard_pointer_domain_t *) internal_hazard_pointer_domain;
+
+	return( 1 );
+
+on_error:
+	if( internal_hazard_pointer_domain != NULL )
+	{
+		if( internal_hazard_pointer_domain->records_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_hazard_pointer_domain->records_mutex ),
+			 NULL );
+		}
+		memory_free(
+		 internal_hazard_pointer_domain );
+	}
+	return( -1 );
+}
+
+/* Frees a hazard pointer domain
+ * All retired values are freed, regardless if they are protected,
+ * so no thread should use the hazard pointer domain anymore
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_hazard_pointer_domain_free(
+     libcthreads_hazard_pointer_domain_t **hazard_pointer_domain,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_hazard_pointer_domain_t *internal_hazard_pointer_domain = NULL;
+	libcthreads_internal_hazard_pointer_domain_record_t *record                  = NULL;
+	static char *function                                                        = "libcthreads_hazard_pointer_domain_free";
+	int result                                                                   = 1;
+
+	if( hazard_pointer_domain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hazard pointer domain.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hazard_pointer_domain != NULL )
+	{
+		internal_hazard_pointer_domain = (libcthreads_internal_hazard_pointer_domain_t *) *hazard_pointer_domain;
+		*hazard_pointer_domain         = NULL;
+
+		/* Freeing the record storage marks the records of the threads
+		 * that have not exited as orphaned
+		 */
+		if( libcthreads_thread_local_free(
+		     &( internal_hazard_pointer_domain->record_storage ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free record storage.",
+			 function );
+
+			result = -1;
+		}
+		while( internal_hazard_pointer_domain->first_record != NULL )
+		{
+			record = internal_hazard_pointer_domain->first_record;
+
+			internal_hazard_pointer_domain->first_record = record->next_record;
+
+			if( libcthreads_internal_hazard_pointer_domain_record_free(
+			     &record,
+			     internal_hazard_pointer_domain->value_free_function,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free record.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( internal_hazard_pointer_domain->records_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free records mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_hazard_pointer_domain );
+	}
+	return( result );
+}
+
+/* Frees a record and its retired values
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_hazard_pointer_domain_record_free(
+     libcthreads_internal_hazard_pointer_domain_record_t **record,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_hazard_pointer_domain_record_free";
+	int result            = 1;
+	int value_index       = 0;
+
+	if( record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record.",
+		 function );
+
+		return( -1 );
+	}
+	if( *record != NULL )
+	{
+		if( ( *record )->retired_values != NULL )
+		{
+			for( value_index = 0;
+			     value_index < ( *record )->number_of_retired_values;
+			     value_index++ )
+			{
+				if( value_free_function(
+				     &( ( *record )->retired_values[ value_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free retired value: %d.",
+					 function,
+					 value_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *record )->retired_values );
+		}
+		if( ( *record )->hazard_pointers_snapshot != NULL )
+		{
+			memory_free(
+			 ( *record )->hazard_pointers_snapshot );
+		}
+		memory_free(
+		 *record );
+
+		*record = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the record of the current thread
+ * If create_record is set an orphaned record is adopted
+ * or a new record is created if the current thread has none
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libcthreads_internal_hazard_pointer_domain_get_record(
+     libcthreads_internal_hazard_pointer_domain_t *internal_hazard_pointer_domain,
+     uint8_t create_record,
+     libcthreads_internal_hazard_pointer_domain_record_t **record,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_hazard_pointer_domain_record_t *safe_record = NULL;
+	static char *function                                            = "libcthreads_internal_hazard_pointer_domain_get_record";
+	int result                                                       = 0;
+
+	if( internal_hazard_pointer_domain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hazard pointer domain.",
+		 function );
+
+		return( -1 );
+	}
+	if( record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_thread_local_get_value(
+	          internal_hazard_pointer_domain->record_storage,
+	          (intptr_t **) &safe_record,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve record.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( result != 0 )
+	 || ( create_record == 0 ) )
+	{
+		*record = safe_record;
+
+		return( result );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_hazard_pointer_domain->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab records mutex.",
+		 function );
+
+		return( -1 );
+	}
+	safe_record = internal_hazard_pointer_domain->first_record;
+
+	while( safe_record != NULL )
+	{
+		if( safe_record->is_orphaned != 0 )
+		{
+			safe_record->is_orphaned = 0;
+
+			break;
+		}
+		safe_record = safe_record->next_record;
+	}
+	if( safe_record == NULL )
+	{
+		safe_record = memory_allocate_structure(
+		               libcthreads_internal_hazard_pointer_domain_record_t );
+
+		if( safe_record == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create record.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     safe_record,
+		     0,
+		     sizeof( libcthreads_internal_hazard_pointer_domain_record_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear record.",
+			 function );
+
+			memory_free(
+			 safe_record );
+
+			safe_record = NULL;
+
+			goto on_error;
+		}
+		safe_record->hazard_pointer_domain = internal_hazard_pointer_domain;
+		safe_record->scan_threshold        = LIBCTHREADS_HAZARD_POINTER_DOMAIN_MINIMUM_SCAN_THRESHOLD;
+		safe_record->next_record           = internal_hazard_pointer_domain->first_record;
+
+		/* Scans traverse the records without the records mutex
+		 * so the record is published after it has been set up
+		 */
+		libcthreads_hazard_pointer_domain_set_first_record(
+		 &( internal_hazard_pointer_domain->first_record ),
+		 safe_record );
+	}
+	if( libcthreads_thread_local_set_value(
+	     internal_hazard_pointer_domain->record_storage,
+	     (intptr_t *) safe_record,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set record.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     internal_hazard_pointer_domain->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release records mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*record = safe_record;
+
+	return( 1 );
+
+on_error:
+	/* A record that could not be assigned to the current thread
+	 * remains available for adoption
+	 */
+	if( safe_record != NULL )
+	{
+		safe_record->is_orphaned = 1;
+	}
+	libcthreads_mutex_release(
+	 internal_hazard_pointer_domain->records_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Compares two values by their address
+ * Returns -1 if the first value is smaller, 1 if it is larger or 0 if both are equal
+ */
+int libcthreads_internal_hazard_pointer_domain_compare_values(
+     const void *first_value,
+     const void *second_value )
+{
+	uintptr_t first_address  = (uintptr_t) *( (intptr_t * const *) first_value );
+	uintptr_t second_address = (uintptr_t) *( (intptr_t * const *) second_value );
+
+	if( first_address < second_address )
+	{
+		return( -1 );
+	}
+	else if( first_address > second_address )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Frees the retired values of a record that are not protected by any hazard pointer
+ * The published hazard pointers are copied into a sorted snapshot once per scan,
+ * so that every retired value is looked up with a binary search
+ * This function should only be called by the thread that owns the record
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_hazard_pointer_domain_scan_record(
+     libcthreads_internal_hazard_pointer_domain_t *internal_hazard_pointer_domain,
+     libcthreads_internal_hazard_pointer_domain_record_t *record,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_hazard_pointer_domain_record_t *first_record  = NULL;
+	libcthreads_internal_hazard_pointer_domain_record_t *hazard_record = NULL;
+	intptr_t **hazard_pointers_snapshot                                = NULL;
+	intptr_t *hazard_pointer                                           = NULL;
+	intptr_t *retired_value                                            = NULL;
+	static char *function                                              = "libcthreads_internal_hazard_pointer_domain_scan_record";
+	size_t hazard_pointers_snapshot_size                               = 0;
+	int number_of_hazard_pointers                                      = 0;
+	int number_of_protected_values                                     = 0;
+	int number_of_published_hazard_pointers                            = 0;
+	int result                                                         = 1;
+	int slot_index                                                     = 0;
+	int value_index                                                    = 0;
+
+	if( internal_hazard_pointer_domain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hazard pointer domain.",
+		 function );
+
+		return( -1 );
+	}
+	if( record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record.",
+		 function );
+
+		return( -1 );
+	}
+	if( record->number_of_retired_values == 0 )
+	{
+		return( 1 );
+	}
+#if defined( LIBCTHREADS_HAZARD_POINTER_DOMAIN_HAVE_ATOMICS )
+	/* Makes sure the values were unlinked before the hazard pointers are read
+	 */
+	libcthreads_hazard_pointer_domain_memory_fence();
+
+#else
+	if( libcthreads_mutex_grab(
+	     internal_hazard_pointer_domain->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab records mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Records are only added in front, hence the records that follow
+	 * the first record remain the same while the snapshot is taken
+	 */
+	first_record = libcthreads_hazard_pointer_domain_get_first_record(
+	                &( internal_hazard_pointer_domain->first_record ) );
+
+	for( hazard_record = first_record;
+	     hazard_record != NULL;
+	     hazard_record = hazard_record->next_record )
+	{
+		number_of_hazard_pointers += internal_hazard_pointer_domain->number_of_slots;
+	}
+	if( number_of_hazard_pointers > record->maximum_number_of_hazard_pointers )
+	{
+		if( (size_t) number_of_hazard_pointers > (size_t) ( SSIZE_MAX / sizeof( intptr_t * ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of hazard pointers value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		hazard_pointers_snapshot_size = sizeof( intptr_t * ) * number_of_hazard_pointers;
+
+		hazard_pointers_snapshot = (intptr_t **) memory_reallocate(
+		                                          record->hazard_pointers_snapshot,
+		                                          hazard_pointers_snapshot_size );
+
+		if( hazard_pointers_snapshot == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize hazard pointers snapshot.",
+			 function );
+
+			goto on_error;
+		}
+		record->hazard_pointers_snapshot          = hazard_pointers_snapshot;
+		record->maximum_number_of_hazard_pointers = number_of_hazard_pointers;
+	}
+	for( hazard_record = first_record;
+	     hazard_record != NULL;
+	     hazard_record = hazard_record->next_record )
+	{
+		for( slot_index = 0;
+		     slot_index < internal_hazard_pointer_domain->number_of_slots;
+		     slot_index++ )
+		{
+			hazard_pointer = libcthreads_hazard_pointer_domain_get_value(
+			                  &( hazard_record->hazard_pointers[ slot_index ] ) );
+
+			if( hazard_pointer != NULL )
+			{
+				record->hazard_pointers_snapshot[ number_of_published_hazard_pointers++ ] = hazard_pointer;
+			}
+		}
+	}
+#if !defined( LIBCTHREADS_HAZARD_POINTER_DOMAIN_HAVE_ATOMICS )
+	if( libcthreads_mutex_release(
+	     internal_hazard_pointer_domain->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release records mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( number_of_published_hazard_pointers > 1 )
+	{
+		qsort(
+		 record->hazard_pointers_snapshot,
+		 (size_t) number_of_published_hazard_pointers,
+		 sizeof( intptr_t * ),
+		 &libcthreads_internal_hazard_pointer_domain_compare_values );
+	}
+	/* Moves the protected values to the front and the values that
+	 * can be reclaimed to the back of the retired values
+	 */
+	number_of_protected_values = record->number_of_retired_values;
+
+	while( value_index < number_of_protected_values )
+	{
+		retired_value = record->retired_values[ value_index ];
+
+		if( ( number_of_published_hazard_pointers > 0 )
+		 && ( bsearch(
+		       &retired_value,
+		       record->hazard_pointers_snapshot,
+		       (size_t) number_of_published_hazard_pointers,
+		       sizeof( intptr_t * ),
+		       &libcthreads_internal_hazard_pointer_domain_compare_values ) != NULL ) )
+		{
+			value_index++;
+		}
+		else
+		{
+			number_of_protected_values--;
+
+			record->retired_values[ value_index ]                = record->retired_values[ number_of_protected_values ];
+			record->retired_values[ number_of_protected_values ] = retired_value;
+		}
+	}
+	for( value_index = number_of_protected_values;
+	     value_index < record->number_of_retired_values;
+	     value_index++ )
+	{
+		if( internal_hazard_pointer_domain->value_free_function(
+		     &( record->retired_values[ value_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free retired value: %d.",
+			 function,
+			 value_index );
+
+			result = -1;
+		}
+	}
+	record->number_of_retired_values = number_of_protected_values;
+
+	/* At most one retired value per hazard pointer remains after a scan,
+	 * scanning again once twice that number of values have been retired
+	 * makes sure at least half of the retired values can be reclaimed
+	 */
+	if( number_of_hazard_pointers < ( LIBCTHREADS_HAZARD_POINTER_DOMAIN_MINIMUM_SCAN_THRESHOLD / 2 ) )
+	{
+		record->scan_threshold = LIBCTHREADS_HAZARD_POINTER_DOMAIN_MINIMUM_SCAN_THRESHOLD;
+	}
+	else
+	{
+		record->scan_threshold = 2 * number_of_hazard_pointers;
+	}
+	return( result );
+
+on_error:
+#if !defined( LIBCTHREADS_HAZARD_POINTER_DOMAIN_HAVE_ATOMICS )
+	libcthreads_mutex_release(
+	 internal_hazard_pointer_domain->records_mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Protects the value referenced by value_reference with a hazard pointer
+ * of the current thread, the value remains valid, even if it is retired
+ * by another thread, until the hazard pointer slot is cleared or reused
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_hazard_pointer_domain_protect(
+     libcthreads_hazard_pointer_domain_t *hazard_pointer_domain,
+     int slot_index,
+     intptr_t **value_reference,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_hazard_pointer_domain_t *internal_hazard_pointer_domain = NULL;
+	libcthreads_internal_hazard_pointer_domain_record_t *record                  = NULL;
+	intptr_t *safe_value                                                         = NULL;
+	static char *function                                                        = "libcthreads_hazard_pointer_domain_protect";
+
+#if defined( LIBCTHREADS_HAZARD_POINTER_DOMAIN_HAVE_ATOMICS )
+	intptr_t *current_value                                                      = NULL;
+#endif
+
+	if( hazard_pointer_domain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hazard pointer domain.",
+		 function );
+
+		return( -1 );
+	}
+	internal_hazard_pointer_domain = (libcthreads_internal_hazard_pointer_domain_t *) hazard_pointer_domain;
+
+	if( ( slot_index < 0 )
+	 || ( slot_index >= internal_hazard_pointer_domain->number_of_slots ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid slot index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_reference == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value reference.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_hazard_pointer_domain_get_record(
+	     internal_hazard_pointer_domain,
+	     1,
+	     &record,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve record.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBCTHREADS_HAZARD_POINTER_DOMAIN_HAVE_ATOMICS )
+	/* The value is protected once it is still referenced
+	 * after the hazard pointer has been published
+	 */
+	safe_value = libcthreads_hazard_pointer_domain_get_value(
+	              value_reference );
+
+	do
+	{
+		libcthreads_hazard_pointer_domain_set_value(
+		 &( record->hazard_pointers[ slot_index ] ),
+		 safe_value );
+
+		current_value = safe_value;
+
+		safe_value = libcthreads_hazard_pointer_domain_get_value(
+		              value_reference );
+	}
+	while( safe_value != current_value );
+
+#else
+	if( libcthreads_mutex_grab(
+	     internal_hazard_pointer_domain->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab records mutex.",
+		 function );
+
+		return( -1 );
+	}
+	safe_value = *value_reference;
+
+	record->hazard_pointers[ slot_index ] = safe_value;
+
+	if( libcthreads_mutex_release(
+	     internal_hazard_pointer_domain->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release records mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*value = safe_value;
+
+	return( 1 );
+}
+
+/* Clears a hazard pointer of the current thread
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_hazard_pointer_domain_clear(
+     libcthreads_hazard_pointer_domain_t *hazard_pointer_domain,
+     int slot_index,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_hazard_pointer_domain_t *internal_hazard_pointer_domain = NULL;
+	libcthreads_internal_hazard_pointer_domain_record_t *record                  = NULL;
+	static char *function                                                        = "libcthreads_hazard_pointer_domain_clear";
+	int result                                                                   = 0;
+
+	if( hazard_pointer_domain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hazard pointer domain.",
+		 function );
+
+		return( -1 );
+	}
+	internal_hazard_pointer_domain = (libcthreads_internal_hazard_pointer_domain_t *) hazard_pointer_domain;
+
+	if( ( slot_index < 0 )
+	 || ( slot_index >= internal_hazard_pointer_domain->number_of_slots ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid slot index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_internal_hazard_pointer_domain_get_record(
+	          internal_hazard_pointer_domain,
+	          0,
+	          &record,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve record.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		libcthreads_hazard_pointer_domain_set_value(
+		 &( record->hazard_pointers[ slot_index ] ),
+		 NULL );
+	}
+	return( 1 );
+}
+
+/* Retires a value that has been unlinked from the shared data structure
+ * The value is freed using the value free function once it is
+ * no longer protected by a hazard pointer
+ * The hazard pointer domain only takes ownership of the value if successful
+ * or if the value was retired but reclaiming other retired values failed
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_hazard_pointer_domain_retire(
+     libcthreads_hazard_pointer_domain_t *hazard_pointer_domain,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_hazard_pointer_domain_t *internal_hazard_pointer_domain = NULL;
+	libcthreads_internal_hazard_pointer_domain_record_t *record                  = NULL;
+	intptr_t **retired_values                                                    = NULL;
+	static char *function                                                        = "libcthreads_hazard_pointer_domain_retire";
+	size_t retired_values_size                                                   = 0;
+	int maximum_number_of_retired_values                                         = 0;
+
+	if( hazard_pointer_domain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hazard pointer domain.",
+		 function );
+
+		return( -1 );
+	}
+	internal_hazard_pointer_domain = (libcthreads_internal_hazard_pointer_domain_t *) hazard_pointer_domain;
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_hazard_pointer_domain_get_record(
+	     internal_hazard_pointer_domain,
+	     1,
+	     &record,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve record.",
+		 function );
+
+		return( -1 );
+	}
+	if( record->number_of_retired_values >= record->maximum_number_of_retired_values )
+	{
+		if( record->maximum_number_of_retired_values == 0 )
+		{
+			maximum_number_of_retired_values = LIBCTHREADS_HAZARD_POINTER_DOMAIN_MINIMUM_SCAN_THRESHOLD;
+		}
+		else if( record->maximum_number_of_retired_values > (int) ( SSIZE_MAX / ( 2 * sizeof( intptr_t * ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid record - maximum number of retired values value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		else
+		{
+			maximum_number_of_retired_values = 2 * record->maximum_number_of_retired_values;
+		}
+		retired_values_size = sizeof( intptr_t * ) * maximum_number_of_retired_values;
+
+		retired_values = (intptr_t **) memory_reallocate(
+		                                record->retired_values,
+		                                retired_values_size );
+
+		if( retired_values == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize retired values.",
+			 function );
+
+			return( -1 );
+		}
+		record->retired_values                   = retired_values;
+		record->maximum_number_of_retired_values = maximum_number_of_retired_values;
+	}
+	record->retired_values[ record->number_of_retired_values ] = value;
+
+	record->number_of_retired_values += 1;
+
+	if( record->number_of_retired_values >= record->scan_threshold )
+	{
+		if( libcthreads_internal_hazard_pointer_domain_scan_record(
+		     internal_hazard_pointer_domain,
+		     record,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to scan retired values.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Frees the retired values of the current thread that are
+ * no longer protected by a hazard pointer
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_hazard_pointer_domain_scan(
+     libcthreads_hazard_pointer_domain_t *hazard_pointer_domain,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_hazard_pointer_domain_t *internal_hazard_pointer_domain = NULL;
+	libcthreads_internal_hazard_pointer_domain_record_t *record                  = NULL;
+	static char *function                                                        = "libcthreads_hazard_pointer_domain_scan";
+	int result                                                                   = 0;
+
+	if( hazard_pointer_domain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hazard pointer domain.",
+		 function );
+
+		return( -1 );
+	}
+	internal_hazard_pointer_domain = (libcthreads_internal_hazard_pointer_domain_t *) hazard_pointer_domain;
+
+	result = libcthreads_internal_hazard_pointer_domain_get_record(
+	          internal_hazard_pointer_domain,
+	          0,
+	          &record,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve record.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libcthreads_internal_hazard_pointer_domain_scan_record(
+		     internal_hazard_pointer_domain,
+		     record,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to scan retired values.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,199 @@
+/*
+ * Hazard pointer domain functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_HAZARD_POINTER_DOMAIN_H )
+#define _LIBCTHREADS_INTERNAL_HAZARD_POINTER_DOMAIN_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_atomic.h"
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The maximum number of hazard pointer slots per thread
+ */
+#define LIBCTHREADS_HAZARD_POINTER_DOMAIN_MAXIMUM_NUMBER_OF_SLOTS	16
+
+/* The minimum number of retired values of a thread before they are scanned
+ */
+#define LIBCTHREADS_HAZARD_POINTER_DOMAIN_MINIMUM_SCAN_THRESHOLD	32
+
+/* The hazard pointers are published and read atomically, if not available
+ * protecting a value and scanning are serialized by the records mutex
+ */
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+#define LIBCTHREADS_HAZARD_POINTER_DOMAIN_HAVE_ATOMICS
+#endif
+
+typedef struct libcthreads_internal_hazard_pointer_domain libcthreads_internal_hazard_pointer_domain_t;
+typedef struct libcthreads_internal_hazard_pointer_domain_record libcthreads_internal_hazard_pointer_domain_record_t;
+
+struct libcthreads_internal_hazard_pointer_domain_record
+{
+	/* The hazard pointer domain
+	 */
+	libcthreads_internal_hazard_pointer_domain_t *hazard_pointer_domain;
+
+	/* The hazard pointers, only written by the owning thread
+	 */
+	intptr_t *hazard_pointers[ LIBCTHREADS_HAZARD_POINTER_DOMAIN_MAXIMUM_NUMBER_OF_SLOTS ];
+
+	/* The retired values, only accessed by the owning thread
+	 */
+	intptr_t **retired_values;
+
+	/* The number of retired values
+	 */
+	int number_of_retired_values;
+
+	/* The maximum number of retired values that fit in the retired values
+	 */
+	int maximum_number_of_retired_values;
+
+	/* The number of retired values that triggers a scan
+	 */
+	int scan_threshold;
+
+	/* The snapshot of the hazard pointers of all records, sorted by a scan
+	 * and only accessed by the owning thread
+	 */
+	intptr_t **hazard_pointers_snapshot;
+
+	/* The maximum number of hazard pointers that fit in the snapshot
+	 */
+	int maximum_number_of_hazard_pointers;
+
+	/* The next record
+	 */
+	libcthreads_internal_hazard_pointer_domain_record_t *next_record;
+
+	/* Value to indicate the owning thread has exited
+	 */
+	uint8_t is_orphaned;
+};
+
+struct libcthreads_internal_hazard_pointer_domain
+{
+	/* The number of hazard pointer slots per thread
+	 */
+	int number_of_slots;
+
+	/* The value free function
+	 */
+	int (*value_free_function)(
+	       intptr_t **value,
+	       libcerror_error_t **error );
+
+	/* The thread local storage of the record of the current thread
+	 */
+	libcthreads_thread_local_t *record_storage;
+
+	/* The records mutex
+	 */
+	libcthreads_mutex_t *records_mutex;
+
+	/* The first record, records are only added in front and are not
+	 * removed until the hazard pointer domain is freed
+	 */
+	libcthreads_internal_hazard_pointer_domain_record_t *first_record;
+};
+
+LIBCTHREADS_EXTERN \
+int libcthreads_hazard_pointer_domain_initialize(
+     libcthreads_hazard_pointer_domain_t **hazard_pointer_domain,
+     int number_of_slots,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_hazard_pointer_domain_free(
+     libcthreads_hazard_pointer_domain_t **hazard_pointer_domain,
+     libcerror_error_t **error );
+
+int libcthreads_internal_hazard_pointer_domain_record_exit(
+     intptr_t **record,
+     libcerror_error_t **error );
+
+int libcthreads_internal_hazard_pointer_domain_record_free(
+     libcthreads_internal_hazard_pointer_domain_record_t **record,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libcthreads_internal_hazard_pointer_domain_get_record(
+     libcthreads_internal_hazard_pointer_domain_t *internal_hazard_pointer_domain,
+     uint8_t create_record,
+     libcthreads_internal_hazard_pointer_domain_record_t **record,
+     libcerror_error_t **error );
+
+int libcthreads_internal_hazard_pointer_domain_compare_values(
+     const void *first_value,
+     const void *second_value );
+
+int libcthreads_internal_hazard_pointer_domain_scan_record(
+     libcthreads_internal_hazard_pointer_domain_t *internal_hazard_pointer_domain,
+     libcthreads_internal_hazard_pointer_domain_record_t *record,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_hazard_pointer_domain_protect(
+     libcthreads_hazard_pointer_domain_t *hazard_pointer_domain,
+     int slot_index,
+     intptr_t **value_reference,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_hazard_pointer_domain_clear(
+     libcthreads_hazard_pointer_domain_t *hazard_pointer_domain,
+     int slot_index,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_hazard_pointer_domain_retire(
+     libcthreads_hazard_pointer_domain_t *hazard_pointer_domain,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_hazard_pointer_domain_scan(
+     libcthreads_hazard_pointer_domain_t *hazard_pointer_domain,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_HAZARD_POINTER_DOMAIN_H ) */
+
@@ -0,0 +1,445 @@
+/*
+ * Latch functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libcthreads_condition.h"
+#include "libcthreads_latch.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_mutex.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a latch
+ * Make sure the value latch is referencing, is set to NULL
+ *
+ * The latch opens after count_down has been called count times
+ * where a count of 0 represents a latch that is open immediately
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_latch_initialize(
+     libcthreads_latch_t **latch,
+     int count,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_latch_t *internal_latch = NULL;
+	static char *function                        = "libcthreads_latch_initialize";
+
+	if( latch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid latch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *latch != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid latch value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid count value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	internal_latch = memory_allocate_structure(
+	                  libcthreads_internal_latch_t );
+
+	if( internal_latch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create latch.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_latch,
+	     0,
+	     sizeof( libcthreads_internal_latch_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear latch.",
+		 function );
+
+		memory_free(
+		 internal_latch );
+
+		return( -1 );
+	}
+	internal_latch->count = count;
+
+	if( libcthreads_mutex_initialize(
+	     &( internal_latch->condition_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( internal_latch->open_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create open condition.",
+		 function );
+
+		goto on_error;
+	}
+	*latch = (libcthreads_latch_t *) internal_latch;
+
+	return( 1 );
+
+on_error:
+	if( internal_latch != NULL )
+	{
+		if( internal_latch->condition_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_latch->condition_mutex ),
+			 NULL );
+		}
+		memory_free(
+		 internal_latch );
+	}
+	return( -1 );
+}
+
+/* Frees a latch
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_latch_free(
+     libcthreads_latch_t **latch,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_latch_t *internal_latch = NULL;
+	static char *function                        = "libcthreads_latch_free";
+	int result                                   = 1;
+
+	if( latch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid latch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *latch != NULL )
+	{
+		internal_latch = (libcthreads_internal_latch_t *) *latch;
+		*latch         = NULL;
+
+		if( libcthreads_condition_free(
+		     &( internal_latch->open_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free open condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( internal_latch->condition_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_latch );
+	}
+	return( result );
+}
+
+/* Counts down the latch
+ * The latch opens when the count reaches 0
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_latch_count_down(
+     libcthreads_latch_t *latch,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_latch_t *internal_latch = NULL;
+	static char *function                        = "libcthreads_latch_count_down";
+
+	if( latch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid latch.",
+		 function );
+
+		return( -1 );
+	}
+	internal_latch = (libcthreads_internal_latch_t *) latch;
+
+	if( libcthreads_mutex_grab(
+	     internal_latch->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_latch->count <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid latch - count value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	internal_latch->count--;
+
+	if( internal_latch->count == 0 )
+	{
+		/* The condition broadcast must be protected by the mutex for the WINAPI version
+		 */
+		if( libcthreads_condition_broadcast(
+		     internal_latch->open_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast open condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_latch->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_latch->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Waits until the latch opens
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_latch_wait(
+     libcthreads_latch_t *latch,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_latch_t *internal_latch = NULL;
+	static char *function                        = "libcthreads_latch_wait";
+
+	if( latch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid latch.",
+		 function );
+
+		return( -1 );
+	}
+	internal_latch = (libcthreads_internal_latch_t *) latch;
+
+	if( libcthreads_mutex_grab(
+	     internal_latch->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( internal_latch->count > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     internal_latch->open_condition,
+		     internal_latch->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for open condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_latch->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_latch->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Determines if the latch is open without waiting
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libcthreads_latch_try_wait(
+     libcthreads_latch_t *latch,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_latch_t *internal_latch = NULL;
+	static char *function                        = "libcthreads_latch_try_wait";
+	int result                                   = 0;
+
+	if( latch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid latch.",
+		 function );
+
+		return( -1 );
+	}
+	internal_latch = (libcthreads_internal_latch_t *) latch;
+
+	if( libcthreads_mutex_grab(
+	     internal_latch->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_latch->count == 0 )
+	{
+		result = 1;
+	}
+	if( libcthreads_mutex_release(
+	     internal_latch->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
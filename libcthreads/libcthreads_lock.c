@@ -19,6 +19,12 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+/* Required for pthread_mutex_clocklock
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
 #include <common.h>
 #include <memory.h>
 #include <types.h>
@@ -29,28 +35,33 @@
 #include <pthread.h>
 #endif
 
+#include "libcthreads_clock.h"
 #include "libcthreads_libcerror.h"
 #include "libcthreads_lock.h"
+#include "libcthreads_lock_validator.h"
 #include "libcthreads_types.h"
+#include "libcthreads_unused.h"
 
 #if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
 
-/* Creates a lock
- * Make sure the value lock is referencing, is set to NULL
+/* Make sure the internal lock fits in the storage for in place initialization
+ */
+typedef char libcthreads_internal_lock_storage_size_check_t[ ( sizeof( libcthreads_internal_lock_t ) <= LIBCTHREADS_LOCK_STORAGE_SIZE ) ? 1 : -1 ];
+
+/* Initializes a lock in the provided memory
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_lock_initialize(
-     libcthreads_lock_t **lock,
+int libcthreads_internal_lock_initialize(
+     libcthreads_internal_lock_t *internal_lock,
      libcerror_error_t **error )
 {
-	libcthreads_internal_lock_t *internal_lock = NULL;
-	static char *function                      = "libcthreads_lock_initialize";
+	static char *function = "libcthreads_internal_lock_initialize";
 
 #if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                         = 0;
+	int pthread_result    = 0;
 #endif
 
-	if( lock == NULL )
+	if( internal_lock == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -61,31 +72,6 @@ int libcthreads_lock_initialize(
 
 		return( -1 );
 	}
-	if( *lock != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid lock value already set.",
-		 function );
-
-		return( -1 );
-	}
-	internal_lock = memory_allocate_structure(
-	                 libcthreads_internal_lock_t );
-
-	if( internal_lock == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create lock.",
-		 function );
-
-		goto on_error;
-	}
 	if( memory_set(
 	     internal_lock,
 	     0,
@@ -98,9 +84,6 @@ int libcthreads_lock_initialize(
 		 "%s: unable to clear lock.",
 		 function );
 
-		memory_free(
-		 internal_lock );
-
 		return( -1 );
 	}
 #if defined( WINAPI )
@@ -125,7 +108,7 @@ int libcthreads_lock_initialize(
 			 "%s: unable to initialize mutex with error: Insufficient resources.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 
 		default:
 			libcerror_system_set_error(
@@ -136,36 +119,22 @@ int libcthreads_lock_initialize(
 			 "%s: unable to initialize mutex.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 	}
 #endif
-	*lock = (libcthreads_lock_t *) internal_lock;
-
 	return( 1 );
-
-on_error:
-	if( internal_lock != NULL )
-	{
-		memory_free(
-		 internal_lock );
-	}
-	return( -1 );
 }
 
-/* Frees a lock
+/* Creates a lock
+ * Make sure the value lock is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_lock_free(
+int libcthreads_lock_initialize(
      libcthreads_lock_t **lock,
      libcerror_error_t **error )
 {
 	libcthreads_internal_lock_t *internal_lock = NULL;
-	static char *function                      = "libcthreads_lock_free";
-	int result                                 = 1;
-
-#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                         = 0;
-#endif
+	static char *function                      = "libcthreads_lock_initialize";
 
 	if( lock == NULL )
 	{
@@ -180,78 +149,70 @@ int libcthreads_lock_free(
 	}
 	if( *lock != NULL )
 	{
-		internal_lock = (libcthreads_internal_lock_t *) *lock;
-		*lock         = NULL;
-
-#if defined( WINAPI )
-		DeleteCriticalSection(
-		 &( internal_lock->critical_section ) );
-
-#elif defined( HAVE_PTHREAD_H )
-		pthread_result = pthread_mutex_destroy(
-		                  &( internal_lock->mutex ) );
-
-		switch( pthread_result )
-		{
-			case 0:
-				break;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid lock value already set.",
+		 function );
 
-			case EAGAIN:
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to destroy mutex with error: Insufficient resources.",
-				 function );
+		return( -1 );
+	}
+	internal_lock = memory_allocate_structure(
+	                 libcthreads_internal_lock_t );
 
-				result = -1;
-				break;
+	if( internal_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create lock.",
+		 function );
 
-			case EBUSY:
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to destroy mutex with error: Resource busy.",
-				 function );
+		goto on_error;
+	}
+	if( libcthreads_internal_lock_initialize(
+	     internal_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize lock.",
+		 function );
 
-				result = -1;
-				break;
+		goto on_error;
+	}
+	*lock = (libcthreads_lock_t *) internal_lock;
 
-			default:
-				libcerror_system_set_error(
-				 error,
-				 pthread_result,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to destroy mutex.",
-				 function );
+	return( 1 );
 
-				result = -1;
-				break;
-		}
-#endif
+on_error:
+	if( internal_lock != NULL )
+	{
 		memory_free(
 		 internal_lock );
 	}
-	return( result );
+	return( -1 );
 }
 
-/* Grabs a lock
+/* Finalizes a lock in the provided memory
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_lock_grab(
-     const libcthreads_lock_t *lock,
+int libcthreads_internal_lock_finalize(
+     libcthreads_internal_lock_t *internal_lock,
      libcerror_error_t **error )
 {
-	libcthreads_internal_lock_t *internal_lock = NULL;
-	static char *function                      = "libcthreads_lock_grab";
+	static char *function = "libcthreads_internal_lock_finalize";
+	int result            = 1;
 
 #if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                         = 0;
+	int pthread_result    = 0;
 #endif
 
-	if( lock == NULL )
+	if( internal_lock == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -262,14 +223,12 @@ int libcthreads_lock_grab(
 
 		return( -1 );
 	}
-	internal_lock = (libcthreads_internal_lock_t *) lock;
-
 #if defined( WINAPI )
-	EnterCriticalSection(
+	DeleteCriticalSection(
 	 &( internal_lock->critical_section ) );
 
 #elif defined( HAVE_PTHREAD_H )
-	pthread_result = pthread_mutex_lock(
+	pthread_result = pthread_mutex_destroy(
 	                  &( internal_lock->mutex ) );
 
 	switch( pthread_result )
@@ -282,20 +241,22 @@ int libcthreads_lock_grab(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to lock mutex with error: Maximum number of locks exceeded.",
+			 "%s: unable to destroy mutex with error: Insufficient resources.",
 			 function );
 
-			return( -1 );
+			result = -1;
+			break;
 
-		case EDEADLK:
+		case EBUSY:
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to lock mutex with error: Deadlock condition detected.",
+			 "%s: unable to destroy mutex with error: Resource busy.",
 			 function );
 
-			return( -1 );
+			result = -1;
+			break;
 
 		default:
 			libcerror_system_set_error(
@@ -303,28 +264,31 @@ int libcthreads_lock_grab(
 			 pthread_result,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to lock mutex.",
+			 "%s: unable to destroy mutex.",
 			 function );
 
-			return( -1 );
+			result = -1;
+			break;
 	}
 #endif
-	return( 1 );
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_remove_lock(
+	 internal_lock );
+#endif
+	return( result );
 }
 
-/* Releases a lock
+/* Frees a lock
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_lock_release(
-     const libcthreads_lock_t *lock,
+int libcthreads_lock_free(
+     libcthreads_lock_t **lock,
      libcerror_error_t **error )
 {
 	libcthreads_internal_lock_t *internal_lock = NULL;
-	static char *function                      = "libcthreads_lock_release";
-
-#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                         = 0;
-#endif
+	static char *function                      = "libcthreads_lock_free";
+	int result                                 = 1;
 
 	if( lock == NULL )
 	{
@@ -337,55 +301,622 @@ int libcthreads_lock_release(
 
 		return( -1 );
 	}
-	internal_lock = (libcthreads_internal_lock_t *) lock;
-
-#if defined( WINAPI )
-	LeaveCriticalSection(
-	 &( internal_lock->critical_section ) );
-
-#elif defined( HAVE_PTHREAD_H )
-	pthread_result = pthread_mutex_unlock(
-	                  &( internal_lock->mutex ) );
-
-	switch( pthread_result )
+	if( *lock != NULL )
 	{
-		case 0:
-			break;
+		internal_lock = (libcthreads_internal_lock_t *) *lock;
+		*lock         = NULL;
 
-		case EAGAIN:
+		if( libcthreads_internal_lock_finalize(
+		     internal_lock,
+		     error ) != 1 )
+		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to unlock mutex with error: Maximum number of locks exceeded.",
+			 "%s: unable to finalize lock.",
 			 function );
 
-			return( -1 );
+			result = -1;
+		}
+		memory_free(
+		 internal_lock );
+	}
+	return( result );
+}
 
-		case EDEADLK:
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to unlock mutex with error: Deadlock condition detected.",
-			 function );
+/* Initializes a lock in caller provided storage
+ * The storage must remain available until the lock is finalized
+ * Make sure the value lock is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_initialize_in_place(
+     libcthreads_lock_t **lock,
+     libcthreads_lock_storage_t *storage,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_lock_t *internal_lock = NULL;
+	static char *function                      = "libcthreads_lock_initialize_in_place";
 
-			return( -1 );
+	if( lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock.",
+		 function );
 
-		default:
-			libcerror_system_set_error(
-			 error,
-			 pthread_result,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to unlock mutex.",
-			 function );
+		return( -1 );
+	}
+	if( *lock != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid lock value already set.",
+		 function );
 
-			return( -1 );
+		return( -1 );
 	}
-#endif
+	if( storage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage.",
+		 function );
+
+		return( -1 );
+	}
+	internal_lock = (libcthreads_internal_lock_t *) storage;
+
+	if( libcthreads_internal_lock_initialize(
+	     internal_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize lock.",
+		 function );
+
+		return( -1 );
+	}
+	*lock = (libcthreads_lock_t *) internal_lock;
+
 	return( 1 );
 }
 
+/* Finalizes a lock that was initialized in caller provided storage
+ * The storage itself is not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_finalize_in_place(
+     libcthreads_lock_t **lock,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_lock_t *internal_lock = NULL;
+	static char *function                      = "libcthreads_lock_finalize_in_place";
+
+	if( lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( *lock != NULL )
+	{
+		internal_lock = (libcthreads_internal_lock_t *) *lock;
+		*lock         = NULL;
+
+		if( libcthreads_internal_lock_finalize(
+		     internal_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize lock.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Grabs a lock without an error object
+ * The error code is set to the system error code on error
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_lock_grab(
+     libcthreads_internal_lock_t *internal_lock,
+     uint32_t *error_code )
+{
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result = 0;
+#endif
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_check_acquire(
+	 internal_lock,
+	 0 );
+#endif
+
+#if defined( WINAPI )
+	LIBCTHREADS_UNREFERENCED_PARAMETER( error_code )
+
+	EnterCriticalSection(
+	 &( internal_lock->critical_section ) );
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_mutex_lock(
+	                  &( internal_lock->mutex ) );
+
+	if( pthread_result != 0 )
+	{
+		*error_code = (uint32_t) pthread_result;
+
+		return( -1 );
+	}
+#endif
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_acquired(
+	 internal_lock );
+#endif
+	return( 1 );
+}
+
+/* Tries to grab a lock without an error object
+ * The error code is set to the system error code on error
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libcthreads_internal_lock_try_grab(
+     libcthreads_internal_lock_t *internal_lock,
+     uint32_t *error_code )
+{
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result = 0;
+#endif
+
+#if defined( WINAPI )
+	LIBCTHREADS_UNREFERENCED_PARAMETER( error_code )
+
+	if( TryEnterCriticalSection(
+	     &( internal_lock->critical_section ) ) == 0 )
+	{
+		return( 0 );
+	}
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_mutex_trylock(
+	                  &( internal_lock->mutex ) );
+
+	if( pthread_result == EBUSY )
+	{
+		return( 0 );
+	}
+	else if( pthread_result != 0 )
+	{
+		*error_code = (uint32_t) pthread_result;
+
+		return( -1 );
+	}
+#endif
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_acquired(
+	 internal_lock );
+#endif
+	return( 1 );
+}
+
+/* Releases a lock without an error object
+ * The error code is set to the system error code on error
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_lock_release(
+     libcthreads_internal_lock_t *internal_lock,
+     uint32_t *error_code )
+{
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result = 0;
+#endif
+
+#if defined( WINAPI )
+	LIBCTHREADS_UNREFERENCED_PARAMETER( error_code )
+
+	LeaveCriticalSection(
+	 &( internal_lock->critical_section ) );
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_mutex_unlock(
+	                  &( internal_lock->mutex ) );
+
+	if( pthread_result != 0 )
+	{
+		*error_code = (uint32_t) pthread_result;
+
+		return( -1 );
+	}
+#endif
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_released(
+	 internal_lock );
+#endif
+	return( 1 );
+}
+
+/* Grabs a lock
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_grab(
+     const libcthreads_lock_t *lock,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_lock_grab";
+	uint32_t error_code   = 0;
+
+	if( lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_lock_grab(
+	     (libcthreads_internal_lock_t *) lock,
+	     &error_code ) != 1 )
+	{
+		switch( error_code )
+		{
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+			case EAGAIN:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to lock mutex with error: Maximum number of locks exceeded.",
+				 function );
+
+				break;
+
+			case EDEADLK:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to lock mutex with error: Deadlock condition detected.",
+				 function );
+
+				break;
+#endif
+			default:
+				libcerror_system_set_error(
+				 error,
+				 error_code,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to lock mutex.",
+				 function );
+
+				break;
+		}
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Grabs a lock without argument checks and error objects
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_grab_fast(
+     const libcthreads_lock_t *lock )
+{
+	uint32_t error_code = 0;
+
+	return( libcthreads_internal_lock_grab(
+	         (libcthreads_internal_lock_t *) lock,
+	         &error_code ) );
+}
+
+/* Tries to grab a lock
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libcthreads_lock_try_grab(
+     const libcthreads_lock_t *lock,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_lock_try_grab";
+	uint32_t error_code   = 0;
+	int result            = 0;
+
+	if( lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_internal_lock_try_grab(
+	          (libcthreads_internal_lock_t *) lock,
+	          &error_code );
+
+	if( result == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to try lock mutex.",
+		 function );
+	}
+	return( result );
+}
+
+/* Grabs a lock and waits at most until the deadline
+ * The deadline is in nanoseconds on the monotonic clock
+ * Returns 1 if successful, 0 if the deadline has passed or -1 on error
+ */
+int libcthreads_lock_grab_until(
+     const libcthreads_lock_t *lock,
+     uint64_t deadline,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_lock_t *internal_lock = NULL;
+	static char *function                      = "libcthreads_lock_grab_until";
+
+#if defined( HAVE_PTHREAD_H ) && defined( HAVE_PTHREAD_MUTEX_CLOCKLOCK ) && !defined( WINAPI )
+	struct timespec time_specification;
+
+	int pthread_result                         = 0;
+
+#else
+	uint64_t backoff_time                      = 0;
+	uint32_t error_code                        = 0;
+	int result                                 = 0;
+#endif
+
+	if( lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock.",
+		 function );
+
+		return( -1 );
+	}
+	internal_lock = (libcthreads_internal_lock_t *) lock;
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_check_acquire(
+	 internal_lock,
+	 0 );
+#endif
+
+#if defined( HAVE_PTHREAD_H ) && defined( HAVE_PTHREAD_MUTEX_CLOCKLOCK ) && !defined( WINAPI )
+	time_specification.tv_sec  = (time_t) ( deadline / 1000000000UL );
+	time_specification.tv_nsec = (long) ( deadline % 1000000000UL );
+
+	pthread_result = pthread_mutex_clocklock(
+	                  &( internal_lock->mutex ),
+	                  CLOCK_MONOTONIC,
+	                  &time_specification );
+
+	if( pthread_result == ETIMEDOUT )
+	{
+		return( 0 );
+	}
+	else if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to lock mutex.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_acquired(
+	 internal_lock );
+#endif
+
+#else
+	/* Without a timed grab on the monotonic clock retry with an increasing backoff
+	 */
+	result = libcthreads_internal_lock_try_grab(
+	          internal_lock,
+	          &error_code );
+
+	while( result == 0 )
+	{
+		result = libcthreads_clock_backoff_until(
+		          deadline,
+		          &backoff_time,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to back off.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		result = libcthreads_internal_lock_try_grab(
+		          internal_lock,
+		          &error_code );
+	}
+	if( result == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to try lock mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Grabs a lock and waits at most timeout nanoseconds
+ * Returns 1 if successful, 0 if the timeout has expired or -1 on error
+ */
+int libcthreads_lock_timed_grab(
+     const libcthreads_lock_t *lock,
+     uint64_t timeout,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_lock_timed_grab";
+	uint64_t deadline     = 0;
+	int result            = 0;
+
+	if( libcthreads_clock_get_deadline(
+	     timeout,
+	     &deadline,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine deadline.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_lock_grab_until(
+	          lock,
+	          deadline,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab lock.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Releases a lock
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_release(
+     const libcthreads_lock_t *lock,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_lock_release";
+	uint32_t error_code   = 0;
+
+	if( lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_lock_release(
+	     (libcthreads_internal_lock_t *) lock,
+	     &error_code ) != 1 )
+	{
+		switch( error_code )
+		{
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+			case EAGAIN:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to unlock mutex with error: Maximum number of locks exceeded.",
+				 function );
+
+				break;
+
+			case EDEADLK:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to unlock mutex with error: Deadlock condition detected.",
+				 function );
+
+				break;
+#endif
+			default:
+				libcerror_system_set_error(
+				 error,
+				 error_code,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to unlock mutex.",
+				 function );
+
+				break;
+		}
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases a lock without argument checks and error objects
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_release_fast(
+     const libcthreads_lock_t *lock )
+{
+	uint32_t error_code = 0;
+
+	return( libcthreads_internal_lock_release(
+	         (libcthreads_internal_lock_t *) lock,
+	         &error_code ) );
+}
+
 #endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
@@ -58,26 +58,82 @@ struct libcthreads_internal_lock
 #endif
 };
 
+int libcthreads_internal_lock_initialize(
+     libcthreads_internal_lock_t *internal_lock,
+     libcerror_error_t **error );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_lock_initialize(
      libcthreads_lock_t **lock,
      libcerror_error_t **error );
 
+int libcthreads_internal_lock_finalize(
+     libcthreads_internal_lock_t *internal_lock,
+     libcerror_error_t **error );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_lock_free(
      libcthreads_lock_t **lock,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_initialize_in_place(
+     libcthreads_lock_t **lock,
+     libcthreads_lock_storage_t *storage,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_finalize_in_place(
+     libcthreads_lock_t **lock,
+     libcerror_error_t **error );
+
+int libcthreads_internal_lock_grab(
+     libcthreads_internal_lock_t *internal_lock,
+     uint32_t *error_code );
+
+int libcthreads_internal_lock_try_grab(
+     libcthreads_internal_lock_t *internal_lock,
+     uint32_t *error_code );
+
+int libcthreads_internal_lock_release(
+     libcthreads_internal_lock_t *internal_lock,
+     uint32_t *error_code );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_lock_grab(
      const libcthreads_lock_t *lock,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_grab_fast(
+     const libcthreads_lock_t *lock );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_try_grab(
+     const libcthreads_lock_t *lock,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_grab_until(
+     const libcthreads_lock_t *lock,
+     uint64_t deadline,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_timed_grab(
+     const libcthreads_lock_t *lock,
+     uint64_t timeout,
+     libcerror_error_t **error );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_lock_release(
      const libcthreads_lock_t *lock,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_release_fast(
+     const libcthreads_lock_t *lock );
+
 #endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 #if defined( __cplusplus )
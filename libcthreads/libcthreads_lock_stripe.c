@@ -0,0 +1,1042 @@
+/*
+ * Lock stripe functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libcthreads_definitions.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_lock_stripe.h"
+#include "libcthreads_mutex.h"
+#include "libcthreads_read_write_lock.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a lock stripe
+ * Make sure the value lock_stripe is referencing, is set to NULL
+ *
+ * The number of stripes is rounded up to the next power of 2
+ * If the LIBCTHREADS_LOCK_STRIPE_FLAG_READ_WRITE flag is set the stripes
+ * are read/write locks, otherwise they are mutexes
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_stripe_initialize(
+     libcthreads_lock_stripe_t **lock_stripe,
+     int number_of_stripes,
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_lock_stripe_t *internal_lock_stripe = NULL;
+	libcthreads_mutex_t *mutex                               = NULL;
+	libcthreads_read_write_lock_t *read_write_lock           = NULL;
+	static char *function                                    = "libcthreads_lock_stripe_initialize";
+	size_t stripes_data_size                                 = 0;
+	size_t stripe_size                                       = 0;
+	int stripe_index                                         = 0;
+	int stripe_index_bits                                    = 0;
+
+	if( lock_stripe == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock stripe.",
+		 function );
+
+		return( -1 );
+	}
+	if( *lock_stripe != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid lock stripe value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_stripes <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of stripes value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_stripes > LIBCTHREADS_LOCK_STRIPE_MAXIMUM_NUMBER_OF_STRIPES )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of stripes value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( flags & ~( LIBCTHREADS_LOCK_STRIPE_FLAG_READ_WRITE ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags: 0x%02" PRIx8 ".",
+		 function,
+		 flags );
+
+		return( -1 );
+	}
+	while( ( 1 << stripe_index_bits ) < number_of_stripes )
+	{
+		stripe_index_bits++;
+	}
+	number_of_stripes = 1 << stripe_index_bits;
+
+	if( ( flags & LIBCTHREADS_LOCK_STRIPE_FLAG_READ_WRITE ) != 0 )
+	{
+		stripe_size = sizeof( libcthreads_read_write_lock_storage_t );
+	}
+	else
+	{
+		stripe_size = sizeof( libcthreads_mutex_storage_t );
+	}
+	/* Pad the stripes to a multitude of the cache line size so that
+	 * stripes do not share cache lines
+	 */
+	stripe_size = ( stripe_size + LIBCTHREADS_CACHE_LINE_SIZE - 1 ) & ~( (size_t) LIBCTHREADS_CACHE_LINE_SIZE - 1 );
+
+	/* Reserve space to align the stripes on a cache line boundary
+	 */
+	stripes_data_size = ( stripe_size * number_of_stripes ) + LIBCTHREADS_CACHE_LINE_SIZE;
+
+	internal_lock_stripe = memory_allocate_structure(
+	                        libcthreads_internal_lock_stripe_t );
+
+	if( internal_lock_stripe == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create lock stripe.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_lock_stripe,
+	     0,
+	     sizeof( libcthreads_internal_lock_stripe_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lock stripe.",
+		 function );
+
+		memory_free(
+		 internal_lock_stripe );
+
+		return( -1 );
+	}
+	internal_lock_stripe->stripes_data = (uint8_t *) memory_allocate(
+	                                                  stripes_data_size );
+
+	if( internal_lock_stripe->stripes_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stripes data.",
+		 function );
+
+		goto on_error;
+	}
+	internal_lock_stripe->stripes            = (uint8_t *) ( ( (intptr_t) internal_lock_stripe->stripes_data + LIBCTHREADS_CACHE_LINE_SIZE - 1 ) & ~( (intptr_t) LIBCTHREADS_CACHE_LINE_SIZE - 1 ) );
+	internal_lock_stripe->stripe_size        = stripe_size;
+	internal_lock_stripe->number_of_stripes  = number_of_stripes;
+	internal_lock_stripe->stripe_index_shift = (uint8_t) ( 64 - stripe_index_bits );
+	internal_lock_stripe->flags              = flags;
+
+	for( stripe_index = 0;
+	     stripe_index < number_of_stripes;
+	     stripe_index++ )
+	{
+		if( ( flags & LIBCTHREADS_LOCK_STRIPE_FLAG_READ_WRITE ) != 0 )
+		{
+			read_write_lock = NULL;
+
+			if( libcthreads_read_write_lock_initialize_in_place(
+			     &read_write_lock,
+			     (libcthreads_read_write_lock_storage_t *) &( internal_lock_stripe->stripes[ stripe_index * stripe_size ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize stripe: %d read/write lock.",
+				 function,
+				 stripe_index );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			mutex = NULL;
+
+			if( libcthreads_mutex_initialize_in_place(
+			     &mutex,
+			     (libcthreads_mutex_storage_t *) &( internal_lock_stripe->stripes[ stripe_index * stripe_size ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize stripe: %d mutex.",
+				 function,
+				 stripe_index );
+
+				goto on_error;
+			}
+		}
+		internal_lock_stripe->number_of_initialized_stripes += 1;
+	}
+	*lock_stripe = (libcthreads_lock_stripe_t *) internal_lock_stripe;
+
+	return( 1 );
+
+on_error:
+	if( internal_lock_stripe != NULL )
+	{
+		for( stripe_index = 0;
+		     stripe_index < internal_lock_stripe->number_of_initialized_stripes;
+		     stripe_index++ )
+		{
+			if( ( flags & LIBCTHREADS_LOCK_STRIPE_FLAG_READ_WRITE ) != 0 )
+			{
+				read_write_lock = (libcthreads_read_write_lock_t *) &( internal_lock_stripe->stripes[ stripe_index * stripe_size ] );
+
+				libcthreads_read_write_lock_finalize_in_place(
+				 &read_write_lock,
+				 NULL );
+			}
+			else
+			{
+				mutex = (libcthreads_mutex_t *) &( internal_lock_stripe->stripes[ stripe_index * stripe_size ] );
+
+				libcthreads_mutex_finalize_in_place(
+				 &mutex,
+				 NULL );
+			}
+		}
+		if( internal_lock_stripe->stripes_data != NULL )
+		{
+			memory_free(
+			 internal_lock_stripe->stripes_data );
+		}
+		memory_free(
+		 internal_lock_stripe );
+	}
+	return( -1 );
+}
+
+/* Frees a lock stripe
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_stripe_free(
+     libcthreads_lock_stripe_t **lock_stripe,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_lock_stripe_t *internal_lock_stripe = NULL;
+	libcthreads_mutex_t *mutex                               = NULL;
+	libcthreads_read_write_lock_t *read_write_lock           = NULL;
+	static char *function                                    = "libcthreads_lock_stripe_free";
+	int result                                               = 1;
+	int stripe_index                                         = 0;
+
+	if( lock_stripe == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock stripe.",
+		 function );
+
+		return( -1 );
+	}
+	if( *lock_stripe != NULL )
+	{
+		internal_lock_stripe = (libcthreads_internal_lock_stripe_t *) *lock_stripe;
+		*lock_stripe         = NULL;
+
+		for( stripe_index = 0;
+		     stripe_index < internal_lock_stripe->number_of_initialized_stripes;
+		     stripe_index++ )
+		{
+			if( ( internal_lock_stripe->flags & LIBCTHREADS_LOCK_STRIPE_FLAG_READ_WRITE ) != 0 )
+			{
+				read_write_lock = (libcthreads_read_write_lock_t *) &( internal_lock_stripe->stripes[ stripe_index * internal_lock_stripe->stripe_size ] );
+
+				if( libcthreads_read_write_lock_finalize_in_place(
+				     &read_write_lock,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to finalize stripe: %d read/write lock.",
+					 function,
+					 stripe_index );
+
+					result = -1;
+				}
+			}
+			else
+			{
+				mutex = (libcthreads_mutex_t *) &( internal_lock_stripe->stripes[ stripe_index * internal_lock_stripe->stripe_size ] );
+
+				if( libcthreads_mutex_finalize_in_place(
+				     &mutex,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to finalize stripe: %d mutex.",
+					 function,
+					 stripe_index );
+
+					result = -1;
+				}
+			}
+		}
+		memory_free(
+		 internal_lock_stripe->stripes_data );
+
+		memory_free(
+		 internal_lock_stripe );
+	}
+	return( result );
+}
+
+/* Retrieves the number of stripes
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_stripe_get_number_of_stripes(
+     libcthreads_lock_stripe_t *lock_stripe,
+     int *number_of_stripes,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_lock_stripe_t *internal_lock_stripe = NULL;
+	static char *function                                    = "libcthreads_lock_stripe_get_number_of_stripes";
+
+	if( lock_stripe == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock stripe.",
+		 function );
+
+		return( -1 );
+	}
+	internal_lock_stripe = (libcthreads_internal_lock_stripe_t *) lock_stripe;
+
+	if( number_of_stripes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of stripes.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_stripes = internal_lock_stripe->number_of_stripes;
+
+	return( 1 );
+}
+
+/* Determines the stripe index of a key hash
+ * The key hash is scrambled using Fibonacci hashing so that key hashes
+ * that only differ in their upper bits are spread over the stripes
+ * Returns the stripe index
+ */
+int libcthreads_internal_lock_stripe_get_index(
+     libcthreads_internal_lock_stripe_t *internal_lock_stripe,
+     uint64_t key_hash )
+{
+	if( internal_lock_stripe->number_of_stripes == 1 )
+	{
+		return( 0 );
+	}
+	key_hash *= (uint64_t) 0x9e3779b97f4a7c15UL;
+
+	return( (int) ( key_hash >> internal_lock_stripe->stripe_index_shift ) );
+}
+
+/* Retrieves the stripe index of a key hash
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_stripe_get_index_for_key(
+     libcthreads_lock_stripe_t *lock_stripe,
+     uint64_t key_hash,
+     int *stripe_index,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_lock_stripe_t *internal_lock_stripe = NULL;
+	static char *function                                    = "libcthreads_lock_stripe_get_index_for_key";
+
+	if( lock_stripe == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock stripe.",
+		 function );
+
+		return( -1 );
+	}
+	internal_lock_stripe = (libcthreads_internal_lock_stripe_t *) lock_stripe;
+
+	if( stripe_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stripe index.",
+		 function );
+
+		return( -1 );
+	}
+	*stripe_index = libcthreads_internal_lock_stripe_get_index(
+	                 internal_lock_stripe,
+	                 key_hash );
+
+	return( 1 );
+}
+
+/* Grabs a stripe
+ * If for_read is set and the stripes are read/write locks the stripe is grabbed for reading,
+ * otherwise the stripe is grabbed exclusively
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_lock_stripe_grab_by_index(
+     libcthreads_internal_lock_stripe_t *internal_lock_stripe,
+     int stripe_index,
+     uint8_t for_read,
+     libcerror_error_t **error )
+{
+	uint8_t *stripe       = NULL;
+	static char *function = "libcthreads_internal_lock_stripe_grab_by_index";
+	int result            = 0;
+
+	stripe = &( internal_lock_stripe->stripes[ stripe_index * internal_lock_stripe->stripe_size ] );
+
+	if( ( internal_lock_stripe->flags & LIBCTHREADS_LOCK_STRIPE_FLAG_READ_WRITE ) == 0 )
+	{
+		result = libcthreads_mutex_grab(
+		          (libcthreads_mutex_t *) stripe,
+		          error );
+	}
+	else if( for_read != 0 )
+	{
+		result = libcthreads_read_write_lock_grab_for_read(
+		          (libcthreads_read_write_lock_t *) stripe,
+		          error );
+	}
+	else
+	{
+		result = libcthreads_read_write_lock_grab_for_write(
+		          (libcthreads_read_write_lock_t *) stripe,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab stripe: %d.",
+		 function,
+		 stripe_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases a stripe
+ * The value of for_read must match the value used to grab the stripe
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_lock_stripe_release_by_index(
+     libcthreads_internal_lock_stripe_t *internal_lock_stripe,
+     int stripe_index,
+     uint8_t for_read,
+     libcerror_error_t **error )
+{
+	uint8_t *stripe       = NULL;
+	static char *function = "libcthreads_internal_lock_stripe_release_by_index";
+	int result            = 0;
+
+	stripe = &( internal_lock_stripe->stripes[ stripe_index * internal_lock_stripe->stripe_size ] );
+
+	if( ( internal_lock_stripe->flags & LIBCTHREADS_LOCK_STRIPE_FLAG_READ_WRITE ) == 0 )
+	{
+		result = libcthreads_mutex_release(
+		          (libcthreads_mutex_t *) stripe,
+		          error );
+	}
+	else if( for_read != 0 )
+	{
+		result = libcthreads_read_write_lock_release_for_read(
+		          (libcthreads_read_write_lock_t *) stripe,
+		          error );
+	}
+	else
+	{
+		result = libcthreads_read_write_lock_release_for_write(
+		          (libcthreads_read_write_lock_t *) stripe,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release stripe: %d.",
+		 function,
+		 stripe_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Grabs the stripe of a key hash exclusively
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_stripe_grab_for_key(
+     libcthreads_lock_stripe_t *lock_stripe,
+     uint64_t key_hash,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_lock_stripe_t *internal_lock_stripe = NULL;
+	static char *function                                    = "libcthreads_lock_stripe_grab_for_key";
+	int stripe_index                                         = 0;
+
+	if( lock_stripe == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock stripe.",
+		 function );
+
+		return( -1 );
+	}
+	internal_lock_stripe = (libcthreads_internal_lock_stripe_t *) lock_stripe;
+
+	stripe_index = libcthreads_internal_lock_stripe_get_index(
+	                internal_lock_stripe,
+	                key_hash );
+
+	if( libcthreads_internal_lock_stripe_grab_by_index(
+	     internal_lock_stripe,
+	     stripe_index,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab stripe for key.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Grabs the stripe of a key hash for reading
+ * If the stripes are mutexes the stripe is grabbed exclusively
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_stripe_grab_for_key_for_read(
+     libcthreads_lock_stripe_t *lock_stripe,
+     uint64_t key_hash,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_lock_stripe_t *internal_lock_stripe = NULL;
+	static char *function                                    = "libcthreads_lock_stripe_grab_for_key_for_read";
+	int stripe_index                                         = 0;
+
+	if( lock_stripe == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock stripe.",
+		 function );
+
+		return( -1 );
+	}
+	internal_lock_stripe = (libcthreads_internal_lock_stripe_t *) lock_stripe;
+
+	stripe_index = libcthreads_internal_lock_stripe_get_index(
+	                internal_lock_stripe,
+	                key_hash );
+
+	if( libcthreads_internal_lock_stripe_grab_by_index(
+	     internal_lock_stripe,
+	     stripe_index,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab stripe for key for reading.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases the stripe of a key hash that was grabbed exclusively
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_stripe_release_for_key(
+     libcthreads_lock_stripe_t *lock_stripe,
+     uint64_t key_hash,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_lock_stripe_t *internal_lock_stripe = NULL;
+	static char *function                                    = "libcthreads_lock_stripe_release_for_key";
+	int stripe_index                                         = 0;
+
+	if( lock_stripe == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock stripe.",
+		 function );
+
+		return( -1 );
+	}
+	internal_lock_stripe = (libcthreads_internal_lock_stripe_t *) lock_stripe;
+
+	stripe_index = libcthreads_internal_lock_stripe_get_index(
+	                internal_lock_stripe,
+	                key_hash );
+
+	if( libcthreads_internal_lock_stripe_release_by_index(
+	     internal_lock_stripe,
+	     stripe_index,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release stripe for key.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases the stripe of a key hash that was grabbed for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_stripe_release_for_key_for_read(
+     libcthreads_lock_stripe_t *lock_stripe,
+     uint64_t key_hash,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_lock_stripe_t *internal_lock_stripe = NULL;
+	static char *function                                    = "libcthreads_lock_stripe_release_for_key_for_read";
+	int stripe_index                                         = 0;
+
+	if( lock_stripe == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock stripe.",
+		 function );
+
+		return( -1 );
+	}
+	internal_lock_stripe = (libcthreads_internal_lock_stripe_t *) lock_stripe;
+
+	stripe_index = libcthreads_internal_lock_stripe_get_index(
+	                internal_lock_stripe,
+	                key_hash );
+
+	if( libcthreads_internal_lock_stripe_release_by_index(
+	     internal_lock_stripe,
+	     stripe_index,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release stripe for key for reading.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines the unique stripe indexes of key hashes in ascending order
+ * The stripe indexes array must be able to hold number of key hashes entries
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_lock_stripe_get_sorted_indexes(
+     libcthreads_internal_lock_stripe_t *internal_lock_stripe,
+     const uint64_t *key_hashes,
+     int number_of_key_hashes,
+     int *stripe_indexes,
+     int *number_of_stripe_indexes )
+{
+	int insert_index      = 0;
+	int key_hash_index    = 0;
+	int move_index        = 0;
+	int number_of_indexes = 0;
+	int stripe_index      = 0;
+
+	for( key_hash_index = 0;
+	     key_hash_index < number_of_key_hashes;
+	     key_hash_index++ )
+	{
+		stripe_index = libcthreads_internal_lock_stripe_get_index(
+		                internal_lock_stripe,
+		                key_hashes[ key_hash_index ] );
+
+		/* The number of key hashes is expected to be small, hence insertion sort
+		 */
+		insert_index = number_of_indexes;
+
+		while( ( insert_index > 0 )
+		    && ( stripe_indexes[ insert_index - 1 ] > stripe_index ) )
+		{
+			insert_index--;
+		}
+		if( ( insert_index > 0 )
+		 && ( stripe_indexes[ insert_index - 1 ] == stripe_index ) )
+		{
+			continue;
+		}
+		for( move_index = number_of_indexes;
+		     move_index > insert_index;
+		     move_index-- )
+		{
+			stripe_indexes[ move_index ] = stripe_indexes[ move_index - 1 ];
+		}
+		stripe_indexes[ insert_index ] = stripe_index;
+
+		number_of_indexes++;
+	}
+	*number_of_stripe_indexes = number_of_indexes;
+
+	return( 1 );
+}
+
+/* Grabs the stripes of multiple key hashes exclusively
+ * The stripes are grabbed in ascending stripe index order, which prevents
+ * deadlocks with other threads grabbing multiple stripes, and a stripe that
+ * is shared by multiple key hashes is only grabbed once
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_stripe_grab_multiple(
+     libcthreads_lock_stripe_t *lock_stripe,
+     const uint64_t *key_hashes,
+     int number_of_key_hashes,
+     libcerror_error_t **error )
+{
+	int stack_stripe_indexes[ LIBCTHREADS_LOCK_STRIPE_NUMBER_OF_STACK_INDEXES ];
+
+	libcthreads_internal_lock_stripe_t *internal_lock_stripe = NULL;
+	int *stripe_indexes                                      = NULL;
+	static char *function                                    = "libcthreads_lock_stripe_grab_multiple";
+	int number_of_grabbed_stripes                            = 0;
+	int number_of_stripe_indexes                             = 0;
+
+	if( lock_stripe == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock stripe.",
+		 function );
+
+		return( -1 );
+	}
+	internal_lock_stripe = (libcthreads_internal_lock_stripe_t *) lock_stripe;
+
+	if( key_hashes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key hashes.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_key_hashes <= 0 )
+	 || ( (size_t) number_of_key_hashes > (size_t) ( SSIZE_MAX / sizeof( int ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of key hashes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_key_hashes <= LIBCTHREADS_LOCK_STRIPE_NUMBER_OF_STACK_INDEXES )
+	{
+		stripe_indexes = stack_stripe_indexes;
+	}
+	else
+	{
+		stripe_indexes = (int *) memory_allocate(
+		                          sizeof( int ) * number_of_key_hashes );
+
+		if( stripe_indexes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create stripe indexes.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	libcthreads_internal_lock_stripe_get_sorted_indexes(
+	 internal_lock_stripe,
+	 key_hashes,
+	 number_of_key_hashes,
+	 stripe_indexes,
+	 &number_of_stripe_indexes );
+
+	for( number_of_grabbed_stripes = 0;
+	     number_of_grabbed_stripes < number_of_stripe_indexes;
+	     number_of_grabbed_stripes++ )
+	{
+		if( libcthreads_internal_lock_stripe_grab_by_index(
+		     internal_lock_stripe,
+		     stripe_indexes[ number_of_grabbed_stripes ],
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab stripe: %d.",
+			 function,
+			 stripe_indexes[ number_of_grabbed_stripes ] );
+
+			goto on_error;
+		}
+	}
+	if( stripe_indexes != stack_stripe_indexes )
+	{
+		memory_free(
+		 stripe_indexes );
+	}
+	return( 1 );
+
+on_error:
+	while( number_of_grabbed_stripes > 0 )
+	{
+		number_of_grabbed_stripes--;
+
+		libcthreads_internal_lock_stripe_release_by_index(
+		 internal_lock_stripe,
+		 stripe_indexes[ number_of_grabbed_stripes ],
+		 0,
+		 NULL );
+	}
+	if( stripe_indexes != stack_stripe_indexes )
+	{
+		memory_free(
+		 stripe_indexes );
+	}
+	return( -1 );
+}
+
+/* Releases the stripes of multiple key hashes that were grabbed with libcthreads_lock_stripe_grab_multiple
+ * The stripes are released in descending stripe index order
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_stripe_release_multiple(
+     libcthreads_lock_stripe_t *lock_stripe,
+     const uint64_t *key_hashes,
+     int number_of_key_hashes,
+     libcerror_error_t **error )
+{
+	int stack_stripe_indexes[ LIBCTHREADS_LOCK_STRIPE_NUMBER_OF_STACK_INDEXES ];
+
+	libcthreads_internal_lock_stripe_t *internal_lock_stripe = NULL;
+	int *stripe_indexes                                      = NULL;
+	static char *function                                    = "libcthreads_lock_stripe_release_multiple";
+	int number_of_stripe_indexes                             = 0;
+	int result                                               = 1;
+
+	if( lock_stripe == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lock stripe.",
+		 function );
+
+		return( -1 );
+	}
+	internal_lock_stripe = (libcthreads_internal_lock_stripe_t *) lock_stripe;
+
+	if( key_hashes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key hashes.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_key_hashes <= 0 )
+	 || ( (size_t) number_of_key_hashes > (size_t) ( SSIZE_MAX / sizeof( int ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of key hashes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_key_hashes <= LIBCTHREADS_LOCK_STRIPE_NUMBER_OF_STACK_INDEXES )
+	{
+		stripe_indexes = stack_stripe_indexes;
+	}
+	else
+	{
+		stripe_indexes = (int *) memory_allocate(
+		                          sizeof( int ) * number_of_key_hashes );
+
+		if( stripe_indexes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create stripe indexes.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	libcthreads_internal_lock_stripe_get_sorted_indexes(
+	 internal_lock_stripe,
+	 key_hashes,
+	 number_of_key_hashes,
+	 stripe_indexes,
+	 &number_of_stripe_indexes );
+
+	while( number_of_stripe_indexes > 0 )
+	{
+		number_of_stripe_indexes--;
+
+		if( libcthreads_internal_lock_stripe_release_by_index(
+		     internal_lock_stripe,
+		     stripe_indexes[ number_of_stripe_indexes ],
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release stripe: %d.",
+			 function,
+			 stripe_indexes[ number_of_stripe_indexes ] );
+
+			result = -1;
+		}
+	}
+	if( stripe_indexes != stack_stripe_indexes )
+	{
+		memory_free(
+		 stripe_indexes );
+	}
+	return( result );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,173 @@
+/*
+ * Lock stripe functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_LOCK_STRIPE_H )
+#define _LIBCTHREADS_INTERNAL_LOCK_STRIPE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The maximum number of stripes
+ */
+#define LIBCTHREADS_LOCK_STRIPE_MAXIMUM_NUMBER_OF_STRIPES	65536
+
+/* The number of stripe indexes that can be sorted without allocating memory
+ */
+#define LIBCTHREADS_LOCK_STRIPE_NUMBER_OF_STACK_INDEXES		32
+
+typedef struct libcthreads_internal_lock_stripe libcthreads_internal_lock_stripe_t;
+
+struct libcthreads_internal_lock_stripe
+{
+	/* The stripes data, this contains the stripes aligned on a cache line boundary
+	 */
+	uint8_t *stripes_data;
+
+	/* The stripes, each stripe is a mutex or read/write lock
+	 * that is padded to a multitude of the cache line size
+	 */
+	uint8_t *stripes;
+
+	/* The size of a stripe
+	 */
+	size_t stripe_size;
+
+	/* The number of stripes, this is a power of 2
+	 */
+	int number_of_stripes;
+
+	/* The number of initialized stripes
+	 */
+	int number_of_initialized_stripes;
+
+	/* The number of bits to shift the scrambled key hash to get the stripe index
+	 */
+	uint8_t stripe_index_shift;
+
+	/* The flags
+	 */
+	uint8_t flags;
+};
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_stripe_initialize(
+     libcthreads_lock_stripe_t **lock_stripe,
+     int number_of_stripes,
+     uint8_t flags,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_stripe_free(
+     libcthreads_lock_stripe_t **lock_stripe,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_stripe_get_number_of_stripes(
+     libcthreads_lock_stripe_t *lock_stripe,
+     int *number_of_stripes,
+     libcerror_error_t **error );
+
+int libcthreads_internal_lock_stripe_get_index(
+     libcthreads_internal_lock_stripe_t *internal_lock_stripe,
+     uint64_t key_hash );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_stripe_get_index_for_key(
+     libcthreads_lock_stripe_t *lock_stripe,
+     uint64_t key_hash,
+     int *stripe_index,
+     libcerror_error_t **error );
+
+int libcthreads_internal_lock_stripe_grab_by_index(
+     libcthreads_internal_lock_stripe_t *internal_lock_stripe,
+     int stripe_index,
+     uint8_t for_read,
+     libcerror_error_t **error );
+
+int libcthreads_internal_lock_stripe_release_by_index(
+     libcthreads_internal_lock_stripe_t *internal_lock_stripe,
+     int stripe_index,
+     uint8_t for_read,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_stripe_grab_for_key(
+     libcthreads_lock_stripe_t *lock_stripe,
+     uint64_t key_hash,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_stripe_grab_for_key_for_read(
+     libcthreads_lock_stripe_t *lock_stripe,
+     uint64_t key_hash,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_stripe_release_for_key(
+     libcthreads_lock_stripe_t *lock_stripe,
+     uint64_t key_hash,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_stripe_release_for_key_for_read(
+     libcthreads_lock_stripe_t *lock_stripe,
+     uint64_t key_hash,
+     libcerror_error_t **error );
+
+int libcthreads_internal_lock_stripe_get_sorted_indexes(
+     libcthreads_internal_lock_stripe_t *internal_lock_stripe,
+     const uint64_t *key_hashes,
+     int number_of_key_hashes,
+     int *stripe_indexes,
+     int *number_of_stripe_indexes );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_stripe_grab_multiple(
+     libcthreads_lock_stripe_t *lock_stripe,
+     const uint64_t *key_hashes,
+     int number_of_key_hashes,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_stripe_release_multiple(
+     libcthreads_lock_stripe_t *lock_stripe,
+     const uint64_t *key_hashes,
+     int number_of_key_hashes,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_LOCK_STRIPE_H ) */
+
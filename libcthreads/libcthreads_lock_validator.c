@@ -0,0 +1,969 @@
+/*
+ * Lock order validator functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+
+#if defined( HAVE_STDARG_H ) || defined( WINAPI )
+#include <stdarg.h>
+#elif defined( HAVE_VARARGS_H )
+#include <varargs.h>
+#else
+#error Missing headers stdarg.h and varargs.h
+#endif
+
+#include <stdio.h>
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#endif
+
+#if defined( HAVE_EXECINFO_H ) && !defined( WINAPI )
+#include <execinfo.h>
+#endif
+
+#endif /* defined( HAVE_LIBCTHREADS_LOCK_VALIDATION ) */
+
+#include "libcthreads_libcerror.h"
+#include "libcthreads_lock_validator.h"
+#include "libcthreads_unused.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The report function, when NULL reports are written to stderr
+ */
+static void (*libcthreads_lock_validator_report_function)(
+               const char *report,
+               void *arguments )                        = NULL;
+
+static void *libcthreads_lock_validator_report_function_arguments = NULL;
+
+/* The number of reported lock order violations
+ */
+static int libcthreads_lock_validator_number_of_reports           = 0;
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+
+#if defined( WINAPI )
+static CRITICAL_SECTION libcthreads_lock_validator_critical_section;
+
+static LONG libcthreads_lock_validator_critical_section_state     = 0;
+
+#elif defined( HAVE_PTHREAD_H ) && defined( HAVE_PTHREAD_SPIN_LOCK )
+static pthread_spinlock_t libcthreads_lock_validator_spin_lock;
+
+static pthread_once_t libcthreads_lock_validator_spin_lock_once   = PTHREAD_ONCE_INIT;
+
+#elif defined( HAVE_PTHREAD_H )
+static pthread_mutex_t libcthreads_lock_validator_mutex           = PTHREAD_MUTEX_INITIALIZER;
+
+#endif
+
+/* The threads that hold locks
+ */
+static libcthreads_lock_validator_thread_t *libcthreads_lock_validator_threads = NULL;
+
+/* The lock order graph, an edge is added for every lock acquired while another lock was held
+ */
+static libcthreads_lock_validator_edge_t *libcthreads_lock_validator_edges    = NULL;
+
+static int libcthreads_lock_validator_number_of_edges                         = 0;
+
+static int libcthreads_lock_validator_allocated_number_of_edges               = 0;
+
+/* Retrieves the backtrace of the calling thread
+ */
+void libcthreads_lock_validator_get_backtrace(
+      libcthreads_lock_validator_backtrace_t *stack_backtrace )
+{
+	if( stack_backtrace == NULL )
+	{
+		return;
+	}
+#if defined( WINAPI )
+	stack_backtrace->number_of_frames = (int) CaptureStackBackTrace(
+	                                           1,
+	                                           LIBCTHREADS_LOCK_VALIDATOR_MAXIMUM_NUMBER_OF_FRAMES,
+	                                           stack_backtrace->frames,
+	                                           NULL );
+
+#elif defined( HAVE_EXECINFO_H ) && defined( HAVE_BACKTRACE )
+	stack_backtrace->number_of_frames = backtrace(
+	                                     stack_backtrace->frames,
+	                                     LIBCTHREADS_LOCK_VALIDATOR_MAXIMUM_NUMBER_OF_FRAMES );
+
+#else
+	stack_backtrace->number_of_frames = 0;
+#endif
+}
+
+/* Prints a formatted string to a report
+ */
+void libcthreads_lock_validator_print(
+      char *report,
+      size_t report_size,
+      size_t *report_offset,
+      const char *format,
+      ... )
+{
+	va_list argument_list;
+
+	int print_count = 0;
+
+	if( ( report == NULL )
+	 || ( report_offset == NULL )
+	 || ( *report_offset >= report_size ) )
+	{
+		return;
+	}
+#if defined( HAVE_STDARG_H ) || defined( WINAPI )
+	va_start(
+	 argument_list,
+	 format );
+#elif defined( HAVE_VARARGS_H )
+	va_start(
+	 argument_list );
+#endif
+	print_count = narrow_string_vsnprintf(
+	               &( report[ *report_offset ] ),
+	               report_size - *report_offset,
+	               format,
+	               argument_list );
+
+	va_end(
+	 argument_list );
+
+	if( print_count < 0 )
+	{
+		return;
+	}
+	*report_offset += (size_t) print_count;
+
+	if( *report_offset >= report_size )
+	{
+		*report_offset = report_size - 1;
+	}
+}
+
+/* Prints a backtrace to a report
+ */
+void libcthreads_lock_validator_print_backtrace(
+      char *report,
+      size_t report_size,
+      size_t *report_offset,
+      const libcthreads_lock_validator_backtrace_t *stack_backtrace )
+{
+#if defined( HAVE_EXECINFO_H ) && defined( HAVE_BACKTRACE_SYMBOLS ) && !defined( WINAPI )
+	char **symbols  = NULL;
+#endif
+	int frame_index = 0;
+
+	if( stack_backtrace == NULL )
+	{
+		return;
+	}
+	if( stack_backtrace->number_of_frames <= 0 )
+	{
+		libcthreads_lock_validator_print(
+		 report,
+		 report_size,
+		 report_offset,
+		 "\t<backtrace not available>\n" );
+
+		return;
+	}
+#if defined( HAVE_EXECINFO_H ) && defined( HAVE_BACKTRACE_SYMBOLS ) && !defined( WINAPI )
+	symbols = backtrace_symbols(
+	           stack_backtrace->frames,
+	           stack_backtrace->number_of_frames );
+#endif
+	for( frame_index = 0;
+	     frame_index < stack_backtrace->number_of_frames;
+	     frame_index++ )
+	{
+#if defined( HAVE_EXECINFO_H ) && defined( HAVE_BACKTRACE_SYMBOLS ) && !defined( WINAPI )
+		if( symbols != NULL )
+		{
+			libcthreads_lock_validator_print(
+			 report,
+			 report_size,
+			 report_offset,
+			 "\t#%d %s\n",
+			 frame_index,
+			 symbols[ frame_index ] );
+
+			continue;
+		}
+#endif
+		libcthreads_lock_validator_print(
+		 report,
+		 report_size,
+		 report_offset,
+		 "\t#%d %p\n",
+		 frame_index,
+		 stack_backtrace->frames[ frame_index ] );
+	}
+#if defined( HAVE_EXECINFO_H ) && defined( HAVE_BACKTRACE_SYMBOLS ) && !defined( WINAPI )
+	if( symbols != NULL )
+	{
+		/* The symbols are allocated by backtrace_symbols using malloc
+		 */
+		free(
+		 symbols );
+	}
+#endif
+}
+
+/* Passes a report to the report function or writes it to stderr
+ * This function must be called without the validator being entered
+ */
+void libcthreads_lock_validator_report(
+      const char *report )
+{
+	void (*report_function)(
+	       const char *report,
+	       void *arguments )      = NULL;
+	void *report_function_arguments = NULL;
+
+	if( report == NULL )
+	{
+		return;
+	}
+	libcthreads_lock_validator_enter();
+
+	libcthreads_lock_validator_number_of_reports++;
+
+	report_function           = libcthreads_lock_validator_report_function;
+	report_function_arguments = libcthreads_lock_validator_report_function_arguments;
+
+	libcthreads_lock_validator_leave();
+
+	if( report_function != NULL )
+	{
+		report_function(
+		 report,
+		 report_function_arguments );
+	}
+	else
+	{
+		fprintf(
+		 stderr,
+		 "%s",
+		 report );
+	}
+}
+
+#if defined( HAVE_PTHREAD_H ) && defined( HAVE_PTHREAD_SPIN_LOCK ) && !defined( WINAPI )
+
+/* Initializes the validator spin lock
+ * A spin lock is used where available since the validator must not use the same primitives it validates
+ */
+void libcthreads_lock_validator_initialize_spin_lock(
+      void )
+{
+	pthread_spin_init(
+	 &libcthreads_lock_validator_spin_lock,
+	 PTHREAD_PROCESS_PRIVATE );
+}
+
+#endif /* defined( HAVE_PTHREAD_H ) && defined( HAVE_PTHREAD_SPIN_LOCK ) && !defined( WINAPI ) */
+
+/* Enters the validator
+ */
+void libcthreads_lock_validator_enter(
+      void )
+{
+#if defined( WINAPI )
+	/* The state is 0 when not initialized, 1 while being initialized and 2 when initialized
+	 */
+	if( InterlockedCompareExchange(
+	     &libcthreads_lock_validator_critical_section_state,
+	     1,
+	     0 ) == 0 )
+	{
+		InitializeCriticalSection(
+		 &libcthreads_lock_validator_critical_section );
+
+		InterlockedExchange(
+		 &libcthreads_lock_validator_critical_section_state,
+		 2 );
+	}
+	else
+	{
+		while( InterlockedCompareExchange(
+		        &libcthreads_lock_validator_critical_section_state,
+		        2,
+		        2 ) != 2 )
+		{
+			Sleep(
+			 0 );
+		}
+	}
+	EnterCriticalSection(
+	 &libcthreads_lock_validator_critical_section );
+
+#elif defined( HAVE_PTHREAD_H ) && defined( HAVE_PTHREAD_SPIN_LOCK )
+	pthread_once(
+	 &libcthreads_lock_validator_spin_lock_once,
+	 &libcthreads_lock_validator_initialize_spin_lock );
+
+	pthread_spin_lock(
+	 &libcthreads_lock_validator_spin_lock );
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_mutex_lock(
+	 &libcthreads_lock_validator_mutex );
+#endif
+}
+
+/* Leaves the validator
+ */
+void libcthreads_lock_validator_leave(
+      void )
+{
+#if defined( WINAPI )
+	LeaveCriticalSection(
+	 &libcthreads_lock_validator_critical_section );
+
+#elif defined( HAVE_PTHREAD_H ) && defined( HAVE_PTHREAD_SPIN_LOCK )
+	pthread_spin_unlock(
+	 &libcthreads_lock_validator_spin_lock );
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_mutex_unlock(
+	 &libcthreads_lock_validator_mutex );
+#endif
+}
+
+/* Retrieves the held locks of the calling thread
+ * The validator must be entered
+ * Returns the thread or NULL if not available
+ */
+libcthreads_lock_validator_thread_t *libcthreads_lock_validator_get_thread(
+                                      int create )
+{
+	libcthreads_lock_validator_thread_t *validator_thread = NULL;
+
+#if defined( WINAPI )
+	DWORD thread_identifier                               = GetCurrentThreadId();
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_t thread                                      = pthread_self();
+#endif
+
+	for( validator_thread = libcthreads_lock_validator_threads;
+	     validator_thread != NULL;
+	     validator_thread = validator_thread->next_thread )
+	{
+#if defined( WINAPI )
+		if( validator_thread->thread_identifier == thread_identifier )
+#elif defined( HAVE_PTHREAD_H )
+		if( pthread_equal(
+		     validator_thread->thread,
+		     thread ) != 0 )
+#endif
+		{
+			return( validator_thread );
+		}
+	}
+	if( create == 0 )
+	{
+		return( NULL );
+	}
+	validator_thread = memory_allocate_structure(
+	                    libcthreads_lock_validator_thread_t );
+
+	if( validator_thread == NULL )
+	{
+		return( NULL );
+	}
+	if( memory_set(
+	     validator_thread,
+	     0,
+	     sizeof( libcthreads_lock_validator_thread_t ) ) == NULL )
+	{
+		memory_free(
+		 validator_thread );
+
+		return( NULL );
+	}
+#if defined( WINAPI )
+	validator_thread->thread_identifier = thread_identifier;
+
+#elif defined( HAVE_PTHREAD_H )
+	validator_thread->thread = thread;
+#endif
+	validator_thread->next_thread = libcthreads_lock_validator_threads;
+
+	libcthreads_lock_validator_threads = validator_thread;
+
+	return( validator_thread );
+}
+
+/* Retrieves the index of the edge from the held lock to the acquired lock
+ * The validator must be entered
+ * Returns the edge index or -1 if not available
+ */
+int libcthreads_lock_validator_get_edge_index(
+     const void *held_lock,
+     const void *acquired_lock )
+{
+	int edge_index = 0;
+
+	for( edge_index = 0;
+	     edge_index < libcthreads_lock_validator_number_of_edges;
+	     edge_index++ )
+	{
+		if( ( libcthreads_lock_validator_edges[ edge_index ].held_lock == held_lock )
+		 && ( libcthreads_lock_validator_edges[ edge_index ].acquired_lock == acquired_lock ) )
+		{
+			return( edge_index );
+		}
+	}
+	return( -1 );
+}
+
+/* Searches the lock order graph for a path from one lock to another
+ * The validator must be entered
+ * Returns the index of the first edge of the path or -1 if not available
+ */
+int libcthreads_lock_validator_find_path(
+     const void *from_lock,
+     const void *to_lock )
+{
+	uint8_t *visited_edges  = NULL;
+	int *first_edge_indexes = NULL;
+	int *queued_edges       = NULL;
+	size_t array_size       = 0;
+	int edge_index          = 0;
+	int next_edge_index     = 0;
+	int number_of_queued    = 0;
+	int queue_index         = 0;
+	int result              = -1;
+
+	if( libcthreads_lock_validator_number_of_edges == 0 )
+	{
+		return( -1 );
+	}
+	array_size = sizeof( int ) * libcthreads_lock_validator_number_of_edges;
+
+	first_edge_indexes = (int *) memory_allocate(
+	                              array_size );
+
+	queued_edges = (int *) memory_allocate(
+	                        array_size );
+
+	visited_edges = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * libcthreads_lock_validator_number_of_edges );
+
+	if( ( first_edge_indexes == NULL )
+	 || ( queued_edges == NULL )
+	 || ( visited_edges == NULL ) )
+	{
+		goto on_error;
+	}
+	if( memory_set(
+	     visited_edges,
+	     0,
+	     sizeof( uint8_t ) * libcthreads_lock_validator_number_of_edges ) == NULL )
+	{
+		goto on_error;
+	}
+	/* Breadth-first search starting at the edges of the from lock
+	 */
+	for( edge_index = 0;
+	     edge_index < libcthreads_lock_validator_number_of_edges;
+	     edge_index++ )
+	{
+		if( libcthreads_lock_validator_edges[ edge_index ].held_lock == from_lock )
+		{
+			visited_edges[ edge_index ]              = 1;
+			first_edge_indexes[ edge_index ]         = edge_index;
+			queued_edges[ number_of_queued++ ] = edge_index;
+		}
+	}
+	while( queue_index < number_of_queued )
+	{
+		edge_index = queued_edges[ queue_index++ ];
+
+		if( libcthreads_lock_validator_edges[ edge_index ].acquired_lock == to_lock )
+		{
+			result = first_edge_indexes[ edge_index ];
+
+			break;
+		}
+		for( next_edge_index = 0;
+		     next_edge_index < libcthreads_lock_validator_number_of_edges;
+		     next_edge_index++ )
+		{
+			if( ( visited_edges[ next_edge_index ] == 0 )
+			 && ( libcthreads_lock_validator_edges[ next_edge_index ].held_lock == libcthreads_lock_validator_edges[ edge_index ].acquired_lock ) )
+			{
+				visited_edges[ next_edge_index ]      = 1;
+				first_edge_indexes[ next_edge_index ] = first_edge_indexes[ edge_index ];
+				queued_edges[ number_of_queued++ ]    = next_edge_index;
+			}
+		}
+	}
+on_error:
+	if( visited_edges != NULL )
+	{
+		memory_free(
+		 visited_edges );
+	}
+	if( queued_edges != NULL )
+	{
+		memory_free(
+		 queued_edges );
+	}
+	if( first_edge_indexes != NULL )
+	{
+		memory_free(
+		 first_edge_indexes );
+	}
+	return( result );
+}
+
+/* Appends an edge to the lock order graph
+ * The validator must be entered
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_validator_append_edge(
+     const libcthreads_lock_validator_held_lock_t *held_lock,
+     const void *acquired_lock,
+     const libcthreads_lock_validator_backtrace_t *acquired_backtrace )
+{
+	libcthreads_lock_validator_edge_t *edge  = NULL;
+	libcthreads_lock_validator_edge_t *edges = NULL;
+	int allocated_number_of_edges            = 0;
+
+	if( ( held_lock == NULL )
+	 || ( acquired_backtrace == NULL ) )
+	{
+		return( -1 );
+	}
+	if( libcthreads_lock_validator_number_of_edges >= libcthreads_lock_validator_allocated_number_of_edges )
+	{
+		allocated_number_of_edges = libcthreads_lock_validator_allocated_number_of_edges * 2;
+
+		if( allocated_number_of_edges == 0 )
+		{
+			allocated_number_of_edges = 64;
+		}
+		edges = (libcthreads_lock_validator_edge_t *) memory_reallocate(
+		                                               libcthreads_lock_validator_edges,
+		                                               sizeof( libcthreads_lock_validator_edge_t ) * allocated_number_of_edges );
+
+		if( edges == NULL )
+		{
+			return( -1 );
+		}
+		libcthreads_lock_validator_edges                     = edges;
+		libcthreads_lock_validator_allocated_number_of_edges = allocated_number_of_edges;
+	}
+	edge = &( libcthreads_lock_validator_edges[ libcthreads_lock_validator_number_of_edges++ ] );
+
+	edge->held_lock          = held_lock->lock;
+	edge->acquired_lock      = acquired_lock;
+	edge->held_backtrace     = held_lock->backtrace;
+	edge->acquired_backtrace = *acquired_backtrace;
+
+	return( 1 );
+}
+
+/* Validates the acquisition of a lock by the calling thread
+ * This function is called before the calling thread blocks on the lock
+ * Every lock order is reported only the first time it is seen
+ */
+void libcthreads_lock_validator_check_acquire(
+      const void *lock,
+      int flags )
+{
+	libcthreads_lock_validator_backtrace_t acquired_backtrace;
+
+	libcthreads_lock_validator_edge_t *path_edge          = NULL;
+	libcthreads_lock_validator_held_lock_t *held_lock     = NULL;
+	libcthreads_lock_validator_thread_t *validator_thread = NULL;
+	char *report                                          = NULL;
+	size_t report_offset                                  = 0;
+	int held_lock_index                                   = 0;
+	int path_edge_index                                   = 0;
+
+	if( lock == NULL )
+	{
+		return;
+	}
+	libcthreads_lock_validator_get_backtrace(
+	 &acquired_backtrace );
+
+	libcthreads_lock_validator_enter();
+
+	validator_thread = libcthreads_lock_validator_get_thread(
+	                    0 );
+
+	if( validator_thread == NULL )
+	{
+		libcthreads_lock_validator_leave();
+
+		return;
+	}
+	for( held_lock_index = 0;
+	     held_lock_index < validator_thread->number_of_held_locks;
+	     held_lock_index++ )
+	{
+		held_lock = &( validator_thread->held_locks[ held_lock_index ] );
+
+		if( ( held_lock->lock == lock )
+		 && ( ( flags & LIBCTHREADS_LOCK_VALIDATOR_FLAG_SHARED ) != 0 ) )
+		{
+			continue;
+		}
+		if( libcthreads_lock_validator_get_edge_index(
+		     held_lock->lock,
+		     lock ) != -1 )
+		{
+			continue;
+		}
+		if( held_lock->lock == lock )
+		{
+			path_edge_index = -1;
+		}
+		else
+		{
+			path_edge_index = libcthreads_lock_validator_find_path(
+			                   lock,
+			                   held_lock->lock );
+		}
+		if( ( report == NULL )
+		 && ( ( held_lock->lock == lock )
+		  ||  ( path_edge_index != -1 ) ) )
+		{
+			report = narrow_string_allocate(
+			          LIBCTHREADS_LOCK_VALIDATOR_REPORT_SIZE );
+
+			if( report != NULL )
+			{
+				report[ 0 ] = 0;
+
+				if( held_lock->lock == lock )
+				{
+					libcthreads_lock_validator_print(
+					 report,
+					 LIBCTHREADS_LOCK_VALIDATOR_REPORT_SIZE,
+					 &report_offset,
+					 "libcthreads: possible recursive locking detected\nlock: %p was acquired at:\n",
+					 lock );
+
+					libcthreads_lock_validator_print_backtrace(
+					 report,
+					 LIBCTHREADS_LOCK_VALIDATOR_REPORT_SIZE,
+					 &report_offset,
+					 &( held_lock->backtrace ) );
+				}
+				else
+				{
+					path_edge = &( libcthreads_lock_validator_edges[ path_edge_index ] );
+
+					libcthreads_lock_validator_print(
+					 report,
+					 LIBCTHREADS_LOCK_VALIDATOR_REPORT_SIZE,
+					 &report_offset,
+					 "libcthreads: possible lock order inversion detected\nlock: %p was acquired at:\n",
+					 held_lock->lock );
+
+					libcthreads_lock_validator_print_backtrace(
+					 report,
+					 LIBCTHREADS_LOCK_VALIDATOR_REPORT_SIZE,
+					 &report_offset,
+					 &( held_lock->backtrace ) );
+
+					libcthreads_lock_validator_print(
+					 report,
+					 LIBCTHREADS_LOCK_VALIDATOR_REPORT_SIZE,
+					 &report_offset,
+					 "previously lock: %p was acquired at:\n",
+					 path_edge->held_lock );
+
+					libcthreads_lock_validator_print_backtrace(
+					 report,
+					 LIBCTHREADS_LOCK_VALIDATOR_REPORT_SIZE,
+					 &report_offset,
+					 &( path_edge->held_backtrace ) );
+
+					libcthreads_lock_validator_print(
+					 report,
+					 LIBCTHREADS_LOCK_VALIDATOR_REPORT_SIZE,
+					 &report_offset,
+					 "while holding it lock: %p was acquired at:\n",
+					 path_edge->acquired_lock );
+
+					libcthreads_lock_validator_print_backtrace(
+					 report,
+					 LIBCTHREADS_LOCK_VALIDATOR_REPORT_SIZE,
+					 &report_offset,
+					 &( path_edge->acquired_backtrace ) );
+				}
+				libcthreads_lock_validator_print(
+				 report,
+				 LIBCTHREADS_LOCK_VALIDATOR_REPORT_SIZE,
+				 &report_offset,
+				 "lock: %p is now acquired at:\n",
+				 lock );
+
+				libcthreads_lock_validator_print_backtrace(
+				 report,
+				 LIBCTHREADS_LOCK_VALIDATOR_REPORT_SIZE,
+				 &report_offset,
+				 &acquired_backtrace );
+			}
+		}
+		/* The edge is added also for a reported lock order so that it is reported only once
+		 */
+		libcthreads_lock_validator_append_edge(
+		 held_lock,
+		 lock,
+		 &acquired_backtrace );
+	}
+	libcthreads_lock_validator_leave();
+
+	if( report != NULL )
+	{
+		libcthreads_lock_validator_report(
+		 report );
+
+		memory_free(
+		 report );
+	}
+}
+
+/* Marks a lock as held by the calling thread
+ * This function is called after the lock was acquired
+ */
+void libcthreads_lock_validator_acquired(
+      const void *lock )
+{
+	libcthreads_lock_validator_backtrace_t acquired_backtrace;
+
+	libcthreads_lock_validator_held_lock_t *held_lock     = NULL;
+	libcthreads_lock_validator_thread_t *validator_thread = NULL;
+
+	if( lock == NULL )
+	{
+		return;
+	}
+	libcthreads_lock_validator_get_backtrace(
+	 &acquired_backtrace );
+
+	libcthreads_lock_validator_enter();
+
+	validator_thread = libcthreads_lock_validator_get_thread(
+	                    1 );
+
+	if( ( validator_thread != NULL )
+	 && ( validator_thread->number_of_held_locks < LIBCTHREADS_LOCK_VALIDATOR_MAXIMUM_NUMBER_OF_HELD_LOCKS ) )
+	{
+		held_lock = &( validator_thread->held_locks[ validator_thread->number_of_held_locks++ ] );
+
+		held_lock->lock      = lock;
+		held_lock->backtrace = acquired_backtrace;
+	}
+	libcthreads_lock_validator_leave();
+}
+
+/* Marks a lock as no longer held by the calling thread
+ */
+void libcthreads_lock_validator_released(
+      const void *lock )
+{
+	libcthreads_lock_validator_thread_t *previous_thread  = NULL;
+	libcthreads_lock_validator_thread_t *validator_thread = NULL;
+	int held_lock_index                                   = 0;
+
+	if( lock == NULL )
+	{
+		return;
+	}
+	libcthreads_lock_validator_enter();
+
+	validator_thread = libcthreads_lock_validator_get_thread(
+	                    0 );
+
+	if( validator_thread != NULL )
+	{
+		for( held_lock_index = validator_thread->number_of_held_locks - 1;
+		     held_lock_index >= 0;
+		     held_lock_index-- )
+		{
+			if( validator_thread->held_locks[ held_lock_index ].lock == lock )
+			{
+				break;
+			}
+		}
+		if( held_lock_index >= 0 )
+		{
+			validator_thread->number_of_held_locks--;
+
+			while( held_lock_index < validator_thread->number_of_held_locks )
+			{
+				validator_thread->held_locks[ held_lock_index ] = validator_thread->held_locks[ held_lock_index + 1 ];
+
+				held_lock_index++;
+			}
+		}
+		/* Threads that hold no locks are removed so that exited threads are not retained
+		 */
+		if( validator_thread->number_of_held_locks == 0 )
+		{
+			if( libcthreads_lock_validator_threads == validator_thread )
+			{
+				libcthreads_lock_validator_threads = validator_thread->next_thread;
+			}
+			else
+			{
+				for( previous_thread = libcthreads_lock_validator_threads;
+				     previous_thread != NULL;
+				     previous_thread = previous_thread->next_thread )
+				{
+					if( previous_thread->next_thread == validator_thread )
+					{
+						previous_thread->next_thread = validator_thread->next_thread;
+
+						break;
+					}
+				}
+			}
+			memory_free(
+			 validator_thread );
+		}
+	}
+	libcthreads_lock_validator_leave();
+}
+
+/* Removes a lock from the lock order graph
+ * This function is called when the lock is freed, since its address can be reused
+ */
+void libcthreads_lock_validator_remove_lock(
+      const void *lock )
+{
+	int edge_index      = 0;
+	int next_edge_index = 0;
+
+	if( lock == NULL )
+	{
+		return;
+	}
+	libcthreads_lock_validator_enter();
+
+	for( edge_index = 0;
+	     edge_index < libcthreads_lock_validator_number_of_edges;
+	     edge_index++ )
+	{
+		if( ( libcthreads_lock_validator_edges[ edge_index ].held_lock == lock )
+		 || ( libcthreads_lock_validator_edges[ edge_index ].acquired_lock == lock ) )
+		{
+			continue;
+		}
+		if( next_edge_index != edge_index )
+		{
+			libcthreads_lock_validator_edges[ next_edge_index ] = libcthreads_lock_validator_edges[ edge_index ];
+		}
+		next_edge_index++;
+	}
+	libcthreads_lock_validator_number_of_edges = next_edge_index;
+
+	if( ( libcthreads_lock_validator_number_of_edges == 0 )
+	 && ( libcthreads_lock_validator_edges != NULL ) )
+	{
+		memory_free(
+		 libcthreads_lock_validator_edges );
+
+		libcthreads_lock_validator_edges                     = NULL;
+		libcthreads_lock_validator_allocated_number_of_edges = 0;
+	}
+	libcthreads_lock_validator_leave();
+}
+
+#endif /* defined( HAVE_LIBCTHREADS_LOCK_VALIDATION ) */
+
+/* Sets the function that is called when a lock order violation is detected
+ * If no report function is set, reports are written to stderr
+ * The report function must not grab libcthreads locks
+ * Lock order validation is only available if the library was built with lock validation
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_validator_set_report_function(
+     void (*report_function)(
+            const char *report,
+            void *arguments ),
+     void *report_function_arguments,
+     libcerror_error_t **error LIBCTHREADS_ATTRIBUTE_UNUSED )
+{
+	LIBCTHREADS_UNREFERENCED_PARAMETER( error )
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_enter();
+#endif
+	libcthreads_lock_validator_report_function           = report_function;
+	libcthreads_lock_validator_report_function_arguments = report_function_arguments;
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_leave();
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of reported lock order violations
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_lock_validator_get_number_of_reports(
+     int *number_of_reports,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_lock_validator_get_number_of_reports";
+
+	if( number_of_reports == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of reports.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_enter();
+#endif
+	*number_of_reports = libcthreads_lock_validator_number_of_reports;
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_leave();
+#endif
+	return( 1 );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,222 @@
+/*
+ * Lock order validator functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_LOCK_VALIDATOR_H )
+#define _LIBCTHREADS_LOCK_VALIDATOR_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#endif
+
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+
+/* The maximum number of stack frames stored per acquisition
+ */
+#define LIBCTHREADS_LOCK_VALIDATOR_MAXIMUM_NUMBER_OF_FRAMES	16
+
+/* The maximum number of locks a thread can hold that are tracked
+ */
+#define LIBCTHREADS_LOCK_VALIDATOR_MAXIMUM_NUMBER_OF_HELD_LOCKS	32
+
+/* The size of a report
+ */
+#define LIBCTHREADS_LOCK_VALIDATOR_REPORT_SIZE			8192
+
+/* The lock validator flags
+ */
+enum LIBCTHREADS_LOCK_VALIDATOR_FLAGS
+{
+	/* The lock is acquired shared, such as a read/write lock grabbed for reading
+	 */
+	LIBCTHREADS_LOCK_VALIDATOR_FLAG_SHARED			= 0x01
+};
+
+typedef struct libcthreads_lock_validator_backtrace libcthreads_lock_validator_backtrace_t;
+
+struct libcthreads_lock_validator_backtrace
+{
+	/* The stack frames
+	 */
+	void *frames[ LIBCTHREADS_LOCK_VALIDATOR_MAXIMUM_NUMBER_OF_FRAMES ];
+
+	/* The number of stack frames
+	 */
+	int number_of_frames;
+};
+
+typedef struct libcthreads_lock_validator_held_lock libcthreads_lock_validator_held_lock_t;
+
+struct libcthreads_lock_validator_held_lock
+{
+	/* The lock
+	 */
+	const void *lock;
+
+	/* The backtrace of the acquisition
+	 */
+	libcthreads_lock_validator_backtrace_t backtrace;
+};
+
+typedef struct libcthreads_lock_validator_thread libcthreads_lock_validator_thread_t;
+
+struct libcthreads_lock_validator_thread
+{
+#if defined( WINAPI )
+	/* The thread identifier
+	 */
+	DWORD thread_identifier;
+
+#elif defined( HAVE_PTHREAD_H )
+	/* The thread
+	 */
+	pthread_t thread;
+
+#endif
+	/* The number of held locks
+	 */
+	int number_of_held_locks;
+
+	/* The held locks in order of acquisition
+	 */
+	libcthreads_lock_validator_held_lock_t held_locks[ LIBCTHREADS_LOCK_VALIDATOR_MAXIMUM_NUMBER_OF_HELD_LOCKS ];
+
+	/* The next thread
+	 */
+	libcthreads_lock_validator_thread_t *next_thread;
+};
+
+typedef struct libcthreads_lock_validator_edge libcthreads_lock_validator_edge_t;
+
+struct libcthreads_lock_validator_edge
+{
+	/* The lock that was held
+	 */
+	const void *held_lock;
+
+	/* The lock that was acquired while the held lock was held
+	 */
+	const void *acquired_lock;
+
+	/* The backtrace of the acquisition of the held lock
+	 */
+	libcthreads_lock_validator_backtrace_t held_backtrace;
+
+	/* The backtrace of the acquisition of the acquired lock
+	 */
+	libcthreads_lock_validator_backtrace_t acquired_backtrace;
+};
+
+void libcthreads_lock_validator_get_backtrace(
+      libcthreads_lock_validator_backtrace_t *stack_backtrace );
+
+void libcthreads_lock_validator_print(
+      char *report,
+      size_t report_size,
+      size_t *report_offset,
+      const char *format,
+      ... );
+
+void libcthreads_lock_validator_print_backtrace(
+      char *report,
+      size_t report_size,
+      size_t *report_offset,
+      const libcthreads_lock_validator_backtrace_t *stack_backtrace );
+
+void libcthreads_lock_validator_report(
+      const char *report );
+
+#if defined( HAVE_PTHREAD_H ) && defined( HAVE_PTHREAD_SPIN_LOCK ) && !defined( WINAPI )
+
+void libcthreads_lock_validator_initialize_spin_lock(
+      void );
+
+#endif
+
+void libcthreads_lock_validator_enter(
+      void );
+
+void libcthreads_lock_validator_leave(
+      void );
+
+libcthreads_lock_validator_thread_t *libcthreads_lock_validator_get_thread(
+                                      int create );
+
+int libcthreads_lock_validator_get_edge_index(
+     const void *held_lock,
+     const void *acquired_lock );
+
+int libcthreads_lock_validator_find_path(
+     const void *from_lock,
+     const void *to_lock );
+
+int libcthreads_lock_validator_append_edge(
+     const libcthreads_lock_validator_held_lock_t *held_lock,
+     const void *acquired_lock,
+     const libcthreads_lock_validator_backtrace_t *acquired_backtrace );
+
+void libcthreads_lock_validator_check_acquire(
+      const void *lock,
+      int flags );
+
+void libcthreads_lock_validator_acquired(
+      const void *lock );
+
+void libcthreads_lock_validator_released(
+      const void *lock );
+
+void libcthreads_lock_validator_remove_lock(
+      const void *lock );
+
+#endif /* defined( HAVE_LIBCTHREADS_LOCK_VALIDATION ) */
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_validator_set_report_function(
+     void (*report_function)(
+            const char *report,
+            void *arguments ),
+     void *report_function_arguments,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_lock_validator_get_number_of_reports(
+     int *number_of_reports,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_LOCK_VALIDATOR_H ) */
+
@@ -0,0 +1,442 @@
+/*
+ * Intrusive multi producer single consumer queue functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libcthreads_libcerror.h"
+#include "libcthreads_mpsc_queue.h"
+#include "libcthreads_mutex.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+#define libcthreads_mpsc_queue_exchange_node( node_reference, node ) \
+	(libcthreads_mpsc_queue_node_t *) libcthreads_internal_atomic_exchange_pointer( node_reference, node, LIBCTHREADS_MEMORY_ORDER_ACQUIRE_RELEASE )
+
+#define libcthreads_mpsc_queue_get_node( node_reference ) \
+	(libcthreads_mpsc_queue_node_t *) libcthreads_internal_atomic_load_pointer( node_reference, LIBCTHREADS_MEMORY_ORDER_ACQUIRE )
+
+#define libcthreads_mpsc_queue_set_node( node_reference, node ) \
+	libcthreads_internal_atomic_store_pointer( node_reference, node, LIBCTHREADS_MEMORY_ORDER_RELEASE )
+
+#else
+#define libcthreads_mpsc_queue_get_node( node_reference ) \
+	*( node_reference )
+
+#define libcthreads_mpsc_queue_set_node( node_reference, node ) \
+	*( node_reference ) = node
+
+#endif
+
+/* Creates a MPSC queue
+ * Make sure the value mpsc_queue is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_mpsc_queue_initialize(
+     libcthreads_mpsc_queue_t **mpsc_queue,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_mpsc_queue_t *internal_mpsc_queue = NULL;
+	static char *function                                  = "libcthreads_mpsc_queue_initialize";
+
+	if( mpsc_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MPSC queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mpsc_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid MPSC queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_mpsc_queue = memory_allocate_structure(
+	                       libcthreads_internal_mpsc_queue_t );
+
+	if( internal_mpsc_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create MPSC queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_mpsc_queue,
+	     0,
+	     sizeof( libcthreads_internal_mpsc_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear MPSC queue.",
+		 function );
+
+		memory_free(
+		 internal_mpsc_queue );
+
+		return( -1 );
+	}
+#if !defined( LIBCTHREADS_MPSC_QUEUE_HAVE_ATOMIC_EXCHANGE )
+	if( libcthreads_mutex_initialize(
+	     &( internal_mpsc_queue->queue_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create queue mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	internal_mpsc_queue->head = &( internal_mpsc_queue->stub_node );
+	internal_mpsc_queue->tail = &( internal_mpsc_queue->stub_node );
+
+	*mpsc_queue = (libcthreads_mpsc_queue_t *) internal_mpsc_queue;
+
+	return( 1 );
+
+on_error:
+	if( internal_mpsc_queue != NULL )
+	{
+		memory_free(
+		 internal_mpsc_queue );
+	}
+	return( -1 );
+}
+
+/* Frees a MPSC queue
+ * The queue does not own the nodes, nodes that are still queued are not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_mpsc_queue_free(
+     libcthreads_mpsc_queue_t **mpsc_queue,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_mpsc_queue_t *internal_mpsc_queue = NULL;
+	static char *function                                  = "libcthreads_mpsc_queue_free";
+	int result                                             = 1;
+
+	if( mpsc_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MPSC queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mpsc_queue != NULL )
+	{
+		internal_mpsc_queue = (libcthreads_internal_mpsc_queue_t *) *mpsc_queue;
+		*mpsc_queue         = NULL;
+
+#if !defined( LIBCTHREADS_MPSC_QUEUE_HAVE_ATOMIC_EXCHANGE )
+		if( libcthreads_mutex_free(
+		     &( internal_mpsc_queue->queue_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free queue mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 internal_mpsc_queue );
+	}
+	return( result );
+}
+
+/* Pushes a node onto the queue
+ * Without an atomic exchange the queue mutex must be grabbed
+ */
+void libcthreads_internal_mpsc_queue_push_node(
+      libcthreads_internal_mpsc_queue_t *internal_mpsc_queue,
+      libcthreads_mpsc_queue_node_t *node )
+{
+	libcthreads_mpsc_queue_node_t *previous_node = NULL;
+
+	libcthreads_mpsc_queue_set_node(
+	 &( node->next_node ),
+	 NULL );
+
+#if defined( LIBCTHREADS_MPSC_QUEUE_HAVE_ATOMIC_EXCHANGE )
+	previous_node = libcthreads_mpsc_queue_exchange_node(
+	                 &( internal_mpsc_queue->head ),
+	                 node );
+#else
+	previous_node             = internal_mpsc_queue->head;
+	internal_mpsc_queue->head = node;
+#endif
+
+	/* Until the previous node is linked, the consumer cannot reach
+	 * the node or any nodes pushed after it
+	 */
+	libcthreads_mpsc_queue_set_node(
+	 &( previous_node->next_node ),
+	 node );
+}
+
+/* Pushes a node onto the queue
+ * The node is typically embedded in the object that is queued, the queue
+ * does not allocate memory and a push completes in a bounded number of steps
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_mpsc_queue_push(
+     libcthreads_mpsc_queue_t *mpsc_queue,
+     libcthreads_mpsc_queue_node_t *node,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_mpsc_queue_t *internal_mpsc_queue = NULL;
+	static char *function                                  = "libcthreads_mpsc_queue_push";
+
+	if( mpsc_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MPSC queue.",
+		 function );
+
+		return( -1 );
+	}
+	internal_mpsc_queue = (libcthreads_internal_mpsc_queue_t *) mpsc_queue;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( LIBCTHREADS_MPSC_QUEUE_HAVE_ATOMIC_EXCHANGE )
+	if( libcthreads_mutex_grab(
+	     internal_mpsc_queue->queue_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab queue mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	libcthreads_internal_mpsc_queue_push_node(
+	 internal_mpsc_queue,
+	 node );
+
+#if !defined( LIBCTHREADS_MPSC_QUEUE_HAVE_ATOMIC_EXCHANGE )
+	if( libcthreads_mutex_release(
+	     internal_mpsc_queue->queue_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release queue mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Pops the oldest node from the queue
+ * Without an atomic exchange the queue mutex must be grabbed
+ * Returns 1 if successful or 0 if no node is available
+ */
+int libcthreads_internal_mpsc_queue_pop_node(
+     libcthreads_internal_mpsc_queue_t *internal_mpsc_queue,
+     libcthreads_mpsc_queue_node_t **node )
+{
+	libcthreads_mpsc_queue_node_t *head_node = NULL;
+	libcthreads_mpsc_queue_node_t *next_node = NULL;
+	libcthreads_mpsc_queue_node_t *tail_node = NULL;
+
+	tail_node = internal_mpsc_queue->tail;
+	next_node = libcthreads_mpsc_queue_get_node(
+	             &( tail_node->next_node ) );
+
+	if( tail_node == &( internal_mpsc_queue->stub_node ) )
+	{
+		if( next_node == NULL )
+		{
+			return( 0 );
+		}
+		internal_mpsc_queue->tail = next_node;
+
+		tail_node = next_node;
+		next_node = libcthreads_mpsc_queue_get_node(
+		             &( tail_node->next_node ) );
+	}
+	if( next_node != NULL )
+	{
+		internal_mpsc_queue->tail = next_node;
+
+		*node = tail_node;
+
+		return( 1 );
+	}
+	head_node = libcthreads_mpsc_queue_get_node(
+	             &( internal_mpsc_queue->head ) );
+
+	/* A producer has exchanged the head but not yet linked its node
+	 */
+	if( tail_node != head_node )
+	{
+		return( 0 );
+	}
+	/* The tail node is the last node, push the stub node so that
+	 * the tail node can be popped without emptying the queue
+	 */
+	libcthreads_internal_mpsc_queue_push_node(
+	 internal_mpsc_queue,
+	 &( internal_mpsc_queue->stub_node ) );
+
+	next_node = libcthreads_mpsc_queue_get_node(
+	             &( tail_node->next_node ) );
+
+	if( next_node == NULL )
+	{
+		return( 0 );
+	}
+	internal_mpsc_queue->tail = next_node;
+
+	*node = tail_node;
+
+	return( 1 );
+}
+
+/* Pops the oldest node from the queue
+ * Only a single thread at a time is allowed to pop nodes
+ * Returns 1 if successful, 0 if the queue is empty or a push
+ * of the next node is still in progress or -1 on error
+ */
+int libcthreads_mpsc_queue_pop(
+     libcthreads_mpsc_queue_t *mpsc_queue,
+     libcthreads_mpsc_queue_node_t **node,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_mpsc_queue_t *internal_mpsc_queue = NULL;
+	static char *function                                  = "libcthreads_mpsc_queue_pop";
+	int result                                             = 0;
+
+	if( mpsc_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MPSC queue.",
+		 function );
+
+		return( -1 );
+	}
+	internal_mpsc_queue = (libcthreads_internal_mpsc_queue_t *) mpsc_queue;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( LIBCTHREADS_MPSC_QUEUE_HAVE_ATOMIC_EXCHANGE )
+	if( libcthreads_mutex_grab(
+	     internal_mpsc_queue->queue_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab queue mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libcthreads_internal_mpsc_queue_pop_node(
+	          internal_mpsc_queue,
+	          node );
+
+#if !defined( LIBCTHREADS_MPSC_QUEUE_HAVE_ATOMIC_EXCHANGE )
+	if( libcthreads_mutex_release(
+	     internal_mpsc_queue->queue_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release queue mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
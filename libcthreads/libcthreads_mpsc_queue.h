@@ -0,0 +1,113 @@
+/*
+ * Intrusive multi producer single consumer queue functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_MPSC_QUEUE_H )
+#define _LIBCTHREADS_INTERNAL_MPSC_QUEUE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_atomic.h"
+#include "libcthreads_definitions.h"
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The head is exchanged atomically by the producers, if not available
+ * the queue is protected by a mutex
+ */
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+#define LIBCTHREADS_MPSC_QUEUE_HAVE_ATOMIC_EXCHANGE
+#endif
+
+typedef struct libcthreads_internal_mpsc_queue libcthreads_internal_mpsc_queue_t;
+
+struct libcthreads_internal_mpsc_queue
+{
+	/* The head, which is the most recently pushed node
+	 */
+	libcthreads_mpsc_queue_node_t *head;
+
+	/* Padding to prevent the head, that is written by the producers,
+	 * from sharing a cache line with the tail, that is written by the consumer
+	 */
+	uint8_t padding[ LIBCTHREADS_CACHE_LINE_SIZE - sizeof( libcthreads_mpsc_queue_node_t * ) ];
+
+	/* The tail, which is the next node to pop
+	 */
+	libcthreads_mpsc_queue_node_t *tail;
+
+	/* The stub node, which is pushed when the last node is popped
+	 * so that the queue never becomes empty
+	 */
+	libcthreads_mpsc_queue_node_t stub_node;
+
+#if !defined( LIBCTHREADS_MPSC_QUEUE_HAVE_ATOMIC_EXCHANGE )
+	/* The queue mutex
+	 */
+	libcthreads_mutex_t *queue_mutex;
+#endif
+};
+
+LIBCTHREADS_EXTERN \
+int libcthreads_mpsc_queue_initialize(
+     libcthreads_mpsc_queue_t **mpsc_queue,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_mpsc_queue_free(
+     libcthreads_mpsc_queue_t **mpsc_queue,
+     libcerror_error_t **error );
+
+void libcthreads_internal_mpsc_queue_push_node(
+      libcthreads_internal_mpsc_queue_t *internal_mpsc_queue,
+      libcthreads_mpsc_queue_node_t *node );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_mpsc_queue_push(
+     libcthreads_mpsc_queue_t *mpsc_queue,
+     libcthreads_mpsc_queue_node_t *node,
+     libcerror_error_t **error );
+
+int libcthreads_internal_mpsc_queue_pop_node(
+     libcthreads_internal_mpsc_queue_t *internal_mpsc_queue,
+     libcthreads_mpsc_queue_node_t **node );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_mpsc_queue_pop(
+     libcthreads_mpsc_queue_t *mpsc_queue,
+     libcthreads_mpsc_queue_node_t **node,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_MPSC_QUEUE_H ) */
+
@@ -34,30 +34,34 @@
 #endif
 
 #include "libcthreads_libcerror.h"
+#include "libcthreads_lock_validator.h"
 #include "libcthreads_mutex.h"
+#include "libcthreads_probes.h"
 #include "libcthreads_types.h"
 
 #if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
 
-/* Creates a mutex
- * Make sure the value mutex is referencing, is set to NULL
+/* Make sure the internal mutex fits in the storage for in place initialization
+ */
+typedef char libcthreads_internal_mutex_storage_size_check_t[ ( sizeof( libcthreads_internal_mutex_t ) <= LIBCTHREADS_MUTEX_STORAGE_SIZE ) ? 1 : -1 ];
+
+/* Initializes a mutex in the provided memory
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_mutex_initialize(
-     libcthreads_mutex_t **mutex,
+int libcthreads_internal_mutex_initialize(
+     libcthreads_internal_mutex_t *internal_mutex,
      libcerror_error_t **error )
 {
-	libcthreads_internal_mutex_t *internal_mutex = NULL;
-	static char *function                        = "libcthreads_mutex_initialize";
+	static char *function = "libcthreads_internal_mutex_initialize";
 
 #if defined( WINAPI ) && ( WINVER < 0x0600 )
-	DWORD error_code                             = 0;
+	DWORD error_code      = 0;
 
 #elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                           = 0;
+	int pthread_result    = 0;
 #endif
 
-	if( mutex == NULL )
+	if( internal_mutex == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -68,31 +72,6 @@ int libcthreads_mutex_initialize(
 
 		return( -1 );
 	}
-	if( *mutex != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid mutex value already set.",
-		 function );
-
-		return( -1 );
-	}
-	internal_mutex = memory_allocate_structure(
-	                  libcthreads_internal_mutex_t );
-
-	if( internal_mutex == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create mutex.",
-		 function );
-
-		goto on_error;
-	}
 	if( memory_set(
 	     internal_mutex,
 	     0,
@@ -105,9 +84,6 @@ int libcthreads_mutex_initialize(
 		 "%s: unable to clear mutex.",
 		 function );
 
-		memory_free(
-		 internal_mutex );
-
 		return( -1 );
 	}
 #if defined( WINAPI ) && ( WINVER >= 0x0600 )
@@ -132,7 +108,7 @@ int libcthreads_mutex_initialize(
 		 "%s: unable to initialize mutex handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 
 #elif defined( HAVE_PTHREAD_H )
@@ -153,7 +129,7 @@ int libcthreads_mutex_initialize(
 			 "%s: unable to initialize mutex with error: Insufficient resources.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 
 		default:
 			libcerror_system_set_error(
@@ -164,39 +140,22 @@ int libcthreads_mutex_initialize(
 			 "%s: unable to initialize mutex.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 	}
 #endif
-	*mutex = (libcthreads_mutex_t *) internal_mutex;
-
 	return( 1 );
-
-on_error:
-	if( internal_mutex != NULL )
-	{
-		memory_free(
-		 internal_mutex );
-	}
-	return( -1 );
 }
 
-/* Frees a mutex
+/* Creates a mutex
+ * Make sure the value mutex is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_mutex_free(
+int libcthreads_mutex_initialize(
      libcthreads_mutex_t **mutex,
      libcerror_error_t **error )
 {
 	libcthreads_internal_mutex_t *internal_mutex = NULL;
-	static char *function                        = "libcthreads_mutex_free";
-	int result                                   = 1;
-
-#if defined( WINAPI ) && ( WINVER < 0x0600 )
-	DWORD error_code                             = 0;
-
-#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                           = 0;
-#endif
+	static char *function                        = "libcthreads_mutex_initialize";
 
 	if( mutex == NULL )
 	{
@@ -211,99 +170,73 @@ int libcthreads_mutex_free(
 	}
 	if( *mutex != NULL )
 	{
-		internal_mutex = (libcthreads_internal_mutex_t *) *mutex;
-		*mutex         = NULL;
-
-#if defined( WINAPI ) && ( WINVER >= 0x0600 )
-		DeleteCriticalSection(
-		 &( internal_mutex->critical_section ) );
-
-#elif defined( WINAPI )
-		if( CloseHandle(
-		     internal_mutex->mutex_handle ) == 0 )
-		{
-			error_code = GetLastError();
-
-			libcerror_system_set_error(
-			 error,
-			 error_code,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free mutex handle.",
-			 function );
-
-			result = -1;
-		}
-
-#elif defined( HAVE_PTHREAD_H )
-		pthread_result = pthread_mutex_destroy(
-		                  &( internal_mutex->mutex ) );
-
-		switch( pthread_result )
-		{
-			case 0:
-				break;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid mutex value already set.",
+		 function );
 
-			case EAGAIN:
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to destroy mutex with error: Insufficient resources.",
-				 function );
+		return( -1 );
+	}
+	internal_mutex = memory_allocate_structure(
+	                  libcthreads_internal_mutex_t );
 
-				result = -1;
-				break;
+	if( internal_mutex == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create mutex.",
+		 function );
 
-			case EBUSY:
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to destroy mutex with error: Resource busy.",
-				 function );
+		goto on_error;
+	}
+	if( libcthreads_internal_mutex_initialize(
+	     internal_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
 
-				result = -1;
-				break;
+		goto on_error;
+	}
+	*mutex = (libcthreads_mutex_t *) internal_mutex;
 
-			default:
-				libcerror_system_set_error(
-				 error,
-				 pthread_result,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to destroy mutex.",
-				 function );
+	return( 1 );
 
-				result = -1;
-				break;
-		}
-#endif
+on_error:
+	if( internal_mutex != NULL )
+	{
 		memory_free(
 		 internal_mutex );
 	}
-	return( result );
+	return( -1 );
 }
 
-/* Grabs a mutex
+/* Finalizes a mutex in the provided memory
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_mutex_grab(
-     libcthreads_mutex_t *mutex,
+int libcthreads_internal_mutex_finalize(
+     libcthreads_internal_mutex_t *internal_mutex,
      libcerror_error_t **error )
 {
-	libcthreads_internal_mutex_t *internal_mutex = NULL;
-	static char *function                        = "libcthreads_mutex_grab";
+	static char *function = "libcthreads_internal_mutex_finalize";
+	int result            = 1;
 
 #if defined( WINAPI ) && ( WINVER < 0x0600 )
-	DWORD error_code                             = 0;
-	DWORD wait_status                            = 0;
+	DWORD error_code      = 0;
 
 #elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                           = 0;
+	int pthread_result    = 0;
 #endif
 
-	if( mutex == NULL )
+	if( internal_mutex == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -314,18 +247,13 @@ int libcthreads_mutex_grab(
 
 		return( -1 );
 	}
-	internal_mutex = (libcthreads_internal_mutex_t *) mutex;
-
 #if defined( WINAPI ) && ( WINVER >= 0x0600 )
-	EnterCriticalSection(
+	DeleteCriticalSection(
 	 &( internal_mutex->critical_section ) );
 
 #elif defined( WINAPI )
-	wait_status = WaitForSingleObject(
-	               internal_mutex->mutex_handle,
-	               INFINITE );
-
-	if( wait_status == WAIT_FAILED )
+	if( CloseHandle(
+	     internal_mutex->mutex_handle ) == 0 )
 	{
 		error_code = GetLastError();
 
@@ -333,15 +261,15 @@ int libcthreads_mutex_grab(
 		 error,
 		 error_code,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: wait for mutex handle failed.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free mutex handle.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
 
 #elif defined( HAVE_PTHREAD_H )
-	pthread_result = pthread_mutex_lock(
+	pthread_result = pthread_mutex_destroy(
 	                  &( internal_mutex->mutex ) );
 
 	switch( pthread_result )
@@ -354,20 +282,22 @@ int libcthreads_mutex_grab(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to lock mutex with error: Maximum number of locks exceeded.",
+			 "%s: unable to destroy mutex with error: Insufficient resources.",
 			 function );
 
-			return( -1 );
+			result = -1;
+			break;
 
-		case EDEADLK:
+		case EBUSY:
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to lock mutex with error: Deadlock condition detected.",
+			 "%s: unable to destroy mutex with error: Resource busy.",
 			 function );
 
-			return( -1 );
+			result = -1;
+			break;
 
 		default:
 			libcerror_system_set_error(
@@ -375,34 +305,32 @@ int libcthreads_mutex_grab(
 			 pthread_result,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to lock mutex.",
+			 "%s: unable to destroy mutex.",
 			 function );
 
-			return( -1 );
+			result = -1;
+			break;
 	}
 #endif
-	return( 1 );
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_remove_lock(
+	 internal_mutex );
+#endif
+	return( result );
 }
 
-/* Tries to grabs a mutex
- * Returns 1 if successful, 0 if not or -1 on error
+/* Frees a mutex
+ * Returns 1 if successful or -1 on error
  */
-int libcthreads_mutex_try_grab(
-     libcthreads_mutex_t *mutex,
+int libcthreads_mutex_free(
+     libcthreads_mutex_t **mutex,
      libcerror_error_t **error )
 {
 	libcthreads_internal_mutex_t *internal_mutex = NULL;
-	static char *function                        = "libcthreads_mutex_try_grab";
+	static char *function                        = "libcthreads_mutex_free";
 	int result                                   = 1;
 
-#if defined( WINAPI ) && ( WINVER < 0x0600 )
-	DWORD error_code                             = 0;
-	DWORD wait_status                            = 0;
-
-#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                           = 0;
-#endif
-
 	if( mutex == NULL )
 	{
 		libcerror_error_set(
@@ -414,121 +342,297 @@ int libcthreads_mutex_try_grab(
 
 		return( -1 );
 	}
-	internal_mutex = (libcthreads_internal_mutex_t *) mutex;
-
-#if defined( WINAPI ) && ( WINVER >= 0x0600 )
-	if( TryEnterCriticalSection(
-	     &( internal_mutex->critical_section ) ) != 0 )
-	{
-		result = 1;
-	}
-	else
+	if( *mutex != NULL )
 	{
-		result = 0;
+		internal_mutex = (libcthreads_internal_mutex_t *) *mutex;
+		*mutex         = NULL;
+
+		if( libcthreads_internal_mutex_finalize(
+		     internal_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_mutex );
 	}
+	return( result );
+}
 
-#elif defined( WINAPI )
-	wait_status = WaitForSingleObject(
-	               internal_mutex->mutex_handle,
-	               0 );
+/* Initializes a mutex in caller provided storage
+ * The storage must remain available until the mutex is finalized
+ * Make sure the value mutex is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_mutex_initialize_in_place(
+     libcthreads_mutex_t **mutex,
+     libcthreads_mutex_storage_t *storage,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_mutex_t *internal_mutex = NULL;
+	static char *function                        = "libcthreads_mutex_initialize_in_place";
 
-	if( wait_status == WAIT_TIMEOUT )
+	if( mutex == NULL )
 	{
-		result = 0;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mutex.",
+		 function );
+
+		return( -1 );
 	}
-	else if( wait_status == WAIT_FAILED )
+	if( *mutex != NULL )
 	{
-		error_code = GetLastError();
-
-		libcerror_system_set_error(
+		libcerror_error_set(
 		 error,
-		 error_code,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: wait for mutex handle failed.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid mutex value already set.",
 		 function );
 
 		return( -1 );
 	}
+	if( storage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage.",
+		 function );
 
-#elif defined( HAVE_PTHREAD_H )
-	pthread_result = pthread_mutex_trylock(
-	                  &( internal_mutex->mutex ) );
+		return( -1 );
+	}
+	internal_mutex = (libcthreads_internal_mutex_t *) storage;
 
-	switch( pthread_result )
+	if( libcthreads_internal_mutex_initialize(
+	     internal_mutex,
+	     error ) != 1 )
 	{
-		case 0:
-			break;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
 
-		case EBUSY:
-			result = 0;
-			break;
+		return( -1 );
+	}
+	*mutex = (libcthreads_mutex_t *) internal_mutex;
 
-		case EAGAIN:
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to try lock mutex with error: Maximum number of locks exceeded.",
-			 function );
+	return( 1 );
+}
 
-			return( -1 );
+/* Finalizes a mutex that was initialized in caller provided storage
+ * The storage itself is not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_mutex_finalize_in_place(
+     libcthreads_mutex_t **mutex,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_mutex_t *internal_mutex = NULL;
+	static char *function                        = "libcthreads_mutex_finalize_in_place";
 
-		case EDEADLK:
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to try lock mutex with error: Deadlock condition detected.",
-			 function );
+	if( mutex == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mutex.",
+		 function );
 
-			return( -1 );
+		return( -1 );
+	}
+	if( *mutex != NULL )
+	{
+		internal_mutex = (libcthreads_internal_mutex_t *) *mutex;
+		*mutex         = NULL;
 
-		default:
-			libcerror_system_set_error(
+		if( libcthreads_internal_mutex_finalize(
+		     internal_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
 			 error,
-			 pthread_result,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to try lock mutex.",
+			 "%s: unable to finalize mutex.",
 			 function );
 
 			return( -1 );
+		}
 	}
-#endif
-	return( result );
+	return( 1 );
 }
 
-/* Releases a mutex
+/* Grabs a mutex without an error object
+ * The error code is set to the system error code on error
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_mutex_release(
-     libcthreads_mutex_t *mutex,
-     libcerror_error_t **error )
+int libcthreads_internal_mutex_grab(
+     libcthreads_internal_mutex_t *internal_mutex,
+     uint32_t *error_code )
 {
-	libcthreads_internal_mutex_t *internal_mutex = NULL;
-	static char *function                        = "libcthreads_mutex_release";
+#if defined( WINAPI ) && ( WINVER < 0x0600 )
+	DWORD wait_status  = 0;
+
+#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result = 0;
+#endif
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_check_acquire(
+	 internal_mutex,
+	 0 );
+#endif
+
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	EnterCriticalSection(
+	 &( internal_mutex->critical_section ) );
+
+#elif defined( WINAPI )
+	wait_status = WaitForSingleObject(
+	               internal_mutex->mutex_handle,
+	               INFINITE );
+
+	if( wait_status == WAIT_FAILED )
+	{
+		*error_code = (uint32_t) GetLastError();
+
+		return( -1 );
+	}
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = EBUSY;
 
+	/* Contention is only detected when a tracer is attached to the probe
+	 */
+	if( LIBCTHREADS_PROBE_ENABLED( mutex__contended ) )
+	{
+		pthread_result = pthread_mutex_trylock(
+		                  &( internal_mutex->mutex ) );
+
+		if( pthread_result == EBUSY )
+		{
+			LIBCTHREADS_PROBE1(
+			 mutex__contended,
+			 internal_mutex );
+		}
+	}
+	if( pthread_result == EBUSY )
+	{
+		pthread_result = pthread_mutex_lock(
+		                  &( internal_mutex->mutex ) );
+	}
+	if( pthread_result != 0 )
+	{
+		*error_code = (uint32_t) pthread_result;
+
+		return( -1 );
+	}
+#endif
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_acquired(
+	 internal_mutex );
+#endif
+	LIBCTHREADS_PROBE1(
+	 mutex__acquire,
+	 internal_mutex );
+
+	return( 1 );
+}
+
+/* Tries to grab a mutex without an error object
+ * The error code is set to the system error code on error
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libcthreads_internal_mutex_try_grab(
+     libcthreads_internal_mutex_t *internal_mutex,
+     uint32_t *error_code )
+{
 #if defined( WINAPI ) && ( WINVER < 0x0600 )
-	DWORD error_code                             = 0;
-	BOOL result                                  = 0;
+	DWORD wait_status  = 0;
 
 #elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                           = 0;
+	int pthread_result = 0;
 #endif
 
-	if( mutex == NULL )
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	if( TryEnterCriticalSection(
+	     &( internal_mutex->critical_section ) ) == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid mutex.",
-		 function );
+		return( 0 );
+	}
+
+#elif defined( WINAPI )
+	wait_status = WaitForSingleObject(
+	               internal_mutex->mutex_handle,
+	               0 );
+
+	if( wait_status == WAIT_TIMEOUT )
+	{
+		return( 0 );
+	}
+	else if( wait_status == WAIT_FAILED )
+	{
+		*error_code = (uint32_t) GetLastError();
+
+		return( -1 );
+	}
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_mutex_trylock(
+	                  &( internal_mutex->mutex ) );
+
+	if( pthread_result == EBUSY )
+	{
+		return( 0 );
+	}
+	else if( pthread_result != 0 )
+	{
+		*error_code = (uint32_t) pthread_result;
 
 		return( -1 );
 	}
-	internal_mutex = (libcthreads_internal_mutex_t *) mutex;
+#endif
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_acquired(
+	 internal_mutex );
+#endif
+	LIBCTHREADS_PROBE1(
+	 mutex__acquire,
+	 internal_mutex );
+
+	return( 1 );
+}
+
+/* Releases a mutex without an error object
+ * The error code is set to the system error code on error
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_mutex_release(
+     libcthreads_internal_mutex_t *internal_mutex,
+     uint32_t *error_code )
+{
+#if defined( WINAPI ) && ( WINVER < 0x0600 )
+	BOOL result        = 0;
+
+#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result = 0;
+#endif
 
 #if defined( WINAPI ) && ( WINVER >= 0x0600 )
 	LeaveCriticalSection(
@@ -540,62 +644,296 @@ int libcthreads_mutex_release(
 
 	if( result == 0 )
 	{
-		error_code = GetLastError();
+		*error_code = (uint32_t) GetLastError();
+
+		return( -1 );
+	}
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_mutex_unlock(
+	                  &( internal_mutex->mutex ) );
+
+	if( pthread_result != 0 )
+	{
+		*error_code = (uint32_t) pthread_result;
+
+		return( -1 );
+	}
+#endif
 
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_released(
+	 internal_mutex );
+#endif
+	LIBCTHREADS_PROBE1(
+	 mutex__release,
+	 internal_mutex );
+
+	return( 1 );
+}
+
+/* Grabs a mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_mutex_grab(
+     libcthreads_mutex_t *mutex,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_mutex_grab";
+	uint32_t error_code   = 0;
+
+	if( mutex == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_mutex_grab(
+	     (libcthreads_internal_mutex_t *) mutex,
+	     &error_code ) != 1 )
+	{
+#if defined( WINAPI )
 		libcerror_system_set_error(
 		 error,
 		 error_code,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to relates mutex handle.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: wait for mutex handle failed.",
 		 function );
 
+#elif defined( HAVE_PTHREAD_H )
+		switch( error_code )
+		{
+			case EAGAIN:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to lock mutex with error: Maximum number of locks exceeded.",
+				 function );
+
+				break;
+
+			case EDEADLK:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to lock mutex with error: Deadlock condition detected.",
+				 function );
+
+				break;
+
+			default:
+				libcerror_system_set_error(
+				 error,
+				 error_code,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to lock mutex.",
+				 function );
+
+				break;
+		}
+#endif
 		return( -1 );
 	}
+	return( 1 );
+}
 
-#elif defined( HAVE_PTHREAD_H )
-	pthread_result = pthread_mutex_unlock(
-	                  &( internal_mutex->mutex ) );
+/* Grabs a mutex without argument checks and error objects
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_mutex_grab_fast(
+     libcthreads_mutex_t *mutex )
+{
+	uint32_t error_code = 0;
 
-	switch( pthread_result )
+	return( libcthreads_internal_mutex_grab(
+	         (libcthreads_internal_mutex_t *) mutex,
+	         &error_code ) );
+}
+
+/* Tries to grabs a mutex
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libcthreads_mutex_try_grab(
+     libcthreads_mutex_t *mutex,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_mutex_try_grab";
+	uint32_t error_code   = 0;
+	int result            = 0;
+
+	if( mutex == NULL )
 	{
-		case 0:
-			break;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mutex.",
+		 function );
 
-		case EAGAIN:
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to unlock mutex with error: Maximum number of locks exceeded.",
-			 function );
+		return( -1 );
+	}
+	result = libcthreads_internal_mutex_try_grab(
+	          (libcthreads_internal_mutex_t *) mutex,
+	          &error_code );
 
-			return( -1 );
+	if( result == -1 )
+	{
+#if defined( WINAPI )
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: wait for mutex handle failed.",
+		 function );
 
-		case EDEADLK:
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to unlock mutex with error: Deadlock condition detected.",
-			 function );
+#elif defined( HAVE_PTHREAD_H )
+		switch( error_code )
+		{
+			case EAGAIN:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to try lock mutex with error: Maximum number of locks exceeded.",
+				 function );
 
-			return( -1 );
+				break;
 
-		default:
-			libcerror_system_set_error(
-			 error,
-			 pthread_result,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to unlock mutex.",
-			 function );
+			case EDEADLK:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to try lock mutex with error: Deadlock condition detected.",
+				 function );
 
-			return( -1 );
+				break;
+
+			default:
+				libcerror_system_set_error(
+				 error,
+				 error_code,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to try lock mutex.",
+				 function );
+
+				break;
+		}
+#endif
 	}
+	return( result );
+}
+
+/* Tries to grab a mutex without argument checks and error objects
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libcthreads_mutex_try_grab_fast(
+     libcthreads_mutex_t *mutex )
+{
+	uint32_t error_code = 0;
+
+	return( libcthreads_internal_mutex_try_grab(
+	         (libcthreads_internal_mutex_t *) mutex,
+	         &error_code ) );
+}
+
+/* Releases a mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_mutex_release(
+     libcthreads_mutex_t *mutex,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_mutex_release";
+	uint32_t error_code   = 0;
+
+	if( mutex == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_mutex_release(
+	     (libcthreads_internal_mutex_t *) mutex,
+	     &error_code ) != 1 )
+	{
+#if defined( WINAPI )
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex handle.",
+		 function );
+
+#elif defined( HAVE_PTHREAD_H )
+		switch( error_code )
+		{
+			case EAGAIN:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to unlock mutex with error: Maximum number of locks exceeded.",
+				 function );
+
+				break;
+
+			case EDEADLK:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to unlock mutex with error: Deadlock condition detected.",
+				 function );
+
+				break;
+
+			default:
+				libcerror_system_set_error(
+				 error,
+				 error_code,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to unlock mutex.",
+				 function );
+
+				break;
+		}
 #endif
+		return( -1 );
+	}
 	return( 1 );
 }
 
+/* Releases a mutex without argument checks and error objects
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_mutex_release_fast(
+     libcthreads_mutex_t *mutex )
+{
+	uint32_t error_code = 0;
+
+	return( libcthreads_internal_mutex_release(
+	         (libcthreads_internal_mutex_t *) mutex,
+	         &error_code ) );
+}
+
 #endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
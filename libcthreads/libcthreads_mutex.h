@@ -63,31 +63,74 @@ struct libcthreads_internal_mutex
 #endif
 };
 
+int libcthreads_internal_mutex_initialize(
+     libcthreads_internal_mutex_t *internal_mutex,
+     libcerror_error_t **error );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_mutex_initialize(
      libcthreads_mutex_t **mutex,
      libcerror_error_t **error );
 
+int libcthreads_internal_mutex_finalize(
+     libcthreads_internal_mutex_t *internal_mutex,
+     libcerror_error_t **error );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_mutex_free(
      libcthreads_mutex_t **mutex,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_mutex_initialize_in_place(
+     libcthreads_mutex_t **mutex,
+     libcthreads_mutex_storage_t *storage,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_mutex_finalize_in_place(
+     libcthreads_mutex_t **mutex,
+     libcerror_error_t **error );
+
+int libcthreads_internal_mutex_grab(
+     libcthreads_internal_mutex_t *internal_mutex,
+     uint32_t *error_code );
+
+int libcthreads_internal_mutex_try_grab(
+     libcthreads_internal_mutex_t *internal_mutex,
+     uint32_t *error_code );
+
+int libcthreads_internal_mutex_release(
+     libcthreads_internal_mutex_t *internal_mutex,
+     uint32_t *error_code );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_mutex_grab(
      libcthreads_mutex_t *mutex,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_mutex_grab_fast(
+     libcthreads_mutex_t *mutex );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_mutex_try_grab(
      libcthreads_mutex_t *mutex,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_mutex_try_grab_fast(
+     libcthreads_mutex_t *mutex );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_mutex_release(
      libcthreads_mutex_t *mutex,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_mutex_release_fast(
+     libcthreads_mutex_t *mutex );
+
 #endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 #if defined( __cplusplus )
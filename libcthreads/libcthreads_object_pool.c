@@ -0,0 +1,982 @@
+/*
+ * Object pool functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libcthreads_libcerror.h"
+#include "libcthreads_mutex.h"
+#include "libcthreads_object_pool.h"
+#include "libcthreads_stack.h"
+#include "libcthreads_thread_local.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The size of the slab header, which contains the pointer to the next slab
+ */
+#define LIBCTHREADS_OBJECT_POOL_SLAB_HEADER_SIZE	16
+
+/* Marks the thread cache as orphaned when its owning thread exits
+ * Objects of an orphaned thread cache remain valid and the thread cache
+ * is adopted by the next thread that needs a thread cache
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_object_pool_thread_cache_exit(
+     intptr_t **thread_cache,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_object_pool_thread_cache_t *internal_thread_cache = NULL;
+	static char *function                                                  = "libcthreads_internal_object_pool_thread_cache_exit";
+
+	if( thread_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *thread_cache == NULL )
+	{
+		return( 1 );
+	}
+	internal_thread_cache = (libcthreads_internal_object_pool_thread_cache_t *) *thread_cache;
+	*thread_cache         = NULL;
+
+	if( libcthreads_mutex_grab(
+	     internal_thread_cache->object_pool->thread_caches_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab thread caches mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_cache->is_orphaned = 1;
+
+	if( libcthreads_mutex_release(
+	     internal_thread_cache->object_pool->thread_caches_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release thread caches mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates an object pool
+ * Make sure the value object_pool is referencing, is set to NULL
+ *
+ * Objects are allocated from slabs of number_of_objects_per_slab objects
+ * per power of 2 size class, from 16 bytes up to the maximum object size.
+ * Every thread has its own cache of free objects. Objects freed by another
+ * thread than the one that allocated them are pushed onto a lock-free stack
+ * of the owning thread cache, which reclaims them in a single batch.
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_object_pool_initialize(
+     libcthreads_object_pool_t **object_pool,
+     size_t maximum_object_size,
+     int number_of_objects_per_slab,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_object_pool_t *internal_object_pool = NULL;
+	static char *function                                    = "libcthreads_object_pool_initialize";
+	size_t size_class_size                                   = LIBCTHREADS_OBJECT_POOL_MINIMUM_OBJECT_SIZE;
+	int number_of_size_classes                               = 1;
+
+	if( object_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *object_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid object pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_object_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum object size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	while( size_class_size < maximum_object_size )
+	{
+		if( number_of_size_classes >= LIBCTHREADS_OBJECT_POOL_MAXIMUM_NUMBER_OF_SIZE_CLASSES )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid maximum object size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		size_class_size <<= 1;
+
+		number_of_size_classes++;
+	}
+	if( number_of_objects_per_slab <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of objects per slab value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) number_of_objects_per_slab > ( ( (size_t) SSIZE_MAX - LIBCTHREADS_OBJECT_POOL_SLAB_HEADER_SIZE ) / ( LIBCTHREADS_OBJECT_POOL_OBJECT_HEADER_SIZE + size_class_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of objects per slab value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	internal_object_pool = memory_allocate_structure(
+	                        libcthreads_internal_object_pool_t );
+
+	if( internal_object_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create object pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_object_pool,
+	     0,
+	     sizeof( libcthreads_internal_object_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear object pool.",
+		 function );
+
+		memory_free(
+		 internal_object_pool );
+
+		return( -1 );
+	}
+	internal_object_pool->maximum_object_size        = size_class_size;
+	internal_object_pool->number_of_size_classes     = number_of_size_classes;
+	internal_object_pool->number_of_objects_per_slab = number_of_objects_per_slab;
+
+	if( libcthreads_mutex_initialize(
+	     &( internal_object_pool->thread_caches_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread caches mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_local_initialize(
+	     &( internal_object_pool->thread_cache_storage ),
+	     &libcthreads_internal_object_pool_thread_cache_exit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread cache storage.",
+		 function );
+
+		goto on_error;
+	}
+	*object_pool = (libcthreads_object_pool_t *) internal_object_pool;
+
+	return( 1 );
+
+on_error:
+	if( internal_object_pool != NULL )
+	{
+		if( internal_object_pool->thread_caches_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_object_pool->thread_caches_mutex ),
+			 NULL );
+		}
+		memory_free(
+		 internal_object_pool );
+	}
+	return( -1 );
+}
+
+/* Frees an object pool
+ * All objects allocated from the object pool are freed as well
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_object_pool_free(
+     libcthreads_object_pool_t **object_pool,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_object_pool_t *internal_object_pool      = NULL;
+	libcthreads_internal_object_pool_thread_cache_t *thread_cache = NULL;
+	static char *function                                         = "libcthreads_object_pool_free";
+	int result                                                    = 1;
+
+	if( object_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *object_pool != NULL )
+	{
+		internal_object_pool = (libcthreads_internal_object_pool_t *) *object_pool;
+		*object_pool         = NULL;
+
+		/* Freeing the thread cache storage marks the thread caches of the threads
+		 * that have not exited as orphaned
+		 */
+		if( libcthreads_thread_local_free(
+		     &( internal_object_pool->thread_cache_storage ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free thread cache storage.",
+			 function );
+
+			result = -1;
+		}
+		while( internal_object_pool->first_thread_cache != NULL )
+		{
+			thread_cache = internal_object_pool->first_thread_cache;
+
+			internal_object_pool->first_thread_cache = thread_cache->next_thread_cache;
+
+			if( libcthreads_internal_object_pool_thread_cache_free(
+			     &thread_cache,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free thread cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( internal_object_pool->thread_caches_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free thread caches mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_object_pool );
+	}
+	return( result );
+}
+
+/* Frees a thread cache and its slabs
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_object_pool_thread_cache_free(
+     libcthreads_internal_object_pool_thread_cache_t **thread_cache,
+     libcerror_error_t **error )
+{
+	uint8_t *slab         = NULL;
+	static char *function = "libcthreads_internal_object_pool_thread_cache_free";
+	int result            = 1;
+
+	if( thread_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *thread_cache != NULL )
+	{
+		while( ( *thread_cache )->first_slab != NULL )
+		{
+			slab = ( *thread_cache )->first_slab;
+
+			( *thread_cache )->first_slab = *( (uint8_t **) slab );
+
+			memory_free(
+			 slab );
+		}
+		if( libcthreads_stack_free(
+		     &( ( *thread_cache )->remote_free_stack ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free remote free stack.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *thread_cache );
+
+		*thread_cache = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the thread cache of the current thread
+ * If create_thread_cache is set an orphaned thread cache is adopted
+ * or a new thread cache is created if the current thread has none
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libcthreads_internal_object_pool_get_thread_cache(
+     libcthreads_internal_object_pool_t *internal_object_pool,
+     uint8_t create_thread_cache,
+     libcthreads_internal_object_pool_thread_cache_t **thread_cache,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_object_pool_thread_cache_t *safe_thread_cache = NULL;
+	static char *function                                              = "libcthreads_internal_object_pool_get_thread_cache";
+	int result                                                         = 0;
+
+	if( internal_object_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread cache.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_thread_local_get_value(
+	          internal_object_pool->thread_cache_storage,
+	          (intptr_t **) &safe_thread_cache,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve thread cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( result != 0 )
+	 || ( create_thread_cache == 0 ) )
+	{
+		*thread_cache = safe_thread_cache;
+
+		return( result );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_object_pool->thread_caches_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab thread caches mutex.",
+		 function );
+
+		return( -1 );
+	}
+	safe_thread_cache = internal_object_pool->first_thread_cache;
+
+	while( safe_thread_cache != NULL )
+	{
+		if( safe_thread_cache->is_orphaned != 0 )
+		{
+			safe_thread_cache->is_orphaned = 0;
+
+			break;
+		}
+		safe_thread_cache = safe_thread_cache->next_thread_cache;
+	}
+	if( safe_thread_cache == NULL )
+	{
+		safe_thread_cache = memory_allocate_structure(
+		                     libcthreads_internal_object_pool_thread_cache_t );
+
+		if( safe_thread_cache == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create thread cache.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     safe_thread_cache,
+		     0,
+		     sizeof( libcthreads_internal_object_pool_thread_cache_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear thread cache.",
+			 function );
+
+			memory_free(
+			 safe_thread_cache );
+
+			safe_thread_cache = NULL;
+
+			goto on_error;
+		}
+		safe_thread_cache->object_pool = internal_object_pool;
+
+		if( libcthreads_stack_initialize(
+		     &( safe_thread_cache->remote_free_stack ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create remote free stack.",
+			 function );
+
+			memory_free(
+			 safe_thread_cache );
+
+			safe_thread_cache = NULL;
+
+			goto on_error;
+		}
+		safe_thread_cache->next_thread_cache = internal_object_pool->first_thread_cache;
+
+		internal_object_pool->first_thread_cache = safe_thread_cache;
+	}
+	if( libcthreads_thread_local_set_value(
+	     internal_object_pool->thread_cache_storage,
+	     (intptr_t *) safe_thread_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set thread cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     internal_object_pool->thread_caches_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release thread caches mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*thread_cache = safe_thread_cache;
+
+	return( 1 );
+
+on_error:
+	/* A thread cache that could not be assigned to the current thread
+	 * remains available for adoption
+	 */
+	if( safe_thread_cache != NULL )
+	{
+		safe_thread_cache->is_orphaned = 1;
+	}
+	libcthreads_mutex_release(
+	 internal_object_pool->thread_caches_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reclaims the objects freed by other threads in a single batch
+ * The objects are added to the free objects of their size class
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_object_pool_reclaim_remote_free_objects(
+     libcthreads_internal_object_pool_thread_cache_t *thread_cache,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_object_pool_object_header_t *object_header = NULL;
+	libcthreads_stack_node_t *node                                  = NULL;
+	libcthreads_stack_node_t *next_node                             = NULL;
+	static char *function                                           = "libcthreads_internal_object_pool_reclaim_remote_free_objects";
+	int result                                                      = 0;
+	int size_class_index                                            = 0;
+
+	if( thread_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread cache.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_stack_pop_all(
+	          thread_cache->remote_free_stack,
+	          &node,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop remote free objects.",
+		 function );
+
+		return( -1 );
+	}
+	/* A free object contains the pointer to the next free object
+	 * at the same location as the next node of a stack node
+	 */
+	while( node != NULL )
+	{
+		next_node = node->next_node;
+
+		object_header = (libcthreads_internal_object_pool_object_header_t *) &( ( (uint8_t *) node )[ -LIBCTHREADS_OBJECT_POOL_OBJECT_HEADER_SIZE ] );
+
+		size_class_index = (int) object_header->size_class_index;
+
+		*( (uint8_t **) node ) = thread_cache->free_objects[ size_class_index ];
+
+		thread_cache->free_objects[ size_class_index ] = (uint8_t *) node;
+
+		node = next_node;
+	}
+	return( 1 );
+}
+
+/* Allocates a slab of objects for a specific size class and adds the objects
+ * to the free objects of the thread cache
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_object_pool_allocate_slab(
+     libcthreads_internal_object_pool_t *internal_object_pool,
+     libcthreads_internal_object_pool_thread_cache_t *thread_cache,
+     int size_class_index,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_object_pool_object_header_t *object_header = NULL;
+	uint8_t *object                                                 = NULL;
+	uint8_t *slab                                                   = NULL;
+	static char *function                                           = "libcthreads_internal_object_pool_allocate_slab";
+	size_t object_slot_size                                         = 0;
+	size_t slab_size                                                = 0;
+	int object_index                                                = 0;
+
+	if( internal_object_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size_class_index < 0 )
+	 || ( size_class_index >= internal_object_pool->number_of_size_classes ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size class index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	object_slot_size = LIBCTHREADS_OBJECT_POOL_OBJECT_HEADER_SIZE
+	                 + ( (size_t) LIBCTHREADS_OBJECT_POOL_MINIMUM_OBJECT_SIZE << size_class_index );
+
+	slab_size = LIBCTHREADS_OBJECT_POOL_SLAB_HEADER_SIZE
+	          + ( object_slot_size * internal_object_pool->number_of_objects_per_slab );
+
+	slab = (uint8_t *) memory_allocate(
+	                    slab_size );
+
+	if( slab == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slab.",
+		 function );
+
+		return( -1 );
+	}
+	/* The slab header contains the pointer to the next slab
+	 */
+	*( (uint8_t **) slab ) = thread_cache->first_slab;
+
+	thread_cache->first_slab = slab;
+
+	for( object_index = internal_object_pool->number_of_objects_per_slab - 1;
+	     object_index >= 0;
+	     object_index-- )
+	{
+		object_header = (libcthreads_internal_object_pool_object_header_t *) &( slab[ LIBCTHREADS_OBJECT_POOL_SLAB_HEADER_SIZE + ( object_index * object_slot_size ) ] );
+
+		object_header->thread_cache     = thread_cache;
+		object_header->size_class_index = (uint32_t) size_class_index;
+
+		object = &( ( (uint8_t *) object_header )[ LIBCTHREADS_OBJECT_POOL_OBJECT_HEADER_SIZE ] );
+
+		/* A free object contains the pointer to the next free object
+		 */
+		*( (uint8_t **) object ) = thread_cache->free_objects[ size_class_index ];
+
+		thread_cache->free_objects[ size_class_index ] = object;
+	}
+	return( 1 );
+}
+
+/* Allocates an object from the object pool
+ * The object is 16 byte aligned
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_object_pool_allocate_object(
+     libcthreads_object_pool_t *object_pool,
+     size_t object_size,
+     intptr_t **object,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_object_pool_t *internal_object_pool      = NULL;
+	libcthreads_internal_object_pool_thread_cache_t *thread_cache = NULL;
+	uint8_t *free_object                                          = NULL;
+	static char *function                                         = "libcthreads_object_pool_allocate_object";
+	size_t size_class_size                                        = LIBCTHREADS_OBJECT_POOL_MINIMUM_OBJECT_SIZE;
+	int size_class_index                                          = 0;
+
+	if( object_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_object_pool = (libcthreads_internal_object_pool_t *) object_pool;
+
+	if( object_size > internal_object_pool->maximum_object_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid object size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object.",
+		 function );
+
+		return( -1 );
+	}
+	while( size_class_size < object_size )
+	{
+		size_class_size <<= 1;
+
+		size_class_index++;
+	}
+	if( libcthreads_internal_object_pool_get_thread_cache(
+	     internal_object_pool,
+	     1,
+	     &thread_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve thread cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_cache->free_objects[ size_class_index ] == NULL )
+	{
+		if( libcthreads_internal_object_pool_reclaim_remote_free_objects(
+		     thread_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to reclaim remote free objects.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( thread_cache->free_objects[ size_class_index ] == NULL )
+	{
+		if( libcthreads_internal_object_pool_allocate_slab(
+		     internal_object_pool,
+		     thread_cache,
+		     size_class_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to allocate slab.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	free_object = thread_cache->free_objects[ size_class_index ];
+
+	thread_cache->free_objects[ size_class_index ] = *( (uint8_t **) free_object );
+
+	*object = (intptr_t *) free_object;
+
+	return( 1 );
+}
+
+/* Frees an object allocated from the object pool
+ * An object freed by another thread than the one that owns it is pushed
+ * onto the remote free stack of the owning thread cache without locking
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_object_pool_free_object(
+     libcthreads_object_pool_t *object_pool,
+     intptr_t *object,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_object_pool_t *internal_object_pool        = NULL;
+	libcthreads_internal_object_pool_object_header_t *object_header = NULL;
+	libcthreads_internal_object_pool_thread_cache_t *owner_cache    = NULL;
+	libcthreads_internal_object_pool_thread_cache_t *thread_cache   = NULL;
+	static char *function                                           = "libcthreads_object_pool_free_object";
+	int result                                                      = 0;
+	int size_class_index                                            = 0;
+
+	if( object_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_object_pool = (libcthreads_internal_object_pool_t *) object_pool;
+
+	if( object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object.",
+		 function );
+
+		return( -1 );
+	}
+	object_header = (libcthreads_internal_object_pool_object_header_t *) &( ( (uint8_t *) object )[ -LIBCTHREADS_OBJECT_POOL_OBJECT_HEADER_SIZE ] );
+
+	owner_cache      = object_header->thread_cache;
+	size_class_index = (int) object_header->size_class_index;
+
+	if( ( owner_cache == NULL )
+	 || ( owner_cache->object_pool != internal_object_pool )
+	 || ( size_class_index >= internal_object_pool->number_of_size_classes ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid object - not allocated from object pool.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_internal_object_pool_get_thread_cache(
+	          internal_object_pool,
+	          0,
+	          &thread_cache,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve thread cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_cache == owner_cache )
+	{
+		*( (uint8_t **) object ) = owner_cache->free_objects[ size_class_index ];
+
+		owner_cache->free_objects[ size_class_index ] = (uint8_t *) object;
+
+		return( 1 );
+	}
+	if( libcthreads_stack_push(
+	     owner_cache->remote_free_stack,
+	     (libcthreads_stack_node_t *) object,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push object onto remote free stack.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
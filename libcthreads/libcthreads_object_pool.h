@@ -0,0 +1,176 @@
+/*
+ * Object pool functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_OBJECT_POOL_H )
+#define _LIBCTHREADS_INTERNAL_OBJECT_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The smallest object size class
+ */
+#define LIBCTHREADS_OBJECT_POOL_MINIMUM_OBJECT_SIZE		16
+
+/* The maximum number of object size classes, the largest size class is 512 KiB
+ */
+#define LIBCTHREADS_OBJECT_POOL_MAXIMUM_NUMBER_OF_SIZE_CLASSES	16
+
+/* The size of the object header that precedes every object
+ * the header is padded to keep objects 16 byte aligned
+ */
+#define LIBCTHREADS_OBJECT_POOL_OBJECT_HEADER_SIZE		16
+
+typedef struct libcthreads_internal_object_pool libcthreads_internal_object_pool_t;
+typedef struct libcthreads_internal_object_pool_thread_cache libcthreads_internal_object_pool_thread_cache_t;
+typedef struct libcthreads_internal_object_pool_object_header libcthreads_internal_object_pool_object_header_t;
+
+struct libcthreads_internal_object_pool_object_header
+{
+	/* The thread cache that owns the object
+	 */
+	libcthreads_internal_object_pool_thread_cache_t *thread_cache;
+
+	/* The size class index
+	 */
+	uint32_t size_class_index;
+};
+
+struct libcthreads_internal_object_pool_thread_cache
+{
+	/* The object pool
+	 */
+	libcthreads_internal_object_pool_t *object_pool;
+
+	/* The free objects per size class, only accessed by the owning thread
+	 */
+	uint8_t *free_objects[ LIBCTHREADS_OBJECT_POOL_MAXIMUM_NUMBER_OF_SIZE_CLASSES ];
+
+	/* The stack of objects freed by other threads, of all size classes
+	 */
+	libcthreads_stack_t *remote_free_stack;
+
+	/* The first slab allocated by the thread cache
+	 */
+	uint8_t *first_slab;
+
+	/* The next thread cache
+	 */
+	libcthreads_internal_object_pool_thread_cache_t *next_thread_cache;
+
+	/* Value to indicate the owning thread has exited
+	 */
+	uint8_t is_orphaned;
+};
+
+struct libcthreads_internal_object_pool
+{
+	/* The maximum object size
+	 */
+	size_t maximum_object_size;
+
+	/* The number of size classes
+	 */
+	int number_of_size_classes;
+
+	/* The number of objects per slab
+	 */
+	int number_of_objects_per_slab;
+
+	/* The thread local storage of the thread cache of the current thread
+	 */
+	libcthreads_thread_local_t *thread_cache_storage;
+
+	/* The thread caches mutex
+	 */
+	libcthreads_mutex_t *thread_caches_mutex;
+
+	/* The first thread cache
+	 */
+	libcthreads_internal_object_pool_thread_cache_t *first_thread_cache;
+};
+
+LIBCTHREADS_EXTERN \
+int libcthreads_object_pool_initialize(
+     libcthreads_object_pool_t **object_pool,
+     size_t maximum_object_size,
+     int number_of_objects_per_slab,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_object_pool_free(
+     libcthreads_object_pool_t **object_pool,
+     libcerror_error_t **error );
+
+int libcthreads_internal_object_pool_thread_cache_exit(
+     intptr_t **thread_cache,
+     libcerror_error_t **error );
+
+int libcthreads_internal_object_pool_thread_cache_free(
+     libcthreads_internal_object_pool_thread_cache_t **thread_cache,
+     libcerror_error_t **error );
+
+int libcthreads_internal_object_pool_get_thread_cache(
+     libcthreads_internal_object_pool_t *internal_object_pool,
+     uint8_t create_thread_cache,
+     libcthreads_internal_object_pool_thread_cache_t **thread_cache,
+     libcerror_error_t **error );
+
+int libcthreads_internal_object_pool_reclaim_remote_free_objects(
+     libcthreads_internal_object_pool_thread_cache_t *thread_cache,
+     libcerror_error_t **error );
+
+int libcthreads_internal_object_pool_allocate_slab(
+     libcthreads_internal_object_pool_t *internal_object_pool,
+     libcthreads_internal_object_pool_thread_cache_t *thread_cache,
+     int size_class_index,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_object_pool_allocate_object(
+     libcthreads_object_pool_t *object_pool,
+     size_t object_size,
+     intptr_t **object,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_object_pool_free_object(
+     libcthreads_object_pool_t *object_pool,
+     intptr_t *object,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_OBJECT_POOL_H ) */
+
@@ -0,0 +1,47 @@
+/*
+ * Static probe (USDT) definitions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_probes.h"
+
+#if defined( HAVE_LIBCTHREADS_USDT_PROBES ) && defined( HAVE_SYS_SDT_H )
+
+/* The probe semaphores are incremented by a tracer, such as bpftrace or SystemTap,
+ * when it attaches to the corresponding probe
+ */
+#define LIBCTHREADS_PROBE_SEMAPHORE( name ) \
+	unsigned short libcthreads_##name##_semaphore __attribute__ ((section (".probes"))) = 0;
+
+LIBCTHREADS_PROBE_SEMAPHORE( mutex__acquire )
+LIBCTHREADS_PROBE_SEMAPHORE( mutex__contended )
+LIBCTHREADS_PROBE_SEMAPHORE( mutex__release )
+LIBCTHREADS_PROBE_SEMAPHORE( cond__wait )
+LIBCTHREADS_PROBE_SEMAPHORE( cond__wake )
+LIBCTHREADS_PROBE_SEMAPHORE( queue__push )
+LIBCTHREADS_PROBE_SEMAPHORE( queue__pop )
+LIBCTHREADS_PROBE_SEMAPHORE( queue__full )
+LIBCTHREADS_PROBE_SEMAPHORE( pool__task__start )
+LIBCTHREADS_PROBE_SEMAPHORE( pool__task__end )
+
+#endif /* defined( HAVE_LIBCTHREADS_USDT_PROBES ) && defined( HAVE_SYS_SDT_H ) */
+
@@ -0,0 +1,103 @@
+/*
+ * Static probe (USDT) definitions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_PROBES_H )
+#define _LIBCTHREADS_PROBES_H
+
+#include <common.h>
+#include <types.h>
+
+/* The probes of the libcthreads provider, for example for bpftrace:
+ *   usdt:libcthreads.so:libcthreads:mutex__contended
+ *
+ * mutex__acquire( mutex )                  a mutex was grabbed
+ * mutex__contended( mutex )                a mutex grab has to wait for another thread
+ * mutex__release( mutex )                  a mutex was released
+ * cond__wait( condition, mutex )           a thread starts waiting on a condition
+ * cond__wake( condition, mutex )           a thread stops waiting on a condition
+ * queue__push( queue, number_of_values )   a value was pushed onto a queue
+ * queue__pop( queue, number_of_values )    a value was popped off a queue
+ * queue__full( queue )                     a push has to wait for the queue to have room
+ * pool__task__start( thread_pool, value )  a thread pool worker starts running a callback
+ * pool__task__end( thread_pool, value, result )
+ *                                          a thread pool worker finished running a callback
+ *
+ * The probes are only available if the library was built with --enable-usdt-probes,
+ * otherwise the probe macros do nothing
+ */
+#if defined( HAVE_LIBCTHREADS_USDT_PROBES ) && defined( HAVE_SYS_SDT_H )
+
+/* The probes use semaphores so that work that is only needed by a probe
+ * is skipped when no tracer is attached
+ */
+#define _SDT_HAS_SEMAPHORES 1
+
+#include <sys/sdt.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+extern unsigned short libcthreads_mutex__acquire_semaphore;
+extern unsigned short libcthreads_mutex__contended_semaphore;
+extern unsigned short libcthreads_mutex__release_semaphore;
+extern unsigned short libcthreads_cond__wait_semaphore;
+extern unsigned short libcthreads_cond__wake_semaphore;
+extern unsigned short libcthreads_queue__push_semaphore;
+extern unsigned short libcthreads_queue__pop_semaphore;
+extern unsigned short libcthreads_queue__full_semaphore;
+extern unsigned short libcthreads_pool__task__start_semaphore;
+extern unsigned short libcthreads_pool__task__end_semaphore;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#define LIBCTHREADS_PROBE_ENABLED( name ) \
+	( __builtin_expect( libcthreads_##name##_semaphore != 0, 0 ) )
+
+#define LIBCTHREADS_PROBE1( name, argument1 ) \
+	DTRACE_PROBE1( libcthreads, name, argument1 )
+
+#define LIBCTHREADS_PROBE2( name, argument1, argument2 ) \
+	DTRACE_PROBE2( libcthreads, name, argument1, argument2 )
+
+#define LIBCTHREADS_PROBE3( name, argument1, argument2, argument3 ) \
+	DTRACE_PROBE3( libcthreads, name, argument1, argument2, argument3 )
+
+#else
+
+#define LIBCTHREADS_PROBE_ENABLED( name ) \
+	( 0 )
+
+#define LIBCTHREADS_PROBE1( name, argument1 ) \
+	do { } while( 0 )
+
+#define LIBCTHREADS_PROBE2( name, argument1, argument2 ) \
+	do { } while( 0 )
+
+#define LIBCTHREADS_PROBE3( name, argument1, argument2, argument3 ) \
+	do { } while( 0 )
+
+#endif /* defined( HAVE_LIBCTHREADS_USDT_PROBES ) && defined( HAVE_SYS_SDT_H ) */
+
+#endif /* !defined( _LIBCTHREADS_PROBES_H ) */
+
@@ -23,11 +23,23 @@
 #include <memory.h>
 #include <types.h>
 
+#include <errno.h>
+
+#if defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI )
+#include <sys/eventfd.h>
+#endif
+
+#if defined( HAVE_UNISTD_H ) && !defined( WINAPI )
+#include <unistd.h>
+#endif
+
 #include "libcthreads_condition.h"
 #include "libcthreads_definitions.h"
 #include "libcthreads_libcerror.h"
 #include "libcthreads_mutex.h"
+#include "libcthreads_probes.h"
 #include "libcthreads_queue.h"
+#include "libcthreads_tracer.h"
 #include "libcthreads_types.h"
 
 #if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
@@ -40,9 +52,45 @@ int libcthreads_queue_initialize(
      libcthreads_queue_t **queue,
      int maximum_number_of_values,
      libcerror_error_t **error )
+{
+	static char *function = "libcthreads_queue_initialize";
+
+	if( libcthreads_queue_initialize_with_value_size(
+	     queue,
+	     maximum_number_of_values,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates a queue that stores values inline
+ * Make sure the value queue is referencing, is set to NULL
+ *
+ * If value_size is 0 the queue stores value pointers, otherwise values of up to
+ * value_size bytes are copied into cache line aligned slots of the queue
+ * using the push_value_data and pop_value_data functions
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_queue_initialize_with_value_size(
+     libcthreads_queue_t **queue,
+     int maximum_number_of_values,
+     size_t value_size,
+     libcerror_error_t **error )
 {
 	libcthreads_internal_queue_t *internal_queue = NULL;
-	static char *function                        = "libcthreads_queue_initialize";
+	static char *function                        = "libcthreads_queue_initialize_with_value_size";
+	size_t value_slot_size                       = 0;
 	size_t values_array_size                     = 0;
 
 	if( queue == NULL )
@@ -78,10 +126,29 @@ int libcthreads_queue_initialize(
 
 		return( -1 );
 	}
+	if( value_size > (size_t) ( SSIZE_MAX - LIBCTHREADS_CACHE_LINE_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid value size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_size == 0 )
+	{
+		value_slot_size = sizeof( intptr_t * );
+	}
+	else
+	{
+		value_slot_size = ( value_size + LIBCTHREADS_CACHE_LINE_SIZE - 1 ) & ~( (size_t) LIBCTHREADS_CACHE_LINE_SIZE - 1 );
+	}
 #if SIZEOF_INT <= SIZEOF_SIZE_T
-	if( (size_t) maximum_number_of_values > (size_t) ( SSIZE_MAX / sizeof( intptr_t * ) ) )
+	if( (size_t) maximum_number_of_values > (size_t) ( ( SSIZE_MAX - LIBCTHREADS_CACHE_LINE_SIZE ) / value_slot_size ) )
 #else
-	if( maximum_number_of_values > (int) ( SSIZE_MAX / sizeof( intptr_t * ) ) )
+	if( maximum_number_of_values > (int) ( ( SSIZE_MAX - LIBCTHREADS_CACHE_LINE_SIZE ) / value_slot_size ) )
 #endif
 	{
 		libcerror_error_set(
@@ -93,7 +160,14 @@ int libcthreads_queue_initialize(
 
 		return( -1 );
 	}
-	values_array_size = sizeof( intptr_t * ) * maximum_number_of_values;
+	values_array_size = value_slot_size * maximum_number_of_values;
+
+	if( value_size != 0 )
+	{
+		/* Reserve space to align the value slots on a cache line boundary
+		 */
+		values_array_size += LIBCTHREADS_CACHE_LINE_SIZE;
+	}
 
 	if( values_array_size > (size_t) SSIZE_MAX )
 	{
@@ -137,35 +211,88 @@ int libcthreads_queue_initialize(
 
 		return( -1 );
 	}
-	internal_queue->values_array = (intptr_t **) memory_allocate(
-	                                              values_array_size );
-
-	if( internal_queue->values_array == NULL )
+	if( value_size == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create values array.",
-		 function );
+		internal_queue->values_array = (intptr_t **) memory_allocate(
+		                                              values_array_size );
 
-		goto on_error;
+		if( internal_queue->values_array == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create values array.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     internal_queue->values_array,
+		     0,
+		     values_array_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear values array.",
+			 function );
+
+			goto on_error;
+		}
 	}
-	if( memory_set(
-	     internal_queue->values_array,
-	     0,
-	     values_array_size ) == NULL )
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear values array.",
-		 function );
+		internal_queue->values_data = (uint8_t *) memory_allocate(
+		                                           values_array_size );
 
-		goto on_error;
+		if( internal_queue->values_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create values data.",
+			 function );
+
+			goto on_error;
+		}
+		internal_queue->value_slots_data = (uint8_t *) ( ( (intptr_t) internal_queue->values_data + LIBCTHREADS_CACHE_LINE_SIZE - 1 ) & ~( (intptr_t) LIBCTHREADS_CACHE_LINE_SIZE - 1 ) );
+
+		internal_queue->value_slots_in_use = (uint8_t *) memory_allocate(
+		                                                  sizeof( uint8_t ) * maximum_number_of_values );
+
+		if( internal_queue->value_slots_in_use == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create value slots in use array.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     internal_queue->value_slots_in_use,
+		     0,
+		     sizeof( uint8_t ) * maximum_number_of_values ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear value slots in use array.",
+			 function );
+
+			goto on_error;
+		}
+		internal_queue->value_size      = value_size;
+		internal_queue->value_slot_size = value_slot_size;
 	}
 	internal_queue->allocated_number_of_values = maximum_number_of_values;
+	internal_queue->readiness_file_descriptor  = -1;
 
 	if( libcthreads_mutex_initialize(
 	     &( internal_queue->condition_mutex ),
@@ -225,6 +352,16 @@ on_error:
 			 &( internal_queue->condition_mutex ),
 			 NULL );
 		}
+		if( internal_queue->value_slots_in_use != NULL )
+		{
+			memory_free(
+			 internal_queue->value_slots_in_use );
+		}
+		if( internal_queue->values_data != NULL )
+		{
+			memory_free(
+			 internal_queue->values_data );
+		}
 		if( internal_queue->values_array != NULL )
 		{
 			memory_free(
@@ -268,7 +405,8 @@ int libcthreads_queue_free(
 		internal_queue = (libcthreads_internal_queue_t *) *queue;
 		*queue         = NULL;
 
-		if( value_free_function != NULL )
+		if( ( value_free_function != NULL )
+		 && ( internal_queue->values_array != NULL ) )
 		{
 			for( value_index = 0;
 			     value_index < internal_queue->number_of_values;
@@ -290,9 +428,39 @@ int libcthreads_queue_free(
 				}
 			}
 		}
-		memory_free(
-		 internal_queue->values_array );
-
+		if( internal_queue->values_array != NULL )
+		{
+			memory_free(
+			 internal_queue->values_array );
+		}
+		if( internal_queue->values_data != NULL )
+		{
+			memory_free(
+			 internal_queue->values_data );
+		}
+		if( internal_queue->value_slots_in_use != NULL )
+		{
+			memory_free(
+			 internal_queue->value_slots_in_use );
+		}
+#if defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI )
+		if( internal_queue->readiness_file_descriptor != -1 )
+		{
+			if( close(
+			     internal_queue->readiness_file_descriptor ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 errno,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close readiness file descriptor.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( libcthreads_condition_free(
 		     &( internal_queue->full_condition ),
 		     error ) != 1 )
@@ -362,7 +530,8 @@ int libcthreads_queue_empty(
 	}
 	internal_queue = (libcthreads_internal_queue_t *) queue;
 
-	if( internal_queue->values_array == NULL )
+	if( ( internal_queue->values_array == NULL )
+	 && ( internal_queue->value_slots_data == NULL ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -388,6 +557,10 @@ int libcthreads_queue_empty(
 	}
 	while( internal_queue->number_of_values != 0 )
 	{
+		LIBCTHREADS_PROBE1(
+		 queue__full,
+		 internal_queue );
+
 		if( libcthreads_condition_wait(
 		     internal_queue->full_condition,
 		     internal_queue->condition_mutex,
@@ -426,17 +599,19 @@ on_error:
 	return( -1 );
 }
 
-/* Tries to pop a value off the queue
- * Returns 1 if successful, 0 if not or -1 on error
+/* Retrieves the readiness file descriptor
+ * The file descriptor is an eventfd that is readable while the queue contains values
+ * and is created on first use. It is owned by the queue and must not be read from,
+ * written to or closed by the caller
+ * Returns 1 if successful or -1 on error
  */
-int libcthreads_queue_try_pop(
+int libcthreads_queue_get_readiness_file_descriptor(
      libcthreads_queue_t *queue,
-     intptr_t **value,
+     int *file_descriptor,
      libcerror_error_t **error )
 {
 	libcthreads_internal_queue_t *internal_queue = NULL;
-	static char *function                        = "libcthreads_queue_try_pop";
-	int result                                   = 1;
+	static char *function                        = "libcthreads_queue_get_readiness_file_descriptor";
 
 	if( queue == NULL )
 	{
@@ -449,30 +624,20 @@ int libcthreads_queue_try_pop(
 
 		return( -1 );
 	}
-	internal_queue = (libcthreads_internal_queue_t *) queue;
-
-	if( internal_queue->values_array == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid queue - missing values array.",
-		 function );
-
-		return( -1 );
-	}
-	if( value == NULL )
+	if( file_descriptor == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value.",
+		 "%s: invalid file descriptor.",
 		 function );
 
 		return( -1 );
 	}
+#if defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI )
+	internal_queue = (libcthreads_internal_queue_t *) queue;
+
 	if( libcthreads_mutex_grab(
 	     internal_queue->condition_mutex,
 	     error ) != 1 )
@@ -486,38 +651,43 @@ int libcthreads_queue_try_pop(
 
 		return( -1 );
 	}
-	if( internal_queue->number_of_values == 0 )
-	{
-		result = 0;
-	}
-	else
+	if( internal_queue->readiness_file_descriptor == -1 )
 	{
-		*value = internal_queue->values_array[ internal_queue->pop_index ];
-
-		internal_queue->pop_index++;
-
-		if( internal_queue->pop_index >= internal_queue->allocated_number_of_values )
-		{
-			internal_queue->pop_index = 0;
-		}
-		internal_queue->number_of_values--;
+		internal_queue->readiness_file_descriptor = eventfd(
+		                                             0,
+		                                             EFD_CLOEXEC | EFD_NONBLOCK );
 
-		/* The condition broadcast must be protected by the mutex for the WINAPI version
-		 */
-		if( libcthreads_condition_broadcast(
-		     internal_queue->full_condition,
-		     error ) != 1 )
+		if( internal_queue->readiness_file_descriptor == -1 )
 		{
-			libcerror_error_set(
+			libcerror_system_set_error(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to broadcast full condition.",
+			 errno,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to create readiness file descriptor.",
 			 function );
 
 			goto on_error;
 		}
+		if( internal_queue->number_of_values > 0 )
+		{
+			if( libcthreads_internal_queue_signal_readiness(
+			     internal_queue,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal readiness.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
+	*file_descriptor = internal_queue->readiness_file_descriptor;
+
 	if( libcthreads_mutex_release(
 	     internal_queue->condition_mutex,
 	     error ) != 1 )
@@ -531,7 +701,7 @@ int libcthreads_queue_try_pop(
 
 		return( -1 );
 	}
-	return( result );
+	return( 1 );
 
 on_error:
 	libcthreads_mutex_release(
@@ -539,20 +709,35 @@ on_error:
 	 NULL );
 
 	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: readiness file descriptor not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI ) */
 }
 
-/* Pops a value off the queue
+/* Signals the readiness file descriptor, if any, that the queue contains values
+ * This function should only be called on the empty to non-empty transition
+ * with the condition mutex held
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_queue_pop(
-     libcthreads_queue_t *queue,
-     intptr_t **value,
+int libcthreads_internal_queue_signal_readiness(
+     libcthreads_internal_queue_t *internal_queue,
      libcerror_error_t **error )
 {
-	libcthreads_internal_queue_t *internal_queue = NULL;
-	static char *function                        = "libcthreads_queue_pop";
+	static char *function = "libcthreads_internal_queue_signal_readiness";
 
-	if( queue == NULL )
+#if defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI )
+	uint64_t event_value  = 1;
+	ssize_t write_count   = 0;
+#endif
+
+	if( internal_queue == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -563,81 +748,316 @@ int libcthreads_queue_pop(
 
 		return( -1 );
 	}
-	internal_queue = (libcthreads_internal_queue_t *) queue;
-
-	if( internal_queue->values_array == NULL )
+#if defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI )
+	if( internal_queue->readiness_file_descriptor != -1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid queue - missing values array.",
-		 function );
+		write_count = write(
+		               internal_queue->readiness_file_descriptor,
+		               &event_value,
+		               sizeof( uint64_t ) );
 
-		return( -1 );
+		/* EAGAIN indicates the event counter is saturated and hence already readable
+		 */
+		if( ( write_count != (ssize_t) sizeof( uint64_t ) )
+		 && ( errno != EAGAIN ) )
+		{
+			libcerror_system_set_error(
+			 error,
+			 errno,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write readiness file descriptor.",
+			 function );
+
+			return( -1 );
+		}
 	}
-	if( value == NULL )
+#endif /* defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI ) */
+
+	return( 1 );
+}
+
+/* Clears the readiness file descriptor, if any, after the queue became empty
+ * This function should only be called on the non-empty to empty transition
+ * with the condition mutex held
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_queue_clear_readiness(
+     libcthreads_internal_queue_t *internal_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_queue_clear_readiness";
+
+#if defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI )
+	uint64_t event_value  = 0;
+	ssize_t read_count    = 0;
+#endif
+
+	if( internal_queue == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value.",
+		 "%s: invalid queue.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcthreads_mutex_grab(
-	     internal_queue->condition_mutex,
-	     error ) != 1 )
+#if defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI )
+	if( internal_queue->readiness_file_descriptor != -1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab condition mutex.",
-		 function );
+		read_count = read(
+		              internal_queue->readiness_file_descriptor,
+		              &event_value,
+		              sizeof( uint64_t ) );
 
-		return( -1 );
-	}
-	while( internal_queue->number_of_values == 0 )
-	{
-		if( libcthreads_condition_wait(
-		     internal_queue->empty_condition,
-		     internal_queue->condition_mutex,
-		     error ) != 1 )
+		/* EAGAIN indicates the event counter was already cleared
+		 */
+		if( ( read_count != (ssize_t) sizeof( uint64_t ) )
+		 && ( errno != EAGAIN ) )
 		{
-			libcerror_error_set(
+			libcerror_system_set_error(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to wait for empty condition.",
+			 errno,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read readiness file descriptor.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
-	*value = internal_queue->values_array[ internal_queue->pop_index ];
+#endif /* defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI ) */
 
-	internal_queue->pop_index++;
+	return( 1 );
+}
 
-	if( internal_queue->pop_index >= internal_queue->allocated_number_of_values )
+/* Pops a value off the queue while the condition mutex is held by the caller
+ * If wait_while_empty is set the calling thread waits while the queue is empty
+ * If is_closed is set the calling thread does not wait once it is non-zero
+ * On error error_code contains the system error code, if available
+ * Returns 1 if successful, 0 if the queue is empty or -1 on error
+ */
+int libcthreads_internal_queue_pop_locked(
+     libcthreads_internal_queue_t *internal_queue,
+     intptr_t **value,
+     uint8_t wait_while_empty,
+     const uint8_t *is_closed,
+     uint32_t *error_code )
+{
+	while( internal_queue->number_of_values == 0 )
 	{
-		internal_queue->pop_index = 0;
-	}
+		if( ( wait_while_empty == 0 )
+		 || ( ( is_closed != NULL )
+		  &&  ( *is_closed != 0 ) ) )
+		{
+			return( 0 );
+		}
+		if( libcthreads_internal_condition_wait(
+		     (libcthreads_internal_condition_t *) internal_queue->empty_condition,
+		     (libcthreads_internal_mutex_t *) internal_queue->condition_mutex,
+		     error_code ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	*value = internal_queue->values_array[ internal_queue->pop_index ];
+
+	internal_queue->pop_index++;
+
+	if( internal_queue->pop_index >= internal_queue->allocated_number_of_values )
+	{
+		internal_queue->pop_index = 0;
+	}
 	internal_queue->number_of_values--;
 
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_DEQUEUE,
+	 internal_queue );
+
+	LIBCTHREADS_PROBE2(
+	 queue__pop,
+	 internal_queue,
+	 internal_queue->number_of_values );
+
+	if( internal_queue->number_of_values == 0 )
+	{
+		if( libcthreads_internal_queue_clear_readiness(
+		     internal_queue,
+		     NULL ) != 1 )
+		{
+			*error_code = (uint32_t) errno;
+
+			return( -1 );
+		}
+	}
 	/* The condition broadcast must be protected by the mutex for the WINAPI version
 	 */
-	if( libcthreads_condition_broadcast(
-	     internal_queue->full_condition,
+	if( libcthreads_internal_condition_broadcast(
+	     (libcthreads_internal_condition_t *) internal_queue->full_condition,
+	     error_code ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Pushes a value onto the queue while the condition mutex is held by the caller
+ * If wait_while_full is set the calling thread waits while the queue is full
+ * If is_closed is set no value is pushed once it is non-zero
+ * On error error_code contains the system error code, if available
+ * Returns 1 if successful, 0 if the queue is full or closed or -1 on error
+ */
+int libcthreads_internal_queue_push_locked(
+     libcthreads_internal_queue_t *internal_queue,
+     intptr_t *value,
+     uint8_t wait_while_full,
+     const uint8_t *is_closed,
+     uint32_t *error_code )
+{
+	while( internal_queue->number_of_values == internal_queue->allocated_number_of_values )
+	{
+		if( ( wait_while_full == 0 )
+		 || ( ( is_closed != NULL )
+		  &&  ( *is_closed != 0 ) ) )
+		{
+			return( 0 );
+		}
+		LIBCTHREADS_PROBE1(
+		 queue__full,
+		 internal_queue );
+
+		if( libcthreads_internal_condition_wait(
+		     (libcthreads_internal_condition_t *) internal_queue->full_condition,
+		     (libcthreads_internal_mutex_t *) internal_queue->condition_mutex,
+		     error_code ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	if( ( is_closed != NULL )
+	 && ( *is_closed != 0 ) )
+	{
+		return( 0 );
+	}
+	internal_queue->values_array[ internal_queue->push_index ] = value;
+
+	internal_queue->push_index++;
+
+	if( internal_queue->push_index >= internal_queue->allocated_number_of_values )
+	{
+		internal_queue->push_index = 0;
+	}
+	internal_queue->number_of_values++;
+
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_ENQUEUE,
+	 internal_queue );
+
+	LIBCTHREADS_PROBE2(
+	 queue__push,
+	 internal_queue,
+	 internal_queue->number_of_values );
+
+	if( internal_queue->number_of_values == 1 )
+	{
+		if( libcthreads_internal_queue_signal_readiness(
+		     internal_queue,
+		     NULL ) != 1 )
+		{
+			*error_code = (uint32_t) errno;
+
+			return( -1 );
+		}
+	}
+	/* The condition broadcast must be protected by the mutex for the WINAPI version
+	 */
+	if( libcthreads_internal_condition_broadcast(
+	     (libcthreads_internal_condition_t *) internal_queue->empty_condition,
+	     error_code ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tries to pop a value off the queue
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libcthreads_queue_try_pop(
+     libcthreads_queue_t *queue,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_queue_t *internal_queue = NULL;
+	static char *function                        = "libcthreads_queue_try_pop";
+	uint32_t error_code                          = 0;
+	int result                                   = 1;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	internal_queue = (libcthreads_internal_queue_t *) queue;
+
+	if( internal_queue->values_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid queue - missing values array.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_queue->condition_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to broadcast full condition.",
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_internal_queue_pop_locked(
+	          internal_queue,
+	          value,
+	          0,
+	          NULL,
+	          &error_code );
+
+	if( result == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop value off queue.",
 		 function );
 
 		goto on_error;
@@ -655,7 +1075,7 @@ int libcthreads_queue_pop(
 
 		return( -1 );
 	}
-	return( 1 );
+	return( result );
 
 on_error:
 	libcthreads_mutex_release(
@@ -665,6 +1085,120 @@ on_error:
 	return( -1 );
 }
 
+/* Pops a value off the queue without an error object
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_queue_pop(
+     libcthreads_internal_queue_t *internal_queue,
+     intptr_t **value )
+{
+	uint32_t error_code = 0;
+
+	if( libcthreads_internal_mutex_grab(
+	     (libcthreads_internal_mutex_t *) internal_queue->condition_mutex,
+	     &error_code ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libcthreads_internal_queue_pop_locked(
+	     internal_queue,
+	     value,
+	     1,
+	     NULL,
+	     &error_code ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcthreads_internal_mutex_release(
+	     (libcthreads_internal_mutex_t *) internal_queue->condition_mutex,
+	     &error_code ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_internal_mutex_release(
+	 (libcthreads_internal_mutex_t *) internal_queue->condition_mutex,
+	 &error_code );
+
+	return( -1 );
+}
+
+/* Pops a value off the queue
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_queue_pop(
+     libcthreads_queue_t *queue,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_queue_t *internal_queue = NULL;
+	static char *function                        = "libcthreads_queue_pop";
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	internal_queue = (libcthreads_internal_queue_t *) queue;
+
+	if( internal_queue->values_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid queue - missing values array.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_queue_pop(
+	     internal_queue,
+	     value ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop value off queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Pops a value off the queue without argument checks and error objects
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_queue_pop_fast(
+     libcthreads_queue_t *queue,
+     intptr_t **value )
+{
+	return( libcthreads_internal_queue_pop(
+	         (libcthreads_internal_queue_t *) queue,
+	         value ) );
+}
+
 /* Tries to push a value onto the queue
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -675,6 +1209,7 @@ int libcthreads_queue_try_push(
 {
 	libcthreads_internal_queue_t *internal_queue = NULL;
 	static char *function                        = "libcthreads_queue_try_push";
+	uint32_t error_code                          = 0;
 	int result                                   = 1;
 
 	if( queue == NULL )
@@ -701,17 +1236,1171 @@ int libcthreads_queue_try_push(
 
 		return( -1 );
 	}
-	if( value == NULL )
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_internal_queue_push_locked(
+	          internal_queue,
+	          value,
+	          0,
+	          NULL,
+	          &error_code );
+
+	if( result == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push value onto queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_queue->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Pushes a value onto the queue without an error object
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_queue_push(
+     libcthreads_internal_queue_t *internal_queue,
+     intptr_t *value )
+{
+	uint32_t error_code = 0;
+
+	if( libcthreads_internal_mutex_grab(
+	     (libcthreads_internal_mutex_t *) internal_queue->condition_mutex,
+	     &error_code ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libcthreads_internal_queue_push_locked(
+	     internal_queue,
+	     value,
+	     1,
+	     NULL,
+	     &error_code ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcthreads_internal_mutex_release(
+	     (libcthreads_internal_mutex_t *) internal_queue->condition_mutex,
+	     &error_code ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_internal_mutex_release(
+	 (libcthreads_internal_mutex_t *) internal_queue->condition_mutex,
+	 &error_code );
+
+	return( -1 );
+}
+
+/* Pushes a value onto the queue
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_queue_push(
+     libcthreads_queue_t *queue,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_queue_t *internal_queue = NULL;
+	static char *function                        = "libcthreads_queue_push";
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	internal_queue = (libcthreads_internal_queue_t *) queue;
+
+	if( internal_queue->values_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid queue - missing values array.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_queue_push(
+	     internal_queue,
+	     value ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push value onto queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Pushes a value onto the queue without argument checks and error objects
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_queue_push_fast(
+     libcthreads_queue_t *queue,
+     intptr_t *value )
+{
+	return( libcthreads_internal_queue_push(
+	         (libcthreads_internal_queue_t *) queue,
+	         value ) );
+}
+
+/* Pushes a value onto the queue in sorted order
+ *
+ * Uses the value_compare_function to determine the similarity of the values
+ * The value_compare_function should return LIBCTHREADS_COMPARE_LESS,
+ * LIBCTHREADS_COMPARE_EQUAL, LIBCTHREADS_COMPARE_GREATER if successful or -1 on error
+ *
+ * Returns 1 if successful, 0 if the value already exists or -1 on error
+ */
+int libcthreads_queue_push_sorted(
+     libcthreads_queue_t *queue,
+     intptr_t *value,
+     int (*value_compare_function)(
+            intptr_t *first_value,
+            intptr_t *second_value,
+            libcerror_error_t **error ),
+     uint8_t sort_flags,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_queue_t *internal_queue = NULL;
+	static char *function                        = "libcthreads_queue_push_sorted";
+	int compare_result                           = 0;
+	int pop_index                                = 0;
+	int previous_push_index                      = 0;
+	int push_index                               = 0;
+	int result                                   = 1;
+	int value_index                              = 0;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	internal_queue = (libcthreads_internal_queue_t *) queue;
+
+	if( internal_queue->values_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid queue - missing values array.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_compare_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value compare function.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sort_flags & ~( LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported sort flags: 0x%02" PRIx8 ".",
+		 function,
+		 sort_flags );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( internal_queue->number_of_values == internal_queue->allocated_number_of_values )
+	{
+		LIBCTHREADS_PROBE1(
+		 queue__full,
+		 internal_queue );
+
+		if( libcthreads_condition_wait(
+		     internal_queue->full_condition,
+		     internal_queue->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for full condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	pop_index = internal_queue->pop_index;
+
+	for( value_index = 0;
+	     value_index < internal_queue->number_of_values;
+	     value_index++ )
+	{
+		compare_result = value_compare_function(
+		                  value,
+		                  internal_queue->values_array[ pop_index ],
+		                  error );
+
+		if( compare_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to compare value: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		else if( compare_result == LIBCTHREADS_COMPARE_EQUAL )
+		{
+			if( ( sort_flags & LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES ) != 0 )
+			{
+				result = 0;
+
+				break;
+			}
+		}
+		else if( compare_result == LIBCTHREADS_COMPARE_LESS )
+		{
+			result = 1;
+
+			break;
+		}
+		else if( compare_result != LIBCTHREADS_COMPARE_GREATER )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported value compare function return value: %d.",
+			 function,
+			 compare_result );
+
+			goto on_error;
+		}
+		pop_index++;
+
+		if( pop_index >= internal_queue->allocated_number_of_values )
+		{
+			pop_index = 0;
+		}
+	}
+	if( result != 0 )
+	{
+		push_index = internal_queue->push_index;
+
+		if( compare_result == LIBCTHREADS_COMPARE_LESS )
+		{
+			previous_push_index = push_index - 1;
+
+			while( push_index != pop_index )
+			{
+				if( previous_push_index < 0 )
+				{
+					previous_push_index = internal_queue->allocated_number_of_values - 1;
+				}
+				internal_queue->values_array[ push_index ] = internal_queue->values_array[ previous_push_index ];
+
+				push_index = previous_push_index;
+
+				previous_push_index--;
+			}
+		}
+		internal_queue->values_array[ push_index ] = value;
+
+		internal_queue->push_index++;
+
+		if( internal_queue->push_index >= internal_queue->allocated_number_of_values )
+		{
+			internal_queue->push_index = 0;
+		}
+		internal_queue->number_of_values++;
+
+		libcthreads_tracer_record_event(
+		 LIBCTHREADS_TRACER_EVENT_ENQUEUE,
+		 internal_queue );
+
+		LIBCTHREADS_PROBE2(
+		 queue__push,
+		 internal_queue,
+		 internal_queue->number_of_values );
+
+		if( internal_queue->number_of_values == 1 )
+		{
+			if( libcthreads_internal_queue_signal_readiness(
+			     internal_queue,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal readiness.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* The condition broadcast must be protected by the mutex for the WINAPI version
+		 */
+		if( libcthreads_condition_broadcast(
+		     internal_queue->empty_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast empty condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_queue->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Copies value data into the next free value slot of the queue
+ * The condition mutex must be held and the queue must not be full
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_queue_push_value_data(
+     libcthreads_internal_queue_t *internal_queue,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t *value_slot   = NULL;
+	static char *function = "libcthreads_internal_queue_push_value_data";
+
+	if( internal_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	value_slot = &( internal_queue->value_slots_data[ internal_queue->push_index * internal_queue->value_slot_size ] );
+
+	if( memory_copy(
+	     value_slot,
+	     data,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy value data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < internal_queue->value_size )
+	{
+		if( memory_set(
+		     &( value_slot[ data_size ] ),
+		     0,
+		     internal_queue->value_size - data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear value slot.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_queue->push_index++;
+
+	if( internal_queue->push_index >= internal_queue->allocated_number_of_values )
+	{
+		internal_queue->push_index = 0;
+	}
+	internal_queue->number_of_values++;
+
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_ENQUEUE,
+	 internal_queue );
+
+	LIBCTHREADS_PROBE2(
+	 queue__push,
+	 internal_queue,
+	 internal_queue->number_of_values );
+
+	if( internal_queue->number_of_values == 1 )
+	{
+		if( libcthreads_internal_queue_signal_readiness(
+		     internal_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal readiness.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The condition broadcast must be protected by the mutex for the WINAPI version
+	 */
+	if( libcthreads_condition_broadcast(
+	     internal_queue->empty_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast empty condition.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Pops the first value slot off the queue
+ * The value slot remains in use until it is released
+ * The condition mutex must be held and the queue must not be empty
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_queue_pop_value_slot(
+     libcthreads_internal_queue_t *internal_queue,
+     int *value_slot_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_queue_pop_value_slot";
+
+	if( internal_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_slot_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value slot index.",
+		 function );
+
+		return( -1 );
+	}
+	*value_slot_index = internal_queue->pop_index;
+
+	internal_queue->value_slots_in_use[ internal_queue->pop_index ] = 1;
+
+	internal_queue->pop_index++;
+
+	if( internal_queue->pop_index >= internal_queue->allocated_number_of_values )
+	{
+		internal_queue->pop_index = 0;
+	}
+	internal_queue->number_of_values--;
+	internal_queue->number_of_popped_values++;
+
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_DEQUEUE,
+	 internal_queue );
+
+	LIBCTHREADS_PROBE2(
+	 queue__pop,
+	 internal_queue,
+	 internal_queue->number_of_values );
+
+	if( internal_queue->number_of_values == 0 )
+	{
+		if( libcthreads_internal_queue_clear_readiness(
+		     internal_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to clear readiness.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Releases a popped value slot
+ * Value slots are reused in order, hence the slot only becomes available for
+ * a push when all value slots that were popped before it have been released
+ * The condition mutex must be held
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_queue_release_value_slot(
+     libcthreads_internal_queue_t *internal_queue,
+     int value_slot_index,
+     libcerror_error_t **error )
+{
+	static char *function        = "libcthreads_internal_queue_release_value_slot";
+	int number_of_released_slots = 0;
+
+	if( internal_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_slot_index < 0 )
+	 || ( value_slot_index >= internal_queue->allocated_number_of_values ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid value slot index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_queue->value_slots_in_use[ value_slot_index ] = 0;
+
+	while( ( internal_queue->number_of_popped_values > 0 )
+	    && ( internal_queue->value_slots_in_use[ internal_queue->release_index ] == 0 ) )
+	{
+		internal_queue->release_index++;
+
+		if( internal_queue->release_index >= internal_queue->allocated_number_of_values )
+		{
+			internal_queue->release_index = 0;
+		}
+		internal_queue->number_of_popped_values--;
+
+		number_of_released_slots++;
+	}
+	if( number_of_released_slots > 0 )
+	{
+		/* The condition broadcast must be protected by the mutex for the WINAPI version
+		 */
+		if( libcthreads_condition_broadcast(
+		     internal_queue->full_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast full condition.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Tries to copy value data onto the queue
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libcthreads_queue_try_push_value_data(
+     libcthreads_queue_t *queue,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_queue_t *internal_queue = NULL;
+	static char *function                        = "libcthreads_queue_try_push_value_data";
+	int result                                   = 1;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	internal_queue = (libcthreads_internal_queue_t *) queue;
+
+	if( internal_queue->value_slots_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid queue - missing value slots data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > internal_queue->value_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_queue->number_of_values + internal_queue->number_of_popped_values ) == internal_queue->allocated_number_of_values )
+	{
+		result = 0;
+	}
+	else if( libcthreads_internal_queue_push_value_data(
+	          internal_queue,
+	          data,
+	          data_size,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push value data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_queue->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Copies value data onto the queue
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_queue_push_value_data(
+     libcthreads_queue_t *queue,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_queue_t *internal_queue = NULL;
+	static char *function                        = "libcthreads_queue_push_value_data";
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	internal_queue = (libcthreads_internal_queue_t *) queue;
+
+	if( internal_queue->value_slots_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid queue - missing value slots data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > internal_queue->value_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( internal_queue->number_of_values + internal_queue->number_of_popped_values ) == internal_queue->allocated_number_of_values )
+	{
+		LIBCTHREADS_PROBE1(
+		 queue__full,
+		 internal_queue );
+
+		if( libcthreads_condition_wait(
+		     internal_queue->full_condition,
+		     internal_queue->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for full condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_internal_queue_push_value_data(
+	     internal_queue,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push value data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_queue->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Tries to copy value data off the queue
+ * Copies up to data_size bytes of the value data
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libcthreads_queue_try_pop_value_data(
+     libcthreads_queue_t *queue,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_queue_t *internal_queue = NULL;
+	static char *function                        = "libcthreads_queue_try_pop_value_data";
+	int result                                   = 1;
+	int value_slot_index                         = 0;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	internal_queue = (libcthreads_internal_queue_t *) queue;
+
+	if( internal_queue->value_slots_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid queue - missing value slots data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > internal_queue->value_size )
+	{
+		data_size = internal_queue->value_size;
+	}
+	if( libcthreads_mutex_grab(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_queue->number_of_values == 0 )
+	{
+		result = 0;
+	}
+	else
+	{
+		if( libcthreads_internal_queue_pop_value_slot(
+		     internal_queue,
+		     &value_slot_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to pop value slot.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     data,
+		     &( internal_queue->value_slots_data[ value_slot_index * internal_queue->value_slot_size ] ),
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy value data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_internal_queue_release_value_slot(
+		     internal_queue,
+		     value_slot_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to release value slot.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_queue->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Copies value data off the queue
+ * Copies up to data_size bytes of the value data
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_queue_pop_value_data(
+     libcthreads_queue_t *queue,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_queue_t *internal_queue = NULL;
+	static char *function                        = "libcthreads_queue_pop_value_data";
+	int value_slot_index                         = 0;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	internal_queue = (libcthreads_internal_queue_t *) queue;
+
+	if( internal_queue->value_slots_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid queue - missing value slots data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
+	if( data_size > internal_queue->value_size )
+	{
+		data_size = internal_queue->value_size;
+	}
 	if( libcthreads_mutex_grab(
 	     internal_queue->condition_mutex,
 	     error ) != 1 )
@@ -725,38 +2414,65 @@ int libcthreads_queue_try_push(
 
 		return( -1 );
 	}
-	if( internal_queue->number_of_values == internal_queue->allocated_number_of_values )
-	{
-		result = 0;
-	}
-	else
+	while( internal_queue->number_of_values == 0 )
 	{
-		internal_queue->values_array[ internal_queue->push_index ] = value;
-
-		internal_queue->push_index++;
-
-		if( internal_queue->push_index >= internal_queue->allocated_number_of_values )
-		{
-			internal_queue->push_index = 0;
-		}
-		internal_queue->number_of_values++;
-
-		/* The condition broadcast must be protected by the mutex for the WINAPI version
-		 */
-		if( libcthreads_condition_broadcast(
+		if( libcthreads_condition_wait(
 		     internal_queue->empty_condition,
+		     internal_queue->condition_mutex,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to broadcast empty condition.",
+			 "%s: unable to wait for empty condition.",
 			 function );
 
 			goto on_error;
 		}
 	}
+	if( libcthreads_internal_queue_pop_value_slot(
+	     internal_queue,
+	     &value_slot_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop value slot.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     data,
+	     &( internal_queue->value_slots_data[ value_slot_index * internal_queue->value_slot_size ] ),
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy value data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_internal_queue_release_value_slot(
+	     internal_queue,
+	     value_slot_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to release value slot.",
+		 function );
+
+		goto on_error;
+	}
 	if( libcthreads_mutex_release(
 	     internal_queue->condition_mutex,
 	     error ) != 1 )
@@ -770,7 +2486,7 @@ int libcthreads_queue_try_push(
 
 		return( -1 );
 	}
-	return( result );
+	return( 1 );
 
 on_error:
 	libcthreads_mutex_release(
@@ -780,16 +2496,19 @@ on_error:
 	return( -1 );
 }
 
-/* Pushes a value onto the queue
+/* Pops a value off the queue without copying the value data
+ * The data references the value slot inside the queue, which remains valid
+ * and is not reused until it is released with libcthreads_queue_release_value_view
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_queue_push(
+int libcthreads_queue_pop_value_view(
      libcthreads_queue_t *queue,
-     intptr_t *value,
+     const uint8_t **data,
      libcerror_error_t **error )
 {
 	libcthreads_internal_queue_t *internal_queue = NULL;
-	static char *function                        = "libcthreads_queue_push";
+	static char *function                        = "libcthreads_queue_pop_value_view";
+	int value_slot_index                         = 0;
 
 	if( queue == NULL )
 	{
@@ -804,24 +2523,24 @@ int libcthreads_queue_push(
 	}
 	internal_queue = (libcthreads_internal_queue_t *) queue;
 
-	if( internal_queue->values_array == NULL )
+	if( internal_queue->value_slots_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid queue - missing values array.",
+		 "%s: invalid queue - missing value slots data.",
 		 function );
 
 		return( -1 );
 	}
-	if( value == NULL )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value.",
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
@@ -839,10 +2558,10 @@ int libcthreads_queue_push(
 
 		return( -1 );
 	}
-	while( internal_queue->number_of_values == internal_queue->allocated_number_of_values )
+	while( internal_queue->number_of_values == 0 )
 	{
 		if( libcthreads_condition_wait(
-		     internal_queue->full_condition,
+		     internal_queue->empty_condition,
 		     internal_queue->condition_mutex,
 		     error ) != 1 )
 		{
@@ -850,37 +2569,28 @@ int libcthreads_queue_push(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to wait for full condition.",
+			 "%s: unable to wait for empty condition.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	internal_queue->values_array[ internal_queue->push_index ] = value;
-
-	internal_queue->push_index++;
-
-	if( internal_queue->push_index >= internal_queue->allocated_number_of_values )
-	{
-		internal_queue->push_index = 0;
-	}
-	internal_queue->number_of_values++;
-
-	/* The condition broadcast must be protected by the mutex for the WINAPI version
-	 */
-	if( libcthreads_condition_broadcast(
-	     internal_queue->empty_condition,
+	if( libcthreads_internal_queue_pop_value_slot(
+	     internal_queue,
+	     &value_slot_index,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to broadcast empty condition.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop value slot.",
 		 function );
 
 		goto on_error;
 	}
+	*data = &( internal_queue->value_slots_data[ value_slot_index * internal_queue->value_slot_size ] );
+
 	if( libcthreads_mutex_release(
 	     internal_queue->condition_mutex,
 	     error ) != 1 )
@@ -904,32 +2614,18 @@ on_error:
 	return( -1 );
 }
 
-/* Pushes a value onto the queue in sorted order
- *
- * Uses the value_compare_function to determine the similarity of the values
- * The value_compare_function should return LIBCTHREADS_COMPARE_LESS,
- * LIBCTHREADS_COMPARE_EQUAL, LIBCTHREADS_COMPARE_GREATER if successful or -1 on error
- *
- * Returns 1 if successful, 0 if the value already exists or -1 on error
+/* Releases a value view previously returned by libcthreads_queue_pop_value_view
+ * Returns 1 if successful or -1 on error
  */
-int libcthreads_queue_push_sorted(
+int libcthreads_queue_release_value_view(
      libcthreads_queue_t *queue,
-     intptr_t *value,
-     int (*value_compare_function)(
-            intptr_t *first_value,
-            intptr_t *second_value,
-            libcerror_error_t **error ),
-     uint8_t sort_flags,
+     const uint8_t *data,
      libcerror_error_t **error )
 {
 	libcthreads_internal_queue_t *internal_queue = NULL;
-	static char *function                        = "libcthreads_queue_push_sorted";
-	int compare_result                           = 0;
-	int pop_index                                = 0;
-	int previous_push_index                      = 0;
-	int push_index                               = 0;
-	int result                                   = 1;
-	int value_index                              = 0;
+	static char *function                        = "libcthreads_queue_release_value_view";
+	size_t data_offset                           = 0;
+	int value_slot_index                         = 0;
 
 	if( queue == NULL )
 	{
@@ -944,51 +2640,55 @@ int libcthreads_queue_push_sorted(
 	}
 	internal_queue = (libcthreads_internal_queue_t *) queue;
 
-	if( internal_queue->values_array == NULL )
+	if( internal_queue->value_slots_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid queue - missing values array.",
+		 "%s: invalid queue - missing value slots data.",
 		 function );
 
 		return( -1 );
 	}
-	if( value == NULL )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value.",
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
 	}
-	if( value_compare_function == NULL )
+	if( ( data < internal_queue->value_slots_data )
+	 || ( data >= &( internal_queue->value_slots_data[ internal_queue->allocated_number_of_values * internal_queue->value_slot_size ] ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value compare function.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( sort_flags & ~( LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES ) ) != 0 )
+	data_offset = (size_t) ( data - internal_queue->value_slots_data );
+
+	if( ( data_offset % internal_queue->value_slot_size ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported sort flags: 0x%02" PRIx8 ".",
-		 function,
-		 sort_flags );
+		 "%s: invalid data - not aligned with value slot.",
+		 function );
 
 		return( -1 );
 	}
+	value_slot_index = (int) ( data_offset / internal_queue->value_slot_size );
+
 	if( libcthreads_mutex_grab(
 	     internal_queue->condition_mutex,
 	     error ) != 1 )
@@ -1002,126 +2702,31 @@ int libcthreads_queue_push_sorted(
 
 		return( -1 );
 	}
-	while( internal_queue->number_of_values == internal_queue->allocated_number_of_values )
-	{
-		if( libcthreads_condition_wait(
-		     internal_queue->full_condition,
-		     internal_queue->condition_mutex,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to wait for full condition.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	pop_index = internal_queue->pop_index;
-
-	for( value_index = 0;
-	     value_index < internal_queue->number_of_values;
-	     value_index++ )
+	if( internal_queue->value_slots_in_use[ value_slot_index ] == 0 )
 	{
-		compare_result = value_compare_function(
-		                  value,
-		                  internal_queue->values_array[ pop_index ],
-		                  error );
-
-		if( compare_result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to compare value: %d.",
-			 function,
-			 value_index );
-
-			goto on_error;
-		}
-		else if( compare_result == LIBCTHREADS_COMPARE_EQUAL )
-		{
-			if( ( sort_flags & LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES ) != 0 )
-			{
-				result = 0;
-
-				break;
-			}
-		}
-		else if( compare_result == LIBCTHREADS_COMPARE_LESS )
-		{
-			result = 1;
-
-			break;
-		}
-		else if( compare_result != LIBCTHREADS_COMPARE_GREATER )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported value compare function return value: %d.",
-			 function,
-			 compare_result );
-
-			goto on_error;
-		}
-		pop_index++;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid value slot: %d - not in use.",
+		 function,
+		 value_slot_index );
 
-		if( pop_index >= internal_queue->allocated_number_of_values )
-		{
-			pop_index = 0;
-		}
+		goto on_error;
 	}
-	if( result != 0 )
+	if( libcthreads_internal_queue_release_value_slot(
+	     internal_queue,
+	     value_slot_index,
+	     error ) != 1 )
 	{
-		push_index = internal_queue->push_index;
-
-		if( compare_result == LIBCTHREADS_COMPARE_LESS )
-		{
-			previous_push_index = push_index - 1;
-
-			while( push_index != pop_index )
-			{
-				if( previous_push_index < 0 )
-				{
-					previous_push_index = internal_queue->allocated_number_of_values - 1;
-				}
-				internal_queue->values_array[ push_index ] = internal_queue->values_array[ previous_push_index ];
-
-				push_index = previous_push_index;
-
-				previous_push_index--;
-			}
-		}
-		internal_queue->values_array[ push_index ] = value;
-
-		internal_queue->push_index++;
-
-		if( internal_queue->push_index >= internal_queue->allocated_number_of_values )
-		{
-			internal_queue->push_index = 0;
-		}
-		internal_queue->number_of_values++;
-
-		/* The condition broadcast must be protected by the mutex for the WINAPI version
-		 */
-		if( libcthreads_condition_broadcast(
-		     internal_queue->empty_condition,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to broadcast empty condition.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to release value slot.",
+		 function );
 
-			goto on_error;
-		}
+		goto on_error;
 	}
 	if( libcthreads_mutex_release(
 	     internal_queue->condition_mutex,
@@ -1136,7 +2741,7 @@ int libcthreads_queue_push_sorted(
 
 		return( -1 );
 	}
-	return( result );
+	return( 1 );
 
 on_error:
 	libcthreads_mutex_release(
@@ -59,6 +59,35 @@ struct libcthreads_internal_queue
 	 */
 	intptr_t **values_array;
 
+	/* The value size, 0 if the queue stores value pointers
+	 */
+	size_t value_size;
+
+	/* The value slot size, the value size rounded up to the cache line size
+	 */
+	size_t value_slot_size;
+
+	/* The values data
+	 */
+	uint8_t *values_data;
+
+	/* The value slots data, the cache line aligned start of the values data
+	 */
+	uint8_t *value_slots_data;
+
+	/* The value slots in use array
+	 * marks popped value slots that are still referenced by a view
+	 */
+	uint8_t *value_slots_in_use;
+
+	/* The (current) release index
+	 */
+	int release_index;
+
+	/* The number of popped values that have not been released
+	 */
+	int number_of_popped_values;
+
 	/* The condition mutex
 	 */
 	libcthreads_mutex_t *condition_mutex;
@@ -70,6 +99,10 @@ struct libcthreads_internal_queue
 	/* The queue full condition
 	 */
 	libcthreads_condition_t *full_condition;
+
+	/* The readiness file descriptor
+	 */
+	int readiness_file_descriptor;
 };
 
 LIBCTHREADS_EXTERN \
@@ -78,6 +111,13 @@ int libcthreads_queue_initialize(
      int maximum_number_of_values,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_queue_initialize_with_value_size(
+     libcthreads_queue_t **queue,
+     int maximum_number_of_values,
+     size_t value_size,
+     libcerror_error_t **error );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_queue_free(
      libcthreads_queue_t **queue,
@@ -91,30 +131,76 @@ int libcthreads_queue_empty(
      libcthreads_queue_t *queue,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_queue_get_readiness_file_descriptor(
+     libcthreads_queue_t *queue,
+     int *file_descriptor,
+     libcerror_error_t **error );
+
+int libcthreads_internal_queue_signal_readiness(
+     libcthreads_internal_queue_t *internal_queue,
+     libcerror_error_t **error );
+
+int libcthreads_internal_queue_clear_readiness(
+     libcthreads_internal_queue_t *internal_queue,
+     libcerror_error_t **error );
+
+int libcthreads_internal_queue_pop_locked(
+     libcthreads_internal_queue_t *internal_queue,
+     intptr_t **value,
+     uint8_t wait_while_empty,
+     const uint8_t *is_closed,
+     uint32_t *error_code );
+
+int libcthreads_internal_queue_push_locked(
+     libcthreads_internal_queue_t *internal_queue,
+     intptr_t *value,
+     uint8_t wait_while_full,
+     const uint8_t *is_closed,
+     uint32_t *error_code );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_queue_try_pop(
      libcthreads_queue_t *queue,
      intptr_t **value,
      libcerror_error_t **error );
 
+int libcthreads_internal_queue_pop(
+     libcthreads_internal_queue_t *internal_queue,
+     intptr_t **value );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_queue_pop(
      libcthreads_queue_t *queue,
      intptr_t **value,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_queue_pop_fast(
+     libcthreads_queue_t *queue,
+     intptr_t **value );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_queue_try_push(
      libcthreads_queue_t *queue,
      intptr_t *value,
      libcerror_error_t **error );
 
+int libcthreads_internal_queue_push(
+     libcthreads_internal_queue_t *internal_queue,
+     intptr_t *value );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_queue_push(
      libcthreads_queue_t *queue,
      intptr_t *value,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_queue_push_fast(
+     libcthreads_queue_t *queue,
+     intptr_t *value );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_queue_push_sorted(
      libcthreads_queue_t *queue,
@@ -126,6 +212,62 @@ int libcthreads_queue_push_sorted(
      uint8_t sort_flags,
      libcerror_error_t **error );
 
+int libcthreads_internal_queue_push_value_data(
+     libcthreads_internal_queue_t *internal_queue,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libcthreads_internal_queue_pop_value_slot(
+     libcthreads_internal_queue_t *internal_queue,
+     int *value_slot_index,
+     libcerror_error_t **error );
+
+int libcthreads_internal_queue_release_value_slot(
+     libcthreads_internal_queue_t *internal_queue,
+     int value_slot_index,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_queue_try_push_value_data(
+     libcthreads_queue_t *queue,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_queue_push_value_data(
+     libcthreads_queue_t *queue,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_queue_try_pop_value_data(
+     libcthreads_queue_t *queue,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_queue_pop_value_data(
+     libcthreads_queue_t *queue,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_queue_pop_value_view(
+     libcthreads_queue_t *queue,
+     const uint8_t **data,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_queue_release_value_view(
+     libcthreads_queue_t *queue,
+     const uint8_t *data,
+     libcerror_error_t **error );
+
 #endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 #if defined( __cplusplus )
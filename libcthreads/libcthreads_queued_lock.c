@@ -0,0 +1,647 @@
+/*
+ * Queued lock functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <sched.h>
+#endif
+
+#include "libcthreads_atomic.h"
+#include "libcthreads_definitions.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_lock_validator.h"
+#include "libcthreads_probes.h"
+#include "libcthreads_queued_lock.h"
+#include "libcthreads_stack.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+#define libcthreads_queued_lock_exchange_tail_node( internal_queued_lock, node ) \
+	(libcthreads_queued_lock_node_t *) libcthreads_internal_atomic_exchange_pointer( &( ( internal_queued_lock )->tail_node ), node, LIBCTHREADS_MEMORY_ORDER_ACQUIRE_RELEASE )
+
+#define libcthreads_queued_lock_node_get_is_locked( node ) \
+	libcthreads_internal_atomic_load_32( &( ( node )->is_locked ), LIBCTHREADS_MEMORY_ORDER_ACQUIRE )
+
+#define libcthreads_queued_lock_node_set_is_locked( node, value ) \
+	libcthreads_internal_atomic_store_32( &( ( node )->is_locked ), value, LIBCTHREADS_MEMORY_ORDER_RELEASE )
+
+#define libcthreads_queued_lock_cpu_relax() \
+	libcthreads_internal_atomic_cpu_relax()
+
+#else
+#define libcthreads_queued_lock_exchange_tail_node( internal_queued_lock, node ) \
+	(libcthreads_queued_lock_node_t *) libcthreads_atomic_exchange_pointer( (intptr_t * volatile *) &( ( internal_queued_lock )->tail_node ), (intptr_t *) ( node ), LIBCTHREADS_MEMORY_ORDER_ACQUIRE_RELEASE )
+
+#define libcthreads_queued_lock_node_get_is_locked( node ) \
+	libcthreads_atomic_load_32( &( ( node )->is_locked ), LIBCTHREADS_MEMORY_ORDER_ACQUIRE )
+
+#define libcthreads_queued_lock_node_set_is_locked( node, value ) \
+	libcthreads_atomic_store_32( &( ( node )->is_locked ), value, LIBCTHREADS_MEMORY_ORDER_RELEASE )
+
+#define libcthreads_queued_lock_cpu_relax() \
+	libcthreads_atomic_cpu_relax()
+
+#endif
+
+#if defined( WINAPI )
+#define libcthreads_queued_lock_yield() \
+	Sleep( 0 )
+
+#else
+#define libcthreads_queued_lock_yield() \
+	sched_yield()
+
+#endif
+
+/* Creates a node
+ * Make sure the value node is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_queued_lock_node_initialize(
+     libcthreads_queued_lock_node_t **node,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_queued_lock_node_initialize";
+	uint8_t *node_data    = NULL;
+	size_t node_data_size = 0;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid node value already set.",
+		 function );
+
+		return( -1 );
+	}
+	/* The node is aligned on a cache line boundary, so that every waiting thread
+	 * spins on a separate cache line
+	 */
+	node_data_size = ( 2 * LIBCTHREADS_CACHE_LINE_SIZE ) - 1;
+
+	node_data = (uint8_t *) memory_allocate(
+	                         node_data_size );
+
+	if( node_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create node data.",
+		 function );
+
+		return( -1 );
+	}
+	*node = (libcthreads_queued_lock_node_t *) ( ( (intptr_t) node_data + LIBCTHREADS_CACHE_LINE_SIZE - 1 ) & ~( (intptr_t) LIBCTHREADS_CACHE_LINE_SIZE - 1 ) );
+
+	if( memory_set(
+	     *node,
+	     0,
+	     sizeof( libcthreads_queued_lock_node_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear node.",
+		 function );
+
+		*node = NULL;
+
+		memory_free(
+		 node_data );
+
+		return( -1 );
+	}
+	( *node )->node_data = node_data;
+
+	return( 1 );
+}
+
+/* Frees a node
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_queued_lock_node_free(
+     libcthreads_queued_lock_node_t **node,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_queued_lock_node_free";
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node != NULL )
+	{
+		memory_free(
+		 ( *node )->node_data );
+
+		*node = NULL;
+	}
+	return( 1 );
+}
+
+/* Creates a queued lock
+ * Make sure the value queued_lock is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_queued_lock_initialize(
+     libcthreads_queued_lock_t **queued_lock,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_queued_lock_t *internal_queued_lock = NULL;
+	static char *function                                    = "libcthreads_queued_lock_initialize";
+
+	if( queued_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queued lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( *queued_lock != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid queued lock value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_queued_lock = memory_allocate_structure(
+	                        libcthreads_internal_queued_lock_t );
+
+	if( internal_queued_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create queued lock.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_queued_lock,
+	     0,
+	     sizeof( libcthreads_internal_queued_lock_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear queued lock.",
+		 function );
+
+		memory_free(
+		 internal_queued_lock );
+
+		return( -1 );
+	}
+	if( libcthreads_stack_initialize(
+	     &( internal_queued_lock->free_nodes ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create free nodes stack.",
+		 function );
+
+		goto on_error;
+	}
+	/* The initial tail node is not locked, so that the first thread
+	 * that grabs the lock does not have to wait
+	 */
+	if( libcthreads_internal_queued_lock_node_initialize(
+	     (libcthreads_queued_lock_node_t **) &( internal_queued_lock->tail_node ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create tail node.",
+		 function );
+
+		goto on_error;
+	}
+	*queued_lock = (libcthreads_queued_lock_t *) internal_queued_lock;
+
+	return( 1 );
+
+on_error:
+	if( internal_queued_lock != NULL )
+	{
+		if( internal_queued_lock->free_nodes != NULL )
+		{
+			libcthreads_stack_free(
+			 &( internal_queued_lock->free_nodes ),
+			 NULL );
+		}
+		memory_free(
+		 internal_queued_lock );
+	}
+	return( -1 );
+}
+
+/* Frees a queued lock
+ * The queued lock must not be held or waited for by any thread
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_queued_lock_free(
+     libcthreads_queued_lock_t **queued_lock,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_queued_lock_t *internal_queued_lock = NULL;
+	libcthreads_queued_lock_node_t *node                     = NULL;
+	libcthreads_stack_node_t *stack_node                     = NULL;
+	static char *function                                    = "libcthreads_queued_lock_free";
+	int result                                               = 1;
+
+	if( queued_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queued lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( *queued_lock != NULL )
+	{
+		internal_queued_lock = (libcthreads_internal_queued_lock_t *) *queued_lock;
+		*queued_lock         = NULL;
+
+		if( libcthreads_stack_pop_all(
+		     internal_queued_lock->free_nodes,
+		     &stack_node,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to pop free nodes.",
+			 function );
+
+			result = -1;
+		}
+		while( stack_node != NULL )
+		{
+			node       = (libcthreads_queued_lock_node_t *) stack_node;
+			stack_node = stack_node->next_node;
+
+			if( libcthreads_internal_queued_lock_node_free(
+			     &node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free node.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_internal_queued_lock_node_free(
+		     (libcthreads_queued_lock_node_t **) &( internal_queued_lock->tail_node ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free tail node.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_stack_free(
+		     &( internal_queued_lock->free_nodes ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free free nodes stack.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+		libcthreads_lock_validator_remove_lock(
+		 internal_queued_lock );
+#endif
+		memory_free(
+		 internal_queued_lock );
+	}
+	return( result );
+}
+
+/* Retrieves a node that is not enqueued
+ * A new node is created if there is no free node
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_queued_lock_get_free_node(
+     libcthreads_internal_queued_lock_t *internal_queued_lock,
+     libcthreads_queued_lock_node_t **node,
+     libcerror_error_t **error )
+{
+	libcthreads_stack_node_t *stack_node = NULL;
+	static char *function                = "libcthreads_internal_queued_lock_get_free_node";
+	int result                           = 0;
+
+	if( internal_queued_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queued lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_stack_pop(
+	          internal_queued_lock->free_nodes,
+	          &stack_node,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to pop free node.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		*node = (libcthreads_queued_lock_node_t *) stack_node;
+
+		return( 1 );
+	}
+	*node = NULL;
+
+	if( libcthreads_internal_queued_lock_node_initialize(
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create node.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Grabs a queued lock
+ * The threads that wait for the lock are queued and grab the lock in order
+ * of arrival, every thread waits on the node of its predecessor
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_queued_lock_grab(
+     libcthreads_queued_lock_t *queued_lock,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_queued_lock_t *internal_queued_lock = NULL;
+	libcthreads_queued_lock_node_t *node                     = NULL;
+	libcthreads_queued_lock_node_t *predecessor_node         = NULL;
+	static char *function                                    = "libcthreads_queued_lock_grab";
+	int spin_count                                           = 0;
+
+	if( queued_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queued lock.",
+		 function );
+
+		return( -1 );
+	}
+	internal_queued_lock = (libcthreads_internal_queued_lock_t *) queued_lock;
+
+	if( libcthreads_internal_queued_lock_get_free_node(
+	     internal_queued_lock,
+	     &node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve free node.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_check_acquire(
+	 internal_queued_lock,
+	 0 );
+#endif
+	node->is_locked = 1;
+
+	predecessor_node = libcthreads_queued_lock_exchange_tail_node(
+	                    internal_queued_lock,
+	                    node );
+
+	if( libcthreads_queued_lock_node_get_is_locked(
+	     predecessor_node ) != 0 )
+	{
+		LIBCTHREADS_PROBE1(
+		 mutex__contended,
+		 internal_queued_lock );
+
+		do
+		{
+			/* Spin for a while on the node of the predecessor,
+			 * which is only read by this thread, before yielding the CPU
+			 */
+			if( spin_count < LIBCTHREADS_QUEUED_LOCK_MAXIMUM_SPIN_COUNT )
+			{
+				libcthreads_queued_lock_cpu_relax();
+
+				spin_count++;
+			}
+			else
+			{
+				libcthreads_queued_lock_yield();
+			}
+		}
+		while( libcthreads_queued_lock_node_get_is_locked(
+		        predecessor_node ) != 0 );
+	}
+	internal_queued_lock->owner_node             = node;
+	internal_queued_lock->owner_predecessor_node = predecessor_node;
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_acquired(
+	 internal_queued_lock );
+#endif
+	LIBCTHREADS_PROBE1(
+	 mutex__acquire,
+	 internal_queued_lock );
+
+	return( 1 );
+}
+
+/* Releases a queued lock
+ * The lock is handed to the thread that has waited the longest
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_queued_lock_release(
+     libcthreads_queued_lock_t *queued_lock,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_queued_lock_t *internal_queued_lock = NULL;
+	libcthreads_queued_lock_node_t *node                     = NULL;
+	libcthreads_queued_lock_node_t *predecessor_node         = NULL;
+	static char *function                                    = "libcthreads_queued_lock_release";
+
+	if( queued_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queued lock.",
+		 function );
+
+		return( -1 );
+	}
+	internal_queued_lock = (libcthreads_internal_queued_lock_t *) queued_lock;
+
+	if( internal_queued_lock->owner_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid queued lock - missing owner node.",
+		 function );
+
+		return( -1 );
+	}
+	node             = internal_queued_lock->owner_node;
+	predecessor_node = internal_queued_lock->owner_predecessor_node;
+
+	internal_queued_lock->owner_node             = NULL;
+	internal_queued_lock->owner_predecessor_node = NULL;
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_released(
+	 internal_queued_lock );
+#endif
+	LIBCTHREADS_PROBE1(
+	 mutex__release,
+	 internal_queued_lock );
+
+	/* The node of the predecessor is no longer read by any thread and can be
+	 * reused, while the node of this thread is now read by its successor
+	 */
+	if( libcthreads_stack_push(
+	     internal_queued_lock->free_nodes,
+	     &( predecessor_node->stack_node ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push free node.",
+		 function );
+
+		libcthreads_queued_lock_node_set_is_locked(
+		 node,
+		 0 );
+
+		return( -1 );
+	}
+	libcthreads_queued_lock_node_set_is_locked(
+	 node,
+	 0 );
+
+	return( 1 );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,122 @@
+/*
+ * Queued lock functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_QUEUED_LOCK_H )
+#define _LIBCTHREADS_INTERNAL_QUEUED_LOCK_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_atomic.h"
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The number of times a waiting thread checks its predecessor before it yields the CPU
+ */
+#define LIBCTHREADS_QUEUED_LOCK_MAXIMUM_SPIN_COUNT	1024
+
+typedef struct libcthreads_queued_lock_node libcthreads_queued_lock_node_t;
+
+struct libcthreads_queued_lock_node
+{
+	/* The stack node, this must be the first member
+	 */
+	libcthreads_stack_node_t stack_node;
+
+	/* The node data, this contains the node aligned on a cache line boundary
+	 */
+	uint8_t *node_data;
+
+	/* Value to indicate the thread that enqueued the node holds or waits for the lock
+	 */
+	volatile uint32_t is_locked;
+};
+
+typedef struct libcthreads_internal_queued_lock libcthreads_internal_queued_lock_t;
+
+struct libcthreads_internal_queued_lock
+{
+	/* The tail node, which is the node of the last thread that grabbed the lock
+	 */
+	libcthreads_queued_lock_node_t * volatile tail_node;
+
+	/* The node of the thread that holds the lock
+	 */
+	libcthreads_queued_lock_node_t *owner_node;
+
+	/* The predecessor node of the thread that holds the lock,
+	 * which is no longer used by any thread
+	 */
+	libcthreads_queued_lock_node_t *owner_predecessor_node;
+
+	/* The nodes that are not enqueued
+	 */
+	libcthreads_stack_t *free_nodes;
+};
+
+int libcthreads_internal_queued_lock_node_initialize(
+     libcthreads_queued_lock_node_t **node,
+     libcerror_error_t **error );
+
+int libcthreads_internal_queued_lock_node_free(
+     libcthreads_queued_lock_node_t **node,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_queued_lock_initialize(
+     libcthreads_queued_lock_t **queued_lock,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_queued_lock_free(
+     libcthreads_queued_lock_t **queued_lock,
+     libcerror_error_t **error );
+
+int libcthreads_internal_queued_lock_get_free_node(
+     libcthreads_internal_queued_lock_t *internal_queued_lock,
+     libcthreads_queued_lock_node_t **node,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_queued_lock_grab(
+     libcthreads_queued_lock_t *queued_lock,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_queued_lock_release(
+     libcthreads_queued_lock_t *queued_lock,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_QUEUED_LOCK_H ) */
+
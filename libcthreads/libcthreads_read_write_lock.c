@@ -19,6 +19,12 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+/* Required for pthread_rwlock_clockrdlock and pthread_rwlock_clockwrlock
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
 #include <common.h>
 #include <memory.h>
 #include <types.h>
@@ -33,31 +39,42 @@
 #include <pthread.h>
 #endif
 
+#include "libcthreads_clock.h"
+#include "libcthreads_condition.h"
+#include "libcthreads_definitions.h"
 #include "libcthreads_libcerror.h"
+#include "libcthreads_lock_validator.h"
+#include "libcthreads_mutex.h"
 #include "libcthreads_read_write_lock.h"
 #include "libcthreads_types.h"
+#include "libcthreads_unused.h"
 
 #if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
 
-/* Creates a read/write lock
- * Make sure the value read_write_lock is referencing, is set to NULL
+/* Make sure the internal read/write lock fits in the storage for in place initialization
+ */
+typedef char libcthreads_internal_read_write_lock_storage_size_check_t[ ( sizeof( libcthreads_internal_read_write_lock_t ) <= LIBCTHREADS_READ_WRITE_LOCK_STORAGE_SIZE ) ? 1 : -1 ];
+
+/* Initializes a read/write lock in the provided memory
+ * The default policy uses the native read/write lock, the other policies
+ * use a read/write lock based on a mutex and conditions
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_read_write_lock_initialize(
-     libcthreads_read_write_lock_t **read_write_lock,
+int libcthreads_internal_read_write_lock_initialize(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     int policy,
      libcerror_error_t **error )
 {
-	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
-	static char *function                                            = "libcthreads_read_write_lock_initialize";
+	static char *function = "libcthreads_internal_read_write_lock_initialize";
 
 #if defined( WINAPI ) && ( WINVER >= 0x0400 ) && ( WINVER < 0x0600 )
-	DWORD error_code                                                 = 0;
+	DWORD error_code      = 0;
 
 #elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                                               = 0;
+	int pthread_result    = 0;
 #endif
 
-	if( read_write_lock == NULL )
+	if( internal_read_write_lock == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -68,31 +85,20 @@ int libcthreads_read_write_lock_initialize(
 
 		return( -1 );
 	}
-	if( *read_write_lock != NULL )
+	if( ( policy != LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT )
+	 && ( policy != LIBCTHREADS_READ_WRITE_LOCK_POLICY_PREFER_READERS )
+	 && ( policy != LIBCTHREADS_READ_WRITE_LOCK_POLICY_PREFER_WRITERS )
+	 && ( policy != LIBCTHREADS_READ_WRITE_LOCK_POLICY_FAIR ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid read/write lock value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported policy.",
 		 function );
 
 		return( -1 );
 	}
-	internal_read_write_lock = memory_allocate_structure(
-	                            libcthreads_internal_read_write_lock_t );
-
-	if( internal_read_write_lock == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create read/write lock.",
-		 function );
-
-		goto on_error;
-	}
 	if( memory_set(
 	     internal_read_write_lock,
 	     0,
@@ -105,29 +111,83 @@ int libcthreads_read_write_lock_initialize(
 		 "%s: unable to clear read/write lock.",
 		 function );
 
-		memory_free(
-		 internal_read_write_lock );
-
 		return( -1 );
 	}
+	internal_read_write_lock->policy = policy;
+
+	if( policy != LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT )
+	{
+		if( libcthreads_internal_mutex_initialize(
+		     &( internal_read_write_lock->lock.managed.mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_internal_condition_initialize(
+		     &( internal_read_write_lock->lock.managed.read_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize read condition.",
+			 function );
+
+			libcthreads_internal_mutex_finalize(
+			 &( internal_read_write_lock->lock.managed.mutex ),
+			 NULL );
+
+			return( -1 );
+		}
+		if( libcthreads_internal_condition_initialize(
+		     &( internal_read_write_lock->lock.managed.write_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write condition.",
+			 function );
+
+			libcthreads_internal_condition_finalize(
+			 &( internal_read_write_lock->lock.managed.read_condition ),
+			 NULL );
+
+			libcthreads_internal_mutex_finalize(
+			 &( internal_read_write_lock->lock.managed.mutex ),
+			 NULL );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
 #if defined( WINAPI ) && ( WINVER >= 0x0600 )
 	InitializeSRWLock(
-	 &( internal_read_write_lock->slim_read_write_lock ) );
+	 &( internal_read_write_lock->lock.native.slim_read_write_lock ) );
 
 #elif defined( WINAPI ) && ( WINVER >= 0x0400 )
 	InitializeCriticalSection(
-	 &( internal_read_write_lock->write_critical_section ) );
+	 &( internal_read_write_lock->lock.native.write_critical_section ) );
 
 	InitializeCriticalSection(
-	 &( internal_read_write_lock->read_critical_section ) );
+	 &( internal_read_write_lock->lock.native.read_critical_section ) );
 
-	internal_read_write_lock->no_read_event_handle = CreateEvent(
+	internal_read_write_lock->lock.native.no_read_event_handle = CreateEvent(
 	                                                  NULL,
 	                                                  TRUE,
 	                                                  TRUE,
 	                                                  NULL );
 
-	if( internal_read_write_lock->no_read_event_handle == NULL )
+	if( internal_read_write_lock->lock.native.no_read_event_handle == NULL )
 	{
 		error_code = GetLastError();
 
@@ -147,7 +207,7 @@ int libcthreads_read_write_lock_initialize(
 
 #elif defined( HAVE_PTHREAD_H )
 	pthread_result = pthread_rwlock_init(
-	                  &( internal_read_write_lock->read_write_lock ),
+	                  &( internal_read_write_lock->lock.native.read_write_lock ),
 	                  NULL );
 
 	switch( pthread_result )
@@ -177,6 +237,96 @@ int libcthreads_read_write_lock_initialize(
 			goto on_error;
 	}
 #endif
+	return( 1 );
+
+on_error:
+#if defined( WINAPI ) && ( WINVER >= 0x0400 ) && ( WINVER < 0x0600 )
+	DeleteCriticalSection(
+	 &( internal_read_write_lock->lock.native.read_critical_section ) );
+
+	DeleteCriticalSection(
+	 &( internal_read_write_lock->lock.native.write_critical_section ) );
+#endif
+	return( -1 );
+}
+
+/* Creates a read/write lock
+ * Make sure the value read_write_lock is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_read_write_lock_initialize(
+     libcthreads_read_write_lock_t **read_write_lock,
+     libcerror_error_t **error )
+{
+	return( libcthreads_read_write_lock_initialize_with_policy(
+	         read_write_lock,
+	         LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT,
+	         error ) );
+}
+
+/* Creates a read/write lock with a specific policy
+ * The policy determines whether waiting readers or writers are preferred
+ * Make sure the value read_write_lock is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_read_write_lock_initialize_with_policy(
+     libcthreads_read_write_lock_t **read_write_lock,
+     int policy,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
+	static char *function                                            = "libcthreads_read_write_lock_initialize_with_policy";
+
+	if( read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_write_lock != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read/write lock value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_read_write_lock = memory_allocate_structure(
+	                            libcthreads_internal_read_write_lock_t );
+
+	if( internal_read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_internal_read_write_lock_initialize(
+	     internal_read_write_lock,
+	     policy,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
 	*read_write_lock = (libcthreads_read_write_lock_t *) internal_read_write_lock;
 
 	return( 1 );
@@ -184,38 +334,30 @@ int libcthreads_read_write_lock_initialize(
 on_error:
 	if( internal_read_write_lock != NULL )
 	{
-#if defined( WINAPI ) && ( WINVER >= 0x0400 ) && ( WINVER < 0x0600 )
-		DeleteCriticalSection(
-		 &( internal_read_write_lock->read_critical_section ) );
-
-		DeleteCriticalSection(
-		 &( internal_read_write_lock->write_critical_section ) );
-#endif
 		memory_free(
 		 internal_read_write_lock );
 	}
 	return( -1 );
 }
 
-/* Frees a read/write lock
+/* Finalizes a read/write lock in the provided memory
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_read_write_lock_free(
-     libcthreads_read_write_lock_t **read_write_lock,
+int libcthreads_internal_read_write_lock_finalize(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
      libcerror_error_t **error )
 {
-	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
-	static char *function                                            = "libcthreads_read_write_lock_free";
-	int result                                                       = 1;
+	static char *function = "libcthreads_internal_read_write_lock_finalize";
+	int result            = 1;
 
 #if defined( WINAPI ) && ( WINVER >= 0x0400 ) && ( WINVER < 0x0600 )
-	DWORD error_code                                                 = 0;
+	DWORD error_code      = 0;
 
 #elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                                               = 0;
+	int pthread_result    = 0;
 #endif
 
-	if( read_write_lock == NULL )
+	if( internal_read_write_lock == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -226,14 +368,53 @@ int libcthreads_read_write_lock_free(
 
 		return( -1 );
 	}
-	if( *read_write_lock != NULL )
+	if( internal_read_write_lock->policy != LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT )
 	{
-		internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) *read_write_lock;
-		*read_write_lock         = NULL;
+		if( libcthreads_internal_condition_finalize(
+		     &( internal_read_write_lock->lock.managed.write_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize write condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_internal_condition_finalize(
+		     &( internal_read_write_lock->lock.managed.read_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize read condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_internal_mutex_finalize(
+		     &( internal_read_write_lock->lock.managed.mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize mutex.",
+			 function );
 
+			result = -1;
+		}
+	}
+	else
+	{
 #if defined( WINAPI ) && ( WINVER >= 0x0400 ) && ( WINVER < 0x0600 )
 		if( CloseHandle(
-		     internal_read_write_lock->no_read_event_handle ) == 0 )
+		     internal_read_write_lock->lock.native.no_read_event_handle ) == 0 )
 		{
 			error_code = GetLastError();
 
@@ -248,10 +429,10 @@ int libcthreads_read_write_lock_free(
 			result = -1;
 		}
 		DeleteCriticalSection(
-		 &( internal_read_write_lock->read_critical_section ) );
+		 &( internal_read_write_lock->lock.native.read_critical_section ) );
 
 		DeleteCriticalSection(
-		 &( internal_read_write_lock->write_critical_section ) );
+		 &( internal_read_write_lock->lock.native.write_critical_section ) );
 
 #elif defined( WINAPI ) && ( WINVER < 0x0400 )
 
@@ -259,7 +440,7 @@ int libcthreads_read_write_lock_free(
 
 #elif defined( HAVE_PTHREAD_H )
 		pthread_result = pthread_rwlock_destroy(
-		                  &( internal_read_write_lock->read_write_lock ) );
+		                  &( internal_read_write_lock->lock.native.read_write_lock ) );
 
 		switch( pthread_result )
 		{
@@ -301,29 +482,25 @@ int libcthreads_read_write_lock_free(
 				break;
 		}
 #endif
-		memory_free(
-		 internal_read_write_lock );
 	}
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_remove_lock(
+	 internal_read_write_lock );
+#endif
 	return( result );
 }
 
-/* Grabs a read/write lock for reading
+/* Frees a read/write lock
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_read_write_lock_grab_for_read(
-     libcthreads_read_write_lock_t *read_write_lock,
+int libcthreads_read_write_lock_free(
+     libcthreads_read_write_lock_t **read_write_lock,
      libcerror_error_t **error )
 {
 	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
-	static char *function                                            = "libcthreads_read_write_lock_grab_for_read";
-
-#if defined( WINAPI ) && ( WINVER >= 0x0400 ) && ( WINVER < 0x0600 )
-	DWORD error_code                                                 = 0;
-	BOOL result                                                      = 0;
-
-#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                                               = 0;
-#endif
+	static char *function                                            = "libcthreads_read_write_lock_free";
+	int result                                                       = 1;
 
 	if( read_write_lock == NULL )
 	{
@@ -336,120 +513,1721 @@ int libcthreads_read_write_lock_grab_for_read(
 
 		return( -1 );
 	}
-	internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) read_write_lock;
-
-#if defined( WINAPI ) && ( WINVER >= 0x0600 )
-	AcquireSRWLockShared(
-	 &( internal_read_write_lock->slim_read_write_lock ) );
-
-#elif defined( WINAPI ) && ( WINVER >= 0x0400 )
-	EnterCriticalSection(
-	 &( internal_read_write_lock->write_critical_section ) );
-
-	EnterCriticalSection(
-	 &( internal_read_write_lock->read_critical_section ) );
-
-	internal_read_write_lock->number_of_readers++;
-
-	if( internal_read_write_lock->number_of_readers == 1 )
+	if( *read_write_lock != NULL )
 	{
-		result = ResetEvent(
-		          internal_read_write_lock->no_read_event_handle );
+		internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) *read_write_lock;
+		*read_write_lock         = NULL;
 
-		if( result == 0 )
+		if( libcthreads_internal_read_write_lock_finalize(
+		     internal_read_write_lock,
+		     error ) != 1 )
 		{
-			error_code = GetLastError();
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize read/write lock.",
+			 function );
 
-			internal_read_write_lock->number_of_readers--;
+			result = -1;
 		}
+		memory_free(
+		 internal_read_write_lock );
 	}
-	else
-	{
-		result = 1;
-	}
-	LeaveCriticalSection(
-	 &( internal_read_write_lock->read_critical_section ) );
+	return( result );
+}
+
+/* Initializes a read/write lock in caller provided storage
+ * The storage must remain available until the read/write lock is finalized
+ * Make sure the value read_write_lock is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_read_write_lock_initialize_in_place(
+     libcthreads_read_write_lock_t **read_write_lock,
+     libcthreads_read_write_lock_storage_t *storage,
+     libcerror_error_t **error )
+{
+	return( libcthreads_read_write_lock_initialize_in_place_with_policy(
+	         read_write_lock,
+	         storage,
+	         LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT,
+	         error ) );
+}
 
-	LeaveCriticalSection(
-	 &( internal_read_write_lock->write_critical_section ) );
+/* Initializes a read/write lock with a specific policy in caller provided storage
+ * The storage must remain available until the read/write lock is finalized
+ * Make sure the value read_write_lock is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_read_write_lock_initialize_in_place_with_policy(
+     libcthreads_read_write_lock_t **read_write_lock,
+     libcthreads_read_write_lock_storage_t *storage,
+     int policy,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
+	static char *function                                            = "libcthreads_read_write_lock_initialize_in_place_with_policy";
 
-	if( result == 0 )
+	if( read_write_lock == NULL )
 	{
-		libcerror_system_set_error(
+		libcerror_error_set(
 		 error,
-		 error_code,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: reset of no read event failed.",
-		 function );
-
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_write_lock != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read/write lock value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage.",
+		 function );
+
+		return( -1 );
+	}
+	internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) storage;
+
+	if( libcthreads_internal_read_write_lock_initialize(
+	     internal_read_write_lock,
+	     policy,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	*read_write_lock = (libcthreads_read_write_lock_t *) internal_read_write_lock;
+
+	return( 1 );
+}
+
+/* Finalizes a read/write lock that was initialized in caller provided storage
+ * The storage itself is not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_read_write_lock_finalize_in_place(
+     libcthreads_read_write_lock_t **read_write_lock,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
+	static char *function                                            = "libcthreads_read_write_lock_finalize_in_place";
+
+	if( read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_write_lock != NULL )
+	{
+		internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) *read_write_lock;
+		*read_write_lock         = NULL;
+
+		if( libcthreads_internal_read_write_lock_finalize(
+		     internal_read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize read/write lock.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the policy
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_read_write_lock_get_policy(
+     libcthreads_read_write_lock_t *read_write_lock,
+     int *policy,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
+	static char *function                                            = "libcthreads_read_write_lock_get_policy";
+
+	if( read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) read_write_lock;
+
+	if( policy == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid policy.",
+		 function );
+
+		return( -1 );
+	}
+	*policy = internal_read_write_lock->policy;
+
+	return( 1 );
+}
+
+/* Determines if a reader or upgrader can enter the condition based read/write lock
+ * The mutex must be held by the caller
+ * Returns 1 if the read/write lock can be entered or 0 if not
+ */
+int libcthreads_internal_read_write_lock_can_enter_shared(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     uint8_t is_upgrade )
+{
+	if( internal_read_write_lock->lock.managed.has_writer != 0 )
+	{
+		return( 0 );
+	}
+	/* There can be only one upgrader at a time
+	 */
+	if( ( is_upgrade != 0 )
+	 && ( internal_read_write_lock->lock.managed.has_upgrader != 0 ) )
+	{
+		return( 0 );
+	}
+	switch( internal_read_write_lock->policy )
+	{
+		case LIBCTHREADS_READ_WRITE_LOCK_POLICY_PREFER_WRITERS:
+			if( internal_read_write_lock->lock.managed.number_of_waiting_writers > 0 )
+			{
+				return( 0 );
+			}
+			break;
+
+		/* Readers that were waiting when the last writer left are admitted
+		 * before the next writer, other readers wait for the writers
+		 */
+		case LIBCTHREADS_READ_WRITE_LOCK_POLICY_FAIR:
+			if( ( internal_read_write_lock->lock.managed.number_of_waiting_writers > 0 )
+			 && ( internal_read_write_lock->lock.managed.number_of_admitted_readers == 0 ) )
+			{
+				return( 0 );
+			}
+			break;
+
+		default:
+			break;
+	}
+	return( 1 );
+}
+
+/* Determines if a writer can enter the condition based read/write lock
+ * The mutex must be held by the caller
+ * Returns 1 if the read/write lock can be entered or 0 if not
+ */
+int libcthreads_internal_read_write_lock_can_enter_exclusive(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock )
+{
+	if( ( internal_read_write_lock->lock.managed.has_writer != 0 )
+	 || ( internal_read_write_lock->lock.managed.has_upgrader != 0 )
+	 || ( internal_read_write_lock->lock.managed.number_of_readers > 0 ) )
+	{
+		return( 0 );
+	}
+	if( ( internal_read_write_lock->policy == LIBCTHREADS_READ_WRITE_LOCK_POLICY_FAIR )
+	 && ( internal_read_write_lock->lock.managed.number_of_admitted_readers > 0 ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Enters the condition based read/write lock for reading or upgrading
+ * If deadline is NULL this waits until the read/write lock can be entered
+ * otherwise at most until the deadline on the monotonic clock
+ * Returns 1 if successful, 0 if the deadline has passed or -1 on error
+ */
+int libcthreads_internal_read_write_lock_enter_shared(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     uint8_t is_upgrade,
+     const uint64_t *deadline,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_read_write_lock_enter_shared";
+	uint32_t error_code   = 0;
+	int result            = -1;
+
+	if( internal_read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_mutex_grab(
+	     &( internal_read_write_lock->lock.managed.mutex ),
+	     &error_code ) != 1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_upgrade == 0 )
+	{
+		internal_read_write_lock->lock.managed.number_of_waiting_readers++;
+	}
+	while( libcthreads_internal_read_write_lock_can_enter_shared(
+	        internal_read_write_lock,
+	        is_upgrade ) == 0 )
+	{
+		if( deadline == NULL )
+		{
+			if( libcthreads_internal_condition_wait(
+			     &( internal_read_write_lock->lock.managed.read_condition ),
+			     &( internal_read_write_lock->lock.managed.mutex ),
+			     &error_code ) != 1 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 error_code,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for read condition.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			result = libcthreads_condition_wait_until(
+			          (libcthreads_condition_t *) &( internal_read_write_lock->lock.managed.read_condition ),
+			          (libcthreads_mutex_t *) &( internal_read_write_lock->lock.managed.mutex ),
+			          *deadline,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for read condition.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				if( libcthreads_internal_read_write_lock_can_enter_shared(
+				     internal_read_write_lock,
+				     is_upgrade ) != 0 )
+				{
+					break;
+				}
+				goto on_error;
+			}
+		}
+	}
+	if( is_upgrade == 0 )
+	{
+		internal_read_write_lock->lock.managed.number_of_waiting_readers--;
+
+		if( internal_read_write_lock->lock.managed.number_of_admitted_readers > 0 )
+		{
+			internal_read_write_lock->lock.managed.number_of_admitted_readers--;
+		}
+	}
+	else
+	{
+		internal_read_write_lock->lock.managed.has_upgrader = 1;
+	}
+	internal_read_write_lock->lock.managed.number_of_readers++;
+
+	if( libcthreads_internal_mutex_release(
+	     &( internal_read_write_lock->lock.managed.mutex ),
+	     &error_code ) != 1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( is_upgrade == 0 )
+	{
+		internal_read_write_lock->lock.managed.number_of_waiting_readers--;
+
+		if( internal_read_write_lock->lock.managed.number_of_admitted_readers > 0 )
+		{
+			internal_read_write_lock->lock.managed.number_of_admitted_readers--;
+		}
+	}
+	/* Wake up the writers that could be waiting for the admitted readers
+	 */
+	libcthreads_internal_condition_broadcast(
+	 &( internal_read_write_lock->lock.managed.write_condition ),
+	 &error_code );
+
+	libcthreads_internal_mutex_release(
+	 &( internal_read_write_lock->lock.managed.mutex ),
+	 &error_code );
+
+	return( result );
+}
+
+/* Enters the condition based read/write lock for writing
+ * If deadline is NULL this waits until the read/write lock can be entered
+ * otherwise at most until the deadline on the monotonic clock
+ * Returns 1 if successful, 0 if the deadline has passed or -1 on error
+ */
+int libcthreads_internal_read_write_lock_enter_exclusive(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     const uint64_t *deadline,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_read_write_lock_enter_exclusive";
+	uint32_t error_code   = 0;
+	int result            = -1;
+
+	if( internal_read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_mutex_grab(
+	     &( internal_read_write_lock->lock.managed.mutex ),
+	     &error_code ) != 1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_read_write_lock->lock.managed.number_of_waiting_writers++;
+
+	while( libcthreads_internal_read_write_lock_can_enter_exclusive(
+	        internal_read_write_lock ) == 0 )
+	{
+		if( deadline == NULL )
+		{
+			if( libcthreads_internal_condition_wait(
+			     &( internal_read_write_lock->lock.managed.write_condition ),
+			     &( internal_read_write_lock->lock.managed.mutex ),
+			     &error_code ) != 1 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 error_code,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for write condition.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			result = libcthreads_condition_wait_until(
+			          (libcthreads_condition_t *) &( internal_read_write_lock->lock.managed.write_condition ),
+			          (libcthreads_mutex_t *) &( internal_read_write_lock->lock.managed.mutex ),
+			          *deadline,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for write condition.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				if( libcthreads_internal_read_write_lock_can_enter_exclusive(
+				     internal_read_write_lock ) != 0 )
+				{
+					break;
+				}
+				goto on_error;
+			}
+		}
+	}
+	internal_read_write_lock->lock.managed.number_of_waiting_writers--;
+	internal_read_write_lock->lock.managed.has_writer = 1;
+
+	if( libcthreads_internal_mutex_release(
+	     &( internal_read_write_lock->lock.managed.mutex ),
+	     &error_code ) != 1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	internal_read_write_lock->lock.managed.number_of_waiting_writers--;
+
+	/* Wake up the readers that could be waiting for this writer
+	 */
+	libcthreads_internal_condition_broadcast(
+	 &( internal_read_write_lock->lock.managed.read_condition ),
+	 &error_code );
+
+	libcthreads_internal_mutex_release(
+	 &( internal_read_write_lock->lock.managed.mutex ),
+	 &error_code );
+
+	return( result );
+}
+
+/* Leaves the condition based read/write lock for reading or upgrading
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_read_write_lock_leave_shared(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     uint8_t is_upgrade,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_read_write_lock_leave_shared";
+	uint32_t error_code   = 0;
+
+	if( internal_read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_mutex_grab(
+	     &( internal_read_write_lock->lock.managed.mutex ),
+	     &error_code ) != 1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_read_write_lock->lock.managed.number_of_readers <= 0 )
+	 || ( ( is_upgrade != 0 )
+	  &&  ( internal_read_write_lock->lock.managed.has_upgrader == 0 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read/write lock - not held for reading.",
+		 function );
+
+		goto on_error;
+	}
+	internal_read_write_lock->lock.managed.number_of_readers--;
+
+	if( is_upgrade != 0 )
+	{
+		internal_read_write_lock->lock.managed.has_upgrader = 0;
+
+		if( libcthreads_internal_condition_broadcast(
+		     &( internal_read_write_lock->lock.managed.read_condition ),
+		     &error_code ) != 1 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 error_code,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast read condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( is_upgrade != 0 )
+	 || ( internal_read_write_lock->lock.managed.number_of_readers == 0 ) )
+	{
+		if( libcthreads_internal_condition_broadcast(
+		     &( internal_read_write_lock->lock.managed.write_condition ),
+		     &error_code ) != 1 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 error_code,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast write condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_internal_mutex_release(
+	     &( internal_read_write_lock->lock.managed.mutex ),
+	     &error_code ) != 1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_internal_mutex_release(
+	 &( internal_read_write_lock->lock.managed.mutex ),
+	 &error_code );
+
+	return( -1 );
+}
+
+/* Leaves the condition based read/write lock for writing
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_read_write_lock_leave_exclusive(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_read_write_lock_leave_exclusive";
+	uint32_t error_code   = 0;
+
+	if( internal_read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_mutex_grab(
+	     &( internal_read_write_lock->lock.managed.mutex ),
+	     &error_code ) != 1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_read_write_lock->lock.managed.has_writer == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read/write lock - not held for writing.",
+		 function );
+
+		goto on_error;
+	}
+	internal_read_write_lock->lock.managed.has_writer = 0;
+
+	/* The fair policy admits the readers that are currently waiting
+	 * before the next writer
+	 */
+	if( internal_read_write_lock->policy == LIBCTHREADS_READ_WRITE_LOCK_POLICY_FAIR )
+	{
+		internal_read_write_lock->lock.managed.number_of_admitted_readers = internal_read_write_lock->lock.managed.number_of_waiting_readers;
+	}
+	if( libcthreads_internal_condition_broadcast(
+	     &( internal_read_write_lock->lock.managed.read_condition ),
+	     &error_code ) != 1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast read condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_internal_condition_broadcast(
+	     &( internal_read_write_lock->lock.managed.write_condition ),
+	     &error_code ) != 1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast write condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_internal_mutex_release(
+	     &( internal_read_write_lock->lock.managed.mutex ),
+	     &error_code ) != 1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_internal_mutex_release(
+	 &( internal_read_write_lock->lock.managed.mutex ),
+	 &error_code );
+
+	return( -1 );
+}
+
+/* Grabs a read/write lock for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_read_write_lock_grab_for_read(
+     libcthreads_read_write_lock_t *read_write_lock,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
+	static char *function                                            = "libcthreads_read_write_lock_grab_for_read";
+
+#if defined( WINAPI ) && ( WINVER >= 0x0400 ) && ( WINVER < 0x0600 )
+	DWORD error_code                                                 = 0;
+	BOOL result                                                      = 0;
+
+#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result                                               = 0;
+#endif
+
+	if( read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) read_write_lock;
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_check_acquire(
+	 internal_read_write_lock,
+	 LIBCTHREADS_LOCK_VALIDATOR_FLAG_SHARED );
+#endif
+
+	if( internal_read_write_lock->policy != LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT )
+	{
+		if( libcthreads_internal_read_write_lock_enter_shared(
+		     internal_read_write_lock,
+		     0,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to enter read/write lock for read.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+		AcquireSRWLockShared(
+		 &( internal_read_write_lock->lock.native.slim_read_write_lock ) );
+
+#elif defined( WINAPI ) && ( WINVER >= 0x0400 )
+		EnterCriticalSection(
+		 &( internal_read_write_lock->lock.native.write_critical_section ) );
+
+		EnterCriticalSection(
+		 &( internal_read_write_lock->lock.native.read_critical_section ) );
+
+		internal_read_write_lock->lock.native.number_of_readers++;
+
+		if( internal_read_write_lock->lock.native.number_of_readers == 1 )
+		{
+			result = ResetEvent(
+			          internal_read_write_lock->lock.native.no_read_event_handle );
+
+			if( result == 0 )
+			{
+				error_code = GetLastError();
+
+				internal_read_write_lock->lock.native.number_of_readers--;
+			}
+		}
+		else
+		{
+			result = 1;
+		}
+		LeaveCriticalSection(
+		 &( internal_read_write_lock->lock.native.read_critical_section ) );
+
+		LeaveCriticalSection(
+		 &( internal_read_write_lock->lock.native.write_critical_section ) );
+
+		if( result == 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 error_code,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: reset of no read event failed.",
+			 function );
+
+			return( -1 );
+		}
+#elif defined( WINAPI )
+
+#error libcthreads_read_write_lock_grab_for_read for Windows earlier than NT4 not implemented
+
+#elif defined( HAVE_PTHREAD_H )
+		pthread_result = pthread_rwlock_rdlock(
+		                  &( internal_read_write_lock->lock.native.read_write_lock ) );
+
+		switch( pthread_result )
+		{
+			case 0:
+				break;
+
+			case EAGAIN:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to lock read/write lock for read with error: Maximum number of locks exceeded.",
+				 function );
+
+				return( -1 );
+
+			case EDEADLK:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to lock read/write lock for read with error: Deadlock condition detected.",
+				 function );
+
+				return( -1 );
+
+			default:
+				libcerror_system_set_error(
+				 error,
+				 pthread_result,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to lock read/write lock for read.",
+				 function );
+
+				return( -1 );
+		}
+#endif
+	}
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_acquired(
+	 internal_read_write_lock );
+#endif
+	return( 1 );
+}
+
+/* Grabs a read/write lock for writing
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_read_write_lock_grab_for_write(
+     libcthreads_read_write_lock_t *read_write_lock,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
+	static char *function                                            = "libcthreads_read_write_lock_grab_for_write";
+
+#if defined( WINAPI ) && ( WINVER >= 0x0400 ) && ( WINVER < 0x0600 )
+	DWORD error_code                                                 = 0;
+	DWORD wait_status                                                = 0;
+
+#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result                                               = 0;
+#endif
+
+	if( read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) read_write_lock;
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_check_acquire(
+	 internal_read_write_lock,
+	 0 );
+#endif
+
+	if( internal_read_write_lock->policy != LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT )
+	{
+		if( libcthreads_internal_read_write_lock_enter_exclusive(
+		     internal_read_write_lock,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to enter read/write lock for write.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+		AcquireSRWLockExclusive(
+		 &( internal_read_write_lock->lock.native.slim_read_write_lock ) );
+
+#elif defined( WINAPI ) && ( WINVER >= 0x0400 )
+		EnterCriticalSection(
+		 &( internal_read_write_lock->lock.native.write_critical_section ) );
+
+		wait_status = WaitForSingleObject(
+		               internal_read_write_lock->lock.native.no_read_event_handle,
+		               INFINITE );
+
+		if( wait_status == WAIT_FAILED )
+		{
+			error_code = GetLastError();
+
+			LeaveCriticalSection(
+			 &( internal_read_write_lock->lock.native.write_critical_section ) );
+
+			libcerror_system_set_error(
+			 error,
+			 error_code,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: wait for no read event handle failed.",
+			 function );
+
+			return( -1 );
+		}
+#elif defined( WINAPI )
+
+#error libcthreads_read_write_lock_grab_for_write for Windows earlier than NT4 not implemented
+
+#elif defined( HAVE_PTHREAD_H )
+		pthread_result = pthread_rwlock_wrlock(
+		                  &( internal_read_write_lock->lock.native.read_write_lock ) );
+
+		switch( pthread_result )
+		{
+			case 0:
+				break;
+
+			case EDEADLK:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to lock read/write lock for write with error: Deadlock condition detected.",
+				 function );
+
+				return( -1 );
+
+			default:
+				libcerror_system_set_error(
+				 error,
+				 pthread_result,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to lock read/write lock for write.",
+				 function );
+
+				return( -1 );
+		}
+#endif
+	}
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_acquired(
+	 internal_read_write_lock );
+#endif
+	return( 1 );
+}
+
+/* Releases a read/write lock for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_read_write_lock_release_for_read(
+     libcthreads_read_write_lock_t *read_write_lock,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
+	static char *function                                            = "libcthreads_read_write_lock_release_for_read";
+
+#if defined( WINAPI ) && ( WINVER >= 0x0400 ) && ( WINVER < 0x0600 )
+	DWORD error_code                                                 = 0;
+	BOOL result                                                      = 0;
+
+#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result                                               = 0;
+#endif
+
+	if( read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) read_write_lock;
+
+	if( internal_read_write_lock->policy != LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT )
+	{
+		if( libcthreads_internal_read_write_lock_leave_shared(
+		     internal_read_write_lock,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to leave read/write lock for read.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+		ReleaseSRWLockShared(
+		 &( internal_read_write_lock->lock.native.slim_read_write_lock ) );
+
+#elif defined( WINAPI ) && ( WINVER >= 0x0400 )
+		EnterCriticalSection(
+		 &( internal_read_write_lock->lock.native.read_critical_section ) );
+
+		internal_read_write_lock->lock.native.number_of_readers--;
+
+		if( internal_read_write_lock->lock.native.number_of_readers == 0 )
+		{
+			result = SetEvent(
+			          internal_read_write_lock->lock.native.no_read_event_handle );
+
+			if( result == 0 )
+			{
+				error_code = GetLastError();
+
+				internal_read_write_lock->lock.native.number_of_readers++;
+			}
+		}
+		else
+		{
+			result = 1;
+		}
+		LeaveCriticalSection(
+		 &( internal_read_write_lock->lock.native.read_critical_section ) );
+
+		if( result == 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 error_code,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: set of no read event failed.",
+			 function );
+
+			return( -1 );
+		}
+#elif defined( WINAPI )
+
+#error libcthreads_read_write_lock_release_for_read for Windows earlier than NT4 not implemented
+
+#elif defined( HAVE_PTHREAD_H )
+		pthread_result = pthread_rwlock_unlock(
+		                  &( internal_read_write_lock->lock.native.read_write_lock ) );
+
+		if( pthread_result != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 pthread_result,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to unlock read/write lock.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_released(
+	 internal_read_write_lock );
+#endif
+	return( 1 );
+}
+
+/* Releases a read/write lock for writing
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_read_write_lock_release_for_write(
+     libcthreads_read_write_lock_t *read_write_lock,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
+	static char *function                                            = "libcthreads_read_write_lock_release_for_write";
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result                                               = 0;
+#endif
+
+	if( read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
 		return( -1 );
 	}
+	internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) read_write_lock;
+
+	if( internal_read_write_lock->policy != LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT )
+	{
+		if( libcthreads_internal_read_write_lock_leave_exclusive(
+		     internal_read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to leave read/write lock for write.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+		ReleaseSRWLockExclusive(
+		 &( internal_read_write_lock->lock.native.slim_read_write_lock ) );
+
+#elif defined( WINAPI ) && ( WINVER >= 0x0400 )
+		LeaveCriticalSection(
+		 &( internal_read_write_lock->lock.native.write_critical_section ) );
+
 #elif defined( WINAPI )
 
-#error libcthreads_read_write_lock_grab_for_read for Windows earlier than NT4 not implemented
+#error libcthreads_read_write_lock_release_for_write for Windows earlier than NT4 not implemented
+
+#elif defined( HAVE_PTHREAD_H )
+		pthread_result = pthread_rwlock_unlock(
+		                  &( internal_read_write_lock->lock.native.read_write_lock ) );
+
+		if( pthread_result != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 pthread_result,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to unlock read/write lock.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_released(
+	 internal_read_write_lock );
+#endif
+	return( 1 );
+}
+
+/* Tries to grab the native read/write lock without an error object
+ * The error code is set to the system error code on error
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libcthreads_internal_read_write_lock_try_grab_native(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     uint8_t is_exclusive,
+     uint32_t *error_code )
+{
+#if defined( WINAPI ) && ( WINVER >= 0x0400 ) && ( WINVER < 0x0600 )
+	DWORD wait_status  = 0;
+	BOOL result        = 0;
+
+#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result = 0;
+#endif
+
+#if defined( WINAPI ) && ( WINVER >= 0x0601 )
+	if( is_exclusive != 0 )
+	{
+		if( TryAcquireSRWLockExclusive(
+		     &( internal_read_write_lock->lock.native.slim_read_write_lock ) ) == 0 )
+		{
+			return( 0 );
+		}
+	}
+	else
+	{
+		if( TryAcquireSRWLockShared(
+		     &( internal_read_write_lock->lock.native.slim_read_write_lock ) ) == 0 )
+		{
+			return( 0 );
+		}
+	}
+
+#elif defined( WINAPI ) && ( WINVER >= 0x0600 )
+	/* The try acquire slim read/write lock functions require Windows 7 or later
+	 */
+	LIBCTHREADS_UNREFERENCED_PARAMETER( internal_read_write_lock )
+	LIBCTHREADS_UNREFERENCED_PARAMETER( is_exclusive )
+
+	*error_code = (uint32_t) ERROR_CALL_NOT_IMPLEMENTED;
+
+	return( -1 );
+
+#elif defined( WINAPI ) && ( WINVER >= 0x0400 )
+	if( TryEnterCriticalSection(
+	     &( internal_read_write_lock->lock.native.write_critical_section ) ) == 0 )
+	{
+		return( 0 );
+	}
+	if( is_exclusive != 0 )
+	{
+		wait_status = WaitForSingleObject(
+		               internal_read_write_lock->lock.native.no_read_event_handle,
+		               0 );
+
+		if( wait_status == WAIT_TIMEOUT )
+		{
+			LeaveCriticalSection(
+			 &( internal_read_write_lock->lock.native.write_critical_section ) );
+
+			return( 0 );
+		}
+		else if( wait_status == WAIT_FAILED )
+		{
+			*error_code = (uint32_t) GetLastError();
+
+			LeaveCriticalSection(
+			 &( internal_read_write_lock->lock.native.write_critical_section ) );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		EnterCriticalSection(
+		 &( internal_read_write_lock->lock.native.read_critical_section ) );
+
+		internal_read_write_lock->lock.native.number_of_readers++;
+
+		if( internal_read_write_lock->lock.native.number_of_readers == 1 )
+		{
+			result = ResetEvent(
+			          internal_read_write_lock->lock.native.no_read_event_handle );
+
+			if( result == 0 )
+			{
+				*error_code = (uint32_t) GetLastError();
+
+				internal_read_write_lock->lock.native.number_of_readers--;
+			}
+		}
+		else
+		{
+			result = 1;
+		}
+		LeaveCriticalSection(
+		 &( internal_read_write_lock->lock.native.read_critical_section ) );
+
+		LeaveCriticalSection(
+		 &( internal_read_write_lock->lock.native.write_critical_section ) );
+
+		if( result == 0 )
+		{
+			return( -1 );
+		}
+	}
+#elif defined( WINAPI )
+
+#error libcthreads_internal_read_write_lock_try_grab_native for Windows earlier than NT4 not implemented
 
 #elif defined( HAVE_PTHREAD_H )
-	pthread_result = pthread_rwlock_rdlock(
-	                  &( internal_read_write_lock->read_write_lock ) );
+	if( is_exclusive != 0 )
+	{
+		pthread_result = pthread_rwlock_trywrlock(
+		                  &( internal_read_write_lock->lock.native.read_write_lock ) );
+	}
+	else
+	{
+		pthread_result = pthread_rwlock_tryrdlock(
+		                  &( internal_read_write_lock->lock.native.read_write_lock ) );
+	}
+	if( pthread_result == EBUSY )
+	{
+		return( 0 );
+	}
+	else if( pthread_result != 0 )
+	{
+		*error_code = (uint32_t) pthread_result;
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Grabs a read/write lock for reading or writing and waits at most until the deadline
+ * The deadline is in nanoseconds on the monotonic clock
+ * Returns 1 if successful, 0 if the deadline has passed or -1 on error
+ */
+int libcthreads_internal_read_write_lock_grab_until(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     uint8_t is_exclusive,
+     uint64_t deadline,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_read_write_lock_grab_until";
+	int result            = 0;
+
+#if defined( HAVE_PTHREAD_H ) && defined( HAVE_PTHREAD_RWLOCK_CLOCKRDLOCK ) && defined( HAVE_PTHREAD_RWLOCK_CLOCKWRLOCK ) && !defined( WINAPI )
+	struct timespec time_specification;
+
+	int pthread_result    = 0;
+
+#else
+	uint64_t backoff_time = 0;
+	uint32_t error_code   = 0;
+#endif
+
+	if( internal_read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_read_write_lock->policy != LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT )
+	{
+		if( is_exclusive != 0 )
+		{
+			result = libcthreads_internal_read_write_lock_enter_exclusive(
+			          internal_read_write_lock,
+			          &deadline,
+			          error );
+		}
+		else
+		{
+			result = libcthreads_internal_read_write_lock_enter_shared(
+			          internal_read_write_lock,
+			          0,
+			          &deadline,
+			          error );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to enter read/write lock.",
+			 function );
+
+			return( -1 );
+		}
+		return( result );
+	}
+#if defined( HAVE_PTHREAD_H ) && defined( HAVE_PTHREAD_RWLOCK_CLOCKRDLOCK ) && defined( HAVE_PTHREAD_RWLOCK_CLOCKWRLOCK ) && !defined( WINAPI )
+	time_specification.tv_sec  = (time_t) ( deadline / 1000000000UL );
+	time_specification.tv_nsec = (long) ( deadline % 1000000000UL );
+
+	if( is_exclusive != 0 )
+	{
+		pthread_result = pthread_rwlock_clockwrlock(
+		                  &( internal_read_write_lock->lock.native.read_write_lock ),
+		                  CLOCK_MONOTONIC,
+		                  &time_specification );
+	}
+	else
+	{
+		pthread_result = pthread_rwlock_clockrdlock(
+		                  &( internal_read_write_lock->lock.native.read_write_lock ),
+		                  CLOCK_MONOTONIC,
+		                  &time_specification );
+	}
+	if( pthread_result == ETIMEDOUT )
+	{
+		return( 0 );
+	}
+	else if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to lock read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	result = 1;
+
+#else
+	/* Without a timed grab on the monotonic clock retry with an increasing backoff
+	 */
+	result = libcthreads_internal_read_write_lock_try_grab_native(
+	          internal_read_write_lock,
+	          is_exclusive,
+	          &error_code );
+
+	while( result == 0 )
+	{
+		result = libcthreads_clock_backoff_until(
+		          deadline,
+		          &backoff_time,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to back off.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		result = libcthreads_internal_read_write_lock_try_grab_native(
+		          internal_read_write_lock,
+		          is_exclusive,
+		          &error_code );
+	}
+	if( result == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to try lock read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Tries to grab a read/write lock for reading
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libcthreads_read_write_lock_try_grab_for_read(
+     libcthreads_read_write_lock_t *read_write_lock,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_read_write_lock_try_grab_for_read";
+	int result            = 0;
+
+	/* A deadline that has already passed only succeeds if the read/write lock
+	 * can be grabbed without waiting
+	 */
+	result = libcthreads_read_write_lock_grab_for_read_until(
+	          read_write_lock,
+	          0,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to try grab read/write lock for read.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Grabs a read/write lock for reading and waits at most until the deadline
+ * The deadline is in nanoseconds on the monotonic clock
+ * Returns 1 if successful, 0 if the deadline has passed or -1 on error
+ */
+int libcthreads_read_write_lock_grab_for_read_until(
+     libcthreads_read_write_lock_t *read_write_lock,
+     uint64_t deadline,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
+	static char *function                                            = "libcthreads_read_write_lock_grab_for_read_until";
+	int result                                                       = 0;
+
+	if( read_write_lock == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+	internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) read_write_lock;
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_check_acquire(
+	 internal_read_write_lock,
+	 LIBCTHREADS_LOCK_VALIDATOR_FLAG_SHARED );
+#endif
+
+	result = libcthreads_internal_read_write_lock_grab_until(
+	          internal_read_write_lock,
+	          0,
+	          deadline,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for read.",
+		 function );
 
-	switch( pthread_result )
+		return( -1 );
+	}
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	if( result == 1 )
 	{
-		case 0:
-			break;
+		libcthreads_lock_validator_acquired(
+		 internal_read_write_lock );
+	}
+#endif
+	return( result );
+}
 
-		case EAGAIN:
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to lock read/write lock for read with error: Maximum number of locks exceeded.",
-			 function );
+/* Grabs a read/write lock for reading and waits at most timeout nanoseconds
+ * Returns 1 if successful, 0 if the timeout has expired or -1 on error
+ */
+int libcthreads_read_write_lock_timed_grab_for_read(
+     libcthreads_read_write_lock_t *read_write_lock,
+     uint64_t timeout,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_read_write_lock_timed_grab_for_read";
+	uint64_t deadline     = 0;
+	int result            = 0;
+
+	if( libcthreads_clock_get_deadline(
+	     timeout,
+	     &deadline,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine deadline.",
+		 function );
 
-			return( -1 );
+		return( -1 );
+	}
+	result = libcthreads_read_write_lock_grab_for_read_until(
+	          read_write_lock,
+	          deadline,
+	          error );
 
-		case EDEADLK:
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to lock read/write lock for read with error: Deadlock condition detected.",
-			 function );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for read.",
+		 function );
 
-			return( -1 );
+		return( -1 );
+	}
+	return( result );
+}
 
-		default:
-			libcerror_system_set_error(
-			 error,
-			 pthread_result,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to lock read/write lock for read.",
-			 function );
+/* Tries to grab a read/write lock for writing
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libcthreads_read_write_lock_try_grab_for_write(
+     libcthreads_read_write_lock_t *read_write_lock,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_read_write_lock_try_grab_for_write";
+	int result            = 0;
+
+	/* A deadline that has already passed only succeeds if the read/write lock
+	 * can be grabbed without waiting
+	 */
+	result = libcthreads_read_write_lock_grab_for_write_until(
+	          read_write_lock,
+	          0,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to try grab read/write lock for write.",
+		 function );
 
-			return( -1 );
+		return( -1 );
 	}
-#endif
-	return( 1 );
+	return( result );
 }
 
-/* Grabs a read/write lock for writing
- * Returns 1 if successful or -1 on error
+/* Grabs a read/write lock for writing and waits at most until the deadline
+ * The deadline is in nanoseconds on the monotonic clock
+ * Returns 1 if successful, 0 if the deadline has passed or -1 on error
  */
-int libcthreads_read_write_lock_grab_for_write(
+int libcthreads_read_write_lock_grab_for_write_until(
      libcthreads_read_write_lock_t *read_write_lock,
+     uint64_t deadline,
      libcerror_error_t **error )
 {
 	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
-	static char *function                                            = "libcthreads_read_write_lock_grab_for_write";
-
-#if defined( WINAPI ) && ( WINVER >= 0x0400 ) && ( WINVER < 0x0600 )
-	DWORD error_code                                                 = 0;
-	DWORD wait_status                                                = 0;
-
-#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                                               = 0;
-#endif
+	static char *function                                            = "libcthreads_read_write_lock_grab_for_write_until";
+	int result                                                       = 0;
 
 	if( read_write_lock == NULL )
 	{
@@ -464,90 +2242,161 @@ int libcthreads_read_write_lock_grab_for_write(
 	}
 	internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) read_write_lock;
 
-#if defined( WINAPI ) && ( WINVER >= 0x0600 )
-	AcquireSRWLockExclusive(
-	 &( internal_read_write_lock->slim_read_write_lock ) );
-
-#elif defined( WINAPI ) && ( WINVER >= 0x0400 )
-	EnterCriticalSection(
-	 &( internal_read_write_lock->write_critical_section ) );
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_check_acquire(
+	 internal_read_write_lock,
+	 0 );
+#endif
 
-	wait_status = WaitForSingleObject(
-	               internal_read_write_lock->no_read_event_handle,
-	               INFINITE );
+	result = libcthreads_internal_read_write_lock_grab_until(
+	          internal_read_write_lock,
+	          1,
+	          deadline,
+	          error );
 
-	if( wait_status == WAIT_FAILED )
+	if( result == -1 )
 	{
-		error_code = GetLastError();
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for write.",
+		 function );
 
-		LeaveCriticalSection(
-		 &( internal_read_write_lock->write_critical_section ) );
+		return( -1 );
+	}
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	if( result == 1 )
+	{
+		libcthreads_lock_validator_acquired(
+		 internal_read_write_lock );
+	}
+#endif
+	return( result );
+}
 
-		libcerror_system_set_error(
+/* Grabs a read/write lock for writing and waits at most timeout nanoseconds
+ * Returns 1 if successful, 0 if the timeout has expired or -1 on error
+ */
+int libcthreads_read_write_lock_timed_grab_for_write(
+     libcthreads_read_write_lock_t *read_write_lock,
+     uint64_t timeout,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_read_write_lock_timed_grab_for_write";
+	uint64_t deadline     = 0;
+	int result            = 0;
+
+	if( libcthreads_clock_get_deadline(
+	     timeout,
+	     &deadline,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
 		 error,
-		 error_code,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: wait for no read event handle failed.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine deadline.",
 		 function );
 
 		return( -1 );
 	}
-#elif defined( WINAPI )
+	result = libcthreads_read_write_lock_grab_for_write_until(
+	          read_write_lock,
+	          deadline,
+	          error );
 
-#error libcthreads_read_write_lock_grab_for_write for Windows earlier than NT4 not implemented
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for write.",
+		 function );
 
-#elif defined( HAVE_PTHREAD_H )
-	pthread_result = pthread_rwlock_wrlock(
-	                  &( internal_read_write_lock->read_write_lock ) );
+		return( -1 );
+	}
+	return( result );
+}
 
-	switch( pthread_result )
+/* Grabs a read/write lock for upgrading
+ * An upgrader coexists with readers but excludes writers and other upgraders
+ * and can be upgraded to a writer without releasing the read/write lock
+ * This requires a read/write lock that was created with a policy other than the default
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_read_write_lock_grab_for_upgrade(
+     libcthreads_read_write_lock_t *read_write_lock,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
+	static char *function                                            = "libcthreads_read_write_lock_grab_for_upgrade";
+
+	if( read_write_lock == NULL )
 	{
-		case 0:
-			break;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read/write lock.",
+		 function );
 
-		case EDEADLK:
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to lock read/write lock for write with error: Deadlock condition detected.",
-			 function );
+		return( -1 );
+	}
+	internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) read_write_lock;
 
-			return( -1 );
+	if( internal_read_write_lock->policy == LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid read/write lock - unsupported policy.",
+		 function );
 
-		default:
-			libcerror_system_set_error(
-			 error,
-			 pthread_result,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to lock read/write lock for write.",
-			 function );
+		return( -1 );
+	}
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_check_acquire(
+	 internal_read_write_lock,
+	 0 );
+#endif
 
-			return( -1 );
+	if( libcthreads_internal_read_write_lock_enter_shared(
+	     internal_read_write_lock,
+	     1,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to enter read/write lock for upgrade.",
+		 function );
+
+		return( -1 );
 	}
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_acquired(
+	 internal_read_write_lock );
 #endif
 	return( 1 );
 }
 
-/* Releases a read/write lock for reading
+/* Upgrades a read/write lock grabbed for upgrading to a read/write lock grabbed for writing
+ * This waits until the other readers have released the read/write lock
+ * The read/write lock must be released for writing afterwards
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_read_write_lock_release_for_read(
+int libcthreads_read_write_lock_upgrade_to_write(
      libcthreads_read_write_lock_t *read_write_lock,
      libcerror_error_t **error )
 {
 	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
-	static char *function                                            = "libcthreads_read_write_lock_release_for_read";
-
-#if defined( WINAPI ) && ( WINVER >= 0x0400 ) && ( WINVER < 0x0600 )
-	DWORD error_code                                                 = 0;
-	BOOL result                                                      = 0;
-
-#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                                               = 0;
-#endif
+	static char *function                                            = "libcthreads_read_write_lock_upgrade_to_write";
+	uint32_t error_code                                              = 0;
 
 	if( read_write_lock == NULL )
 	{
@@ -562,84 +2411,112 @@ int libcthreads_read_write_lock_release_for_read(
 	}
 	internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) read_write_lock;
 
-#if defined( WINAPI ) && ( WINVER >= 0x0600 )
-	ReleaseSRWLockShared(
-	 &( internal_read_write_lock->slim_read_write_lock ) );
-
-#elif defined( WINAPI ) && ( WINVER >= 0x0400 )
-	EnterCriticalSection(
-	 &( internal_read_write_lock->read_critical_section ) );
-
-	internal_read_write_lock->number_of_readers--;
-
-	if( internal_read_write_lock->number_of_readers == 0 )
+	if( internal_read_write_lock->policy == LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT )
 	{
-		result = SetEvent(
-		          internal_read_write_lock->no_read_event_handle );
-
-		if( result == 0 )
-		{
-			error_code = GetLastError();
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid read/write lock - unsupported policy.",
+		 function );
 
-			internal_read_write_lock->number_of_readers++;
-		}
-	}
-	else
-	{
-		result = 1;
+		return( -1 );
 	}
-	LeaveCriticalSection(
-	 &( internal_read_write_lock->read_critical_section ) );
-
-	if( result == 0 )
+	if( libcthreads_internal_mutex_grab(
+	     &( internal_read_write_lock->lock.managed.mutex ),
+	     &error_code ) != 1 )
 	{
 		libcerror_system_set_error(
 		 error,
 		 error_code,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: set of no read event failed.",
+		 "%s: unable to grab mutex.",
 		 function );
 
 		return( -1 );
 	}
-#elif defined( WINAPI )
+	if( internal_read_write_lock->lock.managed.has_upgrader == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read/write lock - not held for upgrading.",
+		 function );
 
-#error libcthreads_read_write_lock_release_for_read for Windows earlier than NT4 not implemented
+		goto on_error;
+	}
+	/* The upgrader stops counting as a reader and waits as a writer,
+	 * the upgrader flag keeps other writers and upgraders out
+	 */
+	internal_read_write_lock->lock.managed.number_of_readers--;
+	internal_read_write_lock->lock.managed.number_of_waiting_writers++;
 
-#elif defined( HAVE_PTHREAD_H )
-	pthread_result = pthread_rwlock_unlock(
-	                  &( internal_read_write_lock->read_write_lock ) );
+	while( internal_read_write_lock->lock.managed.number_of_readers > 0 )
+	{
+		if( libcthreads_internal_condition_wait(
+		     &( internal_read_write_lock->lock.managed.write_condition ),
+		     &( internal_read_write_lock->lock.managed.mutex ),
+		     &error_code ) != 1 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 error_code,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for write condition.",
+			 function );
 
-	if( pthread_result != 0 )
+			/* The read/write lock remains grabbed for upgrading
+			 */
+			internal_read_write_lock->lock.managed.number_of_readers++;
+			internal_read_write_lock->lock.managed.number_of_waiting_writers--;
+
+			libcthreads_internal_condition_broadcast(
+			 &( internal_read_write_lock->lock.managed.read_condition ),
+			 &error_code );
+
+			goto on_error;
+		}
+	}
+	internal_read_write_lock->lock.managed.number_of_waiting_writers--;
+	internal_read_write_lock->lock.managed.has_upgrader = 0;
+	internal_read_write_lock->lock.managed.has_writer   = 1;
+
+	if( libcthreads_internal_mutex_release(
+	     &( internal_read_write_lock->lock.managed.mutex ),
+	     &error_code ) != 1 )
 	{
 		libcerror_system_set_error(
 		 error,
-		 pthread_result,
+		 error_code,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to unlock read/write lock.",
+		 "%s: unable to release mutex.",
 		 function );
 
 		return( -1 );
 	}
-#endif
 	return( 1 );
+
+on_error:
+	libcthreads_internal_mutex_release(
+	 &( internal_read_write_lock->lock.managed.mutex ),
+	 &error_code );
+
+	return( -1 );
 }
 
-/* Releases a read/write lock for writing
+/* Releases a read/write lock for upgrading
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_read_write_lock_release_for_write(
+int libcthreads_read_write_lock_release_for_upgrade(
      libcthreads_read_write_lock_t *read_write_lock,
      libcerror_error_t **error )
 {
 	libcthreads_internal_read_write_lock_t *internal_read_write_lock = NULL;
-	static char *function                                            = "libcthreads_read_write_lock_release_for_write";
-
-#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
-	int pthread_result                                               = 0;
-#endif
+	static char *function                                            = "libcthreads_read_write_lock_release_for_upgrade";
 
 	if( read_write_lock == NULL )
 	{
@@ -654,34 +2531,34 @@ int libcthreads_read_write_lock_release_for_write(
 	}
 	internal_read_write_lock = (libcthreads_internal_read_write_lock_t *) read_write_lock;
 
-#if defined( WINAPI ) && ( WINVER >= 0x0600 )
-	ReleaseSRWLockExclusive(
-	 &( internal_read_write_lock->slim_read_write_lock ) );
-
-#elif defined( WINAPI ) && ( WINVER >= 0x0400 )
-	LeaveCriticalSection(
-	 &( internal_read_write_lock->write_critical_section ) );
-
-#elif defined( WINAPI )
-
-#error libcthreads_read_write_lock_release_for_write for Windows earlier than NT4 not implemented
-
-#elif defined( HAVE_PTHREAD_H )
-	pthread_result = pthread_rwlock_unlock(
-	                  &( internal_read_write_lock->read_write_lock ) );
+	if( internal_read_write_lock->policy == LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid read/write lock - unsupported policy.",
+		 function );
 
-	if( pthread_result != 0 )
+		return( -1 );
+	}
+	if( libcthreads_internal_read_write_lock_leave_shared(
+	     internal_read_write_lock,
+	     1,
+	     error ) != 1 )
 	{
-		libcerror_system_set_error(
+		libcerror_error_set(
 		 error,
-		 pthread_result,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to unlock read/write lock.",
+		 "%s: unable to leave read/write lock for upgrade.",
 		 function );
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	libcthreads_lock_validator_released(
+	 internal_read_write_lock );
 #endif
 	return( 1 );
 }
@@ -33,8 +33,10 @@
 #include <pthread.h>
 #endif
 
+#include "libcthreads_condition.h"
 #include "libcthreads_extern.h"
 #include "libcthreads_libcerror.h"
+#include "libcthreads_mutex.h"
 #include "libcthreads_types.h"
 
 #if defined( __cplusplus )
@@ -47,48 +49,170 @@ typedef struct libcthreads_internal_read_write_lock libcthreads_internal_read_wr
 
 struct libcthreads_internal_read_write_lock
 {
-#if defined( WINAPI ) && ( WINVER >= 0x0600 )
-	/* The slim read/write lock
+	/* The policy
 	 */
-	SRWLOCK slim_read_write_lock;
+	int policy;
+
+	union
+	{
+		/* The native read/write lock, used by the default policy
+		 */
+		struct
+		{
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+			/* The slim read/write lock
+			 */
+			SRWLOCK slim_read_write_lock;
 
 #elif defined( WINAPI )
-	/* The read critical section
-	 */
-	CRITICAL_SECTION read_critical_section;
+			/* The read critical section
+			 */
+			CRITICAL_SECTION read_critical_section;
 
-	/* The write critical section
-	 */
-	CRITICAL_SECTION write_critical_section;
+			/* The write critical section
+			 */
+			CRITICAL_SECTION write_critical_section;
 
-	/* The number of readers
-	 */
-	int number_of_readers;
+			/* The number of readers
+			 */
+			int number_of_readers;
 
-	/* The no read event handle
-	 */
-	HANDLE no_read_event_handle;
+			/* The no read event handle
+			 */
+			HANDLE no_read_event_handle;
 
 #elif defined( HAVE_PTHREAD_H )
-	/* The read/write lock
-	 */
-	pthread_rwlock_t read_write_lock;
+			/* The read/write lock
+			 */
+			pthread_rwlock_t read_write_lock;
 
 #else
 #error Missing read/write lock type
 #endif
+		} native;
+
+		/* The condition based read/write lock, used by the other policies
+		 */
+		struct
+		{
+			/* The mutex that protects the state
+			 */
+			libcthreads_internal_mutex_t mutex;
+
+			/* The condition readers and upgraders wait on
+			 */
+			libcthreads_internal_condition_t read_condition;
+
+			/* The condition writers and upgrading upgraders wait on
+			 */
+			libcthreads_internal_condition_t write_condition;
+
+			/* The number of readers, including the upgrader
+			 */
+			int number_of_readers;
+
+			/* The number of waiting readers, excluding upgraders
+			 */
+			int number_of_waiting_readers;
+
+			/* The number of waiting writers, including an upgrading upgrader
+			 */
+			int number_of_waiting_writers;
+
+			/* The number of waiting readers that are admitted before
+			 * the next writer, used by the fair policy
+			 */
+			int number_of_admitted_readers;
+
+			/* Value to indicate the lock is held by a writer
+			 */
+			uint8_t has_writer;
+
+			/* Value to indicate the lock is held by an upgrader
+			 */
+			uint8_t has_upgrader;
+
+		} managed;
+
+	} lock;
 };
 
+int libcthreads_internal_read_write_lock_initialize(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     int policy,
+     libcerror_error_t **error );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_read_write_lock_initialize(
      libcthreads_read_write_lock_t **read_write_lock,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_initialize_with_policy(
+     libcthreads_read_write_lock_t **read_write_lock,
+     int policy,
+     libcerror_error_t **error );
+
+int libcthreads_internal_read_write_lock_finalize(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     libcerror_error_t **error );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_read_write_lock_free(
      libcthreads_read_write_lock_t **read_write_lock,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_initialize_in_place(
+     libcthreads_read_write_lock_t **read_write_lock,
+     libcthreads_read_write_lock_storage_t *storage,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_initialize_in_place_with_policy(
+     libcthreads_read_write_lock_t **read_write_lock,
+     libcthreads_read_write_lock_storage_t *storage,
+     int policy,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_finalize_in_place(
+     libcthreads_read_write_lock_t **read_write_lock,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_get_policy(
+     libcthreads_read_write_lock_t *read_write_lock,
+     int *policy,
+     libcerror_error_t **error );
+
+int libcthreads_internal_read_write_lock_can_enter_shared(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     uint8_t is_upgrade );
+
+int libcthreads_internal_read_write_lock_can_enter_exclusive(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock );
+
+int libcthreads_internal_read_write_lock_enter_shared(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     uint8_t is_upgrade,
+     const uint64_t *deadline,
+     libcerror_error_t **error );
+
+int libcthreads_internal_read_write_lock_enter_exclusive(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     const uint64_t *deadline,
+     libcerror_error_t **error );
+
+int libcthreads_internal_read_write_lock_leave_shared(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     uint8_t is_upgrade,
+     libcerror_error_t **error );
+
+int libcthreads_internal_read_write_lock_leave_exclusive(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     libcerror_error_t **error );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_read_write_lock_grab_for_read(
      libcthreads_read_write_lock_t *read_write_lock,
@@ -109,6 +233,66 @@ int libcthreads_read_write_lock_release_for_write(
      libcthreads_read_write_lock_t *read_write_lock,
      libcerror_error_t **error );
 
+int libcthreads_internal_read_write_lock_try_grab_native(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     uint8_t is_exclusive,
+     uint32_t *error_code );
+
+int libcthreads_internal_read_write_lock_grab_until(
+     libcthreads_internal_read_write_lock_t *internal_read_write_lock,
+     uint8_t is_exclusive,
+     uint64_t deadline,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_try_grab_for_read(
+     libcthreads_read_write_lock_t *read_write_lock,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_grab_for_read_until(
+     libcthreads_read_write_lock_t *read_write_lock,
+     uint64_t deadline,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_timed_grab_for_read(
+     libcthreads_read_write_lock_t *read_write_lock,
+     uint64_t timeout,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_try_grab_for_write(
+     libcthreads_read_write_lock_t *read_write_lock,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_grab_for_write_until(
+     libcthreads_read_write_lock_t *read_write_lock,
+     uint64_t deadline,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_timed_grab_for_write(
+     libcthreads_read_write_lock_t *read_write_lock,
+     uint64_t timeout,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_grab_for_upgrade(
+     libcthreads_read_write_lock_t *read_write_lock,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_upgrade_to_write(
+     libcthreads_read_write_lock_t *read_write_lock,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_read_write_lock_release_for_upgrade(
+     libcthreads_read_write_lock_t *read_write_lock,
+     libcerror_error_t **error );
+
 #endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 #if defined( __cplusplus )
@@ -34,6 +34,7 @@
 #include <pthread.h>
 #endif
 
+#include "libcthreads_clock.h"
 #include "libcthreads_condition.h"
 #include "libcthreads_definitions.h"
 #include "libcthreads_libcerror.h"
@@ -44,6 +45,204 @@
 
 #if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
 
+/* Determines the time of the next scheduled run
+ * Make sure the condition mutex is grabbed before calling this function
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_repeating_thread_schedule_next_run(
+     libcthreads_internal_repeating_thread_t *internal_repeating_thread,
+     uint8_t is_scheduled_run,
+     libcerror_error_t **error )
+{
+	static char *function      = "libcthreads_internal_repeating_thread_schedule_next_run";
+	uint64_t monotonic_time    = 0;
+	uint64_t number_of_periods = 0;
+
+	if( internal_repeating_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid repeating thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_repeating_thread->schedule == LIBCTHREADS_REPEATING_THREAD_SCHEDULE_NONE )
+	{
+		return( 1 );
+	}
+	if( libcthreads_clock_get_monotonic_time(
+	     &monotonic_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic time.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_repeating_thread->schedule == LIBCTHREADS_REPEATING_THREAD_SCHEDULE_FIXED_DELAY )
+	{
+		if( internal_repeating_thread->interval > ( UINT64_MAX - monotonic_time ) )
+		{
+			internal_repeating_thread->next_run_time = UINT64_MAX;
+		}
+		else
+		{
+			internal_repeating_thread->next_run_time = monotonic_time + internal_repeating_thread->interval;
+		}
+	}
+	/* A fixed rate schedule is only advanced by scheduled runs and stays aligned
+	 * to the intervals of the first run, so the time it takes to wake up
+	 * and run does not accumulate into drift. Runs that were missed because
+	 * the start function took longer than the interval are skipped.
+	 */
+	else if( ( is_scheduled_run != 0 )
+	      && ( monotonic_time >= internal_repeating_thread->next_run_time ) )
+	{
+		number_of_periods = ( ( monotonic_time - internal_repeating_thread->next_run_time ) / internal_repeating_thread->interval ) + 1;
+
+		if( number_of_periods > ( ( UINT64_MAX - internal_repeating_thread->next_run_time ) / internal_repeating_thread->interval ) )
+		{
+			internal_repeating_thread->next_run_time = UINT64_MAX;
+		}
+		else
+		{
+			internal_repeating_thread->next_run_time += number_of_periods * internal_repeating_thread->interval;
+		}
+	}
+	return( 1 );
+}
+
+/* Runs the start function each time the thread is pushed or a scheduled run is due
+ * until the thread is joined
+ * Multiple pushes before the start function runs are coalesced into a single run
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_repeating_thread_run(
+     libcthreads_internal_repeating_thread_t *internal_repeating_thread )
+{
+	uint64_t monotonic_time   = 0;
+	uint8_t has_run           = 0;
+	uint8_t is_scheduled_run  = 0;
+	int start_function_result = 0;
+	int wait_result           = 0;
+
+	if( internal_repeating_thread == NULL )
+	{
+		return( -1 );
+	}
+	internal_repeating_thread->start_function_result = 1;
+
+	if( libcthreads_mutex_grab(
+	     internal_repeating_thread->condition_mutex,
+	     NULL ) != 1 )
+	{
+		internal_repeating_thread->start_function_result = -1;
+
+		return( -1 );
+	}
+	while( 1 )
+	{
+		/* A push that was given before the join is still honoured and
+		 * the start function runs at least once before the thread exits
+		 */
+		if( ( internal_repeating_thread->is_pushed == 0 )
+		 && ( internal_repeating_thread->status == LIBCTHREADS_STATUS_EXIT )
+		 && ( has_run != 0 ) )
+		{
+			break;
+		}
+		is_scheduled_run = 0;
+
+		if( internal_repeating_thread->schedule != LIBCTHREADS_REPEATING_THREAD_SCHEDULE_NONE )
+		{
+			if( libcthreads_clock_get_monotonic_time(
+			     &monotonic_time,
+			     NULL ) != 1 )
+			{
+				internal_repeating_thread->start_function_result = -1;
+
+				break;
+			}
+			if( monotonic_time >= internal_repeating_thread->next_run_time )
+			{
+				is_scheduled_run = 1;
+			}
+		}
+		if( ( internal_repeating_thread->is_pushed == 0 )
+		 && ( internal_repeating_thread->status != LIBCTHREADS_STATUS_EXIT )
+		 && ( is_scheduled_run == 0 ) )
+		{
+			if( internal_repeating_thread->schedule == LIBCTHREADS_REPEATING_THREAD_SCHEDULE_NONE )
+			{
+				wait_result = libcthreads_condition_wait(
+				               internal_repeating_thread->status_condition,
+				               internal_repeating_thread->condition_mutex,
+				               NULL );
+			}
+			else
+			{
+				wait_result = libcthreads_condition_wait_until(
+				               internal_repeating_thread->status_condition,
+				               internal_repeating_thread->condition_mutex,
+				               internal_repeating_thread->next_run_time,
+				               NULL );
+			}
+			if( wait_result == -1 )
+			{
+				internal_repeating_thread->start_function_result = -1;
+
+				break;
+			}
+			continue;
+		}
+		internal_repeating_thread->is_pushed = 0;
+
+		has_run = 1;
+
+		libcthreads_mutex_release(
+		 internal_repeating_thread->condition_mutex,
+		 NULL );
+
+		start_function_result = internal_repeating_thread->start_function(
+		                         internal_repeating_thread->start_function_arguments );
+
+		if( libcthreads_mutex_grab(
+		     internal_repeating_thread->condition_mutex,
+		     NULL ) != 1 )
+		{
+			internal_repeating_thread->start_function_result = -1;
+
+			return( -1 );
+		}
+		if( ( start_function_result != 1 )
+		 && ( internal_repeating_thread->start_function_result == 1 ) )
+		{
+			internal_repeating_thread->start_function_result = start_function_result;
+		}
+		if( libcthreads_internal_repeating_thread_schedule_next_run(
+		     internal_repeating_thread,
+		     is_scheduled_run,
+		     NULL ) != 1 )
+		{
+			internal_repeating_thread->start_function_result = -1;
+
+			break;
+		}
+	}
+	libcthreads_mutex_release(
+	 internal_repeating_thread->condition_mutex,
+	 NULL );
+
+	return( internal_repeating_thread->start_function_result );
+}
+
 #if defined( WINAPI )
 
 /* Start function helper function for WINAPI
@@ -54,7 +253,6 @@ DWORD WINAPI libcthreads_repeating_thread_start_function_helper(
 {
 	libcthreads_internal_repeating_thread_t *internal_repeating_thread = NULL;
 	DWORD result                                                       = 0;
-	int start_function_result                                          = 0;
 
 	if( arguments != NULL )
 	{
@@ -63,40 +261,8 @@ DWORD WINAPI libcthreads_repeating_thread_start_function_helper(
 		if( ( internal_repeating_thread != NULL )
 		 && ( internal_repeating_thread->start_function != NULL ) )
 		{
-			internal_repeating_thread->start_function_result = 1;
-
-			do
-			{
-				libcthreads_mutex_grab(
-				 internal_repeating_thread->condition_mutex,
-				 NULL );
-
-				/* Check for exit status in case of the situation where the thread
-				 * is created after the join has been called
-				 */
-				while( internal_repeating_thread->status != LIBCTHREADS_STATUS_EXIT )
-				{
-					libcthreads_condition_wait(
-					 internal_repeating_thread->status_condition,
-					 internal_repeating_thread->condition_mutex,
-					 NULL );
-				}
-				libcthreads_mutex_release(
-				 internal_repeating_thread->condition_mutex,
-				 NULL );
-
-				start_function_result = internal_repeating_thread->start_function(
-				                         internal_repeating_thread->start_function_arguments );
-
-				if( ( start_function_result != 1 )
-				 && ( internal_repeating_thread->start_function_result == 1 ) )
-				{
-					internal_repeating_thread->start_function_result = start_function_result;
-				}
-			}
-			while( internal_repeating_thread->status != LIBCTHREADS_STATUS_EXIT );
-
-			if( internal_repeating_thread->start_function_result != 1 )
+			if( libcthreads_internal_repeating_thread_run(
+			     internal_repeating_thread ) != 1 )
 			{
 				result = 1;
 			}
@@ -116,7 +282,6 @@ void *libcthreads_repeating_thread_start_function_helper(
 {
 	libcthreads_internal_repeating_thread_t *internal_repeating_thread = NULL;
 	void *result                                                       = NULL;
-	int start_function_result                                          = 0;
 
 	if( arguments != NULL )
 	{
@@ -125,38 +290,8 @@ void *libcthreads_repeating_thread_start_function_helper(
 		if( ( internal_repeating_thread != NULL )
 		 && ( internal_repeating_thread->start_function != NULL ) )
 		{
-			internal_repeating_thread->start_function_result = 1;
-
-			do
-			{
-				libcthreads_mutex_grab(
-				 internal_repeating_thread->condition_mutex,
-				 NULL );
-
-				/* Check for exit status in case of the situation where the thread
-				 * is created after the join has been called
-				 */
-				while( internal_repeating_thread->status != LIBCTHREADS_STATUS_EXIT )
-				{
-					libcthreads_condition_wait(
-					 internal_repeating_thread->status_condition,
-					 internal_repeating_thread->condition_mutex,
-					 NULL );
-				}
-				libcthreads_mutex_release(
-				 internal_repeating_thread->condition_mutex,
-				 NULL );
-
-				start_function_result = internal_repeating_thread->start_function(
-				                         internal_repeating_thread->start_function_arguments );
-
-				if( ( start_function_result != 1 )
-				 && ( internal_repeating_thread->start_function_result == 1 ) )
-				{
-					internal_repeating_thread->start_function_result = start_function_result;
-				}
-			}
-			while( internal_repeating_thread->status != LIBCTHREADS_STATUS_EXIT );
+			libcthreads_internal_repeating_thread_run(
+			 internal_repeating_thread );
 
 			result = (void *) &( internal_repeating_thread->start_function_result );
 		}
@@ -186,6 +321,7 @@ int libcthreads_repeating_thread_create(
 
 #if defined( WINAPI )
 	SECURITY_ATTRIBUTES *security_attributes                           = NULL;
+	SIZE_T stack_size                                                  = 0;
 	DWORD error_code                                                   = 0;
 
 #elif defined( HAVE_PTHREAD_H )
@@ -290,10 +426,11 @@ int libcthreads_repeating_thread_create(
 	if( thread_attributes != NULL )
 	{
 		security_attributes = &( ( (libcthreads_internal_thread_attributes_t *) thread_attributes )->security_attributes );
+		stack_size          = ( (libcthreads_internal_thread_attributes_t *) thread_attributes )->stack_size;
 	}
 	internal_repeating_thread->thread_handle = CreateThread(
 	                                            security_attributes,
-	                                            0, /* stack size */
+	                                            stack_size,
 	                                            &libcthreads_repeating_thread_start_function_helper,
 	                                            (void *) internal_repeating_thread,
 	                                            0, /* creation flags */
@@ -313,6 +450,10 @@ int libcthreads_repeating_thread_create(
 
 		goto on_error;
 	}
+	libcthreads_internal_thread_attributes_apply(
+	 (libcthreads_internal_thread_attributes_t *) thread_attributes,
+	 internal_repeating_thread->thread_handle );
+
 #elif defined( HAVE_PTHREAD_H )
 	if( thread_attributes != NULL )
 	{
@@ -350,6 +491,9 @@ int libcthreads_repeating_thread_create(
 
 			goto on_error;
 	}
+	libcthreads_internal_thread_attributes_apply(
+	 (libcthreads_internal_thread_attributes_t *) thread_attributes,
+	 internal_repeating_thread->thread );
 #endif
 	*repeating_thread = (libcthreads_repeating_thread_t *) internal_repeating_thread;
 
@@ -377,6 +521,7 @@ on_error:
 }
 
 /* Gives the thread a push
+ * Pushes given before the start function runs are coalesced into a single run
  * Returns 1 if successful or -1 on error
  */
 int libcthreads_repeating_thread_push(
@@ -400,8 +545,118 @@ int libcthreads_repeating_thread_push(
 	}
 	internal_repeating_thread = (libcthreads_internal_repeating_thread_t *) repeating_thread;
 
-/* TODO some work */
+	if( libcthreads_mutex_grab(
+	     internal_repeating_thread->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_repeating_thread->is_pushed = 1;
+
+	if( libcthreads_condition_signal(
+	     internal_repeating_thread->status_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to signal status condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     internal_repeating_thread->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the schedule of the thread
+ * The interval is in nanoseconds, the first scheduled run is one interval from now
+ * Scheduled runs are in addition to runs given by a push
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_repeating_thread_set_schedule(
+     libcthreads_repeating_thread_t *repeating_thread,
+     uint8_t schedule,
+     uint64_t interval,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_repeating_thread_t *internal_repeating_thread = NULL;
+	static char *function                                              = "libcthreads_repeating_thread_set_schedule";
+	uint64_t next_run_time                                             = 0;
+	int result                                                         = 1;
+
+	if( repeating_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid repeating thread.",
+		 function );
+
+		return( -1 );
+	}
+	internal_repeating_thread = (libcthreads_internal_repeating_thread_t *) repeating_thread;
+
+	if( ( schedule != LIBCTHREADS_REPEATING_THREAD_SCHEDULE_NONE )
+	 && ( schedule != LIBCTHREADS_REPEATING_THREAD_SCHEDULE_FIXED_RATE )
+	 && ( schedule != LIBCTHREADS_REPEATING_THREAD_SCHEDULE_FIXED_DELAY ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( schedule != LIBCTHREADS_REPEATING_THREAD_SCHEDULE_NONE )
+	 && ( interval == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid interval value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_clock_get_deadline(
+	     interval,
+	     &next_run_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine next run time.",
+		 function );
 
+		return( -1 );
+	}
 	if( libcthreads_mutex_grab(
 	     internal_repeating_thread->condition_mutex,
 	     error ) != 1 )
@@ -415,6 +670,12 @@ int libcthreads_repeating_thread_push(
 
 		return( -1 );
 	}
+	internal_repeating_thread->schedule      = schedule;
+	internal_repeating_thread->interval      = interval;
+	internal_repeating_thread->next_run_time = next_run_time;
+
+	/* Wake the thread so it waits for the new schedule
+	 */
 	if( libcthreads_condition_signal(
 	     internal_repeating_thread->status_condition,
 	     error ) != 1 )
@@ -445,6 +706,7 @@ int libcthreads_repeating_thread_push(
 }
 
 /* Joins the current with a specified repeating thread
+ * If the start function has not run yet, it is run once before the thread exits
  * The the thread is freed after join
  * Returns 1 if successful or -1 on error
  */
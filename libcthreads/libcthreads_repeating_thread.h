@@ -84,8 +84,32 @@ struct libcthreads_internal_repeating_thread
 	/* The status
 	 */
 	uint8_t status;
+
+	/* Value to indicate the thread was pushed since the start function last ran
+	 */
+	uint8_t is_pushed;
+
+	/* The schedule
+	 */
+	uint8_t schedule;
+
+	/* The schedule interval in nanoseconds
+	 */
+	uint64_t interval;
+
+	/* The monotonic time of the next scheduled run
+	 */
+	uint64_t next_run_time;
 };
 
+int libcthreads_internal_repeating_thread_schedule_next_run(
+     libcthreads_internal_repeating_thread_t *internal_repeating_thread,
+     uint8_t is_scheduled_run,
+     libcerror_error_t **error );
+
+int libcthreads_internal_repeating_thread_run(
+     libcthreads_internal_repeating_thread_t *internal_repeating_thread );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_repeating_thread_create(
      libcthreads_repeating_thread_t **repeating_thread,
@@ -100,6 +124,13 @@ int libcthreads_repeating_thread_push(
      libcthreads_repeating_thread_t *repeating_thread,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_repeating_thread_set_schedule(
+     libcthreads_repeating_thread_t *repeating_thread,
+     uint8_t schedule,
+     uint64_t interval,
+     libcerror_error_t **error );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_repeating_thread_join(
      libcthreads_repeating_thread_t **repeating_thread,
@@ -0,0 +1,577 @@
+/*
+ * Sharded counter functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Required for sched_getcpu
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_SCHED_GETCPU ) && !defined( WINAPI )
+#include <sched.h>
+#endif
+
+#include "libcthreads_atomic.h"
+#include "libcthreads_definitions.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_sharded_counter.h"
+#include "libcthreads_topology.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The shards and total are only used as counters and do not order other memory accesses
+ */
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+#define libcthreads_sharded_counter_get_shard_value( value ) \
+	(uint64_t) libcthreads_internal_atomic_load_64( value, LIBCTHREADS_MEMORY_ORDER_RELAXED )
+
+#define libcthreads_sharded_counter_add_shard_value( value, addend ) \
+	(uint64_t) libcthreads_internal_atomic_fetch_add_64( value, addend, LIBCTHREADS_MEMORY_ORDER_RELAXED )
+
+#define libcthreads_sharded_counter_take_shard_value( value ) \
+	(uint64_t) libcthreads_internal_atomic_exchange_64( value, 0, LIBCTHREADS_MEMORY_ORDER_RELAXED )
+
+#else
+#define libcthreads_sharded_counter_get_shard_value( value ) \
+	libcthreads_atomic_load_64( value, LIBCTHREADS_MEMORY_ORDER_RELAXED )
+
+#define libcthreads_sharded_counter_add_shard_value( value, addend ) \
+	libcthreads_atomic_fetch_add_64( value, addend, LIBCTHREADS_MEMORY_ORDER_RELAXED )
+
+#define libcthreads_sharded_counter_take_shard_value( value ) \
+	libcthreads_atomic_exchange_64( value, 0, LIBCTHREADS_MEMORY_ORDER_RELAXED )
+
+#endif
+
+/* Creates a sharded counter
+ * Make sure the value sharded_counter is referencing, is set to NULL
+ * The number of shards is the number of CPUs if 0
+ * The flush threshold is the absolute value a shard accumulates before it is
+ * flushed into the total, LIBCTHREADS_SHARDED_COUNTER_DEFAULT_FLUSH_THRESHOLD is used if 0
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_sharded_counter_initialize(
+     libcthreads_sharded_counter_t **sharded_counter,
+     int number_of_shards,
+     int64_t flush_threshold,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_sharded_counter_t *internal_sharded_counter = NULL;
+	libcthreads_topology_t *topology                                 = NULL;
+	static char *function                                            = "libcthreads_sharded_counter_initialize";
+	size_t shards_data_size                                          = 0;
+
+	if( sharded_counter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sharded counter.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sharded_counter != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sharded counter value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_shards < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of shards value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( flush_threshold < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid flush threshold value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_shards == 0 )
+	{
+		if( libcthreads_topology_get(
+		     &topology,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve topology.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_topology_get_number_of_cpus(
+		     topology,
+		     &number_of_shards,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of CPUs.",
+			 function );
+
+			return( -1 );
+		}
+		if( number_of_shards <= 0 )
+		{
+			number_of_shards = 1;
+		}
+	}
+	if( (size_t) number_of_shards > (size_t) ( ( SSIZE_MAX / LIBCTHREADS_CACHE_LINE_SIZE ) - 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of shards value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( flush_threshold == 0 )
+	{
+		flush_threshold = LIBCTHREADS_SHARDED_COUNTER_DEFAULT_FLUSH_THRESHOLD;
+	}
+	internal_sharded_counter = memory_allocate_structure(
+	                            libcthreads_internal_sharded_counter_t );
+
+	if( internal_sharded_counter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sharded counter.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_sharded_counter,
+	     0,
+	     sizeof( libcthreads_internal_sharded_counter_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sharded counter.",
+		 function );
+
+		memory_free(
+		 internal_sharded_counter );
+
+		return( -1 );
+	}
+	/* The total and every shard are stored in a separate cache line, so that
+	 * threads that add to different shards do not contend for the same cache line
+	 */
+	shards_data_size = ( (size_t) ( number_of_shards + 2 ) * LIBCTHREADS_CACHE_LINE_SIZE ) - 1;
+
+	internal_sharded_counter->shards_data = (uint8_t *) memory_allocate(
+	                                                     shards_data_size );
+
+	if( internal_sharded_counter->shards_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shards data.",
+		 function );
+
+		goto on_error;
+	}
+	internal_sharded_counter->total = (volatile uint64_t *) ( ( (intptr_t) internal_sharded_counter->shards_data + LIBCTHREADS_CACHE_LINE_SIZE - 1 ) & ~( (intptr_t) LIBCTHREADS_CACHE_LINE_SIZE - 1 ) );
+
+	if( memory_set(
+	     (void *) internal_sharded_counter->total,
+	     0,
+	     (size_t) ( number_of_shards + 1 ) * LIBCTHREADS_CACHE_LINE_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shards.",
+		 function );
+
+		goto on_error;
+	}
+	internal_sharded_counter->shards           = &( ( (uint8_t *) internal_sharded_counter->total )[ LIBCTHREADS_CACHE_LINE_SIZE ] );
+	internal_sharded_counter->number_of_shards = number_of_shards;
+	internal_sharded_counter->flush_threshold  = flush_threshold;
+
+	*sharded_counter = (libcthreads_sharded_counter_t *) internal_sharded_counter;
+
+	return( 1 );
+
+on_error:
+	if( internal_sharded_counter != NULL )
+	{
+		if( internal_sharded_counter->shards_data != NULL )
+		{
+			memory_free(
+			 internal_sharded_counter->shards_data );
+		}
+		memory_free(
+		 internal_sharded_counter );
+	}
+	return( -1 );
+}
+
+/* Frees a sharded counter
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_sharded_counter_free(
+     libcthreads_sharded_counter_t **sharded_counter,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_sharded_counter_t *internal_sharded_counter = NULL;
+	static char *function                                            = "libcthreads_sharded_counter_free";
+
+	if( sharded_counter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sharded counter.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sharded_counter != NULL )
+	{
+		internal_sharded_counter = (libcthreads_internal_sharded_counter_t *) *sharded_counter;
+		*sharded_counter         = NULL;
+
+		memory_free(
+		 internal_sharded_counter->shards_data );
+
+		memory_free(
+		 internal_sharded_counter );
+	}
+	return( 1 );
+}
+
+/* Determines the shard of the calling thread
+ * The shard is based on the CPU the thread is running on if available,
+ * otherwise on the thread, a thread that migrates to another CPU can still
+ * add to the previous shard, which is safe since the shards are updated atomically
+ * Returns the shard index
+ */
+int libcthreads_internal_sharded_counter_get_shard_index(
+     libcthreads_internal_sharded_counter_t *internal_sharded_counter )
+{
+#if !defined( WINAPI ) || ( WINVER < 0x0600 )
+	uintptr_t thread_value = 0;
+	uint32_t hash_value    = 0;
+#endif
+#if defined( HAVE_SCHED_GETCPU ) && !defined( WINAPI )
+	int cpu_number         = 0;
+#endif
+
+	if( internal_sharded_counter->number_of_shards == 1 )
+	{
+		return( 0 );
+	}
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	return( (int) ( GetCurrentProcessorNumber() % (DWORD) internal_sharded_counter->number_of_shards ) );
+
+#else
+#if defined( HAVE_SCHED_GETCPU ) && !defined( WINAPI )
+	cpu_number = sched_getcpu();
+
+	if( cpu_number >= 0 )
+	{
+		return( cpu_number % internal_sharded_counter->number_of_shards );
+	}
+#endif
+#if defined( WINAPI )
+	thread_value = (uintptr_t) GetCurrentThreadId();
+#else
+	/* The stacks of the threads do not overlap, hence the address
+	 * of a stack variable identifies the calling thread
+	 */
+	thread_value = ( (uintptr_t) &thread_value ) >> 12;
+#endif
+	/* The upper bits of the multiplicative hash also depend on the upper bits
+	 * of the thread value, which are the only bits that differ for stacks
+	 * that are aligned on a large power of 2
+	 */
+	hash_value = (uint32_t) thread_value * (uint32_t) 0x9e3779b1UL;
+
+	return( (int) ( ( hash_value >> 16 ) % (uint32_t) internal_sharded_counter->number_of_shards ) );
+
+#endif /* defined( WINAPI ) && ( WINVER >= 0x0600 ) */
+}
+
+/* Adds a value to the sharded counter
+ * The value is added to the shard of the calling thread, the shard is flushed
+ * into the total once its absolute value reaches the flush threshold
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_sharded_counter_add(
+     libcthreads_sharded_counter_t *sharded_counter,
+     int64_t value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_sharded_counter_t *internal_sharded_counter = NULL;
+	volatile uint64_t *shard                                         = NULL;
+	static char *function                                            = "libcthreads_sharded_counter_add";
+	int64_t shard_value                                              = 0;
+	int shard_index                                                  = 0;
+
+	if( sharded_counter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sharded counter.",
+		 function );
+
+		return( -1 );
+	}
+	internal_sharded_counter = (libcthreads_internal_sharded_counter_t *) sharded_counter;
+
+	shard_index = libcthreads_internal_sharded_counter_get_shard_index(
+	               internal_sharded_counter );
+
+	shard = (volatile uint64_t *) &( internal_sharded_counter->shards[ shard_index * LIBCTHREADS_CACHE_LINE_SIZE ] );
+
+	/* The shard values are stored as unsigned integers so that an overflow wraps around
+	 */
+	shard_value = (int64_t) ( libcthreads_sharded_counter_add_shard_value(
+	                           shard,
+	                           (uint64_t) value ) + (uint64_t) value );
+
+	if( ( shard_value >= internal_sharded_counter->flush_threshold )
+	 || ( shard_value <= -( internal_sharded_counter->flush_threshold ) ) )
+	{
+		/* Other threads can add to the shard in the meantime, hence the value
+		 * that is flushed is the value that was taken from the shard
+		 */
+		shard_value = (int64_t) libcthreads_sharded_counter_take_shard_value(
+		                         shard );
+
+		libcthreads_sharded_counter_add_shard_value(
+		 internal_sharded_counter->total,
+		 (uint64_t) shard_value );
+	}
+	return( 1 );
+}
+
+/* Increments the sharded counter
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_sharded_counter_increment(
+     libcthreads_sharded_counter_t *sharded_counter,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_sharded_counter_increment";
+
+	if( libcthreads_sharded_counter_add(
+	     sharded_counter,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add to sharded counter.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the value of the sharded counter
+ * The value is determined by folding the total and all the shards, it is exact
+ * when no other thread is adding to the sharded counter, otherwise it can be off
+ * by the values that are being added or flushed concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_sharded_counter_get_value(
+     libcthreads_sharded_counter_t *sharded_counter,
+     int64_t *value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_sharded_counter_t *internal_sharded_counter = NULL;
+	static char *function                                            = "libcthreads_sharded_counter_get_value";
+	uint64_t folded_value                                            = 0;
+	int shard_index                                                  = 0;
+
+	if( sharded_counter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sharded counter.",
+		 function );
+
+		return( -1 );
+	}
+	internal_sharded_counter = (libcthreads_internal_sharded_counter_t *) sharded_counter;
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	folded_value = libcthreads_sharded_counter_get_shard_value(
+	                internal_sharded_counter->total );
+
+	for( shard_index = 0;
+	     shard_index < internal_sharded_counter->number_of_shards;
+	     shard_index++ )
+	{
+		folded_value += libcthreads_sharded_counter_get_shard_value(
+		                 (volatile uint64_t *) &( internal_sharded_counter->shards[ shard_index * LIBCTHREADS_CACHE_LINE_SIZE ] ) );
+	}
+	*value = (int64_t) folded_value;
+
+	return( 1 );
+}
+
+/* Retrieves the approximate value of the sharded counter
+ * Only the total is read, which differs from the value by the values
+ * that have not yet been flushed from the shards, this is less than
+ * the number of shards times the flush threshold
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_sharded_counter_get_approximate_value(
+     libcthreads_sharded_counter_t *sharded_counter,
+     int64_t *value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_sharded_counter_t *internal_sharded_counter = NULL;
+	static char *function                                            = "libcthreads_sharded_counter_get_approximate_value";
+
+	if( sharded_counter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sharded counter.",
+		 function );
+
+		return( -1 );
+	}
+	internal_sharded_counter = (libcthreads_internal_sharded_counter_t *) sharded_counter;
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	*value = (int64_t) libcthreads_sharded_counter_get_shard_value(
+	                    internal_sharded_counter->total );
+
+	return( 1 );
+}
+
+/* Retrieves the number of shards
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_sharded_counter_get_number_of_shards(
+     libcthreads_sharded_counter_t *sharded_counter,
+     int *number_of_shards,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_sharded_counter_t *internal_sharded_counter = NULL;
+	static char *function                                            = "libcthreads_sharded_counter_get_number_of_shards";
+
+	if( sharded_counter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sharded counter.",
+		 function );
+
+		return( -1 );
+	}
+	internal_sharded_counter = (libcthreads_internal_sharded_counter_t *) sharded_counter;
+
+	if( number_of_shards == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of shards.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_shards = internal_sharded_counter->number_of_shards;
+
+	return( 1 );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
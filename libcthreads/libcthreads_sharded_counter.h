@@ -0,0 +1,119 @@
+/*
+ * Sharded counter functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_SHARDED_COUNTER_H )
+#define _LIBCTHREADS_INTERNAL_SHARDED_COUNTER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_atomic.h"
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The default number of units a shard accumulates before it is flushed into the total
+ */
+#define LIBCTHREADS_SHARDED_COUNTER_DEFAULT_FLUSH_THRESHOLD	1024
+
+typedef struct libcthreads_internal_sharded_counter libcthreads_internal_sharded_counter_t;
+
+struct libcthreads_internal_sharded_counter
+{
+	/* The shards data, this contains the total and the shards aligned on a cache line boundary
+	 */
+	uint8_t *shards_data;
+
+	/* The total, which contains the values flushed from the shards
+	 */
+	volatile uint64_t *total;
+
+	/* The shards, each shard is stored in a separate cache line
+	 */
+	uint8_t *shards;
+
+	/* The number of shards
+	 */
+	int number_of_shards;
+
+	/* The flush threshold
+	 */
+	int64_t flush_threshold;
+};
+
+LIBCTHREADS_EXTERN \
+int libcthreads_sharded_counter_initialize(
+     libcthreads_sharded_counter_t **sharded_counter,
+     int number_of_shards,
+     int64_t flush_threshold,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_sharded_counter_free(
+     libcthreads_sharded_counter_t **sharded_counter,
+     libcerror_error_t **error );
+
+int libcthreads_internal_sharded_counter_get_shard_index(
+     libcthreads_internal_sharded_counter_t *internal_sharded_counter );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_sharded_counter_add(
+     libcthreads_sharded_counter_t *sharded_counter,
+     int64_t value,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_sharded_counter_increment(
+     libcthreads_sharded_counter_t *sharded_counter,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_sharded_counter_get_value(
+     libcthreads_sharded_counter_t *sharded_counter,
+     int64_t *value,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_sharded_counter_get_approximate_value(
+     libcthreads_sharded_counter_t *sharded_counter,
+     int64_t *value,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_sharded_counter_get_number_of_shards(
+     libcthreads_sharded_counter_t *sharded_counter,
+     int *number_of_shards,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_SHARDED_COUNTER_H ) */
+
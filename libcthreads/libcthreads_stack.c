@@ -0,0 +1,586 @@
+/*
+ * Lock-free stack functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libcthreads_definitions.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_mutex.h"
+#include "libcthreads_stack.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The next node of a node can be read by one popping thread while another
+ * popping thread resets it, the compare and exchange of the head orders
+ * these accesses, hence the next node itself only needs relaxed atomics
+ */
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+#define libcthreads_stack_get_next_node( node ) \
+	(libcthreads_stack_node_t *) libcthreads_internal_atomic_load_pointer( &( ( node )->next_node ), LIBCTHREADS_MEMORY_ORDER_RELAXED )
+
+#define libcthreads_stack_set_next_node( node, value ) \
+	libcthreads_internal_atomic_store_pointer( &( ( node )->next_node ), value, LIBCTHREADS_MEMORY_ORDER_RELAXED )
+
+#else
+#define libcthreads_stack_get_next_node( node ) \
+	(libcthreads_stack_node_t *) libcthreads_atomic_load_pointer( (intptr_t * volatile *) &( ( node )->next_node ), LIBCTHREADS_MEMORY_ORDER_RELAXED )
+
+#define libcthreads_stack_set_next_node( node, value ) \
+	libcthreads_atomic_store_pointer( (intptr_t * volatile *) &( ( node )->next_node ), (intptr_t *) ( value ), LIBCTHREADS_MEMORY_ORDER_RELAXED )
+
+#endif
+
+/* Creates a stack
+ * Make sure the value stack is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_stack_initialize(
+     libcthreads_stack_t **stack,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_stack_t *internal_stack = NULL;
+	static char *function                        = "libcthreads_stack_initialize";
+	size_t head_data_size                        = 0;
+
+	if( stack == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stack.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stack != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stack value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stack = memory_allocate_structure(
+	                  libcthreads_internal_stack_t );
+
+	if( internal_stack == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stack.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_stack,
+	     0,
+	     sizeof( libcthreads_internal_stack_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stack.",
+		 function );
+
+		memory_free(
+		 internal_stack );
+
+		return( -1 );
+	}
+	/* The head is aligned on a cache line boundary, which satisfies the alignment
+	 * required by the double width compare and exchange and prevents the head
+	 * from sharing a cache line with other data
+	 */
+	head_data_size = ( 2 * LIBCTHREADS_CACHE_LINE_SIZE ) - 1;
+
+	internal_stack->head_data = (uint8_t *) memory_allocate(
+	                                         head_data_size );
+
+	if( internal_stack->head_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create head data.",
+		 function );
+
+		goto on_error;
+	}
+	internal_stack->head = (libcthreads_stack_head_t *) ( ( (intptr_t) internal_stack->head_data + LIBCTHREADS_CACHE_LINE_SIZE - 1 ) & ~( (intptr_t) LIBCTHREADS_CACHE_LINE_SIZE - 1 ) );
+
+	if( memory_set(
+	     internal_stack->head,
+	     0,
+	     sizeof( libcthreads_stack_head_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear head.",
+		 function );
+
+		goto on_error;
+	}
+#if !defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+	if( libcthreads_mutex_initialize(
+	     &( internal_stack->head_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create head mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	*stack = (libcthreads_stack_t *) internal_stack;
+
+	return( 1 );
+
+on_error:
+	if( internal_stack != NULL )
+	{
+		if( internal_stack->head_data != NULL )
+		{
+			memory_free(
+			 internal_stack->head_data );
+		}
+		memory_free(
+		 internal_stack );
+	}
+	return( -1 );
+}
+
+/* Frees a stack
+ * The stack does not own the nodes, nodes that are still on the stack are not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_stack_free(
+     libcthreads_stack_t **stack,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_stack_t *internal_stack = NULL;
+	static char *function                        = "libcthreads_stack_free";
+	int result                                   = 1;
+
+	if( stack == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stack.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stack != NULL )
+	{
+		internal_stack = (libcthreads_internal_stack_t *) *stack;
+		*stack         = NULL;
+
+#if !defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+		if( libcthreads_mutex_free(
+		     &( internal_stack->head_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free head mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 internal_stack->head_data );
+
+		memory_free(
+		 internal_stack );
+	}
+	return( result );
+}
+
+/* Retrieves a copy of the head
+ * The top node and tag can be read separately, since a copy that is
+ * torn by a concurrent update fails the subsequent compare and exchange
+ */
+void libcthreads_internal_stack_get_head(
+      libcthreads_internal_stack_t *internal_stack,
+      libcthreads_stack_head_t *head )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+	head->value.tag      = (uintptr_t) libcthreads_internal_atomic_load_pointer(
+	                                    &( internal_stack->head->value.tag ),
+	                                    LIBCTHREADS_MEMORY_ORDER_ACQUIRE );
+	head->value.top_node = (libcthreads_stack_node_t *) libcthreads_internal_atomic_load_pointer(
+	                                                     &( internal_stack->head->value.top_node ),
+	                                                     LIBCTHREADS_MEMORY_ORDER_ACQUIRE );
+
+#else
+	head->value.tag      = internal_stack->head->value.tag;
+	head->value.top_node = internal_stack->head->value.top_node;
+
+#endif
+}
+
+/* Replaces the head with the new head if it still equals the expected head
+ * Without a double width compare and exchange the head mutex must be grabbed
+ * Returns 1 if the head was replaced or 0 if not
+ */
+int libcthreads_internal_stack_compare_exchange_head(
+     libcthreads_internal_stack_t *internal_stack,
+     libcthreads_stack_head_t *expected_head,
+     libcthreads_stack_head_t *new_head )
+{
+#if defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+	return( libcthreads_atomic_compare_exchange_double_width(
+	         &( internal_stack->head->double_width ),
+	         &( expected_head->double_width ),
+	         &( new_head->double_width ) ) );
+
+#else
+	if( ( internal_stack->head->value.top_node != expected_head->value.top_node )
+	 || ( internal_stack->head->value.tag != expected_head->value.tag ) )
+	{
+		return( 0 );
+	}
+	internal_stack->head->value.top_node = new_head->value.top_node;
+	internal_stack->head->value.tag      = new_head->value.tag;
+
+	return( 1 );
+
+#endif
+}
+
+/* Pushes a node onto the stack
+ * The node is typically embedded in the object that is pushed and must
+ * remain valid while the stack is used, since a concurrent pop can still
+ * read its next node after the node was popped by another thread
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_stack_push(
+     libcthreads_stack_t *stack,
+     libcthreads_stack_node_t *node,
+     libcerror_error_t **error )
+{
+	libcthreads_stack_head_t expected_head;
+	libcthreads_stack_head_t new_head;
+
+	libcthreads_internal_stack_t *internal_stack = NULL;
+	static char *function                        = "libcthreads_stack_push";
+
+	if( stack == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stack.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stack = (libcthreads_internal_stack_t *) stack;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+	if( libcthreads_mutex_grab(
+	     internal_stack->head_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab head mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	do
+	{
+		libcthreads_internal_stack_get_head(
+		 internal_stack,
+		 &expected_head );
+
+		libcthreads_stack_set_next_node(
+		 node,
+		 expected_head.value.top_node );
+
+		new_head.value.top_node = node;
+		new_head.value.tag      = expected_head.value.tag;
+	}
+	while( libcthreads_internal_stack_compare_exchange_head(
+	        internal_stack,
+	        &expected_head,
+	        &new_head ) == 0 );
+
+#if !defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+	if( libcthreads_mutex_release(
+	     internal_stack->head_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release head mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Pops the top node from the stack
+ * Returns 1 if successful, 0 if the stack is empty or -1 on error
+ */
+int libcthreads_stack_pop(
+     libcthreads_stack_t *stack,
+     libcthreads_stack_node_t **node,
+     libcerror_error_t **error )
+{
+	libcthreads_stack_head_t expected_head;
+	libcthreads_stack_head_t new_head;
+
+	libcthreads_internal_stack_t *internal_stack = NULL;
+	static char *function                        = "libcthreads_stack_pop";
+
+	if( stack == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stack.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stack = (libcthreads_internal_stack_t *) stack;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+	if( libcthreads_mutex_grab(
+	     internal_stack->head_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab head mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	do
+	{
+		libcthreads_internal_stack_get_head(
+		 internal_stack,
+		 &expected_head );
+
+		if( expected_head.value.top_node == NULL )
+		{
+			break;
+		}
+		/* The top node can be popped by another thread after the head was read,
+		 * in which case its next node is stale or reset, but the tag has changed
+		 * and the compare and exchange fails, so the value read is never used.
+		 * The node itself remains valid since nodes must outlive the stack.
+		 */
+		new_head.value.top_node = libcthreads_stack_get_next_node(
+		                           expected_head.value.top_node );
+		new_head.value.tag      = expected_head.value.tag + 1;
+	}
+	while( libcthreads_internal_stack_compare_exchange_head(
+	        internal_stack,
+	        &expected_head,
+	        &new_head ) == 0 );
+
+#if !defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+	if( libcthreads_mutex_release(
+	     internal_stack->head_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release head mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( expected_head.value.top_node == NULL )
+	{
+		return( 0 );
+	}
+	libcthreads_stack_set_next_node(
+	 expected_head.value.top_node,
+	 NULL );
+
+	*node = expected_head.value.top_node;
+
+	return( 1 );
+}
+
+/* Pops all nodes from the stack
+ * The nodes are linked by their next node, starting with the top node
+ * Returns 1 if successful, 0 if the stack is empty or -1 on error
+ */
+int libcthreads_stack_pop_all(
+     libcthreads_stack_t *stack,
+     libcthreads_stack_node_t **first_node,
+     libcerror_error_t **error )
+{
+	libcthreads_stack_head_t expected_head;
+	libcthreads_stack_head_t new_head;
+
+	libcthreads_internal_stack_t *internal_stack = NULL;
+	static char *function                        = "libcthreads_stack_pop_all";
+
+	if( stack == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stack.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stack = (libcthreads_internal_stack_t *) stack;
+
+	if( first_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first node.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+	if( libcthreads_mutex_grab(
+	     internal_stack->head_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab head mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	do
+	{
+		libcthreads_internal_stack_get_head(
+		 internal_stack,
+		 &expected_head );
+
+		if( expected_head.value.top_node == NULL )
+		{
+			break;
+		}
+		new_head.value.top_node = NULL;
+		new_head.value.tag      = expected_head.value.tag + 1;
+	}
+	while( libcthreads_internal_stack_compare_exchange_head(
+	        internal_stack,
+	        &expected_head,
+	        &new_head ) == 0 );
+
+#if !defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+	if( libcthreads_mutex_release(
+	     internal_stack->head_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release head mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( expected_head.value.top_node == NULL )
+	{
+		return( 0 );
+	}
+	*first_node = expected_head.value.top_node;
+
+	return( 1 );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,125 @@
+/*
+ * Lock-free stack functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_STACK_H )
+#define _LIBCTHREADS_INTERNAL_STACK_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_atomic.h"
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The top node and tag of the stack head are updated together using a double width
+ * compare and exchange, if not available the stack head is protected by a mutex
+ */
+typedef union libcthreads_stack_head libcthreads_stack_head_t;
+
+union libcthreads_stack_head
+{
+	struct
+	{
+		/* The top node
+		 */
+		libcthreads_stack_node_t *top_node;
+
+		/* The tag, which is incremented every time a node is popped
+		 * to detect that the top node was popped and pushed again
+		 */
+		uintptr_t tag;
+
+	} value;
+
+	libcthreads_atomic_double_width_t double_width;
+};
+
+typedef struct libcthreads_internal_stack libcthreads_internal_stack_t;
+
+struct libcthreads_internal_stack
+{
+	/* The head data, this contains the head aligned on a cache line boundary
+	 */
+	uint8_t *head_data;
+
+	/* The head
+	 */
+	libcthreads_stack_head_t *head;
+
+#if !defined( LIBCTHREADS_ATOMIC_HAVE_DOUBLE_WIDTH_COMPARE_EXCHANGE )
+	/* The head mutex
+	 */
+	libcthreads_mutex_t *head_mutex;
+#endif
+};
+
+LIBCTHREADS_EXTERN \
+int libcthreads_stack_initialize(
+     libcthreads_stack_t **stack,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_stack_free(
+     libcthreads_stack_t **stack,
+     libcerror_error_t **error );
+
+void libcthreads_internal_stack_get_head(
+      libcthreads_internal_stack_t *internal_stack,
+      libcthreads_stack_head_t *head );
+
+int libcthreads_internal_stack_compare_exchange_head(
+     libcthreads_internal_stack_t *internal_stack,
+     libcthreads_stack_head_t *expected_head,
+     libcthreads_stack_head_t *new_head );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_stack_push(
+     libcthreads_stack_t *stack,
+     libcthreads_stack_node_t *node,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_stack_pop(
+     libcthreads_stack_t *stack,
+     libcthreads_stack_node_t **node,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_stack_pop_all(
+     libcthreads_stack_t *stack,
+     libcthreads_stack_node_t **first_node,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_STACK_H ) */
+
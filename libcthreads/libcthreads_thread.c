@@ -72,14 +72,14 @@ DWORD WINAPI libcthreads_thread_callback_function_helper(
 #elif defined( HAVE_PTHREAD_H )
 
 /* Start function helper function for pthread
- * Returns a pointer to a newly allocated int containing 1 if successful or -1 on error
+ * Returns the callback function result, 1 if successful or -1 on error, stored in the pointer value
  * NULL is return if the helper function was unable to run the callback
  */
 void *libcthreads_thread_callback_function_helper(
        void *arguments )
 {
 	libcthreads_internal_thread_t *internal_thread = NULL;
-	int *result                                    = NULL;
+	intptr_t result                                = 0;
 
 	if( arguments != NULL )
 	{
@@ -88,14 +88,8 @@ void *libcthreads_thread_callback_function_helper(
 		if( ( internal_thread != NULL )
 		 && ( internal_thread->callback_function != NULL ) )
 		{
-			result = (int *) memory_allocate(
-			                  sizeof( int ) );
-
-			if( result != NULL )
-			{
-				*result = internal_thread->callback_function(
-				           internal_thread->callback_function_arguments );
-			}
+			result = (intptr_t) internal_thread->callback_function(
+			                     internal_thread->callback_function_arguments );
 		}
 	}
 	pthread_exit(
@@ -124,6 +118,7 @@ int libcthreads_thread_create(
 #if defined( WINAPI )
 	SECURITY_ATTRIBUTES *security_attributes       = NULL;
 	HANDLE thread_handle                           = NULL;
+	SIZE_T stack_size                              = 0;
 	DWORD error_code                               = 0;
 
 #elif defined( HAVE_PTHREAD_H )
@@ -202,10 +197,11 @@ int libcthreads_thread_create(
 	if( thread_attributes != NULL )
 	{
 		security_attributes = &( ( (libcthreads_internal_thread_attributes_t *) thread_attributes )->security_attributes );
+		stack_size          = ( (libcthreads_internal_thread_attributes_t *) thread_attributes )->stack_size;
 	}
 	thread_handle = CreateThread(
 	                 security_attributes,
-	                 0, /* stack size */
+	                 stack_size,
 	                 &libcthreads_thread_callback_function_helper,
 	                 (void *) internal_thread,
 	                 0, /* creation flags */
@@ -227,6 +223,10 @@ int libcthreads_thread_create(
 	}
 	internal_thread->thread_handle = thread_handle;
 
+	libcthreads_internal_thread_attributes_apply(
+	 (libcthreads_internal_thread_attributes_t *) thread_attributes,
+	 thread_handle );
+
 #elif defined( HAVE_PTHREAD_H )
 	if( thread_attributes != NULL )
 	{
@@ -264,6 +264,9 @@ int libcthreads_thread_create(
 
 			goto on_error;
 	}
+	libcthreads_internal_thread_attributes_apply(
+	 (libcthreads_internal_thread_attributes_t *) thread_attributes,
+	 internal_thread->thread );
 #endif
 	*thread = (libcthreads_thread_t *) internal_thread;
 
@@ -295,7 +298,7 @@ int libcthreads_thread_join(
 	DWORD wait_status                              = 0;
 
 #elif defined( HAVE_PTHREAD_H )
-	int *thread_return_value                       = NULL;
+	void *thread_return_value                      = NULL;
 	int pthread_result                             = 0;
 #endif
 
@@ -347,7 +350,7 @@ int libcthreads_thread_join(
 #elif defined( HAVE_PTHREAD_H )
 	pthread_result = pthread_join(
 	                  internal_thread->thread,
-	                  (void **) &thread_return_value );
+	                  &thread_return_value );
 
 	if( pthread_result == EDEADLK )
 	{
@@ -375,7 +378,7 @@ int libcthreads_thread_join(
 	/* If the thread returns NULL it never got around to launching the callback function
 	 */
 	else if( ( thread_return_value != NULL )
-	      && ( *thread_return_value != 1 ) )
+	      && ( (intptr_t) thread_return_value != 1 ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -383,17 +386,10 @@ int libcthreads_thread_join(
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
 		 "%s: thread returned an error status of: %d.",
 		 function,
-		 *thread_return_value );
+		 (int) (intptr_t) thread_return_value );
 
 		result = -1;
 	}
-	if( thread_return_value != NULL )
-	{
-		memory_free(
-		 thread_return_value );
-
-		thread_return_value = NULL;
-	}
 #endif
 	memory_free(
 	 internal_thread );
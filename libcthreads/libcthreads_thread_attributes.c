@@ -19,17 +19,29 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+/* Required for pthread_setname_np
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
 #include <common.h>
 #include <memory.h>
+#include <narrow_string.h>
 #include <types.h>
 
 #if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <errno.h>
 #include <pthread.h>
+#include <sched.h>
 #endif
 
+#include "libcthreads_definitions.h"
+
 #include "libcthreads_libcerror.h"
 #include "libcthreads_thread_attributes.h"
 #include "libcthreads_types.h"
+#include "libcthreads_unused.h"
 
 #if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
 
@@ -44,6 +56,10 @@ int libcthreads_thread_attributes_initialize(
 	libcthreads_internal_thread_attributes_t *internal_thread_attributes = NULL;
 	static char *function                                                = "libcthreads_thread_attributes_initialize";
 
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result                                                   = 0;
+#endif
+
 	if( thread_attributes == NULL )
 	{
 		libcerror_error_set(
@@ -97,7 +113,26 @@ int libcthreads_thread_attributes_initialize(
 
 		return( -1 );
 	}
-/* TODO */
+#if defined( WINAPI )
+	internal_thread_attributes->security_attributes.nLength = sizeof( SECURITY_ATTRIBUTES );
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_attr_init(
+	                  &( internal_thread_attributes->attributes ) );
+
+	if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize attributes.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	*thread_attributes = (libcthreads_thread_attributes_t *) internal_thread_attributes;
 
 	return( 1 );
@@ -122,6 +157,10 @@ int libcthreads_thread_attributes_free(
 	static char *function                                                = "libcthreads_thread_attributes_free";
 	int result                                                           = 1;
 
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result                                                   = 0;
+#endif
+
 	if( thread_attributes == NULL )
 	{
 		libcerror_error_set(
@@ -138,12 +177,439 @@ int libcthreads_thread_attributes_free(
 		internal_thread_attributes = (libcthreads_internal_thread_attributes_t *) *thread_attributes;
 		*thread_attributes         = NULL;
 
-/* TODO */
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+		pthread_result = pthread_attr_destroy(
+		                  &( internal_thread_attributes->attributes ) );
+
+		if( pthread_result != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 pthread_result,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to destroy attributes.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 internal_thread_attributes );
 	}
 	return( result );
 }
 
+/* Sets the stack size
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_attributes_set_stack_size(
+     libcthreads_thread_attributes_t *thread_attributes,
+     size_t stack_size,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_attributes_t *internal_thread_attributes = NULL;
+	static char *function                                                = "libcthreads_thread_attributes_set_stack_size";
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result                                                   = 0;
+#endif
+
+	if( thread_attributes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread attributes.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_attributes = (libcthreads_internal_thread_attributes_t *) thread_attributes;
+
+	if( stack_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid stack size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	internal_thread_attributes->stack_size = (SIZE_T) stack_size;
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_attr_setstacksize(
+	                  &( internal_thread_attributes->attributes ),
+	                  stack_size );
+
+	if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set stack size.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the guard size
+ * The guard size is not supported on Windows and is ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_attributes_set_guard_size(
+     libcthreads_thread_attributes_t *thread_attributes,
+     size_t guard_size,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_attributes_t *internal_thread_attributes = NULL;
+	static char *function                                                = "libcthreads_thread_attributes_set_guard_size";
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result                                                   = 0;
+#endif
+
+	if( thread_attributes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread attributes.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_attributes = (libcthreads_internal_thread_attributes_t *) thread_attributes;
+
+	if( guard_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid guard size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	LIBCTHREADS_UNREFERENCED_PARAMETER( internal_thread_attributes )
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_attr_setguardsize(
+	                  &( internal_thread_attributes->attributes ),
+	                  guard_size );
+
+	if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set guard size.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the scheduling policy and priority
+ * On Windows the priority is a thread priority value e.g. THREAD_PRIORITY_HIGHEST
+ * that is applied after the thread has been created
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_attributes_set_scheduling_policy(
+     libcthreads_thread_attributes_t *thread_attributes,
+     int scheduling_policy,
+     int priority,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_attributes_t *internal_thread_attributes = NULL;
+	static char *function                                                = "libcthreads_thread_attributes_set_scheduling_policy";
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	struct sched_param scheduling_parameters;
+
+	int inherit_scheduler                                                = PTHREAD_EXPLICIT_SCHED;
+	int maximum_priority                                                 = 0;
+	int minimum_priority                                                 = 0;
+	int policy                                                           = SCHED_OTHER;
+	int pthread_result                                                   = 0;
+#endif
+
+	if( thread_attributes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread attributes.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_attributes = (libcthreads_internal_thread_attributes_t *) thread_attributes;
+
+	if( ( scheduling_policy != LIBCTHREADS_SCHEDULING_POLICY_DEFAULT )
+	 && ( scheduling_policy != LIBCTHREADS_SCHEDULING_POLICY_FIFO )
+	 && ( scheduling_policy != LIBCTHREADS_SCHEDULING_POLICY_ROUND_ROBIN ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported scheduling policy.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( priority < THREAD_PRIORITY_IDLE )
+	 || ( priority > THREAD_PRIORITY_TIME_CRITICAL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid priority value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( scheduling_policy == LIBCTHREADS_SCHEDULING_POLICY_DEFAULT )
+	{
+		internal_thread_attributes->priority        = THREAD_PRIORITY_NORMAL;
+		internal_thread_attributes->priority_is_set = 0;
+	}
+	else
+	{
+		internal_thread_attributes->priority        = priority;
+		internal_thread_attributes->priority_is_set = 1;
+	}
+#elif defined( HAVE_PTHREAD_H )
+	if( scheduling_policy == LIBCTHREADS_SCHEDULING_POLICY_DEFAULT )
+	{
+		inherit_scheduler = PTHREAD_INHERIT_SCHED;
+		policy            = SCHED_OTHER;
+	}
+	else if( scheduling_policy == LIBCTHREADS_SCHEDULING_POLICY_FIFO )
+	{
+		policy = SCHED_FIFO;
+	}
+	else
+	{
+		policy = SCHED_RR;
+	}
+	minimum_priority = sched_get_priority_min(
+	                    policy );
+
+	maximum_priority = sched_get_priority_max(
+	                    policy );
+
+	if( ( minimum_priority == -1 )
+	 || ( maximum_priority == -1 ) )
+	{
+		libcerror_system_set_error(
+		 error,
+		 errno,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve priority range.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( priority < minimum_priority )
+	 || ( priority > maximum_priority ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid priority value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	pthread_result = pthread_attr_setinheritsched(
+	                  &( internal_thread_attributes->attributes ),
+	                  inherit_scheduler );
+
+	if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set inherit scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	pthread_result = pthread_attr_setschedpolicy(
+	                  &( internal_thread_attributes->attributes ),
+	                  policy );
+
+	if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set scheduling policy.",
+		 function );
+
+		return( -1 );
+	}
+	scheduling_parameters.sched_priority = priority;
+
+	pthread_result = pthread_attr_setschedparam(
+	                  &( internal_thread_attributes->attributes ),
+	                  &scheduling_parameters );
+
+	if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set scheduling parameters.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the name
+ * The name is applied after the thread has been created, on platforms that support it
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_attributes_set_name(
+     libcthreads_thread_attributes_t *thread_attributes,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_attributes_t *internal_thread_attributes = NULL;
+	static char *function                                                = "libcthreads_thread_attributes_set_name";
+
+	if( thread_attributes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread attributes.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_attributes = (libcthreads_internal_thread_attributes_t *) thread_attributes;
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_length >= (size_t) LIBCTHREADS_THREAD_ATTRIBUTES_MAXIMUM_NAME_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid name length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     internal_thread_attributes->name,
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_attributes->name[ name_length ] = 0;
+
+	internal_thread_attributes->name_size = name_length + 1;
+
+	return( 1 );
+}
+
+/* Applies the thread attributes that can only be set after the thread has been created
+ * This is done on a best effort basis since the thread is already running
+ */
+#if defined( WINAPI )
+void libcthreads_internal_thread_attributes_apply(
+      const libcthreads_internal_thread_attributes_t *internal_thread_attributes,
+      HANDLE thread_handle )
+{
+	if( internal_thread_attributes == NULL )
+	{
+		return;
+	}
+	if( internal_thread_attributes->priority_is_set != 0 )
+	{
+		SetThreadPriority(
+		 thread_handle,
+		 internal_thread_attributes->priority );
+	}
+}
+
+#elif defined( HAVE_PTHREAD_H )
+void libcthreads_internal_thread_attributes_apply(
+      const libcthreads_internal_thread_attributes_t *internal_thread_attributes,
+      pthread_t thread )
+{
+	if( internal_thread_attributes == NULL )
+	{
+		return;
+	}
+#if defined( HAVE_PTHREAD_SETNAME_NP )
+	if( internal_thread_attributes->name_size > 1 )
+	{
+		pthread_setname_np(
+		 thread,
+		 internal_thread_attributes->name );
+	}
+#else
+	LIBCTHREADS_UNREFERENCED_PARAMETER( thread )
+#endif
+}
+
+#endif /* defined( WINAPI ) */
+
 #endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
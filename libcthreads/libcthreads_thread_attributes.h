@@ -39,6 +39,10 @@ extern "C" {
 
 #if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
 
+/* The maximum size of a thread name including the end-of-string character
+ */
+#define LIBCTHREADS_THREAD_ATTRIBUTES_MAXIMUM_NAME_SIZE		16
+
 typedef struct libcthreads_internal_thread_attributes libcthreads_internal_thread_attributes_t;
 
 struct libcthreads_internal_thread_attributes
@@ -48,6 +52,18 @@ struct libcthreads_internal_thread_attributes
 	 */
 	SECURITY_ATTRIBUTES security_attributes;
 
+	/* The stack size
+	 */
+	SIZE_T stack_size;
+
+	/* The thread priority
+	 */
+	int priority;
+
+	/* Value to indicate the thread priority was set
+	 */
+	uint8_t priority_is_set;
+
 #elif defined( HAVE_PTHREAD_H )
 	/* The attributes
 	 */
@@ -56,6 +72,14 @@ struct libcthreads_internal_thread_attributes
 #else
 #error Missing thread attributes type
 #endif
+
+	/* The name
+	 */
+	char name[ LIBCTHREADS_THREAD_ATTRIBUTES_MAXIMUM_NAME_SIZE ];
+
+	/* The name size
+	 */
+	size_t name_size;
 };
 
 LIBCTHREADS_EXTERN \
@@ -68,6 +92,44 @@ int libcthreads_thread_attributes_free(
      libcthreads_thread_attributes_t **thread_attributes,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_thread_attributes_set_stack_size(
+     libcthreads_thread_attributes_t *thread_attributes,
+     size_t stack_size,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_thread_attributes_set_guard_size(
+     libcthreads_thread_attributes_t *thread_attributes,
+     size_t guard_size,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_thread_attributes_set_scheduling_policy(
+     libcthreads_thread_attributes_t *thread_attributes,
+     int scheduling_policy,
+     int priority,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_thread_attributes_set_name(
+     libcthreads_thread_attributes_t *thread_attributes,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+#if defined( WINAPI )
+void libcthreads_internal_thread_attributes_apply(
+      const libcthreads_internal_thread_attributes_t *internal_thread_attributes,
+      HANDLE thread_handle );
+
+#elif defined( HAVE_PTHREAD_H )
+void libcthreads_internal_thread_attributes_apply(
+      const libcthreads_internal_thread_attributes_t *internal_thread_attributes,
+      pthread_t thread );
+
+#endif
+
 #endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 #if defined( __cplusplus )
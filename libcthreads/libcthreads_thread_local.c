@@ -0,0 +1,655 @@
+/*
+ * Thread local storage functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#endif
+
+#include "libcthreads_libcerror.h"
+#include "libcthreads_mutex.h"
+#include "libcthreads_thread_local.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Frees the thread local value when its thread exits
+ * The value is freed using the value free function of the thread local storage
+ */
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+VOID WINAPI libcthreads_internal_thread_local_value_exit(
+             void *arguments )
+#else
+void libcthreads_internal_thread_local_value_exit(
+      void *arguments )
+#endif
+{
+	libcthreads_internal_thread_local_t *internal_thread_local   = NULL;
+	libcthreads_internal_thread_local_value_t *thread_local_value = NULL;
+
+	if( arguments == NULL )
+	{
+		return;
+	}
+	thread_local_value    = (libcthreads_internal_thread_local_value_t *) arguments;
+	internal_thread_local = thread_local_value->thread_local_storage;
+
+	if( libcthreads_mutex_grab(
+	     internal_thread_local->values_mutex,
+	     NULL ) != 1 )
+	{
+		return;
+	}
+	if( thread_local_value->previous_value != NULL )
+	{
+		thread_local_value->previous_value->next_value = thread_local_value->next_value;
+	}
+	else
+	{
+		internal_thread_local->first_value = thread_local_value->next_value;
+	}
+	if( thread_local_value->next_value != NULL )
+	{
+		thread_local_value->next_value->previous_value = thread_local_value->previous_value;
+	}
+	libcthreads_mutex_release(
+	 internal_thread_local->values_mutex,
+	 NULL );
+
+	if( ( thread_local_value->value != NULL )
+	 && ( internal_thread_local->value_free_function != NULL ) )
+	{
+		internal_thread_local->value_free_function(
+		 &( thread_local_value->value ),
+		 NULL );
+	}
+	memory_free(
+	 thread_local_value );
+}
+
+/* Creates a thread local storage
+ * Make sure the value thread_local_storage is referencing, is set to NULL
+ *
+ * Every thread has its own value. The value_free_function, if set, is used to
+ * free the value of a thread when the thread exits, including the worker
+ * threads of a thread pool, and the values that remain when the thread local
+ * storage is freed. On Windows versions before Vista values are only freed
+ * when the thread local storage is freed.
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_local_initialize(
+     libcthreads_thread_local_t **thread_local_storage,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_local_t *internal_thread_local = NULL;
+	static char *function                                      = "libcthreads_thread_local_initialize";
+
+#if defined( WINAPI )
+	DWORD error_code                                           = 0;
+
+#elif defined( HAVE_PTHREAD_H )
+	int pthread_result                                         = 0;
+#endif
+
+	if( thread_local_storage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread local storage.",
+		 function );
+
+		return( -1 );
+	}
+	if( *thread_local_storage != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid thread local storage value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_local = memory_allocate_structure(
+	                         libcthreads_internal_thread_local_t );
+
+	if( internal_thread_local == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create thread local storage.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_thread_local,
+	     0,
+	     sizeof( libcthreads_internal_thread_local_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear thread local storage.",
+		 function );
+
+		memory_free(
+		 internal_thread_local );
+
+		return( -1 );
+	}
+	internal_thread_local->value_free_function = value_free_function;
+
+	if( libcthreads_mutex_initialize(
+	     &( internal_thread_local->values_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create values mutex.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	internal_thread_local->index = FlsAlloc(
+	                                &libcthreads_internal_thread_local_value_exit );
+
+	if( internal_thread_local->index == FLS_OUT_OF_INDEXES )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread local storage index.",
+		 function );
+
+		goto on_error;
+	}
+#elif defined( WINAPI )
+	internal_thread_local->index = TlsAlloc();
+
+	if( internal_thread_local->index == TLS_OUT_OF_INDEXES )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread local storage index.",
+		 function );
+
+		goto on_error;
+	}
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_key_create(
+	                  &( internal_thread_local->key ),
+	                  &libcthreads_internal_thread_local_value_exit );
+
+	if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread local storage key.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	*thread_local_storage = (libcthreads_thread_local_t *) internal_thread_local;
+
+	return( 1 );
+
+on_error:
+	if( internal_thread_local != NULL )
+	{
+		if( internal_thread_local->values_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_thread_local->values_mutex ),
+			 NULL );
+		}
+		memory_free(
+		 internal_thread_local );
+	}
+	return( -1 );
+}
+
+/* Frees a thread local storage
+ * The values of threads that have not exited are freed as well, so make sure
+ * no thread uses the thread local storage anymore
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_local_free(
+     libcthreads_thread_local_t **thread_local_storage,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_local_t *internal_thread_local   = NULL;
+	libcthreads_internal_thread_local_value_t *thread_local_value = NULL;
+	static char *function                                         = "libcthreads_thread_local_free";
+	int result                                                    = 1;
+
+#if defined( WINAPI )
+	DWORD error_code                                              = 0;
+
+#elif defined( HAVE_PTHREAD_H )
+	int pthread_result                                            = 0;
+#endif
+
+	if( thread_local_storage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread local storage.",
+		 function );
+
+		return( -1 );
+	}
+	if( *thread_local_storage != NULL )
+	{
+		internal_thread_local = (libcthreads_internal_thread_local_t *) *thread_local_storage;
+		*thread_local_storage = NULL;
+
+		/* Note that FlsFree frees the values of all threads using the exit callback
+		 */
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+		if( FlsFree(
+		     internal_thread_local->index ) == 0 )
+		{
+			error_code = GetLastError();
+
+			libcerror_system_set_error(
+			 error,
+			 error_code,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free thread local storage index.",
+			 function );
+
+			result = -1;
+		}
+#elif defined( WINAPI )
+		if( TlsFree(
+		     internal_thread_local->index ) == 0 )
+		{
+			error_code = GetLastError();
+
+			libcerror_system_set_error(
+			 error,
+			 error_code,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free thread local storage index.",
+			 function );
+
+			result = -1;
+		}
+#elif defined( HAVE_PTHREAD_H )
+		pthread_result = pthread_key_delete(
+		                  internal_thread_local->key );
+
+		if( pthread_result != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 pthread_result,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free thread local storage key.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		while( internal_thread_local->first_value != NULL )
+		{
+			thread_local_value = internal_thread_local->first_value;
+
+			internal_thread_local->first_value = thread_local_value->next_value;
+
+			if( ( thread_local_value->value != NULL )
+			 && ( internal_thread_local->value_free_function != NULL ) )
+			{
+				if( internal_thread_local->value_free_function(
+				     &( thread_local_value->value ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free value.",
+					 function );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 thread_local_value );
+		}
+		if( libcthreads_mutex_free(
+		     &( internal_thread_local->values_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free values mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_thread_local );
+	}
+	return( result );
+}
+
+/* Retrieves the value of the current thread
+ * Returns 1 if successful, 0 if no value was set or -1 on error
+ */
+int libcthreads_thread_local_get_value(
+     libcthreads_thread_local_t *thread_local_storage,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_local_t *internal_thread_local   = NULL;
+	libcthreads_internal_thread_local_value_t *thread_local_value = NULL;
+	static char *function                                         = "libcthreads_thread_local_get_value";
+
+	if( thread_local_storage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread local storage.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_local = (libcthreads_internal_thread_local_t *) thread_local_storage;
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	thread_local_value = (libcthreads_internal_thread_local_value_t *) FlsGetValue(
+	                                                                    internal_thread_local->index );
+
+#elif defined( WINAPI )
+	thread_local_value = (libcthreads_internal_thread_local_value_t *) TlsGetValue(
+	                                                                    internal_thread_local->index );
+
+#elif defined( HAVE_PTHREAD_H )
+	thread_local_value = (libcthreads_internal_thread_local_value_t *) pthread_getspecific(
+	                                                                    internal_thread_local->key );
+#endif
+	if( ( thread_local_value == NULL )
+	 || ( thread_local_value->value == NULL ) )
+	{
+		*value = NULL;
+
+		return( 0 );
+	}
+	*value = thread_local_value->value;
+
+	return( 1 );
+}
+
+/* Sets the value of the current thread
+ * A previously set value is replaced but not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_local_set_value(
+     libcthreads_thread_local_t *thread_local_storage,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_local_t *internal_thread_local   = NULL;
+	libcthreads_internal_thread_local_value_t *thread_local_value = NULL;
+	static char *function                                         = "libcthreads_thread_local_set_value";
+
+#if defined( WINAPI )
+	DWORD error_code                                              = 0;
+
+#elif defined( HAVE_PTHREAD_H )
+	int pthread_result                                            = 0;
+#endif
+
+	if( thread_local_storage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread local storage.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_local = (libcthreads_internal_thread_local_t *) thread_local_storage;
+
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	thread_local_value = (libcthreads_internal_thread_local_value_t *) FlsGetValue(
+	                                                                    internal_thread_local->index );
+
+#elif defined( WINAPI )
+	thread_local_value = (libcthreads_internal_thread_local_value_t *) TlsGetValue(
+	                                                                    internal_thread_local->index );
+
+#elif defined( HAVE_PTHREAD_H )
+	thread_local_value = (libcthreads_internal_thread_local_value_t *) pthread_getspecific(
+	                                                                    internal_thread_local->key );
+#endif
+	if( thread_local_value != NULL )
+	{
+		thread_local_value->value = value;
+
+		return( 1 );
+	}
+	if( value == NULL )
+	{
+		return( 1 );
+	}
+	/* The first value set by a thread is tracked so it can be freed
+	 * when the thread exits or the thread local storage is freed
+	 */
+	thread_local_value = memory_allocate_structure(
+	                      libcthreads_internal_thread_local_value_t );
+
+	if( thread_local_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create thread local value.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     thread_local_value,
+	     0,
+	     sizeof( libcthreads_internal_thread_local_value_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear thread local value.",
+		 function );
+
+		memory_free(
+		 thread_local_value );
+
+		return( -1 );
+	}
+	thread_local_value->thread_local_storage = internal_thread_local;
+	thread_local_value->value                = value;
+
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	if( FlsSetValue(
+	     internal_thread_local->index,
+	     (void *) thread_local_value ) == 0 )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set thread local value.",
+		 function );
+
+		goto on_error;
+	}
+#elif defined( WINAPI )
+	if( TlsSetValue(
+	     internal_thread_local->index,
+	     (void *) thread_local_value ) == 0 )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set thread local value.",
+		 function );
+
+		goto on_error;
+	}
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_setspecific(
+	                  internal_thread_local->key,
+	                  (void *) thread_local_value );
+
+	if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set thread local value.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( libcthreads_mutex_grab(
+	     internal_thread_local->values_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab values mutex.",
+		 function );
+
+		goto on_error;
+	}
+	thread_local_value->next_value = internal_thread_local->first_value;
+
+	if( internal_thread_local->first_value != NULL )
+	{
+		internal_thread_local->first_value->previous_value = thread_local_value;
+	}
+	internal_thread_local->first_value = thread_local_value;
+
+	if( libcthreads_mutex_release(
+	     internal_thread_local->values_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release values mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	FlsSetValue(
+	 internal_thread_local->index,
+	 NULL );
+
+#elif defined( WINAPI )
+	TlsSetValue(
+	 internal_thread_local->index,
+	 NULL );
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_setspecific(
+	 internal_thread_local->key,
+	 NULL );
+#endif
+	memory_free(
+	 thread_local_value );
+
+	return( -1 );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,127 @@
+/*
+ * Thread local storage functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_THREAD_LOCAL_H )
+#define _LIBCTHREADS_INTERNAL_THREAD_LOCAL_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#endif
+
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct libcthreads_internal_thread_local libcthreads_internal_thread_local_t;
+typedef struct libcthreads_internal_thread_local_value libcthreads_internal_thread_local_value_t;
+
+struct libcthreads_internal_thread_local_value
+{
+	/* The thread local storage
+	 */
+	libcthreads_internal_thread_local_t *thread_local_storage;
+
+	/* The value
+	 */
+	intptr_t *value;
+
+	/* The previous thread local value
+	 */
+	libcthreads_internal_thread_local_value_t *previous_value;
+
+	/* The next thread local value
+	 */
+	libcthreads_internal_thread_local_value_t *next_value;
+};
+
+struct libcthreads_internal_thread_local
+{
+#if defined( WINAPI )
+	/* The fiber or thread local storage index
+	 */
+	DWORD index;
+
+#elif defined( HAVE_PTHREAD_H )
+	/* The thread local storage key
+	 */
+	pthread_key_t key;
+
+#else
+#error Missing thread local storage type
+#endif
+
+	/* The value free function
+	 */
+	int (*value_free_function)(
+	       intptr_t **value,
+	       libcerror_error_t **error );
+
+	/* The values mutex
+	 */
+	libcthreads_mutex_t *values_mutex;
+
+	/* The first value, of the threads that have set a value
+	 */
+	libcthreads_internal_thread_local_value_t *first_value;
+};
+
+LIBCTHREADS_EXTERN \
+int libcthreads_thread_local_initialize(
+     libcthreads_thread_local_t **thread_local_storage,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_thread_local_free(
+     libcthreads_thread_local_t **thread_local_storage,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_thread_local_get_value(
+     libcthreads_thread_local_t *thread_local_storage,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_thread_local_set_value(
+     libcthreads_thread_local_t *thread_local_storage,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_THREAD_LOCAL_H ) */
+
@@ -29,14 +29,18 @@
 #include <Threadpoolapiset.h>
 #endif
 
+#include "libcthreads_clock.h"
 #include "libcthreads_condition.h"
 #include "libcthreads_definitions.h"
 #include "libcthreads_libcerror.h"
 #include "libcthreads_mutex.h"
+#include "libcthreads_probes.h"
 #include "libcthreads_queue.h"
 #include "libcthreads_thread.h"
 #include "libcthreads_thread_attributes.h"
 #include "libcthreads_thread_pool.h"
+#include "libcthreads_topology.h"
+#include "libcthreads_tracer.h"
 #include "libcthreads_types.h"
 #include "libcthreads_unused.h"
 
@@ -90,10 +94,37 @@ void CALLBACK libcthreads_thread_pool_callback_function_helper(
 	{
 		return;
 	}
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_START,
+	 internal_thread_pool );
+
+	LIBCTHREADS_PROBE2(
+	 pool__task__start,
+	 internal_thread_pool,
+	 value );
+
 	callback_function_result = internal_thread_pool->callback_function(
 	                            value,
 	                            internal_thread_pool->callback_function_arguments );
 
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_END,
+	 internal_thread_pool );
+
+	LIBCTHREADS_PROBE3(
+	 pool__task__end,
+	 internal_thread_pool,
+	 value,
+	 callback_function_result );
+
+	if( ( callback_function_result == 1 )
+	 && ( internal_thread_pool->completion_queue != NULL ) )
+	{
+		callback_function_result = libcthreads_internal_thread_pool_push_completion(
+		                            internal_thread_pool,
+		                            value,
+		                            &error );
+	}
 	if( callback_function_result != 1 )
 	{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -106,6 +137,113 @@ void CALLBACK libcthreads_thread_pool_callback_function_helper(
 	}
 }
 
+/* Timer callback function helper function for WINAPI thread pool
+ * Submits work for the delayed values that are due and sets the timer
+ * to the earliest delayed value that is not due
+ */
+void CALLBACK libcthreads_thread_pool_timer_callback_function_helper(
+               TP_CALLBACK_INSTANCE *callback_instance,
+               void *arguments,
+               TP_TIMER *thread_pool_timer )
+{
+	libcerror_error_t *error                                 = NULL;
+	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
+	TP_WORK *thread_pool_work                                = NULL;
+	uint64_t monotonic_time                                  = 0;
+	uint64_t next_deadline                                   = 0;
+	int number_of_due_delayed_values                         = 0;
+	int number_of_work_items                                 = 0;
+	int result                                               = 1;
+
+	LIBCTHREADS_UNREFERENCED_PARAMETER( callback_instance )
+	LIBCTHREADS_UNREFERENCED_PARAMETER( thread_pool_timer )
+
+	if( arguments == NULL )
+	{
+		return;
+	}
+	internal_thread_pool = (libcthreads_internal_thread_pool_t *) arguments;
+
+	if( libcthreads_mutex_grab(
+	     internal_thread_pool->condition_mutex,
+	     &error ) != 1 )
+	{
+		result = -1;
+	}
+	else
+	{
+		internal_thread_pool->delayed_values_timer_deadline = UINT64_MAX;
+
+		/* Delayed values that are not due when the thread pool is joined are not processed
+		 */
+		if( internal_thread_pool->status != LIBCTHREADS_STATUS_EXIT )
+		{
+			if( libcthreads_clock_get_monotonic_time(
+			     &monotonic_time,
+			     &error ) != 1 )
+			{
+				result = -1;
+			}
+			else
+			{
+				libcthreads_internal_thread_pool_get_due_delayed_values(
+				 internal_thread_pool,
+				 monotonic_time,
+				 &number_of_due_delayed_values,
+				 &next_deadline );
+
+				/* Work was already submitted for the released delayed values
+				 */
+				number_of_work_items = number_of_due_delayed_values - internal_thread_pool->number_of_released_delayed_values;
+
+				internal_thread_pool->number_of_released_delayed_values = number_of_due_delayed_values;
+
+				if( next_deadline != UINT64_MAX )
+				{
+					result = libcthreads_internal_thread_pool_set_delayed_values_timer(
+					          internal_thread_pool,
+					          next_deadline,
+					          &error );
+				}
+			}
+		}
+		if( libcthreads_mutex_release(
+		     internal_thread_pool->condition_mutex,
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	while( number_of_work_items > 0 )
+	{
+		thread_pool_work = CreateThreadpoolWork(
+		                    &libcthreads_thread_pool_callback_function_helper,
+		                    (void *) internal_thread_pool,
+		                    &( internal_thread_pool->callback_environment ) );
+
+		if( thread_pool_work == NULL )
+		{
+			result = -1;
+
+			break;
+		}
+		SubmitThreadpoolWork(
+		 thread_pool_work );
+
+		number_of_work_items--;
+	}
+	if( result != 1 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+}
+
 #elif defined( WINAPI )
 
 /* Start function helper function for WINAPI
@@ -143,10 +281,37 @@ DWORD WINAPI libcthreads_thread_pool_callback_function_helper(
 				}
 				else if( pop_result != 0 )
 				{
+					libcthreads_tracer_record_event(
+					 LIBCTHREADS_TRACER_EVENT_START,
+					 internal_thread_pool );
+
+					LIBCTHREADS_PROBE2(
+					 pool__task__start,
+					 internal_thread_pool,
+					 value );
+
 					callback_function_result = internal_thread_pool->callback_function(
 					                            value,
 					                            internal_thread_pool->callback_function_arguments );
 
+					libcthreads_tracer_record_event(
+					 LIBCTHREADS_TRACER_EVENT_END,
+					 internal_thread_pool );
+
+					LIBCTHREADS_PROBE3(
+					 pool__task__end,
+					 internal_thread_pool,
+					 value,
+					 callback_function_result );
+
+					if( ( callback_function_result == 1 )
+					 && ( internal_thread_pool->completion_queue != NULL ) )
+					{
+						callback_function_result = libcthreads_internal_thread_pool_push_completion(
+						                            internal_thread_pool,
+						                            value,
+						                            &error );
+					}
 					if( ( callback_function_result != 1 )
 					 && ( result == 1 ) )
 					{
@@ -183,7 +348,7 @@ DWORD WINAPI libcthreads_thread_pool_callback_function_helper(
 #elif defined( HAVE_PTHREAD_H )
 
 /* Start function helper function for pthread
- * Returns a pointer to a newly allocated int containing 1 if successful or -1 on error
+ * Returns the callback function result, 1 if successful or -1 on error, stored in the pointer value
  * NULL is return if the helper function was unable to run the callback
  */
 void *libcthreads_thread_pool_callback_function_helper(
@@ -192,7 +357,7 @@ void *libcthreads_thread_pool_callback_function_helper(
 	libcerror_error_t *error                                 = NULL;
 	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
 	intptr_t *value                                          = NULL;
-	int *result                                              = NULL;
+	intptr_t result                                          = 0;
 	int callback_function_result                             = 0;
 	int pop_result                                           = 0;
 
@@ -203,57 +368,78 @@ void *libcthreads_thread_pool_callback_function_helper(
 		if( ( internal_thread_pool != NULL )
 		 && ( internal_thread_pool->callback_function != NULL ) )
 		{
-			result = (int *) memory_allocate(
-			                  sizeof( int ) );
+			result = 1;
 
-			if( result != NULL )
+			do
 			{
-				*result = 1;
+				pop_result = libcthreads_internal_thread_pool_pop(
+				              internal_thread_pool,
+				              &value,
+				              &error );
 
-				do
+				if( pop_result == -1 )
+				{
+					break;
+				}
+				else if( pop_result != 0 )
 				{
-					pop_result = libcthreads_internal_thread_pool_pop(
-					              internal_thread_pool,
-					              &value,
-					              &error );
+					libcthreads_tracer_record_event(
+					 LIBCTHREADS_TRACER_EVENT_START,
+					 internal_thread_pool );
 
-					if( pop_result == -1 )
-					{
-						break;
-					}
-					else if( pop_result != 0 )
+					LIBCTHREADS_PROBE2(
+					 pool__task__start,
+					 internal_thread_pool,
+					 value );
+
+					callback_function_result = internal_thread_pool->callback_function(
+					                            value,
+					                            internal_thread_pool->callback_function_arguments );
+
+					libcthreads_tracer_record_event(
+					 LIBCTHREADS_TRACER_EVENT_END,
+					 internal_thread_pool );
+
+					LIBCTHREADS_PROBE3(
+					 pool__task__end,
+					 internal_thread_pool,
+					 value,
+					 callback_function_result );
+
+					if( ( callback_function_result == 1 )
+					 && ( internal_thread_pool->completion_queue != NULL ) )
 					{
-						callback_function_result = internal_thread_pool->callback_function(
+						callback_function_result = libcthreads_internal_thread_pool_push_completion(
+						                            internal_thread_pool,
 						                            value,
-						                            internal_thread_pool->callback_function_arguments );
-
-						if( ( callback_function_result != 1 )
-						 && ( *result == 1 ) )
-						{
-							*result = callback_function_result;
-						}
+						                            &error );
 					}
-					else if( internal_thread_pool->status == LIBCTHREADS_STATUS_EXIT )
+					if( ( callback_function_result != 1 )
+					 && ( result == 1 ) )
 					{
-						break;
+						result = (intptr_t) callback_function_result;
 					}
 				}
-				while( pop_result != -1 );
-
-				if( pop_result == -1 )
+				else if( internal_thread_pool->status == LIBCTHREADS_STATUS_EXIT )
 				{
-					*result = -1;
+					break;
 				}
-				if( error != NULL )
-				{
+			}
+			while( pop_result != -1 );
+
+			if( pop_result == -1 )
+			{
+				result = -1;
+			}
+			if( error != NULL )
+			{
 #if defined( HAVE_VERBOSE_OUTPUT )
-					libcerror_error_backtrace_fprint(
-					 error,
-					 stdout );
+				libcerror_error_backtrace_fprint(
+				 error,
+				 stdout );
 #endif
-					libcerror_error_free(
-					 &error );
-				}
+				libcerror_error_free(
+				 &error );
 			}
 		}
 	}
@@ -265,6 +451,7 @@ void *libcthreads_thread_pool_callback_function_helper(
 
 /* Creates a thread pool
  * Make sure the value thread_pool is referencing, is set to NULL
+ * If number_of_threads is 0 a thread is created per logical CPU
  *
  * The callback_function should return 1 if successful and -1 on error
  * Returns 1 if successful or -1 on error
@@ -281,6 +468,7 @@ int libcthreads_thread_pool_create(
      libcerror_error_t **error )
 {
 	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
+	libcthreads_topology_t *topology                         = NULL;
 	static char *function                                    = "libcthreads_thread_pool_create";
 	size_t array_size                                        = 0;
 
@@ -298,10 +486,10 @@ int libcthreads_thread_pool_create(
 #elif defined( WINAPI )
 	SECURITY_ATTRIBUTES *security_attributes                 = NULL;
 	HANDLE thread_handle                                     = NULL;
+	SIZE_T stack_size                                        = 0;
 
 #elif defined( HAVE_PTHREAD_H )
 	pthread_attr_t *attributes                               = NULL;
-	int *thread_return_value                                 = NULL;
 	int pthread_result                                       = 0;
 #endif
 
@@ -331,17 +519,47 @@ int libcthreads_thread_pool_create(
 
 		return( -1 );
 	}
-	if( number_of_threads <= 0 )
+	if( number_of_threads < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
-		 "%s: invalid number of threads value zero or less.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
 		 function );
 
 		return( -1 );
 	}
+	if( number_of_threads == 0 )
+	{
+		if( libcthreads_topology_get(
+		     &topology,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve topology.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_topology_get_number_of_cpus(
+		     topology,
+		     &number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of CPUs.",
+			 function );
+
+			return( -1 );
+		}
+	}
 #if defined( WINAPI ) && ( WINVER >= 0x0602 )
 #if SIZEOF_INT > 4
 	if( number_of_threads > (int) UINT32_MAX )
@@ -597,6 +815,29 @@ int libcthreads_thread_pool_create(
 	 internal_thread_pool->cleanup_group,
 	 NULL );
 
+	/* A single timer submits the work for all the delayed values
+	 */
+	internal_thread_pool->delayed_values_timer = CreateThreadpoolTimer(
+	                                              &libcthreads_thread_pool_timer_callback_function_helper,
+	                                              (void *) internal_thread_pool,
+	                                              &( internal_thread_pool->callback_environment ) );
+
+	if( internal_thread_pool->delayed_values_timer == NULL )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create delayed values timer.",
+		 function );
+
+		goto on_error;
+	}
+	internal_thread_pool->delayed_values_timer_deadline = UINT64_MAX;
+
 #elif defined( WINAPI )
 	array_size = sizeof( HANDLE ) * number_of_threads;
 
@@ -685,6 +926,7 @@ int libcthreads_thread_pool_create(
 	if( thread_attributes != NULL )
 	{
 		security_attributes = &( ( (libcthreads_internal_thread_attributes_t *) thread_attributes )->security_attributes );
+		stack_size          = ( (libcthreads_internal_thread_attributes_t *) thread_attributes )->stack_size;
 	}
 	for( thread_index = 0;
 	     thread_index < number_of_threads;
@@ -692,7 +934,7 @@ int libcthreads_thread_pool_create(
 	{
 		thread_handle = CreateThread(
 		                 security_attributes,
-		                 0, /* stack size */
+		                 stack_size,
 		                 &libcthreads_thread_pool_callback_function_helper,
 		                 (void *) internal_thread_pool,
 		                 0, /* creation flags */
@@ -714,6 +956,10 @@ int libcthreads_thread_pool_create(
 			goto on_error;
 		}
 		internal_thread_pool->thread_handles_array[ thread_index ] = thread_handle;
+
+		libcthreads_internal_thread_attributes_apply(
+		 (libcthreads_internal_thread_attributes_t *) thread_attributes,
+		 thread_handle );
 	}
 
 #elif defined( HAVE_PTHREAD_H )
@@ -802,6 +1048,9 @@ int libcthreads_thread_pool_create(
 
 				goto on_error;
 		}
+		libcthreads_internal_thread_attributes_apply(
+		 (libcthreads_internal_thread_attributes_t *) thread_attributes,
+		 internal_thread_pool->threads_array[ thread_index ] );
 	}
 #endif /* defined( WINAPI ) && ( WINVER >= 0x0602 ) */
 
@@ -813,6 +1062,13 @@ on_error:
 	if( internal_thread_pool != NULL )
 	{
 #if defined( WINAPI ) && ( WINVER >= 0x0602 )
+		if( internal_thread_pool->delayed_values_timer != NULL )
+		{
+			CloseThreadpoolTimer(
+			 internal_thread_pool->delayed_values_timer );
+
+			internal_thread_pool->delayed_values_timer = NULL;
+		}
 		if( internal_thread_pool->cleanup_group != NULL )
 		{
 			CloseThreadpoolCleanupGroup(
@@ -854,15 +1110,8 @@ on_error:
 			{
 				pthread_join(
 				 internal_thread_pool->threads_array[ thread_index ],
-				 (void **) &thread_return_value );
-
-				if( thread_return_value != NULL )
-				{
-					memory_free(
-					 thread_return_value );
+				 NULL );
 
-					thread_return_value = NULL;
-				}
 				thread_index--;
 			}
 			memory_free(
@@ -907,8 +1156,13 @@ int libcthreads_internal_thread_pool_pop(
      intptr_t **value,
      libcerror_error_t **error )
 {
-	static char *function = "libcthreads_internal_thread_pool_pop";
-	int result            = 0;
+	static char *function   = "libcthreads_internal_thread_pool_pop";
+	uint8_t is_due          = 0;
+	int result              = 0;
+
+#if !defined( WINAPI ) || ( WINVER < 0x0602 )
+	uint64_t monotonic_time = 0;
+#endif
 
 	if( internal_thread_pool == NULL )
 	{
@@ -945,50 +1199,146 @@ int libcthreads_internal_thread_pool_pop(
 
 		return( -1 );
 	}
-	while( internal_thread_pool->number_of_values == 0 )
+	while( result == 0 )
 	{
-		if( internal_thread_pool->status == LIBCTHREADS_STATUS_EXIT )
+		/* A delayed value that is due takes precedence over the queued values
+		 */
+		is_due = 0;
+
+#if defined( WINAPI ) && ( WINVER >= 0x0602 )
+		/* Every work item consumes a single value, hence only as many delayed values
+		 * are popped as the delayed values timer submitted work for
+		 */
+		if( internal_thread_pool->number_of_released_delayed_values > 0 )
 		{
-			break;
+			internal_thread_pool->number_of_released_delayed_values -= 1;
+
+			is_due = 1;
 		}
-		if( libcthreads_condition_wait(
-		     internal_thread_pool->empty_condition,
-		     internal_thread_pool->condition_mutex,
-		     error ) != 1 )
+#else
+		if( internal_thread_pool->number_of_delayed_values > 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to wait for empty condition.",
-			 function );
+			if( libcthreads_clock_get_monotonic_time(
+			     &monotonic_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve monotonic time.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
+			if( internal_thread_pool->delayed_values_heap[ 0 ].deadline <= monotonic_time )
+			{
+				is_due = 1;
+			}
 		}
-	}
-	if( internal_thread_pool->number_of_values > 0 )
-	{
-		*value = internal_thread_pool->values_array[ internal_thread_pool->pop_index ];
-
-		internal_thread_pool->pop_index++;
+#endif /* defined( WINAPI ) && ( WINVER >= 0x0602 ) */
 
-		if( internal_thread_pool->pop_index >= internal_thread_pool->allocated_number_of_values )
+		if( is_due != 0 )
 		{
-			internal_thread_pool->pop_index = 0;
+			libcthreads_internal_thread_pool_remove_first_delayed_value(
+			 internal_thread_pool,
+			 value );
+
+			libcthreads_tracer_record_event(
+			 LIBCTHREADS_TRACER_EVENT_DEQUEUE,
+			 internal_thread_pool );
+
+			result = 1;
+
+			/* Wake another worker thread to wait for the next delayed value,
+			 * since the worker threads that were woken for the previous
+			 * earliest deadline might be busy processing values
+			 */
+			if( internal_thread_pool->number_of_delayed_values > 0 )
+			{
+				if( libcthreads_condition_signal(
+				     internal_thread_pool->empty_condition,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to signal empty condition.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			break;
 		}
-		internal_thread_pool->number_of_values--;
+		if( internal_thread_pool->number_of_values > 0 )
+		{
+			*value = internal_thread_pool->values_array[ internal_thread_pool->pop_index ];
 
-		result = 1;
+			internal_thread_pool->pop_index++;
 
-		if( libcthreads_condition_broadcast(
-		     internal_thread_pool->full_condition,
-		     error ) != 1 )
+			if( internal_thread_pool->pop_index >= internal_thread_pool->allocated_number_of_values )
+			{
+				internal_thread_pool->pop_index = 0;
+			}
+			internal_thread_pool->number_of_values--;
+
+			libcthreads_tracer_record_event(
+			 LIBCTHREADS_TRACER_EVENT_DEQUEUE,
+			 internal_thread_pool );
+
+			result = 1;
+
+			if( libcthreads_condition_broadcast(
+			     internal_thread_pool->full_condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast full condition.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+		}
+		if( internal_thread_pool->status == LIBCTHREADS_STATUS_EXIT )
+		{
+			break;
+		}
+		/* Sleep until the earliest delayed value is due or a value is pushed
+		 */
+		if( internal_thread_pool->number_of_delayed_values > 0 )
+		{
+			if( libcthreads_condition_wait_until(
+			     internal_thread_pool->empty_condition,
+			     internal_thread_pool->condition_mutex,
+			     internal_thread_pool->delayed_values_heap[ 0 ].deadline,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for empty condition.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else if( libcthreads_condition_wait(
+		          internal_thread_pool->empty_condition,
+		          internal_thread_pool->condition_mutex,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to broadcast full condition.",
+			 "%s: unable to wait for empty condition.",
 			 function );
 
 			goto on_error;
@@ -1017,23 +1367,415 @@ on_error:
 	return( -1 );
 }
 
-/* Pushes a value onto the queue of the thread pool
+/* Pushes a value onto the completion queue of the thread pool
+ * The value is dropped and counted if the completion queue is full, since
+ * blocking would stall the worker threads until the completion queue is popped
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_thread_pool_push(
-     libcthreads_thread_pool_t *thread_pool,
+int libcthreads_internal_thread_pool_push_completion(
+     libcthreads_internal_thread_pool_t *internal_thread_pool,
      intptr_t *value,
      libcerror_error_t **error )
 {
-	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
-	static char *function                                    = "libcthreads_thread_pool_push";
-
-#if defined( WINAPI ) && ( WINVER >= 0x0602 )
-	TP_WORK *thread_pool_work                                = NULL;
-	DWORD error_code                                         = 0;
-#endif
+	static char *function = "libcthreads_internal_thread_pool_push_completion";
+	int result            = 0;
 
-	if( thread_pool == NULL )
+	if( internal_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_queue_try_push(
+	          internal_thread_pool->completion_queue,
+	          value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push value onto completion queue.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     internal_thread_pool->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+		internal_thread_pool->number_of_dropped_completions += 1;
+
+		if( libcthreads_mutex_release(
+		     internal_thread_pool->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Compares two delayed values
+ * Returns LIBCTHREADS_COMPARE_LESS if the first delayed value is due before the second
+ * or LIBCTHREADS_COMPARE_GREATER otherwise
+ */
+int libcthreads_internal_thread_pool_delayed_value_compare(
+     libcthreads_internal_thread_pool_delayed_value_t *first_delayed_value,
+     libcthreads_internal_thread_pool_delayed_value_t *second_delayed_value )
+{
+	if( first_delayed_value->deadline < second_delayed_value->deadline )
+	{
+		return( LIBCTHREADS_COMPARE_LESS );
+	}
+	if( ( first_delayed_value->deadline == second_delayed_value->deadline )
+	 && ( first_delayed_value->sequence_number < second_delayed_value->sequence_number ) )
+	{
+		return( LIBCTHREADS_COMPARE_LESS );
+	}
+	return( LIBCTHREADS_COMPARE_GREATER );
+}
+
+/* Inserts a value into the delayed values heap
+ * Make sure the condition mutex is grabbed before calling this function
+ * Returns 1 if the value is the first delayed value, 0 if not or -1 on error
+ */
+int libcthreads_internal_thread_pool_insert_delayed_value(
+     libcthreads_internal_thread_pool_t *internal_thread_pool,
+     intptr_t *value,
+     uint64_t deadline,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_pool_delayed_value_t delayed_value;
+
+	libcthreads_internal_thread_pool_delayed_value_t *delayed_values_heap = NULL;
+	static char *function                                                 = "libcthreads_internal_thread_pool_insert_delayed_value";
+	size_t array_size                                                     = 0;
+	int allocated_number_of_delayed_values                                = 0;
+	int heap_index                                                        = 0;
+	int parent_heap_index                                                 = 0;
+
+	if( internal_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_thread_pool->number_of_delayed_values >= internal_thread_pool->allocated_number_of_delayed_values )
+	{
+		if( internal_thread_pool->allocated_number_of_delayed_values == 0 )
+		{
+			allocated_number_of_delayed_values = LIBCTHREADS_THREAD_POOL_INITIAL_NUMBER_OF_DELAYED_VALUES;
+		}
+		else if( internal_thread_pool->allocated_number_of_delayed_values > ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid thread pool - number of delayed values value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		else
+		{
+			allocated_number_of_delayed_values = internal_thread_pool->allocated_number_of_delayed_values * 2;
+		}
+		array_size = sizeof( libcthreads_internal_thread_pool_delayed_value_t ) * allocated_number_of_delayed_values;
+
+		if( array_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid delayed values heap size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		delayed_values_heap = (libcthreads_internal_thread_pool_delayed_value_t *) memory_reallocate(
+		                                                                            internal_thread_pool->delayed_values_heap,
+		                                                                            array_size );
+
+		if( delayed_values_heap == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize delayed values heap.",
+			 function );
+
+			return( -1 );
+		}
+		internal_thread_pool->delayed_values_heap                = delayed_values_heap;
+		internal_thread_pool->allocated_number_of_delayed_values = allocated_number_of_delayed_values;
+	}
+	delayed_value.deadline        = deadline;
+	delayed_value.sequence_number = internal_thread_pool->next_sequence_number;
+	delayed_value.value           = value;
+
+	internal_thread_pool->next_sequence_number += 1;
+
+	heap_index = internal_thread_pool->number_of_delayed_values;
+
+	internal_thread_pool->number_of_delayed_values += 1;
+
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_ENQUEUE,
+	 internal_thread_pool );
+
+	while( heap_index > 0 )
+	{
+		parent_heap_index = ( heap_index - 1 ) / 2;
+
+		if( libcthreads_internal_thread_pool_delayed_value_compare(
+		     &delayed_value,
+		     &( internal_thread_pool->delayed_values_heap[ parent_heap_index ] ) ) != LIBCTHREADS_COMPARE_LESS )
+		{
+			break;
+		}
+		internal_thread_pool->delayed_values_heap[ heap_index ] = internal_thread_pool->delayed_values_heap[ parent_heap_index ];
+
+		heap_index = parent_heap_index;
+	}
+	internal_thread_pool->delayed_values_heap[ heap_index ] = delayed_value;
+
+	if( heap_index == 0 )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Removes the first value from the delayed values heap
+ * Make sure the condition mutex is grabbed and the heap is not empty before calling this function
+ */
+void libcthreads_internal_thread_pool_remove_first_delayed_value(
+      libcthreads_internal_thread_pool_t *internal_thread_pool,
+      intptr_t **value )
+{
+	libcthreads_internal_thread_pool_delayed_value_t *last_delayed_value = NULL;
+	int child_heap_index                                                 = 0;
+	int heap_index                                                       = 0;
+	int number_of_delayed_values                                         = 0;
+
+	*value = internal_thread_pool->delayed_values_heap[ 0 ].value;
+
+	internal_thread_pool->number_of_delayed_values -= 1;
+
+	number_of_delayed_values = internal_thread_pool->number_of_delayed_values;
+
+	if( number_of_delayed_values == 0 )
+	{
+		return;
+	}
+	last_delayed_value = &( internal_thread_pool->delayed_values_heap[ number_of_delayed_values ] );
+
+	for( ;; )
+	{
+		child_heap_index = ( heap_index * 2 ) + 1;
+
+		if( child_heap_index >= number_of_delayed_values )
+		{
+			break;
+		}
+		if( ( ( child_heap_index + 1 ) < number_of_delayed_values )
+		 && ( libcthreads_internal_thread_pool_delayed_value_compare(
+		       &( internal_thread_pool->delayed_values_heap[ child_heap_index + 1 ] ),
+		       &( internal_thread_pool->delayed_values_heap[ child_heap_index ] ) ) == LIBCTHREADS_COMPARE_LESS ) )
+		{
+			child_heap_index += 1;
+		}
+		if( libcthreads_internal_thread_pool_delayed_value_compare(
+		     &( internal_thread_pool->delayed_values_heap[ child_heap_index ] ),
+		     last_delayed_value ) != LIBCTHREADS_COMPARE_LESS )
+		{
+			break;
+		}
+		internal_thread_pool->delayed_values_heap[ heap_index ] = internal_thread_pool->delayed_values_heap[ child_heap_index ];
+
+		heap_index = child_heap_index;
+	}
+	internal_thread_pool->delayed_values_heap[ heap_index ] = *last_delayed_value;
+}
+
+#if defined( WINAPI ) && ( WINVER >= 0x0602 )
+
+/* Retrieves the number of delayed values that are due and the deadline
+ * of the earliest delayed value that is not due, or UINT64_MAX if none
+ * The heap is traversed depth first without the subtrees of the delayed values
+ * that are not due, since their children are not due either
+ * Make sure the condition mutex is grabbed before calling this function
+ */
+void libcthreads_internal_thread_pool_get_due_delayed_values(
+      libcthreads_internal_thread_pool_t *internal_thread_pool,
+      uint64_t monotonic_time,
+      int *number_of_due_delayed_values,
+      uint64_t *next_deadline )
+{
+	int heap_index               = 0;
+	int number_of_delayed_values = 0;
+
+	number_of_delayed_values = internal_thread_pool->number_of_delayed_values;
+
+	*number_of_due_delayed_values = 0;
+	*next_deadline                = UINT64_MAX;
+
+	while( heap_index < number_of_delayed_values )
+	{
+		if( internal_thread_pool->delayed_values_heap[ heap_index ].deadline <= monotonic_time )
+		{
+			*number_of_due_delayed_values += 1;
+
+			/* Continue with the first child
+			 */
+			if( ( ( heap_index * 2 ) + 1 ) < number_of_delayed_values )
+			{
+				heap_index = ( heap_index * 2 ) + 1;
+
+				continue;
+			}
+		}
+		else if( internal_thread_pool->delayed_values_heap[ heap_index ].deadline < *next_deadline )
+		{
+			*next_deadline = internal_thread_pool->delayed_values_heap[ heap_index ].deadline;
+		}
+		/* Continue with the second child of the nearest ancestor that has not been traversed
+		 * A first child has an odd heap index
+		 */
+		while( heap_index > 0 )
+		{
+			if( ( ( heap_index % 2 ) == 1 )
+			 && ( ( heap_index + 1 ) < number_of_delayed_values ) )
+			{
+				break;
+			}
+			heap_index = ( heap_index - 1 ) / 2;
+		}
+		if( heap_index == 0 )
+		{
+			break;
+		}
+		heap_index += 1;
+	}
+}
+
+/* Sets the delayed values timer to expire at the deadline
+ * The deadline is a time of the monotonic clock in nanoseconds
+ * Make sure the condition mutex is grabbed before calling this function
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_thread_pool_set_delayed_values_timer(
+     libcthreads_internal_thread_pool_t *internal_thread_pool,
+     uint64_t deadline,
+     libcerror_error_t **error )
+{
+	FILETIME due_time;
+
+	static char *function   = "libcthreads_internal_thread_pool_set_delayed_values_timer";
+	uint64_t monotonic_time = 0;
+	uint64_t timeout        = 1;
+
+	if( internal_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_clock_get_monotonic_time(
+	     &monotonic_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic time.",
+		 function );
+
+		return( -1 );
+	}
+	/* The timeout is in 100 nanosecond intervals, at least 1 interval
+	 */
+	if( deadline > monotonic_time )
+	{
+		timeout = ( ( deadline - monotonic_time ) + 99 ) / 100;
+	}
+	/* A negative due time is relative to the current time
+	 */
+	timeout = (uint64_t) -( (int64_t) timeout );
+
+	due_time.dwLowDateTime  = (DWORD) ( timeout & 0xffffffffUL );
+	due_time.dwHighDateTime = (DWORD) ( timeout >> 32 );
+
+	SetThreadpoolTimer(
+	 internal_thread_pool->delayed_values_timer,
+	 &due_time,
+	 0,
+	 0 );
+
+	internal_thread_pool->delayed_values_timer_deadline = deadline;
+
+	return( 1 );
+}
+
+#endif /* defined( WINAPI ) && ( WINVER >= 0x0602 ) */
+
+/* Pushes a value onto the queue of the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_pool_push(
+     libcthreads_thread_pool_t *thread_pool,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
+	static char *function                                    = "libcthreads_thread_pool_push";
+
+#if defined( WINAPI ) && ( WINVER >= 0x0602 )
+	TP_WORK *thread_pool_work                                = NULL;
+	DWORD error_code                                         = 0;
+#endif
+
+	if( thread_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1108,6 +1850,10 @@ int libcthreads_thread_pool_push(
 	}
 	internal_thread_pool->number_of_values++;
 
+	libcthreads_tracer_record_event(
+	 LIBCTHREADS_TRACER_EVENT_ENQUEUE,
+	 internal_thread_pool );
+
 	/* The condition broadcast must be protected by the mutex for the WINAPI version
 	 */
 	if( libcthreads_condition_broadcast(
@@ -1379,6 +2125,10 @@ int libcthreads_thread_pool_push_sorted(
 		}
 		internal_thread_pool->number_of_values++;
 
+		libcthreads_tracer_record_event(
+		 LIBCTHREADS_TRACER_EVENT_ENQUEUE,
+		 internal_thread_pool );
+
 		/* The condition broadcast must be protected by the mutex for the WINAPI version
 		 */
 		if( libcthreads_condition_broadcast(
@@ -1443,6 +2193,319 @@ on_error:
 	return( -1 );
 }
 
+/* Submits a value to the thread pool that is processed after delay nanoseconds
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_pool_submit_after(
+     libcthreads_thread_pool_t *thread_pool,
+     intptr_t *value,
+     uint64_t delay,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_thread_pool_submit_after";
+	uint64_t deadline     = 0;
+
+	if( libcthreads_clock_get_deadline(
+	     delay,
+	     &deadline,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine deadline.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_pool_submit_at(
+	     thread_pool,
+	     value,
+	     deadline,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to submit value.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Submits a value to the thread pool that is processed at or after deadline
+ * The deadline is a time of the monotonic clock in nanoseconds,
+ * as returned by libcthreads_clock_get_monotonic_time
+ *
+ * Delayed values are kept in a heap ordered by deadline, values with the same
+ * deadline are processed in order of submission. Idle worker threads sleep
+ * until the earliest deadline, or on Windows 8 or later a single thread pool
+ * timer submits the work when the earliest deadline is due. Delayed values
+ * that are not due when the thread pool is joined are not processed.
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_pool_submit_at(
+     libcthreads_thread_pool_t *thread_pool,
+     intptr_t *value,
+     uint64_t deadline,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
+	static char *function                                    = "libcthreads_thread_pool_submit_at";
+	int result                                               = 0;
+
+	if( thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_pool = (libcthreads_internal_thread_pool_t *) thread_pool;
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_thread_pool->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_internal_thread_pool_insert_delayed_value(
+	          internal_thread_pool,
+	          value,
+	          deadline,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert delayed value.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( WINAPI ) && ( WINVER >= 0x0602 )
+	/* Only set the timer if the value is due before the timer expires,
+	 * the timer submits the work when the value is due
+	 */
+	if( deadline < internal_thread_pool->delayed_values_timer_deadline )
+	{
+		if( libcthreads_internal_thread_pool_set_delayed_values_timer(
+		     internal_thread_pool,
+		     deadline,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set delayed values timer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#else
+	/* Only wake a worker thread if the earliest deadline has changed
+	 */
+	if( result == 1 )
+	{
+		if( libcthreads_condition_signal(
+		     internal_thread_pool->empty_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal empty condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( WINAPI ) && ( WINVER >= 0x0602 ) */
+
+	if( libcthreads_mutex_release(
+	     internal_thread_pool->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_thread_pool->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Sets the completion queue of the thread pool
+ * Values for which the callback function was successful are pushed onto
+ * the completion queue, which can be monitored by an event loop using
+ * libcthreads_queue_get_readiness_file_descriptor
+ * Values are not waited on when the completion queue is full but dropped and
+ * counted, refer to libcthreads_thread_pool_get_number_of_dropped_completions
+ * The completion queue must be set before values are pushed onto the thread pool
+ * and is not freed by the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_pool_set_completion_queue(
+     libcthreads_thread_pool_t *thread_pool,
+     libcthreads_queue_t *completion_queue,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
+	static char *function                                    = "libcthreads_thread_pool_set_completion_queue";
+
+	if( thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_pool = (libcthreads_internal_thread_pool_t *) thread_pool;
+
+	if( libcthreads_mutex_grab(
+	     internal_thread_pool->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_pool->completion_queue = completion_queue;
+
+	if( libcthreads_mutex_release(
+	     internal_thread_pool->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of values that were dropped because the completion queue was full
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_pool_get_number_of_dropped_completions(
+     libcthreads_thread_pool_t *thread_pool,
+     int *number_of_dropped_completions,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
+	static char *function                                    = "libcthreads_thread_pool_get_number_of_dropped_completions";
+
+	if( thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_pool = (libcthreads_internal_thread_pool_t *) thread_pool;
+
+	if( number_of_dropped_completions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of dropped completions.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_thread_pool->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_dropped_completions = internal_thread_pool->number_of_dropped_completions;
+
+	if( libcthreads_mutex_release(
+	     internal_thread_pool->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Joins the current with a specified thread pool
  * The the thread is freed after join
  * Returns 1 if successful or -1 on error
@@ -1463,7 +2526,7 @@ int libcthreads_thread_pool_join(
 	DWORD wait_status                                        = 0;
 
 #elif defined( HAVE_PTHREAD_H )
-	int *thread_return_value                                 = NULL;
+	void *thread_return_value                                = NULL;
 	int pthread_result                                       = 0;
 #endif
 #endif /* !defined( WINAPI ) || ( WINVER < 0x0602 ) */
@@ -1558,6 +2621,19 @@ int libcthreads_thread_pool_join(
 		return( -1 );
 	}
 #if defined( WINAPI ) && ( WINVER >= 0x0602 )
+	/* Stop the delayed values timer and wait for the work it submitted
+	 * to be processed
+	 */
+	SetThreadpoolTimer(
+	 internal_thread_pool->delayed_values_timer,
+	 NULL,
+	 0,
+	 0 );
+
+	WaitForThreadpoolTimerCallbacks(
+	 internal_thread_pool->delayed_values_timer,
+	 TRUE );
+
 	CloseThreadpoolCleanupGroupMembers(
 	 internal_thread_pool->cleanup_group,
 	 FALSE,
@@ -1606,7 +2682,7 @@ int libcthreads_thread_pool_join(
 	{
 		pthread_result = pthread_join(
 		                  internal_thread_pool->threads_array[ thread_index ],
-		                  (void **) &thread_return_value );
+		                  &thread_return_value );
 
 		if( pthread_result == EDEADLK )
 		{
@@ -1636,7 +2712,7 @@ int libcthreads_thread_pool_join(
 		/* If the thread returns NULL it never got around to launching the callback function
 		 */
 		else if( ( thread_return_value != NULL )
-		      && ( *thread_return_value != 1 ) )
+		      && ( (intptr_t) thread_return_value != 1 ) )
 		{
 			libcerror_error_set(
 			 error,
@@ -1645,17 +2721,10 @@ int libcthreads_thread_pool_join(
 			 "%s: thread: %d returned an error status of: %d.",
 			 function,
 			 thread_index,
-			 *thread_return_value );
+			 (int) (intptr_t) thread_return_value );
 
 			result = -1;
 		}
-		if( thread_return_value != NULL )
-		{
-			memory_free(
-			 thread_return_value );
-
-			thread_return_value = NULL;
-		}
 	}
 #endif /* defined( WINAPI ) && ( WINVER >= 0x0602 ) */
 	if( libcthreads_condition_free(
@@ -1709,6 +2778,11 @@ int libcthreads_thread_pool_join(
 	 internal_thread_pool->threads_array );
 #endif
 
+	if( internal_thread_pool->delayed_values_heap != NULL )
+	{
+		memory_free(
+		 internal_thread_pool->delayed_values_heap );
+	}
 	memory_free(
 	 internal_thread_pool->values_array );
 	memory_free(
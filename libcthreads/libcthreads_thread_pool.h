@@ -39,7 +39,27 @@ extern "C" {
 
 #if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
 
+/* The initial number of entries of the delayed values heap
+ */
+#define LIBCTHREADS_THREAD_POOL_INITIAL_NUMBER_OF_DELAYED_VALUES	16
+
 typedef struct libcthreads_internal_thread_pool libcthreads_internal_thread_pool_t;
+typedef struct libcthreads_internal_thread_pool_delayed_value libcthreads_internal_thread_pool_delayed_value_t;
+
+struct libcthreads_internal_thread_pool_delayed_value
+{
+	/* The monotonic time at which the value is due
+	 */
+	uint64_t deadline;
+
+	/* The sequence number, used to keep values with the same deadline in order of submission
+	 */
+	uint64_t sequence_number;
+
+	/* The value
+	 */
+	intptr_t *value;
+};
 
 struct libcthreads_internal_thread_pool
 {
@@ -56,6 +76,19 @@ struct libcthreads_internal_thread_pool
 	 */
 	TP_CALLBACK_ENVIRON callback_environment;
 
+	/* The timer that submits work when delayed values are due
+	 */
+	TP_TIMER *delayed_values_timer;
+
+	/* The deadline the delayed values timer is set to
+	 * or UINT64_MAX if the timer is not set
+	 */
+	uint64_t delayed_values_timer_deadline;
+
+	/* The number of due delayed values for which work was submitted
+	 */
+	int number_of_released_delayed_values;
+
 #else
 	/* The number of threads in the pool
 	 */
@@ -111,6 +144,22 @@ struct libcthreads_internal_thread_pool
 	 */
 	intptr_t **values_array;
 
+	/* The delayed values heap, ordered by deadline
+	 */
+	libcthreads_internal_thread_pool_delayed_value_t *delayed_values_heap;
+
+	/* The number of delayed values
+	 */
+	int number_of_delayed_values;
+
+	/* The allocated number of delayed values
+	 */
+	int allocated_number_of_delayed_values;
+
+	/* The next delayed value sequence number
+	 */
+	uint64_t next_sequence_number;
+
 	/* The condition mutex
 	 */
 	libcthreads_mutex_t *condition_mutex;
@@ -123,6 +172,14 @@ struct libcthreads_internal_thread_pool
 	 */
 	libcthreads_condition_t *full_condition;
 
+	/* The completion queue
+	 */
+	libcthreads_queue_t *completion_queue;
+
+	/* The number of values that were dropped because the completion queue was full
+	 */
+	int number_of_dropped_completions;
+
 	/* The status
 	 */
 	uint8_t status;
@@ -145,6 +202,40 @@ int libcthreads_internal_thread_pool_pop(
      intptr_t **value,
      libcerror_error_t **error );
 
+int libcthreads_internal_thread_pool_push_completion(
+     libcthreads_internal_thread_pool_t *internal_thread_pool,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+int libcthreads_internal_thread_pool_delayed_value_compare(
+     libcthreads_internal_thread_pool_delayed_value_t *first_delayed_value,
+     libcthreads_internal_thread_pool_delayed_value_t *second_delayed_value );
+
+int libcthreads_internal_thread_pool_insert_delayed_value(
+     libcthreads_internal_thread_pool_t *internal_thread_pool,
+     intptr_t *value,
+     uint64_t deadline,
+     libcerror_error_t **error );
+
+void libcthreads_internal_thread_pool_remove_first_delayed_value(
+      libcthreads_internal_thread_pool_t *internal_thread_pool,
+      intptr_t **value );
+
+#if defined( WINAPI ) && ( WINVER >= 0x0602 )
+
+void libcthreads_internal_thread_pool_get_due_delayed_values(
+      libcthreads_internal_thread_pool_t *internal_thread_pool,
+      uint64_t monotonic_time,
+      int *number_of_due_delayed_values,
+      uint64_t *next_deadline );
+
+int libcthreads_internal_thread_pool_set_delayed_values_timer(
+     libcthreads_internal_thread_pool_t *internal_thread_pool,
+     uint64_t deadline,
+     libcerror_error_t **error );
+
+#endif /* defined( WINAPI ) && ( WINVER >= 0x0602 ) */
+
 LIBCTHREADS_EXTERN \
 int libcthreads_thread_pool_push(
      libcthreads_thread_pool_t *thread_pool,
@@ -162,6 +253,32 @@ int libcthreads_thread_pool_push_sorted(
      uint8_t sort_flags,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_thread_pool_submit_after(
+     libcthreads_thread_pool_t *thread_pool,
+     intptr_t *value,
+     uint64_t delay,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_thread_pool_submit_at(
+     libcthreads_thread_pool_t *thread_pool,
+     intptr_t *value,
+     uint64_t deadline,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_thread_pool_set_completion_queue(
+     libcthreads_thread_pool_t *thread_pool,
+     libcthreads_queue_t *completion_queue,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_thread_pool_get_number_of_dropped_completions(
+     libcthreads_thread_pool_t *thread_pool,
+     int *number_of_dropped_completions,
+     libcerror_error_t **error );
+
 LIBCTHREADS_EXTERN \
 int libcthreads_thread_pool_join(
      libcthreads_thread_pool_t **thread_pool,
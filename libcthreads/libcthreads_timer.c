@@ -0,0 +1,165 @@
+/*
+ * Timer functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libcthreads_atomic.h"
+#include "libcthreads_definitions.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_timer.h"
+#include "libcthreads_timer_service.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a timer
+ * Make sure the value timer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_timer_initialize(
+     libcthreads_timer_t **timer,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_timer_t *internal_timer = NULL;
+	static char *function                        = "libcthreads_timer_initialize";
+
+	if( timer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *timer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid timer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_timer = memory_allocate_structure(
+	                  libcthreads_internal_timer_t );
+
+	if( internal_timer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create timer.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     internal_timer,
+	     0,
+	     sizeof( libcthreads_internal_timer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear timer.",
+		 function );
+
+		memory_free(
+		 internal_timer );
+
+		return( -1 );
+	}
+	*timer = (libcthreads_timer_t *) internal_timer;
+
+	return( 1 );
+}
+
+/* Frees a timer
+ * A timer that is scheduled is cancelled first, the timer service
+ * checks under its condition mutex whether the timer is still scheduled
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_timer_free(
+     libcthreads_timer_t **timer,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_timer_t *internal_timer = NULL;
+	libcthreads_timer_service_t *timer_service   = NULL;
+	static char *function                        = "libcthreads_timer_free";
+	int result                                   = 1;
+
+	if( timer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *timer != NULL )
+	{
+		internal_timer = (libcthreads_internal_timer_t *) *timer;
+		*timer         = NULL;
+
+		/* The timer service clears the timer service of an expired timer
+		 * after it no longer references the timer
+		 */
+		timer_service = (libcthreads_timer_service_t *) libcthreads_atomic_load_pointer(
+		                 (intptr_t * volatile *) &( internal_timer->timer_service ),
+		                 LIBCTHREADS_MEMORY_ORDER_ACQUIRE );
+
+		if( timer_service != NULL )
+		{
+			if( libcthreads_timer_service_cancel(
+			     timer_service,
+			     (libcthreads_timer_t *) internal_timer,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to cancel timer.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 internal_timer );
+	}
+	return( result );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
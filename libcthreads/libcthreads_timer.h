@@ -0,0 +1,87 @@
+/*
+ * Timer functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_TIMER_H )
+#define _LIBCTHREADS_INTERNAL_TIMER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct libcthreads_internal_timer libcthreads_internal_timer_t;
+
+struct libcthreads_internal_timer
+{
+	/* The timer service the timer is scheduled on
+	 * or NULL if the timer is not scheduled
+	 * The timer service is only changed with the condition mutex of
+	 * the timer service grabbed and is accessed atomically
+	 */
+	libcthreads_timer_service_t *timer_service;
+
+	/* The tick at which the timer expires
+	 */
+	uint64_t expiry_tick;
+
+	/* The value passed on when the timer expires
+	 */
+	intptr_t *value;
+
+	/* The timer wheel slot that contains the timer
+	 */
+	libcthreads_internal_timer_t **slot;
+
+	/* The previous timer in the slot
+	 */
+	libcthreads_internal_timer_t *previous_timer;
+
+	/* The next timer in the slot
+	 */
+	libcthreads_internal_timer_t *next_timer;
+};
+
+LIBCTHREADS_EXTERN \
+int libcthreads_timer_initialize(
+     libcthreads_timer_t **timer,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_timer_free(
+     libcthreads_timer_t **timer,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_TIMER_H ) */
+
@@ -0,0 +1,989 @@
+/*
+ * Timer service functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libcthreads_atomic.h"
+#include "libcthreads_clock.h"
+#include "libcthreads_condition.h"
+#include "libcthreads_definitions.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_mutex.h"
+#include "libcthreads_thread.h"
+#include "libcthreads_thread_pool.h"
+#include "libcthreads_timer.h"
+#include "libcthreads_timer_service.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Inserts a timer into the timer wheel
+ *
+ * The level is determined by how far the timer expires from the current tick,
+ * the slot by the bits of the expiry tick that correspond to the level.
+ * Timers on higher levels are cascaded into lower levels when the current
+ * tick wraps the slots of the lower level.
+ *
+ * Make sure the condition mutex is grabbed before calling this function
+ */
+void libcthreads_internal_timer_service_insert_timer(
+      libcthreads_internal_timer_service_t *internal_timer_service,
+      libcthreads_internal_timer_t *internal_timer )
+{
+	uint64_t delta       = 0;
+	uint64_t expiry_tick = 0;
+	int level            = 0;
+	int slot_index       = 0;
+
+	expiry_tick = internal_timer->expiry_tick;
+
+	if( expiry_tick < internal_timer_service->current_tick )
+	{
+		expiry_tick = internal_timer_service->current_tick;
+	}
+	delta = expiry_tick - internal_timer_service->current_tick;
+
+	for( level = 0;
+	     level < ( LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_LEVELS - 1 );
+	     level++ )
+	{
+		if( delta < ( (uint64_t) 1 << ( ( level + 1 ) * LIBCTHREADS_TIMER_SERVICE_SLOT_BITS ) ) )
+		{
+			break;
+		}
+	}
+	/* A timer that expires beyond the range of the timer wheel is placed
+	 * in the last slot of the highest level and reinserted when cascaded
+	 */
+	if( delta >= ( (uint64_t) 1 << ( LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_LEVELS * LIBCTHREADS_TIMER_SERVICE_SLOT_BITS ) ) )
+	{
+		expiry_tick = internal_timer_service->current_tick
+		            + ( (uint64_t) 1 << ( LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_LEVELS * LIBCTHREADS_TIMER_SERVICE_SLOT_BITS ) ) - 1;
+	}
+	slot_index = (int) ( ( expiry_tick >> ( level * LIBCTHREADS_TIMER_SERVICE_SLOT_BITS ) ) & ( LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_SLOTS - 1 ) );
+
+	internal_timer->slot           = &( internal_timer_service->slots[ level ][ slot_index ] );
+	internal_timer->previous_timer = NULL;
+	internal_timer->next_timer     = *( internal_timer->slot );
+
+	if( internal_timer->next_timer != NULL )
+	{
+		internal_timer->next_timer->previous_timer = internal_timer;
+	}
+	*( internal_timer->slot ) = internal_timer;
+}
+
+/* Removes a timer from the timer wheel
+ * Make sure the condition mutex is grabbed before calling this function
+ */
+void libcthreads_internal_timer_service_remove_timer(
+      libcthreads_internal_timer_t *internal_timer )
+{
+	if( internal_timer->previous_timer != NULL )
+	{
+		internal_timer->previous_timer->next_timer = internal_timer->next_timer;
+	}
+	else
+	{
+		*( internal_timer->slot ) = internal_timer->next_timer;
+	}
+	if( internal_timer->next_timer != NULL )
+	{
+		internal_timer->next_timer->previous_timer = internal_timer->previous_timer;
+	}
+	internal_timer->slot           = NULL;
+	internal_timer->previous_timer = NULL;
+	internal_timer->next_timer     = NULL;
+}
+
+/* Processes the ticks up to and including the target tick and collects
+ * the values of the expired timers into the expired values
+ * Make sure the condition mutex is grabbed before calling this function
+ * Returns the number of expired values
+ */
+int libcthreads_internal_timer_service_expire_timers(
+      libcthreads_internal_timer_service_t *internal_timer_service,
+      uint64_t target_tick )
+{
+	libcthreads_internal_timer_t *internal_timer = NULL;
+	libcthreads_internal_timer_t *next_timer     = NULL;
+	uint64_t current_tick                        = 0;
+	int level                                    = 0;
+	int number_of_expired_values                 = 0;
+	int slot_index                               = 0;
+
+	while( ( internal_timer_service->current_tick <= target_tick )
+	    && ( number_of_expired_values < LIBCTHREADS_TIMER_SERVICE_MAXIMUM_BATCH_SIZE ) )
+	{
+		current_tick = internal_timer_service->current_tick;
+
+		/* When the slots of a level wrap cascade the timers of the next
+		 * slot of the level above into the lower levels
+		 */
+		for( level = 1;
+		     level < LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_LEVELS;
+		     level++ )
+		{
+			if( ( current_tick & ( ( (uint64_t) 1 << ( level * LIBCTHREADS_TIMER_SERVICE_SLOT_BITS ) ) - 1 ) ) != 0 )
+			{
+				break;
+			}
+			slot_index = (int) ( ( current_tick >> ( level * LIBCTHREADS_TIMER_SERVICE_SLOT_BITS ) ) & ( LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_SLOTS - 1 ) );
+
+			internal_timer = internal_timer_service->slots[ level ][ slot_index ];
+
+			internal_timer_service->slots[ level ][ slot_index ] = NULL;
+
+			while( internal_timer != NULL )
+			{
+				next_timer = internal_timer->next_timer;
+
+				libcthreads_internal_timer_service_insert_timer(
+				 internal_timer_service,
+				 internal_timer );
+
+				internal_timer = next_timer;
+			}
+		}
+		slot_index = (int) ( current_tick & ( LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_SLOTS - 1 ) );
+
+		while( ( internal_timer_service->slots[ 0 ][ slot_index ] != NULL )
+		    && ( number_of_expired_values < LIBCTHREADS_TIMER_SERVICE_MAXIMUM_BATCH_SIZE ) )
+		{
+			internal_timer = internal_timer_service->slots[ 0 ][ slot_index ];
+
+			internal_timer_service->expired_values[ number_of_expired_values++ ] = internal_timer->value;
+
+			libcthreads_internal_timer_service_remove_timer(
+			 internal_timer );
+
+			/* The timer can be freed once its timer service is cleared
+			 */
+			libcthreads_atomic_store_pointer(
+			 (intptr_t * volatile *) &( internal_timer->timer_service ),
+			 NULL,
+			 LIBCTHREADS_MEMORY_ORDER_RELEASE );
+
+			internal_timer_service->number_of_timers--;
+		}
+		/* If the batch is full before the slot is empty the same tick
+		 * is processed again, cascading an empty slot again is harmless
+		 */
+		if( internal_timer_service->slots[ 0 ][ slot_index ] == NULL )
+		{
+			internal_timer_service->current_tick += 1;
+		}
+	}
+	return( number_of_expired_values );
+}
+
+/* Determines the next tick that has work to do
+ * This is either the next tick with a non-empty slot on the first level
+ * or the next tick at which timers are cascaded, whichever comes first
+ * Make sure the condition mutex is grabbed before calling this function
+ * Returns the next tick
+ */
+uint64_t libcthreads_internal_timer_service_get_next_tick(
+          libcthreads_internal_timer_service_t *internal_timer_service )
+{
+	uint64_t next_tick = 0;
+
+	next_tick = internal_timer_service->current_tick;
+
+	if( ( next_tick & ( LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_SLOTS - 1 ) ) == 0 )
+	{
+		return( next_tick );
+	}
+	do
+	{
+		if( internal_timer_service->slots[ 0 ][ next_tick & ( LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_SLOTS - 1 ) ] != NULL )
+		{
+			break;
+		}
+		next_tick++;
+	}
+	while( ( next_tick & ( LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_SLOTS - 1 ) ) != 0 );
+
+	return( next_tick );
+}
+
+/* Runs the timer service until it is joined
+ * Expired timers are dispatched in batches without the condition mutex grabbed
+ * A failure to dispatch an expired value does not stop the timer service
+ * but is reported when the timer service is joined
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_timer_service_run(
+     void *arguments )
+{
+	libcerror_error_t *error                                     = NULL;
+	libcthreads_internal_timer_service_t *internal_timer_service = NULL;
+	uint64_t deadline                                            = 0;
+	uint64_t monotonic_time                                      = 0;
+	uint64_t target_tick                                         = 0;
+	int dispatch_result                                          = 0;
+	int number_of_expired_values                                 = 0;
+	int result                                                   = 1;
+	int value_index                                              = 0;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	internal_timer_service = (libcthreads_internal_timer_service_t *) arguments;
+
+	if( libcthreads_mutex_grab(
+	     internal_timer_service->condition_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	while( internal_timer_service->status != LIBCTHREADS_STATUS_EXIT )
+	{
+		if( internal_timer_service->number_of_timers == 0 )
+		{
+			internal_timer_service->wait_tick = UINT64_MAX;
+
+			if( libcthreads_condition_wait(
+			     internal_timer_service->status_condition,
+			     internal_timer_service->condition_mutex,
+			     NULL ) != 1 )
+			{
+				result = -1;
+
+				break;
+			}
+			continue;
+		}
+		if( libcthreads_clock_get_monotonic_time(
+		     &monotonic_time,
+		     NULL ) != 1 )
+		{
+			result = -1;
+
+			break;
+		}
+		target_tick = ( monotonic_time - internal_timer_service->start_time ) / internal_timer_service->tick_duration;
+
+		if( internal_timer_service->current_tick > target_tick )
+		{
+			internal_timer_service->wait_tick = libcthreads_internal_timer_service_get_next_tick(
+			                                     internal_timer_service );
+
+			if( internal_timer_service->wait_tick > ( ( UINT64_MAX - internal_timer_service->start_time ) / internal_timer_service->tick_duration ) )
+			{
+				deadline = UINT64_MAX;
+			}
+			else
+			{
+				deadline = internal_timer_service->start_time
+				         + ( internal_timer_service->wait_tick * internal_timer_service->tick_duration );
+			}
+			if( libcthreads_condition_wait_until(
+			     internal_timer_service->status_condition,
+			     internal_timer_service->condition_mutex,
+			     deadline,
+			     NULL ) == -1 )
+			{
+				result = -1;
+
+				break;
+			}
+			continue;
+		}
+		number_of_expired_values = libcthreads_internal_timer_service_expire_timers(
+		                            internal_timer_service,
+		                            target_tick );
+
+		if( number_of_expired_values == 0 )
+		{
+			continue;
+		}
+		libcthreads_mutex_release(
+		 internal_timer_service->condition_mutex,
+		 NULL );
+
+		for( value_index = 0;
+		     value_index < number_of_expired_values;
+		     value_index++ )
+		{
+			if( internal_timer_service->thread_pool != NULL )
+			{
+				dispatch_result = libcthreads_thread_pool_push(
+				                   internal_timer_service->thread_pool,
+				                   internal_timer_service->expired_values[ value_index ],
+				                   &error );
+			}
+			else
+			{
+				dispatch_result = internal_timer_service->callback_function(
+				                   internal_timer_service->expired_values[ value_index ],
+				                   internal_timer_service->callback_function_arguments );
+			}
+			if( dispatch_result != 1 )
+			{
+				result = -1;
+			}
+			if( error != NULL )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				libcerror_error_backtrace_fprint(
+				 error,
+				 stdout );
+#endif
+				libcerror_error_free(
+				 &error );
+			}
+		}
+		if( libcthreads_mutex_grab(
+		     internal_timer_service->condition_mutex,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	libcthreads_mutex_release(
+	 internal_timer_service->condition_mutex,
+	 NULL );
+
+	return( result );
+}
+
+/* Creates a timer service
+ * Make sure the value timer_service is referencing, is set to NULL
+ *
+ * The timer service multiplexes timers onto a single thread using a
+ * hierarchical timer wheel with a resolution of tick_duration nanoseconds.
+ * The value of an expired timer is either passed to the callback_function
+ * on the timer service thread or pushed onto the thread_pool, only one of
+ * both should be set.
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_timer_service_create(
+     libcthreads_timer_service_t **timer_service,
+     const libcthreads_thread_attributes_t *thread_attributes,
+     uint64_t tick_duration,
+     int (*callback_function)(
+            intptr_t *value,
+            void *arguments ),
+     void *callback_function_arguments,
+     libcthreads_thread_pool_t *thread_pool,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_timer_service_t *internal_timer_service = NULL;
+	static char *function                                        = "libcthreads_timer_service_create";
+
+	if( timer_service == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timer service.",
+		 function );
+
+		return( -1 );
+	}
+	if( *timer_service != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid timer service value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( tick_duration == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid tick duration value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( callback_function == NULL )
+	 && ( thread_pool == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function and thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( callback_function != NULL )
+	 && ( thread_pool != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_CONFLICTING_VALUE,
+		 "%s: invalid callback function and thread pool - only one can be set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_timer_service = memory_allocate_structure(
+	                          libcthreads_internal_timer_service_t );
+
+	if( internal_timer_service == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create timer service.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_timer_service,
+	     0,
+	     sizeof( libcthreads_internal_timer_service_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear timer service.",
+		 function );
+
+		memory_free(
+		 internal_timer_service );
+
+		return( -1 );
+	}
+	internal_timer_service->tick_duration               = tick_duration;
+	internal_timer_service->callback_function           = callback_function;
+	internal_timer_service->callback_function_arguments = callback_function_arguments;
+	internal_timer_service->thread_pool                 = thread_pool;
+	internal_timer_service->wait_tick                   = UINT64_MAX;
+
+	if( libcthreads_clock_get_monotonic_time(
+	     &( internal_timer_service->start_time ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic time.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_timer_service->condition_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( internal_timer_service->status_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create status condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_create(
+	     &( internal_timer_service->thread ),
+	     thread_attributes,
+	     &libcthreads_internal_timer_service_run,
+	     (void *) internal_timer_service,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread.",
+		 function );
+
+		goto on_error;
+	}
+	*timer_service = (libcthreads_timer_service_t *) internal_timer_service;
+
+	return( 1 );
+
+on_error:
+	if( internal_timer_service != NULL )
+	{
+		if( internal_timer_service->status_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( internal_timer_service->status_condition ),
+			 NULL );
+		}
+		if( internal_timer_service->condition_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_timer_service->condition_mutex ),
+			 NULL );
+		}
+		memory_free(
+		 internal_timer_service );
+	}
+	return( -1 );
+}
+
+/* Schedules a timer to expire after timeout nanoseconds
+ * A timer that is already scheduled is rescheduled
+ * The timer expires at the first tick at or after the timeout
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_timer_service_schedule(
+     libcthreads_timer_service_t *timer_service,
+     libcthreads_timer_t *timer,
+     uint64_t timeout,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_timer_t *internal_timer                 = NULL;
+	libcthreads_internal_timer_service_t *internal_timer_service = NULL;
+	libcthreads_timer_service_t *scheduled_timer_service         = NULL;
+	static char *function                                        = "libcthreads_timer_service_schedule";
+	uint64_t elapsed_time                                        = 0;
+	uint64_t expiry_tick                                         = 0;
+	uint64_t monotonic_time                                      = 0;
+	uint64_t now_tick                                            = 0;
+	int result                                                   = 1;
+
+	if( timer_service == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timer service.",
+		 function );
+
+		return( -1 );
+	}
+	internal_timer_service = (libcthreads_internal_timer_service_t *) timer_service;
+
+	if( timer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_timer = (libcthreads_internal_timer_t *) timer;
+
+	if( libcthreads_clock_get_monotonic_time(
+	     &monotonic_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic time.",
+		 function );
+
+		return( -1 );
+	}
+	elapsed_time = monotonic_time - internal_timer_service->start_time;
+	now_tick     = elapsed_time / internal_timer_service->tick_duration;
+
+	if( timeout > ( UINT64_MAX - elapsed_time ) )
+	{
+		elapsed_time = UINT64_MAX;
+	}
+	else
+	{
+		elapsed_time += timeout;
+	}
+	/* Round up so the timer does not expire before the timeout
+	 */
+	expiry_tick = elapsed_time / internal_timer_service->tick_duration;
+
+	if( ( elapsed_time % internal_timer_service->tick_duration ) != 0 )
+	{
+		expiry_tick += 1;
+	}
+	if( libcthreads_mutex_grab(
+	     internal_timer_service->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	scheduled_timer_service = (libcthreads_timer_service_t *) libcthreads_atomic_load_pointer(
+	                           (intptr_t * volatile *) &( internal_timer->timer_service ),
+	                           LIBCTHREADS_MEMORY_ORDER_ACQUIRE );
+
+	if( ( scheduled_timer_service != NULL )
+	 && ( scheduled_timer_service != timer_service ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid timer - already scheduled on another timer service.",
+		 function );
+
+		goto on_error;
+	}
+	if( scheduled_timer_service != NULL )
+	{
+		libcthreads_internal_timer_service_remove_timer(
+		 internal_timer );
+	}
+	else
+	{
+		/* The timer wheel is not advanced while it is empty
+		 */
+		if( ( internal_timer_service->number_of_timers == 0 )
+		 && ( internal_timer_service->current_tick < now_tick ) )
+		{
+			internal_timer_service->current_tick = now_tick;
+		}
+		internal_timer_service->number_of_timers++;
+	}
+	internal_timer->expiry_tick = expiry_tick;
+	internal_timer->value       = value;
+
+	libcthreads_atomic_store_pointer(
+	 (intptr_t * volatile *) &( internal_timer->timer_service ),
+	 (intptr_t *) timer_service,
+	 LIBCTHREADS_MEMORY_ORDER_RELEASE );
+
+	libcthreads_internal_timer_service_insert_timer(
+	 internal_timer_service,
+	 internal_timer );
+
+	/* Only wake the thread if the timer expires before the tick it waits for
+	 */
+	if( expiry_tick < internal_timer_service->wait_tick )
+	{
+		internal_timer_service->wait_tick = expiry_tick;
+
+		if( libcthreads_condition_signal(
+		     internal_timer_service->status_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal status condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_timer_service->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_timer_service->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Cancels a timer
+ * Returns 1 if successful, 0 if the timer was not scheduled or -1 on error
+ */
+int libcthreads_timer_service_cancel(
+     libcthreads_timer_service_t *timer_service,
+     libcthreads_timer_t *timer,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_timer_t *internal_timer                 = NULL;
+	libcthreads_internal_timer_service_t *internal_timer_service = NULL;
+	static char *function                                        = "libcthreads_timer_service_cancel";
+	int result                                                   = 0;
+
+	if( timer_service == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timer service.",
+		 function );
+
+		return( -1 );
+	}
+	internal_timer_service = (libcthreads_internal_timer_service_t *) timer_service;
+
+	if( timer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_timer = (libcthreads_internal_timer_t *) timer;
+
+	if( libcthreads_mutex_grab(
+	     internal_timer_service->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_atomic_load_pointer(
+	     (intptr_t * volatile *) &( internal_timer->timer_service ),
+	     LIBCTHREADS_MEMORY_ORDER_ACQUIRE ) == (intptr_t *) timer_service )
+	{
+		libcthreads_internal_timer_service_remove_timer(
+		 internal_timer );
+
+		libcthreads_atomic_store_pointer(
+		 (intptr_t * volatile *) &( internal_timer->timer_service ),
+		 NULL,
+		 LIBCTHREADS_MEMORY_ORDER_RELEASE );
+
+		internal_timer_service->number_of_timers--;
+
+		result = 1;
+	}
+	if( libcthreads_mutex_release(
+	     internal_timer_service->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Joins the current thread with the timer service thread
+ * Timers that have not expired are cancelled
+ * The timer service is freed after join
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_timer_service_join(
+     libcthreads_timer_service_t **timer_service,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_timer_t *internal_timer                 = NULL;
+	libcthreads_internal_timer_service_t *internal_timer_service = NULL;
+	static char *function                                        = "libcthreads_timer_service_join";
+	int level                                                    = 0;
+	int result                                                   = 1;
+	int slot_index                                               = 0;
+
+	if( timer_service == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timer service.",
+		 function );
+
+		return( -1 );
+	}
+	if( *timer_service == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing timer service value.",
+		 function );
+
+		return( -1 );
+	}
+	internal_timer_service = (libcthreads_internal_timer_service_t *) *timer_service;
+	*timer_service         = NULL;
+
+	if( libcthreads_mutex_grab(
+	     internal_timer_service->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_timer_service->status = LIBCTHREADS_STATUS_EXIT;
+
+	if( libcthreads_condition_signal(
+	     internal_timer_service->status_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to signal status condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     internal_timer_service->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	if( libcthreads_thread_join(
+	     &( internal_timer_service->thread ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join thread.",
+		 function );
+
+		result = -1;
+	}
+	for( level = 0;
+	     level < LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_LEVELS;
+	     level++ )
+	{
+		for( slot_index = 0;
+		     slot_index < LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_SLOTS;
+		     slot_index++ )
+		{
+			while( internal_timer_service->slots[ level ][ slot_index ] != NULL )
+			{
+				internal_timer = internal_timer_service->slots[ level ][ slot_index ];
+
+				libcthreads_internal_timer_service_remove_timer(
+				 internal_timer );
+
+				libcthreads_atomic_store_pointer(
+				 (intptr_t * volatile *) &( internal_timer->timer_service ),
+				 NULL,
+				 LIBCTHREADS_MEMORY_ORDER_RELEASE );
+			}
+		}
+	}
+	if( libcthreads_condition_free(
+	     &( internal_timer_service->status_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free status condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_free(
+	     &( internal_timer_service->condition_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free condition mutex.",
+		 function );
+
+		result = -1;
+	}
+	memory_free(
+	 internal_timer_service );
+
+	return( result );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
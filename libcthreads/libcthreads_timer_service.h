@@ -0,0 +1,173 @@
+/*
+ * Timer service functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_TIMER_SERVICE_H )
+#define _LIBCTHREADS_INTERNAL_TIMER_SERVICE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_timer.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The number of levels of the timer wheel
+ */
+#define LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_LEVELS		4
+
+/* The number of bits of the tick used for a slot index
+ */
+#define LIBCTHREADS_TIMER_SERVICE_SLOT_BITS			6
+
+/* The number of slots per level of the timer wheel
+ */
+#define LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_SLOTS		( 1 << LIBCTHREADS_TIMER_SERVICE_SLOT_BITS )
+
+/* The maximum number of expired timers dispatched per batch
+ */
+#define LIBCTHREADS_TIMER_SERVICE_MAXIMUM_BATCH_SIZE		64
+
+typedef struct libcthreads_internal_timer_service libcthreads_internal_timer_service_t;
+
+struct libcthreads_internal_timer_service
+{
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The callback function
+	 */
+	int (*callback_function)(
+	       intptr_t *value,
+	       void *arguments );
+
+	/* The callback function arguments
+	 */
+	void *callback_function_arguments;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The duration of a tick in nanoseconds
+	 */
+	uint64_t tick_duration;
+
+	/* The monotonic time of tick 0
+	 */
+	uint64_t start_time;
+
+	/* The next tick to process
+	 */
+	uint64_t current_tick;
+
+	/* The tick the thread waits for
+	 */
+	uint64_t wait_tick;
+
+	/* The number of scheduled timers
+	 */
+	int number_of_timers;
+
+	/* The timer wheel slots
+	 */
+	libcthreads_internal_timer_t *slots[ LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_LEVELS ][ LIBCTHREADS_TIMER_SERVICE_NUMBER_OF_SLOTS ];
+
+	/* The values of the expired timers, only accessed by the thread
+	 */
+	intptr_t *expired_values[ LIBCTHREADS_TIMER_SERVICE_MAXIMUM_BATCH_SIZE ];
+
+	/* The condition mutex
+	 */
+	libcthreads_mutex_t *condition_mutex;
+
+	/* The status condition
+	 */
+	libcthreads_condition_t *status_condition;
+
+	/* The status
+	 */
+	uint8_t status;
+};
+
+void libcthreads_internal_timer_service_insert_timer(
+      libcthreads_internal_timer_service_t *internal_timer_service,
+      libcthreads_internal_timer_t *internal_timer );
+
+void libcthreads_internal_timer_service_remove_timer(
+      libcthreads_internal_timer_t *internal_timer );
+
+int libcthreads_internal_timer_service_expire_timers(
+     libcthreads_internal_timer_service_t *internal_timer_service,
+     uint64_t target_tick );
+
+uint64_t libcthreads_internal_timer_service_get_next_tick(
+          libcthreads_internal_timer_service_t *internal_timer_service );
+
+int libcthreads_internal_timer_service_run(
+     void *arguments );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_timer_service_create(
+     libcthreads_timer_service_t **timer_service,
+     const libcthreads_thread_attributes_t *thread_attributes,
+     uint64_t tick_duration,
+     int (*callback_function)(
+            intptr_t *value,
+            void *arguments ),
+     void *callback_function_arguments,
+     libcthreads_thread_pool_t *thread_pool,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_timer_service_schedule(
+     libcthreads_timer_service_t *timer_service,
+     libcthreads_timer_t *timer,
+     uint64_t timeout,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_timer_service_cancel(
+     libcthreads_timer_service_t *timer_service,
+     libcthreads_timer_t *timer,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_timer_service_join(
+     libcthreads_timer_service_t **timer_service,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_TIMER_SERVICE_H ) */
+
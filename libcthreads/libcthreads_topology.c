@@ -0,0 +1,1832 @@
+/*
+ * Hardware topology functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#endif
+
+#if defined( HAVE_UNISTD_H ) && !defined( WINAPI )
+#include <unistd.h>
+#endif
+
+#include "libcthreads_definitions.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_topology.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The size of the buffer used to read sysfs values
+ */
+#define LIBCTHREADS_TOPOLOGY_STRING_SIZE		16384
+
+/* The topology that is read once and shared by all callers
+ */
+static libcthreads_topology_t *libcthreads_topology_cached = NULL;
+
+#if defined( WINAPI )
+static LONG libcthreads_topology_cached_state              = 0;
+
+#elif defined( HAVE_PTHREAD_H )
+static pthread_once_t libcthreads_topology_cached_once     = PTHREAD_ONCE_INIT;
+
+#endif
+
+/* Creates a topology
+ * Make sure the value topology is referencing, is set to NULL
+ * The topology is read from the system, use libcthreads_topology_get
+ * to retrieve a topology that is read only once
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_topology_initialize(
+     libcthreads_topology_t **topology,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_topology_t *internal_topology = NULL;
+	static char *function                              = "libcthreads_topology_initialize";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	if( *topology != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid topology value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_topology = memory_allocate_structure(
+	                     libcthreads_internal_topology_t );
+
+	if( internal_topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create topology.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_topology,
+	     0,
+	     sizeof( libcthreads_internal_topology_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear topology.",
+		 function );
+
+		memory_free(
+		 internal_topology );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_topology_read(
+	     internal_topology,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read topology.",
+		 function );
+
+		goto on_error;
+	}
+	*topology = (libcthreads_topology_t *) internal_topology;
+
+	return( 1 );
+
+on_error:
+	if( internal_topology != NULL )
+	{
+		libcthreads_topology_free(
+		 (libcthreads_topology_t **) &internal_topology,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a topology
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_topology_free(
+     libcthreads_topology_t **topology,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_topology_t *internal_topology = NULL;
+	static char *function                              = "libcthreads_topology_free";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	if( *topology != NULL )
+	{
+		if( *topology == libcthreads_topology_cached )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid topology value is shared.",
+			 function );
+
+			return( -1 );
+		}
+		internal_topology = (libcthreads_internal_topology_t *) *topology;
+		*topology         = NULL;
+
+		if( internal_topology->cpu_node_indexes != NULL )
+		{
+			memory_free(
+			 internal_topology->cpu_node_indexes );
+		}
+		if( internal_topology->cpu_core_indexes != NULL )
+		{
+			memory_free(
+			 internal_topology->cpu_core_indexes );
+		}
+		if( internal_topology->cpu_identifiers != NULL )
+		{
+			memory_free(
+			 internal_topology->cpu_identifiers );
+		}
+		memory_free(
+		 internal_topology );
+	}
+	return( 1 );
+}
+
+#if defined( WINAPI )
+
+/* Reads the topology using GetLogicalProcessorInformation
+ * Only the logical processors of the processor group of the calling thread are read
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_topology_read(
+     libcthreads_internal_topology_t *internal_topology,
+     libcerror_error_t **error )
+{
+	int cpu_index_by_bit[ sizeof( ULONG_PTR ) * 8 ];
+
+	SYSTEM_LOGICAL_PROCESSOR_INFORMATION *information = NULL;
+	SYSTEM_LOGICAL_PROCESSOR_INFORMATION *entry       = NULL;
+	static char *function                             = "libcthreads_internal_topology_read";
+	ULONG_PTR processor_mask                          = 0;
+	size_t array_size                                 = 0;
+	DWORD error_code                                  = 0;
+	DWORD information_size                            = 0;
+	DWORD number_of_entries                           = 0;
+	DWORD entry_index                                 = 0;
+	int bit_index                                     = 0;
+	int cpu_index                                     = 0;
+	int group_index                                   = 0;
+	int number_of_bits                                = (int) ( sizeof( ULONG_PTR ) * 8 );
+
+	if( internal_topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	if( GetLogicalProcessorInformation(
+	     NULL,
+	     &information_size ) == FALSE )
+	{
+		error_code = GetLastError();
+
+		if( error_code != ERROR_INSUFFICIENT_BUFFER )
+		{
+			libcerror_system_set_error(
+			 error,
+			 error_code,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve logical processor information size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( information_size == 0 )
+	 || ( (size_t) information_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid logical processor information size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	information = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION *) memory_allocate(
+	                                                        (size_t) information_size );
+
+	if( information == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create logical processor information.",
+		 function );
+
+		goto on_error;
+	}
+	if( GetLogicalProcessorInformation(
+	     information,
+	     &information_size ) == FALSE )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 error_code,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve logical processor information.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_entries = information_size / sizeof( SYSTEM_LOGICAL_PROCESSOR_INFORMATION );
+
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( information[ entry_index ] );
+
+		if( entry->Relationship == RelationProcessorCore )
+		{
+			processor_mask |= entry->ProcessorMask;
+		}
+	}
+	for( bit_index = 0;
+	     bit_index < number_of_bits;
+	     bit_index++ )
+	{
+		if( ( processor_mask & ( (ULONG_PTR) 1 << bit_index ) ) != 0 )
+		{
+			cpu_index_by_bit[ bit_index ] = internal_topology->number_of_cpus++;
+		}
+		else
+		{
+			cpu_index_by_bit[ bit_index ] = -1;
+		}
+	}
+	if( internal_topology->number_of_cpus == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing logical processors.",
+		 function );
+
+		goto on_error;
+	}
+	array_size = sizeof( int ) * internal_topology->number_of_cpus;
+
+	internal_topology->cpu_identifiers = (int *) memory_allocate(
+	                                              array_size );
+
+	internal_topology->cpu_core_indexes = (int *) memory_allocate(
+	                                               array_size );
+
+	internal_topology->cpu_node_indexes = (int *) memory_allocate(
+	                                               array_size );
+
+	if( ( internal_topology->cpu_identifiers == NULL )
+	 || ( internal_topology->cpu_core_indexes == NULL )
+	 || ( internal_topology->cpu_node_indexes == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create CPU arrays.",
+		 function );
+
+		goto on_error;
+	}
+	for( bit_index = 0;
+	     bit_index < number_of_bits;
+	     bit_index++ )
+	{
+		cpu_index = cpu_index_by_bit[ bit_index ];
+
+		if( cpu_index != -1 )
+		{
+			internal_topology->cpu_identifiers[ cpu_index ]  = bit_index;
+			internal_topology->cpu_core_indexes[ cpu_index ] = 0;
+			internal_topology->cpu_node_indexes[ cpu_index ] = 0;
+		}
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( information[ entry_index ] );
+
+		switch( entry->Relationship )
+		{
+			case RelationProcessorCore:
+				group_index = internal_topology->number_of_cores++;
+
+				for( bit_index = 0;
+				     bit_index < number_of_bits;
+				     bit_index++ )
+				{
+					if( ( entry->ProcessorMask & ( (ULONG_PTR) 1 << bit_index ) ) != 0 )
+					{
+						internal_topology->cpu_core_indexes[ cpu_index_by_bit[ bit_index ] ] = group_index;
+					}
+				}
+				break;
+
+			case RelationNumaNode:
+				group_index = internal_topology->number_of_nodes++;
+
+				for( bit_index = 0;
+				     bit_index < number_of_bits;
+				     bit_index++ )
+				{
+					if( ( ( entry->ProcessorMask & ( (ULONG_PTR) 1 << bit_index ) ) != 0 )
+					 && ( cpu_index_by_bit[ bit_index ] != -1 ) )
+					{
+						internal_topology->cpu_node_indexes[ cpu_index_by_bit[ bit_index ] ] = group_index;
+					}
+				}
+				break;
+
+			case RelationCache:
+				if( ( entry->Cache.Type == CacheInstruction )
+				 || ( entry->Cache.Level < 1 )
+				 || ( entry->Cache.Level > LIBCTHREADS_TOPOLOGY_NUMBER_OF_CACHE_LEVELS ) )
+				{
+					break;
+				}
+				if( internal_topology->cache_sizes[ entry->Cache.Level - 1 ] == 0 )
+				{
+					internal_topology->cache_sizes[ entry->Cache.Level - 1 ] = (size_t) entry->Cache.Size;
+				}
+				if( ( entry->Cache.Level == 1 )
+				 && ( internal_topology->cache_line_size == 0 ) )
+				{
+					internal_topology->cache_line_size = (size_t) entry->Cache.LineSize;
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+	if( internal_topology->number_of_nodes == 0 )
+	{
+		internal_topology->number_of_nodes = 1;
+	}
+	if( internal_topology->cache_line_size == 0 )
+	{
+		internal_topology->cache_line_size = LIBCTHREADS_CACHE_LINE_SIZE;
+	}
+	memory_free(
+	 information );
+
+	return( 1 );
+
+on_error:
+	if( information != NULL )
+	{
+		memory_free(
+		 information );
+	}
+	return( -1 );
+}
+
+#elif defined( HAVE_PTHREAD_H )
+
+/* Reads the first line of a sysfs file
+ * The end-of-line character is removed
+ * Returns 1 if successful or 0 if the file is not available
+ */
+int libcthreads_internal_topology_read_file(
+     const char *path,
+     char *string,
+     size_t string_size )
+{
+	FILE *file_stream    = NULL;
+	size_t string_length = 0;
+
+	if( ( path == NULL )
+	 || ( string == NULL )
+	 || ( string_size < 2 )
+	 || ( string_size > (size_t) INT_MAX ) )
+	{
+		return( 0 );
+	}
+	file_stream = file_stream_open(
+	               path,
+	               "r" );
+
+	if( file_stream == NULL )
+	{
+		return( 0 );
+	}
+	if( file_stream_get_string(
+	     file_stream,
+	     string,
+	     (int) string_size ) == NULL )
+	{
+		file_stream_close(
+		 file_stream );
+
+		return( 0 );
+	}
+	file_stream_close(
+	 file_stream );
+
+	string_length = narrow_string_length(
+	                 string );
+
+	while( ( string_length > 0 )
+	    && ( ( string[ string_length - 1 ] == '\n' )
+	     ||  ( string[ string_length - 1 ] == '\r' ) ) )
+	{
+		string_length--;
+	}
+	string[ string_length ] = 0;
+
+	return( 1 );
+}
+
+/* Parses a sysfs list such as "0-3,8,10-11" into a bitmap
+ * Returns the number of entries in the list or -1 if the list is not valid
+ */
+int libcthreads_internal_topology_parse_list(
+     const char *string,
+     uint8_t *bitmap,
+     int bitmap_size )
+{
+	int first_value       = 0;
+	int last_value        = 0;
+	int number_of_entries = 0;
+	int value             = 0;
+
+	if( ( string == NULL )
+	 || ( bitmap == NULL )
+	 || ( bitmap_size <= 0 ) )
+	{
+		return( -1 );
+	}
+	while( *string != 0 )
+	{
+		if( ( *string < '0' )
+		 || ( *string > '9' ) )
+		{
+			return( -1 );
+		}
+		first_value = 0;
+
+		while( ( *string >= '0' )
+		    && ( *string <= '9' ) )
+		{
+			first_value = ( first_value * 10 ) + ( *string - '0' );
+
+			if( first_value >= bitmap_size )
+			{
+				return( -1 );
+			}
+			string++;
+		}
+		last_value = first_value;
+
+		if( *string == '-' )
+		{
+			string++;
+
+			if( ( *string < '0' )
+			 || ( *string > '9' ) )
+			{
+				return( -1 );
+			}
+			last_value = 0;
+
+			while( ( *string >= '0' )
+			    && ( *string <= '9' ) )
+			{
+				last_value = ( last_value * 10 ) + ( *string - '0' );
+
+				if( last_value >= bitmap_size )
+				{
+					return( -1 );
+				}
+				string++;
+			}
+			if( last_value < first_value )
+			{
+				return( -1 );
+			}
+		}
+		for( value = first_value;
+		     value <= last_value;
+		     value++ )
+		{
+			if( bitmap[ value ] == 0 )
+			{
+				bitmap[ value ] = 1;
+
+				number_of_entries++;
+			}
+		}
+		if( *string == ',' )
+		{
+			string++;
+		}
+		else if( *string != 0 )
+		{
+			return( -1 );
+		}
+	}
+	return( number_of_entries );
+}
+
+/* Parses a sysfs size such as "32K" or "8M"
+ * Returns 1 if successful or -1 if the size is not valid
+ */
+int libcthreads_internal_topology_parse_size(
+     const char *string,
+     size_t *size )
+{
+	size_t safe_size = 0;
+
+	if( ( string == NULL )
+	 || ( size == NULL ) )
+	{
+		return( -1 );
+	}
+	if( ( *string < '0' )
+	 || ( *string > '9' ) )
+	{
+		return( -1 );
+	}
+	while( ( *string >= '0' )
+	    && ( *string <= '9' ) )
+	{
+		if( safe_size > ( (size_t) SSIZE_MAX / 10 ) )
+		{
+			return( -1 );
+		}
+		safe_size = ( safe_size * 10 ) + (size_t) ( *string - '0' );
+
+		string++;
+	}
+	switch( *string )
+	{
+		case 0:
+			break;
+
+		case 'K':
+			safe_size *= 1024;
+			break;
+
+		case 'M':
+			safe_size *= 1024 * 1024;
+			break;
+
+		case 'G':
+			safe_size *= 1024 * 1024 * 1024;
+			break;
+
+		default:
+			return( -1 );
+	}
+	*size = safe_size;
+
+	return( 1 );
+}
+
+/* Reads the topology from the Linux sysfs
+ * Falls back to the number of online processors if sysfs is not available
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_topology_read(
+     libcthreads_internal_topology_t *internal_topology,
+     libcerror_error_t **error )
+{
+	char path[ 128 ];
+
+	static char *function  = "libcthreads_internal_topology_read";
+	uint8_t *cpu_bitmap    = NULL;
+	uint8_t *node_bitmap   = NULL;
+	char *string           = NULL;
+	int *core_identifiers  = NULL;
+	int *package_ids       = NULL;
+	size_t array_size      = 0;
+	size_t cache_size      = 0;
+	int cache_index        = 0;
+	int cache_level        = 0;
+	int core_identifier    = 0;
+	int core_index         = 0;
+	int cpu_identifier     = 0;
+	int cpu_index          = 0;
+	int node_identifier    = 0;
+	int number_of_cpus     = -1;
+	int package_identifier = 0;
+
+	if( internal_topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	cpu_bitmap = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS );
+
+	node_bitmap = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_NODES );
+
+	string = narrow_string_allocate(
+	          LIBCTHREADS_TOPOLOGY_STRING_SIZE );
+
+	if( ( cpu_bitmap == NULL )
+	 || ( node_bitmap == NULL )
+	 || ( string == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     cpu_bitmap,
+	     0,
+	     sizeof( uint8_t ) * LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear CPU bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_internal_topology_read_file(
+	     "/sys/devices/system/cpu/online",
+	     string,
+	     LIBCTHREADS_TOPOLOGY_STRING_SIZE ) == 1 )
+	{
+		number_of_cpus = libcthreads_internal_topology_parse_list(
+		                  string,
+		                  cpu_bitmap,
+		                  LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS );
+	}
+	if( number_of_cpus <= 0 )
+	{
+		number_of_cpus = 1;
+
+#if defined( HAVE_UNISTD_H ) && defined( _SC_NPROCESSORS_ONLN )
+		number_of_cpus = (int) sysconf(
+		                        _SC_NPROCESSORS_ONLN );
+
+		if( number_of_cpus <= 0 )
+		{
+			number_of_cpus = 1;
+		}
+		else if( number_of_cpus > LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS )
+		{
+			number_of_cpus = LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS;
+		}
+#endif
+		if( memory_set(
+		     cpu_bitmap,
+		     1,
+		     sizeof( uint8_t ) * number_of_cpus ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to set CPU bitmap.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	array_size = sizeof( int ) * number_of_cpus;
+
+	internal_topology->cpu_identifiers = (int *) memory_allocate(
+	                                              array_size );
+
+	internal_topology->cpu_core_indexes = (int *) memory_allocate(
+	                                               array_size );
+
+	internal_topology->cpu_node_indexes = (int *) memory_allocate(
+	                                               array_size );
+
+	core_identifiers = (int *) memory_allocate(
+	                            array_size );
+
+	package_ids = (int *) memory_allocate(
+	                       array_size );
+
+	if( ( internal_topology->cpu_identifiers == NULL )
+	 || ( internal_topology->cpu_core_indexes == NULL )
+	 || ( internal_topology->cpu_node_indexes == NULL )
+	 || ( core_identifiers == NULL )
+	 || ( package_ids == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create CPU arrays.",
+		 function );
+
+		goto on_error;
+	}
+	internal_topology->number_of_cpus  = number_of_cpus;
+	internal_topology->number_of_cores = 0;
+	internal_topology->number_of_nodes = 1;
+
+	for( cpu_identifier = 0;
+	     cpu_identifier < LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS;
+	     cpu_identifier++ )
+	{
+		if( cpu_bitmap[ cpu_identifier ] == 0 )
+		{
+			continue;
+		}
+		internal_topology->cpu_identifiers[ cpu_index ]  = cpu_identifier;
+		internal_topology->cpu_node_indexes[ cpu_index ] = 0;
+
+		/* Logical CPUs that share the same package and core identifier are SMT siblings
+		 */
+		package_identifier = -1;
+		core_identifier    = cpu_identifier;
+
+		narrow_string_snprintf(
+		 path,
+		 128,
+		 "/sys/devices/system/cpu/cpu%d/topology/core_id",
+		 cpu_identifier );
+
+		if( libcthreads_internal_topology_read_file(
+		     path,
+		     string,
+		     LIBCTHREADS_TOPOLOGY_STRING_SIZE ) == 1 )
+		{
+			if( narrow_string_sscanf(
+			     string,
+			     "%d",
+			     &core_identifier ) == 1 )
+			{
+				package_identifier = 0;
+			}
+			else
+			{
+				core_identifier = cpu_identifier;
+			}
+		}
+		if( package_identifier == 0 )
+		{
+			narrow_string_snprintf(
+			 path,
+			 128,
+			 "/sys/devices/system/cpu/cpu%d/topology/physical_package_id",
+			 cpu_identifier );
+
+			if( libcthreads_internal_topology_read_file(
+			     path,
+			     string,
+			     LIBCTHREADS_TOPOLOGY_STRING_SIZE ) == 1 )
+			{
+				if( narrow_string_sscanf(
+				     string,
+				     "%d",
+				     &package_identifier ) != 1 )
+				{
+					package_identifier = 0;
+				}
+			}
+		}
+		for( core_index = 0;
+		     core_index < internal_topology->number_of_cores;
+		     core_index++ )
+		{
+			if( ( package_ids[ core_index ] == package_identifier )
+			 && ( core_identifiers[ core_index ] == core_identifier ) )
+			{
+				break;
+			}
+		}
+		if( core_index == internal_topology->number_of_cores )
+		{
+			package_ids[ core_index ]      = package_identifier;
+			core_identifiers[ core_index ] = core_identifier;
+
+			internal_topology->number_of_cores++;
+		}
+		internal_topology->cpu_core_indexes[ cpu_index ] = core_index;
+
+		cpu_index++;
+
+		if( cpu_index >= number_of_cpus )
+		{
+			break;
+		}
+	}
+	/* Map the NUMA nodes in order of their identifier onto node indexes
+	 */
+	if( memory_set(
+	     node_bitmap,
+	     0,
+	     sizeof( uint8_t ) * LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_NODES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear node bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_internal_topology_read_file(
+	     "/sys/devices/system/node/online",
+	     string,
+	     LIBCTHREADS_TOPOLOGY_STRING_SIZE ) == 1 )
+	{
+		if( libcthreads_internal_topology_parse_list(
+		     string,
+		     node_bitmap,
+		     LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_NODES ) > 0 )
+		{
+			internal_topology->number_of_nodes = 0;
+
+			for( node_identifier = 0;
+			     node_identifier < LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_NODES;
+			     node_identifier++ )
+			{
+				if( node_bitmap[ node_identifier ] == 0 )
+				{
+					continue;
+				}
+				narrow_string_snprintf(
+				 path,
+				 128,
+				 "/sys/devices/system/node/node%d/cpulist",
+				 node_identifier );
+
+				if( memory_set(
+				     cpu_bitmap,
+				     0,
+				     sizeof( uint8_t ) * LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear CPU bitmap.",
+					 function );
+
+					goto on_error;
+				}
+				if( libcthreads_internal_topology_read_file(
+				     path,
+				     string,
+				     LIBCTHREADS_TOPOLOGY_STRING_SIZE ) == 1 )
+				{
+					/* A node without CPUs has an empty CPU list
+					 */
+					if( libcthreads_internal_topology_parse_list(
+					     string,
+					     cpu_bitmap,
+					     LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS ) > 0 )
+					{
+						for( cpu_index = 0;
+						     cpu_index < number_of_cpus;
+						     cpu_index++ )
+						{
+							if( cpu_bitmap[ internal_topology->cpu_identifiers[ cpu_index ] ] != 0 )
+							{
+								internal_topology->cpu_node_indexes[ cpu_index ] = internal_topology->number_of_nodes;
+							}
+						}
+					}
+				}
+				internal_topology->number_of_nodes++;
+			}
+		}
+	}
+	/* The caches are read from the first logical CPU and assumed to be the same for all
+	 */
+	for( cache_index = 0;
+	     cache_index < 32;
+	     cache_index++ )
+	{
+		narrow_string_snprintf(
+		 path,
+		 128,
+		 "/sys/devices/system/cpu/cpu%d/cache/index%d/level",
+		 internal_topology->cpu_identifiers[ 0 ],
+		 cache_index );
+
+		if( libcthreads_internal_topology_read_file(
+		     path,
+		     string,
+		     LIBCTHREADS_TOPOLOGY_STRING_SIZE ) != 1 )
+		{
+			break;
+		}
+		if( narrow_string_sscanf(
+		     string,
+		     "%d",
+		     &cache_level ) != 1 )
+		{
+			continue;
+		}
+		if( ( cache_level < 1 )
+		 || ( cache_level > LIBCTHREADS_TOPOLOGY_NUMBER_OF_CACHE_LEVELS ) )
+		{
+			continue;
+		}
+		narrow_string_snprintf(
+		 path,
+		 128,
+		 "/sys/devices/system/cpu/cpu%d/cache/index%d/type",
+		 internal_topology->cpu_identifiers[ 0 ],
+		 cache_index );
+
+		if( libcthreads_internal_topology_read_file(
+		     path,
+		     string,
+		     LIBCTHREADS_TOPOLOGY_STRING_SIZE ) != 1 )
+		{
+			continue;
+		}
+		if( narrow_string_compare(
+		     string,
+		     "Instruction",
+		     11 ) == 0 )
+		{
+			continue;
+		}
+		narrow_string_snprintf(
+		 path,
+		 128,
+		 "/sys/devices/system/cpu/cpu%d/cache/index%d/size",
+		 internal_topology->cpu_identifiers[ 0 ],
+		 cache_index );
+
+		if( libcthreads_internal_topology_read_file(
+		     path,
+		     string,
+		     LIBCTHREADS_TOPOLOGY_STRING_SIZE ) == 1 )
+		{
+			if( ( libcthreads_internal_topology_parse_size(
+			       string,
+			       &cache_size ) == 1 )
+			 && ( internal_topology->cache_sizes[ cache_level - 1 ] == 0 ) )
+			{
+				internal_topology->cache_sizes[ cache_level - 1 ] = cache_size;
+			}
+		}
+		if( ( cache_level == 1 )
+		 && ( internal_topology->cache_line_size == 0 ) )
+		{
+			narrow_string_snprintf(
+			 path,
+			 128,
+			 "/sys/devices/system/cpu/cpu%d/cache/index%d/coherency_line_size",
+			 internal_topology->cpu_identifiers[ 0 ],
+			 cache_index );
+
+			if( libcthreads_internal_topology_read_file(
+			     path,
+			     string,
+			     LIBCTHREADS_TOPOLOGY_STRING_SIZE ) == 1 )
+			{
+				if( libcthreads_internal_topology_parse_size(
+				     string,
+				     &cache_size ) == 1 )
+				{
+					internal_topology->cache_line_size = cache_size;
+				}
+			}
+		}
+	}
+	if( internal_topology->cache_line_size == 0 )
+	{
+		internal_topology->cache_line_size = LIBCTHREADS_CACHE_LINE_SIZE;
+	}
+	memory_free(
+	 package_ids );
+	memory_free(
+	 core_identifiers );
+	memory_free(
+	 string );
+	memory_free(
+	 node_bitmap );
+	memory_free(
+	 cpu_bitmap );
+
+	return( 1 );
+
+on_error:
+	if( package_ids != NULL )
+	{
+		memory_free(
+		 package_ids );
+	}
+	if( core_identifiers != NULL )
+	{
+		memory_free(
+		 core_identifiers );
+	}
+	if( string != NULL )
+	{
+		memory_free(
+		 string );
+	}
+	if( node_bitmap != NULL )
+	{
+		memory_free(
+		 node_bitmap );
+	}
+	if( cpu_bitmap != NULL )
+	{
+		memory_free(
+		 cpu_bitmap );
+	}
+	return( -1 );
+}
+
+#endif /* defined( WINAPI ) */
+
+/* Reads the shared topology
+ * Callback function for the one-time initialization
+ */
+void libcthreads_internal_topology_initialize_cached(
+      void )
+{
+	libcthreads_topology_t *topology = NULL;
+
+	if( libcthreads_topology_initialize(
+	     &topology,
+	     NULL ) == 1 )
+	{
+		libcthreads_topology_cached = topology;
+	}
+}
+
+/* Retrieves the shared topology
+ * The topology is read once on the first call and must not be freed
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_topology_get(
+     libcthreads_topology_t **topology,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_topology_get";
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result    = 0;
+#endif
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	/* The state is 0 when not read, 1 while being read and 2 when read
+	 */
+	if( InterlockedCompareExchange(
+	     &libcthreads_topology_cached_state,
+	     1,
+	     0 ) == 0 )
+	{
+		libcthreads_internal_topology_initialize_cached();
+
+		InterlockedExchange(
+		 &libcthreads_topology_cached_state,
+		 2 );
+	}
+	else
+	{
+		while( InterlockedCompareExchange(
+		        &libcthreads_topology_cached_state,
+		        2,
+		        2 ) != 2 )
+		{
+			Sleep(
+			 0 );
+		}
+	}
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_once(
+	                  &libcthreads_topology_cached_once,
+	                  &libcthreads_internal_topology_initialize_cached );
+
+	if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize topology.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcthreads_topology_cached == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read topology.",
+		 function );
+
+		return( -1 );
+	}
+	*topology = libcthreads_topology_cached;
+
+	return( 1 );
+}
+
+/* Retrieves the number of logical CPUs
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_topology_get_number_of_cpus(
+     libcthreads_topology_t *topology,
+     int *number_of_cpus,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_topology_t *internal_topology = NULL;
+	static char *function                              = "libcthreads_topology_get_number_of_cpus";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	internal_topology = (libcthreads_internal_topology_t *) topology;
+
+	if( number_of_cpus == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of CPUs.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_cpus = internal_topology->number_of_cpus;
+
+	return( 1 );
+}
+
+/* Retrieves the number of physical cores
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_topology_get_number_of_cores(
+     libcthreads_topology_t *topology,
+     int *number_of_cores,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_topology_t *internal_topology = NULL;
+	static char *function                              = "libcthreads_topology_get_number_of_cores";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	internal_topology = (libcthreads_internal_topology_t *) topology;
+
+	if( number_of_cores == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of cores.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_cores = internal_topology->number_of_cores;
+
+	return( 1 );
+}
+
+/* Retrieves the number of NUMA nodes
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_topology_get_number_of_nodes(
+     libcthreads_topology_t *topology,
+     int *number_of_nodes,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_topology_t *internal_topology = NULL;
+	static char *function                              = "libcthreads_topology_get_number_of_nodes";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	internal_topology = (libcthreads_internal_topology_t *) topology;
+
+	if( number_of_nodes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of nodes.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_nodes = internal_topology->number_of_nodes;
+
+	return( 1 );
+}
+
+/* Retrieves the operating system identifier of a specific logical CPU
+ * The identifier is the CPU number used for CPU affinity
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_topology_get_cpu_identifier(
+     libcthreads_topology_t *topology,
+     int cpu_index,
+     int *cpu_identifier,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_topology_t *internal_topology = NULL;
+	static char *function                              = "libcthreads_topology_get_cpu_identifier";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	internal_topology = (libcthreads_internal_topology_t *) topology;
+
+	if( ( cpu_index < 0 )
+	 || ( cpu_index >= internal_topology->number_of_cpus ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid CPU index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( cpu_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid CPU identifier.",
+		 function );
+
+		return( -1 );
+	}
+	*cpu_identifier = internal_topology->cpu_identifiers[ cpu_index ];
+
+	return( 1 );
+}
+
+/* Retrieves the physical core index of a specific logical CPU
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_topology_get_cpu_core_index(
+     libcthreads_topology_t *topology,
+     int cpu_index,
+     int *core_index,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_topology_t *internal_topology = NULL;
+	static char *function                              = "libcthreads_topology_get_cpu_core_index";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	internal_topology = (libcthreads_internal_topology_t *) topology;
+
+	if( ( cpu_index < 0 )
+	 || ( cpu_index >= internal_topology->number_of_cpus ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid CPU index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( core_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid core index.",
+		 function );
+
+		return( -1 );
+	}
+	*core_index = internal_topology->cpu_core_indexes[ cpu_index ];
+
+	return( 1 );
+}
+
+/* Retrieves the NUMA node index of a specific logical CPU
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_topology_get_cpu_node_index(
+     libcthreads_topology_t *topology,
+     int cpu_index,
+     int *node_index,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_topology_t *internal_topology = NULL;
+	static char *function                              = "libcthreads_topology_get_cpu_node_index";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	internal_topology = (libcthreads_internal_topology_t *) topology;
+
+	if( ( cpu_index < 0 )
+	 || ( cpu_index >= internal_topology->number_of_cpus ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid CPU index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node index.",
+		 function );
+
+		return( -1 );
+	}
+	*node_index = internal_topology->cpu_node_indexes[ cpu_index ];
+
+	return( 1 );
+}
+
+/* Retrieves the indexes of the logical CPUs that belong to a specific group
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_topology_get_cpus(
+     libcthreads_internal_topology_t *internal_topology,
+     const int *cpu_group_indexes,
+     int group_index,
+     int *cpu_indexes,
+     int maximum_number_of_cpu_indexes,
+     int *number_of_cpu_indexes,
+     libcerror_error_t **error )
+{
+	static char *function     = "libcthreads_internal_topology_get_cpus";
+	int cpu_index             = 0;
+	int safe_number_of_values = 0;
+
+	if( internal_topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	if( cpu_group_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid CPU group indexes.",
+		 function );
+
+		return( -1 );
+	}
+	if( cpu_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid CPU indexes.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_cpu_indexes <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of CPU indexes value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cpu_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of CPU indexes.",
+		 function );
+
+		return( -1 );
+	}
+	for( cpu_index = 0;
+	     cpu_index < internal_topology->number_of_cpus;
+	     cpu_index++ )
+	{
+		if( cpu_group_indexes[ cpu_index ] != group_index )
+		{
+			continue;
+		}
+		if( safe_number_of_values >= maximum_number_of_cpu_indexes )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: invalid maximum number of CPU indexes value too small.",
+			 function );
+
+			return( -1 );
+		}
+		cpu_indexes[ safe_number_of_values++ ] = cpu_index;
+	}
+	*number_of_cpu_indexes = safe_number_of_values;
+
+	return( 1 );
+}
+
+/* Retrieves the indexes of the logical CPUs of a specific physical core
+ * These are the SMT siblings that share the core
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_topology_get_core_cpus(
+     libcthreads_topology_t *topology,
+     int core_index,
+     int *cpu_indexes,
+     int maximum_number_of_cpu_indexes,
+     int *number_of_cpu_indexes,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_topology_t *internal_topology = NULL;
+	static char *function                              = "libcthreads_topology_get_core_cpus";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	internal_topology = (libcthreads_internal_topology_t *) topology;
+
+	if( ( core_index < 0 )
+	 || ( core_index >= internal_topology->number_of_cores ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid core index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_topology_get_cpus(
+	     internal_topology,
+	     internal_topology->cpu_core_indexes,
+	     core_index,
+	     cpu_indexes,
+	     maximum_number_of_cpu_indexes,
+	     number_of_cpu_indexes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve CPUs of core: %d.",
+		 function,
+		 core_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the indexes of the logical CPUs of a specific NUMA node
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_topology_get_node_cpus(
+     libcthreads_topology_t *topology,
+     int node_index,
+     int *cpu_indexes,
+     int maximum_number_of_cpu_indexes,
+     int *number_of_cpu_indexes,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_topology_t *internal_topology = NULL;
+	static char *function                              = "libcthreads_topology_get_node_cpus";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	internal_topology = (libcthreads_internal_topology_t *) topology;
+
+	if( ( node_index < 0 )
+	 || ( node_index >= internal_topology->number_of_nodes ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid node index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_internal_topology_get_cpus(
+	     internal_topology,
+	     internal_topology->cpu_node_indexes,
+	     node_index,
+	     cpu_indexes,
+	     maximum_number_of_cpu_indexes,
+	     number_of_cpu_indexes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve CPUs of node: %d.",
+		 function,
+		 node_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of a specific cache level
+ * Level 1 refers to the level 1 data cache
+ * Returns 1 if successful, 0 if the cache size is not available or -1 on error
+ */
+int libcthreads_topology_get_cache_size(
+     libcthreads_topology_t *topology,
+     int cache_level,
+     size_t *cache_size,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_topology_t *internal_topology = NULL;
+	static char *function                              = "libcthreads_topology_get_cache_size";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	internal_topology = (libcthreads_internal_topology_t *) topology;
+
+	if( ( cache_level < 1 )
+	 || ( cache_level > LIBCTHREADS_TOPOLOGY_NUMBER_OF_CACHE_LEVELS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid cache level value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_topology->cache_sizes[ cache_level - 1 ] == 0 )
+	{
+		return( 0 );
+	}
+	*cache_size = internal_topology->cache_sizes[ cache_level - 1 ];
+
+	return( 1 );
+}
+
+/* Retrieves the cache line size
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_topology_get_cache_line_size(
+     libcthreads_topology_t *topology,
+     size_t *cache_line_size,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_topology_t *internal_topology = NULL;
+	static char *function                              = "libcthreads_topology_get_cache_line_size";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	internal_topology = (libcthreads_internal_topology_t *) topology;
+
+	if( cache_line_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache line size.",
+		 function );
+
+		return( -1 );
+	}
+	*cache_line_size = internal_topology->cache_line_size;
+
+	return( 1 );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
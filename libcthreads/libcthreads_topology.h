@@ -0,0 +1,212 @@
+/*
+ * Hardware topology functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_INTERNAL_TOPOLOGY_H )
+#define _LIBCTHREADS_INTERNAL_TOPOLOGY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The maximum number of logical CPUs supported by the topology
+ */
+#define LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS	4096
+
+/* The maximum number of NUMA nodes supported by the topology
+ */
+#define LIBCTHREADS_TOPOLOGY_MAXIMUM_NUMBER_OF_NODES	1024
+
+/* The number of cache levels, L1 data, L2 and L3
+ */
+#define LIBCTHREADS_TOPOLOGY_NUMBER_OF_CACHE_LEVELS	3
+
+typedef struct libcthreads_internal_topology libcthreads_internal_topology_t;
+
+struct libcthreads_internal_topology
+{
+	/* The number of logical CPUs
+	 */
+	int number_of_cpus;
+
+	/* The number of physical cores
+	 */
+	int number_of_cores;
+
+	/* The number of NUMA nodes
+	 */
+	int number_of_nodes;
+
+	/* The operating system identifier of each logical CPU
+	 */
+	int *cpu_identifiers;
+
+	/* The physical core index of each logical CPU
+	 */
+	int *cpu_core_indexes;
+
+	/* The NUMA node index of each logical CPU
+	 */
+	int *cpu_node_indexes;
+
+	/* The cache sizes per level
+	 */
+	size_t cache_sizes[ LIBCTHREADS_TOPOLOGY_NUMBER_OF_CACHE_LEVELS ];
+
+	/* The cache line size
+	 */
+	size_t cache_line_size;
+};
+
+int libcthreads_internal_topology_read(
+     libcthreads_internal_topology_t *internal_topology,
+     libcerror_error_t **error );
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+int libcthreads_internal_topology_read_file(
+     const char *path,
+     char *string,
+     size_t string_size );
+
+int libcthreads_internal_topology_parse_list(
+     const char *string,
+     uint8_t *bitmap,
+     int bitmap_size );
+
+int libcthreads_internal_topology_parse_size(
+     const char *string,
+     size_t *size );
+
+#endif /* defined( HAVE_PTHREAD_H ) && !defined( WINAPI ) */
+
+void libcthreads_internal_topology_initialize_cached(
+      void );
+
+int libcthreads_internal_topology_get_cpus(
+     libcthreads_internal_topology_t *internal_topology,
+     const int *cpu_group_indexes,
+     int group_index,
+     int *cpu_indexes,
+     int maximum_number_of_cpu_indexes,
+     int *number_of_cpu_indexes,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_topology_initialize(
+     libcthreads_topology_t **topology,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_topology_free(
+     libcthreads_topology_t **topology,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_topology_get(
+     libcthreads_topology_t **topology,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_topology_get_number_of_cpus(
+     libcthreads_topology_t *topology,
+     int *number_of_cpus,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_topology_get_number_of_cores(
+     libcthreads_topology_t *topology,
+     int *number_of_cores,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_topology_get_number_of_nodes(
+     libcthreads_topology_t *topology,
+     int *number_of_nodes,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_topology_get_cpu_identifier(
+     libcthreads_topology_t *topology,
+     int cpu_index,
+     int *cpu_identifier,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_topology_get_cpu_core_index(
+     libcthreads_topology_t *topology,
+     int cpu_index,
+     int *core_index,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_topology_get_cpu_node_index(
+     libcthreads_topology_t *topology,
+     int cpu_index,
+     int *node_index,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_topology_get_core_cpus(
+     libcthreads_topology_t *topology,
+     int core_index,
+     int *cpu_indexes,
+     int maximum_number_of_cpu_indexes,
+     int *number_of_cpu_indexes,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_topology_get_node_cpus(
+     libcthreads_topology_t *topology,
+     int node_index,
+     int *cpu_indexes,
+     int maximum_number_of_cpu_indexes,
+     int *number_of_cpu_indexes,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_topology_get_cache_size(
+     libcthreads_topology_t *topology,
+     int cache_level,
+     size_t *cache_size,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_topology_get_cache_line_size(
+     libcthreads_topology_t *topology,
+     size_t *cache_line_size,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_INTERNAL_TOPOLOGY_H ) */
+
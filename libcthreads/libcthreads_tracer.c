@@ -0,0 +1,897 @@
+/*
+ * Event tracer functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H ) && !defined( WINAPI )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#endif
+
+#if defined( _MSC_VER ) && ( defined( _M_IX86 ) || defined( _M_X64 ) )
+#include <intrin.h>
+
+#define LIBCTHREADS_TRACER_HAVE_TIME_STAMP_COUNTER
+
+#elif defined( __GNUC__ ) && ( defined( __i386__ ) || defined( __x86_64__ ) )
+#include <x86intrin.h>
+
+#define LIBCTHREADS_TRACER_HAVE_TIME_STAMP_COUNTER
+
+#endif
+
+#include "libcthreads_atomic.h"
+#include "libcthreads_clock.h"
+#include "libcthreads_definitions.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_thread_local.h"
+#include "libcthreads_tracer.h"
+#include "libcthreads_unused.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Value to indicate events should be recorded
+ */
+static volatile uint32_t libcthreads_tracer_enabled              = 0;
+
+/* The per-thread event buffers
+ */
+static libcthreads_tracer_buffer_t *libcthreads_tracer_buffers   = NULL;
+
+/* The number of threads that have recorded events
+ */
+static int libcthreads_tracer_number_of_threads                  = 0;
+
+/* The timestamp and monotonic time the tracer was first enabled, used to convert
+ * timestamps to microseconds
+ */
+static uint64_t libcthreads_tracer_start_timestamp               = 0;
+
+static uint64_t libcthreads_tracer_start_time                    = 0;
+
+/* The thread local storage of the per-thread event buffers
+ */
+static libcthreads_thread_local_t *libcthreads_tracer_buffer_storage = NULL;
+
+#if defined( WINAPI )
+static CRITICAL_SECTION libcthreads_tracer_critical_section;
+
+static LONG libcthreads_tracer_critical_section_state            = 0;
+
+static LONG libcthreads_tracer_buffer_storage_state              = 0;
+
+#elif defined( HAVE_PTHREAD_H )
+static pthread_mutex_t libcthreads_tracer_mutex                  = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_once_t libcthreads_tracer_buffer_storage_once     = PTHREAD_ONCE_INIT;
+
+#endif
+
+/* The enabled value is read for every event, the events are published by the write index
+ */
+#if defined( LIBCTHREADS_ATOMIC_HAVE_BUILTINS )
+#define libcthreads_tracer_get_enabled() \
+	(uint32_t) libcthreads_internal_atomic_load_32( &libcthreads_tracer_enabled, LIBCTHREADS_MEMORY_ORDER_ACQUIRE )
+
+#define libcthreads_tracer_set_enabled( value ) \
+	libcthreads_internal_atomic_store_32( &libcthreads_tracer_enabled, value, LIBCTHREADS_MEMORY_ORDER_RELEASE )
+
+#else
+#define libcthreads_tracer_get_enabled() \
+	libcthreads_atomic_load_32( &libcthreads_tracer_enabled, LIBCTHREADS_MEMORY_ORDER_ACQUIRE )
+
+#define libcthreads_tracer_set_enabled( value ) \
+	libcthreads_atomic_store_32( &libcthreads_tracer_enabled, value, LIBCTHREADS_MEMORY_ORDER_RELEASE )
+
+#endif
+
+/* Retrieves the current timestamp
+ * The timestamp is the time stamp counter where available, otherwise the
+ * monotonic time in nanoseconds. Note that the time stamp counter is
+ * only comparable between CPUs if it is invariant
+ * Returns the timestamp
+ */
+uint64_t libcthreads_tracer_get_timestamp(
+          void )
+{
+#if defined( LIBCTHREADS_TRACER_HAVE_TIME_STAMP_COUNTER )
+	return( (uint64_t) __rdtsc() );
+#else
+	uint64_t monotonic_time = 0;
+
+	libcthreads_clock_get_monotonic_time(
+	 &monotonic_time,
+	 NULL );
+
+	return( monotonic_time );
+#endif
+}
+
+/* Creates the thread local storage of the per-thread buffers
+ */
+void libcthreads_internal_tracer_initialize_buffer_storage(
+      void )
+{
+	libcthreads_thread_local_initialize(
+	 &libcthreads_tracer_buffer_storage,
+	 &libcthreads_internal_tracer_buffer_exit,
+	 NULL );
+}
+
+/* Enters the tracer
+ */
+void libcthreads_internal_tracer_enter(
+      void )
+{
+#if defined( WINAPI )
+	/* The state is 0 when not initialized, 1 while being initialized and 2 when initialized
+	 */
+	if( InterlockedCompareExchange(
+	     &libcthreads_tracer_critical_section_state,
+	     1,
+	     0 ) == 0 )
+	{
+		InitializeCriticalSection(
+		 &libcthreads_tracer_critical_section );
+
+		InterlockedExchange(
+		 &libcthreads_tracer_critical_section_state,
+		 2 );
+	}
+	else
+	{
+		while( InterlockedCompareExchange(
+		        &libcthreads_tracer_critical_section_state,
+		        2,
+		        2 ) != 2 )
+		{
+			Sleep(
+			 0 );
+		}
+	}
+	EnterCriticalSection(
+	 &libcthreads_tracer_critical_section );
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_mutex_lock(
+	 &libcthreads_tracer_mutex );
+#endif
+}
+
+/* Leaves the tracer
+ */
+void libcthreads_internal_tracer_leave(
+      void )
+{
+#if defined( WINAPI )
+	LeaveCriticalSection(
+	 &libcthreads_tracer_critical_section );
+
+#elif defined( HAVE_PTHREAD_H )
+	pthread_mutex_unlock(
+	 &libcthreads_tracer_mutex );
+#endif
+}
+
+/* Marks the buffer of an exiting thread
+ * The buffer is retained so that its events can still be exported, it is freed by libcthreads_tracer_clear
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_internal_tracer_buffer_exit(
+     intptr_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_tracer_buffer_exit";
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer == NULL )
+	{
+		return( 1 );
+	}
+	libcthreads_internal_tracer_enter();
+
+	( (libcthreads_tracer_buffer_t *) *buffer )->thread_has_exited = 1;
+
+	libcthreads_internal_tracer_leave();
+
+	*buffer = NULL;
+
+	return( 1 );
+}
+
+#if defined( WINAPI ) && ( WINVER < 0x0600 )
+
+/* Determines if the thread that owns the buffer has exited
+ * Before Vista the thread local storage has no callback when a thread exits
+ * Returns 1 if the thread has exited or 0 if not
+ */
+int libcthreads_internal_tracer_buffer_thread_has_exited(
+     libcthreads_tracer_buffer_t *buffer )
+{
+	HANDLE thread_handle = NULL;
+	DWORD exit_code      = 0;
+	int result           = 1;
+
+	thread_handle = OpenThread(
+	                 THREAD_QUERY_INFORMATION,
+	                 FALSE,
+	                 buffer->thread_identifier );
+
+	if( thread_handle != NULL )
+	{
+		if( ( GetExitCodeThread(
+		       thread_handle,
+		       &exit_code ) != 0 )
+		 && ( exit_code == STILL_ACTIVE ) )
+		{
+			result = 0;
+		}
+		CloseHandle(
+		 thread_handle );
+	}
+	return( result );
+}
+
+#endif /* defined( WINAPI ) && ( WINVER < 0x0600 ) */
+
+/* Retrieves the buffer of the calling thread
+ * The buffer is created on first use
+ * Returns the buffer or NULL if not available
+ */
+libcthreads_tracer_buffer_t *libcthreads_internal_tracer_get_buffer(
+                              void )
+{
+	libcthreads_tracer_buffer_t *buffer = NULL;
+
+	if( libcthreads_tracer_buffer_storage == NULL )
+	{
+		return( NULL );
+	}
+	if( libcthreads_thread_local_get_value(
+	     libcthreads_tracer_buffer_storage,
+	     (intptr_t **) &buffer,
+	     NULL ) == 1 )
+	{
+		return( buffer );
+	}
+	buffer = memory_allocate_structure(
+	          libcthreads_tracer_buffer_t );
+
+	if( buffer == NULL )
+	{
+		return( NULL );
+	}
+	if( memory_set(
+	     buffer,
+	     0,
+	     sizeof( libcthreads_tracer_buffer_t ) ) == NULL )
+	{
+		memory_free(
+		 buffer );
+
+		return( NULL );
+	}
+#if defined( WINAPI ) && ( WINVER < 0x0600 )
+	buffer->thread_identifier = GetCurrentThreadId();
+#endif
+
+	if( libcthreads_thread_local_set_value(
+	     libcthreads_tracer_buffer_storage,
+	     (intptr_t *) buffer,
+	     NULL ) != 1 )
+	{
+		memory_free(
+		 buffer );
+
+		return( NULL );
+	}
+	libcthreads_internal_tracer_enter();
+
+	libcthreads_tracer_number_of_threads += 1;
+
+	buffer->thread_index = libcthreads_tracer_number_of_threads;
+	buffer->next_buffer  = libcthreads_tracer_buffers;
+
+	libcthreads_tracer_buffers = buffer;
+
+	libcthreads_internal_tracer_leave();
+
+	return( buffer );
+}
+
+/* Records an event in the buffer of the calling thread
+ * This function does nothing if the tracer is not enabled and
+ * otherwise does not block, if the buffer is full the oldest event is overwritten
+ */
+void libcthreads_tracer_record_event(
+      uint8_t event_type,
+      const void *object )
+{
+	libcthreads_tracer_buffer_t *buffer = NULL;
+	libcthreads_tracer_event_t *event   = NULL;
+	uint32_t write_index                = 0;
+
+	if( libcthreads_tracer_get_enabled() == 0 )
+	{
+		return;
+	}
+	buffer = libcthreads_internal_tracer_get_buffer();
+
+	if( buffer == NULL )
+	{
+		return;
+	}
+	write_index = buffer->write_index;
+
+	event = &( buffer->events[ write_index & ( LIBCTHREADS_TRACER_BUFFER_SIZE - 1 ) ] );
+
+	event->timestamp  = libcthreads_tracer_get_timestamp();
+	event->object     = object;
+	event->event_type = event_type;
+
+	/* Make sure the event is stored before it is published by the write index
+	 */
+#if defined( WINAPI )
+	MemoryBarrier();
+#elif defined( __GNUC__ )
+	__sync_synchronize();
+#endif
+	buffer->write_index = write_index + 1;
+}
+
+/* Enables recording of events
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_tracer_enable(
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_tracer_enable";
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	int pthread_result    = 0;
+#endif
+
+#if defined( WINAPI )
+	/* The state is 0 when not created, 1 while being created and 2 when created
+	 */
+	if( InterlockedCompareExchange(
+	     &libcthreads_tracer_buffer_storage_state,
+	     1,
+	     0 ) == 0 )
+	{
+		libcthreads_internal_tracer_initialize_buffer_storage();
+
+		InterlockedExchange(
+		 &libcthreads_tracer_buffer_storage_state,
+		 2 );
+	}
+	else
+	{
+		while( InterlockedCompareExchange(
+		        &libcthreads_tracer_buffer_storage_state,
+		        2,
+		        2 ) != 2 )
+		{
+			Sleep(
+			 0 );
+		}
+	}
+#elif defined( HAVE_PTHREAD_H )
+	pthread_result = pthread_once(
+	                  &libcthreads_tracer_buffer_storage_once,
+	                  &libcthreads_internal_tracer_initialize_buffer_storage );
+
+	if( pthread_result != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 pthread_result,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create buffer storage.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcthreads_tracer_buffer_storage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create buffer storage.",
+		 function );
+
+		return( -1 );
+	}
+	libcthreads_internal_tracer_enter();
+
+	if( libcthreads_tracer_start_time == 0 )
+	{
+		if( libcthreads_clock_get_monotonic_time(
+		     &libcthreads_tracer_start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve monotonic time.",
+			 function );
+
+			libcthreads_internal_tracer_leave();
+
+			return( -1 );
+		}
+		libcthreads_tracer_start_timestamp = libcthreads_tracer_get_timestamp();
+	}
+	libcthreads_tracer_set_enabled(
+	 1 );
+
+	libcthreads_internal_tracer_leave();
+
+	return( 1 );
+}
+
+/* Disables recording of events
+ * The recorded events are retained
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_tracer_disable(
+     libcerror_error_t **error LIBCTHREADS_ATTRIBUTE_UNUSED )
+{
+	LIBCTHREADS_UNREFERENCED_PARAMETER( error )
+
+	libcthreads_tracer_set_enabled(
+	 0 );
+
+	return( 1 );
+}
+
+/* Determines if recording of events is enabled
+ * Returns 1 if enabled, 0 if not or -1 on error
+ */
+int libcthreads_tracer_is_enabled(
+     libcerror_error_t **error LIBCTHREADS_ATTRIBUTE_UNUSED )
+{
+	LIBCTHREADS_UNREFERENCED_PARAMETER( error )
+
+	if( libcthreads_tracer_get_enabled() != 0 )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Clears the recorded events
+ * The buffers of threads that have exited are freed
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_tracer_clear(
+     libcerror_error_t **error LIBCTHREADS_ATTRIBUTE_UNUSED )
+{
+	libcthreads_tracer_buffer_t *buffer          = NULL;
+	libcthreads_tracer_buffer_t *previous_buffer = NULL;
+
+	LIBCTHREADS_UNREFERENCED_PARAMETER( error )
+
+	libcthreads_internal_tracer_enter();
+
+	buffer = libcthreads_tracer_buffers;
+
+	while( buffer != NULL )
+	{
+#if defined( WINAPI ) && ( WINVER < 0x0600 )
+		if( buffer->thread_has_exited == 0 )
+		{
+			buffer->thread_has_exited = (uint8_t) libcthreads_internal_tracer_buffer_thread_has_exited(
+			                                       buffer );
+		}
+#endif
+		if( buffer->thread_has_exited != 0 )
+		{
+			if( previous_buffer == NULL )
+			{
+				libcthreads_tracer_buffers = buffer->next_buffer;
+			}
+			else
+			{
+				previous_buffer->next_buffer = buffer->next_buffer;
+			}
+			memory_free(
+			 buffer );
+
+			if( previous_buffer == NULL )
+			{
+				buffer = libcthreads_tracer_buffers;
+			}
+			else
+			{
+				buffer = previous_buffer->next_buffer;
+			}
+		}
+		else
+		{
+			buffer->read_index = buffer->write_index;
+
+			previous_buffer = buffer;
+			buffer          = buffer->next_buffer;
+		}
+	}
+	libcthreads_internal_tracer_leave();
+
+	return( 1 );
+}
+
+/* Retrieves the number of recorded events that are available
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_tracer_get_number_of_events(
+     int *number_of_events,
+     libcerror_error_t **error )
+{
+	libcthreads_tracer_buffer_t *buffer = NULL;
+	static char *function               = "libcthreads_tracer_get_number_of_events";
+	uint32_t number_of_buffer_events    = 0;
+	int safe_number_of_events           = 0;
+
+	if( number_of_events == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of events.",
+		 function );
+
+		return( -1 );
+	}
+	libcthreads_internal_tracer_enter();
+
+	for( buffer = libcthreads_tracer_buffers;
+	     buffer != NULL;
+	     buffer = buffer->next_buffer )
+	{
+		number_of_buffer_events = buffer->write_index - buffer->read_index;
+
+		if( number_of_buffer_events > LIBCTHREADS_TRACER_BUFFER_SIZE )
+		{
+			number_of_buffer_events = LIBCTHREADS_TRACER_BUFFER_SIZE;
+		}
+		safe_number_of_events += (int) number_of_buffer_events;
+	}
+	libcthreads_internal_tracer_leave();
+
+	*number_of_events = safe_number_of_events;
+
+	return( 1 );
+}
+
+/* Writes the recorded events to a file in the Chrome trace event format
+ * The file can be loaded in chrome://tracing or Perfetto
+ * Events are exported without stopping the threads that record them,
+ * events that are overwritten during the export are left out
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_tracer_write_chrome_trace(
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libcthreads_tracer_buffer_t *buffer = NULL;
+	libcthreads_tracer_event_t *event   = NULL;
+	libcthreads_tracer_event_t *events  = NULL;
+	FILE *file_stream                   = NULL;
+	const char *event_name              = NULL;
+	const char *event_phase             = NULL;
+	static char *function               = "libcthreads_tracer_write_chrome_trace";
+	double ticks_per_microsecond        = 1000.0;
+	double timestamp                    = 0.0;
+	uint64_t current_time               = 0;
+	uint64_t current_timestamp          = 0;
+	uint32_t end_index                  = 0;
+	uint32_t event_index                = 0;
+	uint32_t start_index                = 0;
+	int is_first_event                  = 1;
+	int print_count                     = 0;
+	int process_identifier              = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBCTHREADS_TRACER_HAVE_TIME_STAMP_COUNTER )
+	/* Calibrate the time stamp counter against the monotonic clock
+	 * over at least 1 millisecond since the tracer was first enabled
+	 */
+	if( libcthreads_tracer_start_time != 0 )
+	{
+		do
+		{
+			if( libcthreads_clock_get_monotonic_time(
+			     &current_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve monotonic time.",
+				 function );
+
+				goto on_error;
+			}
+			current_timestamp = libcthreads_tracer_get_timestamp();
+		}
+		while( ( current_time - libcthreads_tracer_start_time ) < 1000000 );
+
+		ticks_per_microsecond = (double) ( current_timestamp - libcthreads_tracer_start_timestamp )
+		                      / ( (double) ( current_time - libcthreads_tracer_start_time ) / 1000.0 );
+
+		if( ticks_per_microsecond <= 0.0 )
+		{
+			ticks_per_microsecond = 1000.0;
+		}
+	}
+#endif
+#if defined( WINAPI )
+	process_identifier = (int) GetCurrentProcessId();
+
+#elif defined( HAVE_UNISTD_H )
+	process_identifier = (int) getpid();
+#endif
+	events = (libcthreads_tracer_event_t *) memory_allocate(
+	                                         sizeof( libcthreads_tracer_event_t ) * LIBCTHREADS_TRACER_BUFFER_SIZE );
+
+	if( events == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create events.",
+		 function );
+
+		goto on_error;
+	}
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_OPEN_WRITE );
+
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( fprintf(
+	     file_stream,
+	     "{\"traceEvents\":[\n" ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write header.",
+		 function );
+
+		goto on_error;
+	}
+	libcthreads_internal_tracer_enter();
+
+	for( buffer = libcthreads_tracer_buffers;
+	     buffer != NULL;
+	     buffer = buffer->next_buffer )
+	{
+		/* Copy the events that have been published
+		 */
+		end_index = buffer->write_index;
+
+#if defined( WINAPI )
+		MemoryBarrier();
+#elif defined( __GNUC__ )
+		__sync_synchronize();
+#endif
+		start_index = buffer->read_index;
+
+		if( ( end_index - start_index ) > LIBCTHREADS_TRACER_BUFFER_SIZE )
+		{
+			start_index = end_index - LIBCTHREADS_TRACER_BUFFER_SIZE;
+		}
+		for( event_index = start_index;
+		     event_index != end_index;
+		     event_index++ )
+		{
+			events[ event_index & ( LIBCTHREADS_TRACER_BUFFER_SIZE - 1 ) ] = buffer->events[ event_index & ( LIBCTHREADS_TRACER_BUFFER_SIZE - 1 ) ];
+		}
+		/* Leave out the events that were overwritten while being copied
+		 */
+#if defined( WINAPI )
+		MemoryBarrier();
+#elif defined( __GNUC__ )
+		__sync_synchronize();
+#endif
+		if( ( buffer->write_index - start_index ) > LIBCTHREADS_TRACER_BUFFER_SIZE )
+		{
+			start_index = buffer->write_index - LIBCTHREADS_TRACER_BUFFER_SIZE;
+
+			if( ( end_index - start_index ) > LIBCTHREADS_TRACER_BUFFER_SIZE )
+			{
+				start_index = end_index;
+			}
+		}
+		print_count = fprintf(
+		               file_stream,
+		               "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+		               ( is_first_event != 0 ) ? "" : ",\n",
+		               process_identifier,
+		               buffer->thread_index,
+		               buffer->thread_index );
+
+		is_first_event = 0;
+
+		for( event_index = start_index;
+		     ( print_count >= 0 ) && ( event_index != end_index );
+		     event_index++ )
+		{
+			event = &( events[ event_index & ( LIBCTHREADS_TRACER_BUFFER_SIZE - 1 ) ] );
+
+			switch( event->event_type )
+			{
+				case LIBCTHREADS_TRACER_EVENT_ENQUEUE:
+					event_name  = "enqueue";
+					event_phase = "i";
+					break;
+
+				case LIBCTHREADS_TRACER_EVENT_DEQUEUE:
+					event_name  = "dequeue";
+					event_phase = "i";
+					break;
+
+				case LIBCTHREADS_TRACER_EVENT_START:
+					event_name  = "task";
+					event_phase = "B";
+					break;
+
+				case LIBCTHREADS_TRACER_EVENT_END:
+					event_name  = "task";
+					event_phase = "E";
+					break;
+
+				case LIBCTHREADS_TRACER_EVENT_BLOCK:
+					event_name  = "blocked";
+					event_phase = "B";
+					break;
+
+				case LIBCTHREADS_TRACER_EVENT_WAKE:
+					event_name  = "blocked";
+					event_phase = "E";
+					break;
+
+				default:
+					continue;
+			}
+			timestamp = (double) (int64_t) ( event->timestamp - libcthreads_tracer_start_timestamp ) / ticks_per_microsecond;
+
+			print_count = fprintf(
+			               file_stream,
+			               ",\n{\"name\":\"%s\",\"cat\":\"libcthreads\",\"ph\":\"%s\",%s\"ts\":%.3f,\"pid\":%d,\"tid\":%d,\"args\":{\"object\":\"%p\"}}",
+			               event_name,
+			               event_phase,
+			               ( event_phase[ 0 ] == 'i' ) ? "\"s\":\"t\"," : "",
+			               timestamp,
+			               process_identifier,
+			               buffer->thread_index,
+			               event->object );
+		}
+		if( print_count < 0 )
+		{
+			libcthreads_internal_tracer_leave();
+
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write events.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	libcthreads_internal_tracer_leave();
+
+	if( fprintf(
+	     file_stream,
+	     "\n]}\n" ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write footer.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		file_stream = NULL;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 events );
+
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( events != NULL )
+	{
+		memory_free(
+		 events );
+	}
+	return( -1 );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,183 @@
+/*
+ * Event tracer functions
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_TRACER_H )
+#define _LIBCTHREADS_TRACER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_extern.h"
+#include "libcthreads_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The number of events in a per-thread ring buffer, must be a power of 2
+ */
+#define LIBCTHREADS_TRACER_BUFFER_SIZE		8192
+
+/* The tracer event types
+ */
+enum LIBCTHREADS_TRACER_EVENT_TYPES
+{
+	/* A value was pushed onto a queue or thread pool
+	 */
+	LIBCTHREADS_TRACER_EVENT_ENQUEUE	= 1,
+
+	/* A value was popped off a queue or thread pool
+	 */
+	LIBCTHREADS_TRACER_EVENT_DEQUEUE	= 2,
+
+	/* A thread pool worker started running a callback
+	 */
+	LIBCTHREADS_TRACER_EVENT_START		= 3,
+
+	/* A thread pool worker finished running a callback
+	 */
+	LIBCTHREADS_TRACER_EVENT_END		= 4,
+
+	/* A thread started waiting on a condition
+	 */
+	LIBCTHREADS_TRACER_EVENT_BLOCK		= 5,
+
+	/* A thread stopped waiting on a condition
+	 */
+	LIBCTHREADS_TRACER_EVENT_WAKE		= 6
+};
+
+typedef struct libcthreads_tracer_event libcthreads_tracer_event_t;
+
+struct libcthreads_tracer_event
+{
+	/* The timestamp in clock ticks
+	 */
+	uint64_t timestamp;
+
+	/* The object the event applies to
+	 */
+	const void *object;
+
+	/* The event type
+	 */
+	uint8_t event_type;
+};
+
+typedef struct libcthreads_tracer_buffer libcthreads_tracer_buffer_t;
+
+struct libcthreads_tracer_buffer
+{
+	/* The events
+	 */
+	libcthreads_tracer_event_t events[ LIBCTHREADS_TRACER_BUFFER_SIZE ];
+
+	/* The write index, only written by the thread that owns the buffer
+	 */
+	volatile uint32_t write_index;
+
+	/* The read index, events before the read index were cleared
+	 */
+	volatile uint32_t read_index;
+
+	/* The thread index
+	 */
+	int thread_index;
+
+#if defined( WINAPI ) && ( WINVER < 0x0600 )
+	/* The identifier of the thread that owns the buffer
+	 */
+	DWORD thread_identifier;
+#endif
+
+	/* Value to indicate the thread that owns the buffer has exited
+	 */
+	uint8_t thread_has_exited;
+
+	/* The next buffer
+	 */
+	libcthreads_tracer_buffer_t *next_buffer;
+};
+
+uint64_t libcthreads_tracer_get_timestamp(
+          void );
+
+void libcthreads_internal_tracer_initialize_buffer_storage(
+      void );
+
+void libcthreads_internal_tracer_enter(
+      void );
+
+void libcthreads_internal_tracer_leave(
+      void );
+
+int libcthreads_internal_tracer_buffer_exit(
+     intptr_t **buffer,
+     libcerror_error_t **error );
+
+#if defined( WINAPI ) && ( WINVER < 0x0600 )
+int libcthreads_internal_tracer_buffer_thread_has_exited(
+     libcthreads_tracer_buffer_t *buffer );
+#endif
+
+libcthreads_tracer_buffer_t *libcthreads_internal_tracer_get_buffer(
+                              void );
+
+void libcthreads_tracer_record_event(
+      uint8_t event_type,
+      const void *object );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_tracer_enable(
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_tracer_disable(
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_tracer_is_enabled(
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_tracer_clear(
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_tracer_get_number_of_events(
+     int *number_of_events,
+     libcerror_error_t **error );
+
+LIBCTHREADS_EXTERN \
+int libcthreads_tracer_write_chrome_trace(
+     const char *filename,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_TRACER_H ) */
+
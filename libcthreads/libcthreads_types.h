@@ -34,29 +34,125 @@
 /* The following type definitions hide internal data structures
  */
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
+typedef struct libcthreads_barrier {}		libcthreads_barrier_t;
+typedef struct libcthreads_channel {}		libcthreads_channel_t;
 typedef struct libcthreads_condition {}		libcthreads_condition_t;
+typedef struct libcthreads_hash_map {}		libcthreads_hash_map_t;
+typedef struct libcthreads_hazard_pointer_domain {}	libcthreads_hazard_pointer_domain_t;
+typedef struct libcthreads_latch {}		libcthreads_latch_t;
 typedef struct libcthreads_lock {}		libcthreads_lock_t;
+typedef struct libcthreads_lock_stripe {}	libcthreads_lock_stripe_t;
+typedef struct libcthreads_mpsc_queue {}	libcthreads_mpsc_queue_t;
 typedef struct libcthreads_mutex {}		libcthreads_mutex_t;
+typedef struct libcthreads_object_pool {}	libcthreads_object_pool_t;
 typedef struct libcthreads_queue {}		libcthreads_queue_t;
+typedef struct libcthreads_queued_lock {}	libcthreads_queued_lock_t;
 typedef struct libcthreads_read_write_lock {}	libcthreads_read_write_lock_t;
 typedef struct libcthreads_repeating_thread {}	libcthreads_repeating_thread_t;
+typedef struct libcthreads_sharded_counter {}	libcthreads_sharded_counter_t;
+typedef struct libcthreads_stack {}		libcthreads_stack_t;
 typedef struct libcthreads_thread {}		libcthreads_thread_t;
 typedef struct libcthreads_thread_attributes {}	libcthreads_thread_attributes_t;
+typedef struct libcthreads_thread_local {}	libcthreads_thread_local_t;
 typedef struct libcthreads_thread_pool {}	libcthreads_thread_pool_t;
+typedef struct libcthreads_timer {}		libcthreads_timer_t;
+typedef struct libcthreads_timer_service {}	libcthreads_timer_service_t;
+typedef struct libcthreads_topology {}		libcthreads_topology_t;
 
 #else
+typedef intptr_t libcthreads_barrier_t;
+typedef intptr_t libcthreads_channel_t;
 typedef intptr_t libcthreads_condition_t;
+typedef intptr_t libcthreads_hash_map_t;
+typedef intptr_t libcthreads_hazard_pointer_domain_t;
+typedef intptr_t libcthreads_latch_t;
 typedef intptr_t libcthreads_lock_t;
+typedef intptr_t libcthreads_lock_stripe_t;
+typedef intptr_t libcthreads_mpsc_queue_t;
 typedef intptr_t libcthreads_mutex_t;
+typedef intptr_t libcthreads_object_pool_t;
 typedef intptr_t libcthreads_queue_t;
+typedef intptr_t libcthreads_queued_lock_t;
 typedef intptr_t libcthreads_read_write_lock_t;
 typedef intptr_t libcthreads_repeating_thread_t;
+typedef intptr_t libcthreads_sharded_counter_t;
+typedef intptr_t libcthreads_stack_t;
 typedef intptr_t libcthreads_thread_t;
 typedef intptr_t libcthreads_thread_attributes_t;
+typedef intptr_t libcthreads_thread_local_t;
 typedef intptr_t libcthreads_thread_pool_t;
+typedef intptr_t libcthreads_timer_t;
+typedef intptr_t libcthreads_timer_service_t;
+typedef intptr_t libcthreads_topology_t;
 
 #endif /* defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI ) */
 
+/* The sizes of the storage for in place initialization, these are large
+ * enough to hold the internal data structures on all supported platforms
+ */
+#define LIBCTHREADS_CONDITION_STORAGE_SIZE		96
+#define LIBCTHREADS_LOCK_STORAGE_SIZE			64
+#define LIBCTHREADS_MUTEX_STORAGE_SIZE			64
+#define LIBCTHREADS_READ_WRITE_LOCK_STORAGE_SIZE	256
+
+/* The storage for in place initialization, e.g. as part of another structure
+ */
+typedef union libcthreads_condition_storage
+{
+	uint8_t data[ LIBCTHREADS_CONDITION_STORAGE_SIZE ];
+	uint64_t alignment;
+
+} libcthreads_condition_storage_t;
+
+typedef union libcthreads_lock_storage
+{
+	uint8_t data[ LIBCTHREADS_LOCK_STORAGE_SIZE ];
+	uint64_t alignment;
+
+} libcthreads_lock_storage_t;
+
+typedef union libcthreads_mutex_storage
+{
+	uint8_t data[ LIBCTHREADS_MUTEX_STORAGE_SIZE ];
+	uint64_t alignment;
+
+} libcthreads_mutex_storage_t;
+
+typedef union libcthreads_read_write_lock_storage
+{
+	uint8_t data[ LIBCTHREADS_READ_WRITE_LOCK_STORAGE_SIZE ];
+	uint64_t alignment;
+
+} libcthreads_read_write_lock_storage_t;
+
+/* The nodes of the intrusive stack and MPSC queue, these are embedded
+ * in the objects that are pushed
+ */
+typedef struct libcthreads_stack_node libcthreads_stack_node_t;
+
+struct libcthreads_stack_node
+{
+	libcthreads_stack_node_t *next_node;
+};
+
+typedef struct libcthreads_mpsc_queue_node libcthreads_mpsc_queue_node_t;
+
+struct libcthreads_mpsc_queue_node
+{
+	libcthreads_mpsc_queue_node_t *next_node;
+};
+
+/* The value of the atomic double width compare and exchange, this value
+ * must be aligned to its size
+ */
+typedef struct libcthreads_atomic_double_width libcthreads_atomic_double_width_t;
+
+struct libcthreads_atomic_double_width
+{
+	intptr_t low_value;
+	intptr_t high_value;
+};
+
 #endif /* defined( HAVE_LOCAL_LIBCTHREADS ) && defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 #endif /* !defined( _LIBCTHREADS_INTERNAL_TYPES_H ) */
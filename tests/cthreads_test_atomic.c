@@ -0,0 +1,620 @@
+/*
+ * Library atomic functions test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_unused.h"
+
+#define CTHREADS_TEST_ATOMIC_NUMBER_OF_ITERATIONS	10000
+#define CTHREADS_TEST_ATOMIC_NUMBER_OF_THREADS		4
+
+volatile uint32_t cthreads_test_atomic_value_32 = 0;
+volatile uint64_t cthreads_test_atomic_value_64 = 0;
+
+/* The increment callback function
+ * Increments the 32-bit value using fetch and add and the 64-bit value
+ * using compare and exchange
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_atomic_increment_callback_function(
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	uint64_t expected_value = 0;
+	int iteration           = 0;
+
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	for( iteration = 0;
+	     iteration < CTHREADS_TEST_ATOMIC_NUMBER_OF_ITERATIONS;
+	     iteration++ )
+	{
+		libcthreads_atomic_fetch_add_32(
+		 &cthreads_test_atomic_value_32,
+		 1,
+		 LIBCTHREADS_MEMORY_ORDER_RELAXED );
+
+		expected_value = libcthreads_atomic_load_64(
+		                  &cthreads_test_atomic_value_64,
+		                  LIBCTHREADS_MEMORY_ORDER_RELAXED );
+
+		while( libcthreads_atomic_compare_exchange_64(
+		        &cthreads_test_atomic_value_64,
+		        &expected_value,
+		        expected_value + 1,
+		        LIBCTHREADS_MEMORY_ORDER_ACQUIRE_RELEASE ) == 0 )
+		{
+			libcthreads_atomic_cpu_relax();
+		}
+	}
+	return( 1 );
+}
+
+/* Tests the 32-bit atomic functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_atomic_32(
+     void )
+{
+	volatile uint32_t value = 0;
+	uint32_t expected_value = 0;
+	uint32_t result_value   = 0;
+	int result              = 0;
+
+	/* Test regular cases
+	 */
+	libcthreads_atomic_store_32(
+	 &value,
+	 0x12345678UL,
+	 LIBCTHREADS_MEMORY_ORDER_RELEASE );
+
+	result_value = libcthreads_atomic_load_32(
+	                &value,
+	                LIBCTHREADS_MEMORY_ORDER_ACQUIRE );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT32(
+	 "result_value",
+	 result_value,
+	 (uint32_t) 0x12345678UL );
+
+	result_value = libcthreads_atomic_exchange_32(
+	                &value,
+	                0x00000010UL,
+	                LIBCTHREADS_MEMORY_ORDER_SEQUENTIALLY_CONSISTENT );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT32(
+	 "result_value",
+	 result_value,
+	 (uint32_t) 0x12345678UL );
+
+	result_value = libcthreads_atomic_fetch_add_32(
+	                &value,
+	                2,
+	                LIBCTHREADS_MEMORY_ORDER_RELAXED );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT32(
+	 "result_value",
+	 result_value,
+	 (uint32_t) 0x00000010UL );
+
+	result_value = libcthreads_atomic_fetch_or_32(
+	                &value,
+	                0x80000001UL,
+	                LIBCTHREADS_MEMORY_ORDER_RELAXED );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT32(
+	 "result_value",
+	 result_value,
+	 (uint32_t) 0x00000012UL );
+
+	expected_value = 0;
+
+	result = libcthreads_atomic_compare_exchange_32(
+	          &value,
+	          &expected_value,
+	          1,
+	          LIBCTHREADS_MEMORY_ORDER_ACQUIRE_RELEASE );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT32(
+	 "expected_value",
+	 expected_value,
+	 (uint32_t) 0x80000013UL );
+
+	result = libcthreads_atomic_compare_exchange_32(
+	          &value,
+	          &expected_value,
+	          1,
+	          LIBCTHREADS_MEMORY_ORDER_ACQUIRE_RELEASE );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT32(
+	 "value",
+	 value,
+	 (uint32_t) 1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the 64-bit atomic functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_atomic_64(
+     void )
+{
+	volatile uint64_t value = 0;
+	uint64_t expected_value = 0;
+	uint64_t result_value   = 0;
+	int result              = 0;
+
+	/* Test regular cases
+	 */
+	libcthreads_atomic_store_64(
+	 &value,
+	 0x123456789abcdef0ULL,
+	 LIBCTHREADS_MEMORY_ORDER_RELEASE );
+
+	result_value = libcthreads_atomic_load_64(
+	                &value,
+	                LIBCTHREADS_MEMORY_ORDER_ACQUIRE );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT64(
+	 "result_value",
+	 result_value,
+	 (uint64_t) 0x123456789abcdef0ULL );
+
+	result_value = libcthreads_atomic_exchange_64(
+	                &value,
+	                0x00000000ffffffffULL,
+	                LIBCTHREADS_MEMORY_ORDER_SEQUENTIALLY_CONSISTENT );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT64(
+	 "result_value",
+	 result_value,
+	 (uint64_t) 0x123456789abcdef0ULL );
+
+	result_value = libcthreads_atomic_fetch_add_64(
+	                &value,
+	                1,
+	                LIBCTHREADS_MEMORY_ORDER_RELAXED );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT64(
+	 "result_value",
+	 result_value,
+	 (uint64_t) 0x00000000ffffffffULL );
+
+	result_value = libcthreads_atomic_fetch_or_64(
+	                &value,
+	                0x8000000000000000ULL,
+	                LIBCTHREADS_MEMORY_ORDER_RELAXED );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT64(
+	 "result_value",
+	 result_value,
+	 (uint64_t) 0x0000000100000000ULL );
+
+	expected_value = 0;
+
+	result = libcthreads_atomic_compare_exchange_64(
+	          &value,
+	          &expected_value,
+	          1,
+	          LIBCTHREADS_MEMORY_ORDER_ACQUIRE_RELEASE );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT64(
+	 "expected_value",
+	 expected_value,
+	 (uint64_t) 0x8000000100000000ULL );
+
+	result = libcthreads_atomic_compare_exchange_64(
+	          &value,
+	          &expected_value,
+	          1,
+	          LIBCTHREADS_MEMORY_ORDER_ACQUIRE_RELEASE );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the pointer atomic functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_atomic_pointer(
+     void )
+{
+	intptr_t first_object        = 1;
+	intptr_t second_object       = 2;
+	intptr_t * volatile value    = NULL;
+	intptr_t *expected_value     = NULL;
+	intptr_t *result_value       = NULL;
+	int result                   = 0;
+
+	/* Test regular cases
+	 */
+	libcthreads_atomic_store_pointer(
+	 &value,
+	 &first_object,
+	 LIBCTHREADS_MEMORY_ORDER_RELEASE );
+
+	result_value = libcthreads_atomic_load_pointer(
+	                &value,
+	                LIBCTHREADS_MEMORY_ORDER_ACQUIRE );
+
+	result = ( result_value == &first_object );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result_value = libcthreads_atomic_exchange_pointer(
+	                &value,
+	                &second_object,
+	                LIBCTHREADS_MEMORY_ORDER_ACQUIRE_RELEASE );
+
+	result = ( result_value == &first_object );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	expected_value = &first_object;
+
+	result = libcthreads_atomic_compare_exchange_pointer(
+	          &value,
+	          &expected_value,
+	          NULL,
+	          LIBCTHREADS_MEMORY_ORDER_ACQUIRE_RELEASE );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = ( expected_value == &second_object );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_atomic_compare_exchange_pointer(
+	          &value,
+	          &expected_value,
+	          NULL,
+	          LIBCTHREADS_MEMORY_ORDER_ACQUIRE_RELEASE );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "value",
+	 value );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libcthreads_atomic_compare_exchange_double_width function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_atomic_compare_exchange_double_width(
+     void )
+{
+	libcthreads_atomic_double_width_t expected_value;
+	libcthreads_atomic_double_width_t new_value;
+
+	libcthreads_atomic_double_width_t *value = NULL;
+	int result                               = 0;
+
+	/* Initialize test
+	 */
+	value = (libcthreads_atomic_double_width_t *) memory_allocate(
+	                                               sizeof( libcthreads_atomic_double_width_t ) );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "value",
+	 value );
+
+	value->low_value  = 1;
+	value->high_value = 2;
+
+	/* Test regular cases
+	 */
+	expected_value.low_value  = 1;
+	expected_value.high_value = 3;
+	new_value.low_value       = 4;
+	new_value.high_value      = 5;
+
+	result = libcthreads_atomic_compare_exchange_double_width(
+	          value,
+	          &expected_value,
+	          &new_value );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "expected_value.low_value",
+	 (int) expected_value.low_value,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "expected_value.high_value",
+	 (int) expected_value.high_value,
+	 2 );
+
+	result = libcthreads_atomic_compare_exchange_double_width(
+	          value,
+	          &expected_value,
+	          &new_value );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "value->low_value",
+	 (int) value->low_value,
+	 4 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "value->high_value",
+	 (int) value->high_value,
+	 5 );
+
+	/* Clean up
+	 */
+	memory_free(
+	 value );
+
+	return( 1 );
+
+on_error:
+	if( value != NULL )
+	{
+		memory_free(
+		 value );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_atomic_is_lock_free function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_atomic_is_lock_free(
+     void )
+{
+	int result = 0;
+
+	/* Test regular cases
+	 */
+	result = libcthreads_atomic_is_lock_free(
+	          sizeof( uint32_t ) );
+
+#if defined( WINAPI ) || defined( __GNUC__ ) || defined( __clang__ )
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+#else
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+#endif
+
+	/* Test error cases
+	 */
+	result = libcthreads_atomic_is_lock_free(
+	          3 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the atomic functions from multiple threads
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_atomic_threads(
+     void )
+{
+	libcerror_error_t *error                                                 = NULL;
+	libcthreads_thread_t *threads[ CTHREADS_TEST_ATOMIC_NUMBER_OF_THREADS ] = { NULL };
+	int result                                                               = 0;
+	int thread_index                                                         = 0;
+
+	/* Initialize test
+	 */
+	cthreads_test_atomic_value_32 = 0;
+	cthreads_test_atomic_value_64 = 0;
+
+	/* Test regular cases
+	 */
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_ATOMIC_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          cthreads_test_atomic_increment_callback_function,
+		          NULL,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_ATOMIC_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	libcthreads_atomic_thread_fence(
+	 LIBCTHREADS_MEMORY_ORDER_SEQUENTIALLY_CONSISTENT );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT32(
+	 "cthreads_test_atomic_value_32",
+	 cthreads_test_atomic_value_32,
+	 (uint32_t) ( CTHREADS_TEST_ATOMIC_NUMBER_OF_THREADS * CTHREADS_TEST_ATOMIC_NUMBER_OF_ITERATIONS ) );
+
+	CTHREADS_TEST_ASSERT_EQUAL_UINT64(
+	 "cthreads_test_atomic_value_64",
+	 cthreads_test_atomic_value_64,
+	 (uint64_t) ( CTHREADS_TEST_ATOMIC_NUMBER_OF_THREADS * CTHREADS_TEST_ATOMIC_NUMBER_OF_ITERATIONS ) );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_ATOMIC_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_atomic_32",
+	 cthreads_test_atomic_32 );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_atomic_64",
+	 cthreads_test_atomic_64 );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_atomic_pointer",
+	 cthreads_test_atomic_pointer );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_atomic_compare_exchange_double_width",
+	 cthreads_test_atomic_compare_exchange_double_width );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_atomic_is_lock_free",
+	 cthreads_test_atomic_is_lock_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_atomic_threads",
+	 cthreads_test_atomic_threads );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1291 @@
+/*
+ * Library channel type test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_memory.h"
+#include "cthreads_test_unused.h"
+
+#define CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS	2
+
+libcthreads_channel_t *cthreads_test_channels[ CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS ];
+
+int cthreads_test_number_of_iterations = 497;
+int cthreads_test_receive_result       = -1;
+int cthreads_test_values[ 4 ]          = { 1, 2, 3, 4 };
+
+/* The sender callback function
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_channel_sender_callback_function(
+     void *arguments )
+{
+	libcerror_error_t *error       = NULL;
+	libcthreads_channel_t *channel = NULL;
+	static char *function          = "cthreads_test_channel_sender_callback_function";
+	int iterator                   = 0;
+	int result                     = 0;
+
+	channel = (libcthreads_channel_t *) arguments;
+
+	for( iterator = 0;
+	     iterator < cthreads_test_number_of_iterations;
+	     iterator++ )
+	{
+		result = libcthreads_channel_send(
+		          channel,
+		          (intptr_t *) &( cthreads_test_values[ iterator % 4 ] ),
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to send value.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	result = libcthreads_channel_close(
+	          channel,
+	          &error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to close channel.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* The receiver callback function
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_channel_receiver_callback_function(
+     void *arguments )
+{
+	libcerror_error_t *error       = NULL;
+	libcthreads_channel_t *channel = NULL;
+	intptr_t *value                = NULL;
+
+	channel = (libcthreads_channel_t *) arguments;
+
+	cthreads_test_receive_result = libcthreads_channel_receive(
+	                                channel,
+	                                &value,
+	                                &error );
+
+	if( cthreads_test_receive_result == -1 )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libcthreads_channel_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_channel_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libcthreads_channel_t *channel  = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 6;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libcthreads_channel_initialize(
+	          &channel,
+	          2,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "channel",
+	 channel );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_channel_free(
+	          &channel,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "channel",
+	 channel );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_channel_initialize(
+	          NULL,
+	          2,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	channel = (libcthreads_channel_t *) 0x12345678UL;
+
+	result = libcthreads_channel_initialize(
+	          &channel,
+	          2,
+	          &error );
+
+	channel = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_channel_initialize(
+	          &channel,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_channel_initialize with malloc failing
+		 */
+		cthreads_test_malloc_attempts_before_fail = test_number;
+
+		result = libcthreads_channel_initialize(
+		          &channel,
+		          2,
+		          &error );
+
+		if( cthreads_test_malloc_attempts_before_fail != -1 )
+		{
+			cthreads_test_malloc_attempts_before_fail = -1;
+
+			if( channel != NULL )
+			{
+				libcthreads_channel_free(
+				 &channel,
+				 NULL,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "channel",
+			 channel );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_channel_initialize with memset failing
+		 */
+		cthreads_test_memset_attempts_before_fail = test_number;
+
+		result = libcthreads_channel_initialize(
+		          &channel,
+		          2,
+		          &error );
+
+		if( cthreads_test_memset_attempts_before_fail != -1 )
+		{
+			cthreads_test_memset_attempts_before_fail = -1;
+
+			if( channel != NULL )
+			{
+				libcthreads_channel_free(
+				 &channel,
+				 NULL,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "channel",
+			 channel );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_CTHREADS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( channel != NULL )
+	{
+		libcthreads_channel_free(
+		 &channel,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_channel_free function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_channel_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libcthreads_channel_free(
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_channel_send and libcthreads_channel_receive functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_channel_send(
+     void )
+{
+	libcerror_error_t *error       = NULL;
+	libcthreads_channel_t *channel = NULL;
+	libcthreads_thread_t *thread   = NULL;
+	intptr_t *value                = NULL;
+	int result                     = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_channel_initialize(
+	          &channel,
+	          2,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_channel_try_receive(
+	          channel,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_channel_send(
+	          channel,
+	          (intptr_t *) &( cthreads_test_values[ 0 ] ),
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_channel_try_send(
+	          channel,
+	          (intptr_t *) &( cthreads_test_values[ 1 ] ),
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_channel_try_send(
+	          channel,
+	          (intptr_t *) &( cthreads_test_values[ 2 ] ),
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_channel_close(
+	          channel,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that closing a closed channel is allowed
+	 */
+	result = libcthreads_channel_close(
+	          channel,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_channel_is_end_of_stream(
+	          channel,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the values in a closed channel are drained
+	 */
+	result = libcthreads_channel_receive(
+	          channel,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "value",
+	 *( (int *) value ),
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_channel_try_receive(
+	          channel,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "value",
+	 *( (int *) value ),
+	 2 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_channel_receive(
+	          channel,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_channel_is_end_of_stream(
+	          channel,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_channel_send(
+	          channel,
+	          (intptr_t *) &( cthreads_test_values[ 0 ] ),
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_channel_try_send(
+	          channel,
+	          (intptr_t *) &( cthreads_test_values[ 0 ] ),
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_channel_send(
+	          NULL,
+	          (intptr_t *) &( cthreads_test_values[ 0 ] ),
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_channel_receive(
+	          NULL,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_channel_receive(
+	          channel,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_channel_close(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_channel_free(
+	          &channel,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that closing a channel wakes up a waiting receiver
+	 */
+	result = libcthreads_channel_initialize(
+	          &channel,
+	          2,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	cthreads_test_receive_result = -1;
+
+	result = libcthreads_thread_create(
+	          &thread,
+	          NULL,
+	          cthreads_test_channel_receiver_callback_function,
+	          (void *) channel,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_channel_close(
+	          channel,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_join(
+	          &thread,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_receive_result",
+	 cthreads_test_receive_result,
+	 0 );
+
+	result = libcthreads_channel_free(
+	          &channel,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread != NULL )
+	{
+		libcthreads_thread_join(
+		 &thread,
+		 NULL );
+	}
+	if( channel != NULL )
+	{
+		libcthreads_channel_free(
+		 &channel,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_channel_select function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_channel_select(
+     void )
+{
+	libcthreads_thread_t *threads[ CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS ];
+	int number_of_values[ CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS ];
+
+	libcerror_error_t *error = NULL;
+	intptr_t *value          = NULL;
+	int channel_index        = 0;
+	int expected_sum         = 0;
+	int index                = 0;
+	int result               = 0;
+	int sum                  = 0;
+
+	for( index = 0;
+	     index < CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS;
+	     index++ )
+	{
+		cthreads_test_channels[ index ] = NULL;
+		number_of_values[ index ]       = 0;
+		threads[ index ]                = NULL;
+	}
+	for( index = 0;
+	     index < cthreads_test_number_of_iterations;
+	     index++ )
+	{
+		expected_sum += cthreads_test_values[ index % 4 ];
+	}
+	expected_sum *= CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS;
+
+	/* Initialize test
+	 */
+	for( index = 0;
+	     index < CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS;
+	     index++ )
+	{
+		result = libcthreads_channel_initialize(
+		          &( cthreads_test_channels[ index ] ),
+		          8,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libcthreads_channel_try_select(
+	          cthreads_test_channels,
+	          CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS,
+	          &channel_index,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( index = 0;
+	     index < CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS;
+	     index++ )
+	{
+		result = libcthreads_thread_create(
+		          &( threads[ index ] ),
+		          NULL,
+		          cthreads_test_channel_sender_callback_function,
+		          (void *) cthreads_test_channels[ index ],
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	do
+	{
+		result = libcthreads_channel_select(
+		          cthreads_test_channels,
+		          CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS,
+		          &channel_index,
+		          &value,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result == 1 )
+		{
+			number_of_values[ channel_index ] += 1;
+			sum                               += *( (int *) value );
+		}
+	}
+	while( result != 2 );
+
+	for( index = 0;
+	     index < CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS;
+	     index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "number_of_values",
+		 number_of_values[ index ],
+		 cthreads_test_number_of_iterations );
+	}
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "sum",
+	 sum,
+	 expected_sum );
+
+	/* Test try select when all channels reached end of stream
+	 */
+	result = libcthreads_channel_try_select(
+	          cthreads_test_channels,
+	          CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS,
+	          &channel_index,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 2 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_channel_select(
+	          NULL,
+	          CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS,
+	          &channel_index,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_channel_select(
+	          cthreads_test_channels,
+	          0,
+	          &channel_index,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_channel_select(
+	          cthreads_test_channels,
+	          CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS,
+	          NULL,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_channel_try_select(
+	          NULL,
+	          CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS,
+	          &channel_index,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	for( index = 0;
+	     index < CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS;
+	     index++ )
+	{
+		result = libcthreads_channel_free(
+		          &( cthreads_test_channels[ index ] ),
+		          NULL,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	for( index = 0;
+	     index < CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS;
+	     index++ )
+	{
+		if( cthreads_test_channels[ index ] != NULL )
+		{
+			libcthreads_channel_close(
+			 cthreads_test_channels[ index ],
+			 NULL );
+		}
+	}
+	for( index = 0;
+	     index < CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS;
+	     index++ )
+	{
+		if( threads[ index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ index ] ),
+			 NULL );
+		}
+		if( cthreads_test_channels[ index ] != NULL )
+		{
+			libcthreads_channel_free(
+			 &( cthreads_test_channels[ index ] ),
+			 NULL,
+			 NULL );
+		}
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_channel_try_select and libcthreads_channel_select functions
+ * when all channels are closed
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_channel_select_end_of_stream(
+     void )
+{
+	libcthreads_channel_t *channels[ CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS ];
+
+	libcerror_error_t *error = NULL;
+	intptr_t *value          = NULL;
+	int channel_index        = 0;
+	int index                = 0;
+	int result               = 0;
+
+	for( index = 0;
+	     index < CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS;
+	     index++ )
+	{
+		channels[ index ] = NULL;
+	}
+	/* Initialize test
+	 */
+	for( index = 0;
+	     index < CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS;
+	     index++ )
+	{
+		result = libcthreads_channel_initialize(
+		          &( channels[ index ] ),
+		          8,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_channel_close(
+		          channels[ index ],
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libcthreads_channel_try_select(
+	          channels,
+	          CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS,
+	          &channel_index,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 2 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_channel_select(
+	          channels,
+	          CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS,
+	          &channel_index,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 2 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	for( index = 0;
+	     index < CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS;
+	     index++ )
+	{
+		result = libcthreads_channel_free(
+		          &( channels[ index ] ),
+		          NULL,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( index = 0;
+	     index < CTHREADS_TEST_CHANNEL_NUMBER_OF_CHANNELS;
+	     index++ )
+	{
+		if( channels[ index ] != NULL )
+		{
+			libcthreads_channel_free(
+			 &( channels[ index ] ),
+			 NULL,
+			 NULL );
+		}
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_channel_initialize",
+	 cthreads_test_channel_initialize );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_channel_free",
+	 cthreads_test_channel_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_channel_send",
+	 cthreads_test_channel_send );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_channel_select",
+	 cthreads_test_channel_select );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_channel_select_end_of_stream",
+	 cthreads_test_channel_select_end_of_stream );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -1141,6 +1141,514 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libcthreads_condition_wait_until and libcthreads_condition_timed_wait functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_condition_wait_until(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libcthreads_condition_t *condition = NULL;
+	libcthreads_mutex_t *mutex         = NULL;
+	uint64_t deadline                  = 0;
+	uint64_t monotonic_time            = 0;
+	int mutex_is_grabbed               = 0;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_condition_initialize(
+	          &condition,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_initialize(
+	          &mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_grab(
+	          mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	mutex_is_grabbed = 1;
+
+	/* Test regular cases
+	 */
+	result = libcthreads_clock_get_monotonic_time(
+	          &deadline,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	deadline += 2000000;
+
+	/* Spurious wake ups are allowed so wait until the deadline has passed
+	 */
+	do
+	{
+		result = libcthreads_condition_wait_until(
+		          condition,
+		          mutex,
+		          deadline,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	while( result != 0 );
+
+	result = libcthreads_clock_get_monotonic_time(
+	          &monotonic_time,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "monotonic_time >= deadline",
+	 (int) ( monotonic_time >= deadline ),
+	 1 );
+
+	/* A deadline that has passed does not wait
+	 */
+	result = libcthreads_condition_wait_until(
+	          condition,
+	          mutex,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_condition_timed_wait(
+	          condition,
+	          mutex,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_condition_wait_until(
+	          NULL,
+	          mutex,
+	          deadline,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_condition_wait_until(
+	          condition,
+	          NULL,
+	          deadline,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_condition_timed_wait(
+	          NULL,
+	          mutex,
+	          1000,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	mutex_is_grabbed = 0;
+
+	result = libcthreads_mutex_release(
+	          mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_free(
+	          &mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_condition_free(
+	          &condition,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( mutex_is_grabbed != 0 )
+	{
+		libcthreads_mutex_release(
+		 mutex,
+		 NULL );
+	}
+	if( mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &mutex,
+		 NULL );
+	}
+	if( condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &condition,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_condition_broadcast_fast and libcthreads_condition_signal_fast functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_condition_fast(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libcthreads_condition_t *condition = NULL;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_condition_initialize(
+	          &condition,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_condition_broadcast_fast(
+	          condition );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_condition_signal_fast(
+	          condition );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Clean up
+	 */
+	result = libcthreads_condition_free(
+	          &condition,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &condition,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_condition_initialize_in_place and libcthreads_condition_finalize_in_place functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_condition_in_place(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libcthreads_condition_t *condition = NULL;
+	libcthreads_condition_storage_t storage;
+	int result                         = 0;
+
+	/* Test regular cases
+	 */
+	result = libcthreads_condition_initialize_in_place(
+	          &condition,
+	          &storage,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "condition",
+	 condition );
+
+	result = libcthreads_condition_broadcast(
+	          condition,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_condition_signal(
+	          condition,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_condition_finalize_in_place(
+	          &condition,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "condition",
+	 condition );
+
+	/* Test error cases
+	 */
+	result = libcthreads_condition_initialize_in_place(
+	          NULL,
+	          &storage,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	condition = (libcthreads_condition_t *) 0x12345678UL;
+
+	result = libcthreads_condition_initialize_in_place(
+	          &condition,
+	          &storage,
+	          &error );
+
+	condition = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_condition_initialize_in_place(
+	          &condition,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_condition_finalize_in_place(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( condition != NULL )
+	{
+		libcthreads_condition_finalize_in_place(
+		 &condition,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -1176,6 +1684,18 @@ int main(
 	 "libcthreads_condition_wait",
 	 cthreads_test_condition_wait );
 
+	CTHREADS_TEST_RUN(
+	 "libcthreads_condition_wait_until",
+	 cthreads_test_condition_wait_until );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_condition_fast",
+	 cthreads_test_condition_fast );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_condition_initialize_in_place",
+	 cthreads_test_condition_in_place );
+
 	return( EXIT_SUCCESS );
 
 on_error:
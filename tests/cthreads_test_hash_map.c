@@ -0,0 +1,1186 @@
+/*
+ * Library hash map type test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_memory.h"
+#include "cthreads_test_unused.h"
+
+#define CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS		1000
+#define CTHREADS_TEST_HASH_MAP_NUMBER_OF_THREADS	4
+
+libcthreads_hash_map_t *cthreads_test_hash_map = NULL;
+
+int cthreads_test_hash_map_keys[ CTHREADS_TEST_HASH_MAP_NUMBER_OF_THREADS * CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS ];
+
+/* The hash map key hash function
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_hash_map_key_hash_function(
+     intptr_t *key,
+     uint64_t *key_hash,
+     libcerror_error_t **error )
+{
+	static char *function = "cthreads_test_hash_map_key_hash_function";
+
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	*key_hash = (uint64_t) *( (int *) key );
+
+	return( 1 );
+}
+
+/* The hash map key compare function
+ * Returns LIBCTHREADS_COMPARE_LESS, LIBCTHREADS_COMPARE_EQUAL, LIBCTHREADS_COMPARE_GREATER if successful or -1 on error
+ */
+int cthreads_test_hash_map_key_compare_function(
+     intptr_t *first_key,
+     intptr_t *second_key,
+     libcerror_error_t **error )
+{
+	static char *function = "cthreads_test_hash_map_key_compare_function";
+
+	if( first_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first key.",
+		 function );
+
+		return( -1 );
+	}
+	if( second_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid second key.",
+		 function );
+
+		return( -1 );
+	}
+	if( *( (int *) first_key ) < *( (int *) second_key ) )
+	{
+		return( LIBCTHREADS_COMPARE_LESS );
+	}
+	else if( *( (int *) first_key ) > *( (int *) second_key ) )
+	{
+		return( LIBCTHREADS_COMPARE_GREATER );
+	}
+	return( LIBCTHREADS_COMPARE_EQUAL );
+}
+
+/* The hash map value free function
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_hash_map_value_free_function(
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "cthreads_test_hash_map_value_free_function";
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( *value != NULL )
+	{
+		memory_free(
+		 *value );
+
+		*value = NULL;
+	}
+	return( 1 );
+}
+
+/* The hash map callback function
+ * Inserts, looks up and removes the keys of the thread
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_hash_map_callback_function(
+     void *arguments )
+{
+	libcerror_error_t *error = NULL;
+	intptr_t *removed_key    = NULL;
+	intptr_t *removed_value  = NULL;
+	intptr_t *value          = NULL;
+	int *key                 = NULL;
+	int *thread_number       = NULL;
+	static char *function    = "cthreads_test_hash_map_callback_function";
+	int key_index            = 0;
+	int result               = 0;
+
+	thread_number = (int *) arguments;
+
+	for( key_index = 0;
+	     key_index < CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS;
+	     key_index++ )
+	{
+		key = &( cthreads_test_hash_map_keys[ ( *thread_number * CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS ) + key_index ] );
+
+		result = libcthreads_hash_map_insert_value(
+		          cthreads_test_hash_map,
+		          (intptr_t *) key,
+		          (intptr_t *) key,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert value.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( key_index = 0;
+	     key_index < CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS;
+	     key_index++ )
+	{
+		key = &( cthreads_test_hash_map_keys[ ( *thread_number * CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS ) + key_index ] );
+
+		result = libcthreads_hash_map_get_value(
+		          cthreads_test_hash_map,
+		          (intptr_t *) key,
+		          &value,
+		          &error );
+
+		if( ( result != 1 )
+		 || ( value != (intptr_t *) key ) )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value.",
+			 function );
+
+			goto on_error;
+		}
+		/* Remove the keys with an odd index
+		 */
+		if( ( key_index % 2 ) != 0 )
+		{
+			result = libcthreads_hash_map_remove_value(
+			          cthreads_test_hash_map,
+			          (intptr_t *) key,
+			          &removed_key,
+			          &removed_value,
+			          &error );
+
+			if( ( result != 1 )
+			 || ( removed_key != (intptr_t *) key ) )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove value.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Tests the libcthreads_hash_map_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_hash_map_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libcthreads_hash_map_t *hash_map = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 6;
+	int number_of_memset_fail_tests  = 5;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libcthreads_hash_map_initialize(
+	          &hash_map,
+	          4,
+	          &cthreads_test_hash_map_key_hash_function,
+	          &cthreads_test_hash_map_key_compare_function,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "hash_map",
+	 hash_map );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_hash_map_free(
+	          &hash_map,
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "hash_map",
+	 hash_map );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_hash_map_initialize(
+	          NULL,
+	          4,
+	          &cthreads_test_hash_map_key_hash_function,
+	          &cthreads_test_hash_map_key_compare_function,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	hash_map = (libcthreads_hash_map_t *) 0x12345678UL;
+
+	result = libcthreads_hash_map_initialize(
+	          &hash_map,
+	          4,
+	          &cthreads_test_hash_map_key_hash_function,
+	          &cthreads_test_hash_map_key_compare_function,
+	          &error );
+
+	hash_map = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hash_map_initialize(
+	          &hash_map,
+	          0,
+	          &cthreads_test_hash_map_key_hash_function,
+	          &cthreads_test_hash_map_key_compare_function,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hash_map_initialize(
+	          &hash_map,
+	          4,
+	          NULL,
+	          &cthreads_test_hash_map_key_compare_function,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hash_map_initialize(
+	          &hash_map,
+	          4,
+	          &cthreads_test_hash_map_key_hash_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_hash_map_initialize with malloc failing
+		 */
+		cthreads_test_malloc_attempts_before_fail = test_number;
+
+		result = libcthreads_hash_map_initialize(
+		          &hash_map,
+		          4,
+		          &cthreads_test_hash_map_key_hash_function,
+		          &cthreads_test_hash_map_key_compare_function,
+		          &error );
+
+		if( cthreads_test_malloc_attempts_before_fail != -1 )
+		{
+			cthreads_test_malloc_attempts_before_fail = -1;
+
+			if( hash_map != NULL )
+			{
+				libcthreads_hash_map_free(
+				 &hash_map,
+				 NULL,
+				 NULL,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "hash_map",
+			 hash_map );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_hash_map_initialize with memset failing
+		 */
+		cthreads_test_memset_attempts_before_fail = test_number;
+
+		result = libcthreads_hash_map_initialize(
+		          &hash_map,
+		          4,
+		          &cthreads_test_hash_map_key_hash_function,
+		          &cthreads_test_hash_map_key_compare_function,
+		          &error );
+
+		if( cthreads_test_memset_attempts_before_fail != -1 )
+		{
+			cthreads_test_memset_attempts_before_fail = -1;
+
+			if( hash_map != NULL )
+			{
+				libcthreads_hash_map_free(
+				 &hash_map,
+				 NULL,
+				 NULL,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "hash_map",
+			 hash_map );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_CTHREADS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_map != NULL )
+	{
+		libcthreads_hash_map_free(
+		 &hash_map,
+		 NULL,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_hash_map_free function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_hash_map_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libcthreads_hash_map_free(
+	          NULL,
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_hash_map_insert_value, libcthreads_hash_map_get_value and libcthreads_hash_map_remove_value functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_hash_map_insert_value(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libcthreads_hash_map_t *hash_map = NULL;
+	intptr_t *removed_key            = NULL;
+	intptr_t *removed_value          = NULL;
+	intptr_t *value                  = NULL;
+	int *insert_value                = NULL;
+	int key_index                    = 0;
+	int number_of_entries            = 0;
+	int result                       = 0;
+
+	for( key_index = 0;
+	     key_index < CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS;
+	     key_index++ )
+	{
+		cthreads_test_hash_map_keys[ key_index ] = key_index;
+	}
+	/* Initialize test
+	 */
+	result = libcthreads_hash_map_initialize(
+	          &hash_map,
+	          2,
+	          &cthreads_test_hash_map_key_hash_function,
+	          &cthreads_test_hash_map_key_compare_function,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * Insert enough values to resize the hash map multiple times
+	 */
+	for( key_index = 0;
+	     key_index < CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS;
+	     key_index++ )
+	{
+		insert_value = (int *) memory_allocate(
+		                        sizeof( int ) );
+
+		CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+		 "insert_value",
+		 insert_value );
+
+		*insert_value = key_index;
+
+		result = libcthreads_hash_map_insert_value(
+		          hash_map,
+		          (intptr_t *) &( cthreads_test_hash_map_keys[ key_index ] ),
+		          (intptr_t *) insert_value,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		insert_value = NULL;
+	}
+	result = libcthreads_hash_map_get_number_of_entries(
+	          hash_map,
+	          &number_of_entries,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( key_index = 0;
+	     key_index < CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS;
+	     key_index++ )
+	{
+		result = libcthreads_hash_map_get_value(
+		          hash_map,
+		          (intptr_t *) &( cthreads_test_hash_map_keys[ key_index ] ),
+		          &value,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+		 "value",
+		 value );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "*value",
+		 *( (int *) value ),
+		 key_index );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test insert of an existing key
+	 */
+	result = libcthreads_hash_map_insert_value(
+	          hash_map,
+	          (intptr_t *) &( cthreads_test_hash_map_keys[ 0 ] ),
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test remove of an existing key
+	 */
+	result = libcthreads_hash_map_remove_value(
+	          hash_map,
+	          (intptr_t *) &( cthreads_test_hash_map_keys[ 0 ] ),
+	          &removed_key,
+	          &removed_value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "removed_value",
+	 removed_value );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "*removed_key",
+	 *( (int *) removed_key ),
+	 0 );
+
+	memory_free(
+	 removed_value );
+
+	/* Test remove and retrieve of a missing key
+	 */
+	result = libcthreads_hash_map_remove_value(
+	          hash_map,
+	          (intptr_t *) &( cthreads_test_hash_map_keys[ 0 ] ),
+	          &removed_key,
+	          &removed_value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_hash_map_get_value(
+	          hash_map,
+	          (intptr_t *) &( cthreads_test_hash_map_keys[ 0 ] ),
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_hash_map_get_number_of_entries(
+	          hash_map,
+	          &number_of_entries,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS - 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_hash_map_insert_value(
+	          NULL,
+	          (intptr_t *) &( cthreads_test_hash_map_keys[ 0 ] ),
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hash_map_insert_value(
+	          hash_map,
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hash_map_get_value(
+	          NULL,
+	          (intptr_t *) &( cthreads_test_hash_map_keys[ 0 ] ),
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hash_map_get_value(
+	          hash_map,
+	          (intptr_t *) &( cthreads_test_hash_map_keys[ 0 ] ),
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hash_map_remove_value(
+	          NULL,
+	          (intptr_t *) &( cthreads_test_hash_map_keys[ 0 ] ),
+	          &removed_key,
+	          &removed_value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hash_map_remove_value(
+	          hash_map,
+	          (intptr_t *) &( cthreads_test_hash_map_keys[ 0 ] ),
+	          NULL,
+	          &removed_value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hash_map_remove_value(
+	          hash_map,
+	          (intptr_t *) &( cthreads_test_hash_map_keys[ 0 ] ),
+	          &removed_key,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hash_map_get_number_of_entries(
+	          hash_map,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_hash_map_free(
+	          &hash_map,
+	          NULL,
+	          &cthreads_test_hash_map_value_free_function,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( insert_value != NULL )
+	{
+		memory_free(
+		 insert_value );
+	}
+	if( hash_map != NULL )
+	{
+		libcthreads_hash_map_free(
+		 &hash_map,
+		 NULL,
+		 &cthreads_test_hash_map_value_free_function,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_hash_map functions with multiple threads
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_hash_map_threads(
+     void )
+{
+	int thread_numbers[ CTHREADS_TEST_HASH_MAP_NUMBER_OF_THREADS ];
+	libcthreads_thread_t *threads[ CTHREADS_TEST_HASH_MAP_NUMBER_OF_THREADS ];
+
+	libcerror_error_t *error = NULL;
+	intptr_t *value          = NULL;
+	int expected_result      = 0;
+	int key_index            = 0;
+	int number_of_entries    = 0;
+	int result               = 0;
+	int thread_index         = 0;
+
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_HASH_MAP_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		threads[ thread_index ] = NULL;
+	}
+	for( key_index = 0;
+	     key_index < CTHREADS_TEST_HASH_MAP_NUMBER_OF_THREADS * CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS;
+	     key_index++ )
+	{
+		cthreads_test_hash_map_keys[ key_index ] = key_index;
+	}
+	/* Initialize test
+	 */
+	result = libcthreads_hash_map_initialize(
+	          &cthreads_test_hash_map,
+	          4,
+	          &cthreads_test_hash_map_key_hash_function,
+	          &cthreads_test_hash_map_key_compare_function,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_HASH_MAP_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		thread_numbers[ thread_index ] = thread_index;
+
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          &cthreads_test_hash_map_callback_function,
+		          (void *) &( thread_numbers[ thread_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_HASH_MAP_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcthreads_hash_map_get_number_of_entries(
+	          cthreads_test_hash_map,
+	          &number_of_entries,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 ( CTHREADS_TEST_HASH_MAP_NUMBER_OF_THREADS * CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS ) / 2 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( key_index = 0;
+	     key_index < CTHREADS_TEST_HASH_MAP_NUMBER_OF_THREADS * CTHREADS_TEST_HASH_MAP_NUMBER_OF_KEYS;
+	     key_index++ )
+	{
+		/* The callback function removed the keys with an odd index
+		 */
+		expected_result = ( ( key_index % 2 ) == 0 ) ? 1 : 0;
+
+		result = libcthreads_hash_map_get_value(
+		          cthreads_test_hash_map,
+		          (intptr_t *) &( cthreads_test_hash_map_keys[ key_index ] ),
+		          &value,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 expected_result );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Clean up
+	 */
+	result = libcthreads_hash_map_free(
+	          &cthreads_test_hash_map,
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_HASH_MAP_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	if( cthreads_test_hash_map != NULL )
+	{
+		libcthreads_hash_map_free(
+		 &cthreads_test_hash_map,
+		 NULL,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_hash_map_initialize",
+	 cthreads_test_hash_map_initialize );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_hash_map_free",
+	 cthreads_test_hash_map_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_hash_map_insert_value",
+	 cthreads_test_hash_map_insert_value );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_hash_map_threads",
+	 cthreads_test_hash_map_threads );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
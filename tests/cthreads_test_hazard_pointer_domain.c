@@ -0,0 +1,1332 @@
+/*
+ * Library hazard pointer domain type test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_memory.h"
+#include "cthreads_test_unused.h"
+
+#define CTHREADS_TEST_HAZARD_POINTER_DOMAIN_MAGIC			0x48505452
+#define CTHREADS_TEST_HAZARD_POINTER_DOMAIN_NUMBER_OF_ITERATIONS	1000
+#define CTHREADS_TEST_HAZARD_POINTER_DOMAIN_NUMBER_OF_THREADS		4
+
+libcthreads_hazard_pointer_domain_t *cthreads_test_hazard_pointer_domain = NULL;
+libcthreads_mutex_t *cthreads_test_hazard_pointer_domain_mutex           = NULL;
+intptr_t *cthreads_test_hazard_pointer_domain_shared_value               = NULL;
+int cthreads_test_hazard_pointer_domain_number_of_errors                 = 0;
+int cthreads_test_hazard_pointer_domain_number_of_freed_values           = 0;
+
+/* Creates a value
+ * Returns a pointer to the value if successful or NULL on error
+ */
+intptr_t *cthreads_test_hazard_pointer_domain_value_create(
+           void )
+{
+	int *value = NULL;
+
+	value = (int *) memory_allocate(
+	                 sizeof( int ) );
+
+	if( value != NULL )
+	{
+		*value = CTHREADS_TEST_HAZARD_POINTER_DOMAIN_MAGIC;
+	}
+	return( (intptr_t *) value );
+}
+
+/* The hazard pointer domain value free function
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_hazard_pointer_domain_value_free_function(
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "cthreads_test_hazard_pointer_domain_value_free_function";
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     cthreads_test_hazard_pointer_domain_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( *( (int *) *value ) != CTHREADS_TEST_HAZARD_POINTER_DOMAIN_MAGIC )
+	{
+		cthreads_test_hazard_pointer_domain_number_of_errors++;
+	}
+	cthreads_test_hazard_pointer_domain_number_of_freed_values++;
+
+	if( libcthreads_mutex_release(
+	     cthreads_test_hazard_pointer_domain_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* Poison the value so that a use after reclaim is detected
+	 */
+	*( (int *) *value ) = 0;
+
+	memory_free(
+	 *value );
+
+	*value = NULL;
+
+	return( 1 );
+}
+
+/* The reader callback function
+ * Protects and verifies the shared value while it is being replaced
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_hazard_pointer_domain_reader_callback_function(
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	intptr_t *value          = NULL;
+	static char *function    = "cthreads_test_hazard_pointer_domain_reader_callback_function";
+	int iteration            = 0;
+	int number_of_errors     = 0;
+
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	for( iteration = 0;
+	     iteration < ( 10 * CTHREADS_TEST_HAZARD_POINTER_DOMAIN_NUMBER_OF_ITERATIONS );
+	     iteration++ )
+	{
+		if( libcthreads_hazard_pointer_domain_protect(
+		     cthreads_test_hazard_pointer_domain,
+		     0,
+		     &cthreads_test_hazard_pointer_domain_shared_value,
+		     &value,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to protect value.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( value != NULL )
+		 && ( *( (int *) value ) != CTHREADS_TEST_HAZARD_POINTER_DOMAIN_MAGIC ) )
+		{
+			number_of_errors++;
+		}
+		if( libcthreads_hazard_pointer_domain_clear(
+		     cthreads_test_hazard_pointer_domain,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to clear value.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     cthreads_test_hazard_pointer_domain_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	cthreads_test_hazard_pointer_domain_number_of_errors += number_of_errors;
+
+	if( libcthreads_mutex_release(
+	     cthreads_test_hazard_pointer_domain_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* The retire callback function
+ * Retires values that are reclaimed when the thread exits
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_hazard_pointer_domain_retire_callback_function(
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	intptr_t *value          = NULL;
+	static char *function    = "cthreads_test_hazard_pointer_domain_retire_callback_function";
+	int value_index          = 0;
+
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	for( value_index = 0;
+	     value_index < 4;
+	     value_index++ )
+	{
+		value = cthreads_test_hazard_pointer_domain_value_create();
+
+		if( value == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create value: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		if( libcthreads_hazard_pointer_domain_retire(
+		     cthreads_test_hazard_pointer_domain,
+		     value,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to retire value: %d.",
+			 function,
+			 value_index );
+
+			memory_free(
+			 value );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Tests the libcthreads_hazard_pointer_domain_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_hazard_pointer_domain_initialize(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libcthreads_hazard_pointer_domain_t *hazard_pointer_domain = NULL;
+	int result                                                 = 0;
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                            = 2;
+	int number_of_memset_fail_tests                            = 2;
+	int test_number                                            = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libcthreads_hazard_pointer_domain_initialize(
+	          &hazard_pointer_domain,
+	          2,
+	          &cthreads_test_hazard_pointer_domain_value_free_function,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "hazard_pointer_domain",
+	 hazard_pointer_domain );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_hazard_pointer_domain_free(
+	          &hazard_pointer_domain,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "hazard_pointer_domain",
+	 hazard_pointer_domain );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_hazard_pointer_domain_initialize(
+	          NULL,
+	          2,
+	          &cthreads_test_hazard_pointer_domain_value_free_function,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	hazard_pointer_domain = (libcthreads_hazard_pointer_domain_t *) 0x12345678UL;
+
+	result = libcthreads_hazard_pointer_domain_initialize(
+	          &hazard_pointer_domain,
+	          2,
+	          &cthreads_test_hazard_pointer_domain_value_free_function,
+	          &error );
+
+	hazard_pointer_domain = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hazard_pointer_domain_initialize(
+	          &hazard_pointer_domain,
+	          0,
+	          &cthreads_test_hazard_pointer_domain_value_free_function,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hazard_pointer_domain_initialize(
+	          &hazard_pointer_domain,
+	          17,
+	          &cthreads_test_hazard_pointer_domain_value_free_function,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hazard_pointer_domain_initialize(
+	          &hazard_pointer_domain,
+	          2,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_hazard_pointer_domain_initialize with malloc failing
+		 */
+		cthreads_test_malloc_attempts_before_fail = test_number;
+
+		result = libcthreads_hazard_pointer_domain_initialize(
+		          &hazard_pointer_domain,
+		          2,
+		          &cthreads_test_hazard_pointer_domain_value_free_function,
+		          &error );
+
+		if( cthreads_test_malloc_attempts_before_fail != -1 )
+		{
+			cthreads_test_malloc_attempts_before_fail = -1;
+
+			if( hazard_pointer_domain != NULL )
+			{
+				libcthreads_hazard_pointer_domain_free(
+				 &hazard_pointer_domain,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "hazard_pointer_domain",
+			 hazard_pointer_domain );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_hazard_pointer_domain_initialize with memset failing
+		 */
+		cthreads_test_memset_attempts_before_fail = test_number;
+
+		result = libcthreads_hazard_pointer_domain_initialize(
+		          &hazard_pointer_domain,
+		          2,
+		          &cthreads_test_hazard_pointer_domain_value_free_function,
+		          &error );
+
+		if( cthreads_test_memset_attempts_before_fail != -1 )
+		{
+			cthreads_test_memset_attempts_before_fail = -1;
+
+			if( hazard_pointer_domain != NULL )
+			{
+				libcthreads_hazard_pointer_domain_free(
+				 &hazard_pointer_domain,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "hazard_pointer_domain",
+			 hazard_pointer_domain );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_CTHREADS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( hazard_pointer_domain != NULL )
+	{
+		libcthreads_hazard_pointer_domain_free(
+		 &hazard_pointer_domain,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_hazard_pointer_domain_free function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_hazard_pointer_domain_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libcthreads_hazard_pointer_domain_free(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_hazard_pointer_domain_protect, libcthreads_hazard_pointer_domain_clear,
+ * libcthreads_hazard_pointer_domain_retire and libcthreads_hazard_pointer_domain_scan functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_hazard_pointer_domain_protect(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	intptr_t *value          = NULL;
+	intptr_t *value_copy     = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	cthreads_test_hazard_pointer_domain_number_of_errors       = 0;
+	cthreads_test_hazard_pointer_domain_number_of_freed_values = 0;
+
+	result = libcthreads_mutex_initialize(
+	          &cthreads_test_hazard_pointer_domain_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_hazard_pointer_domain_initialize(
+	          &cthreads_test_hazard_pointer_domain,
+	          2,
+	          &cthreads_test_hazard_pointer_domain_value_free_function,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	cthreads_test_hazard_pointer_domain_shared_value = cthreads_test_hazard_pointer_domain_value_create();
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "cthreads_test_hazard_pointer_domain_shared_value",
+	 cthreads_test_hazard_pointer_domain_shared_value );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_hazard_pointer_domain_protect(
+	          cthreads_test_hazard_pointer_domain,
+	          1,
+	          &cthreads_test_hazard_pointer_domain_shared_value,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ( value == cthreads_test_hazard_pointer_domain_shared_value );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* A retired value is not reclaimed while it is protected
+	 */
+	value_copy = cthreads_test_hazard_pointer_domain_shared_value;
+
+	cthreads_test_hazard_pointer_domain_shared_value = NULL;
+
+	result = libcthreads_hazard_pointer_domain_retire(
+	          cthreads_test_hazard_pointer_domain,
+	          value_copy,
+	          &error );
+
+	value_copy = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_hazard_pointer_domain_scan(
+	          cthreads_test_hazard_pointer_domain,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_hazard_pointer_domain_number_of_freed_values",
+	 cthreads_test_hazard_pointer_domain_number_of_freed_values,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "*value",
+	 *( (int *) value ),
+	 CTHREADS_TEST_HAZARD_POINTER_DOMAIN_MAGIC );
+
+	/* A retired value is reclaimed once it is no longer protected
+	 */
+	result = libcthreads_hazard_pointer_domain_clear(
+	          cthreads_test_hazard_pointer_domain,
+	          1,
+	          &error );
+
+	value = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_hazard_pointer_domain_scan(
+	          cthreads_test_hazard_pointer_domain,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_hazard_pointer_domain_number_of_freed_values",
+	 cthreads_test_hazard_pointer_domain_number_of_freed_values,
+	 1 );
+
+	/* Protecting a NULL reference succeeds
+	 */
+	result = libcthreads_hazard_pointer_domain_protect(
+	          cthreads_test_hazard_pointer_domain,
+	          0,
+	          &cthreads_test_hazard_pointer_domain_shared_value,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "value",
+	 value );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_hazard_pointer_domain_protect(
+	          NULL,
+	          0,
+	          &cthreads_test_hazard_pointer_domain_shared_value,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hazard_pointer_domain_protect(
+	          cthreads_test_hazard_pointer_domain,
+	          -1,
+	          &cthreads_test_hazard_pointer_domain_shared_value,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hazard_pointer_domain_protect(
+	          cthreads_test_hazard_pointer_domain,
+	          2,
+	          &cthreads_test_hazard_pointer_domain_shared_value,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hazard_pointer_domain_protect(
+	          cthreads_test_hazard_pointer_domain,
+	          0,
+	          NULL,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hazard_pointer_domain_protect(
+	          cthreads_test_hazard_pointer_domain,
+	          0,
+	          &cthreads_test_hazard_pointer_domain_shared_value,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hazard_pointer_domain_clear(
+	          NULL,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hazard_pointer_domain_clear(
+	          cthreads_test_hazard_pointer_domain,
+	          2,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hazard_pointer_domain_retire(
+	          NULL,
+	          value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hazard_pointer_domain_retire(
+	          cthreads_test_hazard_pointer_domain,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_hazard_pointer_domain_scan(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_hazard_pointer_domain_free(
+	          &cthreads_test_hazard_pointer_domain,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_hazard_pointer_domain_number_of_errors",
+	 cthreads_test_hazard_pointer_domain_number_of_errors,
+	 0 );
+
+	result = libcthreads_mutex_free(
+	          &cthreads_test_hazard_pointer_domain_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cthreads_test_hazard_pointer_domain != NULL )
+	{
+		libcthreads_hazard_pointer_domain_free(
+		 &cthreads_test_hazard_pointer_domain,
+		 NULL );
+	}
+	if( value_copy != NULL )
+	{
+		memory_free(
+		 value_copy );
+	}
+	if( cthreads_test_hazard_pointer_domain_shared_value != NULL )
+	{
+		memory_free(
+		 cthreads_test_hazard_pointer_domain_shared_value );
+
+		cthreads_test_hazard_pointer_domain_shared_value = NULL;
+	}
+	if( cthreads_test_hazard_pointer_domain_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &cthreads_test_hazard_pointer_domain_mutex,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests replacing and retiring a value while other threads protect it
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_hazard_pointer_domain_retire(
+     void )
+{
+	libcerror_error_t *error                                                                = NULL;
+	libcthreads_thread_t *threads[ CTHREADS_TEST_HAZARD_POINTER_DOMAIN_NUMBER_OF_THREADS ] = { NULL };
+	libcthreads_thread_t *thread                                                            = NULL;
+	intptr_t *previous_value                                                                = NULL;
+	intptr_t *value                                                                         = NULL;
+	int iteration                                                                           = 0;
+	int number_of_freed_values                                                              = 0;
+	int result                                                                              = 0;
+	int thread_index                                                                        = 0;
+
+	/* Initialize test
+	 */
+	cthreads_test_hazard_pointer_domain_number_of_errors       = 0;
+	cthreads_test_hazard_pointer_domain_number_of_freed_values = 0;
+
+	result = libcthreads_mutex_initialize(
+	          &cthreads_test_hazard_pointer_domain_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_hazard_pointer_domain_initialize(
+	          &cthreads_test_hazard_pointer_domain,
+	          1,
+	          &cthreads_test_hazard_pointer_domain_value_free_function,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	cthreads_test_hazard_pointer_domain_shared_value = cthreads_test_hazard_pointer_domain_value_create();
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "cthreads_test_hazard_pointer_domain_shared_value",
+	 cthreads_test_hazard_pointer_domain_shared_value );
+
+	/* Test regular cases
+	 */
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_HAZARD_POINTER_DOMAIN_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          cthreads_test_hazard_pointer_domain_reader_callback_function,
+		          NULL,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( iteration = 0;
+	     iteration < CTHREADS_TEST_HAZARD_POINTER_DOMAIN_NUMBER_OF_ITERATIONS;
+	     iteration++ )
+	{
+		value = cthreads_test_hazard_pointer_domain_value_create();
+
+		CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+		 "value",
+		 value );
+
+		previous_value = cthreads_test_hazard_pointer_domain_shared_value;
+
+		/* The readers protect the shared value with an atomic load,
+		 * hence the value is published with release ordering
+		 */
+		libcthreads_atomic_store_pointer(
+		 &cthreads_test_hazard_pointer_domain_shared_value,
+		 value,
+		 LIBCTHREADS_MEMORY_ORDER_RELEASE );
+
+		result = libcthreads_hazard_pointer_domain_retire(
+		          cthreads_test_hazard_pointer_domain,
+		          previous_value,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		previous_value = NULL;
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_HAZARD_POINTER_DOMAIN_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	previous_value = cthreads_test_hazard_pointer_domain_shared_value;
+
+	cthreads_test_hazard_pointer_domain_shared_value = NULL;
+
+	result = libcthreads_hazard_pointer_domain_retire(
+	          cthreads_test_hazard_pointer_domain,
+	          previous_value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	previous_value = NULL;
+
+	/* The values retired by a thread are reclaimed when the thread exits
+	 */
+	number_of_freed_values = cthreads_test_hazard_pointer_domain_number_of_freed_values;
+
+	result = libcthreads_thread_create(
+	          &thread,
+	          NULL,
+	          cthreads_test_hazard_pointer_domain_retire_callback_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_join(
+	          &thread,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_hazard_pointer_domain_number_of_freed_values",
+	 cthreads_test_hazard_pointer_domain_number_of_freed_values,
+	 number_of_freed_values + 4 );
+
+	/* Clean up
+	 */
+	result = libcthreads_hazard_pointer_domain_free(
+	          &cthreads_test_hazard_pointer_domain,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_hazard_pointer_domain_number_of_freed_values",
+	 cthreads_test_hazard_pointer_domain_number_of_freed_values,
+	 CTHREADS_TEST_HAZARD_POINTER_DOMAIN_NUMBER_OF_ITERATIONS + 5 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_hazard_pointer_domain_number_of_errors",
+	 cthreads_test_hazard_pointer_domain_number_of_errors,
+	 0 );
+
+	result = libcthreads_mutex_free(
+	          &cthreads_test_hazard_pointer_domain_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_HAZARD_POINTER_DOMAIN_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	if( thread != NULL )
+	{
+		libcthreads_thread_join(
+		 &thread,
+		 NULL );
+	}
+	if( cthreads_test_hazard_pointer_domain != NULL )
+	{
+		libcthreads_hazard_pointer_domain_free(
+		 &cthreads_test_hazard_pointer_domain,
+		 NULL );
+	}
+	if( previous_value != NULL )
+	{
+		memory_free(
+		 previous_value );
+	}
+	if( cthreads_test_hazard_pointer_domain_shared_value != NULL )
+	{
+		memory_free(
+		 cthreads_test_hazard_pointer_domain_shared_value );
+
+		cthreads_test_hazard_pointer_domain_shared_value = NULL;
+	}
+	if( cthreads_test_hazard_pointer_domain_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &cthreads_test_hazard_pointer_domain_mutex,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_hazard_pointer_domain_initialize",
+	 cthreads_test_hazard_pointer_domain_initialize );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_hazard_pointer_domain_free",
+	 cthreads_test_hazard_pointer_domain_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_hazard_pointer_domain_protect",
+	 cthreads_test_hazard_pointer_domain_protect );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_hazard_pointer_domain_retire",
+	 cthreads_test_hazard_pointer_domain_retire );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
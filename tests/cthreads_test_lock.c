@@ -62,6 +62,8 @@ int cthreads_test_real_pthread_mutex_unlock_function_return_value
 
 libcthreads_lock_t *cthreads_test_lock = NULL;
 int cthreads_test_locked_value         = 0;
+int cthreads_test_try_grab_result      = 0;
+int cthreads_test_timed_grab_result    = 0;
 
 #if defined( HAVE_GNU_DL_DLSYM ) && defined( __GNUC__ ) && !defined( __clang__ ) && !defined( __CYGWIN__ )
 
@@ -307,6 +309,63 @@ on_error:
 	return( -1 );
 }
 
+/* The try grab callback function, the lock is expected to be held by another thread
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_lock_try_grab_callback_function(
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "cthreads_test_lock_try_grab_callback_function";
+
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	cthreads_test_try_grab_result = libcthreads_lock_try_grab(
+	                                 cthreads_test_lock,
+	                                 &error );
+
+	if( cthreads_test_try_grab_result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to try grab lock.",
+		 function );
+
+		goto on_error;
+	}
+	cthreads_test_timed_grab_result = libcthreads_lock_timed_grab(
+	                                   cthreads_test_lock,
+	                                   1000000,
+	                                   &error );
+
+	if( cthreads_test_timed_grab_result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab lock with timeout.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
 /* Tests the libcthreads_lock_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -1234,36 +1293,627 @@ on_error:
 	return( 0 );
 }
 
-/* The main program
+/* Tests the libcthreads_lock_grab_fast and libcthreads_lock_release_fast functions
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
-     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
-#else
-int main(
-     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
-     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
-#endif
+int cthreads_test_lock_fast(
+     void )
 {
-	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
-	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+	libcerror_error_t *error = NULL;
+	libcthreads_lock_t *lock = NULL;
+	int result               = 0;
 
-	CTHREADS_TEST_RUN(
-	 "libcthreads_lock_initialize",
-	 cthreads_test_lock_initialize );
+	/* Initialize test
+	 */
+	result = libcthreads_lock_initialize(
+	          &lock,
+	          &error );
 
-	CTHREADS_TEST_RUN(
-	 "libcthreads_lock_free",
-	 cthreads_test_lock_free );
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	CTHREADS_TEST_RUN(
-	 "libcthreads_lock_grab",
-	 cthreads_test_lock_grab );
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	CTHREADS_TEST_RUN(
-	 "libcthreads_lock_release",
-	 cthreads_test_lock_release );
+	/* Test regular cases
+	 */
+	result = libcthreads_lock_grab_fast(
+	          lock );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_lock_release_fast(
+	          lock );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+#if defined( HAVE_GNU_DL_DLSYM ) && defined( __GNUC__ ) && !defined( __clang__ ) && !defined( __CYGWIN__ )
+
+	/* Test libcthreads_lock_grab_fast with pthread_mutex_lock returning EDEADLK
+	 */
+	cthreads_test_pthread_mutex_lock_attempts_before_fail       = 0;
+	cthreads_test_real_pthread_mutex_lock_function_return_value = EDEADLK;
+
+	result = libcthreads_lock_grab_fast(
+	          lock );
+
+	if( cthreads_test_pthread_mutex_lock_attempts_before_fail != -1 )
+	{
+		cthreads_test_pthread_mutex_lock_attempts_before_fail = -1;
+	}
+	else
+	{
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+	}
+	/* Test libcthreads_lock_release_fast with pthread_mutex_unlock returning EBUSY
+	 */
+	cthreads_test_pthread_mutex_unlock_attempts_before_fail       = 0;
+	cthreads_test_real_pthread_mutex_unlock_function_return_value = EBUSY;
+
+	result = libcthreads_lock_release_fast(
+	          lock );
+
+	if( cthreads_test_pthread_mutex_unlock_attempts_before_fail != -1 )
+	{
+		cthreads_test_pthread_mutex_unlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+	}
+#endif /* defined( HAVE_GNU_DL_DLSYM ) && defined( __GNUC__ ) && !defined( __clang__ ) && !defined( __CYGWIN__ ) */
+
+	/* Clean up
+	 */
+	result = libcthreads_lock_free(
+	          &lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( lock != NULL )
+	{
+		libcthreads_lock_free(
+		 &lock,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_lock_try_grab and libcthreads_lock_timed_grab functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_lock_try_grab(
+     void )
+{
+	libcerror_error_t *error     = NULL;
+	libcthreads_thread_t *thread = NULL;
+	int result                   = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_lock_initialize(
+	          &cthreads_test_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_lock_try_grab(
+	          cthreads_test_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test try grab and timed grab while the lock is held
+	 */
+	cthreads_test_try_grab_result   = -1;
+	cthreads_test_timed_grab_result = -1;
+
+	result = libcthreads_thread_create(
+	          &thread,
+	          NULL,
+	          cthreads_test_lock_try_grab_callback_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_join(
+	          &thread,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_try_grab_result",
+	 cthreads_test_try_grab_result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_timed_grab_result",
+	 cthreads_test_timed_grab_result,
+	 0 );
+
+	result = libcthreads_lock_release(
+	          cthreads_test_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test timed grab when the lock is available
+	 */
+	result = libcthreads_lock_timed_grab(
+	          cthreads_test_lock,
+	          1000000,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_release(
+	          cthreads_test_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_lock_try_grab(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_lock_grab_until(
+	          NULL,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_lock_timed_grab(
+	          NULL,
+	          1000000,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_lock_free(
+	          &cthreads_test_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "cthreads_test_lock",
+	 cthreads_test_lock );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread != NULL )
+	{
+		libcthreads_thread_join(
+		 &thread,
+		 NULL );
+	}
+	if( cthreads_test_lock != NULL )
+	{
+		libcthreads_lock_free(
+		 &cthreads_test_lock,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_lock_initialize_in_place and libcthreads_lock_finalize_in_place functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_lock_in_place(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libcthreads_lock_t *lock = NULL;
+	libcthreads_lock_storage_t storage;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libcthreads_lock_initialize_in_place(
+	          &lock,
+	          &storage,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "lock",
+	 lock );
+
+	result = libcthreads_lock_grab(
+	          lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_release(
+	          lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_finalize_in_place(
+	          &lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "lock",
+	 lock );
+
+	/* Test error cases
+	 */
+	result = libcthreads_lock_initialize_in_place(
+	          NULL,
+	          &storage,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	lock = (libcthreads_lock_t *) 0x12345678UL;
+
+	result = libcthreads_lock_initialize_in_place(
+	          &lock,
+	          &storage,
+	          &error );
+
+	lock = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_lock_initialize_in_place(
+	          &lock,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_lock_finalize_in_place(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( lock != NULL )
+	{
+		libcthreads_lock_finalize_in_place(
+		 &lock,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( LIBCTHREADS_HAVE_STATIC_INITIALIZERS )
+
+/* Tests a statically initialized lock storage
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_lock_static_initializer(
+     void )
+{
+	static libcthreads_lock_storage_t storage = LIBCTHREADS_LOCK_STORAGE_INITIALIZER;
+
+	libcerror_error_t *error = NULL;
+	libcthreads_lock_t *lock = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	lock = LIBCTHREADS_LOCK_FROM_STORAGE( &storage );
+
+	result = libcthreads_lock_grab(
+	          lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_release(
+	          lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_finalize_in_place(
+	          &lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( LIBCTHREADS_HAVE_STATIC_INITIALIZERS ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_initialize",
+	 cthreads_test_lock_initialize );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_free",
+	 cthreads_test_lock_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_grab",
+	 cthreads_test_lock_grab );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_release",
+	 cthreads_test_lock_release );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_fast",
+	 cthreads_test_lock_fast );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_try_grab",
+	 cthreads_test_lock_try_grab );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_initialize_in_place",
+	 cthreads_test_lock_in_place );
+
+#if defined( LIBCTHREADS_HAVE_STATIC_INITIALIZERS )
+
+	CTHREADS_TEST_RUN(
+	 "LIBCTHREADS_LOCK_STORAGE_INITIALIZER",
+	 cthreads_test_lock_static_initializer );
+
+#endif /* defined( LIBCTHREADS_HAVE_STATIC_INITIALIZERS ) */
 
 	return( EXIT_SUCCESS );
 
@@ -0,0 +1,993 @@
+/*
+ * Library lock stripe type test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_memory.h"
+#include "cthreads_test_unused.h"
+
+#define CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_ITERATIONS	1000
+#define CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_KEYS	16
+#define CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_THREADS	4
+
+libcthreads_lock_stripe_t *cthreads_test_lock_stripe = NULL;
+
+int cthreads_test_lock_stripe_values[ CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_KEYS ];
+
+/* The lock stripe callback function
+ * Moves a value between two keys while holding both of their stripes
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_lock_stripe_callback_function(
+     void *arguments )
+{
+	uint64_t key_hashes[ 2 ];
+
+	libcerror_error_t *error = NULL;
+	int *thread_number       = NULL;
+	static char *function    = "cthreads_test_lock_stripe_callback_function";
+	int iteration            = 0;
+	int result               = 0;
+
+	thread_number = (int *) arguments;
+
+	for( iteration = 0;
+	     iteration < CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_ITERATIONS;
+	     iteration++ )
+	{
+		/* Threads use opposite key orders to make sure the lock stripe
+		 * determines the grab order
+		 */
+		key_hashes[ 0 ] = (uint64_t) ( ( iteration + *thread_number ) % CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_KEYS );
+		key_hashes[ 1 ] = (uint64_t) ( CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_KEYS - 1 - key_hashes[ 0 ] );
+
+		if( ( *thread_number % 2 ) != 0 )
+		{
+			key_hashes[ 0 ] = key_hashes[ 1 ];
+			key_hashes[ 1 ] = (uint64_t) ( CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_KEYS - 1 - key_hashes[ 0 ] );
+		}
+		result = libcthreads_lock_stripe_grab_multiple(
+		          cthreads_test_lock_stripe,
+		          key_hashes,
+		          2,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab stripes.",
+			 function );
+
+			goto on_error;
+		}
+		cthreads_test_lock_stripe_values[ key_hashes[ 0 ] ] -= 1;
+		cthreads_test_lock_stripe_values[ key_hashes[ 1 ] ] += 1;
+
+		result = libcthreads_lock_stripe_release_multiple(
+		          cthreads_test_lock_stripe,
+		          key_hashes,
+		          2,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release stripes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Tests the libcthreads_lock_stripe_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_lock_stripe_initialize(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libcthreads_lock_stripe_t *lock_stripe = NULL;
+	int number_of_stripes                  = 0;
+	int result                             = 0;
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+	int number_of_malloc_fail_tests        = 2;
+	int number_of_memset_fail_tests        = 1;
+	int test_number                        = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libcthreads_lock_stripe_initialize(
+	          &lock_stripe,
+	          5,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "lock_stripe",
+	 lock_stripe );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_stripe_get_number_of_stripes(
+	          lock_stripe,
+	          &number_of_stripes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_stripes",
+	 number_of_stripes,
+	 8 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_stripe_free(
+	          &lock_stripe,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "lock_stripe",
+	 lock_stripe );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_stripe_initialize(
+	          &lock_stripe,
+	          1,
+	          LIBCTHREADS_LOCK_STRIPE_FLAG_READ_WRITE,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "lock_stripe",
+	 lock_stripe );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_stripe_free(
+	          &lock_stripe,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_lock_stripe_initialize(
+	          NULL,
+	          8,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	lock_stripe = (libcthreads_lock_stripe_t *) 0x12345678UL;
+
+	result = libcthreads_lock_stripe_initialize(
+	          &lock_stripe,
+	          8,
+	          0,
+	          &error );
+
+	lock_stripe = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_lock_stripe_initialize(
+	          &lock_stripe,
+	          0,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_lock_stripe_initialize(
+	          &lock_stripe,
+	          8,
+	          0xff,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_lock_stripe_initialize with malloc failing
+		 */
+		cthreads_test_malloc_attempts_before_fail = test_number;
+
+		result = libcthreads_lock_stripe_initialize(
+		          &lock_stripe,
+		          8,
+		          0,
+		          &error );
+
+		if( cthreads_test_malloc_attempts_before_fail != -1 )
+		{
+			cthreads_test_malloc_attempts_before_fail = -1;
+
+			if( lock_stripe != NULL )
+			{
+				libcthreads_lock_stripe_free(
+				 &lock_stripe,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "lock_stripe",
+			 lock_stripe );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_lock_stripe_initialize with memset failing
+		 */
+		cthreads_test_memset_attempts_before_fail = test_number;
+
+		result = libcthreads_lock_stripe_initialize(
+		          &lock_stripe,
+		          8,
+		          0,
+		          &error );
+
+		if( cthreads_test_memset_attempts_before_fail != -1 )
+		{
+			cthreads_test_memset_attempts_before_fail = -1;
+
+			if( lock_stripe != NULL )
+			{
+				libcthreads_lock_stripe_free(
+				 &lock_stripe,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "lock_stripe",
+			 lock_stripe );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_CTHREADS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( lock_stripe != NULL )
+	{
+		libcthreads_lock_stripe_free(
+		 &lock_stripe,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_lock_stripe_free function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_lock_stripe_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libcthreads_lock_stripe_free(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_lock_stripe_grab_for_key and libcthreads_lock_stripe_release_for_key functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_lock_stripe_grab_for_key(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libcthreads_lock_stripe_t *lock_stripe = NULL;
+	int result                             = 0;
+	int stripe_index                       = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_lock_stripe_initialize(
+	          &lock_stripe,
+	          16,
+	          LIBCTHREADS_LOCK_STRIPE_FLAG_READ_WRITE,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_lock_stripe_get_index_for_key(
+	          lock_stripe,
+	          0x1234,
+	          &stripe_index,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_GREATER_THAN_INT(
+	 "stripe_index",
+	 stripe_index,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_LESS_THAN_INT(
+	 "stripe_index",
+	 stripe_index,
+	 16 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_stripe_grab_for_key(
+	          lock_stripe,
+	          0x1234,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_stripe_release_for_key(
+	          lock_stripe,
+	          0x1234,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Multiple readers can hold the same stripe
+	 */
+	result = libcthreads_lock_stripe_grab_for_key_for_read(
+	          lock_stripe,
+	          0x1234,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_stripe_grab_for_key_for_read(
+	          lock_stripe,
+	          0x1234,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_stripe_release_for_key_for_read(
+	          lock_stripe,
+	          0x1234,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_stripe_release_for_key_for_read(
+	          lock_stripe,
+	          0x1234,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_lock_stripe_get_index_for_key(
+	          NULL,
+	          0x1234,
+	          &stripe_index,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_lock_stripe_get_index_for_key(
+	          lock_stripe,
+	          0x1234,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_lock_stripe_grab_for_key(
+	          NULL,
+	          0x1234,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_lock_stripe_release_for_key(
+	          NULL,
+	          0x1234,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_lock_stripe_free(
+	          &lock_stripe,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( lock_stripe != NULL )
+	{
+		libcthreads_lock_stripe_free(
+		 &lock_stripe,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_lock_stripe_grab_multiple and libcthreads_lock_stripe_release_multiple functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_lock_stripe_grab_multiple(
+     void )
+{
+	int thread_numbers[ CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_THREADS ];
+	libcthreads_thread_t *threads[ CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_THREADS ];
+	uint64_t key_hashes[ 64 ];
+
+	libcerror_error_t *error = NULL;
+	int key_hash_index       = 0;
+	int result               = 0;
+	int sum_of_values        = 0;
+	int thread_index         = 0;
+
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		threads[ thread_index ] = NULL;
+	}
+	for( key_hash_index = 0;
+	     key_hash_index < CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_KEYS;
+	     key_hash_index++ )
+	{
+		cthreads_test_lock_stripe_values[ key_hash_index ] = 0;
+	}
+	/* Initialize test
+	 */
+	result = libcthreads_lock_stripe_initialize(
+	          &cthreads_test_lock_stripe,
+	          4,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		thread_numbers[ thread_index ] = thread_index;
+
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          &cthreads_test_lock_stripe_callback_function,
+		          (void *) &( thread_numbers[ thread_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( key_hash_index = 0;
+	     key_hash_index < CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_KEYS;
+	     key_hash_index++ )
+	{
+		sum_of_values += cthreads_test_lock_stripe_values[ key_hash_index ];
+	}
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "sum_of_values",
+	 sum_of_values,
+	 0 );
+
+	/* Test more key hashes than can be sorted without allocating memory
+	 */
+	for( key_hash_index = 0;
+	     key_hash_index < 64;
+	     key_hash_index++ )
+	{
+		key_hashes[ key_hash_index ] = (uint64_t) ( 63 - key_hash_index );
+	}
+	result = libcthreads_lock_stripe_grab_multiple(
+	          cthreads_test_lock_stripe,
+	          key_hashes,
+	          64,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_stripe_release_multiple(
+	          cthreads_test_lock_stripe,
+	          key_hashes,
+	          64,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_lock_stripe_grab_multiple(
+	          NULL,
+	          key_hashes,
+	          2,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_lock_stripe_grab_multiple(
+	          cthreads_test_lock_stripe,
+	          NULL,
+	          2,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_lock_stripe_grab_multiple(
+	          cthreads_test_lock_stripe,
+	          key_hashes,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_lock_stripe_release_multiple(
+	          NULL,
+	          key_hashes,
+	          2,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_lock_stripe_free(
+	          &cthreads_test_lock_stripe,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_LOCK_STRIPE_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	if( cthreads_test_lock_stripe != NULL )
+	{
+		libcthreads_lock_stripe_free(
+		 &cthreads_test_lock_stripe,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_stripe_initialize",
+	 cthreads_test_lock_stripe_initialize );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_stripe_free",
+	 cthreads_test_lock_stripe_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_stripe_grab_for_key",
+	 cthreads_test_lock_stripe_grab_for_key );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_stripe_grab_multiple",
+	 cthreads_test_lock_stripe_grab_multiple );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,659 @@
+/*
+ * Library lock validator functions test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_memory.h"
+#include "cthreads_test_unused.h"
+
+/* Counts the lock order reports without printing them
+ */
+void cthreads_test_lock_validator_report_function(
+      const char *report CTHREADS_TEST_ATTRIBUTE_UNUSED,
+      void *arguments )
+{
+	int *number_of_reports = (int *) arguments;
+
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( report )
+
+	if( number_of_reports != NULL )
+	{
+		*number_of_reports += 1;
+	}
+}
+
+/* Grabs two mutexes in order and releases them
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_lock_validator_grab_in_order(
+     libcthreads_mutex_t *first_mutex,
+     libcthreads_mutex_t *second_mutex,
+     libcerror_error_t **error )
+{
+	if( libcthreads_mutex_grab(
+	     first_mutex,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     second_mutex,
+	     error ) != 1 )
+	{
+		libcthreads_mutex_release(
+		 first_mutex,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_release(
+	     second_mutex,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libcthreads_mutex_release(
+	     first_mutex,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Grabs two locks in order, the second one with a deadline, and releases them
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_lock_validator_grab_until_in_order(
+     libcthreads_lock_t *first_lock,
+     libcthreads_lock_t *second_lock,
+     libcerror_error_t **error )
+{
+	uint64_t deadline = 0;
+
+	if( libcthreads_clock_get_monotonic_time(
+	     &deadline,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	deadline += 1000000000UL;
+
+	if( libcthreads_lock_grab(
+	     first_lock,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libcthreads_lock_grab_until(
+	     second_lock,
+	     deadline,
+	     error ) != 1 )
+	{
+		libcthreads_lock_release(
+		 first_lock,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_lock_release(
+	     second_lock,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libcthreads_lock_release(
+	     first_lock,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libcthreads_lock_validator_set_report_function function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_lock_validator_set_report_function(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_reports    = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libcthreads_lock_validator_set_report_function(
+	          &cthreads_test_lock_validator_report_function,
+	          &number_of_reports,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_validator_set_report_function(
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_lock_validator_get_number_of_reports function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_lock_validator_get_number_of_reports(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_reports    = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libcthreads_lock_validator_get_number_of_reports(
+	          &number_of_reports,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_reports",
+	 number_of_reports,
+	 -1 );
+
+	/* Test error cases
+	 */
+	result = libcthreads_lock_validator_get_number_of_reports(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the detection of a lock order inversion
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_lock_validator_lock_order_inversion(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libcthreads_mutex_t *first_mutex   = NULL;
+	libcthreads_mutex_t *second_mutex  = NULL;
+	int expected_number_of_reports     = 0;
+	int initial_number_of_reports      = 0;
+	int number_of_callback_reports     = 0;
+	int number_of_reports              = 0;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_lock_validator_set_report_function(
+	          &cthreads_test_lock_validator_report_function,
+	          &number_of_callback_reports,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_validator_get_number_of_reports(
+	          &initial_number_of_reports,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_initialize(
+	          &first_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_initialize(
+	          &second_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = cthreads_test_lock_validator_grab_in_order(
+	          first_mutex,
+	          second_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Grabbing the mutexes in the reverse order is a potential deadlock
+	 * that is reported only the first time it is seen
+	 */
+	result = cthreads_test_lock_validator_grab_in_order(
+	          second_mutex,
+	          first_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = cthreads_test_lock_validator_grab_in_order(
+	          second_mutex,
+	          first_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	expected_number_of_reports = 1;
+#endif
+	result = libcthreads_lock_validator_get_number_of_reports(
+	          &number_of_reports,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_reports",
+	 number_of_reports - initial_number_of_reports,
+	 expected_number_of_reports );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_callback_reports",
+	 number_of_callback_reports,
+	 expected_number_of_reports );
+
+	/* Clean up
+	 */
+	result = libcthreads_mutex_free(
+	          &second_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_free(
+	          &first_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_validator_set_report_function(
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( second_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &second_mutex,
+		 NULL );
+	}
+	if( first_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &first_mutex,
+		 NULL );
+	}
+	libcthreads_lock_validator_set_report_function(
+	 NULL,
+	 NULL,
+	 NULL );
+
+	return( 0 );
+}
+
+/* Tests the detection of a lock order inversion by a grab with a deadline
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_lock_validator_timed_lock_order_inversion(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libcthreads_lock_t *first_lock    = NULL;
+	libcthreads_lock_t *second_lock   = NULL;
+	int expected_number_of_reports    = 0;
+	int initial_number_of_reports     = 0;
+	int number_of_reports             = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_lock_validator_get_number_of_reports(
+	          &initial_number_of_reports,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_initialize(
+	          &first_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_initialize(
+	          &second_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = cthreads_test_lock_validator_grab_until_in_order(
+	          first_lock,
+	          second_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A grab with a deadline in the reverse order is validated as well
+	 */
+	result = cthreads_test_lock_validator_grab_until_in_order(
+	          second_lock,
+	          first_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_LIBCTHREADS_LOCK_VALIDATION )
+	expected_number_of_reports = 1;
+#endif
+	result = libcthreads_lock_validator_get_number_of_reports(
+	          &number_of_reports,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_reports",
+	 number_of_reports - initial_number_of_reports,
+	 expected_number_of_reports );
+
+	/* Clean up
+	 */
+	result = libcthreads_lock_free(
+	          &second_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_free(
+	          &first_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( second_lock != NULL )
+	{
+		libcthreads_lock_free(
+		 &second_lock,
+		 NULL );
+	}
+	if( first_lock != NULL )
+	{
+		libcthreads_lock_free(
+		 &first_lock,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_validator_set_report_function",
+	 cthreads_test_lock_validator_set_report_function );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_validator_get_number_of_reports",
+	 cthreads_test_lock_validator_get_number_of_reports );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_validator_lock_order_inversion",
+	 cthreads_test_lock_validator_lock_order_inversion );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_lock_validator_timed_lock_order_inversion",
+	 cthreads_test_lock_validator_timed_lock_order_inversion );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -92,6 +92,13 @@
 		goto on_error; \
 	}
 
+#define CTHREADS_TEST_ASSERT_NOT_EQUAL_SIZE( name, value, expected_value ) \
+	if( value == expected_value ) \
+	{ \
+		fprintf( stdout, "%s:%d %s (%" PRIzu ") == %" PRIzu "\n", __FILE__, __LINE__, name, value, expected_value ); \
+		goto on_error; \
+	}
+
 #define CTHREADS_TEST_ASSERT_EQUAL_SSIZE( name, value, expected_value ) \
 	if( value != expected_value ) \
 	{ \
@@ -0,0 +1,782 @@
+/*
+ * Library MPSC queue type test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_memory.h"
+#include "cthreads_test_unused.h"
+
+#define CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_OBJECTS	1000
+#define CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_THREADS	4
+
+typedef struct cthreads_test_mpsc_queue_object cthreads_test_mpsc_queue_object_t;
+
+struct cthreads_test_mpsc_queue_object
+{
+	/* The MPSC queue node, this must be the first member
+	 */
+	libcthreads_mpsc_queue_node_t node;
+
+	/* The number of the thread that pushed the object
+	 */
+	int thread_number;
+
+	/* The sequence number of the object within the thread
+	 */
+	int sequence_number;
+};
+
+libcthreads_mpsc_queue_t *cthreads_test_mpsc_queue = NULL;
+
+cthreads_test_mpsc_queue_object_t cthreads_test_mpsc_queue_objects[ CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_THREADS * CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_OBJECTS ];
+
+/* The MPSC queue callback function
+ * Pushes the objects of the thread
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_mpsc_queue_callback_function(
+     void *arguments )
+{
+	cthreads_test_mpsc_queue_object_t *object = NULL;
+	libcerror_error_t *error                  = NULL;
+	int *thread_number                        = NULL;
+	static char *function                     = "cthreads_test_mpsc_queue_callback_function";
+	int object_index                          = 0;
+	int result                                = 0;
+
+	thread_number = (int *) arguments;
+
+	for( object_index = 0;
+	     object_index < CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_OBJECTS;
+	     object_index++ )
+	{
+		object = &( cthreads_test_mpsc_queue_objects[ ( *thread_number * CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_OBJECTS ) + object_index ] );
+
+		object->thread_number   = *thread_number;
+		object->sequence_number = object_index;
+
+		result = libcthreads_mpsc_queue_push(
+		          cthreads_test_mpsc_queue,
+		          &( object->node ),
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push node.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Tests the libcthreads_mpsc_queue_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_mpsc_queue_initialize(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libcthreads_mpsc_queue_t *mpsc_queue = NULL;
+	int result                           = 0;
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+	int number_of_malloc_fail_tests      = 2;
+	int number_of_memset_fail_tests      = 2;
+	int test_number                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libcthreads_mpsc_queue_initialize(
+	          &mpsc_queue,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "mpsc_queue",
+	 mpsc_queue );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mpsc_queue_free(
+	          &mpsc_queue,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "mpsc_queue",
+	 mpsc_queue );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_mpsc_queue_initialize(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	mpsc_queue = (libcthreads_mpsc_queue_t *) 0x12345678UL;
+
+	result = libcthreads_mpsc_queue_initialize(
+	          &mpsc_queue,
+	          &error );
+
+	mpsc_queue = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_mpsc_queue_initialize with malloc failing
+		 */
+		cthreads_test_malloc_attempts_before_fail = test_number;
+
+		result = libcthreads_mpsc_queue_initialize(
+		          &mpsc_queue,
+		          &error );
+
+		if( cthreads_test_malloc_attempts_before_fail != -1 )
+		{
+			cthreads_test_malloc_attempts_before_fail = -1;
+
+			if( mpsc_queue != NULL )
+			{
+				libcthreads_mpsc_queue_free(
+				 &mpsc_queue,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "mpsc_queue",
+			 mpsc_queue );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_mpsc_queue_initialize with memset failing
+		 */
+		cthreads_test_memset_attempts_before_fail = test_number;
+
+		result = libcthreads_mpsc_queue_initialize(
+		          &mpsc_queue,
+		          &error );
+
+		if( cthreads_test_memset_attempts_before_fail != -1 )
+		{
+			cthreads_test_memset_attempts_before_fail = -1;
+
+			if( mpsc_queue != NULL )
+			{
+				libcthreads_mpsc_queue_free(
+				 &mpsc_queue,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "mpsc_queue",
+			 mpsc_queue );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_CTHREADS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( mpsc_queue != NULL )
+	{
+		libcthreads_mpsc_queue_free(
+		 &mpsc_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_mpsc_queue_free function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_mpsc_queue_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libcthreads_mpsc_queue_free(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_mpsc_queue_push and libcthreads_mpsc_queue_pop functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_mpsc_queue_push(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libcthreads_mpsc_queue_node_t *node  = NULL;
+	libcthreads_mpsc_queue_t *mpsc_queue = NULL;
+	int object_index                     = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_mpsc_queue_initialize(
+	          &mpsc_queue,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_mpsc_queue_pop(
+	          mpsc_queue,
+	          &node,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Push and pop the objects twice to reuse the stub node
+	 */
+	for( object_index = 0;
+	     object_index < 6;
+	     object_index++ )
+	{
+		cthreads_test_mpsc_queue_objects[ object_index % 3 ].sequence_number = object_index;
+
+		result = libcthreads_mpsc_queue_push(
+		          mpsc_queue,
+		          &( cthreads_test_mpsc_queue_objects[ object_index % 3 ].node ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( ( object_index % 3 ) != 2 )
+		{
+			continue;
+		}
+		result = libcthreads_mpsc_queue_pop(
+		          mpsc_queue,
+		          &node,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "sequence_number",
+		 ( (cthreads_test_mpsc_queue_object_t *) node )->sequence_number,
+		 object_index - 2 );
+
+		result = libcthreads_mpsc_queue_pop(
+		          mpsc_queue,
+		          &node,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "sequence_number",
+		 ( (cthreads_test_mpsc_queue_object_t *) node )->sequence_number,
+		 object_index - 1 );
+
+		result = libcthreads_mpsc_queue_pop(
+		          mpsc_queue,
+		          &node,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "sequence_number",
+		 ( (cthreads_test_mpsc_queue_object_t *) node )->sequence_number,
+		 object_index );
+
+		result = libcthreads_mpsc_queue_pop(
+		          mpsc_queue,
+		          &node,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libcthreads_mpsc_queue_push(
+	          NULL,
+	          &( cthreads_test_mpsc_queue_objects[ 0 ].node ),
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_mpsc_queue_push(
+	          mpsc_queue,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_mpsc_queue_pop(
+	          NULL,
+	          &node,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_mpsc_queue_pop(
+	          mpsc_queue,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_mpsc_queue_free(
+	          &mpsc_queue,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( mpsc_queue != NULL )
+	{
+		libcthreads_mpsc_queue_free(
+		 &mpsc_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_mpsc_queue functions with multiple threads
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_mpsc_queue_threads(
+     void )
+{
+	int next_sequence_numbers[ CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_THREADS ];
+	int thread_numbers[ CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_THREADS ];
+	libcthreads_thread_t *threads[ CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_THREADS ];
+
+	cthreads_test_mpsc_queue_object_t *object = NULL;
+	libcerror_error_t *error                  = NULL;
+	libcthreads_mpsc_queue_node_t *node       = NULL;
+	int number_of_objects                     = 0;
+	int result                                = 0;
+	int thread_index                          = 0;
+
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		next_sequence_numbers[ thread_index ] = 0;
+		threads[ thread_index ]               = NULL;
+	}
+	/* Initialize test
+	 */
+	result = libcthreads_mpsc_queue_initialize(
+	          &cthreads_test_mpsc_queue,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		thread_numbers[ thread_index ] = thread_index;
+
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          &cthreads_test_mpsc_queue_callback_function,
+		          (void *) &( thread_numbers[ thread_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The objects of every thread must be popped in the order they were pushed
+	 */
+	while( number_of_objects < ( CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_THREADS * CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_OBJECTS ) )
+	{
+		result = libcthreads_mpsc_queue_pop(
+		          cthreads_test_mpsc_queue,
+		          &node,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		if( result == 0 )
+		{
+			continue;
+		}
+		object = (cthreads_test_mpsc_queue_object_t *) node;
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "sequence_number",
+		 object->sequence_number,
+		 next_sequence_numbers[ object->thread_number ] );
+
+		next_sequence_numbers[ object->thread_number ] += 1;
+
+		number_of_objects++;
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcthreads_mpsc_queue_pop(
+	          cthreads_test_mpsc_queue,
+	          &node,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libcthreads_mpsc_queue_free(
+	          &cthreads_test_mpsc_queue,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_MPSC_QUEUE_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	if( cthreads_test_mpsc_queue != NULL )
+	{
+		libcthreads_mpsc_queue_free(
+		 &cthreads_test_mpsc_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_mpsc_queue_initialize",
+	 cthreads_test_mpsc_queue_initialize );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_mpsc_queue_free",
+	 cthreads_test_mpsc_queue_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_mpsc_queue_push",
+	 cthreads_test_mpsc_queue_push );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_mpsc_queue_threads",
+	 cthreads_test_mpsc_queue_threads );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -1491,6 +1491,373 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libcthreads_mutex_grab_fast, libcthreads_mutex_try_grab_fast and libcthreads_mutex_release_fast functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_mutex_fast(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	libcthreads_mutex_t *mutex = NULL;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_mutex_initialize(
+	          &mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_mutex_grab_fast(
+	          mutex );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_mutex_release_fast(
+	          mutex );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_mutex_try_grab_fast(
+	          mutex );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_mutex_release_fast(
+	          mutex );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+#if defined( HAVE_GNU_DL_DLSYM ) && defined( __GNUC__ ) && !defined( __clang__ ) && !defined( __CYGWIN__ )
+
+	/* Test libcthreads_mutex_grab_fast with pthread_mutex_lock returning EDEADLK
+	 */
+	cthreads_test_pthread_mutex_lock_attempts_before_fail       = 0;
+	cthreads_test_real_pthread_mutex_lock_function_return_value = EDEADLK;
+
+	result = libcthreads_mutex_grab_fast(
+	          mutex );
+
+	if( cthreads_test_pthread_mutex_lock_attempts_before_fail != -1 )
+	{
+		cthreads_test_pthread_mutex_lock_attempts_before_fail = -1;
+	}
+	else
+	{
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+	}
+	/* Test libcthreads_mutex_release_fast with pthread_mutex_unlock returning EBUSY
+	 */
+	cthreads_test_pthread_mutex_unlock_attempts_before_fail       = 0;
+	cthreads_test_real_pthread_mutex_unlock_function_return_value = EBUSY;
+
+	result = libcthreads_mutex_release_fast(
+	          mutex );
+
+	if( cthreads_test_pthread_mutex_unlock_attempts_before_fail != -1 )
+	{
+		cthreads_test_pthread_mutex_unlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+	}
+#endif /* defined( HAVE_GNU_DL_DLSYM ) && defined( __GNUC__ ) && !defined( __clang__ ) && !defined( __CYGWIN__ ) */
+
+	/* Clean up
+	 */
+	result = libcthreads_mutex_free(
+	          &mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &mutex,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_mutex_initialize_in_place and libcthreads_mutex_finalize_in_place functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_mutex_in_place(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	libcthreads_mutex_t *mutex = NULL;
+	libcthreads_mutex_storage_t storage;
+	int result                 = 0;
+
+	/* Test regular cases
+	 */
+	result = libcthreads_mutex_initialize_in_place(
+	          &mutex,
+	          &storage,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "mutex",
+	 mutex );
+
+	result = libcthreads_mutex_grab(
+	          mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_release(
+	          mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_finalize_in_place(
+	          &mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "mutex",
+	 mutex );
+
+	/* Test error cases
+	 */
+	result = libcthreads_mutex_initialize_in_place(
+	          NULL,
+	          &storage,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	mutex = (libcthreads_mutex_t *) 0x12345678UL;
+
+	result = libcthreads_mutex_initialize_in_place(
+	          &mutex,
+	          &storage,
+	          &error );
+
+	mutex = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_mutex_initialize_in_place(
+	          &mutex,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_mutex_finalize_in_place(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( mutex != NULL )
+	{
+		libcthreads_mutex_finalize_in_place(
+		 &mutex,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( LIBCTHREADS_HAVE_STATIC_INITIALIZERS )
+
+/* Tests a statically initialized mutex storage
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_mutex_static_initializer(
+     void )
+{
+	static libcthreads_mutex_storage_t storage = LIBCTHREADS_MUTEX_STORAGE_INITIALIZER;
+
+	libcerror_error_t *error   = NULL;
+	libcthreads_mutex_t *mutex = NULL;
+	int result                 = 0;
+
+	/* Test regular cases
+	 */
+	mutex = LIBCTHREADS_MUTEX_FROM_STORAGE( &storage );
+
+	result = libcthreads_mutex_grab(
+	          mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_release(
+	          mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_finalize_in_place(
+	          &mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( LIBCTHREADS_HAVE_STATIC_INITIALIZERS ) */
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -1526,6 +1893,22 @@ int main(
 	 "libcthreads_mutex_release",
 	 cthreads_test_mutex_release );
 
+	CTHREADS_TEST_RUN(
+	 "libcthreads_mutex_fast",
+	 cthreads_test_mutex_fast );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_mutex_initialize_in_place",
+	 cthreads_test_mutex_in_place );
+
+#if defined( LIBCTHREADS_HAVE_STATIC_INITIALIZERS )
+
+	CTHREADS_TEST_RUN(
+	 "LIBCTHREADS_MUTEX_STORAGE_INITIALIZER",
+	 cthreads_test_mutex_static_initializer );
+
+#endif /* defined( LIBCTHREADS_HAVE_STATIC_INITIALIZERS ) */
+
 	return( EXIT_SUCCESS );
 
 on_error:
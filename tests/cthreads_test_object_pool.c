@@ -0,0 +1,990 @@
+/*
+ * Library object pool type test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_memory.h"
+#include "cthreads_test_unused.h"
+
+#define CTHREADS_TEST_OBJECT_POOL_NUMBER_OF_OBJECTS	8
+
+libcthreads_object_pool_t *cthreads_test_object_pool                          = NULL;
+intptr_t *cthreads_test_objects[ CTHREADS_TEST_OBJECT_POOL_NUMBER_OF_OBJECTS ] = { NULL };
+
+/* The remote free callback function
+ * Frees the objects allocated by another thread
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_object_pool_remote_free_callback_function(
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "cthreads_test_object_pool_remote_free_callback_function";
+	int object_index         = 0;
+
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	for( object_index = 0;
+	     object_index < CTHREADS_TEST_OBJECT_POOL_NUMBER_OF_OBJECTS;
+	     object_index++ )
+	{
+		if( libcthreads_object_pool_free_object(
+		     cthreads_test_object_pool,
+		     cthreads_test_objects[ object_index ],
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free object: %d.",
+			 function,
+			 object_index );
+
+			goto on_error;
+		}
+		cthreads_test_objects[ object_index ] = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* The allocate callback function
+ * Allocates objects that remain allocated when the thread exits
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_object_pool_allocate_callback_function(
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	intptr_t *object         = NULL;
+	static char *function    = "cthreads_test_object_pool_allocate_callback_function";
+	int object_index         = 0;
+
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	for( object_index = 0;
+	     object_index < CTHREADS_TEST_OBJECT_POOL_NUMBER_OF_OBJECTS;
+	     object_index++ )
+	{
+		if( libcthreads_object_pool_allocate_object(
+		     cthreads_test_object_pool,
+		     24,
+		     &object,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to allocate object: %d.",
+			 function,
+			 object_index );
+
+			goto on_error;
+		}
+		*object = (intptr_t) object_index;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Tests the libcthreads_object_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_object_pool_initialize(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libcthreads_object_pool_t *object_pool = NULL;
+	int result                             = 0;
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+	int number_of_malloc_fail_tests        = 2;
+	int number_of_memset_fail_tests        = 1;
+	int test_number                        = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libcthreads_object_pool_initialize(
+	          &object_pool,
+	          256,
+	          8,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "object_pool",
+	 object_pool );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_object_pool_free(
+	          &object_pool,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "object_pool",
+	 object_pool );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_object_pool_initialize(
+	          NULL,
+	          256,
+	          8,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	object_pool = (libcthreads_object_pool_t *) 0x12345678UL;
+
+	result = libcthreads_object_pool_initialize(
+	          &object_pool,
+	          256,
+	          8,
+	          &error );
+
+	object_pool = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_object_pool_initialize(
+	          &object_pool,
+	          0,
+	          8,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_object_pool_initialize(
+	          &object_pool,
+	          (size_t) 16 * 1024 * 1024,
+	          8,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_object_pool_initialize(
+	          &object_pool,
+	          256,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_object_pool_initialize with malloc failing
+		 */
+		cthreads_test_malloc_attempts_before_fail = test_number;
+
+		result = libcthreads_object_pool_initialize(
+		          &object_pool,
+		          256,
+		          8,
+		          &error );
+
+		if( cthreads_test_malloc_attempts_before_fail != -1 )
+		{
+			cthreads_test_malloc_attempts_before_fail = -1;
+
+			if( object_pool != NULL )
+			{
+				libcthreads_object_pool_free(
+				 &object_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "object_pool",
+			 object_pool );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_object_pool_initialize with memset failing
+		 */
+		cthreads_test_memset_attempts_before_fail = test_number;
+
+		result = libcthreads_object_pool_initialize(
+		          &object_pool,
+		          256,
+		          8,
+		          &error );
+
+		if( cthreads_test_memset_attempts_before_fail != -1 )
+		{
+			cthreads_test_memset_attempts_before_fail = -1;
+
+			if( object_pool != NULL )
+			{
+				libcthreads_object_pool_free(
+				 &object_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "object_pool",
+			 object_pool );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_CTHREADS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( object_pool != NULL )
+	{
+		libcthreads_object_pool_free(
+		 &object_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_object_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_object_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libcthreads_object_pool_free(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_object_pool_allocate_object and libcthreads_object_pool_free_object functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_object_pool_allocate_object(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libcthreads_object_pool_t *object_pool       = NULL;
+	libcthreads_object_pool_t *other_object_pool = NULL;
+	intptr_t *first_object                       = NULL;
+	intptr_t *object                             = NULL;
+	intptr_t *second_object                      = NULL;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_object_pool_initialize(
+	          &object_pool,
+	          256,
+	          8,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "object_pool",
+	 object_pool );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_object_pool_allocate_object(
+	          object_pool,
+	          1,
+	          &first_object,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "first_object",
+	 first_object );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "first_object alignment",
+	 (int) ( (intptr_t) first_object % 16 ),
+	 0 );
+
+	result = libcthreads_object_pool_allocate_object(
+	          object_pool,
+	          256,
+	          &second_object,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "second_object",
+	 second_object );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "second_object alignment",
+	 (int) ( (intptr_t) second_object % 16 ),
+	 0 );
+
+	/* The whole size class is usable
+	 */
+	( (uint8_t *) second_object )[ 0 ]   = 0xff;
+	( (uint8_t *) second_object )[ 255 ] = 0xff;
+
+	result = libcthreads_object_pool_free_object(
+	          object_pool,
+	          first_object,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A freed object is reused by the next allocation of the same size class
+	 */
+	result = libcthreads_object_pool_allocate_object(
+	          object_pool,
+	          16,
+	          &object,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "object",
+	 (int) ( object == first_object ),
+	 1 );
+
+	result = libcthreads_object_pool_free_object(
+	          object_pool,
+	          object,
+	          &error );
+
+	first_object = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	object = NULL;
+
+	result = libcthreads_object_pool_allocate_object(
+	          NULL,
+	          16,
+	          &object,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_object_pool_allocate_object(
+	          object_pool,
+	          257,
+	          &object,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_object_pool_allocate_object(
+	          object_pool,
+	          16,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_object_pool_free_object(
+	          NULL,
+	          second_object,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_object_pool_free_object(
+	          object_pool,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_object_pool_initialize(
+	          &other_object_pool,
+	          256,
+	          8,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_object_pool_free_object(
+	          other_object_pool,
+	          second_object,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_object_pool_free(
+	          &other_object_pool,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 * Objects that are still allocated are freed with the object pool
+	 */
+	result = libcthreads_object_pool_free(
+	          &object_pool,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "object_pool",
+	 object_pool );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( other_object_pool != NULL )
+	{
+		libcthreads_object_pool_free(
+		 &other_object_pool,
+		 NULL );
+	}
+	if( object_pool != NULL )
+	{
+		libcthreads_object_pool_free(
+		 &object_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests freeing objects from a thread other than the one that allocated them
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_object_pool_remote_free_object(
+     void )
+{
+	libcerror_error_t *error     = NULL;
+	libcthreads_thread_t *thread = NULL;
+	intptr_t *object             = NULL;
+	int object_index             = 0;
+	int result                   = 0;
+	int thread_index             = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_object_pool_initialize(
+	          &cthreads_test_object_pool,
+	          64,
+	          CTHREADS_TEST_OBJECT_POOL_NUMBER_OF_OBJECTS,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( object_index = 0;
+	     object_index < CTHREADS_TEST_OBJECT_POOL_NUMBER_OF_OBJECTS;
+	     object_index++ )
+	{
+		result = libcthreads_object_pool_allocate_object(
+		          cthreads_test_object_pool,
+		          64,
+		          &( cthreads_test_objects[ object_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libcthreads_thread_create(
+	          &thread,
+	          NULL,
+	          cthreads_test_object_pool_remote_free_callback_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_join(
+	          &thread,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( object_index = 0;
+	     object_index < CTHREADS_TEST_OBJECT_POOL_NUMBER_OF_OBJECTS;
+	     object_index++ )
+	{
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "cthreads_test_objects[ object_index ]",
+		 cthreads_test_objects[ object_index ] );
+	}
+	/* The objects freed by the other thread are returned to this thread
+	 * on the next allocation instead of a new slab being allocated
+	 */
+	result = libcthreads_object_pool_allocate_object(
+	          cthreads_test_object_pool,
+	          64,
+	          &object,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_object_pool_free_object(
+	          cthreads_test_object_pool,
+	          object,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Objects allocated by a thread that exited remain valid
+	 * and its thread cache is adopted by the next thread
+	 */
+	for( thread_index = 0;
+	     thread_index < 2;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_create(
+		          &thread,
+		          NULL,
+		          cthreads_test_object_pool_allocate_callback_function,
+		          NULL,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_thread_join(
+		          &thread,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Clean up
+	 */
+	result = libcthreads_object_pool_free(
+	          &cthreads_test_object_pool,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread != NULL )
+	{
+		libcthreads_thread_join(
+		 &thread,
+		 NULL );
+	}
+	if( cthreads_test_object_pool != NULL )
+	{
+		libcthreads_object_pool_free(
+		 &cthreads_test_object_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_object_pool_initialize",
+	 cthreads_test_object_pool_initialize );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_object_pool_free",
+	 cthreads_test_object_pool_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_object_pool_allocate_object",
+	 cthreads_test_object_pool_allocate_object );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_object_pool_free_object",
+	 cthreads_test_object_pool_remote_free_object );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
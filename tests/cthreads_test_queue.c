@@ -30,6 +30,10 @@
 
 #include <errno.h>
 
+#if defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI )
+#include <poll.h>
+#endif
+
 #if defined( HAVE_GNU_DL_DLSYM ) && defined( __GNUC__ ) && !defined( __clang__ ) && !defined( __CYGWIN__ )
 #define __USE_GNU
 #include <dlfcn.h>
@@ -732,6 +736,262 @@ on_error:
 	return( 0 );
 }
 
+#if defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI )
+
+/* Tests the libcthreads_queue_get_readiness_file_descriptor function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_queue_get_readiness_file_descriptor(
+     void )
+{
+	struct pollfd poll_file_descriptor;
+
+	libcerror_error_t *error   = NULL;
+	libcthreads_queue_t *queue = NULL;
+	intptr_t *value            = NULL;
+	int file_descriptor        = -1;
+	int queued_value1          = 1;
+	int queued_value2          = 2;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_queue_initialize(
+	          &queue,
+	          10,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "queue",
+	 queue );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_queue_push(
+	          queue,
+	          (intptr_t *) &queued_value1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_queue_get_readiness_file_descriptor(
+	          queue,
+	          &file_descriptor,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_NOT_EQUAL_INT(
+	 "file_descriptor",
+	 file_descriptor,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	poll_file_descriptor.fd     = file_descriptor;
+	poll_file_descriptor.events = POLLIN;
+
+	/* Test that a queue that already contains values is readable
+	 */
+	result = poll(
+	          &poll_file_descriptor,
+	          1,
+	          0 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_queue_push(
+	          queue,
+	          (intptr_t *) &queued_value2,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_queue_pop(
+	          queue,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a queue that still contains values remains readable
+	 */
+	result = poll(
+	          &poll_file_descriptor,
+	          1,
+	          0 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_queue_try_pop(
+	          queue,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that an empty queue is not readable
+	 */
+	result = poll(
+	          &poll_file_descriptor,
+	          1,
+	          0 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libcthreads_queue_try_push(
+	          queue,
+	          (intptr_t *) &queued_value1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the empty to non-empty transition makes the queue readable
+	 */
+	result = poll(
+	          &poll_file_descriptor,
+	          1,
+	          0 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libcthreads_queue_get_readiness_file_descriptor(
+	          NULL,
+	          &file_descriptor,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_queue_get_readiness_file_descriptor(
+	          queue,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_queue_free(
+	          &queue,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "queue",
+	 queue );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &queue,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI ) */
+
 /* Tests the libcthreads_queue_try_pop function
  * Returns 1 if successful or 0 if not
  */
@@ -2205,35 +2465,773 @@ on_error:
 	return( 0 );
 }
 
-/* The main program
+/* Tests the libcthreads_queue_push_value_data and libcthreads_queue_pop_value_data functions
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
-     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
-#else
-int main(
-     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
-     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
-#endif
+int cthreads_test_queue_push_value_data(
+     void )
 {
-	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
-	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
-
-	CTHREADS_TEST_RUN(
-	 "libcthreads_queue_initialize",
-	 cthreads_test_queue_initialize );
+	uint8_t data[ 32 ];
+	uint8_t value_data[ 48 ];
 
-	CTHREADS_TEST_RUN(
-	 "libcthreads_queue_free",
-	 cthreads_test_queue_free );
+	libcerror_error_t *error   = NULL;
+	libcthreads_queue_t *queue = NULL;
+	intptr_t *value            = NULL;
+	int result                 = 0;
 
-	CTHREADS_TEST_RUN(
-	 "libcthreads_queue_empty",
-	 cthreads_test_queue_empty );
+	/* Initialize test
+	 */
+	result = libcthreads_queue_initialize_with_value_size(
+	          &queue,
+	          2,
+	          32,
+	          &error );
 
-	CTHREADS_TEST_RUN(
-	 "libcthreads_queue_try_pop",
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "queue",
+	 queue );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "value slots alignment",
+	 (int) ( (intptr_t) ( (libcthreads_internal_queue_t *) queue )->value_slots_data % 64 ),
+	 0 );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_queue_try_pop_value_data(
+	          queue,
+	          data,
+	          32,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 value_data,
+	 'A',
+	 32 );
+
+	result = libcthreads_queue_push_value_data(
+	          queue,
+	          value_data,
+	          32,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 value_data,
+	 'B',
+	 32 );
+
+	result = libcthreads_queue_try_push_value_data(
+	          queue,
+	          value_data,
+	          16,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_queue_try_push_value_data(
+	          queue,
+	          value_data,
+	          16,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_queue_pop_value_data(
+	          queue,
+	          data,
+	          32,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "data[ 31 ]",
+	 (int) data[ 31 ],
+	 (int) 'A' );
+
+	result = libcthreads_queue_try_pop_value_data(
+	          queue,
+	          data,
+	          32,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "data[ 15 ]",
+	 (int) data[ 15 ],
+	 (int) 'B' );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "data[ 16 ]",
+	 (int) data[ 16 ],
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libcthreads_queue_push_value_data(
+	          NULL,
+	          value_data,
+	          32,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_queue_push_value_data(
+	          queue,
+	          NULL,
+	          32,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_queue_push_value_data(
+	          queue,
+	          value_data,
+	          48,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_queue_pop_value_data(
+	          NULL,
+	          data,
+	          32,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_queue_pop_value_data(
+	          queue,
+	          NULL,
+	          32,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test that the pointer functions are not supported by a queue that stores values inline
+	 */
+	result = libcthreads_queue_try_pop(
+	          queue,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_queue_free(
+	          &queue,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "queue",
+	 queue );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &queue,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_queue_pop_value_view and libcthreads_queue_release_value_view functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_queue_pop_value_view(
+     void )
+{
+	uint8_t value_data[ 8 ];
+
+	libcerror_error_t *error   = NULL;
+	libcthreads_queue_t *queue = NULL;
+	const uint8_t *view1       = NULL;
+	const uint8_t *view2       = NULL;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_queue_initialize_with_value_size(
+	          &queue,
+	          2,
+	          8,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	value_data[ 0 ] = 1;
+
+	result = libcthreads_queue_push_value_data(
+	          queue,
+	          value_data,
+	          8,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	value_data[ 0 ] = 2;
+
+	result = libcthreads_queue_push_value_data(
+	          queue,
+	          value_data,
+	          8,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_queue_pop_value_view(
+	          queue,
+	          &view1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "view1",
+	 view1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "view1[ 0 ]",
+	 (int) view1[ 0 ],
+	 1 );
+
+	result = libcthreads_queue_pop_value_view(
+	          queue,
+	          &view2,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "view2[ 0 ]",
+	 (int) view2[ 0 ],
+	 2 );
+
+	/* Test that a value slot is not reused while an earlier view is still in use
+	 */
+	result = libcthreads_queue_release_value_view(
+	          queue,
+	          view2,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_queue_try_push_value_data(
+	          queue,
+	          value_data,
+	          8,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "view1[ 0 ]",
+	 (int) view1[ 0 ],
+	 1 );
+
+	result = libcthreads_queue_release_value_view(
+	          queue,
+	          view1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_queue_try_push_value_data(
+	          queue,
+	          value_data,
+	          8,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_queue_pop_value_view(
+	          NULL,
+	          &view1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_queue_pop_value_view(
+	          queue,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_queue_release_value_view(
+	          NULL,
+	          view1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test releasing a view that is not in use
+	 */
+	result = libcthreads_queue_release_value_view(
+	          queue,
+	          view1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_queue_release_value_view(
+	          queue,
+	          value_data,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_queue_free(
+	          &queue,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &queue,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_queue_push_fast and libcthreads_queue_pop_fast functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_queue_fast(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	libcthreads_queue_t *queue = NULL;
+	intptr_t *value            = NULL;
+	int queued_value1          = 1;
+	int queued_value2          = 2;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_queue_initialize(
+	          &queue,
+	          10,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "queue",
+	 queue );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_queue_push_fast(
+	          queue,
+	          (intptr_t *) &queued_value1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_queue_push_fast(
+	          queue,
+	          (intptr_t *) &queued_value2 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_queue_pop_fast(
+	          queue,
+	          &value );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "value",
+	 value );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "*value",
+	 *( (int *) value ),
+	 1 );
+
+	result = libcthreads_queue_pop_fast(
+	          queue,
+	          &value );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "value",
+	 value );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "*value",
+	 *( (int *) value ),
+	 2 );
+
+	/* Clean up
+	 */
+	result = libcthreads_queue_free(
+	          &queue,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "queue",
+	 queue );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &queue,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_queue_initialize",
+	 cthreads_test_queue_initialize );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_queue_free",
+	 cthreads_test_queue_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_queue_empty",
+	 cthreads_test_queue_empty );
+
+#if defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_queue_get_readiness_file_descriptor",
+	 cthreads_test_queue_get_readiness_file_descriptor );
+
+#endif /* defined( HAVE_SYS_EVENTFD_H ) && !defined( WINAPI ) */
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_queue_try_pop",
 	 cthreads_test_queue_try_pop );
 
 	CTHREADS_TEST_RUN(
@@ -2252,6 +3250,18 @@ int main(
 	 "libcthreads_queue_push_sorted",
 	 cthreads_test_queue_push_sorted );
 
+	CTHREADS_TEST_RUN(
+	 "libcthreads_queue_push_value_data",
+	 cthreads_test_queue_push_value_data );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_queue_pop_value_view",
+	 cthreads_test_queue_pop_value_view );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_queue_fast",
+	 cthreads_test_queue_fast );
+
 	CTHREADS_TEST_RUN(
 	 "cthreads_test_queue_push_pop_threaded",
 	 cthreads_test_queue_push_pop_threaded );
@@ -65,6 +65,7 @@ int cthreads_test_real_pthread_rwlock_unlock_function_return_value
 
 libcthreads_read_write_lock_t *cthreads_test_read_write_lock = NULL;
 int cthreads_test_locked_value                               = 0;
+int cthreads_test_try_grab_results[ 4 ]                      = { 0, 0, 0, 0 };
 
 #if defined( HAVE_GNU_DL_DLSYM ) && defined( __GNUC__ ) && !defined( __clang__ ) && !defined( __CYGWIN__ )
 
@@ -459,6 +460,182 @@ on_error:
 	return( -1 );
 }
 
+/* The cthreads_test_read_write_lock_grab_for_upgrade thread callback function
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_read_write_lock_grab_for_upgrade_callback_function(
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "cthreads_test_read_write_lock_grab_for_upgrade_callback_function";
+	int result               = 0;
+
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	result = libcthreads_read_write_lock_grab_for_upgrade(
+	          cthreads_test_read_write_lock,
+	          &error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	result = libcthreads_read_write_lock_upgrade_to_write(
+	          cthreads_test_read_write_lock,
+	          &error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to upgrade read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	cthreads_test_locked_value += 19;
+
+	result = libcthreads_read_write_lock_release_for_write(
+		  cthreads_test_read_write_lock,
+		  &error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* The cthreads_test_read_write_lock_try_grab thread callback function
+ * Stores the results of the try and timed grabs and releases the read/write lock if grabbed
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_read_write_lock_try_grab_callback_function(
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "cthreads_test_read_write_lock_try_grab_callback_function";
+	int grab_index           = 0;
+	int result               = 0;
+
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	for( grab_index = 0;
+	     grab_index < 4;
+	     grab_index++ )
+	{
+		switch( grab_index )
+		{
+			case 0:
+				result = libcthreads_read_write_lock_try_grab_for_read(
+				          cthreads_test_read_write_lock,
+				          &error );
+				break;
+
+			case 1:
+				result = libcthreads_read_write_lock_timed_grab_for_read(
+				          cthreads_test_read_write_lock,
+				          1000000,
+				          &error );
+				break;
+
+			case 2:
+				result = libcthreads_read_write_lock_try_grab_for_write(
+				          cthreads_test_read_write_lock,
+				          &error );
+				break;
+
+			case 3:
+				result = libcthreads_read_write_lock_timed_grab_for_write(
+				          cthreads_test_read_write_lock,
+				          1000000,
+				          &error );
+				break;
+		}
+		cthreads_test_try_grab_results[ grab_index ] = result;
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to try grab read/write lock.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		if( grab_index < 2 )
+		{
+			result = libcthreads_read_write_lock_release_for_read(
+			          cthreads_test_read_write_lock,
+			          &error );
+		}
+		else
+		{
+			result = libcthreads_read_write_lock_release_for_write(
+			          cthreads_test_read_write_lock,
+			          &error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
 /* Tests the libcthreads_read_write_lock_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -1717,44 +1894,1287 @@ on_error:
 	return( 0 );
 }
 
-/* The main program
+/* Tests the libcthreads_read_write_lock_initialize_in_place and libcthreads_read_write_lock_finalize_in_place functions
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
-     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
-#else
-int main(
-     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
-     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
-#endif
+int cthreads_test_read_write_lock_in_place(
+     void )
 {
-	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
-	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+	libcerror_error_t *error                       = NULL;
+	libcthreads_read_write_lock_t *read_write_lock = NULL;
+	libcthreads_read_write_lock_storage_t storage;
+	int result                                     = 0;
 
-	CTHREADS_TEST_RUN(
-	 "libcthreads_read_write_lock_initialize",
-	 cthreads_test_read_write_lock_initialize );
+	/* Test regular cases
+	 */
+	result = libcthreads_read_write_lock_initialize_in_place(
+	          &read_write_lock,
+	          &storage,
+	          &error );
 
-	CTHREADS_TEST_RUN(
-	 "libcthreads_read_write_lock_free",
-	 cthreads_test_read_write_lock_free );
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	CTHREADS_TEST_RUN(
-	 "libcthreads_read_write_lock_grab_for_read",
-	 cthreads_test_read_write_lock_grab_for_read );
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	CTHREADS_TEST_RUN(
-	 "libcthreads_read_write_lock_grab_for_write",
-	 cthreads_test_read_write_lock_grab_for_write );
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "read_write_lock",
+	 read_write_lock );
 
-	CTHREADS_TEST_RUN(
-	 "libcthreads_read_write_lock_release_for_read",
-	 cthreads_test_read_write_lock_release_for_read );
+	result = libcthreads_read_write_lock_grab_for_write(
+	          read_write_lock,
+	          &error );
 
-	CTHREADS_TEST_RUN(
-	 "libcthreads_read_write_lock_release_for_write",
-	 cthreads_test_read_write_lock_release_for_write );
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_read_write_lock_release_for_write(
+	          read_write_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_read_write_lock_finalize_in_place(
+	          &read_write_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "read_write_lock",
+	 read_write_lock );
+
+	/* Test error cases
+	 */
+	result = libcthreads_read_write_lock_initialize_in_place(
+	          NULL,
+	          &storage,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_write_lock = (libcthreads_read_write_lock_t *) 0x12345678UL;
+
+	result = libcthreads_read_write_lock_initialize_in_place(
+	          &read_write_lock,
+	          &storage,
+	          &error );
+
+	read_write_lock = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_read_write_lock_initialize_in_place(
+	          &read_write_lock,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_read_write_lock_finalize_in_place(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_write_lock != NULL )
+	{
+		libcthreads_read_write_lock_finalize_in_place(
+		 &read_write_lock,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_read_write_lock_initialize_with_policy function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_read_write_lock_initialize_with_policy(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libcthreads_read_write_lock_t *read_write_lock = NULL;
+	libcthreads_read_write_lock_storage_t storage;
+	int policy                                     = 0;
+	int result                                     = 0;
+	int test_policy                                = 0;
+
+	/* Test regular cases
+	 */
+	for( test_policy = LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT;
+	     test_policy <= LIBCTHREADS_READ_WRITE_LOCK_POLICY_FAIR;
+	     test_policy++ )
+	{
+		result = libcthreads_read_write_lock_initialize_with_policy(
+		          &read_write_lock,
+		          test_policy,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+		 "read_write_lock",
+		 read_write_lock );
+
+		result = libcthreads_read_write_lock_get_policy(
+		          read_write_lock,
+		          &policy,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "policy",
+		 policy,
+		 test_policy );
+
+		result = libcthreads_read_write_lock_grab_for_read(
+		          read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_grab_for_read(
+		          read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_release_for_read(
+		          read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_release_for_read(
+		          read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_grab_for_write(
+		          read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_release_for_write(
+		          read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_free(
+		          &read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_initialize_in_place_with_policy(
+		          &read_write_lock,
+		          &storage,
+		          test_policy,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_grab_for_write(
+		          read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_release_for_write(
+		          read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_finalize_in_place(
+		          &read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libcthreads_read_write_lock_initialize_with_policy(
+	          &read_write_lock,
+	          -1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "read_write_lock",
+	 read_write_lock );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_read_write_lock_initialize_in_place_with_policy(
+	          &read_write_lock,
+	          &storage,
+	          LIBCTHREADS_READ_WRITE_LOCK_POLICY_FAIR + 1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "read_write_lock",
+	 read_write_lock );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_read_write_lock_get_policy(
+	          NULL,
+	          &policy,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_write_lock != NULL )
+	{
+		libcthreads_read_write_lock_free(
+		 &read_write_lock,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_read_write_lock_grab_for_upgrade function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_read_write_lock_grab_for_upgrade(
+     void )
+{
+	libcerror_error_t *error     = NULL;
+	libcthreads_thread_t *thread = NULL;
+	int result                   = 0;
+	int test_policy              = 0;
+
+	for( test_policy = LIBCTHREADS_READ_WRITE_LOCK_POLICY_PREFER_READERS;
+	     test_policy <= LIBCTHREADS_READ_WRITE_LOCK_POLICY_FAIR;
+	     test_policy++ )
+	{
+		/* Initialize test
+		 */
+		result = libcthreads_read_write_lock_initialize_with_policy(
+		          &cthreads_test_read_write_lock,
+		          test_policy,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test upgrade and release
+		 */
+		result = libcthreads_read_write_lock_grab_for_upgrade(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_release_for_upgrade(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test upgrade while the read/write lock is grabbed for reading
+		 */
+		result = libcthreads_read_write_lock_grab_for_read(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_thread_create(
+		          &thread,
+		          NULL,
+		          cthreads_test_read_write_lock_grab_for_upgrade_callback_function,
+		          NULL,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		cthreads_test_locked_value = 46;
+
+		result = libcthreads_read_write_lock_release_for_read(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_thread_join(
+		          &thread,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "cthreads_test_locked_value",
+		 cthreads_test_locked_value,
+		 46 + 19 );
+
+		/* Test error cases
+		 */
+		result = libcthreads_read_write_lock_upgrade_to_write(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libcthreads_read_write_lock_release_for_upgrade(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		/* Clean up
+		 */
+		result = libcthreads_read_write_lock_free(
+		          &cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libcthreads_read_write_lock_grab_for_upgrade(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test grab for upgrade with the default policy
+	 */
+	result = libcthreads_read_write_lock_initialize(
+	          &cthreads_test_read_write_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_read_write_lock_grab_for_upgrade(
+	          cthreads_test_read_write_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_read_write_lock_free(
+	          &cthreads_test_read_write_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread != NULL )
+	{
+		libcthreads_thread_join(
+		 &thread,
+		 NULL );
+	}
+	if( cthreads_test_read_write_lock != NULL )
+	{
+		libcthreads_read_write_lock_free(
+		 &cthreads_test_read_write_lock,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_read_write_lock_try_grab_for_read, libcthreads_read_write_lock_try_grab_for_write,
+ * libcthreads_read_write_lock_timed_grab_for_read and libcthreads_read_write_lock_timed_grab_for_write functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_read_write_lock_try_grab(
+     void )
+{
+	libcerror_error_t *error     = NULL;
+	libcthreads_thread_t *thread = NULL;
+	int grab_index               = 0;
+	int result                   = 0;
+	int test_policy              = 0;
+
+	for( test_policy = LIBCTHREADS_READ_WRITE_LOCK_POLICY_DEFAULT;
+	     test_policy <= LIBCTHREADS_READ_WRITE_LOCK_POLICY_FAIR;
+	     test_policy++ )
+	{
+		/* Initialize test
+		 */
+		result = libcthreads_read_write_lock_initialize_with_policy(
+		          &cthreads_test_read_write_lock,
+		          test_policy,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test regular cases
+		 */
+		result = libcthreads_read_write_lock_try_grab_for_read(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_release_for_read(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_try_grab_for_write(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_release_for_write(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_timed_grab_for_read(
+		          cthreads_test_read_write_lock,
+		          1000000,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_release_for_read(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_timed_grab_for_write(
+		          cthreads_test_read_write_lock,
+		          1000000,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_read_write_lock_release_for_write(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test try and timed grabs while the read/write lock is grabbed for writing
+		 */
+		result = libcthreads_read_write_lock_grab_for_write(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( grab_index = 0;
+		     grab_index < 4;
+		     grab_index++ )
+		{
+			cthreads_test_try_grab_results[ grab_index ] = -1;
+		}
+		result = libcthreads_thread_create(
+		          &thread,
+		          NULL,
+		          cthreads_test_read_write_lock_try_grab_callback_function,
+		          NULL,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_thread_join(
+		          &thread,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "cthreads_test_try_grab_results[ 0 ]",
+		 cthreads_test_try_grab_results[ 0 ],
+		 0 );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "cthreads_test_try_grab_results[ 1 ]",
+		 cthreads_test_try_grab_results[ 1 ],
+		 0 );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "cthreads_test_try_grab_results[ 2 ]",
+		 cthreads_test_try_grab_results[ 2 ],
+		 0 );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "cthreads_test_try_grab_results[ 3 ]",
+		 cthreads_test_try_grab_results[ 3 ],
+		 0 );
+
+		result = libcthreads_read_write_lock_release_for_write(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test try and timed grabs while the read/write lock is grabbed for reading
+		 */
+		result = libcthreads_read_write_lock_grab_for_read(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( grab_index = 0;
+		     grab_index < 4;
+		     grab_index++ )
+		{
+			cthreads_test_try_grab_results[ grab_index ] = -1;
+		}
+		result = libcthreads_thread_create(
+		          &thread,
+		          NULL,
+		          cthreads_test_read_write_lock_try_grab_callback_function,
+		          NULL,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_thread_join(
+		          &thread,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "cthreads_test_try_grab_results[ 0 ]",
+		 cthreads_test_try_grab_results[ 0 ],
+		 1 );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "cthreads_test_try_grab_results[ 1 ]",
+		 cthreads_test_try_grab_results[ 1 ],
+		 1 );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "cthreads_test_try_grab_results[ 2 ]",
+		 cthreads_test_try_grab_results[ 2 ],
+		 0 );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "cthreads_test_try_grab_results[ 3 ]",
+		 cthreads_test_try_grab_results[ 3 ],
+		 0 );
+
+		result = libcthreads_read_write_lock_release_for_read(
+		          cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Clean up
+		 */
+		result = libcthreads_read_write_lock_free(
+		          &cthreads_test_read_write_lock,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+	}
+	/* Test error cases
+	 */
+	result = libcthreads_read_write_lock_try_grab_for_read(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_read_write_lock_try_grab_for_write(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_read_write_lock_grab_for_read_until(
+	          NULL,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_read_write_lock_grab_for_write_until(
+	          NULL,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_read_write_lock_timed_grab_for_read(
+	          NULL,
+	          1000000,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_read_write_lock_timed_grab_for_write(
+	          NULL,
+	          1000000,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread != NULL )
+	{
+		libcthreads_thread_join(
+		 &thread,
+		 NULL );
+	}
+	if( cthreads_test_read_write_lock != NULL )
+	{
+		libcthreads_read_write_lock_free(
+		 &cthreads_test_read_write_lock,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( LIBCTHREADS_HAVE_STATIC_INITIALIZERS )
+
+/* Tests a statically initialized read_write_lock storage
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_read_write_lock_static_initializer(
+     void )
+{
+	static libcthreads_read_write_lock_storage_t storage = LIBCTHREADS_READ_WRITE_LOCK_STORAGE_INITIALIZER;
+
+	libcerror_error_t *error                       = NULL;
+	libcthreads_read_write_lock_t *read_write_lock = NULL;
+	int result                                     = 0;
+
+	/* Test regular cases
+	 */
+	read_write_lock = LIBCTHREADS_READ_WRITE_LOCK_FROM_STORAGE( &storage );
+
+	result = libcthreads_read_write_lock_grab_for_write(
+	          read_write_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_read_write_lock_release_for_write(
+	          read_write_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_read_write_lock_finalize_in_place(
+	          &read_write_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( LIBCTHREADS_HAVE_STATIC_INITIALIZERS ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_read_write_lock_initialize",
+	 cthreads_test_read_write_lock_initialize );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_read_write_lock_free",
+	 cthreads_test_read_write_lock_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_read_write_lock_grab_for_read",
+	 cthreads_test_read_write_lock_grab_for_read );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_read_write_lock_grab_for_write",
+	 cthreads_test_read_write_lock_grab_for_write );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_read_write_lock_release_for_read",
+	 cthreads_test_read_write_lock_release_for_read );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_read_write_lock_release_for_write",
+	 cthreads_test_read_write_lock_release_for_write );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_read_write_lock_initialize_in_place",
+	 cthreads_test_read_write_lock_in_place );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_read_write_lock_initialize_with_policy",
+	 cthreads_test_read_write_lock_initialize_with_policy );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_read_write_lock_grab_for_upgrade",
+	 cthreads_test_read_write_lock_grab_for_upgrade );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_read_write_lock_try_grab",
+	 cthreads_test_read_write_lock_try_grab );
+
+#if defined( LIBCTHREADS_HAVE_STATIC_INITIALIZERS )
+
+	CTHREADS_TEST_RUN(
+	 "LIBCTHREADS_READ_WRITE_LOCK_STORAGE_INITIALIZER",
+	 cthreads_test_read_write_lock_static_initializer );
+
+#endif /* defined( LIBCTHREADS_HAVE_STATIC_INITIALIZERS ) */
 
 	return( EXIT_SUCCESS );
 
@@ -33,6 +33,750 @@
 #include "cthreads_test_memory.h"
 #include "cthreads_test_unused.h"
 
+libcthreads_condition_t *cthreads_test_repeating_thread_condition = NULL;
+libcthreads_mutex_t *cthreads_test_repeating_thread_mutex         = NULL;
+int cthreads_test_repeating_thread_number_of_runs                 = 0;
+
+/* The start function
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_repeating_thread_start_function(
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "cthreads_test_repeating_thread_start_function";
+	int result               = 1;
+
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	if( libcthreads_mutex_grab(
+	     cthreads_test_repeating_thread_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	cthreads_test_repeating_thread_number_of_runs++;
+
+	if( libcthreads_condition_broadcast(
+	     cthreads_test_repeating_thread_condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     cthreads_test_repeating_thread_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Waits until the start function ran a specific number of times
+ * Returns 1 if successful, 0 if not within 10 seconds or -1 on error
+ */
+int cthreads_test_repeating_thread_wait_for_runs(
+     int number_of_runs,
+     libcerror_error_t **error )
+{
+	static char *function = "cthreads_test_repeating_thread_wait_for_runs";
+	uint64_t deadline     = 0;
+	int result            = 1;
+
+	if( libcthreads_clock_get_monotonic_time(
+	     &deadline,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic time.",
+		 function );
+
+		return( -1 );
+	}
+	deadline += (uint64_t) 10 * 1000000000UL;
+
+	if( libcthreads_mutex_grab(
+	     cthreads_test_repeating_thread_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( cthreads_test_repeating_thread_number_of_runs < number_of_runs )
+	{
+		result = libcthreads_condition_wait_until(
+		          cthreads_test_repeating_thread_condition,
+		          cthreads_test_repeating_thread_mutex,
+		          deadline,
+		          error );
+
+		if( result != 1 )
+		{
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     cthreads_test_repeating_thread_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Tests the libcthreads_repeating_thread_create and libcthreads_repeating_thread_join functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_repeating_thread_create(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libcthreads_repeating_thread_t *repeating_thread = NULL;
+	int result                                       = 0;
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                  = 3;
+	int number_of_memset_fail_tests                  = 1;
+	int test_number                                  = 0;
+#endif
+
+	/* Initialize test
+	 */
+	cthreads_test_repeating_thread_number_of_runs = 0;
+
+	/* Test regular cases
+	 */
+	result = libcthreads_repeating_thread_create(
+	          &repeating_thread,
+	          NULL,
+	          cthreads_test_repeating_thread_start_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "repeating_thread",
+	 repeating_thread );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_repeating_thread_join(
+	          &repeating_thread,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "repeating_thread",
+	 repeating_thread );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A thread that was not pushed runs the start function once on join
+	 */
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_runs",
+	 cthreads_test_repeating_thread_number_of_runs,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libcthreads_repeating_thread_create(
+	          NULL,
+	          NULL,
+	          cthreads_test_repeating_thread_start_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	repeating_thread = (libcthreads_repeating_thread_t *) 0x12345678UL;
+
+	result = libcthreads_repeating_thread_create(
+	          &repeating_thread,
+	          NULL,
+	          cthreads_test_repeating_thread_start_function,
+	          NULL,
+	          &error );
+
+	repeating_thread = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_repeating_thread_create(
+	          &repeating_thread,
+	          NULL,
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_repeating_thread_join(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_repeating_thread_join(
+	          &repeating_thread,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_repeating_thread_create with malloc failing
+		 */
+		cthreads_test_malloc_attempts_before_fail = test_number;
+
+		result = libcthreads_repeating_thread_create(
+		          &repeating_thread,
+		          NULL,
+		          cthreads_test_repeating_thread_start_function,
+		          NULL,
+		          &error );
+
+		if( cthreads_test_malloc_attempts_before_fail != -1 )
+		{
+			cthreads_test_malloc_attempts_before_fail = -1;
+
+			if( repeating_thread != NULL )
+			{
+				libcthreads_repeating_thread_join(
+				 &repeating_thread,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "repeating_thread",
+			 repeating_thread );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_repeating_thread_create with memset failing
+		 */
+		cthreads_test_memset_attempts_before_fail = test_number;
+
+		result = libcthreads_repeating_thread_create(
+		          &repeating_thread,
+		          NULL,
+		          cthreads_test_repeating_thread_start_function,
+		          NULL,
+		          &error );
+
+		if( cthreads_test_memset_attempts_before_fail != -1 )
+		{
+			cthreads_test_memset_attempts_before_fail = -1;
+
+			if( repeating_thread != NULL )
+			{
+				libcthreads_repeating_thread_join(
+				 &repeating_thread,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "repeating_thread",
+			 repeating_thread );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_CTHREADS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( repeating_thread != NULL )
+	{
+		libcthreads_repeating_thread_join(
+		 &repeating_thread,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_repeating_thread_push function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_repeating_thread_push(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libcthreads_repeating_thread_t *repeating_thread = NULL;
+	int push_index                                   = 0;
+	int result                                       = 0;
+
+	/* Initialize test
+	 */
+	cthreads_test_repeating_thread_number_of_runs = 0;
+
+	result = libcthreads_repeating_thread_create(
+	          &repeating_thread,
+	          NULL,
+	          cthreads_test_repeating_thread_start_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_repeating_thread_push(
+	          repeating_thread,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = cthreads_test_repeating_thread_wait_for_runs(
+	          1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Multiple pushes are coalesced into fewer runs, but at least one
+	 * run follows the last push even if the thread is joined
+	 */
+	for( push_index = 0;
+	     push_index < 8;
+	     push_index++ )
+	{
+		result = libcthreads_repeating_thread_push(
+		          repeating_thread,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcthreads_repeating_thread_join(
+	          &repeating_thread,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_runs >= 2",
+	 (int) ( cthreads_test_repeating_thread_number_of_runs >= 2 ),
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_runs <= 9",
+	 (int) ( cthreads_test_repeating_thread_number_of_runs <= 9 ),
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libcthreads_repeating_thread_push(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( repeating_thread != NULL )
+	{
+		libcthreads_repeating_thread_join(
+		 &repeating_thread,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_repeating_thread_set_schedule function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_repeating_thread_set_schedule(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libcthreads_repeating_thread_t *repeating_thread = NULL;
+	int result                                       = 0;
+
+	/* Initialize test
+	 */
+	cthreads_test_repeating_thread_number_of_runs = 0;
+
+	result = libcthreads_repeating_thread_create(
+	          &repeating_thread,
+	          NULL,
+	          cthreads_test_repeating_thread_start_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_repeating_thread_set_schedule(
+	          repeating_thread,
+	          LIBCTHREADS_REPEATING_THREAD_SCHEDULE_FIXED_RATE,
+	          2000000,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = cthreads_test_repeating_thread_wait_for_runs(
+	          3,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_repeating_thread_set_schedule(
+	          repeating_thread,
+	          LIBCTHREADS_REPEATING_THREAD_SCHEDULE_FIXED_DELAY,
+	          2000000,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = cthreads_test_repeating_thread_wait_for_runs(
+	          6,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_repeating_thread_set_schedule(
+	          repeating_thread,
+	          LIBCTHREADS_REPEATING_THREAD_SCHEDULE_NONE,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_repeating_thread_set_schedule(
+	          NULL,
+	          LIBCTHREADS_REPEATING_THREAD_SCHEDULE_FIXED_RATE,
+	          2000000,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_repeating_thread_set_schedule(
+	          repeating_thread,
+	          0xff,
+	          2000000,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_repeating_thread_set_schedule(
+	          repeating_thread,
+	          LIBCTHREADS_REPEATING_THREAD_SCHEDULE_FIXED_RATE,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_repeating_thread_join(
+	          &repeating_thread,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( repeating_thread != NULL )
+	{
+		libcthreads_repeating_thread_join(
+		 &repeating_thread,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -48,15 +792,55 @@ int main(
 	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
 	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
 
-	/* TODO: add tests for libcthreads_repeating_thread_create */
+	if( libcthreads_mutex_initialize(
+	     &cthreads_test_repeating_thread_mutex,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &cthreads_test_repeating_thread_condition,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	CTHREADS_TEST_RUN(
+	 "libcthreads_repeating_thread_create",
+	 cthreads_test_repeating_thread_create );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_repeating_thread_push",
+	 cthreads_test_repeating_thread_push );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_repeating_thread_set_schedule",
+	 cthreads_test_repeating_thread_set_schedule );
+
+	/* libcthreads_repeating_thread_join is tested by cthreads_test_repeating_thread_create */
 
-	/* TODO: add tests for libcthreads_repeating_thread_push */
+	libcthreads_condition_free(
+	 &cthreads_test_repeating_thread_condition,
+	 NULL );
 
-	/* TODO: add tests for libcthreads_repeating_thread_join */
+	libcthreads_mutex_free(
+	 &cthreads_test_repeating_thread_mutex,
+	 NULL );
 
 	return( EXIT_SUCCESS );
 
 on_error:
+	if( cthreads_test_repeating_thread_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &cthreads_test_repeating_thread_condition,
+		 NULL );
+	}
+	if( cthreads_test_repeating_thread_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &cthreads_test_repeating_thread_mutex,
+		 NULL );
+	}
 	return( EXIT_FAILURE );
 }
 
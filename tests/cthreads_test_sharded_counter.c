@@ -0,0 +1,850 @@
+/*
+ * Library sharded counter type test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_memory.h"
+#include "cthreads_test_unused.h"
+
+#define CTHREADS_TEST_SHARDED_COUNTER_FLUSH_THRESHOLD		8
+#define CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_ITERATIONS	10000
+#define CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_SHARDS		4
+#define CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_THREADS		4
+
+libcthreads_sharded_counter_t *cthreads_test_sharded_counter = NULL;
+
+/* The sharded counter callback function
+ * Repeatedly increments the sharded counter
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_sharded_counter_callback_function(
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "cthreads_test_sharded_counter_callback_function";
+	int iteration            = 0;
+
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	for( iteration = 0;
+	     iteration < CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_ITERATIONS;
+	     iteration++ )
+	{
+		if( libcthreads_sharded_counter_increment(
+		     cthreads_test_sharded_counter,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to increment sharded counter.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Tests the libcthreads_sharded_counter_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_sharded_counter_initialize(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libcthreads_sharded_counter_t *sharded_counter = NULL;
+	int number_of_shards                           = 0;
+	int result                                     = 0;
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                = 2;
+	int number_of_memset_fail_tests                = 2;
+	int test_number                                = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libcthreads_sharded_counter_initialize(
+	          &sharded_counter,
+	          0,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "sharded_counter",
+	 sharded_counter );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_sharded_counter_get_number_of_shards(
+	          sharded_counter,
+	          &number_of_shards,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_shards",
+	 number_of_shards,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_sharded_counter_free(
+	          &sharded_counter,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "sharded_counter",
+	 sharded_counter );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_sharded_counter_initialize(
+	          &sharded_counter,
+	          CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_SHARDS,
+	          CTHREADS_TEST_SHARDED_COUNTER_FLUSH_THRESHOLD,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_sharded_counter_get_number_of_shards(
+	          sharded_counter,
+	          &number_of_shards,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_shards",
+	 number_of_shards,
+	 CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_SHARDS );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_sharded_counter_free(
+	          &sharded_counter,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_sharded_counter_initialize(
+	          NULL,
+	          0,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	sharded_counter = (libcthreads_sharded_counter_t *) 0x12345678UL;
+
+	result = libcthreads_sharded_counter_initialize(
+	          &sharded_counter,
+	          0,
+	          0,
+	          &error );
+
+	sharded_counter = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_sharded_counter_initialize(
+	          &sharded_counter,
+	          -1,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_sharded_counter_initialize(
+	          &sharded_counter,
+	          0,
+	          -1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_sharded_counter_initialize with malloc failing
+		 */
+		cthreads_test_malloc_attempts_before_fail = test_number;
+
+		result = libcthreads_sharded_counter_initialize(
+		          &sharded_counter,
+		          CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_SHARDS,
+		          0,
+		          &error );
+
+		if( cthreads_test_malloc_attempts_before_fail != -1 )
+		{
+			cthreads_test_malloc_attempts_before_fail = -1;
+
+			if( sharded_counter != NULL )
+			{
+				libcthreads_sharded_counter_free(
+				 &sharded_counter,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "sharded_counter",
+			 sharded_counter );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_sharded_counter_initialize with memset failing
+		 */
+		cthreads_test_memset_attempts_before_fail = test_number;
+
+		result = libcthreads_sharded_counter_initialize(
+		          &sharded_counter,
+		          CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_SHARDS,
+		          0,
+		          &error );
+
+		if( cthreads_test_memset_attempts_before_fail != -1 )
+		{
+			cthreads_test_memset_attempts_before_fail = -1;
+
+			if( sharded_counter != NULL )
+			{
+				libcthreads_sharded_counter_free(
+				 &sharded_counter,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "sharded_counter",
+			 sharded_counter );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_CTHREADS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sharded_counter != NULL )
+	{
+		libcthreads_sharded_counter_free(
+		 &sharded_counter,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_sharded_counter_free function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_sharded_counter_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libcthreads_sharded_counter_free(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_sharded_counter_add, libcthreads_sharded_counter_get_value
+ * and libcthreads_sharded_counter_get_approximate_value functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_sharded_counter_add(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libcthreads_sharded_counter_t *sharded_counter = NULL;
+	int64_t approximate_value                      = 0;
+	int64_t value                                  = 0;
+	int iteration                                  = 0;
+	int result                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_sharded_counter_initialize(
+	          &sharded_counter,
+	          CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_SHARDS,
+	          CTHREADS_TEST_SHARDED_COUNTER_FLUSH_THRESHOLD,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( iteration = 0;
+	     iteration < 100;
+	     iteration++ )
+	{
+		result = libcthreads_sharded_counter_increment(
+		          sharded_counter,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcthreads_sharded_counter_add(
+	          sharded_counter,
+	          -30,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_sharded_counter_get_value(
+	          sharded_counter,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT64(
+	 "value",
+	 value,
+	 (int64_t) 70 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_sharded_counter_get_approximate_value(
+	          sharded_counter,
+	          &approximate_value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The values that were not flushed from the shards are bounded by the flush threshold
+	 */
+	result = ( ( value - approximate_value ) < ( CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_SHARDS * CTHREADS_TEST_SHARDED_COUNTER_FLUSH_THRESHOLD ) )
+	      && ( ( approximate_value - value ) < ( CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_SHARDS * CTHREADS_TEST_SHARDED_COUNTER_FLUSH_THRESHOLD ) );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libcthreads_sharded_counter_add(
+	          NULL,
+	          1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_sharded_counter_increment(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_sharded_counter_get_value(
+	          NULL,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_sharded_counter_get_value(
+	          sharded_counter,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_sharded_counter_get_approximate_value(
+	          NULL,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_sharded_counter_get_approximate_value(
+	          sharded_counter,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_sharded_counter_free(
+	          &sharded_counter,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sharded_counter != NULL )
+	{
+		libcthreads_sharded_counter_free(
+		 &sharded_counter,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_sharded_counter functions with multiple threads
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_sharded_counter_threads(
+     void )
+{
+	libcthreads_thread_t *threads[ CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_THREADS ];
+
+	libcerror_error_t *error = NULL;
+	int64_t value            = 0;
+	int result               = 0;
+	int thread_index         = 0;
+
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		threads[ thread_index ] = NULL;
+	}
+	/* Initialize test
+	 */
+	result = libcthreads_sharded_counter_initialize(
+	          &cthreads_test_sharded_counter,
+	          0,
+	          CTHREADS_TEST_SHARDED_COUNTER_FLUSH_THRESHOLD,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          &cthreads_test_sharded_counter_callback_function,
+		          NULL,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcthreads_sharded_counter_get_value(
+	          cthreads_test_sharded_counter,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT64(
+	 "value",
+	 value,
+	 (int64_t) ( CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_THREADS * CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_ITERATIONS ) );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libcthreads_sharded_counter_free(
+	          &cthreads_test_sharded_counter,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_SHARDED_COUNTER_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	if( cthreads_test_sharded_counter != NULL )
+	{
+		libcthreads_sharded_counter_free(
+		 &cthreads_test_sharded_counter,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_sharded_counter_initialize",
+	 cthreads_test_sharded_counter_initialize );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_sharded_counter_free",
+	 cthreads_test_sharded_counter_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_sharded_counter_add",
+	 cthreads_test_sharded_counter_add );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_sharded_counter_threads",
+	 cthreads_test_sharded_counter_threads );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,855 @@
+/*
+ * Library stack type test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_memory.h"
+#include "cthreads_test_unused.h"
+
+#define CTHREADS_TEST_STACK_NUMBER_OF_ITERATIONS	10000
+#define CTHREADS_TEST_STACK_NUMBER_OF_OBJECTS		16
+#define CTHREADS_TEST_STACK_NUMBER_OF_THREADS		4
+
+typedef struct cthreads_test_stack_object cthreads_test_stack_object_t;
+
+struct cthreads_test_stack_object
+{
+	/* The stack node, this must be the first member
+	 */
+	libcthreads_stack_node_t node;
+
+	/* The value
+	 */
+	int value;
+
+	/* The number of times the object was popped
+	 */
+	int number_of_pops;
+};
+
+libcthreads_stack_t *cthreads_test_stack = NULL;
+
+cthreads_test_stack_object_t cthreads_test_stack_objects[ CTHREADS_TEST_STACK_NUMBER_OF_OBJECTS ];
+
+/* The stack callback function
+ * Repeatedly pops an object and pushes it back
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_stack_callback_function(
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error       = NULL;
+	libcthreads_stack_node_t *node = NULL;
+	static char *function          = "cthreads_test_stack_callback_function";
+	int iteration                  = 0;
+	int result                     = 0;
+
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	for( iteration = 0;
+	     iteration < CTHREADS_TEST_STACK_NUMBER_OF_ITERATIONS;
+	     iteration++ )
+	{
+		result = libcthreads_stack_pop(
+		          cthreads_test_stack,
+		          &node,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to pop node.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		/* The object is owned by this thread until it is pushed back
+		 */
+		( (cthreads_test_stack_object_t *) node )->number_of_pops += 1;
+
+		result = libcthreads_stack_push(
+		          cthreads_test_stack,
+		          node,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push node.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stdout );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Tests the libcthreads_stack_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_stack_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libcthreads_stack_t *stack      = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 3;
+	int number_of_memset_fail_tests = 3;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libcthreads_stack_initialize(
+	          &stack,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "stack",
+	 stack );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_stack_free(
+	          &stack,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "stack",
+	 stack );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_stack_initialize(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	stack = (libcthreads_stack_t *) 0x12345678UL;
+
+	result = libcthreads_stack_initialize(
+	          &stack,
+	          &error );
+
+	stack = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_stack_initialize with malloc failing
+		 */
+		cthreads_test_malloc_attempts_before_fail = test_number;
+
+		result = libcthreads_stack_initialize(
+		          &stack,
+		          &error );
+
+		if( cthreads_test_malloc_attempts_before_fail != -1 )
+		{
+			cthreads_test_malloc_attempts_before_fail = -1;
+
+			if( stack != NULL )
+			{
+				libcthreads_stack_free(
+				 &stack,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "stack",
+			 stack );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_stack_initialize with memset failing
+		 */
+		cthreads_test_memset_attempts_before_fail = test_number;
+
+		result = libcthreads_stack_initialize(
+		          &stack,
+		          &error );
+
+		if( cthreads_test_memset_attempts_before_fail != -1 )
+		{
+			cthreads_test_memset_attempts_before_fail = -1;
+
+			if( stack != NULL )
+			{
+				libcthreads_stack_free(
+				 &stack,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "stack",
+			 stack );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_CTHREADS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stack != NULL )
+	{
+		libcthreads_stack_free(
+		 &stack,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_stack_free function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_stack_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libcthreads_stack_free(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_stack_push, libcthreads_stack_pop and libcthreads_stack_pop_all functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_stack_push(
+     void )
+{
+	libcerror_error_t *error       = NULL;
+	libcthreads_stack_node_t *node = NULL;
+	libcthreads_stack_t *stack     = NULL;
+	int object_index               = 0;
+	int result                     = 0;
+
+	for( object_index = 0;
+	     object_index < 3;
+	     object_index++ )
+	{
+		cthreads_test_stack_objects[ object_index ].value = object_index;
+	}
+	/* Initialize test
+	 */
+	result = libcthreads_stack_initialize(
+	          &stack,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_stack_pop(
+	          stack,
+	          &node,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( object_index = 0;
+	     object_index < 3;
+	     object_index++ )
+	{
+		result = libcthreads_stack_push(
+		          stack,
+		          &( cthreads_test_stack_objects[ object_index ].node ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcthreads_stack_pop(
+	          stack,
+	          &node,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "value",
+	 ( (cthreads_test_stack_object_t *) node )->value,
+	 2 );
+
+	result = libcthreads_stack_pop_all(
+	          stack,
+	          &node,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "value",
+	 ( (cthreads_test_stack_object_t *) node )->value,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "node->next_node",
+	 node->next_node );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "value",
+	 ( (cthreads_test_stack_object_t *) node->next_node )->value,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "node->next_node->next_node",
+	 node->next_node->next_node );
+
+	result = libcthreads_stack_pop_all(
+	          stack,
+	          &node,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_stack_push(
+	          NULL,
+	          &( cthreads_test_stack_objects[ 0 ].node ),
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_stack_push(
+	          stack,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_stack_pop(
+	          NULL,
+	          &node,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_stack_pop(
+	          stack,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_stack_pop_all(
+	          NULL,
+	          &node,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_stack_pop_all(
+	          stack,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_stack_free(
+	          &stack,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stack != NULL )
+	{
+		libcthreads_stack_free(
+		 &stack,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_stack functions with multiple threads
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_stack_threads(
+     void )
+{
+	libcthreads_thread_t *threads[ CTHREADS_TEST_STACK_NUMBER_OF_THREADS ];
+
+	libcerror_error_t *error       = NULL;
+	libcthreads_stack_node_t *node = NULL;
+	int number_of_nodes            = 0;
+	int object_index               = 0;
+	int result                     = 0;
+	int thread_index               = 0;
+
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_STACK_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		threads[ thread_index ] = NULL;
+	}
+	/* Initialize test
+	 */
+	result = libcthreads_stack_initialize(
+	          &cthreads_test_stack,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( object_index = 0;
+	     object_index < CTHREADS_TEST_STACK_NUMBER_OF_OBJECTS;
+	     object_index++ )
+	{
+		cthreads_test_stack_objects[ object_index ].value          = object_index;
+		cthreads_test_stack_objects[ object_index ].number_of_pops = 0;
+
+		result = libcthreads_stack_push(
+		          cthreads_test_stack,
+		          &( cthreads_test_stack_objects[ object_index ].node ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_STACK_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          &cthreads_test_stack_callback_function,
+		          NULL,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_STACK_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Every object must still be on the stack exactly once
+	 */
+	result = libcthreads_stack_pop_all(
+	          cthreads_test_stack,
+	          &node,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	while( node != NULL )
+	{
+		( (cthreads_test_stack_object_t *) node )->value = -1;
+
+		number_of_nodes++;
+
+		CTHREADS_TEST_ASSERT_LESS_THAN_INT(
+		 "number_of_nodes",
+		 number_of_nodes,
+		 CTHREADS_TEST_STACK_NUMBER_OF_OBJECTS + 1 );
+
+		node = node->next_node;
+	}
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_nodes",
+	 number_of_nodes,
+	 CTHREADS_TEST_STACK_NUMBER_OF_OBJECTS );
+
+	for( object_index = 0;
+	     object_index < CTHREADS_TEST_STACK_NUMBER_OF_OBJECTS;
+	     object_index++ )
+	{
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "value",
+		 cthreads_test_stack_objects[ object_index ].value,
+		 -1 );
+	}
+	/* Clean up
+	 */
+	result = libcthreads_stack_free(
+	          &cthreads_test_stack,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( thread_index = 0;
+	     thread_index < CTHREADS_TEST_STACK_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	if( cthreads_test_stack != NULL )
+	{
+		libcthreads_stack_free(
+		 &cthreads_test_stack,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_stack_initialize",
+	 cthreads_test_stack_initialize );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_stack_free",
+	 cthreads_test_stack_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_stack_push",
+	 cthreads_test_stack_push );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_stack_threads",
+	 cthreads_test_stack_threads );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
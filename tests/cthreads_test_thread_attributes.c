@@ -266,6 +266,665 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libcthreads_thread_attributes_set_stack_size function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_thread_attributes_set_stack_size(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libcthreads_thread_attributes_t *thread_attributes = NULL;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_thread_attributes_initialize(
+	          &thread_attributes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "thread_attributes",
+	 thread_attributes );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_thread_attributes_set_stack_size(
+	          thread_attributes,
+	          1024 * 1024,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_thread_attributes_set_stack_size(
+	          NULL,
+	          1024 * 1024,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_thread_attributes_set_stack_size(
+	          thread_attributes,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_thread_attributes_free(
+	          &thread_attributes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "thread_attributes",
+	 thread_attributes );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_attributes != NULL )
+	{
+		libcthreads_thread_attributes_free(
+		 &thread_attributes,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_thread_attributes_set_guard_size function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_thread_attributes_set_guard_size(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libcthreads_thread_attributes_t *thread_attributes = NULL;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_thread_attributes_initialize(
+	          &thread_attributes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "thread_attributes",
+	 thread_attributes );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_thread_attributes_set_guard_size(
+	          thread_attributes,
+	          4096,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_thread_attributes_set_guard_size(
+	          NULL,
+	          4096,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_thread_attributes_set_guard_size(
+	          thread_attributes,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_thread_attributes_free(
+	          &thread_attributes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "thread_attributes",
+	 thread_attributes );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_attributes != NULL )
+	{
+		libcthreads_thread_attributes_free(
+		 &thread_attributes,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_thread_attributes_set_scheduling_policy function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_thread_attributes_set_scheduling_policy(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libcthreads_thread_attributes_t *thread_attributes = NULL;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_thread_attributes_initialize(
+	          &thread_attributes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "thread_attributes",
+	 thread_attributes );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_thread_attributes_set_scheduling_policy(
+	          thread_attributes,
+	          LIBCTHREADS_SCHEDULING_POLICY_DEFAULT,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_thread_attributes_set_scheduling_policy(
+	          NULL,
+	          LIBCTHREADS_SCHEDULING_POLICY_DEFAULT,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_thread_attributes_set_scheduling_policy(
+	          thread_attributes,
+	          -1,
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_thread_attributes_set_scheduling_policy(
+	          thread_attributes,
+	          LIBCTHREADS_SCHEDULING_POLICY_FIFO,
+	          1000,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_thread_attributes_free(
+	          &thread_attributes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "thread_attributes",
+	 thread_attributes );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_attributes != NULL )
+	{
+		libcthreads_thread_attributes_free(
+		 &thread_attributes,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_thread_attributes_set_name function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_thread_attributes_set_name(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libcthreads_thread_attributes_t *thread_attributes = NULL;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_thread_attributes_initialize(
+	          &thread_attributes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "thread_attributes",
+	 thread_attributes );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_thread_attributes_set_name(
+	          thread_attributes,
+	          "worker",
+	          6,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_thread_attributes_set_name(
+	          NULL,
+	          "worker",
+	          6,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_thread_attributes_set_name(
+	          thread_attributes,
+	          NULL,
+	          6,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_thread_attributes_set_name(
+	          thread_attributes,
+	          "worker with a long name",
+	          23,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_thread_attributes_free(
+	          &thread_attributes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "thread_attributes",
+	 thread_attributes );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_attributes != NULL )
+	{
+		libcthreads_thread_attributes_free(
+		 &thread_attributes,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Test callback function
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_thread_attributes_callback_function(
+     void *arguments )
+{
+	int *number = (int *) arguments;
+
+	if( number != NULL )
+	{
+		*number = 1;
+	}
+	return( 1 );
+}
+
+/* Tests creating a thread with thread attributes
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_thread_attributes_thread_create(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libcthreads_thread_t *thread                       = NULL;
+	libcthreads_thread_attributes_t *thread_attributes = NULL;
+	int number                                         = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_thread_attributes_initialize(
+	          &thread_attributes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_attributes_set_stack_size(
+	          thread_attributes,
+	          1024 * 1024,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_attributes_set_name(
+	          thread_attributes,
+	          "cthreads_test",
+	          13,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_thread_create(
+	          &thread,
+	          thread_attributes,
+	          &cthreads_test_thread_attributes_callback_function,
+	          (void *) &number,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "thread",
+	 thread );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_join(
+	          &thread,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number",
+	 number,
+	 1 );
+
+	/* Clean up
+	 */
+	result = libcthreads_thread_attributes_free(
+	          &thread_attributes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread != NULL )
+	{
+		libcthreads_thread_join(
+		 &thread,
+		 NULL );
+	}
+	if( thread_attributes != NULL )
+	{
+		libcthreads_thread_attributes_free(
+		 &thread_attributes,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -289,6 +948,26 @@ int main(
 	 "libcthreads_thread_attributes_free",
 	 cthreads_test_thread_attributes_free );
 
+	CTHREADS_TEST_RUN(
+	 "libcthreads_thread_attributes_set_stack_size",
+	 cthreads_test_thread_attributes_set_stack_size );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_thread_attributes_set_guard_size",
+	 cthreads_test_thread_attributes_set_guard_size );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_thread_attributes_set_scheduling_policy",
+	 cthreads_test_thread_attributes_set_scheduling_policy );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_thread_attributes_set_name",
+	 cthreads_test_thread_attributes_set_name );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_thread_create",
+	 cthreads_test_thread_attributes_thread_create );
+
 	return( EXIT_SUCCESS );
 
 on_error:
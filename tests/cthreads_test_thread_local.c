@@ -0,0 +1,814 @@
+/*
+ * Library thread local storage type test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_memory.h"
+#include "cthreads_test_unused.h"
+
+int cthreads_test_thread_local_value                   = 1;
+int cthreads_test_thread_local_number_of_freed_values  = 0;
+int cthreads_test_thread_local_number_of_set_values    = 0;
+libcthreads_lock_t *cthreads_test_thread_local_lock    = NULL;
+libcthreads_thread_local_t *cthreads_test_thread_local = NULL;
+
+/* Frees a thread local value
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_thread_local_value_free(
+     intptr_t **value,
+     libcerror_error_t **error CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( value == NULL )
+	{
+		return( -1 );
+	}
+	if( libcthreads_lock_grab(
+	     cthreads_test_thread_local_lock,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	cthreads_test_thread_local_number_of_freed_values++;
+
+	libcthreads_lock_release(
+	 cthreads_test_thread_local_lock,
+	 NULL );
+
+	*value = NULL;
+
+	return( 1 );
+}
+
+/* Sets the thread local value of the current thread if not set before
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_thread_local_set_value_once(
+     void )
+{
+	intptr_t *value = NULL;
+	int result      = 0;
+
+	result = libcthreads_thread_local_get_value(
+	          cthreads_test_thread_local,
+	          &value,
+	          NULL );
+
+	if( result != 0 )
+	{
+		return( result );
+	}
+	if( libcthreads_thread_local_set_value(
+	     cthreads_test_thread_local,
+	     (intptr_t *) &cthreads_test_thread_local_value,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libcthreads_lock_grab(
+	     cthreads_test_thread_local_lock,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	cthreads_test_thread_local_number_of_set_values++;
+
+	libcthreads_lock_release(
+	 cthreads_test_thread_local_lock,
+	 NULL );
+
+	return( 1 );
+}
+
+/* The thread callback function
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_thread_local_thread_callback_function(
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	return( cthreads_test_thread_local_set_value_once() );
+}
+
+/* The thread pool callback function
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_thread_local_thread_pool_callback_function(
+     intptr_t *value CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( value )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	if( cthreads_test_thread_local_set_value_once() == -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libcthreads_thread_local_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_thread_local_initialize(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libcthreads_thread_local_t *thread_local_storage = NULL;
+	int result                                       = 0;
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                  = 1;
+	int number_of_memset_fail_tests                  = 1;
+	int test_number                                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libcthreads_thread_local_initialize(
+	          &thread_local_storage,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "thread_local_storage",
+	 thread_local_storage );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_local_free(
+	          &thread_local_storage,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "thread_local_storage",
+	 thread_local_storage );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_thread_local_initialize(
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	thread_local_storage = (libcthreads_thread_local_t *) 0x12345678UL;
+
+	result = libcthreads_thread_local_initialize(
+	          &thread_local_storage,
+	          NULL,
+	          &error );
+
+	thread_local_storage = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_thread_local_initialize with malloc failing
+		 */
+		cthreads_test_malloc_attempts_before_fail = test_number;
+
+		result = libcthreads_thread_local_initialize(
+		          &thread_local_storage,
+		          NULL,
+		          &error );
+
+		if( cthreads_test_malloc_attempts_before_fail != -1 )
+		{
+			cthreads_test_malloc_attempts_before_fail = -1;
+
+			if( thread_local_storage != NULL )
+			{
+				libcthreads_thread_local_free(
+				 &thread_local_storage,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "thread_local_storage",
+			 thread_local_storage );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_thread_local_initialize with memset failing
+		 */
+		cthreads_test_memset_attempts_before_fail = test_number;
+
+		result = libcthreads_thread_local_initialize(
+		          &thread_local_storage,
+		          NULL,
+		          &error );
+
+		if( cthreads_test_memset_attempts_before_fail != -1 )
+		{
+			cthreads_test_memset_attempts_before_fail = -1;
+
+			if( thread_local_storage != NULL )
+			{
+				libcthreads_thread_local_free(
+				 &thread_local_storage,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "thread_local_storage",
+			 thread_local_storage );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_CTHREADS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_local_storage != NULL )
+	{
+		libcthreads_thread_local_free(
+		 &thread_local_storage,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_thread_local_free function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_thread_local_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libcthreads_thread_local_free(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_thread_local_get_value and libcthreads_thread_local_set_value functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_thread_local_get_value(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	intptr_t *value          = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	cthreads_test_thread_local_number_of_freed_values = 0;
+
+	result = libcthreads_thread_local_initialize(
+	          &cthreads_test_thread_local,
+	          &cthreads_test_thread_local_value_free,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_thread_local_get_value(
+	          cthreads_test_thread_local,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "value",
+	 value );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_local_set_value(
+	          cthreads_test_thread_local,
+	          (intptr_t *) &cthreads_test_thread_local_value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_local_get_value(
+	          cthreads_test_thread_local,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "value",
+	 (int) ( value == (intptr_t *) &cthreads_test_thread_local_value ),
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_local_set_value(
+	          cthreads_test_thread_local,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_local_get_value(
+	          cthreads_test_thread_local,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_thread_local_get_value(
+	          NULL,
+	          &value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_thread_local_get_value(
+	          cthreads_test_thread_local,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_thread_local_set_value(
+	          NULL,
+	          (intptr_t *) &cthreads_test_thread_local_value,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_thread_local_free(
+	          &cthreads_test_thread_local,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The value was cleared before the thread local storage was freed
+	 */
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_thread_local_number_of_freed_values",
+	 cthreads_test_thread_local_number_of_freed_values,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cthreads_test_thread_local != NULL )
+	{
+		libcthreads_thread_local_free(
+		 &cthreads_test_thread_local,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests if thread local values are freed when a thread exits
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_thread_local_thread_exit(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libcthreads_thread_t *thread           = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	int result                             = 0;
+	int value_index                        = 0;
+
+	/* Initialize test
+	 */
+	cthreads_test_thread_local_number_of_freed_values = 0;
+	cthreads_test_thread_local_number_of_set_values   = 0;
+
+	result = libcthreads_thread_local_initialize(
+	          &cthreads_test_thread_local,
+	          &cthreads_test_thread_local_value_free,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_thread_create(
+	          &thread,
+	          NULL,
+	          &cthreads_test_thread_local_thread_callback_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_join(
+	          &thread,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if !defined( WINAPI ) || ( WINVER >= 0x0600 )
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_thread_local_number_of_freed_values",
+	 cthreads_test_thread_local_number_of_freed_values,
+	 1 );
+#endif
+
+	result = libcthreads_thread_pool_create(
+	          &thread_pool,
+	          NULL,
+	          4,
+	          16,
+	          &cthreads_test_thread_local_thread_pool_callback_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( value_index = 0;
+	     value_index < 16;
+	     value_index++ )
+	{
+		result = libcthreads_thread_pool_push(
+		          thread_pool,
+		          (intptr_t *) &cthreads_test_thread_local_value,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcthreads_thread_pool_join(
+	          &thread_pool,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Every worker thread that set a value freed it on exit
+	 */
+#if !defined( WINAPI ) || ( ( WINVER >= 0x0600 ) && ( WINVER < 0x0602 ) )
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_thread_local_number_of_freed_values",
+	 cthreads_test_thread_local_number_of_freed_values,
+	 cthreads_test_thread_local_number_of_set_values );
+#endif
+
+	/* The value of the current thread is freed with the thread local storage
+	 */
+	result = cthreads_test_thread_local_set_value_once();
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_thread_local_free(
+	          &cthreads_test_thread_local,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_thread_local_number_of_freed_values",
+	 cthreads_test_thread_local_number_of_freed_values,
+	 cthreads_test_thread_local_number_of_set_values );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread != NULL )
+	{
+		libcthreads_thread_join(
+		 &thread,
+		 NULL );
+	}
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( cthreads_test_thread_local != NULL )
+	{
+		libcthreads_thread_local_free(
+		 &cthreads_test_thread_local,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	if( libcthreads_lock_initialize(
+	     &cthreads_test_thread_local_lock,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	CTHREADS_TEST_RUN(
+	 "libcthreads_thread_local_initialize",
+	 cthreads_test_thread_local_initialize );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_thread_local_free",
+	 cthreads_test_thread_local_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_thread_local_get_value",
+	 cthreads_test_thread_local_get_value );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_thread_local_thread_exit",
+	 cthreads_test_thread_local_thread_exit );
+
+	libcthreads_lock_free(
+	 &cthreads_test_thread_local_lock,
+	 NULL );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( cthreads_test_thread_local_lock != NULL )
+	{
+		libcthreads_lock_free(
+		 &cthreads_test_thread_local_lock,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -40,6 +40,11 @@ int cthreads_test_queued_value          = 0;
 int cthreads_test_number_of_iterations  = 497;
 int cthreads_test_number_of_values      = 32;
 
+libcthreads_mutex_t *cthreads_test_submitted_values_mutex         = NULL;
+libcthreads_condition_t *cthreads_test_submitted_values_condition = NULL;
+int cthreads_test_processed_values[ 16 ];
+int cthreads_test_number_of_processed_values                      = 0;
+
 /* The thread pool callback function
  * Returns 1 if successful or -1 on error
  */
@@ -111,6 +116,103 @@ on_error:
 	return( -1 );
 }
 
+/* The thread pool callback function that records the order in which values are processed
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_thread_pool_ordered_callback_function(
+     intptr_t *value,
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	if( value == NULL )
+	{
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     cthreads_test_submitted_values_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	if( cthreads_test_number_of_processed_values < 16 )
+	{
+		cthreads_test_processed_values[ cthreads_test_number_of_processed_values ] = *( (int *) value );
+	}
+	cthreads_test_number_of_processed_values++;
+
+	libcthreads_condition_broadcast(
+	 cthreads_test_submitted_values_condition,
+	 NULL );
+
+	libcthreads_mutex_release(
+	 cthreads_test_submitted_values_mutex,
+	 NULL );
+
+	return( 1 );
+}
+
+/* The thread pool callback function that processes the value 0 slowly
+ * The value 0 is only recorded after another value was processed or after a timeout of 2 seconds
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_thread_pool_slow_callback_function(
+     intptr_t *value,
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	uint64_t deadline = 0;
+
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	if( value == NULL )
+	{
+		return( -1 );
+	}
+	if( libcthreads_clock_get_monotonic_time(
+	     &deadline,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	deadline += 2000000000UL;
+
+	if( libcthreads_mutex_grab(
+	     cthreads_test_submitted_values_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	if( *( (int *) value ) == 0 )
+	{
+		while( cthreads_test_number_of_processed_values == 0 )
+		{
+			if( libcthreads_condition_wait_until(
+			     cthreads_test_submitted_values_condition,
+			     cthreads_test_submitted_values_mutex,
+			     deadline,
+			     NULL ) != 1 )
+			{
+				break;
+			}
+		}
+	}
+	if( cthreads_test_number_of_processed_values < 16 )
+	{
+		cthreads_test_processed_values[ cthreads_test_number_of_processed_values ] = *( (int *) value );
+	}
+	cthreads_test_number_of_processed_values++;
+
+	libcthreads_condition_broadcast(
+	 cthreads_test_submitted_values_condition,
+	 NULL );
+
+	libcthreads_mutex_release(
+	 cthreads_test_submitted_values_mutex,
+	 NULL );
+
+	return( 1 );
+}
+
 /* Tests the libcthreads_thread_pool_create function
  * Returns 1 if successful or 0 if not
  */
@@ -531,19 +633,248 @@ on_error:
 	return( -1 );
 }
 
-/* Tests the libcthreads_thread_join function
+/* Tests the libcthreads_thread_pool_submit_at and libcthreads_thread_pool_submit_after functions
  * Returns 1 if successful or 0 if not
  */
-int cthreads_test_thread_join(
+int cthreads_test_thread_pool_submit_at(
      void )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	int expected_processed_values[ 11 ]    = { 10, 7, 6, 5, 4, 3, 2, 1, 0, 8, 9 };
+	int submitted_values[ 12 ]             = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+	libcerror_error_t *error               = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	uint64_t deadline                      = 0;
+	uint64_t monotonic_time                = 0;
+	int result                             = 0;
+	int value_index                        = 0;
+
+	/* Initialize test
+	 */
+	cthreads_test_number_of_processed_values = 0;
+
+	result = libcthreads_mutex_initialize(
+	          &cthreads_test_submitted_values_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_condition_initialize(
+	          &cthreads_test_submitted_values_condition,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Use a single thread so the values are processed in order of deadline
+	 */
+	result = libcthreads_thread_pool_create(
+	          &thread_pool,
+	          NULL,
+	          1,
+	          4,
+	          &cthreads_test_thread_pool_ordered_callback_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_clock_get_monotonic_time(
+	          &monotonic_time,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Submit values in the reverse order of their deadlines
+	 */
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		deadline = monotonic_time + ( (uint64_t) ( 17 - value_index ) * 2000000 );
+
+		result = libcthreads_thread_pool_submit_at(
+		          thread_pool,
+		          (intptr_t *) &( submitted_values[ value_index ] ),
+		          deadline,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Values with the same deadline are processed in order of submission
+	 */
+	deadline = monotonic_time + 40000000;
+
+	for( value_index = 8;
+	     value_index < 10;
+	     value_index++ )
+	{
+		result = libcthreads_thread_pool_submit_at(
+		          thread_pool,
+		          (intptr_t *) &( submitted_values[ value_index ] ),
+		          deadline,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcthreads_thread_pool_submit_after(
+	          thread_pool,
+	          (intptr_t *) &( submitted_values[ 10 ] ),
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A value that is not due when the thread pool is joined is not processed
+	 */
+	result = libcthreads_thread_pool_submit_after(
+	          thread_pool,
+	          (intptr_t *) &( submitted_values[ 11 ] ),
+	          3600000000000UL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_grab(
+	          cthreads_test_submitted_values_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	deadline = monotonic_time + 5000000000UL;
+
+	while( cthreads_test_number_of_processed_values < 11 )
+	{
+		result = libcthreads_condition_wait_until(
+		          cthreads_test_submitted_values_condition,
+		          cthreads_test_submitted_values_mutex,
+		          deadline,
+		          &error );
+
+		if( result != 1 )
+		{
+			break;
+		}
+	}
+	result = libcthreads_mutex_release(
+	          cthreads_test_submitted_values_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_pool_join(
+	          &thread_pool,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_number_of_processed_values",
+	 cthreads_test_number_of_processed_values,
+	 11 );
+
+	for( value_index = 0;
+	     value_index < 11;
+	     value_index++ )
+	{
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "cthreads_test_processed_values[ value_index ]",
+		 cthreads_test_processed_values[ value_index ],
+		 expected_processed_values[ value_index ] );
+	}
 	/* Test error cases
 	 */
-	result = libcthreads_thread_join(
+	result = libcthreads_thread_pool_submit_at(
+	          NULL,
+	          (intptr_t *) &( submitted_values[ 0 ] ),
+	          0,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_thread_pool_submit_after(
 	          NULL,
+	          (intptr_t *) &( submitted_values[ 0 ] ),
+	          0,
 	          &error );
 
 	CTHREADS_TEST_ASSERT_EQUAL_INT(
@@ -558,6 +889,30 @@ int cthreads_test_thread_join(
 	libcerror_error_free(
 	 &error );
 
+	/* Clean up
+	 */
+	result = libcthreads_condition_free(
+	          &cthreads_test_submitted_values_condition,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_mutex_free(
+	          &cthreads_test_submitted_values_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -566,25 +921,871 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( cthreads_test_submitted_values_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &cthreads_test_submitted_values_condition,
+		 NULL );
+	}
+	if( cthreads_test_submitted_values_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &cthreads_test_submitted_values_mutex,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* The main program
+/* Tests the libcthreads_thread_pool_submit_at function with multiple threads
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
-     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
-#else
-int main(
-     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
-     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
-#endif
+int cthreads_test_thread_pool_submit_at_multiple_threads(
+     void )
 {
-	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
-	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
-
-	CTHREADS_TEST_RUN(
+	int submitted_values[ 2 ]              = { 0, 1 };
+	libcerror_error_t *error               = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	uint64_t deadline                      = 0;
+	uint64_t monotonic_time                = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	cthreads_test_number_of_processed_values = 0;
+
+	result = libcthreads_mutex_initialize(
+	          &cthreads_test_submitted_values_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_condition_initialize(
+	          &cthreads_test_submitted_values_condition,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_pool_create(
+	          &thread_pool,
+	          NULL,
+	          2,
+	          4,
+	          &cthreads_test_thread_pool_slow_callback_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Give both threads time to wait for values
+	 */
+	result = libcthreads_clock_get_monotonic_time(
+	          &monotonic_time,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_mutex_grab(
+	          cthreads_test_submitted_values_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_condition_wait_until(
+	          cthreads_test_submitted_values_condition,
+	          cthreads_test_submitted_values_mutex,
+	          monotonic_time + 50000000,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcthreads_mutex_release(
+	          cthreads_test_submitted_values_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test that the second delayed value is processed while the first
+	 * delayed value is being processed by the other thread
+	 */
+	result = libcthreads_clock_get_monotonic_time(
+	          &monotonic_time,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_thread_pool_submit_at(
+	          thread_pool,
+	          (intptr_t *) &( submitted_values[ 0 ] ),
+	          monotonic_time + 20000000,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_pool_submit_at(
+	          thread_pool,
+	          (intptr_t *) &( submitted_values[ 1 ] ),
+	          monotonic_time + 40000000,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_grab(
+	          cthreads_test_submitted_values_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	deadline = monotonic_time + 5000000000UL;
+
+	while( cthreads_test_number_of_processed_values < 2 )
+	{
+		result = libcthreads_condition_wait_until(
+		          cthreads_test_submitted_values_condition,
+		          cthreads_test_submitted_values_mutex,
+		          deadline,
+		          &error );
+
+		if( result != 1 )
+		{
+			break;
+		}
+	}
+	result = libcthreads_mutex_release(
+	          cthreads_test_submitted_values_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_pool_join(
+	          &thread_pool,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_number_of_processed_values",
+	 cthreads_test_number_of_processed_values,
+	 2 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_processed_values[ 0 ]",
+	 cthreads_test_processed_values[ 0 ],
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_processed_values[ 1 ]",
+	 cthreads_test_processed_values[ 1 ],
+	 0 );
+
+	/* Clean up
+	 */
+	result = libcthreads_condition_free(
+	          &cthreads_test_submitted_values_condition,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_mutex_free(
+	          &cthreads_test_submitted_values_mutex,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( cthreads_test_submitted_values_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &cthreads_test_submitted_values_condition,
+		 NULL );
+	}
+	if( cthreads_test_submitted_values_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &cthreads_test_submitted_values_mutex,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_thread_pool_set_completion_queue function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_thread_pool_set_completion_queue(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libcthreads_queue_t *completion_queue  = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	intptr_t *value                        = NULL;
+	int *queued_values                     = NULL;
+	int iterator                           = 0;
+	int number_of_completed_values         = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	cthreads_test_queued_value = 0;
+
+	queued_values = (int *) memory_allocate(
+	                         sizeof( int ) * cthreads_test_number_of_iterations );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "queued_values",
+	 queued_values );
+
+	result = libcthreads_lock_initialize(
+	          &cthreads_test_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_queue_initialize(
+	          &completion_queue,
+	          cthreads_test_number_of_iterations,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_pool_create(
+	          &thread_pool,
+	          NULL,
+	          8,
+	          cthreads_test_number_of_values,
+	          (int (*)(intptr_t *, void *)) &cthreads_test_thread_pool_callback_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_thread_pool_set_completion_queue(
+	          thread_pool,
+	          completion_queue,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( iterator = 0;
+	     iterator < cthreads_test_number_of_iterations;
+	     iterator++ )
+	{
+		queued_values[ iterator ] = iterator;
+
+		result = libcthreads_thread_pool_push(
+		          thread_pool,
+		          (intptr_t *) &( queued_values[ iterator ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcthreads_thread_pool_join(
+	          &thread_pool,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	do
+	{
+		result = libcthreads_queue_try_pop(
+		          completion_queue,
+		          &value,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result == 1 )
+		{
+			number_of_completed_values++;
+		}
+	}
+	while( result == 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_completed_values",
+	 number_of_completed_values,
+	 cthreads_test_number_of_iterations );
+
+	/* Test error cases
+	 */
+	result = libcthreads_thread_pool_set_completion_queue(
+	          NULL,
+	          completion_queue,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_queue_free(
+	          &completion_queue,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_free(
+	          &cthreads_test_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 queued_values );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( completion_queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &completion_queue,
+		 NULL,
+		 NULL );
+	}
+	if( cthreads_test_lock != NULL )
+	{
+		libcthreads_lock_free(
+		 &cthreads_test_lock,
+		 NULL );
+	}
+	if( queued_values != NULL )
+	{
+		memory_free(
+		 queued_values );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_thread_pool_get_number_of_dropped_completions function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_thread_pool_get_number_of_dropped_completions(
+     void )
+{
+	int queued_values[ 16 ];
+
+	libcerror_error_t *error               = NULL;
+	libcthreads_queue_t *completion_queue  = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	intptr_t *value                        = NULL;
+	uint64_t deadline                      = 0;
+	uint64_t monotonic_time                = 0;
+	int iterator                           = 0;
+	int number_of_completed_values         = 0;
+	int number_of_dropped_completions      = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	cthreads_test_queued_value = 0;
+
+	result = libcthreads_lock_initialize(
+	          &cthreads_test_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_queue_initialize(
+	          &completion_queue,
+	          1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_pool_create(
+	          &thread_pool,
+	          NULL,
+	          4,
+	          cthreads_test_number_of_values,
+	          (int (*)(intptr_t *, void *)) &cthreads_test_thread_pool_callback_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_pool_set_completion_queue(
+	          thread_pool,
+	          completion_queue,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( iterator = 0;
+	     iterator < 16;
+	     iterator++ )
+	{
+		queued_values[ iterator ] = iterator;
+
+		result = libcthreads_thread_pool_push(
+		          thread_pool,
+		          (intptr_t *) &( queued_values[ iterator ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The completion queue is not popped, hence all but the first completed
+	 * value are dropped instead of stalling the worker threads
+	 */
+	result = libcthreads_clock_get_monotonic_time(
+	          &deadline,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	deadline += 5000000000UL;
+
+	do
+	{
+		result = libcthreads_thread_pool_get_number_of_dropped_completions(
+		          thread_pool,
+		          &number_of_dropped_completions,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_clock_get_monotonic_time(
+		          &monotonic_time,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	while( ( number_of_dropped_completions < 15 )
+	    && ( monotonic_time < deadline ) );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_dropped_completions",
+	 number_of_dropped_completions,
+	 15 );
+
+	/* Test error cases
+	 */
+	result = libcthreads_thread_pool_get_number_of_dropped_completions(
+	          NULL,
+	          &number_of_dropped_completions,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_thread_pool_get_number_of_dropped_completions(
+	          thread_pool,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_thread_pool_join(
+	          &thread_pool,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	do
+	{
+		result = libcthreads_queue_try_pop(
+		          completion_queue,
+		          &value,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result == 1 )
+		{
+			number_of_completed_values++;
+		}
+	}
+	while( result == 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_completed_values",
+	 number_of_completed_values,
+	 1 );
+
+	result = libcthreads_queue_free(
+	          &completion_queue,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_lock_free(
+	          &cthreads_test_lock,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( completion_queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &completion_queue,
+		 NULL,
+		 NULL );
+	}
+	if( cthreads_test_lock != NULL )
+	{
+		libcthreads_lock_free(
+		 &cthreads_test_lock,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_thread_join function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_thread_join(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libcthreads_thread_join(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
 	 "libcthreads_thread_pool_create",
 	 cthreads_test_thread_pool_create );
 
@@ -602,6 +1803,22 @@ int main(
 
 		return( EXIT_FAILURE );
 	}
+	CTHREADS_TEST_RUN(
+	 "libcthreads_thread_pool_submit_at",
+	 cthreads_test_thread_pool_submit_at );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_thread_pool_submit_at_multiple_threads",
+	 cthreads_test_thread_pool_submit_at_multiple_threads );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_thread_pool_set_completion_queue",
+	 cthreads_test_thread_pool_set_completion_queue );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_thread_pool_get_number_of_dropped_completions",
+	 cthreads_test_thread_pool_get_number_of_dropped_completions );
+
 	return( EXIT_SUCCESS );
 
 on_error:
@@ -0,0 +1,1207 @@
+/*
+ * Library timer service type test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_memory.h"
+#include "cthreads_test_unused.h"
+
+/* The number of expired timers and the sum of their values
+ */
+static int cthreads_test_timer_service_number_of_expired_timers = 0;
+static intptr_t cthreads_test_timer_service_sum_of_values       = 0;
+
+static libcthreads_mutex_t *cthreads_test_timer_service_mutex         = NULL;
+static libcthreads_condition_t *cthreads_test_timer_service_condition = NULL;
+
+/* The timer service test callback function
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_timer_service_callback_function(
+     intptr_t *value,
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	if( libcthreads_mutex_grab(
+	     cthreads_test_timer_service_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	cthreads_test_timer_service_number_of_expired_timers++;
+	cthreads_test_timer_service_sum_of_values += (intptr_t) value;
+
+	libcthreads_condition_broadcast(
+	 cthreads_test_timer_service_condition,
+	 NULL );
+
+	libcthreads_mutex_release(
+	 cthreads_test_timer_service_mutex,
+	 NULL );
+
+	return( 1 );
+}
+
+/* The timer service test callback function that fails
+ * Returns -1 on error
+ */
+int cthreads_test_timer_service_failing_callback_function(
+     intptr_t *value,
+     void *arguments )
+{
+	cthreads_test_timer_service_callback_function(
+	 value,
+	 arguments );
+
+	return( -1 );
+}
+
+/* Waits until a number of timers have expired or a timeout of 5 seconds
+ * Returns the number of expired timers or -1 on error
+ */
+int cthreads_test_timer_service_wait_for_expired_timers(
+     int number_of_expired_timers )
+{
+	uint64_t deadline = 0;
+	int result        = 0;
+
+	if( libcthreads_clock_get_monotonic_time(
+	     &deadline,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	deadline += 5000000000UL;
+
+	if( libcthreads_mutex_grab(
+	     cthreads_test_timer_service_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	while( cthreads_test_timer_service_number_of_expired_timers < number_of_expired_timers )
+	{
+		result = libcthreads_condition_wait_until(
+		          cthreads_test_timer_service_condition,
+		          cthreads_test_timer_service_mutex,
+		          deadline,
+		          NULL );
+
+		if( result != 1 )
+		{
+			break;
+		}
+	}
+	result = cthreads_test_timer_service_number_of_expired_timers;
+
+	libcthreads_mutex_release(
+	 cthreads_test_timer_service_mutex,
+	 NULL );
+
+	return( result );
+}
+
+/* Tests the libcthreads_timer_service_create and libcthreads_timer_service_join functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_timer_service_create(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libcthreads_thread_pool_t *thread_pool     = NULL;
+	libcthreads_timer_service_t *timer_service = NULL;
+	int result                                 = 0;
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+	int number_of_malloc_fail_tests            = 1;
+	int number_of_memset_fail_tests            = 1;
+	int test_number                            = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libcthreads_timer_service_create(
+	          &timer_service,
+	          NULL,
+	          1000000,
+	          &cthreads_test_timer_service_callback_function,
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "timer_service",
+	 timer_service );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_timer_service_join(
+	          &timer_service,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "timer_service",
+	 timer_service );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_timer_service_create(
+	          NULL,
+	          NULL,
+	          1000000,
+	          &cthreads_test_timer_service_callback_function,
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	timer_service = (libcthreads_timer_service_t *) 0x12345678UL;
+
+	result = libcthreads_timer_service_create(
+	          &timer_service,
+	          NULL,
+	          1000000,
+	          &cthreads_test_timer_service_callback_function,
+	          NULL,
+	          NULL,
+	          &error );
+
+	timer_service = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_timer_service_create(
+	          &timer_service,
+	          NULL,
+	          0,
+	          &cthreads_test_timer_service_callback_function,
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_timer_service_create(
+	          &timer_service,
+	          NULL,
+	          1000000,
+	          NULL,
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	thread_pool = (libcthreads_thread_pool_t *) 0x12345678UL;
+
+	result = libcthreads_timer_service_create(
+	          &timer_service,
+	          NULL,
+	          1000000,
+	          &cthreads_test_timer_service_callback_function,
+	          NULL,
+	          thread_pool,
+	          &error );
+
+	thread_pool = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_timer_service_join(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_timer_service_join(
+	          &timer_service,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_timer_service_create with malloc failing
+		 */
+		cthreads_test_malloc_attempts_before_fail = test_number;
+
+		result = libcthreads_timer_service_create(
+		          &timer_service,
+		          NULL,
+		          1000000,
+		          &cthreads_test_timer_service_callback_function,
+		          NULL,
+		          NULL,
+		          &error );
+
+		if( cthreads_test_malloc_attempts_before_fail != -1 )
+		{
+			cthreads_test_malloc_attempts_before_fail = -1;
+
+			if( timer_service != NULL )
+			{
+				libcthreads_timer_service_join(
+				 &timer_service,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "timer_service",
+			 timer_service );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_timer_service_create with memset failing
+		 */
+		cthreads_test_memset_attempts_before_fail = test_number;
+
+		result = libcthreads_timer_service_create(
+		          &timer_service,
+		          NULL,
+		          1000000,
+		          &cthreads_test_timer_service_callback_function,
+		          NULL,
+		          NULL,
+		          &error );
+
+		if( cthreads_test_memset_attempts_before_fail != -1 )
+		{
+			cthreads_test_memset_attempts_before_fail = -1;
+
+			if( timer_service != NULL )
+			{
+				libcthreads_timer_service_join(
+				 &timer_service,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "timer_service",
+			 timer_service );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_CTHREADS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( timer_service != NULL )
+	{
+		libcthreads_timer_service_join(
+		 &timer_service,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_timer_service_schedule and libcthreads_timer_service_cancel functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_timer_service_schedule(
+     void )
+{
+	libcthreads_timer_t *timers[ 4 ]           = { NULL, NULL, NULL, NULL };
+	libcerror_error_t *error                   = NULL;
+	libcthreads_timer_service_t *timer_service = NULL;
+	int result                                 = 0;
+	int timer_index                            = 0;
+
+	cthreads_test_timer_service_number_of_expired_timers = 0;
+	cthreads_test_timer_service_sum_of_values            = 0;
+
+	for( timer_index = 0;
+	     timer_index < 4;
+	     timer_index++ )
+	{
+		result = libcthreads_timer_initialize(
+		          &( timers[ timer_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Use a 10 microsecond tick so timers are placed on several levels of the timer wheel
+	 */
+	result = libcthreads_timer_service_create(
+	          &timer_service,
+	          NULL,
+	          10000,
+	          &cthreads_test_timer_service_callback_function,
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_timer_service_schedule(
+	          timer_service,
+	          timers[ 0 ],
+	          100000,
+	          (intptr_t *) 1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_timer_service_schedule(
+	          timer_service,
+	          timers[ 1 ],
+	          5000000,
+	          (intptr_t *) 2,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_timer_service_schedule(
+	          timer_service,
+	          timers[ 2 ],
+	          60000000,
+	          (intptr_t *) 4,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Schedule a timer far in the future and reschedule it to expire soon
+	 */
+	result = libcthreads_timer_service_schedule(
+	          timer_service,
+	          timers[ 3 ],
+	          3600000000000UL,
+	          (intptr_t *) 16,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_timer_service_schedule(
+	          timer_service,
+	          timers[ 3 ],
+	          1000000,
+	          (intptr_t *) 8,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = cthreads_test_timer_service_wait_for_expired_timers(
+	          4 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 4 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_timer_service_sum_of_values",
+	 (int) cthreads_test_timer_service_sum_of_values,
+	 15 );
+
+	/* An expired timer is no longer scheduled
+	 */
+	result = libcthreads_timer_service_cancel(
+	          timer_service,
+	          timers[ 0 ],
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A cancelled timer does not expire
+	 */
+	result = libcthreads_timer_service_schedule(
+	          timer_service,
+	          timers[ 0 ],
+	          3600000000000UL,
+	          (intptr_t *) 32,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_timer_service_cancel(
+	          timer_service,
+	          timers[ 0 ],
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_timer_service_cancel(
+	          timer_service,
+	          timers[ 0 ],
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A timer that is still scheduled is cancelled on free and on join
+	 */
+	result = libcthreads_timer_service_schedule(
+	          timer_service,
+	          timers[ 0 ],
+	          3600000000000UL,
+	          (intptr_t *) 32,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_timer_service_schedule(
+	          timer_service,
+	          timers[ 1 ],
+	          3600000000000UL,
+	          (intptr_t *) 64,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_timer_free(
+	          &( timers[ 0 ] ),
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_timer_service_schedule(
+	          NULL,
+	          timers[ 2 ],
+	          1000000,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_timer_service_schedule(
+	          timer_service,
+	          NULL,
+	          1000000,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_timer_service_cancel(
+	          NULL,
+	          timers[ 2 ],
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_timer_service_cancel(
+	          timer_service,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_timer_service_join(
+	          &timer_service,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_timer_service_number_of_expired_timers",
+	 cthreads_test_timer_service_number_of_expired_timers,
+	 4 );
+
+	for( timer_index = 1;
+	     timer_index < 4;
+	     timer_index++ )
+	{
+		result = libcthreads_timer_free(
+		          &( timers[ timer_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( timer_service != NULL )
+	{
+		libcthreads_timer_service_join(
+		 &timer_service,
+		 NULL );
+	}
+	for( timer_index = 0;
+	     timer_index < 4;
+	     timer_index++ )
+	{
+		if( timers[ timer_index ] != NULL )
+		{
+			libcthreads_timer_free(
+			 &( timers[ timer_index ] ),
+			 NULL );
+		}
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_timer_service_schedule function with a thread pool
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_timer_service_schedule_thread_pool(
+     void )
+{
+	libcthreads_timer_t *timers[ 4 ]           = { NULL, NULL, NULL, NULL };
+	libcerror_error_t *error                   = NULL;
+	libcthreads_thread_pool_t *thread_pool     = NULL;
+	libcthreads_timer_service_t *timer_service = NULL;
+	int result                                 = 0;
+	int timer_index                            = 0;
+
+	cthreads_test_timer_service_number_of_expired_timers = 0;
+	cthreads_test_timer_service_sum_of_values            = 0;
+
+	result = libcthreads_thread_pool_create(
+	          &thread_pool,
+	          NULL,
+	          2,
+	          8,
+	          &cthreads_test_timer_service_callback_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_timer_service_create(
+	          &timer_service,
+	          NULL,
+	          1000000,
+	          NULL,
+	          NULL,
+	          thread_pool,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( timer_index = 0;
+	     timer_index < 4;
+	     timer_index++ )
+	{
+		result = libcthreads_timer_initialize(
+		          &( timers[ timer_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_timer_service_schedule(
+		          timer_service,
+		          timers[ timer_index ],
+		          (uint64_t) ( timer_index + 1 ) * 2000000,
+		          (intptr_t *) ( (intptr_t) 1 << timer_index ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = cthreads_test_timer_service_wait_for_expired_timers(
+	          4 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 4 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "cthreads_test_timer_service_sum_of_values",
+	 (int) cthreads_test_timer_service_sum_of_values,
+	 15 );
+
+	result = libcthreads_timer_service_join(
+	          &timer_service,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_pool_join(
+	          &thread_pool,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( timer_index = 0;
+	     timer_index < 4;
+	     timer_index++ )
+	{
+		result = libcthreads_timer_free(
+		          &( timers[ timer_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( timer_service != NULL )
+	{
+		libcthreads_timer_service_join(
+		 &timer_service,
+		 NULL );
+	}
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	for( timer_index = 0;
+	     timer_index < 4;
+	     timer_index++ )
+	{
+		if( timers[ timer_index ] != NULL )
+		{
+			libcthreads_timer_free(
+			 &( timers[ timer_index ] ),
+			 NULL );
+		}
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_timer_service_join function with a failing callback function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_timer_service_schedule_callback_failure(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libcthreads_timer_t *timer                 = NULL;
+	libcthreads_timer_service_t *timer_service = NULL;
+	int result                                 = 0;
+
+	cthreads_test_timer_service_number_of_expired_timers = 0;
+	cthreads_test_timer_service_sum_of_values            = 0;
+
+	result = libcthreads_timer_initialize(
+	          &timer,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_timer_service_create(
+	          &timer_service,
+	          NULL,
+	          10000,
+	          &cthreads_test_timer_service_failing_callback_function,
+	          NULL,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_timer_service_schedule(
+	          timer_service,
+	          timer,
+	          100000,
+	          (intptr_t *) 1,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = cthreads_test_timer_service_wait_for_expired_timers(
+	          1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test that the failure of the callback function is reported when the timer service is joined
+	 */
+	result = libcthreads_timer_service_join(
+	          &timer_service,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_timer_free(
+	          &timer,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( timer_service != NULL )
+	{
+		libcthreads_timer_service_join(
+		 &timer_service,
+		 NULL );
+	}
+	if( timer != NULL )
+	{
+		libcthreads_timer_free(
+		 &timer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	if( libcthreads_mutex_initialize(
+	     &cthreads_test_timer_service_mutex,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &cthreads_test_timer_service_condition,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	CTHREADS_TEST_RUN(
+	 "libcthreads_timer_service_create",
+	 cthreads_test_timer_service_create );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_timer_service_schedule",
+	 cthreads_test_timer_service_schedule );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_timer_service_schedule_thread_pool",
+	 cthreads_test_timer_service_schedule_thread_pool );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_timer_service_schedule_callback_failure",
+	 cthreads_test_timer_service_schedule_callback_failure );
+
+	libcthreads_condition_free(
+	 &cthreads_test_timer_service_condition,
+	 NULL );
+
+	libcthreads_mutex_free(
+	 &cthreads_test_timer_service_mutex,
+	 NULL );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( cthreads_test_timer_service_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &cthreads_test_timer_service_condition,
+		 NULL );
+	}
+	if( cthreads_test_timer_service_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &cthreads_test_timer_service_mutex,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
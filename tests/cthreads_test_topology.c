@@ -0,0 +1,1539 @@
+/*
+ * Library topology functions test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_memory.h"
+#include "cthreads_test_unused.h"
+
+/* The maximum number of CPU indexes used by the tests
+ */
+#define CTHREADS_TEST_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS	4096
+
+int cthreads_test_topology_cpu_indexes[ CTHREADS_TEST_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS ];
+
+/* Tests the libcthreads_topology_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_topology_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libcthreads_topology_t *topology = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 1;
+	int number_of_memset_fail_tests  = 1;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libcthreads_topology_initialize(
+	          &topology,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "topology",
+	 topology );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_topology_free(
+	          &topology,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "topology",
+	 topology );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_topology_initialize(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	topology = (libcthreads_topology_t *) 0x12345678UL;
+
+	result = libcthreads_topology_initialize(
+	          &topology,
+	          &error );
+
+	topology = NULL;
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_CTHREADS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_topology_initialize with malloc failing
+		 */
+		cthreads_test_malloc_attempts_before_fail = test_number;
+
+		result = libcthreads_topology_initialize(
+		          &topology,
+		          &error );
+
+		if( cthreads_test_malloc_attempts_before_fail != -1 )
+		{
+			cthreads_test_malloc_attempts_before_fail = -1;
+
+			if( topology != NULL )
+			{
+				libcthreads_topology_free(
+				 &topology,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "topology",
+			 topology );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libcthreads_topology_initialize with memset failing
+		 */
+		cthreads_test_memset_attempts_before_fail = test_number;
+
+		result = libcthreads_topology_initialize(
+		          &topology,
+		          &error );
+
+		if( cthreads_test_memset_attempts_before_fail != -1 )
+		{
+			cthreads_test_memset_attempts_before_fail = -1;
+
+			if( topology != NULL )
+			{
+				libcthreads_topology_free(
+				 &topology,
+				 NULL );
+			}
+		}
+		else
+		{
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NULL(
+			 "topology",
+			 topology );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_CTHREADS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( topology != NULL )
+	{
+		libcthreads_topology_free(
+		 &topology,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_topology_free function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_topology_free(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libcthreads_topology_t *topology = NULL;
+	int result                       = 0;
+
+	/* Test error cases
+	 */
+	result = libcthreads_topology_free(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The shared topology cannot be freed
+	 */
+	result = libcthreads_topology_get(
+	          &topology,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_topology_free(
+	          &topology,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "topology",
+	 topology );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_topology_get function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_topology_get(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libcthreads_topology_t *shared_topology = NULL;
+	libcthreads_topology_t *topology        = NULL;
+	int result                              = 0;
+
+	/* Test regular cases
+	 */
+	result = libcthreads_topology_get(
+	          &topology,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "topology",
+	 topology );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The topology is read once and shared
+	 */
+	result = libcthreads_topology_get(
+	          &shared_topology,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "shared_topology",
+	 (int) ( shared_topology == topology ),
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_topology_get(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_topology_get_number_of_cpus, libcthreads_topology_get_number_of_cores
+ * and libcthreads_topology_get_number_of_nodes functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_topology_get_counts(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libcthreads_topology_t *topology = NULL;
+	int number_of_cores              = 0;
+	int number_of_cpus               = 0;
+	int number_of_nodes              = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_topology_get(
+	          &topology,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcthreads_topology_get_number_of_cpus(
+	          topology,
+	          &number_of_cpus,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_cpus",
+	 number_of_cpus,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_topology_get_number_of_cores(
+	          topology,
+	          &number_of_cores,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_cores",
+	 number_of_cores,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_LESS_THAN_INT(
+	 "number_of_cores",
+	 number_of_cores,
+	 number_of_cpus + 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_topology_get_number_of_nodes(
+	          topology,
+	          &number_of_nodes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_nodes",
+	 number_of_nodes,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_topology_get_number_of_cpus(
+	          NULL,
+	          &number_of_cpus,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_number_of_cpus(
+	          topology,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_number_of_cores(
+	          NULL,
+	          &number_of_cores,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_number_of_cores(
+	          topology,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_number_of_nodes(
+	          NULL,
+	          &number_of_nodes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_number_of_nodes(
+	          topology,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_topology_get_cpu_identifier, libcthreads_topology_get_cpu_core_index
+ * and libcthreads_topology_get_cpu_node_index functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_topology_get_cpu_values(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libcthreads_topology_t *topology = NULL;
+	int core_index                   = 0;
+	int cpu_identifier               = 0;
+	int cpu_index                    = 0;
+	int node_index                   = 0;
+	int number_of_cores              = 0;
+	int number_of_cpus               = 0;
+	int number_of_nodes              = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_topology_get(
+	          &topology,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_topology_get_number_of_cpus(
+	          topology,
+	          &number_of_cpus,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_topology_get_number_of_cores(
+	          topology,
+	          &number_of_cores,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_topology_get_number_of_nodes(
+	          topology,
+	          &number_of_nodes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( cpu_index = 0;
+	     cpu_index < number_of_cpus;
+	     cpu_index++ )
+	{
+		result = libcthreads_topology_get_cpu_identifier(
+		          topology,
+		          cpu_index,
+		          &cpu_identifier,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_GREATER_THAN_INT(
+		 "cpu_identifier",
+		 cpu_identifier,
+		 -1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_topology_get_cpu_core_index(
+		          topology,
+		          cpu_index,
+		          &core_index,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_GREATER_THAN_INT(
+		 "core_index",
+		 core_index,
+		 -1 );
+
+		CTHREADS_TEST_ASSERT_LESS_THAN_INT(
+		 "core_index",
+		 core_index,
+		 number_of_cores );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_topology_get_cpu_node_index(
+		          topology,
+		          cpu_index,
+		          &node_index,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_GREATER_THAN_INT(
+		 "node_index",
+		 node_index,
+		 -1 );
+
+		CTHREADS_TEST_ASSERT_LESS_THAN_INT(
+		 "node_index",
+		 node_index,
+		 number_of_nodes );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libcthreads_topology_get_cpu_identifier(
+	          NULL,
+	          0,
+	          &cpu_identifier,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cpu_identifier(
+	          topology,
+	          -1,
+	          &cpu_identifier,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cpu_identifier(
+	          topology,
+	          number_of_cpus,
+	          &cpu_identifier,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cpu_identifier(
+	          topology,
+	          0,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cpu_core_index(
+	          NULL,
+	          0,
+	          &core_index,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cpu_core_index(
+	          topology,
+	          number_of_cpus,
+	          &core_index,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cpu_core_index(
+	          topology,
+	          0,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cpu_node_index(
+	          NULL,
+	          0,
+	          &node_index,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cpu_node_index(
+	          topology,
+	          number_of_cpus,
+	          &node_index,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cpu_node_index(
+	          topology,
+	          0,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_topology_get_core_cpus function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_topology_get_core_cpus(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libcthreads_topology_t *topology = NULL;
+	int core_index                   = 0;
+	int number_of_core_cpus          = 0;
+	int number_of_cores              = 0;
+	int number_of_cpus               = 0;
+	int result                       = 0;
+	int total_number_of_cpus         = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_topology_get(
+	          &topology,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_topology_get_number_of_cpus(
+	          topology,
+	          &number_of_cpus,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_topology_get_number_of_cores(
+	          topology,
+	          &number_of_cores,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( core_index = 0;
+	     core_index < number_of_cores;
+	     core_index++ )
+	{
+		result = libcthreads_topology_get_core_cpus(
+		          topology,
+		          core_index,
+		          cthreads_test_topology_cpu_indexes,
+		          CTHREADS_TEST_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS,
+		          &number_of_core_cpus,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_GREATER_THAN_INT(
+		 "number_of_core_cpus",
+		 number_of_core_cpus,
+		 0 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		total_number_of_cpus += number_of_core_cpus;
+	}
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "total_number_of_cpus",
+	 total_number_of_cpus,
+	 number_of_cpus );
+
+	/* Test error cases
+	 */
+	result = libcthreads_topology_get_core_cpus(
+	          NULL,
+	          0,
+	          cthreads_test_topology_cpu_indexes,
+	          CTHREADS_TEST_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS,
+	          &number_of_core_cpus,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_core_cpus(
+	          topology,
+	          number_of_cores,
+	          cthreads_test_topology_cpu_indexes,
+	          CTHREADS_TEST_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS,
+	          &number_of_core_cpus,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_core_cpus(
+	          topology,
+	          0,
+	          NULL,
+	          CTHREADS_TEST_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS,
+	          &number_of_core_cpus,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_core_cpus(
+	          topology,
+	          0,
+	          cthreads_test_topology_cpu_indexes,
+	          0,
+	          &number_of_core_cpus,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_core_cpus(
+	          topology,
+	          0,
+	          cthreads_test_topology_cpu_indexes,
+	          CTHREADS_TEST_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_topology_get_node_cpus function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_topology_get_node_cpus(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libcthreads_topology_t *topology = NULL;
+	int node_index                   = 0;
+	int number_of_cpus               = 0;
+	int number_of_node_cpus          = 0;
+	int number_of_nodes              = 0;
+	int result                       = 0;
+	int total_number_of_cpus         = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_topology_get(
+	          &topology,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_topology_get_number_of_cpus(
+	          topology,
+	          &number_of_cpus,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_topology_get_number_of_nodes(
+	          topology,
+	          &number_of_nodes,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( node_index = 0;
+	     node_index < number_of_nodes;
+	     node_index++ )
+	{
+		result = libcthreads_topology_get_node_cpus(
+		          topology,
+		          node_index,
+		          cthreads_test_topology_cpu_indexes,
+		          CTHREADS_TEST_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS,
+		          &number_of_node_cpus,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		total_number_of_cpus += number_of_node_cpus;
+	}
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "total_number_of_cpus",
+	 total_number_of_cpus,
+	 number_of_cpus );
+
+	/* Test error cases
+	 */
+	result = libcthreads_topology_get_node_cpus(
+	          NULL,
+	          0,
+	          cthreads_test_topology_cpu_indexes,
+	          CTHREADS_TEST_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS,
+	          &number_of_node_cpus,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_node_cpus(
+	          topology,
+	          number_of_nodes,
+	          cthreads_test_topology_cpu_indexes,
+	          CTHREADS_TEST_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS,
+	          &number_of_node_cpus,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( number_of_cpus > 1 )
+	{
+		/* With a single node all CPUs do not fit in a single CPU index
+		 */
+		if( number_of_nodes == 1 )
+		{
+			result = libcthreads_topology_get_node_cpus(
+			          topology,
+			          0,
+			          cthreads_test_topology_cpu_indexes,
+			          1,
+			          &number_of_node_cpus,
+			          &error );
+
+			CTHREADS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcthreads_topology_get_cache_size and libcthreads_topology_get_cache_line_size functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_topology_get_cache_sizes(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libcthreads_topology_t *topology = NULL;
+	size_t cache_line_size           = 0;
+	size_t cache_size                = 0;
+	int cache_level                  = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_topology_get(
+	          &topology,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( cache_level = 1;
+	     cache_level <= 3;
+	     cache_level++ )
+	{
+		result = libcthreads_topology_get_cache_size(
+		          topology,
+		          cache_level,
+		          &cache_size,
+		          &error );
+
+		CTHREADS_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result != 0 )
+		{
+			CTHREADS_TEST_ASSERT_NOT_EQUAL_SIZE(
+			 "cache_size",
+			 cache_size,
+			 (size_t) 0 );
+		}
+	}
+	result = libcthreads_topology_get_cache_line_size(
+	          topology,
+	          &cache_line_size,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_NOT_EQUAL_SIZE(
+	 "cache_line_size",
+	 cache_line_size,
+	 (size_t) 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libcthreads_topology_get_cache_size(
+	          NULL,
+	          1,
+	          &cache_size,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cache_size(
+	          topology,
+	          0,
+	          &cache_size,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cache_size(
+	          topology,
+	          4,
+	          &cache_size,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cache_size(
+	          topology,
+	          1,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cache_line_size(
+	          NULL,
+	          &cache_line_size,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcthreads_topology_get_cache_line_size(
+	          topology,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_topology_initialize",
+	 cthreads_test_topology_initialize );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_topology_free",
+	 cthreads_test_topology_free );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_topology_get",
+	 cthreads_test_topology_get );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_topology_get_number_of_cpus",
+	 cthreads_test_topology_get_counts );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_topology_get_cpu_identifier",
+	 cthreads_test_topology_get_cpu_values );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_topology_get_core_cpus",
+	 cthreads_test_topology_get_core_cpus );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_topology_get_node_cpus",
+	 cthreads_test_topology_get_node_cpus );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_topology_get_cache_size",
+	 cthreads_test_topology_get_cache_sizes );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
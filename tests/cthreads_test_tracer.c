@@ -0,0 +1,560 @@
+/*
+ * Library tracer functions test program
+ *
+ * Copyright (C) 2012-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "cthreads_test_libcerror.h"
+#include "cthreads_test_libcthreads.h"
+#include "cthreads_test_macros.h"
+#include "cthreads_test_memory.h"
+#include "cthreads_test_unused.h"
+
+#define CTHREADS_TEST_TRACER_FILENAME	"cthreads_test_tracer.json"
+
+int cthreads_test_tracer_values[ 8 ];
+
+/* The thread pool callback function
+ * Returns 1 if successful or -1 on error
+ */
+int cthreads_test_tracer_callback_function(
+     intptr_t *value,
+     void *arguments CTHREADS_TEST_ATTRIBUTE_UNUSED )
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	if( value == NULL )
+	{
+		return( -1 );
+	}
+	*( (int *) value ) += 1;
+
+	return( 1 );
+}
+
+/* Tests the libcthreads_tracer_enable, libcthreads_tracer_disable and
+ * libcthreads_tracer_is_enabled functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_tracer_enable(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libcthreads_tracer_enable(
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_tracer_is_enabled(
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_tracer_disable(
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_tracer_is_enabled(
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the recording of thread pool events
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_tracer_record_event(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	int number_of_events                   = 0;
+	int result                             = 0;
+	int value_index                        = 0;
+
+	/* Initialize test
+	 */
+	result = libcthreads_tracer_clear(
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that no events are recorded when the tracer is disabled
+	 */
+	result = libcthreads_thread_pool_create(
+	          &thread_pool,
+	          NULL,
+	          2,
+	          8,
+	          &cthreads_test_tracer_callback_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		cthreads_test_tracer_values[ value_index ] = 0;
+
+		result = libcthreads_thread_pool_push(
+		          thread_pool,
+		          (intptr_t *) &( cthreads_test_tracer_values[ value_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcthreads_thread_pool_join(
+	          &thread_pool,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_tracer_get_number_of_events(
+	          &number_of_events,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_events",
+	 number_of_events,
+	 0 );
+
+	/* Test that events are recorded when the tracer is enabled
+	 */
+	result = libcthreads_tracer_enable(
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_pool_create(
+	          &thread_pool,
+	          NULL,
+	          2,
+	          8,
+	          &cthreads_test_tracer_callback_function,
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		result = libcthreads_thread_pool_push(
+		          thread_pool,
+		          (intptr_t *) &( cthreads_test_tracer_values[ value_index ] ),
+		          &error );
+
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CTHREADS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcthreads_thread_pool_join(
+	          &thread_pool,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_tracer_disable(
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		CTHREADS_TEST_ASSERT_EQUAL_INT(
+		 "cthreads_test_tracer_values[ value_index ]",
+		 cthreads_test_tracer_values[ value_index ],
+		 2 );
+	}
+	/* Every value is enqueued, dequeued, started and ended
+	 */
+	result = libcthreads_tracer_get_number_of_events(
+	          &number_of_events,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_events",
+	 number_of_events,
+	 31 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	libcthreads_tracer_disable(
+	 NULL );
+
+	return( 0 );
+}
+
+/* Tests the libcthreads_tracer_write_chrome_trace function
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_tracer_write_chrome_trace(
+     void )
+{
+	char string[ 64 ];
+
+	libcerror_error_t *error = NULL;
+	FILE *file_stream        = NULL;
+	char *result_string      = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libcthreads_tracer_write_chrome_trace(
+	          CTHREADS_TEST_TRACER_FILENAME,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	file_stream = file_stream_open(
+	               CTHREADS_TEST_TRACER_FILENAME,
+	               FILE_STREAM_OPEN_READ );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_stream",
+	 file_stream );
+
+	result_string = file_stream_get_string(
+	                 file_stream,
+	                 string,
+	                 64 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "result_string",
+	 result_string );
+
+	result = narrow_string_compare(
+	          string,
+	          "{\"traceEvents\":[",
+	          16 );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	file_stream_close(
+	 file_stream );
+
+	file_stream = NULL;
+
+	remove(
+	 CTHREADS_TEST_TRACER_FILENAME );
+
+	/* Test error cases
+	 */
+	result = libcthreads_tracer_write_chrome_trace(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	remove(
+	 CTHREADS_TEST_TRACER_FILENAME );
+
+	return( 0 );
+}
+
+/* Tests the libcthreads_tracer_clear and libcthreads_tracer_get_number_of_events functions
+ * Returns 1 if successful or 0 if not
+ */
+int cthreads_test_tracer_clear(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_events     = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libcthreads_tracer_clear(
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_tracer_get_number_of_events(
+	          &number_of_events,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CTHREADS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_events",
+	 number_of_events,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libcthreads_tracer_get_number_of_events(
+	          NULL,
+	          &error );
+
+	CTHREADS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	CTHREADS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CTHREADS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CTHREADS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argc )
+	CTHREADS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_tracer_enable",
+	 cthreads_test_tracer_enable );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_tracer_record_event",
+	 cthreads_test_tracer_record_event );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_tracer_write_chrome_trace",
+	 cthreads_test_tracer_write_chrome_trace );
+
+	CTHREADS_TEST_RUN(
+	 "libcthreads_tracer_clear",
+	 cthreads_test_tracer_clear );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -6,7 +6,7 @@ $ExitSuccess = 0
 $ExitFailure = 1
 $ExitIgnore = 77
 
-$LibraryTests = "condition error lock mutex queue read_write_lock repeating_thread support thread thread_attributes thread_pool"
+$LibraryTests = "atomic barrier channel clock condition error hash_map hazard_pointer_domain latch lock lock_stripe lock_validator mpsc_queue mutex object_pool queue queued_lock read_write_lock repeating_thread sharded_counter stack support thread thread_attributes thread_local thread_pool timer timer_service topology tracer"
 $LibraryTestsWithInput = ""
 $OptionSets = ""
 
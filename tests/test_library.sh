@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="condition error lock mutex queue read_write_lock repeating_thread support thread thread_attributes thread_pool";
+LIBRARY_TESTS="atomic barrier channel clock condition error hash_map hazard_pointer_domain latch lock lock_stripe lock_validator mpsc_queue mutex object_pool queue queued_lock read_write_lock repeating_thread sharded_counter stack support thread thread_attributes thread_local thread_pool timer timer_service topology tracer";
 LIBRARY_TESTS_WITH_INPUT="";
 OPTION_SETS=();
 